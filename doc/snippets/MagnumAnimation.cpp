@@ -23,7 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <thread>
 #include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/Reference.h>
 
 #include "Magnum/Timeline.h"
 #include "Magnum/Math/Bezier.h"
@@ -32,6 +35,8 @@
 #include "Magnum/Math/Packing.h"
 #include "Magnum/Animation/Easing.h"
 #include "Magnum/Animation/Player.h"
+#include "Magnum/Animation/Quantization.h"
+#include "Magnum/Animation/TrackBatch.h"
 
 using namespace Magnum;
 using namespace Magnum::Math::Literals;
@@ -150,6 +155,32 @@ player.add(scaling, objectScaling)
 /* [Player-usage] */
 }
 
+{
+/* [TrackBatch-usage] */
+Containers::ArrayView<const Animation::TrackView<const Float, const Quaternion>> jointRotationTracks;
+Containers::StridedArrayView1D<Quaternion> jointRotations;
+
+Animation::TrackBatch<Float, Quaternion> batch{Math::slerp};
+for(std::size_t i = 0; i != jointRotationTracks.size(); ++i)
+    batch.add(jointRotationTracks[i], jointRotations[i]);
+
+Animation::Player<Float> player;
+player.add(batch);
+/* [TrackBatch-usage] */
+}
+
+{
+/* [slerpSmallestThree] */
+Containers::ArrayView<const Float> keys;
+Containers::ArrayView<const Vector3us> packedRotations;
+
+Animation::TrackView<const Float, const Vector3us, Quaternion> rotation{
+    keys, packedRotations, Animation::slerpSmallestThree};
+Quaternion result = rotation.at(0.5f);
+/* [slerpSmallestThree] */
+static_cast<void>(result);
+}
+
 /* WinRT has warnings-as-errors and fails on the unitialized object var */
 #ifndef CORRADE_TARGET_WINDOWS_RT
 {
@@ -218,6 +249,21 @@ player.advance(std::chrono::system_clock::now().time_since_epoch());
 /* [Player-usage-chrono] */
 }
 
+{
+std::vector<Containers::Reference<Animation::Player<Float>>> players;
+Float time{};
+/* [Player-advance-parallel] */
+Animation::Player<Float>::advance(time, players, 16,
+    [](void(*job)(std::size_t, void*), void* jobData, std::size_t jobCount, void*) {
+        std::vector<std::thread> threads;
+        for(std::size_t i = 1; i < jobCount; ++i)
+            threads.emplace_back(job, i, jobData);
+        job(0, jobData);
+        for(std::thread& thread: threads) thread.join();
+    });
+/* [Player-advance-parallel] */
+}
+
 {
 /* [Player-higher-order] */
 struct Data {
@@ -31,12 +31,14 @@
 #include "Magnum/SceneGraph/AnimableGroup.h"
 #include "Magnum/SceneGraph/AbstractGroupedFeature.h"
 #include "Magnum/SceneGraph/AbstractTranslationRotation3D.h"
+#include "Magnum/SceneGraph/Boundable.h"
 #include "Magnum/SceneGraph/MatrixTransformation2D.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
 #include "Magnum/SceneGraph/Object.h"
 #include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
 
 using namespace Magnum;
 using namespace Magnum::Math::Literals;
@@ -387,4 +389,42 @@ camera.draw(drawableTransformations);
 /* [Drawable-culling] */
 }
 
+{
+Object3D cameraObject;
+SceneGraph::Camera3D camera{cameraObject};
+Scene3D scene;
+/* [Boundable-usage] */
+SceneGraph::SpatialIndex3D index{{Vector3{-1000.0f}, Vector3{1000.0f}}};
+
+Object3D* object = new Object3D{&scene};
+new SceneGraph::Boundable3D{*object, {Vector3{-1.0f}, Vector3{1.0f}}, &index};
+/* [Boundable-usage] */
+
+/* [SpatialIndex-culling] */
+struct IndexedDrawable3D: Object3D, SceneGraph::Drawable3D, SceneGraph::Boundable3D {
+    explicit IndexedDrawable3D(Object3D* parent, const Range3D& bounds, SceneGraph::SpatialIndex3D& index): Object3D{parent}, SceneGraph::Drawable3D{*this}, SceneGraph::Boundable3D{*this, bounds, &index} {}
+
+    // ...
+};
+
+/* Query only the objects inside the camera frustum */
+auto frustum = Frustum::fromMatrix(camera.projectionMatrix()*camera.cameraMatrix());
+std::vector<std::reference_wrapper<SceneGraph::Boundable3D>> visible =
+    index.intersectFrustum(frustum);
+
+/* Calculate transformations just for those and draw them */
+std::vector<std::reference_wrapper<Object3D>> objects;
+for(SceneGraph::Boundable3D& boundable: visible)
+    objects.push_back(static_cast<IndexedDrawable3D&>(boundable));
+std::vector<Matrix4> transformations =
+    scene.transformationMatrices(objects, camera.cameraMatrix());
+std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>>
+    drawableTransformations;
+for(std::size_t i = 0; i != visible.size(); ++i)
+    drawableTransformations.emplace_back(
+        static_cast<IndexedDrawable3D&>(visible[i].get()), transformations[i]);
+camera.draw(drawableTransformations);
+/* [SpatialIndex-culling] */
+}
+
 }
@@ -23,13 +23,16 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <unordered_map>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Resource.h>
 
 #include "Magnum/FileCallback.h"
+#include "Magnum/Mesh.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Shaders/Vector.h"
@@ -112,6 +115,22 @@ font->setFileCallback([](const std::string& filename,
 /* [AbstractFont-setFileCallback-template] */
 }
 
+{
+Containers::Pointer<Text::AbstractFont> font;
+std::string message;
+/* [AbstractGlyphCache-dynamic] */
+Text::GlyphCache cache{Vector2i{1024}};
+cache.setDynamic(true);
+Text::Renderer2D renderer{*font, cache, 0.15f};
+renderer.reserve(256, GL::BufferUsage::DynamicDraw, GL::BufferUsage::StaticDraw);
+
+// each frame ...
+cache.nextFrame();
+font->fillGlyphCache(cache, message);
+renderer.render(message);
+/* [AbstractGlyphCache-dynamic] */
+}
+
 {
 /* [DistanceFieldGlyphCache-usage] */
 Containers::Pointer<Text::AbstractFont> font;
@@ -174,6 +193,60 @@ shader.setTransformationProjectionMatrix(projectionMatrix)
     .bindVectorTexture(cache.texture())
     .draw(renderer.mesh());
 /* [Renderer-usage2] */
+
+/* [Renderer-edit] */
+/* Change the countdown value, only the changed line gets laid out again and
+   uploaded */
+renderer.replace(23, 2, "9");
+
+/* Append a new line */
+renderer.insert(renderer.text().size(), "\nLiftoff!");
+/* [Renderer-edit] */
+}
+
+{
+Containers::Pointer<Text::AbstractFont> font;
+Text::GlyphCache cache{Vector2i{512}};
+/* [Renderer-shared-indices] */
+/* One index buffer for up to 256 glyphs, shared by all labels */
+GL::Buffer indices;
+MeshIndexType indexType = Text::Renderer2D::fillIndexBuffer(indices, 256,
+    GL::BufferUsage::StaticDraw);
+
+Text::Renderer2D title{*font, cache, 0.15f}, subtitle{*font, cache, 0.1f};
+title.reserve(64, GL::BufferUsage::DynamicDraw, indices, indexType);
+subtitle.reserve(256, GL::BufferUsage::DynamicDraw, indices, indexType);
+/* [Renderer-shared-indices] */
+}
+
+{
+Containers::Pointer<Text::AbstractFont> font;
+Text::GlyphCache cache{Vector2i{512}};
+/* [renderGlyphQuadsInto] */
+/* Scratch memory allocated once upfront */
+Containers::Array<UnsignedInt> glyphIds{256};
+Containers::Array<Vector2> glyphOffsets{256}, glyphAdvances{256};
+struct Vertex {
+    Vector2 position, textureCoordinates;
+};
+Containers::Array<Vertex> vertices{256*4};
+
+/* Layout a run of text and produce the quads, advancing the cursor */
+const char text[] = "Hello World!";
+UnsignedInt count = font->layoutGlyphs({text, sizeof(text) - 1},
+    Containers::arrayView(glyphIds), Containers::arrayView(glyphOffsets),
+    Containers::arrayView(glyphAdvances));
+CORRADE_INTERNAL_ASSERT(count <= glyphIds.size());
+Vector2 cursor;
+Range2D rectangle = Text::renderGlyphQuadsInto(cache, 0.15f/font->size(),
+    cursor, glyphIds.prefix(count), glyphOffsets.prefix(count),
+    glyphAdvances.prefix(count),
+    Containers::StridedArrayView1D<Vector2>{Containers::arrayView(vertices),
+        &vertices[0].position, count*4, sizeof(Vertex)},
+    Containers::StridedArrayView1D<Vector2>{Containers::arrayView(vertices),
+        &vertices[0].textureCoordinates, count*4, sizeof(Vertex)});
+/* [renderGlyphQuadsInto] */
+static_cast<void>(rectangle);
 }
 
 }
@@ -23,7 +23,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <chrono>
 #include <unordered_map>
+#include <vector>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Resource.h>
@@ -34,11 +36,16 @@
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Animation/Player.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Quaternion.h"
 #include "Magnum/Math/Swizzle.h"
 #include "Magnum/MeshTools/Interleave.h"
 #include "Magnum/MeshTools/Transform.h"
 #include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AnimationCompression.h"
 #include "Magnum/Trade/AnimationData.h"
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include "Magnum/Trade/AsyncImporter.h"
+#endif
 #include "Magnum/Trade/ImageData.h"
 #include "Magnum/Trade/LightData.h"
 #include "Magnum/Trade/MaterialData.h"
@@ -137,6 +144,34 @@ if(data && data->instanceType() == Trade::ObjectInstanceType3D::Mesh) {
 static_cast<void>(materialIndex);
 }
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+{
+PluginManager::Manager<Trade::AbstractImporter> manager;
+/* [AsyncImporter-usage] */
+Trade::AsyncImporter importer{manager, "AnySceneImporter"};
+if(!importer.openFile("scene.gltf"))
+    Fatal{} << "Can't open scene.gltf";
+
+/* Request all images with a higher priority than meshes */
+std::vector<std::future<Containers::Optional<Trade::ImageData2D>>> images;
+for(UnsignedInt i = 0; i != importer.importer().image2DCount(); ++i)
+    images.push_back(importer.image2D(i, 0, 1));
+std::vector<std::future<Containers::Optional<Trade::MeshData>>> meshes;
+for(UnsignedInt i = 0; i != importer.importer().meshCount(); ++i)
+    meshes.push_back(importer.mesh(i));
+
+/* Every frame, upload whatever is ready and keep the rest loading */
+for(std::future<Containers::Optional<Trade::ImageData2D>>& image: images) {
+    if(!image.valid() || image.wait_for(std::chrono::seconds{0}) !=
+        std::future_status::ready) continue;
+
+    Containers::Optional<Trade::ImageData2D> data = image.get();
+    // upload to the GPU ...
+}
+/* [AsyncImporter-usage] */
+}
+#endif
+
 {
 Containers::Pointer<Trade::AbstractImporter> importer;
 /* [AbstractImporter-setFileCallback] */
@@ -199,6 +234,28 @@ for(UnsignedInt i = 0; i != data.trackCount(); ++i) {
 /* [AnimationData-usage-mutable] */
 }
 
+{
+Containers::Optional<Trade::AnimationData> data;
+Animation::Player<Float> player;
+Containers::Array<Quaternion> rotations;
+/* [quantizeAnimation] */
+Trade::AnimationData compressed = Trade::quantizeAnimation(
+    Trade::simplifyAnimation(Trade::resampleAnimation(*data, 30.0f),
+        0.001f, 0.1_degf));
+
+for(UnsignedInt i = 0; i != compressed.trackCount(); ++i) {
+    if(compressed.trackTargetType(i) != Trade::AnimationTrackTargetType::Rotation3D)
+        continue;
+    if(compressed.trackType(i) == Trade::AnimationTrackType::Vector3us)
+        player.add(compressed.track<Vector3us, Quaternion>(i),
+            rotations[compressed.trackTarget(i)]);
+    else
+        player.add(compressed.track<Quaternion>(i),
+            rotations[compressed.trackTarget(i)]);
+}
+/* [quantizeAnimation] */
+}
+
 {
 /* [ImageData-construction] */
 Containers::Array<char> data;
@@ -232,6 +289,19 @@ else
 }
 #endif
 
+{
+Containers::Array<Trade::ImageData2D> levels;
+/* [ImageData-serialization] */
+/* Save the whole mip chain … */
+Utility::Directory::write("image.blob", Trade::ImageData2D::serialize(levels));
+
+/* … and later load the second level back, the data are not copied */
+auto blob = Utility::Directory::mapRead("image.blob");
+Containers::Optional<Trade::ImageData2D> level1 =
+    Trade::ImageData2D::deserialize(blob, 1);
+/* [ImageData-serialization] */
+}
+
 {
 Trade::ImageData2D data{PixelFormat::RGB8Unorm, {}, nullptr};
 /* [ImageData-usage-mutable] */
@@ -704,6 +774,18 @@ static_cast<void>(triangleIds);
 static_cast<void>(triangleCounts);
 }
 
+{
+Trade::MeshData mesh{MeshPrimitive::Points, 0};
+/* [MeshData-serialization] */
+/* Save the mesh … */
+Utility::Directory::write("mesh.blob", mesh.serialize());
+
+/* … and later load it back, the data are not copied anywhere */
+auto blob = Utility::Directory::mapRead("mesh.blob");
+Containers::Optional<Trade::MeshData> loaded = Trade::MeshData::deserialize(blob);
+/* [MeshData-serialization] */
+}
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 {
 CORRADE_IGNORE_DEPRECATED_PUSH
@@ -88,6 +88,9 @@
 #  OpenGLTester                 - OpenGLTester class
 #  MagnumFont                   - Magnum bitmap font plugin
 #  MagnumFontConverter          - Magnum bitmap font converter plugin
+#  MagnumImageConverter         - Magnum blob image converter plugin
+#  MagnumImporter               - Magnum blob importer plugin
+#  MagnumSceneConverter         - Magnum blob scene converter plugin
 #  ObjImporter                  - OBJ importer plugin
 #  TgaImageConverter            - TGA image converter plugin
 #  TgaImporter                  - TGA importer plugin
@@ -371,8 +374,9 @@ set(_MAGNUM_LIBRARY_COMPONENT_LIST
     OpenGLTester)
 set(_MAGNUM_PLUGIN_COMPONENT_LIST
     AnyAudioImporter AnyImageConverter AnyImageImporter AnySceneConverter
-    AnySceneImporter MagnumFont MagnumFontConverter ObjImporter
-    TgaImageConverter TgaImporter WavAudioImporter)
+    AnySceneImporter MagnumFont MagnumFontConverter MagnumImageConverter
+    MagnumImporter MagnumSceneConverter ObjImporter TgaImageConverter
+    TgaImporter WavAudioImporter)
 set(_MAGNUM_EXECUTABLE_COMPONENT_LIST
     distancefieldconverter fontconverter imageconverter sceneconverter
     shaderconverter gl-info al-info)
@@ -891,11 +895,25 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         elseif(_component STREQUAL TextureTools)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Atlas.h)
 
+            # Resampling uses threads
+            if(NOT CORRADE_TARGET_EMSCRIPTEN)
+                find_package(Threads REQUIRED)
+                set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
+
         # Trade library
         elseif(_component STREQUAL Trade)
             set_property(TARGET Magnum::${_component} APPEND PROPERTY
                 INTERFACE_LINK_LIBRARIES Corrade::PluginManager)
 
+            # AsyncImporter uses threads
+            if(NOT CORRADE_TARGET_EMSCRIPTEN)
+                find_package(Threads REQUIRED)
+                set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES Threads::Threads)
+            endif()
+
         # Vk library
         elseif(_component STREQUAL Vk)
             find_package(Vulkan REQUIRED)
@@ -909,6 +927,9 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         # No special setup for AnySceneImporter plugin
         # No special setup for MagnumFont plugin
         # No special setup for MagnumFontConverter plugin
+        # No special setup for MagnumImageConverter plugin
+        # No special setup for MagnumImporter plugin
+        # No special setup for MagnumSceneConverter plugin
         # No special setup for ObjImporter plugin
         # No special setup for TgaImageConverter plugin
         # No special setup for TgaImporter plugin
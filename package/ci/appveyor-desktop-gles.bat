@@ -40,6 +40,9 @@ cmake .. ^
     -DWITH_ANYSHADERCONVERTER=OFF ^
     -DWITH_MAGNUMFONT=ON ^
     -DWITH_MAGNUMFONTCONVERTER=ON ^
+    -DWITH_MAGNUMIMAGECONVERTER=OFF ^
+    -DWITH_MAGNUMIMPORTER=OFF ^
+    -DWITH_MAGNUMSCENECONVERTER=OFF ^
     -DWITH_OBJIMPORTER=OFF ^
     -DWITH_TGAIMAGECONVERTER=OFF ^
     -DWITH_TGAIMPORTER=OFF ^
@@ -39,6 +39,9 @@ cmake .. ^
     -DWITH_ANYSHADERCONVERTER=ON ^
     -DWITH_MAGNUMFONT=ON ^
     -DWITH_MAGNUMFONTCONVERTER=ON ^
+    -DWITH_MAGNUMIMAGECONVERTER=ON ^
+    -DWITH_MAGNUMIMPORTER=ON ^
+    -DWITH_MAGNUMSCENECONVERTER=ON ^
     -DWITH_OBJIMPORTER=ON ^
     -DWITH_TGAIMAGECONVERTER=ON ^
     -DWITH_TGAIMPORTER=ON ^
@@ -47,6 +47,9 @@ cmake .. ^
     -DWITH_ANYSCENEIMPORTER=OFF ^
     -DWITH_MAGNUMFONT=OFF ^
     -DWITH_MAGNUMFONTCONVERTER=OFF ^
+    -DWITH_MAGNUMIMAGECONVERTER=ON ^
+    -DWITH_MAGNUMIMPORTER=ON ^
+    -DWITH_MAGNUMSCENECONVERTER=ON ^
     -DWITH_OBJIMPORTER=OFF ^
     -DWITH_TGAIMAGECONVERTER=OFF ^
     -DWITH_TGAIMPORTER=OFF ^
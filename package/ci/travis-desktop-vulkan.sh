@@ -52,6 +52,9 @@ cmake .. \
     -DWITH_ANYSHADERCONVERTER=OFF \
     -DWITH_MAGNUMFONT=OFF \
     -DWITH_MAGNUMFONTCONVERTER=OFF \
+    -DWITH_MAGNUMIMAGECONVERTER=OFF \
+    -DWITH_MAGNUMIMPORTER=OFF \
+    -DWITH_MAGNUMSCENECONVERTER=OFF \
     -DWITH_OBJIMPORTER=OFF \
     -DWITH_TGAIMAGECONVERTER=OFF \
     -DWITH_TGAIMPORTER=OFF \
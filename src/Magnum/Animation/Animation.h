@@ -49,6 +49,7 @@ template<class T, class K = T> class Player;
 template<class K, class V, class R = ResultOf<V>> class Track;
 template<class K> class TrackViewStorage;
 template<class K, class V, class R = ResultOf<V>> class TrackView;
+template<class K, class V, class R = ResultOf<V>> class TrackBatch;
 #endif
 
 }}
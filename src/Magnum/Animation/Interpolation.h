@@ -175,8 +175,8 @@ MAGNUM_EXPORT Debug& operator<<(Debug& debug, Extrapolation value);
 @param frame        Frame at which to interpolate
 @param hint         Hint for keyframe search
 
-Does a linear search over the keyframes until it finds last keyframe which is
-not larger than @p frame. Once the keyframe is found, reference to it and the immediately following keyframe is passed to @p interpolator along with
+Searches the keyframes for the last keyframe which is not larger than
+@p frame. Once the keyframe is found, reference to it and the immediately following keyframe is passed to @p interpolator along with
 calculated interpolation factor, returning the interpolated value.
 
 -   In case the first keyframe is already larger than @p frame or @p frame is
@@ -187,9 +187,13 @@ calculated interpolation factor, returning the interpolated value.
     the interpolator.
 -   In case no keyframes are present, default-constructed value is returned.
 
-The @p hint parameter hints where to start the linear search and is updated
-with keyframe index matching @p frame. If @p frame is earlier than @p hint, the
-search is restarted from the beginning.
+The @p hint parameter hints where to start the search and is updated with
+keyframe index matching @p frame. If @p frame is between the keyframe at
+@p hint and the next keyframe, the lookup is done in constant time, otherwise
+the search gallops forward or backward from @p hint with exponentially
+increasing steps and then does a binary search, resulting in
+@f$ \mathcal{O}(\log n) @f$ complexity for arbitrary seeking and constant
+complexity for both forward and reverse sequential playback.
 
 Used internally from @ref Track::at() / @ref TrackView::at(), see @ref Track
 documentation for more information.
@@ -203,12 +207,12 @@ template<class K, class V, class R = ResultOf<V>> R interpolate(const Containers
 /**
 @brief Interpolate animation value with strict constraints
 
-Does a linear search over the keyframes until it finds last keyframe which is
-not larger than @p frame. Once the keyframe is found, reference to it and the immediately following keyframe is passed to @p interpolator along with
+Searches the keyframes for the last keyframe which is not larger than
+@p frame. Once the keyframe is found, reference to it and the immediately following keyframe is passed to @p interpolator along with
 calculated interpolation factor, returning the interpolated value. The @p hint
-parameter hints where to start the linear search and is updated with keyframe
-index matching @p frame. If @p frame is earlier than @p hint, the search is
-restarted from the beginning.
+parameter hints where to start the search and is updated with keyframe index
+matching @p frame, see @ref interpolate() for details about the search
+complexity.
 
 This is a stricter but more performant version of @ref interpolate() with
 implicit @ref Extrapolation::Extrapolated behavior. Expects that there are
@@ -415,6 +419,65 @@ template<class V, class R> auto interpolatorFor(Interpolation interpolation) ->
     return Implementation::TypeTraits<typename std::remove_const<V>::type, R>::interpolator(interpolation);
 }
 
+namespace Implementation {
+
+/* Finds the last keyframe in [0, keys.size() - 2] that's not larger than
+   frame, or 0 if all keyframes are larger. Expects at least two keyframes.
+   Starts at the hint and gallops forward or backward with exponentially
+   increasing steps until the keyframe is bracketed, then does a binary search
+   in the bracket. That's O(1) for sequential playback (where the frame is
+   usually at the hint or right after it) and O(log n) for arbitrary seeks,
+   independently of the direction. Only operator< is used on the keys so it
+   works with any key type. */
+template<class K> std::size_t keyframeFor(const Containers::StridedArrayView1D<const K>& keys, const K frame, std::size_t hint) {
+    const std::size_t last = keys.size() - 2;
+    if(hint > last) hint = last;
+
+    /* Invariant for the binary search below: keys[lo] <= frame and either
+       hi == last + 1 or frame < keys[hi] */
+    std::size_t lo, hi;
+    if(!(frame < keys[hint])) {
+        /* Sequential playback, the frame is still between the same two
+           keyframes. This is the most common case so do it first. */
+        if(hint == last || frame < keys[hint + 1]) return hint;
+
+        lo = hint + 1;
+        for(std::size_t step = 1; ; step *= 2) {
+            hi = lo + step;
+            if(hi > last) {
+                hi = last + 1;
+                break;
+            }
+            if(frame < keys[hi]) break;
+            lo = hi;
+        }
+    } else {
+        /* Before the first keyframe, nothing to search for */
+        if(frame < keys[0]) return 0;
+
+        hi = hint;
+        for(std::size_t step = 1; ; step *= 2) {
+            if(step >= hi) {
+                lo = 0;
+                break;
+            }
+            lo = hi - step;
+            if(!(frame < keys[lo])) break;
+            hi = lo;
+        }
+    }
+
+    while(hi - lo > 1) {
+        const std::size_t mid = lo + (hi - lo)/2;
+        if(frame < keys[mid]) hi = mid;
+        else lo = mid;
+    }
+
+    return lo;
+}
+
+}
+
 template<class K, class V, class R> R interpolate(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, const Extrapolation before, const Extrapolation after, R(*const interpolator)(const V&, const V&, Float), K frame, std::size_t& hint) {
     CORRADE_ASSERT(keys.size() == values.size(), "Animation::interpolate(): keys and values don't have the same size", {});
 
@@ -430,12 +493,8 @@ template<class K, class V, class R> R interpolate(const Containers::StridedArray
         return interpolator(values[0], values[0], 0.0f);
     }
 
-    /* Rewind from the beginning if hint is too late */
-    if(hint >= keys.size() || frame < keys[hint]) hint = 0;
-
-    /* Go through the keys until we find a pair that is around given time */
-    while(hint + 2 < keys.size() && frame >= keys[hint + 1])
-        ++hint;
+    /* Find a pair of keys that is around given time */
+    hint = Implementation::keyframeFor(keys, frame, hint);
 
     /* Special extrapolation outside of range. Usual extrapolation is handled
        below. */
@@ -455,12 +514,8 @@ template<class K, class V, class R> R interpolateStrict(const Containers::Stride
     CORRADE_ASSERT(keys.size() >= 2, "Animation::interpolateStrict(): at least two keyframes required", {});
     CORRADE_ASSERT(keys.size() == values.size(), "Animation::interpolateStrict(): keys and values don't have the same size", {});
 
-    /* Rewind from the beginning if hint is too late */
-    if(hint >= keys.size() || frame < keys[hint]) hint = 0;
-
-    /* Go through the keys until we find a pair that is around given time */
-    while(hint + 2 < keys.size() && frame >= keys[hint + 1])
-        ++hint;
+    /* Find a pair of keys that is around given time */
+    hint = Implementation::keyframeFor(keys, frame, hint);
 
     return interpolator(values[hint], values[hint + 1],
         Math::lerpInverted(Float(keys[hint]), Float(keys[hint + 1]), Float(frame)));
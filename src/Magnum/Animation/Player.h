@@ -258,6 +258,19 @@ template<class T, class K
          */
         typedef std::pair<UnsignedInt, K>(*Scaler)(T, K);
 
+        /**
+         * @brief Executor function type
+         * @m_since_latest
+         *
+         * Used by @ref advance(T, Containers::ArrayView<const Containers::Reference<Player<T, K>>>, std::size_t, Executor, void*).
+         * The function gets a job function, a data pointer for it, job count
+         * and a user data pointer. It's expected to call the job function with
+         * each index in range @cpp [0, jobCount) @ce and the job data pointer
+         * exactly once, possibly in parallel, and return only after all jobs
+         * finished.
+         */
+        typedef void(*Executor)(void(*)(std::size_t, void*), void*, std::size_t, void*);
+
         /**
          * @brief Advance multiple players at the same time
          *
@@ -265,6 +278,41 @@ template<class T, class K
          */
         static void advance(T time, std::initializer_list<Containers::Reference<Player<T, K>>> players);
 
+        /**
+         * @brief Advance multiple players in parallel
+         * @param time          Time
+         * @param players       Players to advance
+         * @param jobCount      Count of jobs to split the players into
+         * @param executor      Executor function
+         * @param executorData  User data pointer passed to @p executor
+         * @m_since_latest
+         *
+         * Splits @p players into at most @p jobCount contiguous ranges of
+         * nearly equal size and lets @p executor run them. Each job calls
+         * @ref advance(T) on players in its range in order, meaning
+         * destinations are updated and user callbacks are called in the order
+         * in which the players are in @p players for each range, but ranges
+         * can be processed concurrently. The split depends only on the
+         * player count and @p jobCount, not on the executor, so the order is
+         * deterministic across runs.
+         *
+         * Players are independent of each other, but it's the caller's
+         * responsibility to ensure no two players in the list write to the
+         * same destination and that user callbacks don't access shared state
+         * without synchronization. If @p jobCount is @cpp 1 @ce or there's
+         * at most one player, the players are advanced directly on the
+         * calling thread without calling @p executor at all.
+         *
+         * The library itself doesn't provide any thread pool. The following
+         * snippet shows an executor spawning one thread per job, running the
+         * first job on the calling thread; for per-frame use it's
+         * recommended to dispatch the jobs to a persistent thread pool
+         * instead:
+         *
+         * @snippet MagnumAnimation.cpp Player-advance-parallel
+         */
+        static void advance(T time, Containers::ArrayView<const Containers::Reference<Player<T, K>>> players, std::size_t jobCount, Executor executor, void* executorData = nullptr);
+
         /** @brief Constructor */
         explicit Player();
 
@@ -410,6 +458,25 @@ template<class T, class K
         }
         #endif
 
+        /**
+         * @brief Add a track batch
+         * @m_since_latest
+         *
+         * All tracks in the @p batch are advanced together using
+         * @ref TrackBatch::advance() after each call to @ref advance() as long
+         * as the animation is playing. The whole batch counts as a single
+         * track in @ref size() and @ref duration() is extended with
+         * @ref TrackBatch::duration(), however tracks added to the batch
+         * after this call won't be accounted for in the player duration.
+         * The corresponding @ref track() is empty.
+         *
+         * Note that batch ownership is *not* transferred to the @ref Player
+         * and you have to ensure that it's kept in scope and not moved for
+         * the whole lifetime of the @ref Player instance. You need to include
+         * @ref Magnum/Animation/TrackBatch.h in order to use this function.
+         */
+        template<class V, class R> Player<T, K>& add(TrackBatch<K, V, R>& batch);
+
         /**
          * @brief Add a track with a result callback
          *
@@ -805,6 +872,7 @@ template<class T, class K
         struct Track;
 
         Player<T, K>& addInternal(const TrackViewStorage<const K>& track, void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* destination, void(*userCallback)(), void* userCallbackData);
+        Player<T, K>& addInternal(const TrackViewStorage<const K>& track, const Math::Range1D<K>& duration, void (*advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* destination, void(*userCallback)(), void* userCallbackData);
 
         Containers::Optional<std::pair<UnsignedInt, K>> elapsedInternal(T time, T& updatedStartTime, T& updatedPauseTime, State& updatedState) const;
 
@@ -823,6 +891,13 @@ template<class T, class K> template<class V, class R> Player<T, K>& Player<T, K>
         }, &destination, nullptr, nullptr);
 }
 
+template<class T, class K> template<class V, class R> Player<T, K>& Player<T, K>::add(TrackBatch<K, V, R>& batch) {
+    return addInternal({}, batch.duration(),
+        [](const TrackViewStorage<const K>&, K key, std::size_t&, void* batch, void(*)(), void*) {
+            static_cast<TrackBatch<K, V, R>*>(batch)->advance(key);
+        }, &batch, nullptr, nullptr);
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template<class T, class K> template<class V, class R, class Callback> Player<T, K>& Player<T, K>::addWithCallback(const TrackView<const K, const V, R>& track, Callback callback, void* userData) {
     auto callbackPtr = static_cast<void(*)(K, const R&, void*)>(callback);
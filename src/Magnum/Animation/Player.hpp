@@ -76,6 +76,31 @@ template<class T, class K> void Player<T, K>::advance(const T time, const std::i
     for(Player<T, K>& p: players) p.advance(time);
 }
 
+template<class T, class K> void Player<T, K>::advance(const T time, const Containers::ArrayView<const Containers::Reference<Player<T, K>>> players, const std::size_t jobCount, const Executor executor, void* const executorData) {
+    CORRADE_ASSERT(jobCount,
+        "Animation::Player::advance(): expected non-zero job count", );
+
+    /* Not worth going through the executor in this case */
+    if(jobCount == 1 || players.size() <= 1) {
+        for(Player<T, K>& p: players) p.advance(time);
+        return;
+    }
+
+    struct Data {
+        T time;
+        Containers::ArrayView<const Containers::Reference<Player<T, K>>> players;
+        std::size_t jobCount;
+    } data{time, players, jobCount < players.size() ? jobCount : players.size()};
+
+    executor([](std::size_t job, void* data) {
+        const Data& d = *static_cast<const Data*>(data);
+        const std::size_t begin = job*d.players.size()/d.jobCount;
+        const std::size_t end = (job + 1)*d.players.size()/d.jobCount;
+        for(std::size_t i = begin; i != end; ++i)
+            static_cast<Player<T, K>&>(d.players[i]).advance(d.time);
+    }, &data, data.jobCount, executorData);
+}
+
 template<class T, class K> Player<T, K>::Player(Player<T, K>&&) noexcept = default;
 
 template<class T, class K> Player<T, K>& Player<T, K>::operator=(Player<T, K>&&) noexcept = default;
@@ -102,10 +127,14 @@ template<class T, class K> const TrackViewStorage<const K>& Player<T, K>::track(
 }
 
 template<class T, class K> Player<T, K>& Player<T, K>::addInternal(const TrackViewStorage<const K>& track, void(*const advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* const destination, void(*const userCallback)(), void* const userCallbackData) {
+    return addInternal(track, track.duration(), advancer, destination, userCallback, userCallbackData);
+}
+
+template<class T, class K> Player<T, K>& Player<T, K>::addInternal(const TrackViewStorage<const K>& track, const Math::Range1D<K>& duration, void(*const advancer)(const TrackViewStorage<const K>&, K, std::size_t&, void*, void(*)(), void*), void* const destination, void(*const userCallback)(), void* const userCallbackData) {
     if(_tracks.empty() && _duration == Math::Range1D<K>{})
-        _duration = track.duration();
+        _duration = duration;
     else
-        _duration = Math::join(track.duration(), _duration);
+        _duration = Math::join(duration, _duration);
     arrayAppend(_tracks, Containers::InPlaceInit, track, advancer, destination, userCallback, userCallbackData, 0u);
     return *this;
 }
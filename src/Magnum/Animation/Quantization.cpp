@@ -0,0 +1,130 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Quantization.h"
+
+#include <cmath>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/Vector4.h"
+
+namespace Magnum { namespace Animation {
+
+namespace {
+    constexpr Float Sqrt2Inv = 0.70710678118654752440f;
+
+    template<Int exponent> Vector3 lerpTranslation(const Vector3s& a, const Vector3s& b, Float t) {
+        /* Interpolating in the packed space, as the scale is the same for
+           both values */
+        return Math::lerp(Math::unpack<Vector3>(a), Math::unpack<Vector3>(b), t)*Float(std::ldexp(1.0f, exponent));
+    }
+}
+
+Vector3us packQuaternionSmallestThree(const Quaternion& rotation) {
+    CORRADE_ASSERT(rotation.isNormalized(),
+        "Animation::packQuaternionSmallestThree():" << rotation << "is not normalized", {});
+
+    const Vector4 data{rotation.vector(), rotation.scalar()};
+
+    /* Find the largest component */
+    UnsignedInt largest = 0;
+    for(UnsignedInt i = 1; i != 4; ++i)
+        if(Math::abs(data[i]) > Math::abs(data[largest])) largest = i;
+
+    /* Flip so the dropped component is positive, pack the remaining three
+       to 15 bits */
+    const Float sign = data[largest] < 0.0f ? -1.0f : 1.0f;
+    Vector3us out;
+    for(UnsignedInt i = 0, j = 0; i != 4; ++i) {
+        if(i == largest) continue;
+        const Float normalized = Math::clamp(sign*data[i]*Sqrt2Inv + 0.5f, 0.0f, 1.0f);
+        out[j++] = UnsignedShort(normalized*32767.0f + 0.5f);
+    }
+
+    /* Index of the dropped component in the top bits of first two */
+    out[0] |= (largest & 1) << 15;
+    out[1] |= (largest >> 1) << 15;
+    return out;
+}
+
+Quaternion unpackQuaternionSmallestThree(const Vector3us& packed) {
+    const UnsignedInt largest = (packed[0] >> 15)|((packed[1] >> 15) << 1);
+
+    Vector4 data;
+    Float sum = 0.0f;
+    for(UnsignedInt i = 0, j = 0; i != 4; ++i) {
+        if(i == largest) continue;
+        const Float value = ((packed[j++] & 0x7fff)/32767.0f - 0.5f)*2.0f*Sqrt2Inv;
+        data[i] = value;
+        sum += value*value;
+    }
+    data[largest] = std::sqrt(Math::max(1.0f - sum, 0.0f));
+
+    return Quaternion{data.xyz(), data.w()};
+}
+
+Quaternion slerpSmallestThree(const Vector3us& a, const Vector3us& b, const Float t) {
+    return Math::slerpShortestPath(unpackQuaternionSmallestThree(a), unpackQuaternionSmallestThree(b), t);
+}
+
+Int quantizedTranslationExponent(const Float maxAbsoluteValue) {
+    if(!(maxAbsoluteValue > 0.0f)) return QuantizedTranslationMinExponent;
+
+    /* frexp() gives a mantissa in [0.5, 1), so 2^exponent is strictly larger
+       than the value, except when the mantissa is exactly 0.5 */
+    Int exponent;
+    const Float mantissa = std::frexp(maxAbsoluteValue, &exponent);
+    if(mantissa == 0.5f) --exponent;
+
+    return Math::clamp(exponent, QuantizedTranslationMinExponent, QuantizedTranslationMaxExponent);
+}
+
+Vector3s packTranslation(const Vector3& translation, const Int exponent) {
+    CORRADE_ASSERT(exponent >= QuantizedTranslationMinExponent && exponent <= QuantizedTranslationMaxExponent,
+        "Animation::packTranslation(): expected exponent in range [" << Debug::nospace << QuantizedTranslationMinExponent << Debug::nospace << "," << QuantizedTranslationMaxExponent << Debug::nospace << "] but got" << exponent, {});
+    return Math::pack<Vector3s>(Math::clamp(translation/Float(std::ldexp(1.0f, exponent)), -1.0f, 1.0f));
+}
+
+Vector3 unpackTranslation(const Vector3s& packed, const Int exponent) {
+    CORRADE_ASSERT(exponent >= QuantizedTranslationMinExponent && exponent <= QuantizedTranslationMaxExponent,
+        "Animation::unpackTranslation(): expected exponent in range [" << Debug::nospace << QuantizedTranslationMinExponent << Debug::nospace << "," << QuantizedTranslationMaxExponent << Debug::nospace << "] but got" << exponent, {});
+    return Math::unpack<Vector3>(packed)*Float(std::ldexp(1.0f, exponent));
+}
+
+auto quantizedTranslationInterpolator(const Int exponent) -> Vector3(*)(const Vector3s&, const Vector3s&, Float) {
+    switch(exponent) {
+        #define _c(exponent) case exponent: return lerpTranslation<exponent>;
+        _c(-8) _c(-7) _c(-6) _c(-5) _c(-4) _c(-3) _c(-2) _c(-1)
+        _c(0) _c(1) _c(2) _c(3) _c(4) _c(5) _c(6) _c(7)
+        _c(8) _c(9) _c(10) _c(11) _c(12) _c(13) _c(14) _c(15)
+        #undef _c
+    }
+
+    CORRADE_ASSERT_UNREACHABLE("Animation::quantizedTranslationInterpolator(): expected exponent in range [" << Debug::nospace << QuantizedTranslationMinExponent << Debug::nospace << "," << QuantizedTranslationMaxExponent << Debug::nospace << "] but got" << exponent, {});
+}
+
+}}
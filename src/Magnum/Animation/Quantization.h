@@ -0,0 +1,147 @@
+#ifndef Magnum_Animation_Quantization_h
+#define Magnum_Animation_Quantization_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Animation::packQuaternionSmallestThree(), @ref Magnum::Animation::unpackQuaternionSmallestThree(), @ref Magnum::Animation::slerpSmallestThree(), @ref Magnum::Animation::quantizedTranslationExponent(), @ref Magnum::Animation::packTranslation(), @ref Magnum::Animation::unpackTranslation(), @ref Magnum::Animation::quantizedTranslationInterpolator()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Animation {
+
+/**
+@brief Pack a quaternion using the smallest-three encoding
+@m_since_latest
+
+Drops the component with the largest absolute value, flips the quaternion so
+the dropped component is positive and quantizes the remaining three
+components, which are all in range @f$ [-\frac{1}{\sqrt{2}}; \frac{1}{\sqrt{2}}] @f$,
+to 15 bits each. The index of the dropped component is stored in the highest
+bits of the first two components. The packed value takes six bytes instead of
+sixteen, with maximal per-component error of about @cpp 6e-5 @ce. Expects
+that the quaternion is normalized.
+
+As the encoding doesn't preserve the quaternion sign, the result should be
+interpolated with a shortest-path interpolation, which is what
+@ref slerpSmallestThree() does.
+@see @ref unpackQuaternionSmallestThree(), @ref Quaternion::isNormalized()
+*/
+MAGNUM_EXPORT Vector3us packQuaternionSmallestThree(const Quaternion& rotation);
+
+/**
+@brief Unpack a quaternion packed using the smallest-three encoding
+@m_since_latest
+
+Inverse to @ref packQuaternionSmallestThree(). The returned quaternion is
+normalized within the precision of the encoding.
+*/
+MAGNUM_EXPORT Quaternion unpackQuaternionSmallestThree(const Vector3us& packed);
+
+/**
+@brief Spherical linear interpolation of quaternions packed using the smallest-three encoding
+@m_since_latest
+
+Equivalent to calling @ref Math::slerpShortestPath(const Quaternion<T>&, const Quaternion<T>&, T)
+on the output of @ref unpackQuaternionSmallestThree(). Meant to be used as an
+interpolator for @ref TrackView with @ref Vector3us values and a
+@ref Quaternion result:
+
+@snippet MagnumAnimation.cpp slerpSmallestThree
+*/
+MAGNUM_EXPORT Quaternion slerpSmallestThree(const Vector3us& a, const Vector3us& b, Float t);
+
+/**
+@brief Minimal exponent for quantized translations
+@m_since_latest
+
+@see @ref QuantizedTranslationMaxExponent,
+    @ref quantizedTranslationExponent()
+*/
+constexpr Int QuantizedTranslationMinExponent = -8;
+
+/**
+@brief Maximal exponent for quantized translations
+@m_since_latest
+
+@see @ref QuantizedTranslationMinExponent,
+    @ref quantizedTranslationExponent()
+*/
+constexpr Int QuantizedTranslationMaxExponent = 15;
+
+/**
+@brief Exponent for quantizing translations of given range
+@m_since_latest
+
+Returns the smallest exponent @f$ e @f$ for which @f$ 2^e @f$ is not smaller
+than @p maxAbsoluteValue, clamped to the range given by
+@ref QuantizedTranslationMinExponent and
+@ref QuantizedTranslationMaxExponent.
+@see @ref packTranslation(), @ref Math::max(const Vector<size, T>&)
+*/
+MAGNUM_EXPORT Int quantizedTranslationExponent(Float maxAbsoluteValue);
+
+/**
+@brief Pack a translation into a 16-bit normalized vector
+@m_since_latest
+
+Divides @p translation by @f$ 2^e @f$, where @f$ e @f$ is @p exponent, and
+packs the result to a signed normalized 16-bit vector using
+@ref Math::pack(). Values outside of the @f$ [-2^e; 2^e] @f$ range get
+clamped, the precision is @f$ \frac{2^e}{32767} @f$. Expects that
+@p exponent is in the range given by @ref QuantizedTranslationMinExponent and
+@ref QuantizedTranslationMaxExponent.
+@see @ref quantizedTranslationExponent(), @ref unpackTranslation()
+*/
+MAGNUM_EXPORT Vector3s packTranslation(const Vector3& translation, Int exponent);
+
+/**
+@brief Unpack a translation from a 16-bit normalized vector
+@m_since_latest
+
+Inverse to @ref packTranslation().
+*/
+MAGNUM_EXPORT Vector3 unpackTranslation(const Vector3s& packed, Int exponent);
+
+/**
+@brief Interpolator for quantized translations
+@m_since_latest
+
+Returns a function that linearly interpolates two translations packed using
+@ref packTranslation() with given @p exponent and returns the unpacked
+result. Since the interpolator function can't carry any state, the exponent
+is baked into the returned function. Meant to be used as an interpolator for
+@ref TrackView with @ref Vector3s values and a @ref Vector3 result. Expects
+that @p exponent is in the range given by
+@ref QuantizedTranslationMinExponent and @ref QuantizedTranslationMaxExponent.
+*/
+MAGNUM_EXPORT auto quantizedTranslationInterpolator(Int exponent) -> Vector3(*)(const Vector3s&, const Vector3s&, Float);
+
+}}
+
+#endif
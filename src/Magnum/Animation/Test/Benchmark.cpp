@@ -26,6 +26,7 @@
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Animation/Player.h"
+#include "Magnum/Animation/TrackBatch.h"
 
 namespace Magnum { namespace Animation { namespace Test { namespace {
 
@@ -39,6 +40,9 @@ struct Benchmark: TestSuite::Tester {
     void atEmpty();
     void at();
     void atHint();
+    void atHintReverse();
+    void atHintSeek();
+    void atHintScrub();
     void atStrict();
     void atStrictInterleaved();
     void atStrictInterleavedDirectInterpolator();
@@ -49,6 +53,8 @@ struct Benchmark: TestSuite::Tester {
     void playerAdvanceCallback();
     void playerAdvanceRawCallback();
     void playerAdvanceRawCallbackDirectInterpolator();
+    void playerAdvanceManyTracks();
+    void playerAdvanceManyTracksBatch();
 
     Containers::Array<Float> _keys;
     Containers::Array<Int> _values;
@@ -60,7 +66,7 @@ struct Benchmark: TestSuite::Tester {
 };
 
 namespace {
-    enum: std::size_t { DataSize = 2000 };
+    enum: std::size_t { DataSize = 2000, TrackCount = 64 };
 }
 
 Benchmark::Benchmark() {
@@ -71,6 +77,9 @@ Benchmark::Benchmark() {
                    &Benchmark::atEmpty,
                    &Benchmark::at,
                    &Benchmark::atHint,
+                   &Benchmark::atHintReverse,
+                   &Benchmark::atHintSeek,
+                   &Benchmark::atHintScrub,
                    &Benchmark::atStrict,
                    &Benchmark::atStrictInterleaved,
                    &Benchmark::atStrictInterleavedDirectInterpolator,
@@ -80,7 +89,9 @@ Benchmark::Benchmark() {
                    &Benchmark::playerAdvance,
                    &Benchmark::playerAdvanceCallback,
                    &Benchmark::playerAdvanceRawCallback,
-                   &Benchmark::playerAdvanceRawCallbackDirectInterpolator}, 10);
+                   &Benchmark::playerAdvanceRawCallbackDirectInterpolator,
+                   &Benchmark::playerAdvanceManyTracks,
+                   &Benchmark::playerAdvanceManyTracksBatch}, 10);
 
     _keys = Containers::Array<Float>{DataSize};
     _values = Containers::Array<Int>{Containers::DirectInit, DataSize, 1};
@@ -154,6 +165,39 @@ void Benchmark::atHint() {
     CORRADE_COMPARE(result, 125000);
 }
 
+void Benchmark::atHintReverse() {
+    Int result{};
+    CORRADE_BENCHMARK(250) {
+        std::size_t hint = DataSize - 1;
+        for(Float i = 500.0f; i > 0.0f; i -= 1.0f)
+            result += _track.at(i, hint);
+    }
+    CORRADE_COMPARE(result, 125000);
+}
+
+void Benchmark::atHintSeek() {
+    Int result{};
+    CORRADE_BENCHMARK(250) {
+        std::size_t hint{};
+        /* Jumping randomly all over the track */
+        for(std::size_t i = 0; i != 500; ++i)
+            result += _track.at(Float((i*7919) % 6000), hint);
+    }
+    CORRADE_COMPARE(result, 125000);
+}
+
+void Benchmark::atHintScrub() {
+    Int result{};
+    CORRADE_BENCHMARK(250) {
+        std::size_t hint{};
+        /* Going back and forth around the middle with increasing amplitude,
+           like when dragging a timeline cursor */
+        for(Int i = 0; i != 500; ++i)
+            result += _track.at(3000.0f + Float(i & 1 ? i*6 : -i*6), hint);
+    }
+    CORRADE_COMPARE(result, 125000);
+}
+
 void Benchmark::atStrict() {
     Int result{};
     CORRADE_BENCHMARK(250) {
@@ -260,6 +304,36 @@ void Benchmark::playerAdvanceRawCallbackDirectInterpolator() {
     CORRADE_COMPARE(result, 125000);
 }
 
+void Benchmark::playerAdvanceManyTracks() {
+    /* All tracks share the same keys, which is the common case e.g. for
+       skinned characters */
+    Int results[TrackCount]{};
+    Player<Float> player;
+    for(Int& result: results) player.add(_track, result);
+    player.play({});
+    CORRADE_BENCHMARK(250) {
+        for(Float i = 0.0f; i < 500.0f; i += 1.0f)
+            player.advance(i);
+    }
+    CORRADE_COMPARE(results[0], 1);
+    CORRADE_COMPARE(results[TrackCount - 1], 1);
+}
+
+void Benchmark::playerAdvanceManyTracksBatch() {
+    Int results[TrackCount]{};
+    TrackBatch<Float, Int> batch{Math::select};
+    for(Int& result: results) batch.add(_track, result);
+    Player<Float> player;
+    player.add(batch)
+        .play({});
+    CORRADE_BENCHMARK(250) {
+        for(Float i = 0.0f; i < 500.0f; i += 1.0f)
+            player.advance(i);
+    }
+    CORRADE_COMPARE(results[0], 1);
+    CORRADE_COMPARE(results[TrackCount - 1], 1);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Animation::Test::Benchmark)
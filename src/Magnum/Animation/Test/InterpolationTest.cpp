@@ -68,6 +68,7 @@ struct InterpolationTest: TestSuite::Tester {
 
     void interpolateHint();
     void interpolateStrictHint();
+    void interpolateHintSearch();
 
     void interpolateDifferentResultType();
     void interpolateStrictDifferentResultType();
@@ -191,6 +192,8 @@ InterpolationTest::InterpolationTest() {
                        &InterpolationTest::interpolateStrictHint},
                        Containers::arraySize(HintData));
 
+    addTests({&InterpolationTest::interpolateHintSearch});
+
     addTests({&InterpolationTest::interpolateDifferentResultType,
               &InterpolationTest::interpolateStrictDifferentResultType,
 
@@ -526,6 +529,44 @@ Float lerpHalf(const Half& a, const Half& b, Float t) {
     return Math::lerp(Float(a), Float(b), t);
 }
 
+void InterpolationTest::interpolateHintSearch() {
+    /* Uneven spacing and repeated keys to test all branches of the galloping
+       search */
+    const Float keys[]{0.0f, 1.0f, 1.0f, 1.0f, 2.0f, 3.0f, 5.0f, 5.0f, 8.0f,
+        9.0f, 10.0f, 10.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 20.0f,
+        21.0f, 22.0f, 23.0f, 24.0f, 25.0f, 26.0f, 27.0f, 28.0f, 30.0f, 31.0f};
+    /* Test all prefixes of the keyframe list with all hints and frames
+       against a linear search. Values are not important here. */
+    for(std::size_t size = 2; size <= Containers::arraySize(keys); ++size) {
+        CORRADE_ITERATION(size);
+        for(Float frame = -2.0f; frame < 35.0f; frame += 0.5f) {
+            CORRADE_ITERATION(frame);
+            std::size_t expected = 0;
+            while(expected + 2 < size && frame >= keys[expected + 1])
+                ++expected;
+
+            for(std::size_t hint = 0; hint != size + 2; ++hint) {
+                CORRADE_ITERATION(hint);
+
+                std::size_t h = hint;
+                Animation::interpolate<Float, Float>(
+                    Containers::arrayView(keys).prefix(size),
+                    Containers::arrayView(keys).prefix(size),
+                    Extrapolation::Extrapolated, Extrapolation::Extrapolated,
+                    Math::lerp, frame, h);
+                CORRADE_COMPARE(h, expected);
+
+                std::size_t hStrict = hint;
+                Animation::interpolateStrict<Float, Float>(
+                    Containers::arrayView(keys).prefix(size),
+                    Containers::arrayView(keys).prefix(size),
+                    Math::lerp, frame, hStrict);
+                CORRADE_COMPARE(hStrict, expected);
+            }
+        }
+    }
+}
+
 void InterpolationTest::interpolateDifferentResultType() {
     std::size_t hint{};
     CORRADE_COMPARE((Animation::interpolate<Float, Half, Float>(
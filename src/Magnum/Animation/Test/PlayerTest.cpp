@@ -24,6 +24,8 @@
 */
 
 #include <sstream>
+#include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Reference.h>
 #include <Corrade/TestSuite/Tester.h>
@@ -62,6 +64,9 @@ struct PlayerTest: TestSuite::Tester {
     void advancePlayCountInfinite();
     void advanceChrono();
     void advanceList();
+    void advanceListParallel();
+    void advanceListParallelSingleJob();
+    void advanceListParallelZeroJobs();
     void advanceZeroDurationStop();
     void advanceZeroDurationPause();
     void advanceZeroDurationInfinitePlayCount();
@@ -153,6 +158,9 @@ PlayerTest::PlayerTest() {
               &PlayerTest::advancePlayCountInfinite,
               &PlayerTest::advanceChrono,
               &PlayerTest::advanceList,
+              &PlayerTest::advanceListParallel,
+              &PlayerTest::advanceListParallelSingleJob,
+              &PlayerTest::advanceListParallelZeroJobs,
               &PlayerTest::advanceZeroDurationStop,
               &PlayerTest::advanceZeroDurationPause,
               &PlayerTest::advanceZeroDurationInfinitePlayCount,
@@ -804,6 +812,92 @@ void PlayerTest::advanceList() {
     CORRADE_COMPARE(valueB, 2.75f);
 }
 
+void PlayerTest::advanceListParallel() {
+    struct Callback {
+        std::size_t index;
+        std::vector<std::size_t>* order;
+    };
+
+    std::vector<std::size_t> order;
+    Float values[5]{};
+    Callback callbacks[5];
+    Player<Float> players[5];
+    std::vector<Containers::Reference<Player<Float>>> references;
+    for(std::size_t i = 0; i != 5; ++i) {
+        callbacks[i] = {i, &order};
+        players[i].add(Track, values[i])
+            .addWithCallback(Track, [](Float, const Float&, Callback& callback) {
+                callback.order->push_back(callback.index);
+            }, callbacks[i])
+            .play(2.0f);
+        references.emplace_back(players[i]);
+    }
+
+    /* Executing the jobs in reverse order. Five players split into three
+       jobs should be [0], [1, 2] and [3, 4], with order preserved inside each
+       job. */
+    std::vector<std::size_t> jobs;
+    Player<Float>::advance(3.75f, references, 3, [](void(*job)(std::size_t, void*), void* jobData, std::size_t jobCount, void* executorData) {
+        for(std::size_t i = jobCount; i != 0; --i) {
+            static_cast<std::vector<std::size_t>*>(executorData)->push_back(i - 1);
+            job(i - 1, jobData);
+        }
+    }, &jobs);
+    CORRADE_COMPARE_AS(jobs, (std::vector<std::size_t>{2, 1, 0}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(order, (std::vector<std::size_t>{3, 4, 1, 2, 0}),
+        TestSuite::Compare::Container);
+    for(std::size_t i = 0; i != 5; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(players[i].state(), State::Playing);
+        CORRADE_COMPARE(values[i], 4.0f);
+    }
+
+    /* More jobs than players gets clamped to player count */
+    jobs.clear();
+    Player<Float>::advance(3.75f, references, 8, [](void(*job)(std::size_t, void*), void* jobData, std::size_t jobCount, void* executorData) {
+        for(std::size_t i = 0; i != jobCount; ++i) {
+            static_cast<std::vector<std::size_t>*>(executorData)->push_back(i);
+            job(i, jobData);
+        }
+    }, &jobs);
+    CORRADE_COMPARE_AS(jobs, (std::vector<std::size_t>{0, 1, 2, 3, 4}),
+        TestSuite::Compare::Container);
+}
+
+void PlayerTest::advanceListParallelSingleJob() {
+    Float valueA = -1.0f, valueB = -1.0f;
+    Player<Float> a, b;
+    a.add(Track, valueA)
+     .play(2.0f);
+    b.add(Track, valueB)
+     .play(1.0f);
+
+    /* The executor is not called at all, everything is done directly */
+    bool called = false;
+    const Containers::Reference<Player<Float>> players[]{a, b};
+    Player<Float>::advance(3.75f, players, 1, [](void(*)(std::size_t, void*), void*, std::size_t, void* executorData) {
+        *static_cast<bool*>(executorData) = true;
+    }, &called);
+    CORRADE_VERIFY(!called);
+    CORRADE_COMPARE(valueA, 4.0f);
+    CORRADE_COMPARE(valueB, 2.75f);
+}
+
+void PlayerTest::advanceListParallelZeroJobs() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Player<Float> a;
+    const Containers::Reference<Player<Float>> players[]{a};
+    Player<Float>::advance(1.0f, players, 0, [](void(*)(std::size_t, void*), void*, std::size_t, void*) {});
+    CORRADE_COMPARE(out.str(), "Animation::Player::advance(): expected non-zero job count\n");
+}
+
 void PlayerTest::advanceZeroDurationStop() {
     Float value = -1.0f;
     Player<Float> player;
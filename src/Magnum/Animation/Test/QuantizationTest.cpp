@@ -0,0 +1,217 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Animation/Quantization.h"
+#include "Magnum/Animation/Track.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/Vector4.h"
+
+namespace Magnum { namespace Animation { namespace Test { namespace {
+
+struct QuantizationTest: TestSuite::Tester {
+    explicit QuantizationTest();
+
+    void packUnpackQuaternion();
+    void packQuaternionNegative();
+    void packQuaternionNotNormalized();
+    void slerpSmallestThree();
+
+    void translationExponent();
+    void packUnpackTranslation();
+    void packTranslationClamp();
+    void packTranslationInvalidExponent();
+    void translationInterpolator();
+    void translationInterpolatorInvalidExponent();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    Quaternion rotation;
+} PackUnpackQuaternionData[]{
+    {"identity", {}},
+    {"largest x", Quaternion::rotation(170.0_degf, Vector3{1.0f, 0.1f, -0.2f}.normalized())},
+    {"largest y", Quaternion::rotation(150.0_degf, Vector3{0.3f, -1.0f, 0.2f}.normalized())},
+    {"largest z", Quaternion::rotation(-160.0_degf, Vector3{0.3f, 0.1f, 1.0f}.normalized())},
+    {"largest w", Quaternion::rotation(35.0_degf, Vector3{0.3f, 0.7f, 0.1f}.normalized())},
+    {"two equal components", Quaternion::rotation(90.0_degf, Vector3::zAxis())}
+};
+
+QuantizationTest::QuantizationTest() {
+    addInstancedTests({&QuantizationTest::packUnpackQuaternion},
+        Containers::arraySize(PackUnpackQuaternionData));
+
+    addTests({&QuantizationTest::packQuaternionNegative,
+              &QuantizationTest::packQuaternionNotNormalized,
+              &QuantizationTest::slerpSmallestThree,
+
+              &QuantizationTest::translationExponent,
+              &QuantizationTest::packUnpackTranslation,
+              &QuantizationTest::packTranslationClamp,
+              &QuantizationTest::packTranslationInvalidExponent,
+              &QuantizationTest::translationInterpolator,
+              &QuantizationTest::translationInterpolatorInvalidExponent});
+}
+
+void QuantizationTest::packUnpackQuaternion() {
+    auto&& data = PackUnpackQuaternionData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Quaternion unpacked = unpackQuaternionSmallestThree(packQuaternionSmallestThree(data.rotation));
+    CORRADE_VERIFY(unpacked.isNormalized());
+
+    /* The sign might get flipped */
+    const Quaternion expected = Math::dot(unpacked, data.rotation) < 0.0f ? -data.rotation : data.rotation;
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_WITH(unpacked.vector()[i], expected.vector()[i],
+            TestSuite::Compare::around(0.00006f));
+    }
+    CORRADE_COMPARE_WITH(unpacked.scalar(), expected.scalar(),
+        TestSuite::Compare::around(0.00006f));
+}
+
+void QuantizationTest::packQuaternionNegative() {
+    /* A quaternion with the largest component negative is the same rotation
+       as its negation, so the packed value should be the same */
+    const Quaternion a = Quaternion::rotation(35.0_degf, Vector3{0.3f, 0.7f, 0.1f}.normalized());
+    CORRADE_COMPARE(packQuaternionSmallestThree(-a), packQuaternionSmallestThree(a));
+}
+
+void QuantizationTest::packQuaternionNotNormalized() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    packQuaternionSmallestThree(Quaternion{{1.0f, 2.0f, 3.0f}, 4.0f});
+    CORRADE_COMPARE(out.str(), "Animation::packQuaternionSmallestThree(): Quaternion({1, 2, 3}, 4) is not normalized\n");
+}
+
+void QuantizationTest::slerpSmallestThree() {
+    const Quaternion a = Quaternion::rotation(20.0_degf, Vector3::xAxis());
+    const Quaternion b = Quaternion::rotation(80.0_degf, Vector3::xAxis());
+
+    const Float keys[]{0.0f, 2.0f};
+    const Vector3us values[]{
+        packQuaternionSmallestThree(a),
+        /* Sign-flipped, should still interpolate the shortest path */
+        packQuaternionSmallestThree(-b)
+    };
+    const TrackView<const Float, const Vector3us, Quaternion> track{keys, values, Animation::slerpSmallestThree};
+
+    const Quaternion result = track.at(0.5f);
+    const Quaternion expected = Quaternion::rotation(35.0_degf, Vector3::xAxis());
+    CORRADE_COMPARE_WITH(Math::abs(Math::dot(result, expected)), 1.0f,
+        TestSuite::Compare::around(0.00001f));
+}
+
+void QuantizationTest::translationExponent() {
+    CORRADE_COMPARE(quantizedTranslationExponent(0.0f), QuantizedTranslationMinExponent);
+    CORRADE_COMPARE(quantizedTranslationExponent(0.001f), QuantizedTranslationMinExponent);
+    CORRADE_COMPARE(quantizedTranslationExponent(0.75f), 0);
+    CORRADE_COMPARE(quantizedTranslationExponent(1.0f), 0);
+    CORRADE_COMPARE(quantizedTranslationExponent(1.0001f), 1);
+    CORRADE_COMPARE(quantizedTranslationExponent(3.0f), 2);
+    CORRADE_COMPARE(quantizedTranslationExponent(4.0f), 2);
+    CORRADE_COMPARE(quantizedTranslationExponent(1.0e6f), QuantizedTranslationMaxExponent);
+}
+
+void QuantizationTest::packUnpackTranslation() {
+    const Vector3 translation{3.5f, -0.25f, 1.0f};
+    const Int exponent = quantizedTranslationExponent(3.5f);
+    CORRADE_COMPARE(exponent, 2);
+
+    const Vector3s packed = packTranslation(translation, exponent);
+    CORRADE_COMPARE(packed, (Vector3s{28671, -2048, 8192}));
+
+    const Vector3 unpacked = unpackTranslation(packed, exponent);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_WITH(unpacked[i], translation[i],
+            TestSuite::Compare::around(4.0f/32767.0f));
+    }
+}
+
+void QuantizationTest::packTranslationClamp() {
+    CORRADE_COMPARE(packTranslation({5.0f, -5.0f, 0.0f}, 2),
+        (Vector3s{32767, -32767, 0}));
+}
+
+void QuantizationTest::packTranslationInvalidExponent() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    packTranslation({}, 16);
+    unpackTranslation({}, -9);
+    CORRADE_COMPARE(out.str(),
+        "Animation::packTranslation(): expected exponent in range [-8, 15] but got 16\n"
+        "Animation::unpackTranslation(): expected exponent in range [-8, 15] but got -9\n");
+}
+
+void QuantizationTest::translationInterpolator() {
+    const Float keys[]{1.0f, 3.0f};
+    const Vector3s values[]{
+        packTranslation({-2.0f, 0.5f, 6.0f}, 3),
+        packTranslation({2.0f, 1.5f, -6.0f}, 3)
+    };
+    const TrackView<const Float, const Vector3s, Vector3> track{keys, values, quantizedTranslationInterpolator(3)};
+
+    const Vector3 result = track.at(1.5f);
+    const Vector3 expected{-1.0f, 0.75f, 3.0f};
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_WITH(result[i], expected[i],
+            TestSuite::Compare::around(8.0f/32767.0f));
+    }
+
+    /* Different exponents should give different functions */
+    CORRADE_VERIFY(quantizedTranslationInterpolator(3) != quantizedTranslationInterpolator(4));
+}
+
+void QuantizationTest::translationInterpolatorInvalidExponent() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    quantizedTranslationInterpolator(16);
+    CORRADE_COMPARE(out.str(), "Animation::quantizedTranslationInterpolator(): expected exponent in range [-8, 15] but got 16\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Animation::Test::QuantizationTest)
@@ -0,0 +1,294 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Animation/Player.h"
+#include "Magnum/Animation/TrackBatch.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Animation { namespace Test { namespace {
+
+struct TrackBatchTest: TestSuite::Tester {
+    explicit TrackBatchTest();
+
+    void constructEmpty();
+    void add();
+    void addInterpolatorMismatch();
+
+    void advance();
+    void advanceEmptySingle();
+    void advanceHint();
+    void at();
+    void atInvalidSize();
+
+    void player();
+};
+
+/* Same as in TrackViewTest */
+const struct {
+    const char* name;
+    Extrapolation extrapolationBefore;
+    Extrapolation extrapolationAfter;
+    Float time;
+} AdvanceData[] {
+    {"before default-constructed",
+        Extrapolation::DefaultConstructed, Extrapolation::Extrapolated, -1.0f},
+    {"before constant",
+        Extrapolation::Constant, Extrapolation::Extrapolated, -1.0f},
+    {"before extrapolated",
+        Extrapolation::Extrapolated, Extrapolation::DefaultConstructed, -1.0f},
+    {"during first",
+        Extrapolation::DefaultConstructed, Extrapolation::DefaultConstructed, 1.5f},
+    {"during second",
+        Extrapolation::DefaultConstructed, Extrapolation::DefaultConstructed, 4.75f},
+    {"after default-constructed",
+        Extrapolation::Extrapolated, Extrapolation::DefaultConstructed, 6.0f},
+    {"after constant",
+        Extrapolation::Extrapolated, Extrapolation::Constant, 6.0f},
+    {"after extrapolated",
+        Extrapolation::DefaultConstructed, Extrapolation::Extrapolated, 6.0f}
+};
+
+TrackBatchTest::TrackBatchTest() {
+    addTests({&TrackBatchTest::constructEmpty,
+              &TrackBatchTest::add,
+              &TrackBatchTest::addInterpolatorMismatch});
+
+    addInstancedTests({&TrackBatchTest::advance},
+        Containers::arraySize(AdvanceData));
+
+    addTests({&TrackBatchTest::advanceEmptySingle,
+              &TrackBatchTest::advanceHint,
+              &TrackBatchTest::at,
+              &TrackBatchTest::atInvalidSize,
+
+              &TrackBatchTest::player});
+}
+
+const Float Keys[]{0.0f, 2.0f, 4.0f, 5.0f};
+const Float OtherKeys[]{-1.0f, 1.0f, 3.0f, 4.5f, 7.0f};
+const Float ValuesA[]{3.0f, 1.0f, 2.5f, 0.5f};
+const Float ValuesB[]{-1.0f, 0.0f, 4.0f, 2.0f};
+const Float ValuesC[]{0.5f, 2.0f, 1.5f, -3.0f, 1.0f};
+
+void TrackBatchTest::constructEmpty() {
+    TrackBatch<Float, Vector3> batch{Math::lerp};
+
+    CORRADE_COMPARE(batch.interpolator(), Math::lerp);
+    CORRADE_VERIFY(batch.isEmpty());
+    CORRADE_COMPARE(batch.size(), 0);
+    CORRADE_COMPARE(batch.keyGroupCount(), 0);
+    CORRADE_COMPARE(batch.duration(), Range1D{});
+
+    /* Shouldn't crash or anything */
+    batch.advance(1.0f);
+    batch.at(1.0f, nullptr);
+}
+
+void TrackBatchTest::add() {
+    const TrackView<const Float, const Float> a{Keys, ValuesA, Math::lerp};
+    const TrackView<const Float, const Float> b{Keys, ValuesB, Math::lerp};
+    const TrackView<const Float, const Float> c{OtherKeys, ValuesC, Math::lerp};
+    /* Same keys as a, but different extrapolation, so can't share the key
+       search */
+    const TrackView<const Float, const Float> d{Keys, ValuesB, Math::lerp,
+        Extrapolation::Constant, Extrapolation::DefaultConstructed};
+
+    Float valueA, valueB, valueD;
+    TrackBatch<Float, Float> batch{Math::lerp};
+    batch.add(a, valueA)
+         .add(b, valueB)
+         .add(c)
+         .add(d, valueD);
+
+    CORRADE_VERIFY(!batch.isEmpty());
+    CORRADE_COMPARE(batch.size(), 4);
+    CORRADE_COMPARE(batch.keyGroupCount(), 3);
+    CORRADE_COMPARE(batch.duration(), (Range1D{-1.0f, 7.0f}));
+}
+
+void TrackBatchTest::addInterpolatorMismatch() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const TrackView<const Float, const Float> a{Keys, ValuesA, Math::select};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    TrackBatch<Float, Float> batch{Math::lerp};
+    batch.add(a);
+
+    CORRADE_COMPARE(batch.size(), 0);
+    CORRADE_COMPARE(out.str(), "Animation::TrackBatch::add(): track interpolator doesn't match the batch\n");
+}
+
+void TrackBatchTest::advance() {
+    const auto& data = AdvanceData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const TrackView<const Float, const Float> a{Keys, ValuesA, Math::lerp,
+        data.extrapolationBefore, data.extrapolationAfter};
+    const TrackView<const Float, const Float> b{Keys, ValuesB, Math::lerp,
+        data.extrapolationBefore, data.extrapolationAfter};
+    const TrackView<const Float, const Float> c{OtherKeys, ValuesC, Math::lerp,
+        data.extrapolationBefore, data.extrapolationAfter};
+
+    Float valueA = 100.0f, valueB = 100.0f, valueC = 100.0f;
+    TrackBatch<Float, Float> batch{Math::lerp};
+    batch.add(a, valueA)
+         .add(b, valueB)
+         .add(c, valueC);
+    CORRADE_COMPARE(batch.keyGroupCount(), 2);
+
+    /* The result should be the same as when evaluating each track
+       separately */
+    batch.advance(data.time);
+    CORRADE_COMPARE(valueA, a.at(data.time));
+    CORRADE_COMPARE(valueB, b.at(data.time));
+    CORRADE_COMPARE(valueC, c.at(data.time));
+}
+
+void TrackBatchTest::advanceEmptySingle() {
+    const Float singleKey[]{2.0f};
+    const Vector3 singleValue[]{{1.0f, 2.0f, 3.0f}};
+    const TrackView<const Float, const Vector3> empty{
+        Containers::StridedArrayView1D<const Float>{},
+        Containers::StridedArrayView1D<const Vector3>{}, Math::lerp};
+    const TrackView<const Float, const Vector3> single{singleKey, singleValue, Math::lerp};
+    const TrackView<const Float, const Vector3> singleDefault{singleKey, singleValue, Math::lerp, Extrapolation::DefaultConstructed};
+
+    Vector3 valueEmpty{1.0f}, valueSingle, valueSingleDefault;
+    TrackBatch<Float, Vector3> batch{Math::lerp};
+    batch.add(empty, valueEmpty)
+         .add(single, valueSingle)
+         .add(singleDefault, valueSingleDefault);
+    CORRADE_COMPARE(batch.keyGroupCount(), 3);
+
+    batch.advance(2.0f);
+    CORRADE_COMPARE(valueEmpty, Vector3{});
+    CORRADE_COMPARE(valueSingle, (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(valueSingleDefault, (Vector3{1.0f, 2.0f, 3.0f}));
+
+    batch.advance(3.0f);
+    CORRADE_COMPARE(valueEmpty, Vector3{});
+    CORRADE_COMPARE(valueSingle, (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(valueSingleDefault, Vector3{});
+}
+
+void TrackBatchTest::advanceHint() {
+    const TrackView<const Float, const Float> a{Keys, ValuesA, Math::lerp};
+    const TrackView<const Float, const Float> c{OtherKeys, ValuesC, Math::lerp};
+
+    Float valueA, valueC;
+    TrackBatch<Float, Float> batch{Math::lerp};
+    batch.add(a, valueA)
+         .add(c, valueC);
+
+    /* Going back and forth through the whole range, the hint kept inside the
+       batch should not affect the result in any way */
+    for(Float time: {-2.0f, 0.5f, 4.75f, 3.0f, 1.0f, 6.5f, 8.0f, 2.5f, -0.5f, 4.5f}) {
+        CORRADE_ITERATION(time);
+        batch.advance(time);
+        CORRADE_COMPARE(valueA, a.at(time));
+        CORRADE_COMPARE(valueC, c.at(time));
+    }
+}
+
+void TrackBatchTest::at() {
+    const TrackView<const Float, const Float> a{Keys, ValuesA, Math::lerp};
+    const TrackView<const Float, const Float> b{Keys, ValuesB, Math::lerp};
+    const TrackView<const Float, const Float> c{OtherKeys, ValuesC, Math::lerp};
+
+    Float valueA = 100.0f;
+    TrackBatch<Float, Float> batch{Math::lerp};
+    batch.add(a, valueA)
+         .add(b)
+         .add(c);
+
+    /* Writing into every other item of a strided view */
+    Float out[6]{};
+    batch.at(4.75f, Containers::stridedArrayView(out).every(2));
+    CORRADE_COMPARE(out[0], a.at(4.75f));
+    CORRADE_COMPARE(out[1], 0.0f);
+    CORRADE_COMPARE(out[2], b.at(4.75f));
+    CORRADE_COMPARE(out[3], 0.0f);
+    CORRADE_COMPARE(out[4], c.at(4.75f));
+    CORRADE_COMPARE(out[5], 0.0f);
+
+    /* Destinations are not touched */
+    CORRADE_COMPARE(valueA, 100.0f);
+}
+
+void TrackBatchTest::atInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const TrackView<const Float, const Float> a{Keys, ValuesA, Math::lerp};
+
+    TrackBatch<Float, Float> batch{Math::lerp};
+    batch.add(a)
+         .add(a);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Float values[3];
+    batch.at(1.0f, values);
+
+    CORRADE_COMPARE(out.str(), "Animation::TrackBatch::at(): expected destination view of size 2 but got 3\n");
+}
+
+void TrackBatchTest::player() {
+    const TrackView<const Float, const Float> a{Keys, ValuesA, Math::lerp};
+    const TrackView<const Float, const Float> b{Keys, ValuesB, Math::lerp};
+    const TrackView<const Float, const Float> c{OtherKeys, ValuesC, Math::lerp};
+
+    Float valueA = 100.0f, valueB = 100.0f, valueC = 100.0f;
+    TrackBatch<Float, Float> batch{Math::lerp};
+    batch.add(a, valueA)
+         .add(b, valueB);
+
+    Player<Float> player;
+    player.add(batch)
+          .add(c, valueC);
+    CORRADE_COMPARE(player.size(), 2);
+    CORRADE_COMPARE(player.duration(), (Range1D{-1.0f, 7.0f}));
+
+    player.play(10.0f);
+    player.advance(15.75f);
+    CORRADE_COMPARE(valueA, a.at(4.75f));
+    CORRADE_COMPARE(valueB, b.at(4.75f));
+    CORRADE_COMPARE(valueC, c.at(4.75f));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Animation::Test::TrackBatchTest)
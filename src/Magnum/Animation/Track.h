@@ -76,9 +76,11 @@ performance. You have the following options:
 @subsection Animation-Track-performance-hint Keyframe hinting
 
 The @ref Track and @ref TrackView classes are fully stateless and the
-@ref at(K) const function performs a linear search for matching keyframe from
-the beginning every time. You can use @ref at(K, std::size_t&) const to
-remember last used keyframe index and pass it in the next iteration as a hint:
+@ref at(K) const function performs a logarithmic search for matching keyframe
+from the beginning every time. You can use @ref at(K, std::size_t&) const to
+remember last used keyframe index and pass it in the next iteration as a hint,
+which makes the lookup constant-time for sequential playback in either
+direction and keeps it logarithmic in the distance from the hint when seeking:
 
 @snippet MagnumAnimation.cpp Track-performance-hint
 
@@ -348,7 +350,7 @@ template<class K, class V, class R
          * @brief Animated value at a given time
          *
          * Calls @ref interpolate(), see its documentation for more
-         * information. Note that this function performs a linear search every
+         * information. Note that this function performs a full search every
          * time, use @ref at(K, std::size_t&) const to supply a search hint.
          * @see @ref atStrict(K, std::size_t&) const,
          *      @ref at(Interpolator, K) const
@@ -725,7 +727,7 @@ template<class K, class V, class R
          * @brief Animated value at a given time
          *
          * Calls @ref interpolate(), see its documentation for more
-         * information. Note that this function performs a linear search every
+         * information. Note that this function performs a full search every
          * time, use @ref at(K, std::size_t&) const to supply a search hint.
          * @see @ref atStrict(K, std::size_t&) const,
          *      @ref at(Interpolator, K) const
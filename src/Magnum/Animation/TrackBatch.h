@@ -0,0 +1,300 @@
+#ifndef Magnum_Animation_TrackBatch_h
+#define Magnum_Animation_TrackBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Animation::TrackBatch
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Animation/Track.h"
+
+namespace Magnum { namespace Animation {
+
+/**
+@brief Batch of animation tracks with the same interpolator
+@tparam K       Key type
+@tparam V       Value type
+@tparam R       Result type
+@m_since_latest
+
+Evaluates many tracks sharing the same value type and interpolator function
+together. Compared to adding each track to a @ref Player separately, where each
+track is advanced through a type-erased function pointer and the keyframe
+search is done for each track independently, the batch:
+
+-   stores the track views, keyframe hints and destinations in contiguous
+    arrays and evaluates them in two tight loops without any type erasure,
+-   groups tracks that share the same keys (i.e., the same key view and the
+    same extrapolation behavior) and does the keyframe search and the
+    interpolation factor calculation only once for each such group. This is
+    the common case for skinned characters, where rotation, translation and
+    scaling tracks of all joints are usually sampled at the same keyframes,
+-   can write the results into a strided view instead of separate
+    destinations, making it possible to write for example directly into a
+    joint transformation array.
+
+The result for each track is the same as calling
+@ref TrackView::at(K, std::size_t&) const on it.
+
+@section Animation-TrackBatch-usage Usage
+
+Add tracks together with their destination locations using @ref add(), then
+either call @ref advance() to update the destinations or @ref at() to write
+the results to a strided view. The batch can be also added to a @ref Player
+as a whole using @ref Player::add(TrackBatch<K, V, R>&), in which case it's
+advanced together with all other tracks in the player:
+
+@snippet MagnumAnimation.cpp TrackBatch-usage
+
+The batch references the track data, meaning the data have to stay in scope
+for the whole batch lifetime. Similarly, a batch added to a player has to stay
+in scope and not be moved for the whole player lifetime.
+@experimental
+*/
+template<class K, class V, class R
+    #ifdef DOXYGEN_GENERATING_OUTPUT
+    = ResultOf<V>
+    #endif
+> class TrackBatch {
+    public:
+        /** @brief Key type */
+        typedef K KeyType;
+
+        /** @brief Value type */
+        typedef V ValueType;
+
+        /** @brief Animation result type */
+        typedef R ResultType;
+
+        /** @brief Interpolation function */
+        typedef ResultType(*Interpolator)(const ValueType&, const ValueType&, Float);
+
+        /**
+         * @brief Constructor
+         * @param interpolator  Interpolator function shared by all tracks
+         *      in the batch
+         */
+        explicit TrackBatch(Interpolator interpolator) noexcept: _interpolator{interpolator} {}
+
+        /** @brief Interpolation function */
+        Interpolator interpolator() const { return _interpolator; }
+
+        /** @brief Whether the batch is empty */
+        bool isEmpty() const { return _tracks.empty(); }
+
+        /** @brief Count of tracks in the batch */
+        std::size_t size() const { return _tracks.size(); }
+
+        /**
+         * @brief Count of distinct key groups
+         *
+         * Tracks sharing the same key view and extrapolation behavior are put
+         * into the same group and the keyframe search is done only once for
+         * the whole group. The count is never larger than @ref size().
+         */
+        std::size_t keyGroupCount() const { return _keyGroups.size(); }
+
+        /**
+         * @brief Duration
+         *
+         * Union of durations of all tracks in the batch.
+         */
+        Math::Range1D<K> duration() const { return _duration; }
+
+        /**
+         * @brief Add a track with a destination location
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that interpolator of @p track is the same as
+         * @ref interpolator(). The @p destination is updated on each call to
+         * @ref advance(). Keyframe hint for the track is initialized to
+         * @cpp 0 @ce.
+         */
+        TrackBatch<K, V, R>& add(const TrackView<const K, const V, R>& track, R& destination) {
+            return addInternal(track, &destination);
+        }
+
+        /**
+         * @brief Add a track without a destination location
+         * @return Reference to self (for method chaining)
+         *
+         * Same as above, but the track is only evaluated in @ref at(),
+         * @ref advance() doesn't update anything for it.
+         */
+        TrackBatch<K, V, R>& add(const TrackView<const K, const V, R>& track) {
+            return addInternal(track, nullptr);
+        }
+
+        /**
+         * @brief Advance all tracks
+         *
+         * Evaluates all tracks at @p key and writes the results to their
+         * destination locations specified in @ref add(). Tracks that were
+         * added without a destination are skipped.
+         */
+        void advance(K key) {
+            evaluate(key, [](const Entry& entry, std::size_t, const R& result) {
+                if(entry.destination) *entry.destination = result;
+            });
+        }
+
+        /**
+         * @brief Evaluate all tracks into a strided view
+         *
+         * Evaluates all tracks at @p key and writes the result for track
+         * @cpp i @ce into @cpp destination[i] @ce. Expects that the
+         * @p destination size is equal to @ref size(). Destination locations
+         * specified in @ref add() are not updated.
+         */
+        void at(K key, const Containers::StridedArrayView1D<R>& destination) {
+            CORRADE_ASSERT(destination.size() == _tracks.size(),
+                "Animation::TrackBatch::at(): expected destination view of size" << _tracks.size() << "but got" << destination.size(), );
+            evaluate(key, [&destination](const Entry&, std::size_t i, const R& result) {
+                destination[i] = result;
+            });
+        }
+
+    private:
+        enum class Mode: UnsignedByte {
+            DefaultConstructed,
+            Single,
+            Interpolate
+        };
+
+        struct KeyGroup {
+            Containers::StridedArrayView1D<const K> keys;
+            Extrapolation before, after;
+            Mode mode;
+            std::size_t hint;
+            Float factor;
+        };
+
+        struct Entry {
+            Containers::StridedArrayView1D<const V> values;
+            std::size_t keyGroup;
+            R* destination;
+        };
+
+        TrackBatch<K, V, R>& addInternal(const TrackView<const K, const V, R>& track, R* destination);
+
+        template<class Output> void evaluate(K key, Output output);
+
+        Interpolator _interpolator;
+        Containers::Array<KeyGroup> _keyGroups;
+        Containers::Array<Entry> _tracks;
+        Math::Range1D<K> _duration;
+};
+
+template<class K, class V, class R> TrackBatch<K, V, R>& TrackBatch<K, V, R>::addInternal(const TrackView<const K, const V, R>& track, R* const destination) {
+    CORRADE_ASSERT(track.interpolator() == _interpolator,
+        "Animation::TrackBatch::add(): track interpolator doesn't match the batch", *this);
+
+    /* Find a group with the same keys, if there's none, add a new one */
+    const Containers::StridedArrayView1D<const K> keys = track.keys();
+    std::size_t keyGroup = 0;
+    for(; keyGroup != _keyGroups.size(); ++keyGroup) {
+        const KeyGroup& g = _keyGroups[keyGroup];
+        if(g.keys.data() == keys.data() &&
+           g.keys.size() == keys.size() &&
+           g.keys.stride() == keys.stride() &&
+           g.before == track.before() && g.after == track.after())
+            break;
+    }
+    if(keyGroup == _keyGroups.size())
+        arrayAppend(_keyGroups, Containers::InPlaceInit, keys, track.before(), track.after(), Mode::DefaultConstructed, std::size_t{}, 0.0f);
+
+    if(_tracks.empty())
+        _duration = track.duration();
+    else
+        _duration = Math::join(track.duration(), _duration);
+
+    arrayAppend(_tracks, Containers::InPlaceInit, track.values(), keyGroup, destination);
+    return *this;
+}
+
+template<class K, class V, class R> template<class Output> void TrackBatch<K, V, R>::evaluate(const K key, Output output) {
+    /* First find the keyframes and interpolation factors for all key groups.
+       This has to follow the logic in interpolate() exactly. */
+    for(KeyGroup& g: _keyGroups) {
+        const std::size_t size = g.keys.size();
+
+        /* No data, default-constructed value */
+        if(!size) {
+            g.mode = Mode::DefaultConstructed;
+            continue;
+        }
+
+        /* Only one frame, use it verbatim (or default-constructed, if
+           desired) */
+        if(size == 1) {
+            g.mode =
+                (key < g.keys[0] && g.before == Extrapolation::DefaultConstructed) ||
+                (key > g.keys[0] && g.after == Extrapolation::DefaultConstructed) ?
+                Mode::DefaultConstructed : Mode::Single;
+            continue;
+        }
+
+        g.hint = Implementation::keyframeFor(g.keys, key, g.hint);
+
+        K frame = key;
+        if(frame < g.keys[g.hint]) {
+            if(g.before == Extrapolation::DefaultConstructed) {
+                g.mode = Mode::DefaultConstructed;
+                continue;
+            }
+            if(g.before == Extrapolation::Constant) frame = g.keys[g.hint];
+        } else if(frame >= g.keys[g.hint + 1]) {
+            if(g.after == Extrapolation::DefaultConstructed) {
+                g.mode = Mode::DefaultConstructed;
+                continue;
+            }
+            if(g.after == Extrapolation::Constant) frame = g.keys[g.hint + 1];
+        }
+
+        g.mode = Mode::Interpolate;
+        g.factor = Math::lerpInverted(Float(g.keys[g.hint]), Float(g.keys[g.hint + 1]), Float(frame));
+    }
+
+    /* Then interpolate all tracks in a tight loop */
+    for(std::size_t i = 0; i != _tracks.size(); ++i) {
+        const Entry& t = _tracks[i];
+        const KeyGroup& g = _keyGroups[t.keyGroup];
+        if(g.mode == Mode::Interpolate)
+            output(t, i, _interpolator(t.values[g.hint], t.values[g.hint + 1], g.factor));
+        else if(g.mode == Mode::Single)
+            output(t, i, _interpolator(t.values[0], t.values[0], 0.0f));
+        else
+            output(t, i, R{});
+    }
+}
+
+}}
+
+#endif
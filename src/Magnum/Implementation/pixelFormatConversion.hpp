@@ -0,0 +1,372 @@
+#ifndef Magnum_Implementation_pixelFormatConversion_hpp
+#define Magnum_Implementation_pixelFormatConversion_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/ColorBatch.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Math/Implementation/cpuFeatures.hpp"
+
+namespace Magnum { namespace Implementation {
+
+/* Shared by convertPixelFormatInto() and TextureTools::resampleInto(). Each
+   generic uncompressed format is described by a component type, component
+   size and channel count, the rows are decoded to and encoded from floats
+   using the batch APIs. */
+enum class PixelComponentType: UnsignedByte {
+    Unorm, Snorm, Srgb, UnsignedInteger, Integer, Half, Float
+};
+
+struct PixelFormatInfo {
+    PixelComponentType type;
+    UnsignedInt componentSize;
+    UnsignedInt channelCount;
+};
+
+inline PixelFormatInfo pixelFormatInfo(const PixelFormat format) {
+    switch(format) {
+        #define _c(size, suffix, type, componentSize)                       \
+            case PixelFormat::R ## size ## suffix:                          \
+                return {PixelComponentType::type, componentSize, 1};        \
+            case PixelFormat::RG ## size ## suffix:                         \
+                return {PixelComponentType::type, componentSize, 2};        \
+            case PixelFormat::RGB ## size ## suffix:                        \
+                return {PixelComponentType::type, componentSize, 3};        \
+            case PixelFormat::RGBA ## size ## suffix:                       \
+                return {PixelComponentType::type, componentSize, 4};
+        _c(8, Unorm, Unorm, 1)
+        _c(8, Snorm, Snorm, 1)
+        _c(8, Srgb, Srgb, 1)
+        _c(8, UI, UnsignedInteger, 1)
+        _c(8, I, Integer, 1)
+        _c(16, Unorm, Unorm, 2)
+        _c(16, Snorm, Snorm, 2)
+        _c(16, UI, UnsignedInteger, 2)
+        _c(16, I, Integer, 2)
+        _c(32, UI, UnsignedInteger, 4)
+        _c(32, I, Integer, 4)
+        _c(16, F, Half, 2)
+        _c(32, F, Float, 4)
+        #undef _c
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Bit representation of 1 in given component type, used to fill the alpha
+   channel */
+inline UnsignedInt pixelComponentOne(const PixelFormatInfo& info) {
+    switch(info.type) {
+        case PixelComponentType::Unorm:
+        case PixelComponentType::Srgb:
+            return info.componentSize == 1 ? 0xff : 0xffff;
+        case PixelComponentType::Snorm:
+            return info.componentSize == 1 ? 0x7f : 0x7fff;
+        case PixelComponentType::UnsignedInteger:
+        case PixelComponentType::Integer:
+            return 1;
+        case PixelComponentType::Half:
+            return 0x3c00;
+        case PixelComponentType::Float:
+            return 0x3f800000;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* For sRGB formats the alpha channel is linear */
+inline void decodePixelRow(const PixelFormatInfo& info, const Containers::StridedArrayView2D<const char>& src, const Containers::StridedArrayView2D<Float>& dst) {
+    switch(info.type) {
+        case PixelComponentType::Unorm:
+            if(info.componentSize == 1)
+                Math::unpackInto(Containers::arrayCast<2, const UnsignedByte>(src), dst);
+            else
+                Math::unpackInto(Containers::arrayCast<2, const UnsignedShort>(src), dst);
+            return;
+        case PixelComponentType::Snorm:
+            if(info.componentSize == 1)
+                Math::unpackInto(Containers::arrayCast<2, const Byte>(src), dst);
+            else
+                Math::unpackInto(Containers::arrayCast<2, const Short>(src), dst);
+            return;
+        case PixelComponentType::Srgb: {
+            const auto srgb = Containers::arrayCast<2, const UnsignedByte>(src);
+            if(info.channelCount == 4) {
+                const std::size_t width = srgb.size()[0];
+                Math::fromSrgbInto(srgb.slice({0, 0}, {width, 3}), dst.slice({0, 0}, {width, 3}));
+                Math::unpackInto(srgb.slice({0, 3}, {width, 4}), dst.slice({0, 3}, {width, 4}));
+            } else Math::fromSrgbInto(srgb, dst);
+            return;
+        }
+        case PixelComponentType::UnsignedInteger:
+            if(info.componentSize == 1)
+                Math::castInto(Containers::arrayCast<2, const UnsignedByte>(src), dst);
+            else if(info.componentSize == 2)
+                Math::castInto(Containers::arrayCast<2, const UnsignedShort>(src), dst);
+            else
+                Math::castInto(Containers::arrayCast<2, const UnsignedInt>(src), dst);
+            return;
+        case PixelComponentType::Integer:
+            if(info.componentSize == 1)
+                Math::castInto(Containers::arrayCast<2, const Byte>(src), dst);
+            else if(info.componentSize == 2)
+                Math::castInto(Containers::arrayCast<2, const Short>(src), dst);
+            else
+                Math::castInto(Containers::arrayCast<2, const Int>(src), dst);
+            return;
+        case PixelComponentType::Half:
+            Math::unpackHalfInto(Containers::arrayCast<2, const UnsignedShort>(src), dst);
+            return;
+        case PixelComponentType::Float:
+            Utility::copy(Containers::arrayCast<2, const Float>(src), dst);
+            return;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+inline void clampPixelRow(const Containers::ArrayView<Float> values, const Float min, const Float max) {
+    for(Float& value: values) value = Math::clamp(value, min, max);
+}
+
+/* Rounding to nearest and clamping to the range of the type. Done in doubles
+   as the range of 32-bit types isn't representable exactly in a float. */
+template<class T> void encodeIntegralPixelRow(const Containers::ArrayView<const Float> src, const Containers::StridedArrayView2D<T>& dst) {
+    constexpr Double min = Double(std::numeric_limits<T>::min());
+    constexpr Double max = Double(std::numeric_limits<T>::max());
+    const Float* value = src.data();
+    for(std::size_t i = 0; i != dst.size()[0]; ++i)
+        for(std::size_t c = 0; c != dst.size()[1]; ++c)
+            dst[i][c] = T(Math::clamp(std::round(Double(*value++)), min, max));
+}
+
+/* Normalized formats are clamped to their range, modifying src. The alpha
+   channel of sRGB formats is linear. */
+inline void encodePixelRow(const PixelFormatInfo& info, const Containers::ArrayView<Float> src, const Containers::StridedArrayView2D<char>& dst) {
+    const Containers::StridedArrayView2D<Float> srcView{src, {dst.size()[0], info.channelCount}};
+
+    switch(info.type) {
+        case PixelComponentType::Unorm:
+            clampPixelRow(src, 0.0f, 1.0f);
+            if(info.componentSize == 1)
+                Math::packInto(srcView, Containers::arrayCast<2, UnsignedByte>(dst));
+            else
+                Math::packInto(srcView, Containers::arrayCast<2, UnsignedShort>(dst));
+            return;
+        case PixelComponentType::Snorm:
+            clampPixelRow(src, -1.0f, 1.0f);
+            if(info.componentSize == 1)
+                Math::packInto(srcView, Containers::arrayCast<2, Byte>(dst));
+            else
+                Math::packInto(srcView, Containers::arrayCast<2, Short>(dst));
+            return;
+        case PixelComponentType::Srgb: {
+            clampPixelRow(src, 0.0f, 1.0f);
+            const auto srgb = Containers::arrayCast<2, UnsignedByte>(dst);
+            if(info.channelCount == 4) {
+                const std::size_t width = srgb.size()[0];
+                Math::toSrgbInto(srcView.slice({0, 0}, {width, 3}), srgb.slice({0, 0}, {width, 3}));
+                Math::packInto(srcView.slice({0, 3}, {width, 4}), srgb.slice({0, 3}, {width, 4}));
+            } else Math::toSrgbInto(srcView, srgb);
+            return;
+        }
+        case PixelComponentType::UnsignedInteger:
+            if(info.componentSize == 1)
+                encodeIntegralPixelRow(src, Containers::arrayCast<2, UnsignedByte>(dst));
+            else if(info.componentSize == 2)
+                encodeIntegralPixelRow(src, Containers::arrayCast<2, UnsignedShort>(dst));
+            else
+                encodeIntegralPixelRow(src, Containers::arrayCast<2, UnsignedInt>(dst));
+            return;
+        case PixelComponentType::Integer:
+            if(info.componentSize == 1)
+                encodeIntegralPixelRow(src, Containers::arrayCast<2, Byte>(dst));
+            else if(info.componentSize == 2)
+                encodeIntegralPixelRow(src, Containers::arrayCast<2, Short>(dst));
+            else
+                encodeIntegralPixelRow(src, Containers::arrayCast<2, Int>(dst));
+            return;
+        case PixelComponentType::Half:
+            Math::packHalfInto(srcView, Containers::arrayCast<2, UnsignedShort>(dst));
+            return;
+        case PixelComponentType::Float:
+            Utility::copy(srcView, Containers::arrayCast<2, Float>(dst));
+            return;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+inline bool isIntegerPixelComponentType(const PixelComponentType type) {
+    return type == PixelComponentType::UnsignedInteger ||
+           type == PixelComponentType::Integer;
+}
+
+/* Conversion between integer formats of different types or sizes. Done in
+   64-bit integers, which can represent all values of the 32-bit types
+   exactly, unlike floats. */
+template<class T> void decodeIntegerPixelRow(const Containers::StridedArrayView2D<const T>& src, Long* dst) {
+    for(std::size_t i = 0; i != src.size()[0]; ++i)
+        for(std::size_t c = 0; c != src.size()[1]; ++c)
+            *dst++ = src[i][c];
+}
+
+inline void decodeIntegerPixelRow(const PixelFormatInfo& info, const Containers::StridedArrayView2D<const char>& src, const Containers::ArrayView<Long> dst) {
+    CORRADE_INTERNAL_ASSERT(dst.size() == src.size()[0]*info.channelCount);
+    if(info.type == PixelComponentType::UnsignedInteger) {
+        if(info.componentSize == 1)
+            decodeIntegerPixelRow(Containers::arrayCast<2, const UnsignedByte>(src), dst.data());
+        else if(info.componentSize == 2)
+            decodeIntegerPixelRow(Containers::arrayCast<2, const UnsignedShort>(src), dst.data());
+        else
+            decodeIntegerPixelRow(Containers::arrayCast<2, const UnsignedInt>(src), dst.data());
+    } else {
+        CORRADE_INTERNAL_ASSERT(info.type == PixelComponentType::Integer);
+        if(info.componentSize == 1)
+            decodeIntegerPixelRow(Containers::arrayCast<2, const Byte>(src), dst.data());
+        else if(info.componentSize == 2)
+            decodeIntegerPixelRow(Containers::arrayCast<2, const Short>(src), dst.data());
+        else
+            decodeIntegerPixelRow(Containers::arrayCast<2, const Int>(src), dst.data());
+    }
+}
+
+/* Clamping to the range of the type */
+template<class T> void encodeIntegerPixelRow(const Long* src, const Containers::StridedArrayView2D<T>& dst) {
+    constexpr Long min = Long(std::numeric_limits<T>::min());
+    constexpr Long max = Long(std::numeric_limits<T>::max());
+    for(std::size_t i = 0; i != dst.size()[0]; ++i)
+        for(std::size_t c = 0; c != dst.size()[1]; ++c)
+            dst[i][c] = T(Math::clamp(*src++, min, max));
+}
+
+inline void encodeIntegerPixelRow(const PixelFormatInfo& info, const Containers::ArrayView<const Long> src, const Containers::StridedArrayView2D<char>& dst) {
+    CORRADE_INTERNAL_ASSERT(src.size() == dst.size()[0]*info.channelCount);
+    if(info.type == PixelComponentType::UnsignedInteger) {
+        if(info.componentSize == 1)
+            encodeIntegerPixelRow(src.data(), Containers::arrayCast<2, UnsignedByte>(dst));
+        else if(info.componentSize == 2)
+            encodeIntegerPixelRow(src.data(), Containers::arrayCast<2, UnsignedShort>(dst));
+        else
+            encodeIntegerPixelRow(src.data(), Containers::arrayCast<2, UnsignedInt>(dst));
+    } else {
+        CORRADE_INTERNAL_ASSERT(info.type == PixelComponentType::Integer);
+        if(info.componentSize == 1)
+            encodeIntegerPixelRow(src.data(), Containers::arrayCast<2, Byte>(dst));
+        else if(info.componentSize == 2)
+            encodeIntegerPixelRow(src.data(), Containers::arrayCast<2, Short>(dst));
+        else
+            encodeIntegerPixelRow(src.data(), Containers::arrayCast<2, Int>(dst));
+    }
+}
+
+/* Source channel for each destination channel, or one of the following for
+   channels that aren't in the source. A single-channel source is broadcast to
+   RGB, other missing channels are zero, missing alpha is one. With
+   swapRedBlue the source is treated as BGR(A). */
+enum: Byte {
+    PixelChannelZero = -1,
+    PixelChannelOne = -2
+};
+
+inline void pixelChannelMapping(const UnsignedInt srcChannels, const UnsignedInt dstChannels, const bool swapRedBlue, Byte(&mapping)[4]) {
+    for(UnsignedInt c = 0; c != 4; ++c) {
+        if(c >= dstChannels)
+            mapping[c] = PixelChannelZero;
+        else if(srcChannels == 1 && c < 3)
+            mapping[c] = 0;
+        else if(c < srcChannels)
+            mapping[c] = (swapRedBlue && c != 1 && c != 3) ? 2 - c : c;
+        else
+            mapping[c] = c == 3 ? PixelChannelOne : PixelChannelZero;
+    }
+}
+
+/* Channel remapping between formats with the same component type, done on
+   the bit representation */
+template<class T> void remapPixelRowScalar(const T* src, T* dst, const std::size_t count, const UnsignedInt srcChannels, const UnsignedInt dstChannels, const Byte(&mapping)[4], const T one) {
+    for(std::size_t i = 0; i != count; ++i, src += srcChannels, dst += dstChannels) {
+        /* Read everything first so it works in-place as well */
+        T pixel[4];
+        for(UnsignedInt c = 0; c != dstChannels; ++c)
+            pixel[c] = mapping[c] >= 0 ? src[mapping[c]] :
+                mapping[c] == PixelChannelOne ? one : T{};
+        for(UnsignedInt c = 0; c != dstChannels; ++c)
+            dst[c] = pixel[c];
+    }
+}
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+/* Remapping of 8-bit components four pixels at a time with a byte shuffle,
+   missing channels filled with a constant. PSHUFB is SSSE3, which is implied
+   by SSE4.1. Sixteen bytes of the source are loaded at once, so the rest of
+   the row where less than that is left is done by the scalar code. */
+MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 inline void remapPixelRow8Sse41(const UnsignedByte* src, UnsignedByte* dst, const std::size_t count, const UnsignedInt srcChannels, const UnsignedInt dstChannels, const Byte(&mapping)[4], const UnsignedByte one) {
+    alignas(16) UnsignedByte shuffle[16], fill[16];
+    for(UnsignedInt i = 0; i != 16; ++i) {
+        const UnsignedInt pixel = i/dstChannels;
+        const Byte channel = mapping[i%dstChannels];
+        shuffle[i] = pixel < 4 && channel >= 0 ? UnsignedByte(pixel*srcChannels + channel) : 0x80;
+        fill[i] = pixel < 4 && channel == PixelChannelOne ? one : 0;
+    }
+    const __m128i shuffleMask = _mm_load_si128(reinterpret_cast<const __m128i*>(shuffle));
+    const __m128i fillMask = _mm_load_si128(reinterpret_cast<const __m128i*>(fill));
+
+    std::size_t i = 0;
+    for(; (count - i)*srcChannels >= 16; i += 4, src += 4*srcChannels, dst += 4*dstChannels) {
+        const __m128i pixels = _mm_or_si128(_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), shuffleMask), fillMask);
+        if(dstChannels == 4)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), pixels);
+        else {
+            alignas(16) UnsignedByte out[16];
+            _mm_store_si128(reinterpret_cast<__m128i*>(out), pixels);
+            std::memcpy(dst, out, 4*dstChannels);
+        }
+    }
+
+    remapPixelRowScalar(src, dst, count - i, srcChannels, dstChannels, mapping, one);
+}
+#endif
+
+inline void remapPixelRow8(const UnsignedByte* src, UnsignedByte* dst, const std::size_t count, const UnsignedInt srcChannels, const UnsignedInt dstChannels, const Byte(&mapping)[4], const UnsignedByte one) {
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+    if(Math::Implementation::cpuFeatures().sse41)
+        return remapPixelRow8Sse41(src, dst, count, srcChannels, dstChannels, mapping, one);
+    #endif
+    remapPixelRowScalar(src, dst, count, srcChannels, dstChannels, mapping, one);
+}
+
+}}
+
+#endif
@@ -117,7 +117,9 @@ template<std::size_t size, std::size_t cols, class T> bool gaussJordanInPlace(Re
 Uses the [Gauss-Jordan elimination](https://en.wikipedia.org/wiki/Gaussian_elimination#Finding_the_inverse_of_a_matrix) to perform a matrix
 inversion. Since @f$ (\boldsymbol{A}^{-1})^T = (\boldsymbol{A}^T)^{-1} @f$,
 passes @p matrix and an identity matrix to @ref gaussJordanInPlaceTransposed();
-returning the inverted matrix. Expects that the matrix is invertible.
+returning the inverted matrix. Expects that the matrix is invertible. For 3x3
+and 4x4 matrices, @ref Matrix::inverted() uses a closed-form expression that's
+considerably faster.
 @see @ref Matrix::inverted()
 */
 template<std::size_t size, class T> Matrix<size, T> gaussJordanInverted(Matrix<size, T> matrix) {
@@ -26,9 +26,12 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::Math::Algorithms::qr()
+ * @brief Function @ref Magnum::Math::Algorithms::qr(), @ref Magnum::Math::Algorithms::qrInto()
  */
 
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Matrix.h"
 #include "Magnum/Math/Algorithms/GramSchmidt.h"
 
 namespace Magnum { namespace Math { namespace Algorithms {
@@ -58,7 +61,13 @@ One possible use is to decompose a transformation matrix into separate rotation
 and scaling/shear parts. Note, however, that the decomposition is not unique.
 See the [associated test case](https://github.com/mosra/magnum/blob/master/src/Magnum/Math/Algorithms/Test/QrTest.cpp)
 for an example.
-@see @ref svd(), @ref Matrix3::rotationShear(), @ref Matrix4::rotationShear()
+
+For 3x3 and 4x4 matrices an unrolled variant is used instead, which takes the
+off-diagonal elements of @f$ \boldsymbol{R} @f$ directly from the projections
+done during the orthonormalization instead of calculating all dot products
+again. The result is the same up to rounding errors.
+@see @ref qrInto(), @ref svd(), @ref Matrix3::rotationShear(),
+    @ref Matrix4::rotationShear()
 */
 template<std::size_t size, class T> std::pair<Matrix<size, T>, Matrix<size, T>> qr(const Matrix<size, T>& matrix) {
     const Matrix<size, T> q = gramSchmidtOrthonormalize(matrix);
@@ -72,6 +81,99 @@ template<std::size_t size, class T> std::pair<Matrix<size, T>, Matrix<size, T>>
     return {q, r};
 }
 
+/**
+@brief QR decomposition of a 3x3 matrix
+@m_since_latest
+
+Unrolled variant of @ref qr(const Matrix<size, T>&) for 3x3 matrices.
+*/
+template<class T> std::pair<Matrix3x3<T>, Matrix3x3<T>> qr(const Matrix3x3<T>& matrix) {
+    Matrix3x3<T> q{Magnum::NoInit};
+    Matrix3x3<T> r{ZeroInit};
+
+    r[0][0] = matrix[0].length();
+    q[0] = matrix[0]/r[0][0];
+
+    r[1][0] = Math::dot(q[0], matrix[1]);
+    r[2][0] = Math::dot(q[0], matrix[2]);
+    const Vector<3, T> v1 = matrix[1] - q[0]*r[1][0];
+    Vector<3, T> v2 = matrix[2] - q[0]*r[2][0];
+
+    r[1][1] = v1.length();
+    q[1] = v1/r[1][1];
+
+    r[2][1] = Math::dot(q[1], v2);
+    v2 -= q[1]*r[2][1];
+
+    r[2][2] = v2.length();
+    q[2] = v2/r[2][2];
+
+    return {q, r};
+}
+
+/**
+@brief QR decomposition of a 4x4 matrix
+@m_since_latest
+
+Unrolled variant of @ref qr(const Matrix<size, T>&) for 4x4 matrices.
+*/
+template<class T> std::pair<Matrix4x4<T>, Matrix4x4<T>> qr(const Matrix4x4<T>& matrix) {
+    Matrix4x4<T> q{Magnum::NoInit};
+    Matrix4x4<T> r{ZeroInit};
+
+    r[0][0] = matrix[0].length();
+    q[0] = matrix[0]/r[0][0];
+
+    r[1][0] = Math::dot(q[0], matrix[1]);
+    r[2][0] = Math::dot(q[0], matrix[2]);
+    r[3][0] = Math::dot(q[0], matrix[3]);
+    const Vector<4, T> v1 = matrix[1] - q[0]*r[1][0];
+    Vector<4, T> v2 = matrix[2] - q[0]*r[2][0];
+    Vector<4, T> v3 = matrix[3] - q[0]*r[3][0];
+
+    r[1][1] = v1.length();
+    q[1] = v1/r[1][1];
+
+    r[2][1] = Math::dot(q[1], v2);
+    r[3][1] = Math::dot(q[1], v3);
+    v2 -= q[1]*r[2][1];
+    v3 -= q[1]*r[3][1];
+
+    r[2][2] = v2.length();
+    q[2] = v2/r[2][2];
+
+    r[3][2] = Math::dot(q[2], v3);
+    v3 -= q[2]*r[3][2];
+
+    r[3][3] = v3.length();
+    q[3] = v3/r[3][3];
+
+    return {q, r};
+}
+
+/**
+@brief QR decomposition of a batch of matrices
+@param[in]  src     Input matrices
+@param[out] q       Where to put the @f$ \boldsymbol{Q} @f$ matrices
+@param[out] r       Where to put the @f$ \boldsymbol{R} @f$ matrices
+@m_since_latest
+
+Equivalent to calling @ref qr() on each matrix in @p src. Expects that all
+views have the same size.
+*/
+template<std::size_t size, class T> void qrInto(const Corrade::Containers::StridedArrayView1D<const Matrix<size, T>>& src, const Corrade::Containers::StridedArrayView1D<Matrix<size, T>>& q, const Corrade::Containers::StridedArrayView1D<Matrix<size, T>>& r) {
+    CORRADE_ASSERT(q.size() == src.size(),
+        "Math::Algorithms::qrInto(): wrong Q destination size, got" << q.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(r.size() == src.size(),
+        "Math::Algorithms::qrInto(): wrong R destination size, got" << r.size() << "but expected" << src.size(), );
+
+    for(std::size_t i = 0; i != src.size(); ++i) {
+        const std::pair<Matrix<size, T>, Matrix<size, T>> out = qr(src[i]);
+        q[i] = out.first;
+        r[i] = out.second;
+    }
+}
+
 }}}
 
 #endif
@@ -26,13 +26,16 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::Math::Algorithms::svd()
+ * @brief Function @ref Magnum::Math::Algorithms::svd(), @ref Magnum::Math::Algorithms::svdJacobi(), @ref Magnum::Math::Algorithms::svdJacobiInto()
  */
 
+#include <limits>
 #include <tuple>
+#include <Corrade/Containers/StridedArrayView.h>
 
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Matrix.h"
+#include "Magnum/Math/Vector3.h"
 
 namespace Magnum { namespace Math { namespace Algorithms {
 
@@ -53,6 +56,41 @@ template<class T> constexpr T smallestDelta();
 template<> constexpr Float smallestDelta<Float>() { return 1.0e-32f; }
 template<> constexpr Double smallestDelta<Double>() { return 1.0e-64; }
 
+/* One Jacobi rotation of columns p and q of a, making them orthogonal, and
+   the same rotation applied to columns of v. Returns false if the columns
+   are orthogonal already or one of them is negligible. The threshold is
+   twice the machine epsilon, with just the epsilon the iteration can cycle
+   on rounding errors for some Float inputs. */
+template<class T> bool svdJacobiRotate(Matrix3x3<T>& a, Matrix3x3<T>& v, const std::size_t p, const std::size_t q, const T negligible) {
+    const T alpha = a[p].dot();
+    const T beta = a[q].dot();
+    const T gamma = Math::dot(a[p], a[q]);
+    if(alpha <= negligible || beta <= negligible || std::abs(gamma) <= T(2)*std::numeric_limits<T>::epsilon()*std::sqrt(alpha*beta))
+        return false;
+
+    const T zeta = (beta - alpha)/(T(2)*gamma);
+    const T t = (zeta >= T(0) ? T(1) : T(-1))/(std::abs(zeta) + std::sqrt(T(1) + zeta*zeta));
+    const T c = T(1)/std::sqrt(T(1) + t*t);
+    const T s = c*t;
+
+    const Vector<3, T> ap = a[p];
+    a[p] = ap*c - a[q]*s;
+    a[q] = ap*s + a[q]*c;
+    const Vector<3, T> vp = v[p];
+    v[p] = vp*c - v[q]*s;
+    v[q] = vp*s + v[q]*c;
+    return true;
+}
+
+template<class T> void svdJacobiSortSwap(Matrix3x3<T>& a, Matrix3x3<T>& v, Vector3<T>& w, const std::size_t p, const std::size_t q) {
+    if(w[q] <= w[p]) return;
+
+    using std::swap;
+    swap(a[p], a[q]);
+    swap(v[p], v[q]);
+    swap(w[p], w[q]);
+}
+
 }
 
 /**
@@ -77,7 +115,8 @@ One possible use is to decompose a transformation matrix into separate rotation
 and scaling parts. Note, however, that the decomposition is not unique. See the
 [associated test case](https://github.com/mosra/magnum/blob/master/src/Magnum/Math/Algorithms/Test/SvdTest.cpp)
 for an example. Implementation based on *Golub, G. H.; Reinsch, C. (1970).
-"Singular value decomposition and least squares solutions"*.
+"Singular value decomposition and least squares solutions"*. For 3x3 matrices
+see also @ref svdJacobi(), which is significantly faster.
 @see @ref qr(), @ref Matrix3::rotationShear(), @ref Matrix4::rotationShear()
 */
 /* The matrix is passed by value because it is changed inside */
@@ -319,6 +358,110 @@ template<std::size_t cols, std::size_t rows, class T> std::tuple<RectangularMatr
     return std::make_tuple(m, q, v);
 }
 
+/**
+@brief Singular Value Decomposition of a 3x3 matrix
+@m_since_latest
+
+Calculates the decomposition @f[
+    \boldsymbol{M} = \boldsymbol{U} \boldsymbol{\Sigma} \boldsymbol{V}^*
+@f]
+
+using the one-sided Jacobi method, which repeatedly rotates pairs of columns
+of @f$ \boldsymbol{M} @f$ until they're all mutually orthogonal. Unlike
+@ref svd(), the work is done on a fixed set of three column pairs with no
+bidiagonalization and with the loop over sweeps usually terminating after four
+or five iterations, which makes it a good fit for cases like polar
+decomposition of deformation gradients done for each element of a mesh.
+
+Returns @f$ \boldsymbol{U} @f$, diagonal of @f$ \boldsymbol{\Sigma} @f$ and
+non-transposed @f$ \boldsymbol{V} @f$, which can be used to reconstruct the
+original matrix the same way as with @ref svd(). Both @f$ \boldsymbol{U} @f$ and
+@f$ \boldsymbol{V} @f$ are orthogonal. The singular values are non-negative
+and sorted from the largest, which is different from @ref svd() that returns
+them unsorted. For rank-deficient input the columns of @f$ \boldsymbol{U} @f$
+corresponding to zero singular values are filled so the matrix stays
+orthogonal. Since the decomposition is not unique, @f$ \boldsymbol{U} @f$ and
+@f$ \boldsymbol{V} @f$ can be reflections --- to get a rotation
+@f$ \boldsymbol{R} @f$ for a polar decomposition, negate the last column of
+@f$ \boldsymbol{U} @f$ if @f$ \det(\boldsymbol{U} \boldsymbol{V}^T) < 0 @f$
+and calculate @f$ \boldsymbol{R} = \boldsymbol{U} \boldsymbol{V}^T @f$.
+@see @ref svdJacobiInto(), @ref qr()
+*/
+template<class T> std::tuple<Matrix3x3<T>, Vector3<T>, Matrix3x3<T>> svdJacobi(const Matrix3x3<T>& m) {
+    Matrix3x3<T> a = m;
+    Matrix3x3<T> v{IdentityInit};
+
+    /* Columns shorter than this relative to the whole matrix are treated as
+       zero. Rotating them wouldn't improve the orthogonality in any way as
+       their directions are just rounding noise. */
+    const T negligible = (a[0].dot() + a[1].dot() + a[2].dot())*
+        Math::pow<2>(std::numeric_limits<T>::epsilon());
+
+    /* The non-short-circuiting | is intentional, all three rotations have to
+       be done in each sweep. Usually converges in four or five sweeps, the
+       limit is just a safety net. */
+    constexpr std::size_t maxSweeps = 12;
+    for(std::size_t sweep = 0; sweep != maxSweeps; ++sweep) {
+        if(!(Implementation::svdJacobiRotate(a, v, 0, 1, negligible) |
+             Implementation::svdJacobiRotate(a, v, 0, 2, negligible) |
+             Implementation::svdJacobiRotate(a, v, 1, 2, negligible)))
+            break;
+    }
+
+    /* Singular values are lengths of the orthogonalized columns, sort them
+       from the largest */
+    Vector3<T> w{a[0].length(), a[1].length(), a[2].length()};
+    Implementation::svdJacobiSortSwap(a, v, w, 0, 1);
+    Implementation::svdJacobiSortSwap(a, v, w, 0, 2);
+    Implementation::svdJacobiSortSwap(a, v, w, 1, 2);
+
+    /* U is then the normalized columns. If some of them are negligible,
+       complete the basis with perpendicular vectors. */
+    Matrix3x3<T> u{IdentityInit};
+    if(w[0] != T(0)) {
+        u[0] = a[0]/w[0];
+
+        if(Math::pow<2>(w[1]) > negligible) u[1] = a[1]/w[1];
+        else {
+            /* Cross with the axis the first column is the least aligned
+               with */
+            const Vector3<T> absolute = Math::abs(Vector3<T>{u[0]});
+            Vector3<T> axis;
+            axis[absolute[0] <= absolute[1] && absolute[0] <= absolute[2] ? 0 :
+                 absolute[1] <= absolute[2] ? 1 : 2] = T(1);
+            u[1] = Math::cross(Vector3<T>{u[0]}, axis).normalized();
+        }
+
+        if(Math::pow<2>(w[2]) > negligible) u[2] = a[2]/w[2];
+        else u[2] = Math::cross(Vector3<T>{u[0]}, Vector3<T>{u[1]});
+    }
+
+    return std::make_tuple(u, w, v);
+}
+
+/**
+@brief Singular Value Decomposition of a batch of 3x3 matrices
+@param[in]  src     Input matrices
+@param[out] u       Where to put the @f$ \boldsymbol{U} @f$ matrices
+@param[out] w       Where to put the singular values
+@param[out] v       Where to put the @f$ \boldsymbol{V} @f$ matrices
+@m_since_latest
+
+Equivalent to calling @ref svdJacobi() on each matrix in @p src. Expects that
+all views have the same size.
+*/
+template<class T> void svdJacobiInto(const Corrade::Containers::StridedArrayView1D<const Matrix3x3<T>>& src, const Corrade::Containers::StridedArrayView1D<Matrix3x3<T>>& u, const Corrade::Containers::StridedArrayView1D<Vector3<T>>& w, const Corrade::Containers::StridedArrayView1D<Matrix3x3<T>>& v) {
+    CORRADE_ASSERT(u.size() == src.size(),
+        "Math::Algorithms::svdJacobiInto(): wrong U destination size, got" << u.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(w.size() == src.size(),
+        "Math::Algorithms::svdJacobiInto(): wrong W destination size, got" << w.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(v.size() == src.size(),
+        "Math::Algorithms::svdJacobiInto(): wrong V destination size, got" << v.size() << "but expected" << src.size(), );
+
+    for(std::size_t i = 0; i != src.size(); ++i)
+        std::tie(u[i], w[i], v[i]) = svdJacobi(src[i]);
+}
+
 }}}
 
 #endif
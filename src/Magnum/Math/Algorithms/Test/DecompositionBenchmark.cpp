@@ -0,0 +1,130 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Algorithms/Qr.h"
+#include "Magnum/Math/Algorithms/Svd.h"
+
+namespace Magnum { namespace Math { namespace Algorithms { namespace Test { namespace {
+
+struct DecompositionBenchmark: Corrade::TestSuite::Tester {
+    explicit DecompositionBenchmark();
+
+    void svd3();
+    void svd3Jacobi();
+    void qr3();
+    void qr3Unrolled();
+    void qr4();
+    void qr4Unrolled();
+};
+
+typedef Math::Matrix3x3<Float> Matrix3x3;
+typedef Math::Matrix4x4<Float> Matrix4x4;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Vector3<Float> Vector3;
+
+enum: std::size_t { Repeats = 1000 };
+
+using namespace Literals;
+
+/* A deformation gradient-like matrix, rotation with non-uniform scaling and
+   a bit of shear */
+const Matrix4 Data4 = Matrix4::rotation(134.7_degf, Vector3{1.0f, 3.0f, -1.4f}.normalized())*Matrix4::scaling({1.1f, 0.9f, 1.05f})*Matrix4::shearingXY(0.1f, -0.05f);
+const Matrix3x3 Data3 = Data4.rotationScaling();
+
+DecompositionBenchmark::DecompositionBenchmark() {
+    addBenchmarks({&DecompositionBenchmark::svd3,
+                   &DecompositionBenchmark::svd3Jacobi,
+                   &DecompositionBenchmark::qr3,
+                   &DecompositionBenchmark::qr3Unrolled,
+                   &DecompositionBenchmark::qr4,
+                   &DecompositionBenchmark::qr4Unrolled}, 50);
+}
+
+void DecompositionBenchmark::svd3() {
+    Matrix3x3 a = Data3;
+    Vector3 sum;
+    CORRADE_BENCHMARK(Repeats) {
+        sum += std::get<1>(Algorithms::svd(a));
+        a[0][0] += 1.0e-6f;
+    }
+
+    CORRADE_VERIFY(sum.sum() != 0);
+}
+
+void DecompositionBenchmark::svd3Jacobi() {
+    Matrix3x3 a = Data3;
+    Vector3 sum;
+    CORRADE_BENCHMARK(Repeats) {
+        sum += std::get<1>(Algorithms::svdJacobi(a));
+        a[0][0] += 1.0e-6f;
+    }
+
+    CORRADE_VERIFY(sum.sum() != 0);
+}
+
+void DecompositionBenchmark::qr3() {
+    Matrix3x3 a = Data3;
+    CORRADE_BENCHMARK(Repeats) {
+        /* Explicitly calling the generic implementation */
+        a = Algorithms::qr<3, Float>(a).second;
+    }
+
+    CORRADE_VERIFY(a.toVector().sum() != 0);
+}
+
+void DecompositionBenchmark::qr3Unrolled() {
+    Matrix3x3 a = Data3;
+    CORRADE_BENCHMARK(Repeats) {
+        a = Algorithms::qr(a).second;
+    }
+
+    CORRADE_VERIFY(a.toVector().sum() != 0);
+}
+
+void DecompositionBenchmark::qr4() {
+    Matrix4x4 a = Data4;
+    CORRADE_BENCHMARK(Repeats) {
+        /* Explicitly calling the generic implementation */
+        a = Algorithms::qr<4, Float>(a).second;
+    }
+
+    CORRADE_VERIFY(a.toVector().sum() != 0);
+}
+
+void DecompositionBenchmark::qr4Unrolled() {
+    Matrix4x4 a = Data4;
+    CORRADE_BENCHMARK(Repeats) {
+        a = Algorithms::qr(a).second;
+    }
+
+    CORRADE_VERIFY(a.toVector().sum() != 0);
+}
+
+}}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::DecompositionBenchmark)
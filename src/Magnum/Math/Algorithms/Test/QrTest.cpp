@@ -23,7 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
@@ -36,6 +39,10 @@ struct QrTest: Corrade::TestSuite::Tester {
 
     void test();
     void decomposeRotationShear();
+    void unrolled3x3();
+    void unrolled4x4();
+    void batch();
+    void batchAssertions();
 };
 
 using namespace Math::Literals;
@@ -43,10 +50,16 @@ using namespace Math::Literals;
 typedef Matrix3x3<Float> Matrix3x3;
 typedef Vector3<Float> Vector3;
 typedef Matrix4<Float> Matrix4;
+typedef Matrix4x4<Float> Matrix4x4;
+typedef Vector4<Float> Vector4;
 
 QrTest::QrTest() {
     addTests({&QrTest::test,
-              &QrTest::decomposeRotationShear});
+              &QrTest::decomposeRotationShear,
+              &QrTest::unrolled3x3,
+              &QrTest::unrolled4x4,
+              &QrTest::batch,
+              &QrTest::batchAssertions});
 }
 
 void QrTest::test() {
@@ -81,6 +94,81 @@ void QrTest::decomposeRotationShear() {
     CORRADE_COMPARE(r4.rotationShear(), Matrix4::shearingXZ(0.274077f, 0.0f).rotationShear());
 }
 
+void QrTest::unrolled3x3() {
+    Matrix3x3 a{Vector3{ 2.0f, -1.0f,  0.5f},
+                Vector3{ 3.5f,  4.0f, -2.0f},
+                Vector3{-1.5f, 0.25f,  7.0f}};
+
+    /* Explicitly calling the generic implementation */
+    std::pair<Matrix3x3, Matrix3x3> expected = Algorithms::qr<3, Float>(a);
+    std::pair<Matrix3x3, Matrix3x3> qr = Algorithms::qr(a);
+    CORRADE_COMPARE(qr.first, expected.first);
+    CORRADE_COMPARE(qr.second, expected.second);
+    CORRADE_COMPARE(qr.first*qr.second, a);
+    CORRADE_VERIFY(qr.first.isOrthogonal());
+}
+
+void QrTest::unrolled4x4() {
+    Matrix4x4 a{Vector4{ 2.0f, -1.0f,  0.5f, 1.0f},
+                Vector4{ 3.5f,  4.0f, -2.0f, 0.0f},
+                Vector4{-1.5f, 0.25f,  7.0f, 3.0f},
+                Vector4{ 1.0f,  2.0f,  3.0f, 4.0f}};
+
+    /* Explicitly calling the generic implementation */
+    std::pair<Matrix4x4, Matrix4x4> expected = Algorithms::qr<4, Float>(a);
+    std::pair<Matrix4x4, Matrix4x4> qr = Algorithms::qr(a);
+    CORRADE_COMPARE(qr.first, expected.first);
+    CORRADE_COMPARE(qr.second, expected.second);
+    CORRADE_COMPARE(qr.first*qr.second, a);
+    CORRADE_VERIFY(qr.first.isOrthogonal());
+
+    /* R is upper triangular */
+    CORRADE_COMPARE(qr.second[0][1], 0.0f);
+    CORRADE_COMPARE(qr.second[0][2], 0.0f);
+    CORRADE_COMPARE(qr.second[0][3], 0.0f);
+    CORRADE_COMPARE(qr.second[1][2], 0.0f);
+    CORRADE_COMPARE(qr.second[1][3], 0.0f);
+    CORRADE_COMPARE(qr.second[2][3], 0.0f);
+}
+
+void QrTest::batch() {
+    Matrix3x3 src[]{
+        Matrix3x3{Vector3{  0.0f,   3.0f,   4.0f},
+                  Vector3{-20.0f,  27.0f,  11.0f},
+                  Vector3{-14.0f,  -4.0f,  -2.0f}},
+        Matrix4::scaling({1.5f, 2.0f, 1.0f}).rotationScaling(),
+        (Matrix4::scaling({1.5f, 2.0f, 1.0f})*Matrix4::rotationZ(35.0_degf)).rotationScaling()
+    };
+    Matrix3x3 q[Corrade::Containers::arraySize(src)];
+    Matrix3x3 r[Corrade::Containers::arraySize(src)];
+    Algorithms::qrInto<3, Float>(src, q, r);
+
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        std::pair<Matrix3x3, Matrix3x3> expected = Algorithms::qr(src[i]);
+        CORRADE_COMPARE(q[i], expected.first);
+        CORRADE_COMPARE(r[i], expected.second);
+    }
+}
+
+void QrTest::batchAssertions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Matrix3x3 src[3];
+    Matrix3x3 q[3];
+    Matrix3x3 r[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Algorithms::qrInto<3, Float>(src, Corrade::Containers::arrayView(q).prefix(2), r);
+    Algorithms::qrInto<3, Float>(src, q, Corrade::Containers::arrayView(r).prefix(1));
+    CORRADE_COMPARE(out.str(),
+        "Math::Algorithms::qrInto(): wrong Q destination size, got 2 but expected 3\n"
+        "Math::Algorithms::qrInto(): wrong R destination size, got 1 but expected 3\n");
+}
+
 }}}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::QrTest)
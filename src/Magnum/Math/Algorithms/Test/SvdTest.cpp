@@ -23,7 +23,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/Math/Algorithms/Svd.h"
@@ -35,6 +39,16 @@ struct SvdTest: Corrade::TestSuite::Tester {
 
     template<class T> void test();
     void decomposeRotationShear();
+
+    template<class T> void jacobi();
+    template<class T> void jacobiRankDeficient();
+    void jacobiZero();
+    void jacobiDecomposeRotationShear();
+    void jacobiBatch();
+    void jacobiBatchAssertions();
+
+    private:
+        template<class T> void verifyJacobi(const Matrix3x3<T>& a, const Matrix3x3<T>& u, const Vector3<T>& w, const Matrix3x3<T>& v);
 };
 
 template<class T> using Matrix5x8 = RectangularMatrix<5, 8, T>;
@@ -43,10 +57,48 @@ template<class T> using Matrix5 = Matrix<5, T>;
 template<class T> using Vector8 = Vector<8, T>;
 template<class T> using Vector5 = Vector<5, T>;
 
+const struct {
+    const char* name;
+    Vector3<Double> a, b, c;
+} JacobiData[]{
+    {"identity", {1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}},
+    {"diagonal, unsorted", {0.5, 0.0, 0.0}, {0.0, -3.0, 0.0}, {0.0, 0.0, 2.0}},
+    {"generic", {2.0, -1.0, 0.5}, {3.5, 4.0, -2.0}, {-1.5, 0.25, 7.0}},
+    {"large differences", {10.0, 2.0, 3.0}, {-4.0, 0.5, 5.0}, {6.0, 7.0, -1.0}},
+    {"repeated singular values", {0.0, 2.0, 0.0}, {2.0, 0.0, 0.0}, {0.0, 0.0, 2.0}},
+    {"negative determinant", {-1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}, {7.0, 8.0, -9.0}}
+};
+
+const struct {
+    const char* name;
+    Vector3<Double> a, b, c;
+    std::size_t rank;
+} JacobiRankDeficientData[]{
+    {"rank 2", {1.0, 2.0, 3.0}, {-2.0, 0.5, 1.0}, {-1.0, 2.5, 4.0}, 2},
+    {"rank 2, zero column", {1.0, 2.0, 3.0}, {0.0, 0.0, 0.0}, {4.0, -1.0, 2.0}, 2},
+    {"rank 1", {1.0, 2.0, 3.0}, {2.0, 4.0, 6.0}, {-0.5, -1.0, -1.5}, 1},
+    {"rank 1, single column", {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 3.0, 0.0}, 1}
+};
+
 SvdTest::SvdTest() {
     addTests({&SvdTest::test<Float>,
               &SvdTest::test<Double>,
               &SvdTest::decomposeRotationShear});
+
+    addInstancedTests<SvdTest>({
+        &SvdTest::jacobi<Float>,
+        &SvdTest::jacobi<Double>},
+        Corrade::Containers::arraySize(JacobiData));
+
+    addInstancedTests<SvdTest>({
+        &SvdTest::jacobiRankDeficient<Float>,
+        &SvdTest::jacobiRankDeficient<Double>},
+        Corrade::Containers::arraySize(JacobiRankDeficientData));
+
+    addTests({&SvdTest::jacobiZero,
+              &SvdTest::jacobiDecomposeRotationShear,
+              &SvdTest::jacobiBatch,
+              &SvdTest::jacobiBatchAssertions});
 }
 
 template<class T> void SvdTest::test() {
@@ -116,6 +168,154 @@ void SvdTest::decomposeRotationShear() {
     CORRADE_COMPARE(Matrix4::from(u*v.transposed(), {}), Matrix4::rotationZ(35.0_degf));
 }
 
+template<class T> void SvdTest::verifyJacobi(const Matrix3x3<T>& a, const Matrix3x3<T>& u, const Vector3<T>& w, const Matrix3x3<T>& v) {
+    /* Composition. Checking the absolute error relative to the largest
+       singular value, as the usual fuzzy compare is too strict for elements
+       that are much smaller than the rest. */
+    CORRADE_COMPARE_AS(Math::abs((u*Matrix3x3<T>::fromDiagonal(w)*v.transposed() - a).toVector()).max(),
+        w[0]*T(32)*std::numeric_limits<T>::epsilon(),
+        Corrade::TestSuite::Compare::LessOrEqual);
+
+    /* U and V are orthogonal */
+    CORRADE_COMPARE(u*u.transposed(), Matrix3x3<T>{IdentityInit});
+    CORRADE_COMPARE(v*v.transposed(), Matrix3x3<T>{IdentityInit});
+
+    /* Singular values are sorted and non-negative */
+    CORRADE_COMPARE_AS(w[0], w[1], Corrade::TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(w[1], w[2], Corrade::TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(w[2], T(0), Corrade::TestSuite::Compare::GreaterOrEqual);
+}
+
+template<class T> void SvdTest::jacobi() {
+    auto&& data = JacobiData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    const Matrix3x3<T> a{Matrix3x3<Double>{data.a, data.b, data.c}};
+
+    Matrix3x3<T> u{Magnum::NoInit};
+    Vector3<T> w{Magnum::NoInit};
+    Matrix3x3<T> v{Magnum::NoInit};
+    std::tie(u, w, v) = Algorithms::svdJacobi(a);
+    verifyJacobi(a, u, w, v);
+
+    /* The singular values should be the same as from the generic algorithm,
+       just sorted */
+    Vector3<T> expected = std::get<1>(Algorithms::svd(a));
+    using std::swap;
+    if(expected[1] > expected[0]) swap(expected[0], expected[1]);
+    if(expected[2] > expected[0]) swap(expected[0], expected[2]);
+    if(expected[2] > expected[1]) swap(expected[1], expected[2]);
+    CORRADE_COMPARE(w, expected);
+}
+
+template<class T> void SvdTest::jacobiRankDeficient() {
+    auto&& data = JacobiRankDeficientData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    const Matrix3x3<T> a{Matrix3x3<Double>{data.a, data.b, data.c}};
+
+    Matrix3x3<T> u{Magnum::NoInit};
+    Vector3<T> w{Magnum::NoInit};
+    Matrix3x3<T> v{Magnum::NoInit};
+    std::tie(u, w, v) = Algorithms::svdJacobi(a);
+    verifyJacobi(a, u, w, v);
+
+    /* The zero singular values are zero up to rounding errors, U is
+       completed to an orthogonal basis, which verifyJacobi() checked */
+    for(std::size_t i = data.rank; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS(w[i], w[0]*T(32)*std::numeric_limits<T>::epsilon(),
+            Corrade::TestSuite::Compare::LessOrEqual);
+    }
+}
+
+void SvdTest::jacobiZero() {
+    Matrix3x3<Float> u{Magnum::NoInit};
+    Vector3<Float> w{Magnum::NoInit};
+    Matrix3x3<Float> v{Magnum::NoInit};
+    std::tie(u, w, v) = Algorithms::svdJacobi(Matrix3x3<Float>{ZeroInit});
+
+    CORRADE_COMPARE(u, Matrix3x3<Float>{IdentityInit});
+    CORRADE_COMPARE(w, Vector3<Float>{});
+    CORRADE_COMPARE(v, Matrix3x3<Float>{IdentityInit});
+}
+
+void SvdTest::jacobiDecomposeRotationShear() {
+    typedef Math::Matrix4<Float> Matrix4;
+    typedef Math::Matrix3x3<Float> Matrix3x3;
+    typedef Math::Vector3<Float> Vector3;
+
+    using namespace Math::Literals;
+
+    Matrix4 a = Matrix4::scaling({1.5f, 2.0f, 1.0f})*Matrix4::rotationZ(35.0_degf);
+
+    Matrix3x3 u{Magnum::NoInit};
+    Vector3 w{Magnum::NoInit};
+    Matrix3x3 v{Magnum::NoInit};
+    std::tie(u, w, v) = Algorithms::svdJacobi(a.rotationScaling());
+
+    CORRADE_COMPARE(u*Matrix3x3::fromDiagonal(w)*v.transposed(), a.rotationScaling());
+
+    /* Compared to svd() the singular values are sorted */
+    CORRADE_COMPARE(w, (Vector3{2.0f, 1.5f, 1.0f}));
+
+    /* Polar decomposition, the rotation is the same as the original */
+    Matrix3x3 r = u*v.transposed();
+    if(r.determinant() < 0.0f) {
+        u[2] = -u[2];
+        r = u*v.transposed();
+    }
+    CORRADE_COMPARE(Matrix4::from(r, {}), Matrix4::rotationZ(35.0_degf));
+}
+
+void SvdTest::jacobiBatch() {
+    typedef Math::Matrix3x3<Float> Matrix3x3;
+    typedef Math::Vector3<Float> Vector3;
+
+    Matrix3x3 src[Corrade::Containers::arraySize(JacobiData)];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(JacobiData); ++i)
+        src[i] = Matrix3x3{Math::Matrix3x3<Double>{JacobiData[i].a, JacobiData[i].b, JacobiData[i].c}};
+
+    Matrix3x3 u[Corrade::Containers::arraySize(src)];
+    Vector3 w[Corrade::Containers::arraySize(src)];
+    Matrix3x3 v[Corrade::Containers::arraySize(src)];
+    Algorithms::svdJacobiInto<Float>(src, u, w, v);
+
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        Matrix3x3 expectedU{Magnum::NoInit};
+        Vector3 expectedW{Magnum::NoInit};
+        Matrix3x3 expectedV{Magnum::NoInit};
+        std::tie(expectedU, expectedW, expectedV) = Algorithms::svdJacobi(src[i]);
+        CORRADE_COMPARE(u[i], expectedU);
+        CORRADE_COMPARE(w[i], expectedW);
+        CORRADE_COMPARE(v[i], expectedV);
+    }
+}
+
+void SvdTest::jacobiBatchAssertions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Matrix3x3<Float> src[3];
+    Matrix3x3<Float> u[3];
+    Vector3<Float> w[3];
+    Matrix3x3<Float> v[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Algorithms::svdJacobiInto<Float>(src, Corrade::Containers::arrayView(u).prefix(2), w, v);
+    Algorithms::svdJacobiInto<Float>(src, u, Corrade::Containers::arrayView(w).prefix(2), v);
+    Algorithms::svdJacobiInto<Float>(src, u, w, Corrade::Containers::arrayView(v).prefix(1));
+    CORRADE_COMPARE(out.str(),
+        "Math::Algorithms::svdJacobiInto(): wrong U destination size, got 2 but expected 3\n"
+        "Math::Algorithms::svdJacobiInto(): wrong W destination size, got 2 but expected 3\n"
+        "Math::Algorithms::svdJacobiInto(): wrong V destination size, got 1 but expected 3\n");
+}
+
 }}}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::SvdTest)
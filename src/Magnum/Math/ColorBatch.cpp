@@ -0,0 +1,74 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ColorBatch.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Implementation/colorBatchKernels.hpp"
+#include "Magnum/Math/Implementation/stridedConversion.hpp"
+
+namespace Magnum { namespace Math {
+
+void fromSrgbInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::fromSrgbInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
+        "Math::fromSrgbInto(): second view dimension is not contiguous", );
+
+    static const Implementation::ColorBatchKernel<UnsignedByte, Float> kernel = Implementation::fromSrgb8Kernel();
+    Implementation::convertInto(src, dst, kernel);
+}
+
+void fromSrgbHalfInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::fromSrgbHalfInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
+        "Math::fromSrgbHalfInto(): second view dimension is not contiguous", );
+
+    Implementation::convertInto(src, dst, Implementation::fromSrgb8HalfScalar);
+}
+
+void toSrgbInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedByte>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::toSrgbInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
+        "Math::toSrgbInto(): second view dimension is not contiguous", );
+
+    static const Implementation::ColorBatchKernel<Float, UnsignedByte> kernel = Implementation::toSrgb8Kernel();
+    Implementation::convertInto(src, dst, kernel);
+}
+
+void toSrgbHalfInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<UnsignedByte>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::toSrgbHalfInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
+        "Math::toSrgbHalfInto(): second view dimension is not contiguous", );
+
+    Implementation::convertInto(src, dst, Implementation::toSrgb8HalfScalar);
+}
+
+}}
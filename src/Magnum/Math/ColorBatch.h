@@ -0,0 +1,124 @@
+#ifndef Magnum_Math_ColorBatch_h
+#define Magnum_Math_ColorBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Functions @ref Magnum::Math::fromSrgbInto(), @ref Magnum::Math::fromSrgbHalfInto(), @ref Magnum::Math::toSrgbInto(), @ref Magnum::Math::toSrgbHalfInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@{ @name Batch color conversion functions
+
+These functions process an unbounded range of values, as opposed to single
+colors. The conversion is done on all components of the view, so in order to
+convert RGBA data without touching the alpha channel, pass a view on the RGB
+channels only. Conversion of a single view is done on the calling thread, the
+functions are however reentrant and large images can be converted in parallel
+by splitting the views into ranges of rows.
+*/
+
+/**
+@brief Convert 8-bit sRGB values to 32-bit float linear RGB
+@param[in]  src     Source 8-bit sRGB values
+@param[out] dst     Destination 32-bit float linear RGB values
+@m_since_latest
+
+A batch equivalent to @ref Color3::fromSrgb(const Vector3<Integral>&) applied
+to each component. Uses a 256-entry table, on x86 with AVX2 gathers if the CPU
+supports them. The output is bit-identical to
+@ref Color3::fromSrgb(const Vector3<Integral>&). Expects that @p src and
+@p dst have the same size and that the second dimension in both is
+contiguous.
+@see @ref fromSrgbHalfInto(), @ref toSrgbInto(), @ref unpackInto(),
+    @ref Corrade::Containers::StridedArrayView::isContiguous()
+*/
+MAGNUM_EXPORT void fromSrgbInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst);
+
+/**
+@brief Convert 8-bit sRGB values to 16-bit half-float linear RGB
+@param[in]  src     Source 8-bit sRGB values
+@param[out] dst     Destination 16-bit half-float linear RGB values
+@m_since_latest
+
+Same as @ref fromSrgbInto(), except that the result is converted to a
+half-float using the same rounding as @ref packHalf(). Expects that @p src and
+@p dst have the same size and that the second dimension in both is
+contiguous.
+@see @ref toSrgbHalfInto(), @ref packHalfInto()
+*/
+MAGNUM_EXPORT void fromSrgbHalfInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst);
+
+/**
+@brief Convert 32-bit float linear RGB values to 8-bit sRGB
+@param[in]  src     Source 32-bit float linear RGB values
+@param[out] dst     Destination 8-bit sRGB values
+@m_since_latest
+
+A batch equivalent to @ref Color3::toSrgb() const "Color3::toSrgb<UnsignedByte>()"
+applied to each component, with values clamped to the @f$ [0, 1] @f$ range and
+NaNs converted to @cpp 0 @ce. Instead of evaluating a power function for each
+value, the range is split into a few thousand intervals in which the result
+changes at most once, each described by a base value and a threshold. The
+result is still exactly equal to @ref Color3::toSrgb() const "Color3::toSrgb<UnsignedByte>()"
+for all inputs in range. On x86 the lookups are done with AVX2 gathers if the
+CPU supports them. Expects that @p src and @p dst have the same size and that
+the second dimension in both is contiguous.
+@see @ref toSrgbHalfInto(), @ref fromSrgbInto(), @ref packInto(),
+    @ref Corrade::Containers::StridedArrayView::isContiguous()
+*/
+MAGNUM_EXPORT void toSrgbInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedByte>& dst);
+
+/**
+@brief Convert 16-bit half-float linear RGB values to 8-bit sRGB
+@param[in]  src     Source 16-bit half-float linear RGB values
+@param[out] dst     Destination 8-bit sRGB values
+@m_since_latest
+
+Same as @ref toSrgbInto() with the input converted using @ref unpackHalf(),
+implemented as a lookup into a table covering all half-float values. Expects
+that @p src and @p dst have the same size and that the second dimension in
+both is contiguous.
+@see @ref fromSrgbHalfInto(), @ref unpackHalfInto()
+*/
+MAGNUM_EXPORT void toSrgbHalfInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<UnsignedByte>& dst);
+
+/* Since 1.8.17, the original short-hand group closing doesn't work anymore.
+   FFS. */
+/**
+ * @}
+ */
+
+}}
+
+#endif
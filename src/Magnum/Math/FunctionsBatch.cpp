@@ -0,0 +1,94 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FunctionsBatch.h"
+
+#include <cstring>
+
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/Implementation/functionsBatchKernels.hpp"
+
+namespace Magnum { namespace Math { namespace Implementation {
+
+namespace {
+
+/* Ranges with fewer items than MinmaxMinSize go through the scalar loop
+   directly. Non-contiguous ranges are gathered into blocks of MinmaxBlockSize
+   items on stack first. */
+enum: std::size_t { MinmaxBlockSize = 256, MinmaxMinSize = 16 };
+
+template<class T, std::size_t size> void minmaxIntoImplementation(const void* const data, const std::ptrdiff_t stride, const std::size_t count, T* const min, T* const max) {
+    static const MinmaxKernel<T> kernel = minmaxKernel<T, size>();
+
+    const char* ptr = static_cast<const char*>(data);
+    if(count < MinmaxMinSize) {
+        for(std::size_t i = 0; i != count; ++i, ptr += stride)
+            minmaxScalar<T, size>(reinterpret_cast<const T*>(ptr), 1, min, max);
+        return;
+    }
+
+    if(stride == std::ptrdiff_t(sizeof(T)*size))
+        return kernel(reinterpret_cast<const T*>(ptr), count, min, max);
+
+    T block[MinmaxBlockSize*size];
+    for(std::size_t i = 0; i < count; i += MinmaxBlockSize) {
+        const std::size_t blockCount = count - i < MinmaxBlockSize ? count - i : std::size_t(MinmaxBlockSize);
+        for(std::size_t j = 0; j != blockCount; ++j, ptr += stride)
+            std::memcpy(block + j*size, ptr, sizeof(T)*size);
+        kernel(block, blockCount, min, max);
+    }
+}
+
+}
+
+/* The vector types are just arrays of scalars, so they're all handled as a
+   scalar type with a component count */
+#define _c(type, scalar, size)                                              \
+    void minInto(const Corrade::Containers::StridedArrayView1D<const type>& range, type& min) { \
+        type max = min;                                                     \
+        minmaxIntoImplementation<scalar, size>(range.data(), range.stride(), range.size(), reinterpret_cast<scalar*>(&min), reinterpret_cast<scalar*>(&max)); \
+    }                                                                       \
+    void maxInto(const Corrade::Containers::StridedArrayView1D<const type>& range, type& max) { \
+        type min = max;                                                     \
+        minmaxIntoImplementation<scalar, size>(range.data(), range.stride(), range.size(), reinterpret_cast<scalar*>(&min), reinterpret_cast<scalar*>(&max)); \
+    }                                                                       \
+    void minmaxInto(const Corrade::Containers::StridedArrayView1D<const type>& range, type& min, type& max) { \
+        minmaxIntoImplementation<scalar, size>(range.data(), range.stride(), range.size(), reinterpret_cast<scalar*>(&min), reinterpret_cast<scalar*>(&max)); \
+    }
+_c(Float, Float, 1)
+_c(Vector2<Float>, Float, 2)
+_c(Vector3<Float>, Float, 3)
+_c(Vector4<Float>, Float, 4)
+_c(Int, Int, 1)
+_c(Vector2<Int>, Int, 2)
+_c(Vector3<Int>, Int, 3)
+_c(Vector4<Int>, Int, 4)
+_c(UnsignedInt, UnsignedInt, 1)
+_c(Vector2<UnsignedInt>, UnsignedInt, 2)
+_c(Vector3<UnsignedInt>, UnsignedInt, 3)
+_c(Vector4<UnsignedInt>, UnsignedInt, 4)
+#undef _c
+
+}}}
@@ -190,6 +190,39 @@ namespace Implementation {
         }
         return {firstValid, out};
     }
+
+    /* Generic variants of the loops in min(), max() and minmax(), the
+       Implementation::minmax() helper is defined further below */
+    template<class T> inline void minInto(const Corrade::Containers::StridedArrayView1D<const T>& range, T& min) {
+        for(std::size_t i = 0; i != range.size(); ++i)
+            min = Math::min(min, range[i]);
+    }
+    template<class T> inline void maxInto(const Corrade::Containers::StridedArrayView1D<const T>& range, T& max) {
+        for(std::size_t i = 0; i != range.size(); ++i)
+            max = Math::max(max, range[i]);
+    }
+    template<class T> void minmaxInto(const Corrade::Containers::StridedArrayView1D<const T>& range, T& min, T& max);
+
+    /* SIMD variants for the common types, implemented in FunctionsBatch.cpp.
+       Being non-templated, these are preferred over the above during overload
+       resolution. */
+    #define _c(type)                                                        \
+        MAGNUM_EXPORT void minInto(const Corrade::Containers::StridedArrayView1D<const type>& range, type& min); \
+        MAGNUM_EXPORT void maxInto(const Corrade::Containers::StridedArrayView1D<const type>& range, type& max); \
+        MAGNUM_EXPORT void minmaxInto(const Corrade::Containers::StridedArrayView1D<const type>& range, type& min, type& max);
+    _c(Float)
+    _c(Vector2<Float>)
+    _c(Vector3<Float>)
+    _c(Vector4<Float>)
+    _c(Int)
+    _c(Vector2<Int>)
+    _c(Vector3<Int>)
+    _c(Vector4<Int>)
+    _c(UnsignedInt)
+    _c(Vector2<UnsignedInt>)
+    _c(Vector3<UnsignedInt>)
+    _c(Vector4<UnsignedInt>)
+    #undef _c
 }
 
 /**
@@ -197,14 +230,18 @@ namespace Implementation {
 
 If the range is empty, returns default-constructed value. <em>NaN</em>s are
 ignored, unless the range is all <em>NaN</em>s.
+
+@ref Float, @ref Int and @ref UnsignedInt scalars and their two-, three- and
+four-component vectors are processed using SIMD instructions where available.
+If the minimum is a zero and the range contains both a positive and a
+negative zero, it's unspecified which of them gets returned.
 @see @ref min(T, T), @ref isNan(const Corrade::Containers::StridedArrayView1D<const T>&)
 */
 template<class T> inline T min(const Corrade::Containers::StridedArrayView1D<const T>& range) {
     if(range.empty()) return {};
 
     std::pair<std::size_t, T> iOut = Implementation::firstNonNan(range, IsFloatingPoint<T>{}, IsVector<T>{});
-    for(++iOut.first; iOut.first != range.size(); ++iOut.first)
-        iOut.second = Math::min(iOut.second, range[iOut.first]);
+    Implementation::minInto(range.suffix(iOut.first + 1), iOut.second);
 
     return iOut.second;
 }
@@ -242,14 +279,18 @@ template<class T, std::size_t size> inline T min(const T(&array)[size]) {
 
 If the range is empty, returns default-constructed value. <em>NaN</em>s are
 ignored, unless the range is all <em>NaN</em>s.
+
+@ref Float, @ref Int and @ref UnsignedInt scalars and their two-, three- and
+four-component vectors are processed using SIMD instructions where available.
+If the maximum is a zero and the range contains both a positive and a
+negative zero, it's unspecified which of them gets returned.
 @see @ref max(T, T), @ref isNan(const Corrade::Containers::StridedArrayView1D<const T>&)
 */
 template<class T> inline T max(const Corrade::Containers::StridedArrayView1D<const T>& range) {
     if(range.empty()) return {};
 
     std::pair<std::size_t, T> iOut = Implementation::firstNonNan(range, IsFloatingPoint<T>{}, IsVector<T>{});
-    for(++iOut.first; iOut.first != range.size(); ++iOut.first)
-        iOut.second = Math::max(iOut.second, range[iOut.first]);
+    Implementation::maxInto(range.suffix(iOut.first + 1), iOut.second);
 
     return iOut.second;
 }
@@ -293,6 +334,11 @@ namespace Implementation {
         for(std::size_t i = 0; i != size; ++i)
             minmax(min[i], max[i], value[i]);
     }
+
+    template<class T> void minmaxInto(const Corrade::Containers::StridedArrayView1D<const T>& range, T& min, T& max) {
+        for(std::size_t i = 0; i != range.size(); ++i)
+            minmax(min, max, range[i]);
+    }
 }
 
 /**
@@ -300,6 +346,11 @@ namespace Implementation {
 
 If the range is empty, returns default-constructed values. <em>NaN</em>s are
 ignored, unless the range is all <em>NaN</em>s.
+
+@ref Float, @ref Int and @ref UnsignedInt scalars and their two-, three- and
+four-component vectors are processed using SIMD instructions where available.
+If the minimum or maximum is a zero and the range contains both a positive and
+a negative zero, it's unspecified which of them gets returned.
 @see @ref minmax(T, T),
     @ref Range::Range(const std::pair<VectorType, VectorType>&),
     @ref isNan(const Corrade::Containers::StridedArrayView1D<const T>&)
@@ -309,8 +360,7 @@ template<class T> inline std::pair<T, T> minmax(const Corrade::Containers::Strid
 
     std::pair<std::size_t, T> iOut = Implementation::firstNonNan(range, IsFloatingPoint<T>{}, IsVector<T>{});
     T min{iOut.second}, max{iOut.second};
-    for(++iOut.first; iOut.first != range.size(); ++iOut.first)
-        Implementation::minmax(min, max, range[iOut.first]);
+    Implementation::minmaxInto(range.suffix(iOut.first + 1), min, max);
 
     return {min, max};
 }
@@ -0,0 +1,231 @@
+#ifndef Magnum_Math_Implementation_colorBatchKernels_hpp
+#define Magnum_Math_Implementation_colorBatchKernels_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <cstring>
+
+#include "Magnum/Types.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Implementation/cpuFeatures.hpp"
+
+namespace Magnum { namespace Math { namespace Implementation {
+
+/* The same calculations as in fromSrgb() / toSrgb() in Color.h, done on a
+   single channel. The tables below are filled using these so the batch
+   conversion is bit-identical to the per-color one. */
+inline Float fromSrgbChannel(const Float srgb) {
+    constexpr const Float a = 0.055f;
+    return srgb > 0.04045f ? std::pow((srgb + a)/(1.0f + a), 2.4f) : srgb/12.92f;
+}
+
+inline UnsignedByte toSrgb8Channel(const Float linear) {
+    constexpr const Float a = 0.055f;
+    const Float srgb = linear > 0.0031308f ? (1.0f + a)*std::pow(linear, 1.0f/2.4f) - a : linear*12.92f;
+    return pack<UnsignedByte>(srgb);
+}
+
+/* Float to 8-bit sRGB conversion is done with a table indexed by the top
+   bits of the float representation. Inputs below 2^-13 always give 0 and
+   inputs at 1 or above always give 255, the range in between is split into
+   13 exponents times 256 mantissa ranges. Every range is narrow enough that
+   the output changes at most once in it, so each entry stores the output at
+   the start of the range in the upper 16 bits and the offset at which it
+   increments by one in the lower 16 bits. Because the offsets are found from
+   the actual toSrgb8Channel() output, the result is exact for all inputs.
+   Idea similar to https://gist.github.com/rygorous/2203834, which however
+   interpolates linearly and isn't exact. */
+enum: UnsignedInt {
+    ToSrgb8MinBits = (127 - 13) << 23,  /* 2^-13 */
+    ToSrgb8MaxBits = 0x3f7fffff,        /* 1 - epsilon */
+    ToSrgb8Shift = 15,
+    ToSrgb8Mask = (1 << ToSrgb8Shift) - 1,
+    ToSrgb8TableSize = (13 << 23) >> ToSrgb8Shift
+};
+
+struct SrgbTables {
+    explicit SrgbTables();
+
+    Float fromSrgb8[256];
+    UnsignedShort fromSrgb8Half[256];
+    UnsignedInt toSrgb8[ToSrgb8TableSize];
+};
+
+inline Float floatFromBits(const UnsignedInt bits) {
+    Float value;
+    std::memcpy(&value, &bits, 4);
+    return value;
+}
+
+inline SrgbTables::SrgbTables() {
+    for(UnsignedInt i = 0; i != 256; ++i) {
+        fromSrgb8[i] = fromSrgbChannel(unpack<Float>(UnsignedByte(i)));
+        fromSrgb8Half[i] = packHalf(fromSrgb8[i]);
+    }
+
+    for(UnsignedInt i = 0; i != ToSrgb8TableSize; ++i) {
+        const UnsignedInt begin = ToSrgb8MinBits + (i << ToSrgb8Shift);
+        const UnsignedInt end = begin + ToSrgb8Mask + 1;
+        const UnsignedByte base = toSrgb8Channel(floatFromBits(begin));
+
+        /* Binary search for the first value with a different output, or
+           end if the output stays the same for the whole range */
+        UnsignedInt lo = end;
+        if(toSrgb8Channel(floatFromBits(end - 1)) != base) {
+            lo = begin;
+            UnsignedInt hi = end;
+            while(lo < hi) {
+                const UnsignedInt mid = lo + (hi - lo)/2;
+                if(toSrgb8Channel(floatFromBits(mid)) != base) hi = mid;
+                else lo = mid + 1;
+            }
+        }
+
+        toSrgb8[i] = (UnsignedInt(base) << 16)|(lo - begin);
+    }
+}
+
+/* Filled on first use, which is thread-safe */
+inline const SrgbTables& srgbTables() {
+    static const SrgbTables tables;
+    return tables;
+}
+
+inline UnsignedByte toSrgb8(const UnsignedInt* const table, Float value) {
+    /* Written this way so NaNs become 0 */
+    if(!(value > floatFromBits(ToSrgb8MinBits))) value = floatFromBits(ToSrgb8MinBits);
+    if(value > floatFromBits(ToSrgb8MaxBits)) value = floatFromBits(ToSrgb8MaxBits);
+    UnsignedInt bits;
+    std::memcpy(&bits, &value, 4);
+    const UnsignedInt entry = table[(bits - ToSrgb8MinBits) >> ToSrgb8Shift];
+    return UnsignedByte((entry >> 16) + ((bits & ToSrgb8Mask) >= (entry & 0xffff) ? 1 : 0));
+}
+
+/* Half-float to 8-bit sRGB is a lookup into a table covering all 65536
+   half-float values, filled with the above. It's separate from SrgbTables
+   to not allocate its 64 kB if not needed. */
+struct SrgbHalfTable {
+    explicit SrgbHalfTable();
+
+    UnsignedByte toSrgb8[65536];
+};
+
+inline SrgbHalfTable::SrgbHalfTable() {
+    const UnsignedInt* const table = srgbTables().toSrgb8;
+    for(UnsignedInt i = 0; i != 65536; ++i)
+        toSrgb8[i] = Implementation::toSrgb8(table, unpackHalf(UnsignedShort(i)));
+}
+
+inline const SrgbHalfTable& srgbHalfTable() {
+    static const SrgbHalfTable table;
+    return table;
+}
+
+/* Kernels converting a contiguous run of count elements, the same signature
+   as PackingBatchKernel */
+template<class T, class U> using ColorBatchKernel = void(*)(const T*, U*, std::size_t);
+
+inline void fromSrgb8Scalar(const UnsignedByte* src, Float* dst, const std::size_t count) {
+    const Float* const table = srgbTables().fromSrgb8;
+    for(std::size_t i = 0; i != count; ++i)
+        dst[i] = table[src[i]];
+}
+
+inline void fromSrgb8HalfScalar(const UnsignedByte* src, UnsignedShort* dst, const std::size_t count) {
+    const UnsignedShort* const table = srgbTables().fromSrgb8Half;
+    for(std::size_t i = 0; i != count; ++i)
+        dst[i] = table[src[i]];
+}
+
+inline void toSrgb8Scalar(const Float* src, UnsignedByte* dst, const std::size_t count) {
+    const UnsignedInt* const table = srgbTables().toSrgb8;
+    for(std::size_t i = 0; i != count; ++i)
+        dst[i] = toSrgb8(table, src[i]);
+}
+
+inline void toSrgb8HalfScalar(const UnsignedShort* src, UnsignedByte* dst, const std::size_t count) {
+    const UnsignedByte* const table = srgbHalfTable().toSrgb8;
+    for(std::size_t i = 0; i != count; ++i)
+        dst[i] = table[src[i]];
+}
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+/* AVX2 variants using gathers for the table lookups, eight values at a
+   time */
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline void fromSrgb8Avx2(const UnsignedByte* src, Float* dst, const std::size_t count) {
+    const Float* const table = srgbTables().fromSrgb8;
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_i32gather_ps(table, index, 4));
+    }
+    fromSrgb8Scalar(src + i, dst + i, count - i);
+}
+
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline void toSrgb8Avx2(const Float* src, UnsignedByte* dst, const std::size_t count) {
+    const UnsignedInt* const table = srgbTables().toSrgb8;
+    const __m256 min = _mm256_castsi256_ps(_mm256_set1_epi32(ToSrgb8MinBits));
+    const __m256 max = _mm256_castsi256_ps(_mm256_set1_epi32(ToSrgb8MaxBits));
+    const __m256i minBits = _mm256_set1_epi32(ToSrgb8MinBits);
+    const __m256i mask = _mm256_set1_epi32(ToSrgb8Mask);
+    const __m256i entryMask = _mm256_set1_epi32(0xffff);
+    const __m256i one = _mm256_set1_epi32(1);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        /* MAXPS returns the second operand for NaNs, so they become 0 */
+        const __m256 value = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(src + i), min), max);
+        const __m256i bits = _mm256_castps_si256(value);
+        const __m256i entry = _mm256_i32gather_epi32(reinterpret_cast<const int*>(table), _mm256_srli_epi32(_mm256_sub_epi32(bits, minBits), ToSrgb8Shift), 4);
+        /* base + (low >= offset) == base + 1 + (offset > low ? -1 : 0) */
+        const __m256i out = _mm256_add_epi32(_mm256_add_epi32(_mm256_srli_epi32(entry, 16), one),
+            _mm256_cmpgt_epi32(_mm256_and_si256(entry, entryMask), _mm256_and_si256(bits, mask)));
+        const __m128i out16 = _mm_packus_epi32(_mm256_castsi256_si128(out), _mm256_extracti128_si256(out, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(out16, out16));
+    }
+    toSrgb8Scalar(src + i, dst + i, count - i);
+}
+#endif
+
+/* Picks the best kernel for the current CPU. The half-float variants are
+   single table lookups, which is about as fast as it gets even without
+   SIMD. */
+inline ColorBatchKernel<UnsignedByte, Float> fromSrgb8Kernel() {
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+    if(cpuFeatures().avx2) return fromSrgb8Avx2;
+    #endif
+    return fromSrgb8Scalar;
+}
+
+inline ColorBatchKernel<Float, UnsignedByte> toSrgb8Kernel() {
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+    if(cpuFeatures().avx2) return toSrgb8Avx2;
+    #endif
+    return toSrgb8Scalar;
+}
+
+}}}
+
+#endif
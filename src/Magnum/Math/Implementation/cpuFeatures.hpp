@@ -0,0 +1,134 @@
+#ifndef Magnum_Math_Implementation_cpuFeatures_hpp
+#define Magnum_Math_Implementation_cpuFeatures_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Types.h"
+
+/* Shared by the SIMD kernels of the batch APIs. SSE2 is always available on
+   x86-64 and is used unconditionally if the compiler targets it. SSE4.1, AVX2
+   and F16C variants are compiled using function target attributes and picked
+   at runtime based on CPUID. */
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#if defined(CORRADE_TARGET_GCC) || defined(CORRADE_TARGET_CLANG) || defined(CORRADE_TARGET_MSVC)
+#define MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+#include <immintrin.h>
+#ifdef CORRADE_TARGET_MSVC
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+#if defined(CORRADE_TARGET_GCC) || defined(CORRADE_TARGET_CLANG)
+#define MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 __attribute__((__target__("sse4.1")))
+#define MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 __attribute__((__target__("avx2")))
+#define MAGNUM_MATH_IMPLEMENTATION_TARGET_F16C __attribute__((__target__("f16c")))
+#else
+#define MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41
+#define MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2
+#define MAGNUM_MATH_IMPLEMENTATION_TARGET_F16C
+#endif
+#endif
+
+/* Used for generic kernel loops that get instantiated with SIMD operations
+   for a particular instruction set. Without forced inlining these would be
+   compiled without the target attribute of the caller and the operations
+   couldn't be inlined into them. */
+#if defined(CORRADE_TARGET_GCC) || defined(CORRADE_TARGET_CLANG)
+#define MAGNUM_MATH_IMPLEMENTATION_ALWAYS_INLINE __attribute__((always_inline)) inline
+#elif defined(CORRADE_TARGET_MSVC)
+#define MAGNUM_MATH_IMPLEMENTATION_ALWAYS_INLINE __forceinline
+#else
+#define MAGNUM_MATH_IMPLEMENTATION_ALWAYS_INLINE inline
+#endif
+
+/* Division is available only on AArch64 NEON, the 32-bit variant uses the
+   scalar code in all kernels */
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#define MAGNUM_MATH_IMPLEMENTATION_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace Math { namespace Implementation {
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+struct CpuFeatures {
+    bool sse41, avx2, f16c;
+};
+
+inline CpuFeatures detectCpuFeatures() {
+    CpuFeatures features{};
+    unsigned int leaf1[4]{}, leaf7[4]{}, maxLeaf;
+    #ifdef CORRADE_TARGET_MSVC
+    int info[4];
+    __cpuid(info, 0);
+    maxLeaf = info[0];
+    __cpuid(info, 1);
+    for(std::size_t i = 0; i != 4; ++i) leaf1[i] = info[i];
+    if(maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        for(std::size_t i = 0; i != 4; ++i) leaf7[i] = info[i];
+    }
+    #else
+    maxLeaf = __get_cpuid_max(0, nullptr);
+    __cpuid(1, leaf1[0], leaf1[1], leaf1[2], leaf1[3]);
+    if(maxLeaf >= 7)
+        __cpuid_count(7, 0, leaf7[0], leaf7[1], leaf7[2], leaf7[3]);
+    #endif
+
+    features.sse41 = leaf1[2] & (1 << 19);
+
+    /* AVX2 and F16C need the OS to save the YMM registers on context switch,
+       which is checked via OSXSAVE and XGETBV */
+    if((leaf1[2] & (1 << 27)) && (leaf1[2] & (1 << 28))) {
+        #ifdef CORRADE_TARGET_MSVC
+        const unsigned long long xcr0 = _xgetbv(0);
+        #else
+        unsigned int eax, edx;
+        __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        const unsigned long long xcr0 = (static_cast<unsigned long long>(edx) << 32)|eax;
+        #endif
+        if((xcr0 & 0x6) == 0x6) {
+            features.avx2 = leaf7[1] & (1 << 5);
+            features.f16c = leaf1[2] & (1 << 29);
+        }
+    }
+
+    return features;
+}
+
+inline const CpuFeatures& cpuFeatures() {
+    static const CpuFeatures features = detectCpuFeatures();
+    return features;
+}
+#endif
+
+}}}
+
+#endif
@@ -0,0 +1,273 @@
+#ifndef Magnum_Math_Implementation_functionsBatchKernels_hpp
+#define Magnum_Math_Implementation_functionsBatchKernels_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Types.h"
+#include "Magnum/Math/Implementation/cpuFeatures.hpp"
+
+namespace Magnum { namespace Math { namespace Implementation {
+
+/* Kernels updating the per-component minimum and maximum with count
+   contiguous items of size components each. Both min and max are expected to
+   be initialized with a value from the range or with a NaN for components
+   that have no non-NaN value. In order to preserve the NaN-skipping semantics
+   of the scalar minmax() a value replaces the current minimum only if it's
+   less than it and the current maximum only if it's greater, which means NaN
+   values never end up in the output. */
+template<class T> using MinmaxKernel = void(*)(const T*, std::size_t, T*, T*);
+
+template<class T, std::size_t size> void minmaxScalar(const T* data, const std::size_t count, T* const min, T* const max) {
+    for(std::size_t i = 0; i != count; ++i, data += size) {
+        for(std::size_t j = 0; j != size; ++j) {
+            if(data[j] < min[j])
+                min[j] = data[j];
+            else if(data[j] > max[j])
+                max[j] = data[j];
+        }
+    }
+}
+
+/* Generic SIMD loop. The components are processed as a flat array of
+   scalars, with the accumulators spanning a whole number of items so each
+   lane always sees the same component --- for three-component vectors that
+   means three registers. Two sets of accumulators are used to hide the
+   instruction latency. Lanes are reduced in order at the end and the
+   remaining items go through the scalar loop. Since each lane sees a
+   different subset of the values, it's not specified which of the zeros gets
+   returned if both a positive and a negative zero is the minimum or
+   maximum. */
+template<class Ops, std::size_t size> MAGNUM_MATH_IMPLEMENTATION_ALWAYS_INLINE void minmaxSimd(const typename Ops::Type* const data, const std::size_t count, typename Ops::Type* const min, typename Ops::Type* const max) {
+    typedef typename Ops::Type T;
+    typedef typename Ops::Vector V;
+    enum: std::size_t {
+        Width = Ops::Width,
+        Registers = (size == 3 ? 3 : 1)*2,
+        Lanes = Width*Registers
+    };
+
+    /* Spread the initial values across the lanes */
+    T laneMin[Lanes], laneMax[Lanes];
+    for(std::size_t i = 0; i != Lanes; ++i) {
+        laneMin[i] = min[i % size];
+        laneMax[i] = max[i % size];
+    }
+    V vmin[Registers], vmax[Registers];
+    for(std::size_t r = 0; r != Registers; ++r) {
+        vmin[r] = Ops::load(laneMin + r*Width);
+        vmax[r] = Ops::load(laneMax + r*Width);
+    }
+
+    const std::size_t scalarCount = count*size;
+    std::size_t i = 0;
+    for(; i + Lanes <= scalarCount; i += Lanes) {
+        for(std::size_t r = 0; r != Registers; ++r) {
+            const V value = Ops::load(data + i + r*Width);
+            vmin[r] = Ops::min(value, vmin[r]);
+            vmax[r] = Ops::max(value, vmax[r]);
+        }
+    }
+
+    for(std::size_t r = 0; r != Registers; ++r) {
+        Ops::store(laneMin + r*Width, vmin[r]);
+        Ops::store(laneMax + r*Width, vmax[r]);
+    }
+    for(std::size_t j = 0; j != Lanes; ++j) {
+        if(laneMin[j] < min[j % size]) min[j % size] = laneMin[j];
+        if(laneMax[j] > max[j % size]) max[j % size] = laneMax[j];
+    }
+
+    /* Lanes is a multiple of size so i is always at an item boundary */
+    minmaxScalar<T, size>(data + i, count - i/size, min, max);
+}
+
+#ifdef CORRADE_TARGET_SSE2
+/* The first argument is the new value, the second the accumulator. MINPS and
+   MAXPS return the second operand if either is a NaN or if they're equal,
+   which is exactly the scalar semantics. */
+struct MinmaxSse2Float {
+    typedef Float Type;
+    typedef __m128 Vector;
+    enum: std::size_t { Width = 4 };
+
+    static Vector load(const Float* src) { return _mm_loadu_ps(src); }
+    static void store(Float* dst, Vector a) { _mm_storeu_ps(dst, a); }
+    static Vector min(Vector value, Vector min) { return _mm_min_ps(value, min); }
+    static Vector max(Vector value, Vector max) { return _mm_max_ps(value, max); }
+};
+
+/* SSE2 has only 16-bit integer min / max, emulating with a compare and a
+   select */
+struct MinmaxSse2Int {
+    typedef Int Type;
+    typedef __m128i Vector;
+    enum: std::size_t { Width = 4 };
+
+    static Vector load(const Int* src) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)); }
+    static void store(Int* dst, Vector a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), a); }
+    static Vector select(Vector mask, Vector a, Vector b) {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+    static Vector min(Vector value, Vector min) { return select(_mm_cmplt_epi32(value, min), value, min); }
+    static Vector max(Vector value, Vector max) { return select(_mm_cmpgt_epi32(value, max), value, max); }
+};
+
+/* Unsigned comparison is done by flipping the sign bit and comparing as
+   signed */
+struct MinmaxSse2UnsignedInt {
+    typedef UnsignedInt Type;
+    typedef __m128i Vector;
+    enum: std::size_t { Width = 4 };
+
+    static Vector load(const UnsignedInt* src) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)); }
+    static void store(UnsignedInt* dst, Vector a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), a); }
+    static Vector less(Vector a, Vector b) {
+        const __m128i sign = _mm_set1_epi32(-0x7fffffff - 1);
+        return _mm_cmplt_epi32(_mm_xor_si128(a, sign), _mm_xor_si128(b, sign));
+    }
+    static Vector min(Vector value, Vector min) { return MinmaxSse2Int::select(less(value, min), value, min); }
+    static Vector max(Vector value, Vector max) { return MinmaxSse2Int::select(less(max, value), value, max); }
+};
+
+template<std::size_t size> void minmaxSse2(const Float* data, const std::size_t count, Float* const min, Float* const max) {
+    minmaxSimd<MinmaxSse2Float, size>(data, count, min, max);
+}
+
+template<std::size_t size> void minmaxSse2(const Int* data, const std::size_t count, Int* const min, Int* const max) {
+    minmaxSimd<MinmaxSse2Int, size>(data, count, min, max);
+}
+
+template<std::size_t size> void minmaxSse2(const UnsignedInt* data, const std::size_t count, UnsignedInt* const min, UnsignedInt* const max) {
+    minmaxSimd<MinmaxSse2UnsignedInt, size>(data, count, min, max);
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+/* SSE4.1 has native 32-bit integer min / max */
+struct MinmaxSse41Int: MinmaxSse2Int {
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 static Vector min(Vector value, Vector min) { return _mm_min_epi32(value, min); }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 static Vector max(Vector value, Vector max) { return _mm_max_epi32(value, max); }
+};
+
+struct MinmaxSse41UnsignedInt: MinmaxSse2UnsignedInt {
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 static Vector min(Vector value, Vector min) { return _mm_min_epu32(value, min); }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 static Vector max(Vector value, Vector max) { return _mm_max_epu32(value, max); }
+};
+
+template<std::size_t size> MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 void minmaxSse41(const Int* data, const std::size_t count, Int* const min, Int* const max) {
+    minmaxSimd<MinmaxSse41Int, size>(data, count, min, max);
+}
+
+template<std::size_t size> MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 void minmaxSse41(const UnsignedInt* data, const std::size_t count, UnsignedInt* const min, UnsignedInt* const max) {
+    minmaxSimd<MinmaxSse41UnsignedInt, size>(data, count, min, max);
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+/* Unlike MINPS / MAXPS, FMIN / FMAX propagate NaNs, so the float variant
+   does a compare and a select instead */
+struct MinmaxNeonFloat {
+    typedef Float Type;
+    typedef float32x4_t Vector;
+    enum: std::size_t { Width = 4 };
+
+    static Vector load(const Float* src) { return vld1q_f32(src); }
+    static void store(Float* dst, Vector a) { vst1q_f32(dst, a); }
+    static Vector min(Vector value, Vector min) { return vbslq_f32(vcltq_f32(value, min), value, min); }
+    static Vector max(Vector value, Vector max) { return vbslq_f32(vcgtq_f32(value, max), value, max); }
+};
+
+struct MinmaxNeonInt {
+    typedef Int Type;
+    typedef int32x4_t Vector;
+    enum: std::size_t { Width = 4 };
+
+    static Vector load(const Int* src) { return vld1q_s32(src); }
+    static void store(Int* dst, Vector a) { vst1q_s32(dst, a); }
+    static Vector min(Vector value, Vector min) { return vminq_s32(value, min); }
+    static Vector max(Vector value, Vector max) { return vmaxq_s32(value, max); }
+};
+
+struct MinmaxNeonUnsignedInt {
+    typedef UnsignedInt Type;
+    typedef uint32x4_t Vector;
+    enum: std::size_t { Width = 4 };
+
+    static Vector load(const UnsignedInt* src) { return vld1q_u32(src); }
+    static void store(UnsignedInt* dst, Vector a) { vst1q_u32(dst, a); }
+    static Vector min(Vector value, Vector min) { return vminq_u32(value, min); }
+    static Vector max(Vector value, Vector max) { return vmaxq_u32(value, max); }
+};
+
+template<std::size_t size> void minmaxNeon(const Float* data, const std::size_t count, Float* const min, Float* const max) {
+    minmaxSimd<MinmaxNeonFloat, size>(data, count, min, max);
+}
+
+template<std::size_t size> void minmaxNeon(const Int* data, const std::size_t count, Int* const min, Int* const max) {
+    minmaxSimd<MinmaxNeonInt, size>(data, count, min, max);
+}
+
+template<std::size_t size> void minmaxNeon(const UnsignedInt* data, const std::size_t count, UnsignedInt* const min, UnsignedInt* const max) {
+    minmaxSimd<MinmaxNeonUnsignedInt, size>(data, count, min, max);
+}
+#endif
+
+/* Picks the best kernel for the current CPU. Float has no SSE4.1 variant as
+   there's nothing to gain over SSE2. */
+template<class T, std::size_t size> struct MinmaxKernelFor {
+    static MinmaxKernel<T> get() {
+        #if defined(CORRADE_TARGET_SSE2)
+        return minmaxSse2<size>;
+        #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+        return minmaxNeon<size>;
+        #else
+        return minmaxScalar<T, size>;
+        #endif
+    }
+};
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+template<std::size_t size> struct MinmaxKernelFor<Int, size> {
+    static MinmaxKernel<Int> get() {
+        if(cpuFeatures().sse41) return minmaxSse41<size>;
+        return minmaxSse2<size>;
+    }
+};
+
+template<std::size_t size> struct MinmaxKernelFor<UnsignedInt, size> {
+    static MinmaxKernel<UnsignedInt> get() {
+        if(cpuFeatures().sse41) return minmaxSse41<size>;
+        return minmaxSse2<size>;
+    }
+};
+#endif
+
+template<class T, std::size_t size> MinmaxKernel<T> minmaxKernel() {
+    return MinmaxKernelFor<T, size>::get();
+}
+
+}}}
+
+#endif
@@ -0,0 +1,684 @@
+#ifndef Magnum_Math_Implementation_packingBatchKernels_hpp
+#define Magnum_Math_Implementation_packingBatchKernels_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <cstring>
+
+#include "Magnum/Types.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Implementation/cpuFeatures.hpp"
+#include "Magnum/Math/Implementation/halfTables.hpp"
+
+namespace Magnum { namespace Math { namespace Implementation {
+
+/* Kernels converting a contiguous run of count elements. These are the
+   building blocks of the PackingBatch.h APIs, which take care of splitting
+   the strided views into contiguous runs. */
+template<class T, class U> using PackingBatchKernel = void(*)(const T*, U*, std::size_t);
+
+/* Scalar variants, used for the remaining elements that don't fill a whole
+   SIMD register and on platforms without any SIMD implementation */
+
+template<class T> void unpackScalar(const T* src, Float* dst, const std::size_t count) {
+    constexpr Float bitMax = Implementation::bitMax<T>();
+    for(std::size_t i = 0; i != count; ++i) {
+        const Float value = src[i]/bitMax;
+        /* Avoiding a max() call in Debug. Unsigned values are never below
+           zero so this is a no-op for them. */
+        dst[i] = value < -1.0f ? -1.0f : value;
+    }
+}
+
+template<class T> void packScalar(const Float* src, T* dst, const std::size_t count) {
+    constexpr Float bitMax = Implementation::bitMax<T>();
+    for(std::size_t i = 0; i != count; ++i)
+        /** @todo provide a version that doesn't do rounding */
+        dst[i] = T(std::round(src[i]*bitMax));
+}
+
+template<class T, class U> void castScalar(const T* src, U* dst, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i)
+        dst[i] = U(src[i]);
+}
+
+/* Table-based half-float conversion. The SIMD variants are bit-exact with
+   these, including the truncation when packing, overflow to infinity and
+   NaN payloads. */
+inline void unpackHalfScalar(const UnsignedShort* src, Float* dst, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i) {
+        const UnsignedShort h = src[i];
+        const UnsignedInt f = HalfMantissaTable[HalfOffsetTable[h >> 10] + (h & 0x3ff)] + HalfExponentTable[h >> 10];
+        std::memcpy(dst + i, &f, 4);
+    }
+}
+
+inline void packHalfScalar(const Float* src, UnsignedShort* dst, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i) {
+        UnsignedInt f;
+        std::memcpy(&f, src + i, 4);
+        dst[i] = HalfBaseTable[(f >> 23) & 0x1ff] + ((f & 0x007fffff) >> HalfShiftTable[(f >> 23) & 0x1ff]);
+    }
+}
+
+#ifdef CORRADE_TARGET_SSE2
+/* Operations on four 32-bit lanes. Integer loads sign- or zero-extend to 32
+   bits, integer stores keep only the low bits, which matches the modulo
+   behavior of scalar integer conversions. */
+struct Sse2 {
+    enum: std::size_t { Width = 4 };
+    typedef __m128i IntVector;
+    typedef __m128 FloatVector;
+
+    static IntVector load(const UnsignedByte* src) {
+        Int v;
+        std::memcpy(&v, src, 4);
+        const __m128i zero = _mm_setzero_si128();
+        return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(v), zero), zero);
+    }
+    static IntVector load(const Byte* src) {
+        Int v;
+        std::memcpy(&v, src, 4);
+        const __m128i a = _mm_unpacklo_epi8(_mm_cvtsi32_si128(v), _mm_cvtsi32_si128(v));
+        return _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 24);
+    }
+    static IntVector load(const UnsignedShort* src) {
+        return _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)), _mm_setzero_si128());
+    }
+    static IntVector load(const Short* src) {
+        const __m128i a = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+        return _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16);
+    }
+    static IntVector load(const UnsignedInt* src) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    }
+    static IntVector load(const Int* src) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    }
+    static FloatVector load(const Float* src) {
+        return _mm_loadu_ps(src);
+    }
+
+    static void store(UnsignedByte* dst, IntVector a) {
+        a = _mm_and_si128(a, _mm_set1_epi32(0xff));
+        a = _mm_packs_epi32(a, a);
+        const Int v = _mm_cvtsi128_si32(_mm_packus_epi16(a, a));
+        std::memcpy(dst, &v, 4);
+    }
+    static void store(Byte* dst, IntVector a) {
+        a = _mm_srai_epi32(_mm_slli_epi32(a, 24), 24);
+        a = _mm_packs_epi32(a, a);
+        const Int v = _mm_cvtsi128_si32(_mm_packs_epi16(a, a));
+        std::memcpy(dst, &v, 4);
+    }
+    /* Sign-extending the low 16 bits makes the signed saturation a no-op, so
+       the same works for both signed and unsigned shorts */
+    static void store(UnsignedShort* dst, IntVector a) {
+        a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packs_epi32(a, a));
+    }
+    static void store(Short* dst, IntVector a) {
+        store(reinterpret_cast<UnsignedShort*>(dst), a);
+    }
+    static void store(UnsignedInt* dst, IntVector a) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), a);
+    }
+    static void store(Int* dst, IntVector a) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), a);
+    }
+    static void store(Float* dst, FloatVector a) {
+        _mm_storeu_ps(dst, a);
+    }
+
+    /* Integer to float conversion. The unsigned 32-bit variant converts the
+       two 16-bit halves separately, which are both exact, so the final
+       addition is the only rounding, same as in the scalar conversion. */
+    template<class T> static FloatVector convert(IntVector a, const T*, Float*) {
+        return _mm_cvtepi32_ps(a);
+    }
+    static FloatVector convert(IntVector a, const UnsignedInt*, Float*) {
+        const __m128 high = _mm_cvtepi32_ps(_mm_srli_epi32(a, 16));
+        const __m128 low = _mm_cvtepi32_ps(_mm_and_si128(a, _mm_set1_epi32(0xffff)));
+        return _mm_add_ps(_mm_mul_ps(high, _mm_set1_ps(65536.0f)), low);
+    }
+
+    /* Float to integer conversion with truncation. Values not representable
+       in a signed 32-bit integer are shifted down for the unsigned variant
+       and the top bit is then put back. */
+    template<class U> static IntVector convert(FloatVector a, const Float*, U*) {
+        return _mm_cvttps_epi32(a);
+    }
+    static IntVector convert(FloatVector a, const Float*, UnsignedInt*) {
+        const __m128 twoPow31 = _mm_set1_ps(2147483648.0f);
+        const __m128 mask = _mm_cmpge_ps(a, twoPow31);
+        const __m128i b = _mm_cvttps_epi32(_mm_sub_ps(a, _mm_and_ps(mask, twoPow31)));
+        return _mm_xor_si128(b, _mm_slli_epi32(_mm_castps_si128(mask), 31));
+    }
+
+    /* Integer to integer conversion is done by the load and store */
+    template<class T, class U> static IntVector convert(IntVector a, const T*, U*) {
+        return a;
+    }
+
+    /* Rounding half away from zero, same as std::round(). The difference
+       between a value and its truncation is exact, so comparing it against
+       0.5 gives the same result as the scalar code. */
+    static IntVector round(FloatVector a) {
+        const __m128i truncated = _mm_cvttps_epi32(a);
+        const __m128 difference = _mm_sub_ps(a, _mm_cvtepi32_ps(truncated));
+        const __m128i up = _mm_castps_si128(_mm_cmpge_ps(difference, _mm_set1_ps(0.5f)));
+        const __m128i down = _mm_castps_si128(_mm_cmple_ps(difference, _mm_set1_ps(-0.5f)));
+        return _mm_add_epi32(_mm_sub_epi32(truncated, up), down);
+    }
+
+    static FloatVector splat(Float a) { return _mm_set1_ps(a); }
+    static FloatVector mul(FloatVector a, FloatVector b) { return _mm_mul_ps(a, b); }
+    static FloatVector div(FloatVector a, FloatVector b) { return _mm_div_ps(a, b); }
+    static FloatVector max(FloatVector a, FloatVector b) { return _mm_max_ps(a, b); }
+
+    static IntVector select(IntVector mask, IntVector a, IntVector b) {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+    /* Half to float conversion of zero-extended 16-bit lanes. Exponent and
+       mantissa get shifted into place and rebiased, infinities and NaNs get
+       the maximal exponent and denormals are renormalized by subtracting
+       the implicit one bit in floating-point, which is exact. */
+    static FloatVector unpackHalf(IntVector h) {
+        const __m128i sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+        const __m128i shifted = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7fff)), 13);
+        const __m128i exponent = _mm_and_si128(shifted, _mm_set1_epi32(0x7c00 << 13));
+        const __m128i normal = _mm_add_epi32(shifted, _mm_set1_epi32((127 - 15) << 23));
+        const __m128i infNan = _mm_add_epi32(normal, _mm_set1_epi32((128 - 16) << 23));
+        const __m128i denormal = _mm_castps_si128(_mm_sub_ps(
+            _mm_castsi128_ps(_mm_add_epi32(normal, _mm_set1_epi32(1 << 23))),
+            _mm_castsi128_ps(_mm_set1_epi32(113 << 23))));
+        const __m128i out =
+            select(_mm_cmpeq_epi32(exponent, _mm_setzero_si128()), denormal,
+            select(_mm_cmpeq_epi32(exponent, _mm_set1_epi32(0x7c00 << 13)), infNan,
+                normal));
+        return _mm_castsi128_ps(_mm_or_si128(out, sign));
+    }
+
+    /* Values that overflow a half become infinity, NaNs keep the top
+       mantissa bits. Returns the value without the sign bit. */
+    static IntVector packHalfInfNan(IntVector absolute) {
+        const __m128i nanMantissa = _mm_and_si128(
+            _mm_cmpgt_epi32(absolute, _mm_set1_epi32(0x7f7fffff)),
+            _mm_srli_epi32(_mm_and_si128(absolute, _mm_set1_epi32(0x007fffff)), 13));
+        return _mm_or_si128(nanMantissa, _mm_set1_epi32(0x7c00));
+    }
+
+    /* Float to half conversion with truncation into 32-bit lanes. Normal
+       halves are just the shifted and rebiased exponent and mantissa, for
+       denormals multiplying by 2^24 and truncating to an integer gives the
+       mantissa directly, flushing everything below the smallest denormal to
+       zero. */
+    static IntVector packHalf(FloatVector f) {
+        const __m128i bits = _mm_castps_si128(f);
+        const __m128i sign = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(0x8000));
+        const __m128i absolute = _mm_and_si128(bits, _mm_set1_epi32(0x7fffffff));
+        const __m128i denormal = _mm_cvttps_epi32(_mm_mul_ps(_mm_castsi128_ps(absolute), _mm_set1_ps(16777216.0f)));
+        const __m128i normal = _mm_sub_epi32(_mm_srli_epi32(absolute, 13), _mm_set1_epi32(112 << 10));
+        const __m128i out =
+            select(_mm_cmplt_epi32(absolute, _mm_set1_epi32(0x38800000)), denormal,
+            select(_mm_cmpgt_epi32(absolute, _mm_set1_epi32(0x477fffff)), packHalfInfNan(absolute),
+                normal));
+        return _mm_or_si128(out, sign);
+    }
+};
+
+template<class T> void unpackSse2(const T* src, Float* dst, const std::size_t count) {
+    const __m128 bitMax = Sse2::splat(Implementation::bitMax<T>());
+    const __m128 minusOne = Sse2::splat(-1.0f);
+    std::size_t i = 0;
+    for(; i + Sse2::Width <= count; i += Sse2::Width)
+        Sse2::store(dst + i, Sse2::max(Sse2::div(Sse2::convert(Sse2::load(src + i), src, dst), bitMax), minusOne));
+    unpackScalar(src + i, dst + i, count - i);
+}
+
+template<class T> void packSse2(const Float* src, T* dst, const std::size_t count) {
+    const __m128 bitMax = Sse2::splat(Implementation::bitMax<T>());
+    std::size_t i = 0;
+    for(; i + Sse2::Width <= count; i += Sse2::Width)
+        Sse2::store(dst + i, Sse2::round(Sse2::mul(Sse2::load(src + i), bitMax)));
+    packScalar(src + i, dst + i, count - i);
+}
+
+template<class T, class U> void castSse2(const T* src, U* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + Sse2::Width <= count; i += Sse2::Width)
+        Sse2::store(dst + i, Sse2::convert(Sse2::load(src + i), src, dst));
+    castScalar(src + i, dst + i, count - i);
+}
+
+inline void unpackHalfSse2(const UnsignedShort* src, Float* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + Sse2::Width <= count; i += Sse2::Width)
+        Sse2::store(dst + i, Sse2::unpackHalf(Sse2::load(src + i)));
+    unpackHalfScalar(src + i, dst + i, count - i);
+}
+
+inline void packHalfSse2(const Float* src, UnsignedShort* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + Sse2::Width <= count; i += Sse2::Width)
+        Sse2::store(dst + i, Sse2::packHalf(Sse2::load(src + i)));
+    packHalfScalar(src + i, dst + i, count - i);
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+/* SSE4.1 has dedicated sign- and zero-extending loads, the rest is the same
+   as SSE2 */
+struct Sse41: Sse2 {
+    using Sse2::load;
+
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 static IntVector load(const UnsignedByte* src) {
+        Int v;
+        std::memcpy(&v, src, 4);
+        return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(v));
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 static IntVector load(const Byte* src) {
+        Int v;
+        std::memcpy(&v, src, 4);
+        return _mm_cvtepi8_epi32(_mm_cvtsi32_si128(v));
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 static IntVector load(const UnsignedShort* src) {
+        return _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 static IntVector load(const Short* src) {
+        return _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
+    }
+};
+
+template<class T> MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 void unpackSse41(const T* src, Float* dst, const std::size_t count) {
+    const __m128 bitMax = Sse41::splat(Implementation::bitMax<T>());
+    const __m128 minusOne = Sse41::splat(-1.0f);
+    std::size_t i = 0;
+    for(; i + Sse41::Width <= count; i += Sse41::Width)
+        Sse41::store(dst + i, Sse41::max(Sse41::div(Sse41::convert(Sse41::load(src + i), src, dst), bitMax), minusOne));
+    unpackScalar(src + i, dst + i, count - i);
+}
+
+template<class T> MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 void packSse41(const Float* src, T* dst, const std::size_t count) {
+    const __m128 bitMax = Sse41::splat(Implementation::bitMax<T>());
+    std::size_t i = 0;
+    for(; i + Sse41::Width <= count; i += Sse41::Width)
+        Sse41::store(dst + i, Sse41::round(Sse41::mul(Sse41::load(src + i), bitMax)));
+    packScalar(src + i, dst + i, count - i);
+}
+
+template<class T, class U> MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 void castSse41(const T* src, U* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + Sse41::Width <= count; i += Sse41::Width)
+        Sse41::store(dst + i, Sse41::convert(Sse41::load(src + i), src, dst));
+    castScalar(src + i, dst + i, count - i);
+}
+
+/* Operations on eight 32-bit lanes, semantically equivalent to Sse2. The
+   AVX2 pack instructions operate on 128-bit halves, so the narrowing stores
+   split the vector first. */
+struct Avx2 {
+    enum: std::size_t { Width = 8 };
+    typedef __m256i IntVector;
+    typedef __m256 FloatVector;
+
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static IntVector load(const UnsignedByte* src) {
+        return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static IntVector load(const Byte* src) {
+        return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static IntVector load(const UnsignedShort* src) {
+        return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static IntVector load(const Short* src) {
+        return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static IntVector load(const UnsignedInt* src) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static IntVector load(const Int* src) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static FloatVector load(const Float* src) {
+        return _mm256_loadu_ps(src);
+    }
+
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static void store(UnsignedByte* dst, IntVector a) {
+        a = _mm256_and_si256(a, _mm256_set1_epi32(0xff));
+        const __m128i b = _mm_packs_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(b, b));
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static void store(Byte* dst, IntVector a) {
+        a = _mm256_srai_epi32(_mm256_slli_epi32(a, 24), 24);
+        const __m128i b = _mm_packs_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packs_epi16(b, b));
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static void store(UnsignedShort* dst, IntVector a) {
+        a = _mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packs_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1)));
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static void store(Short* dst, IntVector a) {
+        store(reinterpret_cast<UnsignedShort*>(dst), a);
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static void store(UnsignedInt* dst, IntVector a) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), a);
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static void store(Int* dst, IntVector a) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), a);
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static void store(Float* dst, FloatVector a) {
+        _mm256_storeu_ps(dst, a);
+    }
+
+    template<class T> MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static FloatVector convert(IntVector a, const T*, Float*) {
+        return _mm256_cvtepi32_ps(a);
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static FloatVector convert(IntVector a, const UnsignedInt*, Float*) {
+        const __m256 high = _mm256_cvtepi32_ps(_mm256_srli_epi32(a, 16));
+        const __m256 low = _mm256_cvtepi32_ps(_mm256_and_si256(a, _mm256_set1_epi32(0xffff)));
+        return _mm256_add_ps(_mm256_mul_ps(high, _mm256_set1_ps(65536.0f)), low);
+    }
+    template<class U> MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static IntVector convert(FloatVector a, const Float*, U*) {
+        return _mm256_cvttps_epi32(a);
+    }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static IntVector convert(FloatVector a, const Float*, UnsignedInt*) {
+        const __m256 twoPow31 = _mm256_set1_ps(2147483648.0f);
+        const __m256 mask = _mm256_cmp_ps(a, twoPow31, _CMP_GE_OQ);
+        const __m256i b = _mm256_cvttps_epi32(_mm256_sub_ps(a, _mm256_and_ps(mask, twoPow31)));
+        return _mm256_xor_si256(b, _mm256_slli_epi32(_mm256_castps_si256(mask), 31));
+    }
+    template<class T, class U> MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static IntVector convert(IntVector a, const T*, U*) {
+        return a;
+    }
+
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static IntVector round(FloatVector a) {
+        const __m256i truncated = _mm256_cvttps_epi32(a);
+        const __m256 difference = _mm256_sub_ps(a, _mm256_cvtepi32_ps(truncated));
+        const __m256i up = _mm256_castps_si256(_mm256_cmp_ps(difference, _mm256_set1_ps(0.5f), _CMP_GE_OQ));
+        const __m256i down = _mm256_castps_si256(_mm256_cmp_ps(difference, _mm256_set1_ps(-0.5f), _CMP_LE_OQ));
+        return _mm256_add_epi32(_mm256_sub_epi32(truncated, up), down);
+    }
+
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static FloatVector splat(Float a) { return _mm256_set1_ps(a); }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static FloatVector mul(FloatVector a, FloatVector b) { return _mm256_mul_ps(a, b); }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static FloatVector div(FloatVector a, FloatVector b) { return _mm256_div_ps(a, b); }
+    MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 static FloatVector max(FloatVector a, FloatVector b) { return _mm256_max_ps(a, b); }
+};
+
+template<class T> MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 void unpackAvx2(const T* src, Float* dst, const std::size_t count) {
+    const __m256 bitMax = Avx2::splat(Implementation::bitMax<T>());
+    const __m256 minusOne = Avx2::splat(-1.0f);
+    std::size_t i = 0;
+    for(; i + Avx2::Width <= count; i += Avx2::Width)
+        Avx2::store(dst + i, Avx2::max(Avx2::div(Avx2::convert(Avx2::load(src + i), src, dst), bitMax), minusOne));
+    unpackScalar(src + i, dst + i, count - i);
+}
+
+template<class T> MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 void packAvx2(const Float* src, T* dst, const std::size_t count) {
+    const __m256 bitMax = Avx2::splat(Implementation::bitMax<T>());
+    std::size_t i = 0;
+    for(; i + Avx2::Width <= count; i += Avx2::Width)
+        Avx2::store(dst + i, Avx2::round(Avx2::mul(Avx2::load(src + i), bitMax)));
+    packScalar(src + i, dst + i, count - i);
+}
+
+template<class T, class U> MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 void castAvx2(const T* src, U* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + Avx2::Width <= count; i += Avx2::Width)
+        Avx2::store(dst + i, Avx2::convert(Avx2::load(src + i), src, dst));
+    castScalar(src + i, dst + i, count - i);
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+/* The F16C instructions convert everything except NaNs the same way as the
+   tables. Signaling NaNs get quieted, so these lanes are patched up. */
+MAGNUM_MATH_IMPLEMENTATION_TARGET_F16C inline void unpackHalfF16c(const UnsignedShort* src, Float* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + Sse2::Width <= count; i += Sse2::Width) {
+        const __m128i h = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i h32 = _mm_unpacklo_epi16(h, _mm_setzero_si128());
+        const __m128i nan = _mm_cmpgt_epi32(_mm_and_si128(h32, _mm_set1_epi32(0x7fff)), _mm_set1_epi32(0x7c00));
+        const __m128i out = Sse2::select(nan,
+            _mm_castps_si128(Sse2::unpackHalf(h32)),
+            _mm_castps_si128(_mm_cvtph_ps(h)));
+        Sse2::store(dst + i, _mm_castsi128_ps(out));
+    }
+    unpackHalfScalar(src + i, dst + i, count - i);
+}
+
+/* Truncating to match the tables. The only differences are overflow, which
+   gets clamped to the largest finite value instead of becoming an infinity,
+   and NaNs, which get quieted. These lanes are patched up. */
+MAGNUM_MATH_IMPLEMENTATION_TARGET_F16C inline void packHalfF16c(const Float* src, UnsignedShort* dst, const std::size_t count) {
+    const __m128i absoluteMask = _mm_set1_epi32(0x7fffffff);
+    const __m128i overflow = _mm_set1_epi32(0x477fffff);
+    std::size_t i = 0;
+    for(; i + 2*Sse2::Width <= count; i += 2*Sse2::Width) {
+        const __m128 a = _mm_loadu_ps(src + i);
+        const __m128 b = _mm_loadu_ps(src + i + Sse2::Width);
+        const __m128i h = _mm_unpacklo_epi64(
+            _mm_cvtps_ph(a, _MM_FROUND_TO_ZERO),
+            _mm_cvtps_ph(b, _MM_FROUND_TO_ZERO));
+
+        const __m128i absoluteA = _mm_and_si128(_mm_castps_si128(a), absoluteMask);
+        const __m128i absoluteB = _mm_and_si128(_mm_castps_si128(b), absoluteMask);
+        const __m128i mask = _mm_packs_epi32(
+            _mm_cmpgt_epi32(absoluteA, overflow),
+            _mm_cmpgt_epi32(absoluteB, overflow));
+        /* Without the sign the values fit into a signed 16-bit integer, so
+           the saturation does nothing */
+        const __m128i infNan = _mm_or_si128(
+            _mm_packs_epi32(Sse2::packHalfInfNan(absoluteA), Sse2::packHalfInfNan(absoluteB)),
+            _mm_and_si128(h, _mm_set1_epi16(Short(0x8000))));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), Sse2::select(mask, infNan, h));
+    }
+    packHalfSse2(src + i, dst + i, count - i);
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+/* Operations on four 32-bit lanes, semantically equivalent to Sse2. The
+   narrowing moves keep only the low bits, so the stores don't need any
+   masking. */
+struct Neon {
+    enum: std::size_t { Width = 4 };
+    typedef int32x4_t IntVector;
+    typedef float32x4_t FloatVector;
+
+    static IntVector load(const UnsignedByte* src) {
+        uint8x8_t a = vdup_n_u8(0);
+        a = vreinterpret_u8_u32(vld1_lane_u32(reinterpret_cast<const uint32_t*>(src), vreinterpret_u32_u8(a), 0));
+        return vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(vmovl_u8(a))));
+    }
+    static IntVector load(const Byte* src) {
+        int8x8_t a = vdup_n_s8(0);
+        a = vreinterpret_s8_u32(vld1_lane_u32(reinterpret_cast<const uint32_t*>(src), vreinterpret_u32_s8(a), 0));
+        return vmovl_s16(vget_low_s16(vmovl_s8(a)));
+    }
+    static IntVector load(const UnsignedShort* src) {
+        return vreinterpretq_s32_u32(vmovl_u16(vld1_u16(src)));
+    }
+    static IntVector load(const Short* src) {
+        return vmovl_s16(vld1_s16(src));
+    }
+    static IntVector load(const UnsignedInt* src) {
+        return vreinterpretq_s32_u32(vld1q_u32(src));
+    }
+    static IntVector load(const Int* src) {
+        return vld1q_s32(src);
+    }
+    static FloatVector load(const Float* src) {
+        return vld1q_f32(src);
+    }
+
+    static void store(UnsignedByte* dst, IntVector a) {
+        const uint16x4_t b = vmovn_u32(vreinterpretq_u32_s32(a));
+        const uint8x8_t c = vmovn_u16(vcombine_u16(b, b));
+        vst1_lane_u32(reinterpret_cast<uint32_t*>(dst), vreinterpret_u32_u8(c), 0);
+    }
+    static void store(Byte* dst, IntVector a) {
+        store(reinterpret_cast<UnsignedByte*>(dst), a);
+    }
+    static void store(UnsignedShort* dst, IntVector a) {
+        vst1_u16(dst, vmovn_u32(vreinterpretq_u32_s32(a)));
+    }
+    static void store(Short* dst, IntVector a) {
+        vst1_s16(dst, vmovn_s32(a));
+    }
+    static void store(UnsignedInt* dst, IntVector a) {
+        vst1q_u32(dst, vreinterpretq_u32_s32(a));
+    }
+    static void store(Int* dst, IntVector a) {
+        vst1q_s32(dst, a);
+    }
+    static void store(Float* dst, FloatVector a) {
+        vst1q_f32(dst, a);
+    }
+
+    template<class T> static FloatVector convert(IntVector a, const T*, Float*) {
+        return vcvtq_f32_s32(a);
+    }
+    static FloatVector convert(IntVector a, const UnsignedInt*, Float*) {
+        return vcvtq_f32_u32(vreinterpretq_u32_s32(a));
+    }
+    template<class U> static IntVector convert(FloatVector a, const Float*, U*) {
+        return vcvtq_s32_f32(a);
+    }
+    static IntVector convert(FloatVector a, const Float*, UnsignedInt*) {
+        return vreinterpretq_s32_u32(vcvtq_u32_f32(a));
+    }
+    template<class T, class U> static IntVector convert(IntVector a, const T*, U*) {
+        return a;
+    }
+
+    /* vcvtaq rounds half away from zero, same as std::round() */
+    static IntVector round(FloatVector a) {
+        return vcvtaq_s32_f32(a);
+    }
+
+    static FloatVector splat(Float a) { return vdupq_n_f32(a); }
+    static FloatVector mul(FloatVector a, FloatVector b) { return vmulq_f32(a, b); }
+    static FloatVector div(FloatVector a, FloatVector b) { return vdivq_f32(a, b); }
+    static FloatVector max(FloatVector a, FloatVector b) { return vmaxq_f32(a, b); }
+};
+
+template<class T> void unpackNeon(const T* src, Float* dst, const std::size_t count) {
+    const float32x4_t bitMax = Neon::splat(Implementation::bitMax<T>());
+    const float32x4_t minusOne = Neon::splat(-1.0f);
+    std::size_t i = 0;
+    for(; i + Neon::Width <= count; i += Neon::Width)
+        Neon::store(dst + i, Neon::max(Neon::div(Neon::convert(Neon::load(src + i), src, dst), bitMax), minusOne));
+    unpackScalar(src + i, dst + i, count - i);
+}
+
+template<class T> void packNeon(const Float* src, T* dst, const std::size_t count) {
+    const float32x4_t bitMax = Neon::splat(Implementation::bitMax<T>());
+    std::size_t i = 0;
+    for(; i + Neon::Width <= count; i += Neon::Width)
+        Neon::store(dst + i, Neon::round(Neon::mul(Neon::load(src + i), bitMax)));
+    packScalar(src + i, dst + i, count - i);
+}
+
+template<class T, class U> void castNeon(const T* src, U* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + Neon::Width <= count; i += Neon::Width)
+        Neon::store(dst + i, Neon::convert(Neon::load(src + i), src, dst));
+    castScalar(src + i, dst + i, count - i);
+}
+#endif
+
+/* Picks the best kernel for the current CPU */
+template<class T> PackingBatchKernel<T, Float> unpackKernel() {
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+    if(cpuFeatures().avx2) return unpackAvx2<T>;
+    if(cpuFeatures().sse41) return unpackSse41<T>;
+    #endif
+    #if defined(CORRADE_TARGET_SSE2)
+    return unpackSse2<T>;
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    return unpackNeon<T>;
+    #else
+    return unpackScalar<T>;
+    #endif
+}
+
+template<class T> PackingBatchKernel<Float, T> packKernel() {
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+    if(cpuFeatures().avx2) return packAvx2<T>;
+    if(cpuFeatures().sse41) return packSse41<T>;
+    #endif
+    #if defined(CORRADE_TARGET_SSE2)
+    return packSse2<T>;
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    return packNeon<T>;
+    #else
+    return packScalar<T>;
+    #endif
+}
+
+template<class T, class U> PackingBatchKernel<T, U> castKernel() {
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+    if(cpuFeatures().avx2) return castAvx2<T, U>;
+    if(cpuFeatures().sse41) return castSse41<T, U>;
+    #endif
+    #if defined(CORRADE_TARGET_SSE2)
+    return castSse2<T, U>;
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    return castNeon<T, U>;
+    #else
+    return castScalar<T, U>;
+    #endif
+}
+
+inline PackingBatchKernel<UnsignedShort, Float> unpackHalfKernel() {
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+    if(cpuFeatures().f16c) return unpackHalfF16c;
+    #endif
+    #ifdef CORRADE_TARGET_SSE2
+    return unpackHalfSse2;
+    #else
+    return unpackHalfScalar;
+    #endif
+}
+
+inline PackingBatchKernel<Float, UnsignedShort> packHalfKernel() {
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+    if(cpuFeatures().f16c) return packHalfF16c;
+    #endif
+    #ifdef CORRADE_TARGET_SSE2
+    return packHalfSse2;
+    #else
+    return packHalfScalar;
+    #endif
+}
+
+}}}
+
+#endif
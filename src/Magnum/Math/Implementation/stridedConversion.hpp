@@ -0,0 +1,107 @@
+#ifndef Magnum_Math_Implementation_stridedConversion_hpp
+#define Magnum_Math_Implementation_stridedConversion_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Types.h"
+
+namespace Magnum { namespace Math { namespace Implementation {
+
+/* Shared by the PackingBatch.h and ColorBatch.h APIs, which convert 2D
+   strided views using kernels working on contiguous memory */
+
+/* Copies count rows of given byte size between two strided locations. Row
+   sizes of common vertex formats and pixel formats get a fixed-size copy. */
+template<std::size_t size> inline void copyRows(const char* src, const std::ptrdiff_t srcStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, src += srcStride, dst += dstStride)
+        std::memcpy(dst, src, size);
+}
+
+inline void copyRows(const char* src, const std::ptrdiff_t srcStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count, const std::size_t size) {
+    switch(size) {
+        case 1: return copyRows<1>(src, srcStride, dst, dstStride, count);
+        case 2: return copyRows<2>(src, srcStride, dst, dstStride, count);
+        case 3: return copyRows<3>(src, srcStride, dst, dstStride, count);
+        case 4: return copyRows<4>(src, srcStride, dst, dstStride, count);
+        case 6: return copyRows<6>(src, srcStride, dst, dstStride, count);
+        case 8: return copyRows<8>(src, srcStride, dst, dstStride, count);
+        case 12: return copyRows<12>(src, srcStride, dst, dstStride, count);
+        case 16: return copyRows<16>(src, srcStride, dst, dstStride, count);
+    }
+
+    for(std::size_t i = 0; i != count; ++i, src += srcStride, dst += dstStride)
+        std::memcpy(dst, src, size);
+}
+
+/* Rows with at least this many elements are converted one by one, shorter
+   ones are gathered into blocks of this many elements first */
+enum: std::size_t { ConversionBlockSize = 256, ConversionMinRowSize = 16 };
+
+/* Converts a 2D view using a kernel working on contiguous memory. If both
+   views are contiguous, the whole data get converted at once. Otherwise long
+   rows (such as image rows with padding) are converted one by one and short
+   rows (such as interleaved vertex attributes) are gathered into a
+   contiguous block on stack, converted and scattered back. */
+template<class T, class U> void convertInto(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<U>& dst, void(*const kernel)(const T*, U*, std::size_t)) {
+    /* Caching values to avoid inline function calls in debug builds */
+    const char* srcPtr = reinterpret_cast<const char*>(src.data());
+    char* dstPtr = reinterpret_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride()[0];
+    const std::ptrdiff_t dstStride = dst.stride()[0];
+    const std::size_t maxI = src.size()[0];
+    const std::size_t maxJ = src.size()[1];
+    if(!maxI || !maxJ) return;
+
+    if(src.template isContiguous<0>() && dst.template isContiguous<0>()) {
+        kernel(reinterpret_cast<const T*>(srcPtr), reinterpret_cast<U*>(dstPtr), maxI*maxJ);
+
+    } else if(maxJ >= ConversionMinRowSize) {
+        for(std::size_t i = 0; i != maxI; ++i) {
+            kernel(reinterpret_cast<const T*>(srcPtr), reinterpret_cast<U*>(dstPtr), maxJ);
+            srcPtr += srcStride;
+            dstPtr += dstStride;
+        }
+
+    } else {
+        T srcBlock[ConversionBlockSize];
+        U dstBlock[ConversionBlockSize];
+        const std::size_t rowsPerBlock = ConversionBlockSize/maxJ;
+        for(std::size_t i = 0; i < maxI; i += rowsPerBlock) {
+            const std::size_t rowCount = rowsPerBlock < maxI - i ? rowsPerBlock : maxI - i;
+            copyRows(srcPtr, srcStride, reinterpret_cast<char*>(srcBlock), std::ptrdiff_t(maxJ*sizeof(T)), rowCount, maxJ*sizeof(T));
+            kernel(srcBlock, dstBlock, rowCount*maxJ);
+            copyRows(reinterpret_cast<const char*>(dstBlock), std::ptrdiff_t(maxJ*sizeof(U)), dstPtr, dstStride, rowCount, maxJ*sizeof(U));
+            srcPtr += std::ptrdiff_t(rowCount)*srcStride;
+            dstPtr += std::ptrdiff_t(rowCount)*dstStride;
+        }
+    }
+}
+
+}}}
+
+#endif
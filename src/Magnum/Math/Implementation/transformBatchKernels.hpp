@@ -0,0 +1,424 @@
+#ifndef Magnum_Math_Implementation_transformBatchKernels_hpp
+#define Magnum_Math_Implementation_transformBatchKernels_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+
+#include "Magnum/Types.h"
+#include "Magnum/Math/Implementation/cpuFeatures.hpp"
+
+namespace Magnum { namespace Math { namespace Implementation {
+
+/* Kernels working on count elements given by a pointer and a byte stride.
+   Matrices are 16 column-major floats, points and vectors three floats.
+   Everything is read before being written, so the output is allowed to
+   alias the input. Apart from the inversion, the operations are done in the
+   same order as in the Matrix4 APIs, so the results are the same as well. */
+typedef void(*MatrixMultiplyKernel)(const char*, std::ptrdiff_t, const char*, std::ptrdiff_t, char*, std::ptrdiff_t, std::size_t);
+typedef void(*MatrixTransformKernel)(const Float*, const char*, std::ptrdiff_t, char*, std::ptrdiff_t, std::size_t);
+typedef void(*MatrixInvertKernel)(const char*, std::ptrdiff_t, char*, std::ptrdiff_t, std::size_t);
+
+/* Inverse of a 4x4 matrix using 2x2 subdeterminants, written once for
+   scalars and for SIMD registers holding the same element of several
+   matrices. Element a[4*i + j] is column i and row j, the output has the same
+   layout. */
+template<class V> inline void invertMatrix(const V(&a)[16], V(&b)[16], const V one) {
+    const V s0 = a[0]*a[5] - a[4]*a[1];
+    const V s1 = a[0]*a[6] - a[4]*a[2];
+    const V s2 = a[0]*a[7] - a[4]*a[3];
+    const V s3 = a[1]*a[6] - a[5]*a[2];
+    const V s4 = a[1]*a[7] - a[5]*a[3];
+    const V s5 = a[2]*a[7] - a[6]*a[3];
+    const V c5 = a[10]*a[15] - a[14]*a[11];
+    const V c4 = a[9]*a[15] - a[13]*a[11];
+    const V c3 = a[9]*a[14] - a[13]*a[10];
+    const V c2 = a[8]*a[15] - a[12]*a[11];
+    const V c1 = a[8]*a[14] - a[12]*a[10];
+    const V c0 = a[8]*a[13] - a[12]*a[9];
+    const V invDet = one/(s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0);
+
+    b[0] = (a[5]*c5 - a[6]*c4 + a[7]*c3)*invDet;
+    b[1] = (a[2]*c4 - a[1]*c5 - a[3]*c3)*invDet;
+    b[2] = (a[13]*s5 - a[14]*s4 + a[15]*s3)*invDet;
+    b[3] = (a[10]*s4 - a[9]*s5 - a[11]*s3)*invDet;
+    b[4] = (a[6]*c2 - a[4]*c5 - a[7]*c1)*invDet;
+    b[5] = (a[0]*c5 - a[2]*c2 + a[3]*c1)*invDet;
+    b[6] = (a[14]*s2 - a[12]*s5 - a[15]*s1)*invDet;
+    b[7] = (a[8]*s5 - a[10]*s2 + a[11]*s1)*invDet;
+    b[8] = (a[4]*c4 - a[5]*c2 + a[7]*c0)*invDet;
+    b[9] = (a[1]*c2 - a[0]*c4 - a[3]*c0)*invDet;
+    b[10] = (a[12]*s4 - a[13]*s2 + a[15]*s0)*invDet;
+    b[11] = (a[9]*s2 - a[8]*s4 - a[11]*s0)*invDet;
+    b[12] = (a[5]*c1 - a[4]*c3 - a[6]*c0)*invDet;
+    b[13] = (a[0]*c3 - a[1]*c1 + a[2]*c0)*invDet;
+    b[14] = (a[13]*s1 - a[12]*s3 - a[14]*s0)*invDet;
+    b[15] = (a[8]*s3 - a[9]*s1 + a[10]*s0)*invDet;
+}
+
+inline void multiplyMatricesScalar(const char* a, const std::ptrdiff_t aStride, const char* b, const std::ptrdiff_t bStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, a += aStride, b += bStride, dst += dstStride) {
+        Float am[16], bm[16], out[16];
+        std::memcpy(am, a, sizeof(am));
+        std::memcpy(bm, b, sizeof(bm));
+        for(std::size_t col = 0; col != 4; ++col)
+            for(std::size_t row = 0; row != 4; ++row)
+                out[col*4 + row] = am[row]*bm[col*4] + am[4 + row]*bm[col*4 + 1] + am[8 + row]*bm[col*4 + 2] + am[12 + row]*bm[col*4 + 3];
+        std::memcpy(dst, out, sizeof(out));
+    }
+}
+
+inline void transformPointsScalar(const Float* m, const char* src, const std::ptrdiff_t srcStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, src += srcStride, dst += dstStride) {
+        Float p[3], out[4];
+        std::memcpy(p, src, sizeof(p));
+        for(std::size_t row = 0; row != 4; ++row)
+            out[row] = m[row]*p[0] + m[4 + row]*p[1] + m[8 + row]*p[2] + m[12 + row];
+        for(std::size_t row = 0; row != 3; ++row)
+            out[row] /= out[3];
+        std::memcpy(dst, out, 3*sizeof(Float));
+    }
+}
+
+inline void transformVectorsScalar(const Float* m, const char* src, const std::ptrdiff_t srcStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, src += srcStride, dst += dstStride) {
+        Float v[3], out[3];
+        std::memcpy(v, src, sizeof(v));
+        for(std::size_t row = 0; row != 3; ++row)
+            out[row] = m[row]*v[0] + m[4 + row]*v[1] + m[8 + row]*v[2];
+        std::memcpy(dst, out, sizeof(out));
+    }
+}
+
+inline void invertMatricesScalar(const char* src, const std::ptrdiff_t srcStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, src += srcStride, dst += dstStride) {
+        Float a[16], b[16];
+        std::memcpy(a, src, sizeof(a));
+        invertMatrix(a, b, 1.0f);
+        std::memcpy(dst, b, sizeof(b));
+    }
+}
+
+#ifdef CORRADE_TARGET_SSE2
+/* Column-wise linear combination, the building block of both the
+   multiplication and the transformation */
+inline __m128 combineColumnsSse2(const __m128 c0, const __m128 c1, const __m128 c2, const __m128 c3, const Float* v) {
+    return _mm_add_ps(_mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(c0, _mm_set1_ps(v[0])),
+        _mm_mul_ps(c1, _mm_set1_ps(v[1]))),
+        _mm_mul_ps(c2, _mm_set1_ps(v[2]))),
+        _mm_mul_ps(c3, _mm_set1_ps(v[3])));
+}
+
+inline void multiplyMatrixSse2(const Float* a, const Float* b, Float* dst) {
+    const __m128 a0 = _mm_loadu_ps(a);
+    const __m128 a1 = _mm_loadu_ps(a + 4);
+    const __m128 a2 = _mm_loadu_ps(a + 8);
+    const __m128 a3 = _mm_loadu_ps(a + 12);
+    Float bm[16];
+    std::memcpy(bm, b, sizeof(bm));
+    for(std::size_t col = 0; col != 4; ++col)
+        _mm_storeu_ps(dst + col*4, combineColumnsSse2(a0, a1, a2, a3, bm + col*4));
+}
+
+inline void multiplyMatricesSse2(const char* a, const std::ptrdiff_t aStride, const char* b, const std::ptrdiff_t bStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, a += aStride, b += bStride, dst += dstStride)
+        multiplyMatrixSse2(reinterpret_cast<const Float*>(a), reinterpret_cast<const Float*>(b), reinterpret_cast<Float*>(dst));
+}
+
+/* Stores the first three components, not touching the memory after */
+inline void storeVector3Sse2(char* dst, const __m128 a) {
+    _mm_storel_pi(reinterpret_cast<__m64*>(dst), a);
+    _mm_store_ss(reinterpret_cast<Float*>(dst) + 2, _mm_movehl_ps(a, a));
+}
+
+inline void transformPointsSse2(const Float* m, const char* src, const std::ptrdiff_t srcStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    const __m128 c0 = _mm_loadu_ps(m);
+    const __m128 c1 = _mm_loadu_ps(m + 4);
+    const __m128 c2 = _mm_loadu_ps(m + 8);
+    const __m128 c3 = _mm_loadu_ps(m + 12);
+    for(std::size_t i = 0; i != count; ++i, src += srcStride, dst += dstStride) {
+        const Float* p = reinterpret_cast<const Float*>(src);
+        const __m128 out = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(c0, _mm_set1_ps(p[0])),
+            _mm_mul_ps(c1, _mm_set1_ps(p[1]))),
+            _mm_mul_ps(c2, _mm_set1_ps(p[2]))), c3);
+        storeVector3Sse2(dst, _mm_div_ps(out, _mm_shuffle_ps(out, out, _MM_SHUFFLE(3, 3, 3, 3))));
+    }
+}
+
+inline void transformVectorsSse2(const Float* m, const char* src, const std::ptrdiff_t srcStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    const __m128 c0 = _mm_loadu_ps(m);
+    const __m128 c1 = _mm_loadu_ps(m + 4);
+    const __m128 c2 = _mm_loadu_ps(m + 8);
+    for(std::size_t i = 0; i != count; ++i, src += srcStride, dst += dstStride) {
+        const Float* v = reinterpret_cast<const Float*>(src);
+        storeVector3Sse2(dst, _mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(c0, _mm_set1_ps(v[0])),
+            _mm_mul_ps(c1, _mm_set1_ps(v[1]))),
+            _mm_mul_ps(c2, _mm_set1_ps(v[2]))));
+    }
+}
+
+/* Four matrices inverted at once, each register holding the same element of
+   all four */
+struct Sse2Lanes { __m128 v; };
+inline Sse2Lanes operator+(Sse2Lanes a, Sse2Lanes b) { return {_mm_add_ps(a.v, b.v)}; }
+inline Sse2Lanes operator-(Sse2Lanes a, Sse2Lanes b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline Sse2Lanes operator*(Sse2Lanes a, Sse2Lanes b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline Sse2Lanes operator/(Sse2Lanes a, Sse2Lanes b) { return {_mm_div_ps(a.v, b.v)}; }
+
+inline void invertMatricesSse2(const char* src, const std::ptrdiff_t srcStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4, src += 4*srcStride, dst += 4*dstStride) {
+        Sse2Lanes a[16], b[16];
+        for(std::size_t col = 0; col != 4; ++col) {
+            __m128 r0 = _mm_loadu_ps(reinterpret_cast<const Float*>(src) + col*4);
+            __m128 r1 = _mm_loadu_ps(reinterpret_cast<const Float*>(src + srcStride) + col*4);
+            __m128 r2 = _mm_loadu_ps(reinterpret_cast<const Float*>(src + 2*srcStride) + col*4);
+            __m128 r3 = _mm_loadu_ps(reinterpret_cast<const Float*>(src + 3*srcStride) + col*4);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            a[col*4 + 0].v = r0;
+            a[col*4 + 1].v = r1;
+            a[col*4 + 2].v = r2;
+            a[col*4 + 3].v = r3;
+        }
+
+        invertMatrix(a, b, Sse2Lanes{_mm_set1_ps(1.0f)});
+
+        for(std::size_t col = 0; col != 4; ++col) {
+            __m128 r0 = b[col*4 + 0].v;
+            __m128 r1 = b[col*4 + 1].v;
+            __m128 r2 = b[col*4 + 2].v;
+            __m128 r3 = b[col*4 + 3].v;
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(reinterpret_cast<Float*>(dst) + col*4, r0);
+            _mm_storeu_ps(reinterpret_cast<Float*>(dst + dstStride) + col*4, r1);
+            _mm_storeu_ps(reinterpret_cast<Float*>(dst + 2*dstStride) + col*4, r2);
+            _mm_storeu_ps(reinterpret_cast<Float*>(dst + 3*dstStride) + col*4, r3);
+        }
+    }
+    invertMatricesScalar(src, srcStride, dst, dstStride, count - i);
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+/* Two output columns at once, with the columns of the left matrix
+   duplicated into both halves of a register and the right matrix elements
+   splatted within each half */
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline void multiplyMatricesAvx2(const char* a, const std::ptrdiff_t aStride, const char* b, const std::ptrdiff_t bStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, a += aStride, b += bStride, dst += dstStride) {
+        const Float* af = reinterpret_cast<const Float*>(a);
+        const Float* bf = reinterpret_cast<const Float*>(b);
+        Float* df = reinterpret_cast<Float*>(dst);
+        const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(af));
+        const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(af + 4));
+        const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(af + 8));
+        const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(af + 12));
+        const __m256 b01 = _mm256_loadu_ps(bf);
+        const __m256 b23 = _mm256_loadu_ps(bf + 8);
+        const __m256 c01 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(a0, _mm256_permute_ps(b01, _MM_SHUFFLE(0, 0, 0, 0))),
+            _mm256_mul_ps(a1, _mm256_permute_ps(b01, _MM_SHUFFLE(1, 1, 1, 1)))),
+            _mm256_mul_ps(a2, _mm256_permute_ps(b01, _MM_SHUFFLE(2, 2, 2, 2)))),
+            _mm256_mul_ps(a3, _mm256_permute_ps(b01, _MM_SHUFFLE(3, 3, 3, 3))));
+        const __m256 c23 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(a0, _mm256_permute_ps(b23, _MM_SHUFFLE(0, 0, 0, 0))),
+            _mm256_mul_ps(a1, _mm256_permute_ps(b23, _MM_SHUFFLE(1, 1, 1, 1)))),
+            _mm256_mul_ps(a2, _mm256_permute_ps(b23, _MM_SHUFFLE(2, 2, 2, 2)))),
+            _mm256_mul_ps(a3, _mm256_permute_ps(b23, _MM_SHUFFLE(3, 3, 3, 3))));
+        _mm256_storeu_ps(df, c01);
+        _mm256_storeu_ps(df + 8, c23);
+    }
+}
+
+/* Two points at once, with the matrix columns duplicated into both halves
+   of a register */
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline void transformPointsAvx2(const Float* m, const char* src, const std::ptrdiff_t srcStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m));
+    const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 4));
+    const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 8));
+    const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 12));
+    std::size_t i = 0;
+    for(; i + 2 <= count; i += 2, src += 2*srcStride, dst += 2*dstStride) {
+        const Float* p = reinterpret_cast<const Float*>(src);
+        const Float* q = reinterpret_cast<const Float*>(src + srcStride);
+        const __m256 out = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+            _mm256_mul_ps(c0, _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(p[0])), _mm_set1_ps(q[0]), 1)),
+            _mm256_mul_ps(c1, _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(p[1])), _mm_set1_ps(q[1]), 1))),
+            _mm256_mul_ps(c2, _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(p[2])), _mm_set1_ps(q[2]), 1))),
+            c3);
+        const __m256 divided = _mm256_div_ps(out, _mm256_permute_ps(out, _MM_SHUFFLE(3, 3, 3, 3)));
+        storeVector3Sse2(dst, _mm256_castps256_ps128(divided));
+        storeVector3Sse2(dst + dstStride, _mm256_extractf128_ps(divided, 1));
+    }
+    transformPointsSse2(m, src, srcStride, dst, dstStride, count - i);
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+inline float32x4_t combineColumnsNeon(const float32x4_t c0, const float32x4_t c1, const float32x4_t c2, const float32x4_t c3, const Float* v) {
+    return vaddq_f32(vaddq_f32(vaddq_f32(
+        vmulq_n_f32(c0, v[0]),
+        vmulq_n_f32(c1, v[1])),
+        vmulq_n_f32(c2, v[2])),
+        vmulq_n_f32(c3, v[3]));
+}
+
+inline void multiplyMatricesNeon(const char* a, const std::ptrdiff_t aStride, const char* b, const std::ptrdiff_t bStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, a += aStride, b += bStride, dst += dstStride) {
+        const Float* af = reinterpret_cast<const Float*>(a);
+        const float32x4_t a0 = vld1q_f32(af);
+        const float32x4_t a1 = vld1q_f32(af + 4);
+        const float32x4_t a2 = vld1q_f32(af + 8);
+        const float32x4_t a3 = vld1q_f32(af + 12);
+        Float bm[16];
+        std::memcpy(bm, b, sizeof(bm));
+        for(std::size_t col = 0; col != 4; ++col)
+            vst1q_f32(reinterpret_cast<Float*>(dst) + col*4, combineColumnsNeon(a0, a1, a2, a3, bm + col*4));
+    }
+}
+
+inline void storeVector3Neon(char* dst, const float32x4_t a) {
+    vst1_f32(reinterpret_cast<Float*>(dst), vget_low_f32(a));
+    vst1q_lane_f32(reinterpret_cast<Float*>(dst) + 2, a, 2);
+}
+
+inline void transformPointsNeon(const Float* m, const char* src, const std::ptrdiff_t srcStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    const float32x4_t c0 = vld1q_f32(m);
+    const float32x4_t c1 = vld1q_f32(m + 4);
+    const float32x4_t c2 = vld1q_f32(m + 8);
+    const float32x4_t c3 = vld1q_f32(m + 12);
+    for(std::size_t i = 0; i != count; ++i, src += srcStride, dst += dstStride) {
+        const Float* p = reinterpret_cast<const Float*>(src);
+        const float32x4_t out = vaddq_f32(vaddq_f32(vaddq_f32(
+            vmulq_n_f32(c0, p[0]),
+            vmulq_n_f32(c1, p[1])),
+            vmulq_n_f32(c2, p[2])), c3);
+        storeVector3Neon(dst, vdivq_f32(out, vdupq_laneq_f32(out, 3)));
+    }
+}
+
+inline void transformVectorsNeon(const Float* m, const char* src, const std::ptrdiff_t srcStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    const float32x4_t c0 = vld1q_f32(m);
+    const float32x4_t c1 = vld1q_f32(m + 4);
+    const float32x4_t c2 = vld1q_f32(m + 8);
+    for(std::size_t i = 0; i != count; ++i, src += srcStride, dst += dstStride) {
+        const Float* v = reinterpret_cast<const Float*>(src);
+        storeVector3Neon(dst, vaddq_f32(vaddq_f32(
+            vmulq_n_f32(c0, v[0]),
+            vmulq_n_f32(c1, v[1])),
+            vmulq_n_f32(c2, v[2])));
+    }
+}
+
+struct NeonLanes { float32x4_t v; };
+inline NeonLanes operator+(NeonLanes a, NeonLanes b) { return {vaddq_f32(a.v, b.v)}; }
+inline NeonLanes operator-(NeonLanes a, NeonLanes b) { return {vsubq_f32(a.v, b.v)}; }
+inline NeonLanes operator*(NeonLanes a, NeonLanes b) { return {vmulq_f32(a.v, b.v)}; }
+inline NeonLanes operator/(NeonLanes a, NeonLanes b) { return {vdivq_f32(a.v, b.v)}; }
+
+/* The lane loads and stores transpose four matrices on the fly */
+inline void invertMatricesNeon(const char* src, const std::ptrdiff_t srcStride, char* dst, const std::ptrdiff_t dstStride, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4, src += 4*srcStride, dst += 4*dstStride) {
+        NeonLanes a[16], b[16];
+        for(std::size_t col = 0; col != 4; ++col) {
+            float32x4x4_t r;
+            r.val[0] = r.val[1] = r.val[2] = r.val[3] = vdupq_n_f32(0.0f);
+            r = vld4q_lane_f32(reinterpret_cast<const Float*>(src) + col*4, r, 0);
+            r = vld4q_lane_f32(reinterpret_cast<const Float*>(src + srcStride) + col*4, r, 1);
+            r = vld4q_lane_f32(reinterpret_cast<const Float*>(src + 2*srcStride) + col*4, r, 2);
+            r = vld4q_lane_f32(reinterpret_cast<const Float*>(src + 3*srcStride) + col*4, r, 3);
+            for(std::size_t row = 0; row != 4; ++row)
+                a[col*4 + row].v = r.val[row];
+        }
+
+        invertMatrix(a, b, NeonLanes{vdupq_n_f32(1.0f)});
+
+        for(std::size_t col = 0; col != 4; ++col) {
+            float32x4x4_t r;
+            for(std::size_t row = 0; row != 4; ++row)
+                r.val[row] = b[col*4 + row].v;
+            vst4q_lane_f32(reinterpret_cast<Float*>(dst) + col*4, r, 0);
+            vst4q_lane_f32(reinterpret_cast<Float*>(dst + dstStride) + col*4, r, 1);
+            vst4q_lane_f32(reinterpret_cast<Float*>(dst + 2*dstStride) + col*4, r, 2);
+            vst4q_lane_f32(reinterpret_cast<Float*>(dst + 3*dstStride) + col*4, r, 3);
+        }
+    }
+    invertMatricesScalar(src, srcStride, dst, dstStride, count - i);
+}
+#endif
+
+/* Picks the best kernel for the current CPU */
+inline MatrixMultiplyKernel multiplyMatricesKernel() {
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+    if(cpuFeatures().avx2) return multiplyMatricesAvx2;
+    #endif
+    #if defined(CORRADE_TARGET_SSE2)
+    return multiplyMatricesSse2;
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    return multiplyMatricesNeon;
+    #else
+    return multiplyMatricesScalar;
+    #endif
+}
+
+inline MatrixTransformKernel transformPointsKernel() {
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+    if(cpuFeatures().avx2) return transformPointsAvx2;
+    #endif
+    #if defined(CORRADE_TARGET_SSE2)
+    return transformPointsSse2;
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    return transformPointsNeon;
+    #else
+    return transformPointsScalar;
+    #endif
+}
+
+inline MatrixTransformKernel transformVectorsKernel() {
+    #if defined(CORRADE_TARGET_SSE2)
+    return transformVectorsSse2;
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    return transformVectorsNeon;
+    #else
+    return transformVectorsScalar;
+    #endif
+}
+
+inline MatrixInvertKernel invertMatricesKernel() {
+    #if defined(CORRADE_TARGET_SSE2)
+    return invertMatricesSse2;
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    return invertMatricesNeon;
+    #else
+    return invertMatricesScalar;
+    #endif
+}
+
+}}}
+
+#endif
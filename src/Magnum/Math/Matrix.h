@@ -35,6 +35,7 @@ namespace Magnum { namespace Math {
 
 namespace Implementation {
     template<std::size_t, class> struct MatrixDeterminant;
+    template<std::size_t, class> struct MatrixInverted;
 
     template<std::size_t size, std::size_t col, std::size_t otherSize, class T, std::size_t ...row> constexpr Vector<size, T> valueOrIdentityVector(Sequence<row...>, const RectangularMatrix<otherSize, otherSize, T>& other) {
         return {(col < otherSize && row < otherSize ? other[col][row] :
@@ -255,7 +256,11 @@ template<std::size_t size, class T> class Matrix: public RectangularMatrix<size,
          * using a @ref comatrix(): @f[
          *      \boldsymbol{A}^{-1} = \frac{1}{\det \boldsymbol{A}} adj(\boldsymbol{A}) = \frac{1}{\det \boldsymbol{A}} \boldsymbol{C}^T
          * @f]
-         * See @ref invertedOrthogonal(), @ref Matrix3::invertedRigid() and
+         * For 3x3 and 4x4 matrices the calculation is done in a closed form,
+         * with the adjugate matrix assembled from cross products of the
+         * columns or from shared 2x2 subdeterminants, respectively, and the
+         * determinant calculated from the already computed cofactors. See
+         * @ref invertedOrthogonal(), @ref Matrix3::invertedRigid() and
          * @ref Matrix4::invertedRigid() which are faster alternatives for
          * particular matrix types.
          * @see @ref Algorithms::gaussJordanInverted(),
@@ -300,6 +305,7 @@ template<std::size_t size, class T> class Matrix: public RectangularMatrix<size,
 
     private:
         friend struct Implementation::MatrixDeterminant<size, T>;
+        friend struct Implementation::MatrixInverted<size, T>;
 
         /* Implementation for RectangularMatrix<cols, rows, T>::RectangularMatrix(const RectangularMatrix<cols, rows, U>&) */
         template<std::size_t otherSize, std::size_t ...col> constexpr explicit Matrix(Implementation::Sequence<col...>, const RectangularMatrix<otherSize, otherSize, T>& other) noexcept: RectangularMatrix<size, size, T>{Implementation::valueOrIdentityVector<size, col>(other)...} {}
@@ -452,6 +458,99 @@ template<class T> struct MatrixDeterminant<1, T> {
     }
 };
 
+template<std::size_t size, class T> struct MatrixInverted {
+    Matrix<size, T> operator()(const Matrix<size, T>& m) const {
+        return m.adjugate()/m.determinant();
+    }
+};
+
+/* Floating-point matrices are scaled by the reciprocal of the determinant,
+   integer matrices divide by it to give the same result as the generic
+   variant */
+template<class T, bool = IsIntegral<T>::value> struct MatrixInvertedScale {
+    explicit MatrixInvertedScale(T determinant): invDeterminant{T(1)/determinant} {}
+    T operator()(T value) const { return value*invDeterminant; }
+    T invDeterminant;
+};
+template<class T> struct MatrixInvertedScale<T, true> {
+    explicit MatrixInvertedScale(T determinant): determinant{determinant} {}
+    T operator()(T value) const { return value/determinant; }
+    T determinant;
+};
+
+/* Rows of the inverse are cross products of the columns, the determinant
+   is then a dot product of the first of them with the first column. Compared
+   to the generic variant this avoids calculating the cofactors of the first
+   column twice. */
+template<class T> struct MatrixInverted<3, T> {
+    Matrix<3, T> operator()(const Matrix<3, T>& m) const {
+        /* Using ._data[] instead of [] to avoid function call indirection
+           on debug builds (saves a lot, yet doesn't obfuscate too much) */
+        const T* const a = m._data[0]._data;
+        const T* const b = m._data[1]._data;
+        const T* const c = m._data[2]._data;
+        const T r00 = b[1]*c[2] - b[2]*c[1];
+        const T r01 = b[2]*c[0] - b[0]*c[2];
+        const T r02 = b[0]*c[1] - b[1]*c[0];
+        const MatrixInvertedScale<T> scale{a[0]*r00 + a[1]*r01 + a[2]*r02};
+
+        return {
+            Vector<3, T>{scale(r00),
+                         scale(c[1]*a[2] - c[2]*a[1]),
+                         scale(a[1]*b[2] - a[2]*b[1])},
+            Vector<3, T>{scale(r01),
+                         scale(c[2]*a[0] - c[0]*a[2]),
+                         scale(a[2]*b[0] - a[0]*b[2])},
+            Vector<3, T>{scale(r02),
+                         scale(c[0]*a[1] - c[1]*a[0]),
+                         scale(a[0]*b[1] - a[1]*b[0])}};
+    }
+};
+
+/* Each 2x2 subdeterminant of the first two and last two columns is used by
+   four cofactors, calculating them upfront needs considerably fewer
+   multiplications than recursing into 3x3 determinants. Same as
+   invertMatrix() in Implementation/transformBatchKernels.hpp. */
+template<class T> struct MatrixInverted<4, T> {
+    Matrix<4, T> operator()(const Matrix<4, T>& m) const {
+        /* Using ._data[] instead of [] to avoid function call indirection
+           on debug builds (saves a lot, yet doesn't obfuscate too much) */
+        #define _m(col, row) m._data[col]._data[row]
+        const T s0 = _m(0, 0)*_m(1, 1) - _m(1, 0)*_m(0, 1);
+        const T s1 = _m(0, 0)*_m(1, 2) - _m(1, 0)*_m(0, 2);
+        const T s2 = _m(0, 0)*_m(1, 3) - _m(1, 0)*_m(0, 3);
+        const T s3 = _m(0, 1)*_m(1, 2) - _m(1, 1)*_m(0, 2);
+        const T s4 = _m(0, 1)*_m(1, 3) - _m(1, 1)*_m(0, 3);
+        const T s5 = _m(0, 2)*_m(1, 3) - _m(1, 2)*_m(0, 3);
+        const T c5 = _m(2, 2)*_m(3, 3) - _m(3, 2)*_m(2, 3);
+        const T c4 = _m(2, 1)*_m(3, 3) - _m(3, 1)*_m(2, 3);
+        const T c3 = _m(2, 1)*_m(3, 2) - _m(3, 1)*_m(2, 2);
+        const T c2 = _m(2, 0)*_m(3, 3) - _m(3, 0)*_m(2, 3);
+        const T c1 = _m(2, 0)*_m(3, 2) - _m(3, 0)*_m(2, 2);
+        const T c0 = _m(2, 0)*_m(3, 1) - _m(3, 0)*_m(2, 1);
+        const MatrixInvertedScale<T> scale{s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0};
+
+        return {
+            Vector<4, T>{scale(_m(1, 1)*c5 - _m(1, 2)*c4 + _m(1, 3)*c3),
+                         scale(_m(0, 2)*c4 - _m(0, 1)*c5 - _m(0, 3)*c3),
+                         scale(_m(3, 1)*s5 - _m(3, 2)*s4 + _m(3, 3)*s3),
+                         scale(_m(2, 2)*s4 - _m(2, 1)*s5 - _m(2, 3)*s3)},
+            Vector<4, T>{scale(_m(1, 2)*c2 - _m(1, 0)*c5 - _m(1, 3)*c1),
+                         scale(_m(0, 0)*c5 - _m(0, 2)*c2 + _m(0, 3)*c1),
+                         scale(_m(3, 2)*s2 - _m(3, 0)*s5 - _m(3, 3)*s1),
+                         scale(_m(2, 0)*s5 - _m(2, 2)*s2 + _m(2, 3)*s1)},
+            Vector<4, T>{scale(_m(1, 0)*c4 - _m(1, 1)*c2 + _m(1, 3)*c0),
+                         scale(_m(0, 1)*c2 - _m(0, 0)*c4 - _m(0, 3)*c0),
+                         scale(_m(3, 0)*s4 - _m(3, 1)*s2 + _m(3, 3)*s0),
+                         scale(_m(2, 1)*s2 - _m(2, 0)*s4 - _m(2, 3)*s0)},
+            Vector<4, T>{scale(_m(1, 1)*c1 - _m(1, 0)*c3 - _m(1, 2)*c0),
+                         scale(_m(0, 0)*c3 - _m(0, 1)*c1 + _m(0, 2)*c0),
+                         scale(_m(3, 1)*s1 - _m(3, 0)*s3 - _m(3, 2)*s0),
+                         scale(_m(2, 0)*s3 - _m(2, 1)*s1 + _m(2, 2)*s0)}};
+        #undef _m
+    }
+};
+
 template<std::size_t size, class T> struct StrictWeakOrdering<Matrix<size, T>>: StrictWeakOrdering<RectangularMatrix<size, size, T>> {};
 
 }
@@ -518,7 +617,7 @@ template<std::size_t size, class T> Matrix<size, T> Matrix<size, T>::adjugate()
 }
 
 template<std::size_t size, class T> Matrix<size, T> Matrix<size, T>::inverted() const {
-    return adjugate()/determinant();
+    return Implementation::MatrixInverted<size, T>{}(*this);
 }
 
 }}
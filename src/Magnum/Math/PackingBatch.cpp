@@ -30,6 +30,8 @@
 
 #include "Magnum/Math/Packing.h"
 #include "Magnum/Math/Implementation/halfTables.hpp"
+#include "Magnum/Math/Implementation/packingBatchKernels.hpp"
+#include "Magnum/Math/Implementation/stridedConversion.hpp"
 
 namespace Magnum { namespace Math {
 
@@ -41,25 +43,8 @@ template<class T> inline void unpackUnsignedIntoImplementation(const Corrade::Co
     CORRADE_ASSERT(src.template isContiguous<1>() && dst.isContiguous<1>(),
         "Math::unpackInto(): second view dimension is not contiguous", );
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
-
-    /* Caching values to avoid inline function calls in ebug builds */
-    constexpr Float bitMax = Implementation::bitMax<T>();
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
-        Float* dstPtrI = reinterpret_cast<Float*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j)
-            *dstPtrI++ = *srcPtrI++/bitMax;
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    static const Implementation::PackingBatchKernel<T, Float> kernel = Implementation::unpackKernel<T>();
+    Implementation::convertInto(src, dst, kernel);
 }
 
 }
@@ -80,28 +65,9 @@ template<class T> inline void unpackSignedIntoImplementation(const Corrade::Cont
     CORRADE_ASSERT(src.template isContiguous<1>() && dst.isContiguous<1>(),
         "Math::unpackInto(): second view dimension is not contiguous", );
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
-
-    /* Caching values to avoid inline function calls in debug builds */
-    constexpr Float bitMax = Implementation::bitMax<T>();
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
-        Float* dstPtrI = reinterpret_cast<Float*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j) {
-            const Float value = *srcPtrI++/bitMax;
-            /* Avoiding a max() call in Debug */
-            *dstPtrI++ = value < -1.0f ? -1.0f : value;
-        }
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    /* The kernel clamps the result to -1 */
+    static const Implementation::PackingBatchKernel<T, Float> kernel = Implementation::unpackKernel<T>();
+    Implementation::convertInto(src, dst, kernel);
 }
 
 }
@@ -122,26 +88,8 @@ template<class T> inline void packIntoImplementation(const Corrade::Containers::
     CORRADE_ASSERT(src.isContiguous<1>() && dst.template isContiguous<1>(),
         "Math::packInto(): second view dimension is not contiguous", );
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
-
-    /* Caching values to avoid inline function calls in debug builds */
-    constexpr Float bitMax = Implementation::bitMax<T>();
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const Float* srcPtrI = reinterpret_cast<const Float*>(srcPtr);
-        T* dstPtrI = reinterpret_cast<T*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j)
-            /** @todo provide a version that doesn't do rounding */
-            *dstPtrI++ = std::round(*srcPtrI++*bitMax);
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    static const Implementation::PackingBatchKernel<Float, T> kernel = Implementation::packKernel<T>();
+    Implementation::convertInto(src, dst, kernel);
 }
 
 }
@@ -170,24 +118,8 @@ template<class T, class U> inline void castIntoImplementation(const Corrade::Con
     CORRADE_ASSERT(src.template isContiguous<1>() && dst.template isContiguous<1>(),
         "Math::castInto(): second view dimension is not contiguous", );
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
-
-    /* Caching values to avoid inline function calls in debug buílds */
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
-        U* dstPtrI = reinterpret_cast<U*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j)
-            *dstPtrI++ = U(*srcPtrI++);
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    static const Implementation::PackingBatchKernel<T, U> kernel = Implementation::castKernel<T, U>();
+    Implementation::convertInto(src, dst, kernel);
 }
 
 }
@@ -284,23 +216,8 @@ void unpackHalfInto(const Corrade::Containers::StridedArrayView2D<const Unsigned
     CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
         "Math::unpackHalfInto(): second view dimension is not contiguous", );
 
-    /* Caching values to avoid inline function calls in debug builds */
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const UnsignedShort* srcPtrI = reinterpret_cast<const UnsignedShort*>(srcPtr);
-        UnsignedInt* dstPtrI = reinterpret_cast<UnsignedInt*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j) {
-            const UnsignedShort h = *srcPtrI++;
-            *dstPtrI++ = HalfMantissaTable[HalfOffsetTable[h >> 10] + (h & 0x3ff)] + HalfExponentTable[h >> 10];
-        }
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    static const Implementation::PackingBatchKernel<UnsignedShort, Float> kernel = Implementation::unpackHalfKernel();
+    Implementation::convertInto(src, dst, kernel);
 }
 
 void packHalfInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst) {
@@ -309,23 +226,8 @@ void packHalfInto(const Corrade::Containers::StridedArrayView2D<const Float>& sr
     CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
         "Math::packHalfInto(): second view dimension is not contiguous", );
 
-    /* Caching values to avoid inline function calls in debug builds */
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const UnsignedInt* srcPtrI = reinterpret_cast<const UnsignedInt*>(srcPtr);
-        UnsignedShort* dstPtrI = reinterpret_cast<UnsignedShort*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j) {
-            const UnsignedInt f = *srcPtrI++;
-            *dstPtrI++ = HalfBaseTable[(f >> 23) & 0x1ff] + ((f & 0x007fffff) >> HalfShiftTable[(f >> 23) & 0x1ff]);
-        }
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    static const Implementation::PackingBatchKernel<Float, UnsignedShort> kernel = Implementation::packHalfKernel();
+    Implementation::convertInto(src, dst, kernel);
 }
 
 }}
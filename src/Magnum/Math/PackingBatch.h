@@ -135,10 +135,15 @@ MAGNUM_EXPORT void packInto(const Corrade::Containers::StridedArrayView2D<const
 
 See [Wikipedia](https://en.wikipedia.org/wiki/Half-precision_floating-point_format)
 for more information about half floats. Unlike @ref packHalf() this function is
-a faster table-based implementation at the expense of using more memory, thus
-more suitable for batch conversions of large data amounts. Expects that @p src
-and @p dst have the same size and that the second dimension in both is
-contiguous.
+a faster batch implementation, more suitable for conversions of large data
+amounts. Expects that @p src and @p dst have the same size and that the second
+dimension in both is contiguous.
+
+Values are truncated, values outside of the half-float range become an
+infinity and NaNs keep the top 10 bits of their payload. On x86 the conversion
+uses F16C instructions if the CPU supports them and a SSE2 implementation
+otherwise, elsewhere a table-based implementation is used. All variants give
+bit-identical results.
 
 Algorithm used: *Jeroen van der Zijp -- Fast Half Float Conversions, 2008,
 ftp://ftp.fox-toolkit.org/pub/fasthalffloatconversion.pdf*
@@ -154,10 +159,13 @@ MAGNUM_EXPORT void packHalfInto(const Corrade::Containers::StridedArrayView2D<co
 
 See [Wikipedia](https://en.wikipedia.org/wiki/Half-precision_floating-point_format)
 for more information about half floats. Unlike @ref unpackHalf() this function
-is a faster table-based implementation at the expense of using more memory,
-thus more suitable for batch conversions of large data amounts. Expects that
-@p src and @p dst have the same size and that the second dimension in both is
-contiguous.
+is a faster batch implementation, more suitable for conversions of large data
+amounts. Expects that @p src and @p dst have the same size and that the second
+dimension in both is contiguous.
+
+On x86 the conversion uses F16C instructions if the CPU supports them and a
+SSE2 implementation otherwise, elsewhere a table-based implementation is used.
+All variants give bit-identical results, including NaN payloads.
 
 Algorithm used: *Jeroen van der Zijp -- Fast Half Float Conversions, 2008,
 ftp://ftp.fox-toolkit.org/pub/fasthalffloatconversion.pdf*
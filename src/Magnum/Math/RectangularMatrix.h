@@ -450,10 +450,11 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
         template<std::size_t ...sequence> constexpr explicit RectangularMatrix(Implementation::Sequence<sequence...>, T value) noexcept: _data{Vector<rows, T>((static_cast<void>(sequence), value))...} {}
 
     private:
-        /* These two needed to access _data to speed up debug builds,
+        /* These three needed to access _data to speed up debug builds,
            Matrix::ij() needs access to different Matrix sizes */
         template<std::size_t, class> friend class Matrix;
         template<std::size_t, class> friend struct Implementation::MatrixDeterminant;
+        template<std::size_t, class> friend struct Implementation::MatrixInverted;
 
         /* Implementation for RectangularMatrix<cols, rows, T>::RectangularMatrix(const RectangularMatrix<cols, rows, U>&) */
         template<class U, std::size_t ...sequence> constexpr explicit RectangularMatrix(Implementation::Sequence<sequence...>, const RectangularMatrix<cols, rows, U>& matrix) noexcept: _data{Vector<rows, T>(matrix[sequence])...} {}
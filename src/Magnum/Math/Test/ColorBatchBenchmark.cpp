@@ -0,0 +1,161 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/ColorBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct ColorBatchBenchmark: Corrade::TestSuite::Tester {
+    explicit ColorBatchBenchmark();
+
+    void fromSrgbScalar();
+    void fromSrgbBatch();
+    void toSrgbScalar();
+    void toSrgbBatch();
+};
+
+enum: std::size_t {
+    PixelCount = 512*512
+};
+
+/* Each benchmark is run on a RGB image and on RGB channels of a RGBA image,
+   the alpha channel being left untouched */
+const struct {
+    const char* name;
+    std::size_t pixelStride; /* in elements */
+} Data[]{
+    {"RGB", 3},
+    {"RGBA", 4}
+};
+
+ColorBatchBenchmark::ColorBatchBenchmark() {
+    addInstancedBenchmarks({&ColorBatchBenchmark::fromSrgbScalar,
+                            &ColorBatchBenchmark::fromSrgbBatch,
+                            &ColorBatchBenchmark::toSrgbScalar,
+                            &ColorBatchBenchmark::toSrgbBatch}, 10,
+        Corrade::Containers::arraySize(Data));
+}
+
+typedef Math::Vector3<UnsignedByte> Vector3ub;
+typedef Math::Color3<Float> Color3;
+
+template<class T> Corrade::Containers::StridedArrayView2D<T> view(Corrade::Containers::Array<T>& array, const std::size_t pixelStride) {
+    return {array, array.data(), {PixelCount, 3}, {std::ptrdiff_t(pixelStride*sizeof(T)), std::ptrdiff_t(sizeof(T))}};
+}
+
+Corrade::Containers::Array<UnsignedByte> srgbInput(const std::size_t pixelStride) {
+    Corrade::Containers::Array<UnsignedByte> out{Corrade::Containers::NoInit, PixelCount*pixelStride};
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = UnsignedByte(i*7919 + 13);
+    return out;
+}
+
+Corrade::Containers::Array<Float> linearInput(const std::size_t pixelStride) {
+    Corrade::Containers::Array<Float> out{Corrade::Containers::NoInit, PixelCount*pixelStride};
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = (i % 1001)/1000.0f;
+    return out;
+}
+
+void ColorBatchBenchmark::fromSrgbScalar() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Corrade::Containers::Array<UnsignedByte> src = srgbInput(data.pixelStride);
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::ValueInit, PixelCount*data.pixelStride};
+    const Corrade::Containers::StridedArrayView2D<const UnsignedByte> srcView = view(src, data.pixelStride);
+    const Corrade::Containers::StridedArrayView2D<Float> dstView = view(dst, data.pixelStride);
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != PixelCount; ++i) {
+            const Color3 color = Color3::fromSrgb(Vector3ub{srcView[i][0], srcView[i][1], srcView[i][2]});
+            for(std::size_t j = 0; j != 3; ++j)
+                dstView[i][j] = color[j];
+        }
+    }
+
+    CORRADE_COMPARE(dstView[1][2], Color3::fromSrgb(Vector3ub{srcView[1][2]}).b());
+}
+
+void ColorBatchBenchmark::fromSrgbBatch() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Corrade::Containers::Array<UnsignedByte> src = srgbInput(data.pixelStride);
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::ValueInit, PixelCount*data.pixelStride};
+    const Corrade::Containers::StridedArrayView2D<const UnsignedByte> srcView = view(src, data.pixelStride);
+    const Corrade::Containers::StridedArrayView2D<Float> dstView = view(dst, data.pixelStride);
+
+    CORRADE_BENCHMARK(1) {
+        Math::fromSrgbInto(srcView, dstView);
+    }
+
+    CORRADE_COMPARE(dstView[1][2], Color3::fromSrgb(Vector3ub{srcView[1][2]}).b());
+}
+
+void ColorBatchBenchmark::toSrgbScalar() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Corrade::Containers::Array<Float> src = linearInput(data.pixelStride);
+    Corrade::Containers::Array<UnsignedByte> dst{Corrade::Containers::ValueInit, PixelCount*data.pixelStride};
+    const Corrade::Containers::StridedArrayView2D<const Float> srcView = view(src, data.pixelStride);
+    const Corrade::Containers::StridedArrayView2D<UnsignedByte> dstView = view(dst, data.pixelStride);
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != PixelCount; ++i) {
+            const Vector3ub color = Color3{srcView[i][0], srcView[i][1], srcView[i][2]}.toSrgb<UnsignedByte>();
+            for(std::size_t j = 0; j != 3; ++j)
+                dstView[i][j] = color[j];
+        }
+    }
+
+    CORRADE_COMPARE(dstView[1][2], Color3{srcView[1][2]}.toSrgb<UnsignedByte>().b());
+}
+
+void ColorBatchBenchmark::toSrgbBatch() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Corrade::Containers::Array<Float> src = linearInput(data.pixelStride);
+    Corrade::Containers::Array<UnsignedByte> dst{Corrade::Containers::ValueInit, PixelCount*data.pixelStride};
+    const Corrade::Containers::StridedArrayView2D<const Float> srcView = view(src, data.pixelStride);
+    const Corrade::Containers::StridedArrayView2D<UnsignedByte> dstView = view(dst, data.pixelStride);
+
+    CORRADE_BENCHMARK(1) {
+        Math::toSrgbInto(srcView, dstView);
+    }
+
+    CORRADE_COMPARE(dstView[1][2], Color3{srcView[1][2]}.toSrgb<UnsignedByte>().b());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::ColorBatchBenchmark)
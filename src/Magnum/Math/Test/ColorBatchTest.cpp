@@ -0,0 +1,314 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/ColorBatch.h"
+#include "Magnum/Math/Packing.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct ColorBatchTest: Corrade::TestSuite::Tester {
+    explicit ColorBatchTest();
+
+    void fromSrgb();
+    void fromSrgbHalf();
+    void toSrgb();
+    void toSrgbOutOfRange();
+    void toSrgbHalf();
+    void roundTrip();
+
+    void layoutFromSrgb();
+    void layoutToSrgb();
+
+    void assertions();
+};
+
+/* Exercising the contiguous, row-by-row and gathered code paths, with sizes
+   not divisible by the SIMD width */
+const struct {
+    const char* name;
+    std::size_t rows, columns, srcPadding, dstPadding;
+} LayoutData[]{
+    {"contiguous", 97, 3, 0, 0},
+    {"long rows", 13, 37, 3, 0},
+    {"RGB out of RGBA", 531, 3, 1, 1},
+    {"short rows, padded destination", 531, 2, 0, 2},
+    {"single column", 301, 1, 3, 1}
+};
+
+ColorBatchTest::ColorBatchTest() {
+    addTests({&ColorBatchTest::fromSrgb,
+              &ColorBatchTest::fromSrgbHalf,
+              &ColorBatchTest::toSrgb,
+              &ColorBatchTest::toSrgbOutOfRange,
+              &ColorBatchTest::toSrgbHalf,
+              &ColorBatchTest::roundTrip});
+
+    addInstancedTests({&ColorBatchTest::layoutFromSrgb,
+                       &ColorBatchTest::layoutToSrgb},
+        Corrade::Containers::arraySize(LayoutData));
+
+    addTests({&ColorBatchTest::assertions});
+}
+
+typedef Math::Constants<Float> Constants;
+typedef Math::Vector2<Float> Vector2;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector3<UnsignedByte> Vector3ub;
+typedef Math::Vector3<UnsignedShort> Vector3us;
+typedef Math::Color3<Float> Color3;
+
+UnsignedInt bits(const Float value) {
+    UnsignedInt out;
+    std::memcpy(&out, &value, sizeof(Float));
+    return out;
+}
+
+/* Views of N values, treated as N rows of one component */
+template<class T> Corrade::Containers::StridedArrayView2D<T> view(Corrade::Containers::ArrayView<T> data) {
+    return {data, data.data(), {data.size(), 1}, {std::ptrdiff_t(sizeof(T)), std::ptrdiff_t(sizeof(T))}};
+}
+
+void ColorBatchTest::fromSrgb() {
+    UnsignedByte src[256];
+    for(std::size_t i = 0; i != 256; ++i) src[i] = i;
+
+    Float dst[256];
+    fromSrgbInto(view<const UnsignedByte>(src), view<Float>(dst));
+
+    /* Should be bit-exact with the scalar API for all values */
+    for(std::size_t i = 0; i != 256; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(bits(dst[i]), bits(Color3::fromSrgb(Vector3ub{src[i]}).r()));
+    }
+}
+
+void ColorBatchTest::fromSrgbHalf() {
+    UnsignedByte src[256];
+    for(std::size_t i = 0; i != 256; ++i) src[i] = i;
+
+    UnsignedShort dst[256];
+    fromSrgbHalfInto(view<const UnsignedByte>(src), view<UnsignedShort>(dst));
+
+    for(std::size_t i = 0; i != 256; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(dst[i], packHalf(Color3::fromSrgb(Vector3ub{src[i]}).r()));
+    }
+}
+
+void ColorBatchTest::toSrgb() {
+    /* Sweep through the whole range, with a step that isn't a power of two
+       in order to hit values around all 255 rounding points */
+    Corrade::Containers::Array<Float> src{Corrade::Containers::NoInit, 100003};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = Float(i)/(src.size() - 1);
+    /* Smallest values that get a nonzero output are extremely close to zero,
+       include also denormals */
+    src[1] = 1.0e-40f;
+    src[2] = 1.0e-6f;
+
+    Corrade::Containers::Array<UnsignedByte> dst{Corrade::Containers::NoInit, src.size()};
+    toSrgbInto(view<const Float>(src), view<UnsignedByte>(dst));
+
+    for(std::size_t i = 0; i != src.size(); ++i) {
+        CORRADE_ITERATION(src[i]);
+        CORRADE_COMPARE(dst[i], Color3{src[i]}.toSrgb<UnsignedByte>().r());
+    }
+}
+
+void ColorBatchTest::toSrgbOutOfRange() {
+    const Float src[]{
+        -0.0f,
+        -1.0f,
+        1.0f,
+        1.0001f,
+        1000.0f,
+        Constants::inf(),
+        -Constants::inf(),
+        Constants::nan()
+    };
+    UnsignedByte dst[Corrade::Containers::arraySize(src)];
+    toSrgbInto(view<const Float>(src), view<UnsignedByte>(dst));
+
+    /* Clamped, NaN is treated as zero */
+    CORRADE_COMPARE(dst[0], 0);
+    CORRADE_COMPARE(dst[1], 0);
+    CORRADE_COMPARE(dst[2], 255);
+    CORRADE_COMPARE(dst[3], 255);
+    CORRADE_COMPARE(dst[4], 255);
+    CORRADE_COMPARE(dst[5], 255);
+    CORRADE_COMPARE(dst[6], 0);
+    CORRADE_COMPARE(dst[7], 0);
+}
+
+void ColorBatchTest::toSrgbHalf() {
+    /* Test all possible half-float values */
+    Corrade::Containers::Array<UnsignedShort> src{Corrade::Containers::NoInit, 65536};
+    for(std::size_t i = 0; i != src.size(); ++i) src[i] = i;
+
+    Corrade::Containers::Array<UnsignedByte> dst{Corrade::Containers::NoInit, src.size()};
+    toSrgbHalfInto(view<const UnsignedShort>(src), view<UnsignedByte>(dst));
+
+    for(std::size_t i = 0; i != src.size(); ++i) {
+        CORRADE_ITERATION(i);
+        const Float value = unpackHalf(src[i]);
+        UnsignedByte expected;
+        if(value != value || value <= 0.0f) expected = 0;
+        else if(value >= 1.0f) expected = 255;
+        else expected = Color3{value}.toSrgb<UnsignedByte>().r();
+        CORRADE_COMPARE(dst[i], expected);
+    }
+}
+
+void ColorBatchTest::roundTrip() {
+    UnsignedByte src[256];
+    for(std::size_t i = 0; i != 256; ++i) src[i] = i;
+
+    Float linear[256];
+    UnsignedShort linearHalf[256];
+    UnsignedByte dst[256];
+    UnsignedByte dstHalf[256];
+    fromSrgbInto(view<const UnsignedByte>(src), view<Float>(linear));
+    fromSrgbHalfInto(view<const UnsignedByte>(src), view<UnsignedShort>(linearHalf));
+    toSrgbInto(view<const Float>(linear), view<UnsignedByte>(dst));
+    toSrgbHalfInto(view<const UnsignedShort>(linearHalf), view<UnsignedByte>(dstHalf));
+
+    for(std::size_t i = 0; i != 256; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(dst[i], src[i]);
+        CORRADE_COMPARE(dstHalf[i], src[i]);
+    }
+}
+
+void ColorBatchTest::layoutFromSrgb() {
+    auto&& data = LayoutData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::size_t srcRowSize = data.columns + data.srcPadding;
+    const std::size_t dstRowSize = data.columns + data.dstPadding;
+    Corrade::Containers::Array<UnsignedByte> src{Corrade::Containers::NoInit, data.rows*srcRowSize};
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::ValueInit, data.rows*dstRowSize};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = UnsignedByte(UnsignedInt(i)*2654435761u >> 24);
+
+    fromSrgbInto(
+        Corrade::Containers::StridedArrayView2D<const UnsignedByte>{src, src.data(), {data.rows, data.columns}, {std::ptrdiff_t(srcRowSize), 1}},
+        Corrade::Containers::StridedArrayView2D<Float>{dst, dst.data(), {data.rows, data.columns}, {std::ptrdiff_t(dstRowSize*sizeof(Float)), std::ptrdiff_t(sizeof(Float))}});
+
+    /* Should give the same result as the scalar APIs, padding untouched */
+    for(std::size_t i = 0; i != data.rows; ++i) {
+        for(std::size_t j = 0; j != data.columns; ++j)
+            CORRADE_COMPARE(dst[i*dstRowSize + j], Color3::fromSrgb(Vector3ub{src[i*srcRowSize + j]}).r());
+        for(std::size_t j = data.columns; j != dstRowSize; ++j)
+            CORRADE_COMPARE(dst[i*dstRowSize + j], 0.0f);
+    }
+}
+
+void ColorBatchTest::layoutToSrgb() {
+    auto&& data = LayoutData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::size_t srcRowSize = data.columns + data.srcPadding;
+    const std::size_t dstRowSize = data.columns + data.dstPadding;
+    Corrade::Containers::Array<Float> src{Corrade::Containers::NoInit, data.rows*srcRowSize};
+    /* Padding filled with a value that the conversion never produces for
+       the inputs below, to verify it's not touched */
+    Corrade::Containers::Array<UnsignedByte> dst{Corrade::Containers::DirectInit, data.rows*dstRowSize, UnsignedByte(0xff)};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = (i % 1001)/1001.0f;
+
+    toSrgbInto(
+        Corrade::Containers::StridedArrayView2D<const Float>{src, src.data(), {data.rows, data.columns}, {std::ptrdiff_t(srcRowSize*sizeof(Float)), std::ptrdiff_t(sizeof(Float))}},
+        Corrade::Containers::StridedArrayView2D<UnsignedByte>{dst, dst.data(), {data.rows, data.columns}, {std::ptrdiff_t(dstRowSize), 1}});
+
+    for(std::size_t i = 0; i != data.rows; ++i) {
+        for(std::size_t j = 0; j != data.columns; ++j)
+            CORRADE_COMPARE(dst[i*dstRowSize + j], Color3{src[i*srcRowSize + j]}.toSrgb<UnsignedByte>().r());
+        for(std::size_t j = data.columns; j != dstRowSize; ++j)
+            CORRADE_COMPARE(dst[i*dstRowSize + j], 0xff);
+    }
+}
+
+void ColorBatchTest::assertions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Vector3ub srgb[2]{};
+    Vector3 linearWrongCount[1]{};
+    Vector2 linearWrongVectorSize[2]{};
+    Vector3 linearNonContiguous[2]{};
+    Vector3us linearHalfWrongCount[1]{};
+    Vector3us linearHalfNonContiguous[2]{};
+
+    auto src = Corrade::Containers::arrayCast<2, UnsignedByte>(
+        Corrade::Containers::arrayView(srgb));
+    auto linearWrongCountView = Corrade::Containers::arrayCast<2, Float>(
+        Corrade::Containers::arrayView(linearWrongCount));
+    auto linearWrongVectorSizeView = Corrade::Containers::arrayCast<2, Float>(
+        Corrade::Containers::arrayView(linearWrongVectorSize));
+    auto linearNonContiguousView = Corrade::Containers::arrayCast<2, Float>(
+        Corrade::Containers::arrayView(linearNonContiguous)).every({1, 2});
+    auto srcNonContiguous = src.every({1, 2});
+    auto linearHalfWrongCountView = Corrade::Containers::arrayCast<2, UnsignedShort>(
+        Corrade::Containers::arrayView(linearHalfWrongCount));
+    auto linearHalfNonContiguousView = Corrade::Containers::arrayCast<2, UnsignedShort>(
+        Corrade::Containers::arrayView(linearHalfNonContiguous)).every({1, 2});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    fromSrgbInto(src, linearWrongCountView);
+    fromSrgbInto(src, linearWrongVectorSizeView);
+    fromSrgbInto(srcNonContiguous, linearNonContiguousView);
+    fromSrgbHalfInto(src, linearHalfWrongCountView);
+    fromSrgbHalfInto(srcNonContiguous, linearHalfNonContiguousView);
+    toSrgbInto(linearWrongCountView, src);
+    toSrgbInto(linearWrongVectorSizeView, src);
+    toSrgbInto(linearNonContiguousView, srcNonContiguous);
+    toSrgbHalfInto(linearHalfWrongCountView, src);
+    toSrgbHalfInto(linearHalfNonContiguousView, srcNonContiguous);
+    CORRADE_COMPARE(out.str(),
+        "Math::fromSrgbInto(): wrong destination size, got {1, 3} but expected {2, 3}\n"
+        "Math::fromSrgbInto(): wrong destination size, got {2, 2} but expected {2, 3}\n"
+        "Math::fromSrgbInto(): second view dimension is not contiguous\n"
+        "Math::fromSrgbHalfInto(): wrong destination size, got {1, 3} but expected {2, 3}\n"
+        "Math::fromSrgbHalfInto(): second view dimension is not contiguous\n"
+        "Math::toSrgbInto(): wrong destination size, got {2, 3} but expected {1, 3}\n"
+        "Math::toSrgbInto(): wrong destination size, got {2, 3} but expected {2, 2}\n"
+        "Math::toSrgbInto(): second view dimension is not contiguous\n"
+        "Math::toSrgbHalfInto(): wrong destination size, got {2, 3} but expected {1, 3}\n"
+        "Math::toSrgbHalfInto(): second view dimension is not contiguous\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::ColorBatchTest)
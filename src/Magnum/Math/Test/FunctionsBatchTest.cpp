@@ -28,7 +28,7 @@
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/FunctionsBatch.h"
-#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Vector4.h"
 
 namespace Magnum { namespace Math { namespace Test { namespace {
 
@@ -42,8 +42,11 @@ struct FunctionsBatchTest: Corrade::TestSuite::Tester {
     void max();
     void minmax();
 
+    template<class T> void minmaxLarge();
+
     void nanIgnoring();
     void nanIgnoringVector();
+    void nanIgnoringLarge();
 };
 
 using namespace Literals;
@@ -52,6 +55,21 @@ typedef Math::Constants<Float> Constants;
 typedef Math::Vector2<Float> Vector2;
 typedef Math::Vector3<Int> Vector3i;
 typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
+typedef Math::Vector4<UnsignedInt> Vector4ui;
+
+/* Sizes and strides exercising both the SIMD code with a remainder and the
+   scalar code for short ranges */
+const struct {
+    const char* name;
+    std::size_t count;
+    std::size_t stride; /* in items */
+} MinmaxLargeData[]{
+    {"contiguous", 1001, 1},
+    {"strided", 1001, 3},
+    {"contiguous, short", 15, 1},
+    {"strided, short", 15, 2}
+};
 
 FunctionsBatchTest::FunctionsBatchTest() {
     addTests({&FunctionsBatchTest::isInf,
@@ -59,10 +77,23 @@ FunctionsBatchTest::FunctionsBatchTest() {
 
               &FunctionsBatchTest::min,
               &FunctionsBatchTest::max,
-              &FunctionsBatchTest::minmax,
-
-              &FunctionsBatchTest::nanIgnoring,
-              &FunctionsBatchTest::nanIgnoringVector});
+              &FunctionsBatchTest::minmax});
+
+    addInstancedTests<FunctionsBatchTest>({
+        &FunctionsBatchTest::minmaxLarge<Float>,
+        &FunctionsBatchTest::minmaxLarge<Vector2>,
+        &FunctionsBatchTest::minmaxLarge<Vector3>,
+        &FunctionsBatchTest::minmaxLarge<Vector4>,
+        &FunctionsBatchTest::minmaxLarge<Int>,
+        &FunctionsBatchTest::minmaxLarge<Vector3i>,
+        &FunctionsBatchTest::minmaxLarge<UnsignedInt>,
+        &FunctionsBatchTest::minmaxLarge<Vector4ui>,
+        &FunctionsBatchTest::minmaxLarge<Double>},
+        Corrade::Containers::arraySize(MinmaxLargeData));
+
+    addTests({&FunctionsBatchTest::nanIgnoring,
+              &FunctionsBatchTest::nanIgnoringVector,
+              &FunctionsBatchTest::nanIgnoringLarge});
 }
 
 void FunctionsBatchTest::isInf() {
@@ -201,6 +232,59 @@ void FunctionsBatchTest::minmax() {
     CORRADE_COMPARE(Math::minmax({1.0_radf, 2.0_radf, 3.0_radf}), std::make_pair(1.0_radf, 3.0_radf));
 }
 
+template<class> struct TypeName;
+template<> struct TypeName<Float> { static const char* name() { return "Float"; } };
+template<> struct TypeName<Vector2> { static const char* name() { return "Vector2"; } };
+template<> struct TypeName<Vector3> { static const char* name() { return "Vector3"; } };
+template<> struct TypeName<Vector4> { static const char* name() { return "Vector4"; } };
+template<> struct TypeName<Int> { static const char* name() { return "Int"; } };
+template<> struct TypeName<Vector3i> { static const char* name() { return "Vector3i"; } };
+template<> struct TypeName<UnsignedInt> { static const char* name() { return "UnsignedInt"; } };
+template<> struct TypeName<Vector4ui> { static const char* name() { return "Vector4ui"; } };
+template<> struct TypeName<Double> { static const char* name() { return "Double"; } };
+
+template<class T> void FunctionsBatchTest::minmaxLarge() {
+    auto&& data = MinmaxLargeData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeName<T>::name());
+    setTestCaseDescription(data.name);
+
+    typedef UnderlyingTypeOf<T> S;
+    enum: std::size_t { Size = sizeof(T)/sizeof(S) };
+
+    /* Values for unsigned types cross the 2^31 boundary to verify the
+       comparison isn't signed */
+    const S base = std::is_unsigned<S>::value ? S(0x7ffffc00u) : S(-1000);
+
+    /* The minimum and maximum is different for every component to verify
+       the lanes get reduced into correct components. The padding between
+       items has values beyond both and should get ignored. */
+    std::vector<S> scalars(data.count*data.stride*Size);
+    for(std::size_t i = 0; i != scalars.size(); ++i)
+        scalars[i] = i % 2 ? base - S(100) : base + S(9000);
+    S expectedMin[Size], expectedMax[Size];
+    for(std::size_t i = 0; i != data.count; ++i) {
+        for(std::size_t j = 0; j != Size; ++j) {
+            S& value = scalars[(i*data.stride)*Size + j];
+            if(i == data.count/3) {
+                value = expectedMin[j] = base - S(1 + j);
+            } else if(i == data.count*2/3) {
+                value = expectedMax[j] = base + S(7000 + j);
+            } else value = base + S(((i*7 + j*13) % 101)*50);
+        }
+    }
+
+    Corrade::Containers::StridedArrayView1D<const T> view{
+        Corrade::Containers::arrayView(scalars),
+        reinterpret_cast<const T*>(scalars.data()), data.count,
+        std::ptrdiff_t(data.stride*sizeof(T))};
+    const T& min = *reinterpret_cast<const T*>(expectedMin);
+    const T& max = *reinterpret_cast<const T*>(expectedMax);
+
+    CORRADE_COMPARE(Math::min(view), min);
+    CORRADE_COMPARE(Math::max(view), max);
+    CORRADE_COMPARE(Math::minmax(view), std::make_pair(min, max));
+}
+
 void FunctionsBatchTest::nanIgnoring() {
     auto oneNan = {1.0f, Constants::nan(), -3.0f};
     auto firstNan = {Constants::nan(), 1.0f, -3.0f};
@@ -284,6 +368,29 @@ void FunctionsBatchTest::nanIgnoringVector() {
     CORRADE_COMPARE(Math::minmax(allNan).second[1], Constants::nan());
 }
 
+void FunctionsBatchTest::nanIgnoringLarge() {
+    /* Large enough to go through the SIMD code. First component is NaN in
+       the first few items, second in every seventh item and the last is NaN
+       everywhere. */
+    std::vector<Vector3> data(1001);
+    for(std::size_t i = 0; i != data.size(); ++i) data[i] = {
+        i < 50 ? Constants::nan() : Float(i % 101) - 50.0f,
+        i % 7 ? Float(i % 37)*0.5f : Constants::nan(),
+        Constants::nan()
+    };
+
+    CORRADE_COMPARE(Math::min(data).xy(), (Vector2{-50.0f, 0.0f}));
+    CORRADE_COMPARE(Math::min(data)[2], Constants::nan());
+    CORRADE_COMPARE(Math::max(data).xy(), (Vector2{50.0f, 18.0f}));
+    CORRADE_COMPARE(Math::max(data)[2], Constants::nan());
+
+    const std::pair<Vector3, Vector3> minmax = Math::minmax(data);
+    CORRADE_COMPARE(minmax.first.xy(), (Vector2{-50.0f, 0.0f}));
+    CORRADE_COMPARE(minmax.first[2], Constants::nan());
+    CORRADE_COMPARE(minmax.second.xy(), (Vector2{50.0f, 18.0f}));
+    CORRADE_COMPARE(minmax.second[2], Constants::nan());
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::FunctionsBatchTest)
@@ -23,10 +23,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 
-#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Vector3.h"
 
 #ifdef CORRADE_TARGET_SSE2
 #include <xmmintrin.h>
@@ -48,6 +51,21 @@ struct FunctionsBenchmark: Corrade::TestSuite::Tester {
 
     void sinCosSeparate();
     void sinCosCombined();
+
+    template<class T> void minmaxScalar();
+    template<class T> void minmaxBatch();
+};
+
+enum: std::size_t { MinmaxCount = 1000000 };
+
+/* Contiguous data and a position-like attribute interleaved with other data,
+   which is what the mesh bounds calculation usually works with */
+const struct {
+    const char* name;
+    std::size_t stride; /* in items */
+} MinmaxData[]{
+    {"contiguous", 1},
+    {"interleaved", 3}
 };
 
 FunctionsBenchmark::FunctionsBenchmark() {
@@ -66,6 +84,15 @@ FunctionsBenchmark::FunctionsBenchmark() {
 
     addBenchmarks({&FunctionsBenchmark::sinCosSeparate,
                    &FunctionsBenchmark::sinCosCombined}, 100);
+
+    addInstancedBenchmarks({
+        &FunctionsBenchmark::minmaxScalar<Float>,
+        &FunctionsBenchmark::minmaxBatch<Float>,
+        &FunctionsBenchmark::minmaxScalar<Vector3<Float>>,
+        &FunctionsBenchmark::minmaxBatch<Vector3<Float>>,
+        &FunctionsBenchmark::minmaxScalar<Vector3<Int>>,
+        &FunctionsBenchmark::minmaxBatch<Vector3<Int>>}, 10,
+        Corrade::Containers::arraySize(MinmaxData));
 }
 
 typedef Math::Constants<Float> Constants;
@@ -215,6 +242,53 @@ void FunctionsBenchmark::sinCosCombined() {
     CORRADE_COMPARE_AS(a, 10.0f, Corrade::TestSuite::Compare::Greater);
 }
 
+template<class> struct MinmaxTypeName;
+template<> struct MinmaxTypeName<Float> { static const char* name() { return "Float"; } };
+template<> struct MinmaxTypeName<Vector3<Float>> { static const char* name() { return "Vector3"; } };
+template<> struct MinmaxTypeName<Vector3<Int>> { static const char* name() { return "Vector3i"; } };
+
+template<class T> Corrade::Containers::Array<T> minmaxInput(const std::size_t stride) {
+    Corrade::Containers::Array<T> out{Corrade::Containers::NoInit, MinmaxCount*stride};
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = T(UnderlyingTypeOf<T>(Int(i*7919 % 10007) - 5000));
+    return out;
+}
+
+template<class T> void FunctionsBenchmark::minmaxScalar() {
+    auto&& data = MinmaxData[testCaseInstanceId()];
+    setTestCaseTemplateName(MinmaxTypeName<T>::name());
+    setTestCaseDescription(data.name);
+
+    Corrade::Containers::Array<T> input = minmaxInput<T>(data.stride);
+    const Corrade::Containers::StridedArrayView1D<const T> view{input, input.data(), MinmaxCount, std::ptrdiff_t(data.stride*sizeof(T))};
+
+    /* What Math::minmax() did before it got SIMD implementations */
+    std::pair<T, T> out;
+    CORRADE_BENCHMARK(1) {
+        T min{view[0]}, max{view[0]};
+        for(std::size_t i = 1; i != view.size(); ++i)
+            Implementation::minmax(min, max, view[i]);
+        out = {min, max};
+    }
+
+    CORRADE_COMPARE(out, Math::minmax(view));
+}
+
+template<class T> void FunctionsBenchmark::minmaxBatch() {
+    auto&& data = MinmaxData[testCaseInstanceId()];
+    setTestCaseTemplateName(MinmaxTypeName<T>::name());
+    setTestCaseDescription(data.name);
+
+    Corrade::Containers::Array<T> input = minmaxInput<T>(data.stride);
+    const Corrade::Containers::StridedArrayView1D<const T> view{input, input.data(), MinmaxCount, std::ptrdiff_t(data.stride*sizeof(T))};
+
+    std::pair<T, T> out;
+    CORRADE_BENCHMARK(1) {
+        out = Math::minmax(view);
+    }
+
+    CORRADE_COMPARE(out, std::make_pair(T(UnderlyingTypeOf<T>(-5000)), T(UnderlyingTypeOf<T>(5006))));
+}
 
 }}}}
 
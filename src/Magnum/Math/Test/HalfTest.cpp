@@ -26,6 +26,7 @@
 #include <cstring>
 #include <algorithm>
 #include <sstream>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -47,6 +48,8 @@ struct HalfTest: Corrade::TestSuite::Tester {
     void unpack();
     void pack();
     void repack();
+    void unpackBatch();
+    void packBatch();
 
     void unpack1k();
     void unpack1kNaive();
@@ -119,6 +122,9 @@ HalfTest::HalfTest() {
 
     addRepeatedTests({&HalfTest::repack}, 65536);
 
+    addTests({&HalfTest::unpackBatch,
+              &HalfTest::packBatch});
+
     addBenchmarks({
         &HalfTest::unpack1k,
         &HalfTest::unpack1kNaive,
@@ -429,6 +435,69 @@ void HalfTest::repack() {
     }
 }
 
+void HalfTest::unpackBatch() {
+    /* All possible values with a few more to not end at a SIMD boundary.
+       Converting the whole array at once goes through the SIMD code, while
+       unpackTable() converts just a single value and thus uses the tables, so
+       this verifies both are bit-exact, including NaN payloads. */
+    Corrade::Containers::Array<UnsignedShort> src{Corrade::Containers::NoInit, 65536 + 3};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = UnsignedShort(i);
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, src.size()};
+    unpackHalfInto(Corrade::Containers::StridedArrayView2D<UnsignedShort>{src, {1, src.size()}},
+        Corrade::Containers::StridedArrayView2D<Float>{dst, {1, dst.size()}});
+
+    for(std::size_t i = 0; i != src.size(); ++i) {
+        CORRADE_ITERATION(i);
+        const Float expected = unpackTable(src[i]);
+        UnsignedInt expectedBits, actualBits;
+        std::memcpy(&expectedBits, &expected, 4);
+        std::memcpy(&actualBits, dst + i, 4);
+        CORRADE_COMPARE(actualBits, expectedBits);
+    }
+}
+
+void HalfTest::packBatch() {
+    /* Values exactly representable, in between two halves (which get
+       truncated), denormals, underflow, overflow and NaN payloads, with a few
+       more to not end at a SIMD boundary. Converting the whole array at once
+       goes through the SIMD code, while packTable() converts just a single
+       value and thus uses the tables, so this verifies both are
+       bit-exact. */
+    const UnsignedInt bits[]{
+        0x00000000, 0x80000000, 0x3f800000, 0xbf800000, /* +-0, +-1 */
+        0x3f801000, 0x3f801fff, 0x3f802000, 0xbf801000, /* halfway, truncation */
+        0x477fe000, 0x477fefff, 0x477ff000, 0x477fffff, /* around 65504 */
+        0x47800000, 0xc7800000, 0x501502f9, 0x7f7fffff, /* overflow */
+        0x38800000, 0x387fffff, 0x38000000, 0x33800000, /* smallest normal, denormals */
+        0x337fffff, 0x33000000, 0x00000001, 0x807fffff, /* underflow, float denormals */
+        0x7f800000, 0xff800000, 0x7fc00000, 0xffc00000, /* +-inf, quiet NaN */
+        0x7f800001, 0x7f801fff, 0x7fa00000, 0xffbfffff, /* signaling NaN payloads */
+        0x40490fdb, 0xc2f6e979, 0x3eaaaaab};
+    Float src[Corrade::Containers::arraySize(bits)];
+    std::memcpy(src, bits, sizeof(bits));
+    UnsignedShort dst[Corrade::Containers::arraySize(src)];
+    packHalfInto(Corrade::Containers::StridedArrayView2D<Float>{src, {1, Corrade::Containers::arraySize(src)}},
+        Corrade::Containers::StridedArrayView2D<UnsignedShort>{dst, {1, Corrade::Containers::arraySize(src)}});
+
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(dst[i], packTable(src[i]));
+    }
+
+    /* Truncation, overflow and NaN payloads checked explicitly as well */
+    CORRADE_COMPARE(dst[4], 0x3c00);
+    CORRADE_COMPARE(dst[6], 0x3c01);
+    CORRADE_COMPARE(dst[11], 0x7bff);
+    CORRADE_COMPARE(dst[12], 0x7c00);
+    CORRADE_COMPARE(dst[13], 0xfc00);
+    CORRADE_COMPARE(dst[17], 0x03ff);
+    CORRADE_COMPARE(dst[19], 0x0001);
+    CORRADE_COMPARE(dst[20], 0x0000);
+    CORRADE_COMPARE(dst[28], 0x7c00);
+    CORRADE_COMPARE(dst[30], 0x7d00);
+}
+
 void HalfTest::pack1k() {
     UnsignedInt out = 0;
     CORRADE_BENCHMARK(100)
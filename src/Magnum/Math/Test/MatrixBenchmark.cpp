@@ -39,11 +39,13 @@ struct MatrixBenchmark: Corrade::TestSuite::Tester {
 
     void comatrix3();
     void invert3();
+    void invert3Adjugate();
     void invert3GaussJordan();
     void invert3Rigid();
     void invert3Orthogonal();
     void comatrix4();
     void invert4();
+    void invert4Adjugate();
     void invert4GaussJordan();
     void invert4Rigid();
     void invert4Orthogonal();
@@ -60,11 +62,13 @@ MatrixBenchmark::MatrixBenchmark() {
 
     addBenchmarks({&MatrixBenchmark::comatrix3,
                    &MatrixBenchmark::invert3,
+                   &MatrixBenchmark::invert3Adjugate,
                    &MatrixBenchmark::invert3GaussJordan,
                    &MatrixBenchmark::invert3Rigid,
                    &MatrixBenchmark::invert3Orthogonal,
                    &MatrixBenchmark::comatrix4,
                    &MatrixBenchmark::invert4,
+                   &MatrixBenchmark::invert4Adjugate,
                    &MatrixBenchmark::invert4GaussJordan,
                    &MatrixBenchmark::invert4Rigid,
                    &MatrixBenchmark::invert4Orthogonal}, 50);
@@ -129,6 +133,15 @@ void MatrixBenchmark::invert3() {
     CORRADE_VERIFY(a.toVector().sum() != 0);
 }
 
+void MatrixBenchmark::invert3Adjugate() {
+    Matrix3 a = Data3;
+    CORRADE_BENCHMARK(Repeats) {
+        a = a.adjugate()/a.determinant();
+    }
+
+    CORRADE_VERIFY(a.toVector().sum() != 0);
+}
+
 void MatrixBenchmark::invert3GaussJordan() {
     Matrix3 a = Data3;
     CORRADE_BENCHMARK(Repeats) {
@@ -174,6 +187,15 @@ void MatrixBenchmark::invert4() {
     CORRADE_VERIFY(a.toVector().sum() != 0);
 }
 
+void MatrixBenchmark::invert4Adjugate() {
+    Matrix4 a = Data4;
+    CORRADE_BENCHMARK(Repeats) {
+        a = a.adjugate()/a.determinant();
+    }
+
+    CORRADE_VERIFY(a.toVector().sum() != 0);
+}
+
 void MatrixBenchmark::invert4GaussJordan() {
     Matrix4 a = Data4;
     CORRADE_BENCHMARK(Repeats) {
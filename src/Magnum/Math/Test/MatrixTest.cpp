@@ -78,6 +78,8 @@ struct MatrixTest: Corrade::TestSuite::Tester {
     void adjugateCofactor();
     void determinant();
     void inverted();
+    void inverted3x3();
+    void invertedIntegral();
     void invertedOrthogonal();
     void invertedOrthogonalNotOrthogonal();
 
@@ -118,6 +120,8 @@ MatrixTest::MatrixTest() {
               &MatrixTest::adjugateCofactor,
               &MatrixTest::determinant,
               &MatrixTest::inverted,
+              &MatrixTest::inverted3x3,
+              &MatrixTest::invertedIntegral,
               &MatrixTest::invertedOrthogonal,
               &MatrixTest::invertedOrthogonalNotOrthogonal,
 
@@ -383,6 +387,46 @@ void MatrixTest::inverted() {
     CORRADE_COMPARE(_inverse*m, Matrix4x4());
 }
 
+void MatrixTest::inverted3x3() {
+    /* 3x3 and 4x4 have dedicated closed-form implementations */
+    Matrix3x3 m(Vector3(3.0f,  5.0f, 8.0f),
+                Vector3(4.0f,  4.0f, 7.0f),
+                Vector3(7.0f, -1.0f, 8.0f));
+
+    Matrix3x3 inverse(Vector3(-13/18.0f,  8/9.0f,  -1/18.0f),
+                      Vector3(-17/54.0f, 16/27.0f, -11/54.0f),
+                      Vector3( 16/27.0f, -19/27.0f,  4/27.0f));
+
+    Matrix3x3 _inverse = m.inverted();
+
+    CORRADE_COMPARE(_inverse, inverse);
+    CORRADE_COMPARE(_inverse*m, Matrix3x3());
+    CORRADE_COMPARE(_inverse, m.adjugate()/m.determinant());
+}
+
+void MatrixTest::invertedIntegral() {
+    /* The closed-form 3x3 and 4x4 variants divide by the determinant for
+       integers instead of multiplying by its (zero) reciprocal, giving the
+       same result as the generic variant */
+    Matrix<3, Int> a{Vector<3, Int>{1, 0, 0},
+                     Vector<3, Int>{3, 1, 0},
+                     Vector<3, Int>{0, 0, 2}};
+    CORRADE_COMPARE(a.inverted(), (Matrix<3, Int>{Vector<3, Int>{ 1, 0, 0},
+                                                  Vector<3, Int>{-3, 1, 0},
+                                                  Vector<3, Int>{ 0, 0, 0}}));
+    CORRADE_COMPARE(a.inverted(), a.adjugate()/a.determinant());
+
+    Matrix4x4i b{Vector4i{1, 0, 0, 0},
+                 Vector4i{3, 1, 0, 0},
+                 Vector4i{0, 0, 1, 0},
+                 Vector4i{0, 0, 0, 2}};
+    CORRADE_COMPARE(b.inverted(), (Matrix4x4i{Vector4i{ 1, 0, 0, 0},
+                                              Vector4i{-3, 1, 0, 0},
+                                              Vector4i{ 0, 0, 1, 0},
+                                              Vector4i{ 0, 0, 0, 0}}));
+    CORRADE_COMPARE(b.inverted(), b.adjugate()/b.determinant());
+}
+
 void MatrixTest::invertedOrthogonal() {
     Matrix3x3 a(Vector3(Constants::sqrt3()/2.0f, 0.5f, 0.0f),
                 Vector3(-0.5f, Constants::sqrt3()/2.0f, 0.0f),
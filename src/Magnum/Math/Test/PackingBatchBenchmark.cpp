@@ -0,0 +1,228 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/PackingBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct PackingBatchBenchmark: Corrade::TestSuite::Tester {
+    explicit PackingBatchBenchmark();
+
+    template<class T> void unpackScalar();
+    template<class T> void unpackBatch();
+    template<class T> void packScalar();
+    template<class T> void packBatch();
+    template<class T, class U> void castScalar();
+    template<class T, class U> void castBatch();
+};
+
+enum: std::size_t {
+    VertexCount = 65536,
+    ComponentCount = 3
+};
+
+/* Each benchmark is run on a contiguous array and on an array with the
+   components interleaved with other data, which is the usual case when
+   (un)packing vertex attributes */
+const struct {
+    const char* name;
+    std::size_t vertexStride; /* in elements */
+} Data[]{
+    {"contiguous", ComponentCount},
+    {"interleaved", 8}
+};
+
+PackingBatchBenchmark::PackingBatchBenchmark() {
+    addInstancedBenchmarks({
+        &PackingBatchBenchmark::unpackScalar<UnsignedByte>,
+        &PackingBatchBenchmark::unpackBatch<UnsignedByte>,
+        &PackingBatchBenchmark::unpackScalar<Short>,
+        &PackingBatchBenchmark::unpackBatch<Short>,
+
+        &PackingBatchBenchmark::packScalar<UnsignedByte>,
+        &PackingBatchBenchmark::packBatch<UnsignedByte>,
+        &PackingBatchBenchmark::packScalar<Short>,
+        &PackingBatchBenchmark::packBatch<Short>,
+
+        &PackingBatchBenchmark::castScalar<UnsignedShort, Float>,
+        &PackingBatchBenchmark::castBatch<UnsignedShort, Float>,
+        &PackingBatchBenchmark::castScalar<Float, Int>,
+        &PackingBatchBenchmark::castBatch<Float, Int>,
+        &PackingBatchBenchmark::castScalar<UnsignedByte, UnsignedInt>,
+        &PackingBatchBenchmark::castBatch<UnsignedByte, UnsignedInt>}, 10,
+        Corrade::Containers::arraySize(Data));
+}
+
+template<class T> Corrade::Containers::StridedArrayView2D<T> view(Corrade::Containers::Array<T>& array, const std::size_t vertexStride) {
+    return {array, array.data(), {VertexCount, ComponentCount}, {std::ptrdiff_t(vertexStride*sizeof(T)), std::ptrdiff_t(sizeof(T))}};
+}
+
+template<class T> Corrade::Containers::Array<T> integerInput(const std::size_t vertexStride) {
+    Corrade::Containers::Array<T> out{Corrade::Containers::NoInit, VertexCount*vertexStride};
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = T(i*7919 + 13);
+    return out;
+}
+
+template<class T> Corrade::Containers::Array<Float> floatInput(const std::size_t vertexStride) {
+    Corrade::Containers::Array<Float> out{Corrade::Containers::NoInit, VertexCount*vertexStride};
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        const Float value = (i % 1001)/1000.0f;
+        out[i] = std::is_signed<T>::value ? value*2.0f - 1.0f : value;
+    }
+    return out;
+}
+
+template<class T> void PackingBatchBenchmark::unpackScalar() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    Corrade::Containers::Array<T> src = integerInput<T>(data.vertexStride);
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::ValueInit, VertexCount*data.vertexStride};
+    const Corrade::Containers::StridedArrayView2D<const T> srcView = view(src, data.vertexStride);
+    const Corrade::Containers::StridedArrayView2D<Float> dstView = view(dst, data.vertexStride);
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != VertexCount; ++i)
+            for(std::size_t j = 0; j != ComponentCount; ++j)
+                dstView[i][j] = Math::unpack<Float>(srcView[i][j]);
+    }
+
+    CORRADE_COMPARE(dstView[1][2], Math::unpack<Float>(srcView[1][2]));
+}
+
+template<class T> void PackingBatchBenchmark::unpackBatch() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    Corrade::Containers::Array<T> src = integerInput<T>(data.vertexStride);
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::ValueInit, VertexCount*data.vertexStride};
+    const Corrade::Containers::StridedArrayView2D<const T> srcView = view(src, data.vertexStride);
+    const Corrade::Containers::StridedArrayView2D<Float> dstView = view(dst, data.vertexStride);
+
+    CORRADE_BENCHMARK(1) {
+        Math::unpackInto(srcView, dstView);
+    }
+
+    CORRADE_COMPARE(dstView[1][2], Math::unpack<Float>(srcView[1][2]));
+}
+
+template<class T> void PackingBatchBenchmark::packScalar() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    Corrade::Containers::Array<Float> src = floatInput<T>(data.vertexStride);
+    Corrade::Containers::Array<T> dst{Corrade::Containers::ValueInit, VertexCount*data.vertexStride};
+    const Corrade::Containers::StridedArrayView2D<const Float> srcView = view(src, data.vertexStride);
+    const Corrade::Containers::StridedArrayView2D<T> dstView = view(dst, data.vertexStride);
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != VertexCount; ++i)
+            for(std::size_t j = 0; j != ComponentCount; ++j)
+                dstView[i][j] = Math::pack<T>(srcView[i][j]);
+    }
+
+    CORRADE_COMPARE(dstView[1][2], Math::pack<T>(srcView[1][2]));
+}
+
+template<class T> void PackingBatchBenchmark::packBatch() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    Corrade::Containers::Array<Float> src = floatInput<T>(data.vertexStride);
+    Corrade::Containers::Array<T> dst{Corrade::Containers::ValueInit, VertexCount*data.vertexStride};
+    const Corrade::Containers::StridedArrayView2D<const Float> srcView = view(src, data.vertexStride);
+    const Corrade::Containers::StridedArrayView2D<T> dstView = view(dst, data.vertexStride);
+
+    CORRADE_BENCHMARK(1) {
+        Math::packInto(srcView, dstView);
+    }
+
+    CORRADE_COMPARE(dstView[1][2], Math::pack<T>(srcView[1][2]));
+}
+
+template<class T, class U> struct CastInput {
+    static Corrade::Containers::Array<T> get(const std::size_t vertexStride) {
+        return integerInput<T>(vertexStride);
+    }
+};
+template<class U> struct CastInput<Float, U> {
+    static Corrade::Containers::Array<Float> get(const std::size_t vertexStride) {
+        Corrade::Containers::Array<Float> out{Corrade::Containers::NoInit, VertexCount*vertexStride};
+        for(std::size_t i = 0; i != out.size(); ++i)
+            out[i] = Float(U(i*7919 + 13)) + 0.25f;
+        return out;
+    }
+};
+
+template<class T, class U> void PackingBatchBenchmark::castScalar() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseTemplateName(Corrade::Utility::formatString("{}, {}", TypeTraits<T>::name(), TypeTraits<U>::name()));
+    setTestCaseDescription(data.name);
+
+    Corrade::Containers::Array<T> src = CastInput<T, U>::get(data.vertexStride);
+    Corrade::Containers::Array<U> dst{Corrade::Containers::ValueInit, VertexCount*data.vertexStride};
+    const Corrade::Containers::StridedArrayView2D<const T> srcView = view(src, data.vertexStride);
+    const Corrade::Containers::StridedArrayView2D<U> dstView = view(dst, data.vertexStride);
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != VertexCount; ++i)
+            for(std::size_t j = 0; j != ComponentCount; ++j)
+                dstView[i][j] = U(srcView[i][j]);
+    }
+
+    CORRADE_COMPARE(dstView[1][2], U(srcView[1][2]));
+}
+
+template<class T, class U> void PackingBatchBenchmark::castBatch() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseTemplateName(Corrade::Utility::formatString("{}, {}", TypeTraits<T>::name(), TypeTraits<U>::name()));
+    setTestCaseDescription(data.name);
+
+    Corrade::Containers::Array<T> src = CastInput<T, U>::get(data.vertexStride);
+    Corrade::Containers::Array<U> dst{Corrade::Containers::ValueInit, VertexCount*data.vertexStride};
+    const Corrade::Containers::StridedArrayView2D<const T> srcView = view(src, data.vertexStride);
+    const Corrade::Containers::StridedArrayView2D<U> dstView = view(dst, data.vertexStride);
+
+    CORRADE_BENCHMARK(1) {
+        Math::castInto(srcView, dstView);
+    }
+
+    CORRADE_COMPARE(dstView[1][2], U(srcView[1][2]));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::PackingBatchBenchmark)
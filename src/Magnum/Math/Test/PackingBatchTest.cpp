@@ -24,6 +24,7 @@
 */
 
 #include <sstream>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
@@ -58,11 +59,28 @@ struct PackingBatchTest: Corrade::TestSuite::Tester {
     template<class T> void castUnsignedInteger();
     template<class T> void castSignedInteger();
 
+    template<class T> void unpackLayout();
+    template<class T> void packLayout();
+    template<class T, class U> void castLayout();
+
     template<class T> void assertionsPackUnpack();
     void assertionsPackUnpackHalf();
     template<class U, class T> void assertionsCast();
 };
 
+/* Exercising the contiguous, row-by-row and gathered code paths, with sizes
+   not divisible by the SIMD width */
+const struct {
+    const char* name;
+    std::size_t rows, columns, srcPadding, dstPadding;
+} LayoutData[]{
+    {"contiguous", 97, 3, 0, 0},
+    {"long rows", 13, 37, 3, 0},
+    {"short rows, padded source", 531, 3, 1, 0},
+    {"short rows, padded destination", 531, 2, 0, 2},
+    {"single column", 301, 1, 3, 1}
+};
+
 PackingBatchTest::PackingBatchTest() {
     addTests({&PackingBatchTest::unpackUnsignedByte,
               &PackingBatchTest::unpackUnsignedShort,
@@ -86,9 +104,27 @@ PackingBatchTest::PackingBatchTest() {
               &PackingBatchTest::castUnsignedInteger<UnsignedByte>,
               &PackingBatchTest::castUnsignedInteger<UnsignedShort>,
               &PackingBatchTest::castSignedInteger<Byte>,
-              &PackingBatchTest::castSignedInteger<Short>,
-
-              &PackingBatchTest::assertionsPackUnpack<UnsignedByte>,
+              &PackingBatchTest::castSignedInteger<Short>});
+
+    addInstancedTests<PackingBatchTest>({
+        &PackingBatchTest::unpackLayout<UnsignedByte>,
+        &PackingBatchTest::unpackLayout<UnsignedShort>,
+        &PackingBatchTest::unpackLayout<Byte>,
+        &PackingBatchTest::unpackLayout<Short>,
+        &PackingBatchTest::packLayout<UnsignedByte>,
+        &PackingBatchTest::packLayout<UnsignedShort>,
+        &PackingBatchTest::packLayout<Byte>,
+        &PackingBatchTest::packLayout<Short>,
+        &PackingBatchTest::castLayout<UnsignedByte, Float>,
+        &PackingBatchTest::castLayout<Short, Float>,
+        &PackingBatchTest::castLayout<UnsignedInt, Float>,
+        &PackingBatchTest::castLayout<Float, UnsignedShort>,
+        &PackingBatchTest::castLayout<Float, Int>,
+        &PackingBatchTest::castLayout<UnsignedInt, UnsignedByte>,
+        &PackingBatchTest::castLayout<Short, Int>},
+        Corrade::Containers::arraySize(LayoutData));
+
+    addTests({&PackingBatchTest::assertionsPackUnpack<UnsignedByte>,
               &PackingBatchTest::assertionsPackUnpack<Byte>,
               &PackingBatchTest::assertionsPackUnpack<UnsignedShort>,
               &PackingBatchTest::assertionsPackUnpack<Short>,
@@ -574,6 +610,97 @@ template<class T> void PackingBatchTest::castSignedInteger() {
         Corrade::TestSuite::Compare::Container);
 }
 
+template<class T> void PackingBatchTest::unpackLayout() {
+    auto&& data = LayoutData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    const std::size_t srcRowSize = data.columns + data.srcPadding;
+    const std::size_t dstRowSize = data.columns + data.dstPadding;
+    Corrade::Containers::Array<T> src{Corrade::Containers::NoInit, data.rows*srcRowSize};
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::ValueInit, data.rows*dstRowSize};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = T(UnsignedInt(i)*2654435761u);
+
+    unpackInto(
+        Corrade::Containers::StridedArrayView2D<const T>{src, src.data(), {data.rows, data.columns}, {std::ptrdiff_t(srcRowSize*sizeof(T)), std::ptrdiff_t(sizeof(T))}},
+        Corrade::Containers::StridedArrayView2D<Float>{dst, dst.data(), {data.rows, data.columns}, {std::ptrdiff_t(dstRowSize*sizeof(Float)), std::ptrdiff_t(sizeof(Float))}});
+
+    /* Should give the same result as the scalar APIs, padding untouched */
+    for(std::size_t i = 0; i != data.rows; ++i) {
+        for(std::size_t j = 0; j != data.columns; ++j)
+            CORRADE_COMPARE(dst[i*dstRowSize + j], Math::unpack<Float>(src[i*srcRowSize + j]));
+        for(std::size_t j = data.columns; j != dstRowSize; ++j)
+            CORRADE_COMPARE(dst[i*dstRowSize + j], 0.0f);
+    }
+}
+
+template<class T> void PackingBatchTest::packLayout() {
+    auto&& data = LayoutData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    const std::size_t srcRowSize = data.columns + data.srcPadding;
+    const std::size_t dstRowSize = data.columns + data.dstPadding;
+    Corrade::Containers::Array<Float> src{Corrade::Containers::NoInit, data.rows*srcRowSize};
+    Corrade::Containers::Array<T> dst{Corrade::Containers::ValueInit, data.rows*dstRowSize};
+    /* Includes also values exactly in the middle between two integers, to
+       verify the rounding matches */
+    for(std::size_t i = 0; i != src.size(); ++i) {
+        const Float value = (i % 1001)/1000.0f;
+        src[i] = std::is_signed<T>::value ? value*2.0f - 1.0f : value;
+    }
+    if(src.size() > 2) {
+        src[0] = 0.5f/Implementation::bitMax<T>();
+        src[1] = 1.5f/Implementation::bitMax<T>();
+    }
+
+    packInto(
+        Corrade::Containers::StridedArrayView2D<const Float>{src, src.data(), {data.rows, data.columns}, {std::ptrdiff_t(srcRowSize*sizeof(Float)), std::ptrdiff_t(sizeof(Float))}},
+        Corrade::Containers::StridedArrayView2D<T>{dst, dst.data(), {data.rows, data.columns}, {std::ptrdiff_t(dstRowSize*sizeof(T)), std::ptrdiff_t(sizeof(T))}});
+
+    /* Should give the same result as the scalar APIs, padding untouched */
+    for(std::size_t i = 0; i != data.rows; ++i) {
+        for(std::size_t j = 0; j != data.columns; ++j)
+            CORRADE_COMPARE(dst[i*dstRowSize + j], Math::pack<T>(src[i*srcRowSize + j]));
+        for(std::size_t j = data.columns; j != dstRowSize; ++j)
+            CORRADE_COMPARE(dst[i*dstRowSize + j], T(0));
+    }
+}
+
+template<class T, class U> struct CastLayoutValue {
+    static T get(std::size_t i) { return T(UnsignedInt(i)*2654435761u); }
+};
+template<class U> struct CastLayoutValue<Float, U> {
+    /* Keeping the values in range of the destination type */
+    static Float get(std::size_t i) { return Float(U(UnsignedInt(i)*7919u + 13u)) + 0.25f; }
+};
+
+template<class T, class U> void PackingBatchTest::castLayout() {
+    auto&& data = LayoutData[testCaseInstanceId()];
+    setTestCaseTemplateName(Corrade::Utility::formatString("{}, {}", TypeTraits<T>::name(), TypeTraits<U>::name()));
+    setTestCaseDescription(data.name);
+
+    const std::size_t srcRowSize = data.columns + data.srcPadding;
+    const std::size_t dstRowSize = data.columns + data.dstPadding;
+    Corrade::Containers::Array<T> src{Corrade::Containers::NoInit, data.rows*srcRowSize};
+    Corrade::Containers::Array<U> dst{Corrade::Containers::ValueInit, data.rows*dstRowSize};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = CastLayoutValue<T, U>::get(i);
+
+    castInto(
+        Corrade::Containers::StridedArrayView2D<const T>{src, src.data(), {data.rows, data.columns}, {std::ptrdiff_t(srcRowSize*sizeof(T)), std::ptrdiff_t(sizeof(T))}},
+        Corrade::Containers::StridedArrayView2D<U>{dst, dst.data(), {data.rows, data.columns}, {std::ptrdiff_t(dstRowSize*sizeof(U)), std::ptrdiff_t(sizeof(U))}});
+
+    /* Should give the same result as a plain cast, padding untouched */
+    for(std::size_t i = 0; i != data.rows; ++i) {
+        for(std::size_t j = 0; j != data.columns; ++j)
+            CORRADE_COMPARE(dst[i*dstRowSize + j], U(src[i*srcRowSize + j]));
+        for(std::size_t j = data.columns; j != dstRowSize; ++j)
+            CORRADE_COMPARE(dst[i*dstRowSize + j], U(0));
+    }
+}
+
 template<class T> void PackingBatchTest::assertionsPackUnpack() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
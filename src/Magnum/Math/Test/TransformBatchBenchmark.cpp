@@ -0,0 +1,280 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/TransformBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct TransformBatchBenchmark: Corrade::TestSuite::Tester {
+    explicit TransformBatchBenchmark();
+
+    void multiplyScalar();
+    void multiplyBatch();
+    void multiplyCommonScalar();
+    void multiplyCommonBatch();
+    void transformPointsScalar();
+    void transformPointsBatch();
+    void invertedScalar();
+    void invertedBatch();
+    void skinScalar();
+    void skinBatch();
+};
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::DualQuaternion<Float> DualQuaternion;
+
+/* Each benchmark processes this many elements in a single iteration, divide
+   the reported time by it to get a per-element cost */
+enum: std::size_t {
+    Count = 1000,
+    JointCount = 64,
+    InfluenceCount = 4
+};
+
+TransformBatchBenchmark::TransformBatchBenchmark() {
+    addBenchmarks({&TransformBatchBenchmark::multiplyScalar,
+                   &TransformBatchBenchmark::multiplyBatch,
+                   &TransformBatchBenchmark::multiplyCommonScalar,
+                   &TransformBatchBenchmark::multiplyCommonBatch,
+                   &TransformBatchBenchmark::transformPointsScalar,
+                   &TransformBatchBenchmark::transformPointsBatch,
+                   &TransformBatchBenchmark::invertedScalar,
+                   &TransformBatchBenchmark::invertedBatch,
+                   &TransformBatchBenchmark::skinScalar,
+                   &TransformBatchBenchmark::skinBatch}, 50);
+}
+
+Matrix4 transformation(std::size_t i) {
+    return Matrix4::translation({i*0.5f, -1.0f, 2.0f - i*0.01f})*
+        Matrix4::rotation(Deg(i*17.0f), Vector3{1.0f, Float(i % 7), 2.0f}.normalized())*
+        Matrix4::scaling({1.0f + (i % 10)*0.1f, 2.0f, 0.5f});
+}
+
+DualQuaternion dualQuaternion(std::size_t i) {
+    return DualQuaternion::translation({i*0.5f, -1.0f, 2.0f - i*0.01f})*
+        DualQuaternion::rotation(Deg(i*17.0f), Vector3{1.0f, Float(i % 7), 2.0f}.normalized());
+}
+
+Corrade::Containers::Array<Matrix4> transformations(std::size_t offset) {
+    Corrade::Containers::Array<Matrix4> out{Corrade::Containers::NoInit, Count};
+    for(std::size_t i = 0; i != Count; ++i)
+        out[i] = transformation(i + offset);
+    return out;
+}
+
+Corrade::Containers::Array<Vector3> points() {
+    Corrade::Containers::Array<Vector3> out{Corrade::Containers::NoInit, Count};
+    for(std::size_t i = 0; i != Count; ++i)
+        out[i] = {i*0.1f, 1.0f - i*0.05f, (i % 13)*0.3f};
+    return out;
+}
+
+void TransformBatchBenchmark::multiplyScalar() {
+    setTestCaseDescription("1000 matrices");
+
+    Corrade::Containers::Array<Matrix4> a = transformations(0);
+    Corrade::Containers::Array<Matrix4> b = transformations(3);
+    Corrade::Containers::Array<Matrix4> out{Corrade::Containers::ValueInit, Count};
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != Count; ++i)
+            out[i] = a[i]*b[i];
+    }
+
+    CORRADE_COMPARE(out[7], a[7]*b[7]);
+}
+
+void TransformBatchBenchmark::multiplyBatch() {
+    setTestCaseDescription("1000 matrices");
+
+    Corrade::Containers::Array<Matrix4> a = transformations(0);
+    Corrade::Containers::Array<Matrix4> b = transformations(3);
+    Corrade::Containers::Array<Matrix4> out{Corrade::Containers::ValueInit, Count};
+
+    CORRADE_BENCHMARK(1) {
+        multiplyInto(a, b, out);
+    }
+
+    CORRADE_COMPARE(out[7], a[7]*b[7]);
+}
+
+void TransformBatchBenchmark::multiplyCommonScalar() {
+    setTestCaseDescription("1000 matrices");
+
+    const Matrix4 a = Matrix4::perspectiveProjection(Deg(60.0f), 1.5f, 0.1f, 100.0f);
+    Corrade::Containers::Array<Matrix4> b = transformations(0);
+    Corrade::Containers::Array<Matrix4> out{Corrade::Containers::ValueInit, Count};
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != Count; ++i)
+            out[i] = a*b[i];
+    }
+
+    CORRADE_COMPARE(out[7], a*b[7]);
+}
+
+void TransformBatchBenchmark::multiplyCommonBatch() {
+    setTestCaseDescription("1000 matrices");
+
+    const Matrix4 a = Matrix4::perspectiveProjection(Deg(60.0f), 1.5f, 0.1f, 100.0f);
+    Corrade::Containers::Array<Matrix4> b = transformations(0);
+    Corrade::Containers::Array<Matrix4> out{Corrade::Containers::ValueInit, Count};
+
+    CORRADE_BENCHMARK(1) {
+        multiplyInto(a, b, out);
+    }
+
+    CORRADE_COMPARE(out[7], a*b[7]);
+}
+
+void TransformBatchBenchmark::transformPointsScalar() {
+    setTestCaseDescription("1000 points");
+
+    const Matrix4 matrix = transformation(5);
+    Corrade::Containers::Array<Vector3> src = points();
+    Corrade::Containers::Array<Vector3> out{Corrade::Containers::ValueInit, Count};
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != Count; ++i)
+            out[i] = matrix.transformPoint(src[i]);
+    }
+
+    CORRADE_COMPARE(out[7], matrix.transformPoint(src[7]));
+}
+
+void TransformBatchBenchmark::transformPointsBatch() {
+    setTestCaseDescription("1000 points");
+
+    const Matrix4 matrix = transformation(5);
+    Corrade::Containers::Array<Vector3> src = points();
+    Corrade::Containers::Array<Vector3> out{Corrade::Containers::ValueInit, Count};
+
+    CORRADE_BENCHMARK(1) {
+        transformPointsInto(matrix, src, out);
+    }
+
+    CORRADE_COMPARE(out[7], matrix.transformPoint(src[7]));
+}
+
+void TransformBatchBenchmark::invertedScalar() {
+    setTestCaseDescription("1000 matrices");
+
+    Corrade::Containers::Array<Matrix4> src = transformations(0);
+    Corrade::Containers::Array<Matrix4> out{Corrade::Containers::ValueInit, Count};
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != Count; ++i)
+            out[i] = src[i].inverted();
+    }
+
+    CORRADE_COMPARE(out[7], src[7].inverted());
+}
+
+void TransformBatchBenchmark::invertedBatch() {
+    setTestCaseDescription("1000 matrices");
+
+    Corrade::Containers::Array<Matrix4> src = transformations(0);
+    Corrade::Containers::Array<Matrix4> out{Corrade::Containers::ValueInit, Count};
+
+    CORRADE_BENCHMARK(1) {
+        invertedInto(src, out);
+    }
+
+    CORRADE_COMPARE(out[7], src[7].inverted());
+}
+
+/* Dual quaternion skinning of 1000 vertices with four influences each, i.e.
+   what a CPU skinning implementation would do every frame */
+struct SkinData {
+    SkinData();
+
+    DualQuaternion joints[JointCount];
+    UnsignedInt ids[Count*InfluenceCount];
+    Float weights[Count*InfluenceCount];
+    Corrade::Containers::Array<Vector3> positions;
+};
+
+SkinData::SkinData(): positions{points()} {
+    for(std::size_t i = 0; i != JointCount; ++i)
+        joints[i] = dualQuaternion(i);
+    for(std::size_t i = 0; i != Count; ++i) {
+        for(std::size_t j = 0; j != InfluenceCount; ++j) {
+            ids[i*InfluenceCount + j] = (i*7 + j*13) % JointCount;
+            weights[i*InfluenceCount + j] = 0.1f + j*0.2f;
+        }
+    }
+}
+
+void TransformBatchBenchmark::skinScalar() {
+    setTestCaseDescription("1000 vertices, 4 influences");
+
+    SkinData data;
+    Corrade::Containers::Array<Vector3> out{Corrade::Containers::ValueInit, Count};
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != Count; ++i) {
+            DualQuaternion blended{Math::ZeroInit};
+            for(std::size_t j = 0; j != InfluenceCount; ++j) {
+                const DualQuaternion& joint = data.joints[data.ids[i*InfluenceCount + j]];
+                const Float weight = data.weights[i*InfluenceCount + j];
+                blended += Math::dot(blended.real(), joint.real()) < 0.0f ?
+                    -joint*weight : joint*weight;
+            }
+            out[i] = (blended/blended.real().length()).transformPoint(data.positions[i]);
+        }
+    }
+
+    CORRADE_VERIFY(out[7] != Vector3{});
+}
+
+void TransformBatchBenchmark::skinBatch() {
+    setTestCaseDescription("1000 vertices, 4 influences");
+
+    SkinData data;
+    Corrade::Containers::Array<DualQuaternion> blended{Corrade::Containers::ValueInit, Count};
+    Corrade::Containers::Array<Vector3> out{Corrade::Containers::ValueInit, Count};
+
+    CORRADE_BENCHMARK(1) {
+        blendInto(data.joints,
+            Corrade::Containers::StridedArrayView2D<const UnsignedInt>{data.ids, {Count, InfluenceCount}},
+            Corrade::Containers::StridedArrayView2D<const Float>{data.weights, {Count, InfluenceCount}},
+            blended);
+        transformPointsInto(blended, data.positions, out);
+    }
+
+    CORRADE_VERIFY(out[7] != Vector3{});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::TransformBatchBenchmark)
@@ -0,0 +1,435 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/TransformBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct TransformBatchTest: Corrade::TestSuite::Tester {
+    explicit TransformBatchTest();
+
+    void multiply();
+    void multiplyCommon();
+    void multiplyInPlace();
+    void transformPoints();
+    void transformPointsProjective();
+    void transformVectors();
+    void inverted();
+    void invertedInPlace();
+    void inverted3x3();
+    void quaternionToMatrix();
+    void dualQuaternionToMatrix();
+    void blend();
+    void blendShortestPath();
+    void blendNoInfluences();
+    void transformPointsDualQuaternion();
+
+    void assertions();
+    void assertionsBlend();
+};
+
+TransformBatchTest::TransformBatchTest() {
+    addTests({&TransformBatchTest::multiply,
+              &TransformBatchTest::multiplyCommon,
+              &TransformBatchTest::multiplyInPlace,
+              &TransformBatchTest::transformPoints,
+              &TransformBatchTest::transformPointsProjective,
+              &TransformBatchTest::transformVectors,
+              &TransformBatchTest::inverted,
+              &TransformBatchTest::invertedInPlace,
+              &TransformBatchTest::inverted3x3,
+              &TransformBatchTest::quaternionToMatrix,
+              &TransformBatchTest::dualQuaternionToMatrix,
+              &TransformBatchTest::blend,
+              &TransformBatchTest::blendShortestPath,
+              &TransformBatchTest::blendNoInfluences,
+              &TransformBatchTest::transformPointsDualQuaternion,
+
+              &TransformBatchTest::assertions,
+              &TransformBatchTest::assertionsBlend});
+}
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Matrix3x3<Float> Matrix3x3;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Quaternion<Float> Quaternion;
+typedef Math::DualQuaternion<Float> DualQuaternion;
+
+using namespace Literals;
+
+/* Not divisible by any SIMD width, to test the remainder handling as well */
+enum: std::size_t { Count = 13 };
+
+Matrix4 transformation(std::size_t i) {
+    return Matrix4::translation({i*0.5f, -1.0f, 2.0f - i})*
+        Matrix4::rotation(Deg(i*17.0f), Vector3{1.0f, Float(i), 2.0f}.normalized())*
+        Matrix4::scaling({1.0f + i*0.1f, 2.0f, 0.5f});
+}
+
+DualQuaternion dualQuaternion(std::size_t i) {
+    return DualQuaternion::translation({i*0.5f, -1.0f, 2.0f - i})*
+        DualQuaternion::rotation(Deg(i*17.0f), Vector3{1.0f, Float(i), 2.0f}.normalized());
+}
+
+void TransformBatchTest::multiply() {
+    Matrix4 a[Count], b[Count], out[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        a[i] = transformation(i);
+        b[i] = transformation(Count - i)*Matrix4::perspectiveProjection(60.0_degf, 1.5f, 0.1f, 100.0f);
+    }
+
+    multiplyInto(a, b, out);
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], a[i]*b[i]);
+    }
+}
+
+void TransformBatchTest::multiplyCommon() {
+    const Matrix4 a = transformation(7);
+    Matrix4 b[Count], out[Count];
+    for(std::size_t i = 0; i != Count; ++i)
+        b[i] = transformation(Count - i);
+
+    multiplyInto(a, b, out);
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], a*b[i]);
+    }
+}
+
+void TransformBatchTest::multiplyInPlace() {
+    /* Interleaved with other data, every second one */
+    struct Data {
+        Matrix4 matrix;
+        Int other;
+    } data[Count];
+    Matrix4 a[Count], expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        a[i] = transformation(i);
+        data[i].matrix = transformation(Count - i);
+        data[i].other = Int(i);
+        expected[i] = a[i]*data[i].matrix;
+    }
+
+    Corrade::Containers::StridedArrayView1D<Matrix4> matrices{data, &data[0].matrix, Count, sizeof(Data)};
+    multiplyInto(a, matrices, matrices);
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(data[i].matrix, expected[i]);
+        CORRADE_COMPARE(data[i].other, Int(i));
+    }
+}
+
+void TransformBatchTest::transformPoints() {
+    const Matrix4 matrix = transformation(5);
+    Vector3 points[Count], out[Count + 1];
+    for(std::size_t i = 0; i != Count; ++i)
+        points[i] = {Float(i), 1.0f - i*0.25f, 3.0f};
+    /* Verify the memory after the last point isn't touched */
+    out[Count] = Vector3{1337.0f};
+
+    transformPointsInto(matrix, points, Corrade::Containers::arrayView(out).prefix(Count));
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], matrix.transformPoint(points[i]));
+    }
+    CORRADE_COMPARE(out[Count], Vector3{1337.0f});
+}
+
+void TransformBatchTest::transformPointsProjective() {
+    /* The division by W should be done as well */
+    const Matrix4 matrix = Matrix4::perspectiveProjection(60.0_degf, 1.5f, 0.1f, 100.0f)*transformation(2);
+    Vector3 points[Count], out[Count];
+    for(std::size_t i = 0; i != Count; ++i)
+        points[i] = {Float(i), 1.0f - i*0.25f, -3.0f - i};
+
+    transformPointsInto(matrix, points, out);
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], matrix.transformPoint(points[i]));
+    }
+}
+
+void TransformBatchTest::transformVectors() {
+    const Matrix4 matrix = transformation(5);
+    Vector3 vectors[Count], out[Count];
+    for(std::size_t i = 0; i != Count; ++i)
+        vectors[i] = {Float(i), 1.0f - i*0.25f, 3.0f};
+
+    /* In-place */
+    for(std::size_t i = 0; i != Count; ++i)
+        out[i] = vectors[i];
+    transformVectorsInto(matrix, out, out);
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], matrix.transformVector(vectors[i]));
+    }
+}
+
+void TransformBatchTest::inverted() {
+    Matrix4 matrices[Count], out[Count];
+    for(std::size_t i = 0; i != Count; ++i)
+        matrices[i] = Matrix4::perspectiveProjection(60.0_degf, 1.5f, 0.1f, 100.0f)*transformation(i);
+
+    invertedInto(matrices, out);
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], matrices[i].inverted());
+        CORRADE_COMPARE(out[i]*matrices[i], Matrix4{});
+    }
+}
+
+void TransformBatchTest::invertedInPlace() {
+    Matrix4 matrices[Count], expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        matrices[i] = transformation(i);
+        expected[i] = matrices[i].inverted();
+    }
+
+    invertedInto(matrices, matrices);
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(matrices[i], expected[i]);
+    }
+}
+
+void TransformBatchTest::inverted3x3() {
+    Matrix3x3 matrices[Count], out[Count];
+    for(std::size_t i = 0; i != Count; ++i)
+        matrices[i] = transformation(i).rotationScaling();
+
+    invertedInto(matrices, out);
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], matrices[i].inverted());
+        CORRADE_COMPARE(out[i]*matrices[i], Matrix3x3{});
+    }
+}
+
+void TransformBatchTest::quaternionToMatrix() {
+    Quaternion quaternions[Count];
+    Matrix3x3 out[Count];
+    for(std::size_t i = 0; i != Count; ++i)
+        quaternions[i] = dualQuaternion(i).rotation();
+
+    toMatrixInto(quaternions, out);
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], quaternions[i].toMatrix());
+    }
+}
+
+void TransformBatchTest::dualQuaternionToMatrix() {
+    DualQuaternion dualQuaternions[Count];
+    Matrix4 out[Count];
+    for(std::size_t i = 0; i != Count; ++i)
+        dualQuaternions[i] = dualQuaternion(i);
+
+    toMatrixInto(dualQuaternions, out);
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], dualQuaternions[i].toMatrix());
+    }
+}
+
+void TransformBatchTest::blend() {
+    const DualQuaternion joints[]{
+        DualQuaternion::translation({1.0f, 0.0f, 0.0f}),
+        DualQuaternion::translation({0.0f, 3.0f, 0.0f}),
+        DualQuaternion::rotation(90.0_degf, Vector3::zAxis())
+    };
+    const UnsignedInt ids[]{
+        0, 1,
+        1, 0,
+        2, 2,
+        0, 2
+    };
+    const Float weights[]{
+        0.5f, 0.5f,
+        1.0f, 0.0f,
+        0.25f, 0.25f,
+        0.5f, 0.5f
+    };
+    DualQuaternion out[4];
+
+    blendInto(joints,
+        Corrade::Containers::StridedArrayView2D<const UnsignedInt>{ids, {4, 2}},
+        Corrade::Containers::StridedArrayView2D<const Float>{weights, {4, 2}},
+        out);
+    /* Translations get averaged */
+    CORRADE_COMPARE(out[0], DualQuaternion::translation({0.5f, 1.5f, 0.0f}));
+    /* Zero weight is ignored */
+    CORRADE_COMPARE(out[1], joints[1]);
+    /* Weights that don't sum up to one get normalized */
+    CORRADE_COMPARE(out[2], joints[2]);
+    /* Rotation and translation gets blended halfway, the result is a unit
+       dual quaternion */
+    CORRADE_VERIFY(out[3].isNormalized());
+    CORRADE_COMPARE(out[3].rotation(), Quaternion::rotation(45.0_degf, Vector3::zAxis()));
+}
+
+void TransformBatchTest::blendShortestPath() {
+    /* The same rotation, but the second has the opposite sign. Without the
+       hemisphere check these would cancel each other out. */
+    const DualQuaternion rotation = DualQuaternion::rotation(30.0_degf, Vector3::xAxis());
+    const DualQuaternion joints[]{
+        rotation,
+        DualQuaternion{-rotation.real(), -rotation.dual()}
+    };
+    const UnsignedInt ids[]{0, 1};
+    const Float weights[]{0.5f, 0.5f};
+    DualQuaternion out[1];
+
+    blendInto(joints,
+        Corrade::Containers::StridedArrayView2D<const UnsignedInt>{ids, {1, 2}},
+        Corrade::Containers::StridedArrayView2D<const Float>{weights, {1, 2}},
+        out);
+    CORRADE_COMPARE(out[0], rotation);
+}
+
+void TransformBatchTest::blendNoInfluences() {
+    const DualQuaternion joints[]{
+        DualQuaternion::translation({1.0f, 0.0f, 0.0f})
+    };
+    const UnsignedInt ids[1]{};
+    const Float weights[1]{};
+    DualQuaternion out[3]{joints[0], joints[0], joints[0]};
+
+    blendInto(joints,
+        Corrade::Containers::StridedArrayView2D<const UnsignedInt>{ids, {3, 0}},
+        Corrade::Containers::StridedArrayView2D<const Float>{weights, {3, 0}},
+        out);
+    CORRADE_COMPARE(out[0], DualQuaternion{});
+    CORRADE_COMPARE(out[1], DualQuaternion{});
+    CORRADE_COMPARE(out[2], DualQuaternion{});
+}
+
+void TransformBatchTest::transformPointsDualQuaternion() {
+    DualQuaternion transformations[Count];
+    Vector3 points[Count], out[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        transformations[i] = dualQuaternion(i);
+        points[i] = {Float(i), 1.0f - i*0.25f, 3.0f};
+    }
+
+    transformPointsInto(transformations, points, out);
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], transformations[i].transformPointNormalized(points[i]));
+    }
+}
+
+void TransformBatchTest::assertions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Matrix4 matrices[3];
+    Vector3 points[3];
+    Quaternion quaternions[3];
+    Matrix3x3 matrices3[3];
+    DualQuaternion dualQuaternions[3];
+    auto matrices2 = Corrade::Containers::arrayView(matrices).prefix(2);
+    auto points2 = Corrade::Containers::arrayView(points).prefix(2);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    multiplyInto(matrices2, matrices, matrices);
+    multiplyInto(matrices, matrices, matrices2);
+    multiplyInto(Matrix4{}, matrices, matrices2);
+    transformPointsInto(Matrix4{}, points, points2);
+    transformVectorsInto(Matrix4{}, points, points2);
+    invertedInto(matrices, matrices2);
+    invertedInto(matrices3, Corrade::Containers::arrayView(matrices3).prefix(2));
+    toMatrixInto(Corrade::Containers::arrayView(quaternions).prefix(2), matrices3);
+    toMatrixInto(dualQuaternions, matrices2);
+    transformPointsInto(Corrade::Containers::arrayView(dualQuaternions).prefix(2), points, points);
+    transformPointsInto(dualQuaternions, points, points2);
+
+    /* The output element is larger than the input, so they can't overlap */
+    alignas(16) char data[2*sizeof(Matrix4)]{};
+    auto dataView = Corrade::Containers::arrayView(data);
+    toMatrixInto(Corrade::Containers::arrayCast<const Quaternion>(dataView.prefix(2*sizeof(Quaternion))),
+        Corrade::Containers::arrayCast<Matrix3x3>(dataView.prefix(2*sizeof(Matrix3x3))));
+    toMatrixInto(Corrade::Containers::arrayCast<const DualQuaternion>(dataView.prefix(2*sizeof(DualQuaternion))),
+        Corrade::Containers::arrayCast<Matrix4>(dataView));
+    CORRADE_COMPARE(out.str(),
+        "Math::multiplyInto(): expected views of the same size, got 2 and 3\n"
+        "Math::multiplyInto(): wrong destination size, got 2 but expected 3\n"
+        "Math::multiplyInto(): wrong destination size, got 2 but expected 3\n"
+        "Math::transformPointsInto(): wrong destination size, got 2 but expected 3\n"
+        "Math::transformVectorsInto(): wrong destination size, got 2 but expected 3\n"
+        "Math::invertedInto(): wrong destination size, got 2 but expected 3\n"
+        "Math::invertedInto(): wrong destination size, got 2 but expected 3\n"
+        "Math::toMatrixInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::toMatrixInto(): wrong destination size, got 2 but expected 3\n"
+        "Math::transformPointsInto(): expected 3 transformations but got 2\n"
+        "Math::transformPointsInto(): wrong destination size, got 2 but expected 3\n"
+        "Math::toMatrixInto(): the destination can't overlap the source\n"
+        "Math::toMatrixInto(): the destination can't overlap the source\n");
+}
+
+void TransformBatchTest::assertionsBlend() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const DualQuaternion joints[2];
+    const UnsignedInt ids[]{0, 1, 1, 2};
+    const Float weights[]{0.5f, 0.5f, 0.5f, 0.5f};
+    DualQuaternion dst[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    blendInto(joints,
+        Corrade::Containers::StridedArrayView2D<const UnsignedInt>{ids, {2, 2}},
+        Corrade::Containers::StridedArrayView2D<const Float>{weights, {2, 1}, {8, 4}},
+        dst);
+    blendInto(joints,
+        Corrade::Containers::StridedArrayView2D<const UnsignedInt>{ids, {2, 2}},
+        Corrade::Containers::StridedArrayView2D<const Float>{weights, {2, 2}},
+        Corrade::Containers::arrayView(dst).prefix(1));
+    blendInto(joints,
+        Corrade::Containers::StridedArrayView2D<const UnsignedInt>{ids, {2, 2}},
+        Corrade::Containers::StridedArrayView2D<const Float>{weights, {2, 2}},
+        dst);
+    CORRADE_COMPARE(out.str(),
+        "Math::blendInto(): expected ids and weights to have the same size, got {2, 2} and {2, 1}\n"
+        "Math::blendInto(): wrong destination size, got 1 but expected 2\n"
+        "Math::blendInto(): ID 2 out of bounds for 2 transformations\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::TransformBatchTest)
@@ -0,0 +1,218 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TransformBatch.h"
+
+#include <utility>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Implementation/transformBatchKernels.hpp"
+
+namespace Magnum { namespace Math {
+
+static_assert(sizeof(Matrix4<Float>) == 16*sizeof(Float) && sizeof(Vector3<Float>) == 3*sizeof(Float),
+    "improper size of matrix and vector types");
+
+void multiplyInto(const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst) {
+    CORRADE_ASSERT(a.size() == b.size(),
+        "Math::multiplyInto(): expected views of the same size, got" << a.size() << "and" << b.size(), );
+    CORRADE_ASSERT(a.size() == dst.size(),
+        "Math::multiplyInto(): wrong destination size, got" << dst.size() << "but expected" << a.size(), );
+
+    static const Implementation::MatrixMultiplyKernel kernel = Implementation::multiplyMatricesKernel();
+    kernel(static_cast<const char*>(a.data()), a.stride(),
+        static_cast<const char*>(b.data()), b.stride(),
+        static_cast<char*>(dst.data()), dst.stride(), dst.size());
+}
+
+void multiplyInto(const Matrix4<Float>& a, const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst) {
+    CORRADE_ASSERT(b.size() == dst.size(),
+        "Math::multiplyInto(): wrong destination size, got" << dst.size() << "but expected" << b.size(), );
+
+    /* A zero stride makes the kernel use the same matrix for all elements.
+       Copying it first, as the destination can alias it. */
+    const Matrix4<Float> aCopy = a;
+    static const Implementation::MatrixMultiplyKernel kernel = Implementation::multiplyMatricesKernel();
+    kernel(reinterpret_cast<const char*>(aCopy.data()), 0,
+        static_cast<const char*>(b.data()), b.stride(),
+        static_cast<char*>(dst.data()), dst.stride(), dst.size());
+}
+
+void transformPointsInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::transformPointsInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    static const Implementation::MatrixTransformKernel kernel = Implementation::transformPointsKernel();
+    kernel(matrix.data(),
+        static_cast<const char*>(src.data()), src.stride(),
+        static_cast<char*>(dst.data()), dst.stride(), dst.size());
+}
+
+void transformVectorsInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::transformVectorsInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    static const Implementation::MatrixTransformKernel kernel = Implementation::transformVectorsKernel();
+    kernel(matrix.data(),
+        static_cast<const char*>(src.data()), src.stride(),
+        static_cast<char*>(dst.data()), dst.stride(), dst.size());
+}
+
+void invertedInto(const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& src, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::invertedInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    static const Implementation::MatrixInvertKernel kernel = Implementation::invertMatricesKernel();
+    kernel(static_cast<const char*>(src.data()), src.stride(),
+        static_cast<char*>(dst.data()), dst.stride(), dst.size());
+}
+
+void invertedInto(const Corrade::Containers::StridedArrayView1D<const Matrix3x3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Matrix3x3<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::invertedInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    /* Matrix::inverted() is already a closed-form expression for 3x3
+       matrices, there's nothing to share between the elements */
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = src[i].inverted();
+}
+
+namespace {
+
+#ifndef CORRADE_NO_ASSERT
+/* Used by functions where the output element is larger than the input, so
+   writing it would overwrite inputs that weren't read yet */
+template<class T, class U> bool overlaps(const Corrade::Containers::StridedArrayView1D<T>& a, const Corrade::Containers::StridedArrayView1D<U>& b) {
+    if(a.empty() || b.empty()) return false;
+
+    const char* aBegin = static_cast<const char*>(static_cast<const void*>(a.data()));
+    const char* aEnd = aBegin + std::ptrdiff_t(a.size() - 1)*a.stride();
+    if(aEnd < aBegin) std::swap(aBegin, aEnd);
+    aEnd += sizeof(T);
+
+    const char* bBegin = static_cast<const char*>(static_cast<const void*>(b.data()));
+    const char* bEnd = bBegin + std::ptrdiff_t(b.size() - 1)*b.stride();
+    if(bEnd < bBegin) std::swap(bBegin, bEnd);
+    bEnd += sizeof(U);
+
+    return aBegin < bEnd && bBegin < aEnd;
+}
+#endif
+
+}
+
+void toMatrixInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<Matrix3x3<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::toMatrixInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(!overlaps(src, dst),
+        "Math::toMatrixInto(): the destination can't overlap the source", );
+
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = src[i].toMatrix();
+}
+
+namespace {
+
+/* Translation part of a normalized dual quaternion, equivalent to
+   DualQuaternion::translation() with the quaternion multiplication
+   expanded */
+inline Vector3<Float> translation(const Quaternion<Float>& real, const Quaternion<Float>& dual) {
+    return 2.0f*(real.scalar()*dual.vector() - dual.scalar()*real.vector() + cross(real.vector(), dual.vector()));
+}
+
+}
+
+void toMatrixInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::toMatrixInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(!overlaps(src, dst),
+        "Math::toMatrixInto(): the destination can't overlap the source", );
+
+    for(std::size_t i = 0; i != src.size(); ++i) {
+        const Quaternion<Float> real = src[i].real();
+        const Quaternion<Float> dual = src[i].dual();
+        dst[i] = Matrix4<Float>::from(real.toMatrix(), translation(real, dual));
+    }
+}
+
+void blendInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& transformations, const Corrade::Containers::StridedArrayView2D<const UnsignedInt>& ids, const Corrade::Containers::StridedArrayView2D<const Float>& weights, const Corrade::Containers::StridedArrayView1D<DualQuaternion<Float>>& dst) {
+    CORRADE_ASSERT(ids.size() == weights.size(),
+        "Math::blendInto(): expected ids and weights to have the same size, got" << ids.size() << "and" << weights.size(), );
+    CORRADE_ASSERT(ids.size()[0] == dst.size(),
+        "Math::blendInto(): wrong destination size, got" << dst.size() << "but expected" << ids.size()[0], );
+
+    const std::size_t influenceCount = ids.size()[1];
+    for(std::size_t i = 0; i != dst.size(); ++i) {
+        Quaternion<Float> real{ZeroInit}, dual{ZeroInit};
+        Quaternion<Float> pivot;
+        for(std::size_t j = 0; j != influenceCount; ++j) {
+            const UnsignedInt id = ids[i][j];
+            CORRADE_ASSERT(id < transformations.size(),
+                "Math::blendInto(): ID" << id << "out of bounds for" << transformations.size() << "transformations", );
+
+            const DualQuaternion<Float>& transformation = transformations[id];
+            if(j == 0) pivot = transformation.real();
+
+            /* Flip transformations in the opposite hemisphere to go the
+               shortest way */
+            const Float weight = dot(pivot, transformation.real()) < 0.0f ? -weights[i][j] : weights[i][j];
+            real += transformation.real()*weight;
+            dual += transformation.dual()*weight;
+        }
+
+        /* No influences at all gives back an identity */
+        if(!influenceCount) {
+            dst[i] = DualQuaternion<Float>{};
+            continue;
+        }
+
+        const Float length = real.length();
+        dst[i] = DualQuaternion<Float>{real/length, dual/length};
+    }
+}
+
+void transformPointsInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& transformations, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    CORRADE_ASSERT(transformations.size() == src.size(),
+        "Math::transformPointsInto(): expected" << src.size() << "transformations but got" << transformations.size(), );
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::transformPointsInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    for(std::size_t i = 0; i != src.size(); ++i) {
+        const Quaternion<Float> real = transformations[i].real();
+        const Quaternion<Float> dual = transformations[i].dual();
+        const Vector3<Float> point = src[i];
+
+        /* Rotation by the real part, same as in
+           Quaternion::transformVectorNormalized(), followed by the
+           translation */
+        const Vector3<Float> t = 2.0f*cross(real.vector(), point);
+        dst[i] = point + real.scalar()*t + cross(real.vector(), t) + translation(real, dual);
+    }
+}
+
+}}
@@ -0,0 +1,220 @@
+#ifndef Magnum_Math_TransformBatch_h
+#define Magnum_Math_TransformBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Functions @ref Magnum::Math::multiplyInto(), @ref Magnum::Math::transformPointsInto(), @ref Magnum::Math::transformVectorsInto(), @ref Magnum::Math::invertedInto(), @ref Magnum::Math::toMatrixInto(), @ref Magnum::Math::blendInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@{ @name Batch transformation functions
+
+These functions process an unbounded range of matrices, quaternions or
+points, as opposed to single values. On x86 the matrix operations use SSE2
+and NEON on ARM if the target supports it. Matrix multiplication and point
+transformation additionally have an AVX2 code path on x86, which is picked at
+runtime if the CPU supports it.
+
+The output view is allowed to point to the same memory as the input in all
+functions except for the following:
+
+-   @ref toMatrixInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>&, const Corrade::Containers::StridedArrayView1D<Matrix3x3<Float>>&)
+    and @ref toMatrixInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>&, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>&),
+    where the output element is larger than the input one, so writing it
+    would overwrite inputs that weren't read yet. Overlap is checked with an
+    assertion.
+-   @ref blendInto(), where the destination can't alias the transformations
+    as each of them may be read for any output
+*/
+
+/**
+@brief Multiply matrices
+@param[in]  a       Left-hand side matrices
+@param[in]  b       Right-hand side matrices
+@param[out] dst     Destination matrices
+@m_since_latest
+
+Equivalent to calculating @cpp a[i]*b[i] @ce for all elements, with the same
+result. Expects that all views have the same size.
+@see @ref Matrix4::operator*()
+*/
+MAGNUM_EXPORT void multiplyInto(const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst);
+
+/**
+@brief Multiply matrices by a common matrix
+@param[in]  a       Left-hand side matrix
+@param[in]  b       Right-hand side matrices
+@param[out] dst     Destination matrices
+@m_since_latest
+
+Equivalent to calculating @cpp a*b[i] @ce for all elements, with the same
+result. Useful for example for applying a parent transformation to a list of
+children. Expects that @p b and @p dst have the same size.
+*/
+MAGNUM_EXPORT void multiplyInto(const Matrix4<Float>& a, const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst);
+
+/**
+@brief Transform points with a matrix
+@param[in]  matrix  Transformation matrix
+@param[in]  src     Source points
+@param[out] dst     Destination points
+@m_since_latest
+
+Equivalent to calculating @cpp matrix.transformPoint(src[i]) @ce for all
+elements, with the same result. Expects that @p src and @p dst have the same
+size.
+@see @ref Matrix4::transformPoint()
+*/
+MAGNUM_EXPORT void transformPointsInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst);
+
+/**
+@brief Transform vectors with a matrix
+@param[in]  matrix  Transformation matrix
+@param[in]  src     Source vectors
+@param[out] dst     Destination vectors
+@m_since_latest
+
+Equivalent to calculating @cpp matrix.transformVector(src[i]) @ce for all
+elements. Expects that @p src and @p dst have the same size.
+@see @ref Matrix4::transformVector()
+*/
+MAGNUM_EXPORT void transformVectorsInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst);
+
+/**
+@brief Invert matrices
+@param[in]  src     Source matrices
+@param[out] dst     Destination matrices
+@m_since_latest
+
+Equivalent to calculating @cpp src[i].inverted() @ce for all elements, but
+sharing 2x2 subdeterminants between the cofactors and inverting several
+matrices at once in SIMD registers. Inverting a singular matrix results in
+infinities or NaNs. Expects that @p src and @p dst have the same size.
+@see @ref Matrix::inverted(), @ref Matrix4::invertedRigid()
+*/
+MAGNUM_EXPORT void invertedInto(const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& src, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst);
+
+/**
+@brief Invert 3x3 matrices
+@param[in]  src     Source matrices
+@param[out] dst     Destination matrices
+@m_since_latest
+
+Equivalent to calculating @cpp src[i].inverted() @ce for all elements, with
+the result being the same as @ref Matrix::inverted(). Inverting a singular
+matrix results in infinities or NaNs. Expects that @p src and @p dst have the
+same size.
+*/
+MAGNUM_EXPORT void invertedInto(const Corrade::Containers::StridedArrayView1D<const Matrix3x3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Matrix3x3<Float>>& dst);
+
+/**
+@brief Convert quaternions to rotation matrices
+@param[in]  src     Source quaternions
+@param[out] dst     Destination matrices
+@m_since_latest
+
+Equivalent to calculating @cpp src[i].toMatrix() @ce for all elements, with
+the same result. Expects that @p src and @p dst have the same size and don't
+overlap.
+@see @ref Quaternion::toMatrix()
+*/
+MAGNUM_EXPORT void toMatrixInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<Matrix3x3<Float>>& dst);
+
+/**
+@brief Convert dual quaternions to transformation matrices
+@param[in]  src     Source dual quaternions
+@param[out] dst     Destination matrices
+@m_since_latest
+
+Equivalent to calculating @cpp src[i].toMatrix() @ce for all elements.
+Expects that @p src and @p dst have the same size and don't overlap.
+@see @ref DualQuaternion::toMatrix()
+*/
+MAGNUM_EXPORT void toMatrixInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst);
+
+/**
+@brief Blend dual quaternions
+@param[in]  transformations Transformations to blend, such as joint
+    transformations of a skin
+@param[in]  ids             Transformation IDs for each output
+@param[in]  weights         Transformation weights for each output
+@param[out] dst             Destination dual quaternions
+@m_since_latest
+
+Performs dual quaternion linear blending, the first step of dual quaternion
+skinning. For each output @f$ i @f$, the transformations @f$ \hat q_{ij} @f$
+referenced by @cpp ids[i][j] @ce are multiplied by @cpp weights[i][j] @ce,
+summed and normalized: @f[
+    \hat q_i = \frac{\sum_j s_{ij} w_{ij} \hat q_{ij}}{|\sum_j s_{ij} w_{ij} q_{ij}|}
+@f]
+
+Where @f$ q_{ij} @f$ is the real part of @f$ \hat q_{ij} @f$ and the sign
+@f$ s_{ij} @f$ is @f$ -1 @f$ if @f$ q_{ij} @f$ lies in the opposite hemisphere
+than @f$ q_{i0} @f$ and @f$ 1 @f$ otherwise, so the blending always follows
+the shortest path. Use @ref transformPointsInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>&, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>&, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>&)
+to apply the result to vertex positions. Expects that @p ids and @p weights
+have the same size, that their first dimension has the same size as @p dst
+and that all IDs are less than size of @p transformations. Unused influences
+can be given a zero weight.
+
+Algorithm used: *Ladislav Kavan, Steven Collins, Jiri Zara, Carol O'Sullivan
+-- Skinning with Dual Quaternions, 2007,
+https://www.cs.utah.edu/~ladislav/kavan07skinning/kavan07skinning.pdf*
+*/
+MAGNUM_EXPORT void blendInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& transformations, const Corrade::Containers::StridedArrayView2D<const UnsignedInt>& ids, const Corrade::Containers::StridedArrayView2D<const Float>& weights, const Corrade::Containers::StridedArrayView1D<DualQuaternion<Float>>& dst);
+
+/**
+@brief Transform points with dual quaternions
+@param[in]  transformations Per-point transformations
+@param[in]  src             Source points
+@param[out] dst             Destination points
+@m_since_latest
+
+Equivalent to calculating
+@cpp transformations[i].transformPointNormalized(src[i]) @ce for all
+elements, but without checking that the dual quaternions are normalized.
+Expects that all views have the same size.
+@see @ref DualQuaternion::transformPointNormalized(), @ref blendInto()
+*/
+MAGNUM_EXPORT void transformPointsInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& transformations, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst);
+
+/* Since 1.8.17, the original short-hand group closing doesn't work anymore.
+   FFS. */
+/**
+ * @}
+ */
+
+}}
+
+#endif
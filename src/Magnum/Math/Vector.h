@@ -84,6 +84,7 @@ namespace Implementation {
 
     /* Used to make friends to speed up debug builds */
     template<std::size_t, class> struct MatrixDeterminant;
+    template<std::size_t, class> struct MatrixInverted;
     /* To make gather() / scatter() faster */
     template<std::size_t, std::size_t> struct GatherComponentAt;
     template<std::size_t, std::size_t, bool> struct ScatterComponentOr;
@@ -675,10 +676,11 @@ template<std::size_t size, class T> class Vector {
 
     private:
         template<std::size_t, class> friend class Vector;
-        /* These three needed to access _data to speed up debug builds */
+        /* These four needed to access _data to speed up debug builds */
         template<std::size_t, std::size_t, class> friend class RectangularMatrix;
         template<std::size_t, class> friend class Matrix;
         template<std::size_t, class> friend struct Implementation::MatrixDeterminant;
+        template<std::size_t, class> friend struct Implementation::MatrixInverted;
         /* To make gather() / scatter() faster */
         template<std::size_t, std::size_t> friend struct Implementation::GatherComponentAt;
         template<std::size_t, std::size_t, bool> friend struct Implementation::ScatterComponentOr;
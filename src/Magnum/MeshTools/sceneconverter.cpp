@@ -24,10 +24,18 @@
 */
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <functional>
+#include <mutex>
 #include <set>
 #include <sstream>
+#include <thread>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/PluginManager/PluginMetadata.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
@@ -37,6 +45,7 @@
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Implementation/converterUtilities.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/FunctionsBatch.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/Trade/AbstractImporter.h"
@@ -46,8 +55,13 @@
 #include "Magnum/Trade/MeshObjectData3D.h"
 #include "Magnum/Trade/TextureData.h"
 #include "Magnum/Trade/AbstractSceneConverter.h"
+#include "Magnum/Trade/Implementation/anyConverterPlugins.h"
 #include "Magnum/Trade/Implementation/converterUtilities.h"
 
+#ifdef CORRADE_TARGET_UNIX
+#include <time.h>
+#endif
+
 namespace Magnum {
 
 /** @page magnum-sceneconverter Scene conversion utility
@@ -79,8 +93,8 @@ magnum-sceneconverter [-h|--help] [-I|--importer IMPORTER]
     [--remove-duplicates-fuzzy EPSILON]
     [-i|--importer-options key=val,key2=val2,…]
     [-c|--converter-options key=val,key2=val2,…]... [--mesh MESH]
-    [--level LEVEL] [--info] [--bounds] [-v|--verbose] [--profile]
-    [--] input output
+    [--level LEVEL] [--all-meshes] [--threads N] [--info] [--bounds]
+    [-v|--verbose] [--profile] [--] input output
 @endcode
 
 Arguments:
@@ -105,10 +119,15 @@ Arguments:
     to pass to the converter(s)
 -   `--mesh MESH` --- mesh to import (default: `0`)
 -   `--level LEVEL` --- mesh level to import (default: `0`)
+-   `--all-meshes` --- process all meshes and levels in parallel instead of
+    just `--mesh` and `--level`
+-   `--threads N` --- number of worker threads with `--all-meshes` (default:
+    `0`, which means the number of hardware threads)
 -   `--info` --- print info about the input file and exit
 -   `--bounds` --- show bounds of known attributes in `--info` output
 -   `-v`, `--verbose` --- verbose output from importer and converter plugins
--   `--profile` --- measure import and conversion time
+-   `--profile` --- measure import and conversion time, with `--all-meshes`
+    wall and CPU time of each processing stage of each mesh
 
 If `--info` is given, the utility will print information about all lights,
 materials, meshes, images and textures present in the file.
@@ -130,6 +149,27 @@ doesn't support conversion to a file,
 if no `-C` / `--converter` is specified,
 @ref Trade::AnySceneConverter "AnySceneConverter" is used.
 
+@subsection magnum-sceneconverter-usage-all-meshes Processing all meshes
+
+With `--all-meshes`, all meshes and all their levels are imported and
+processed in parallel on `--threads` worker threads. Each thread has its own
+importer and converter instances, with the input file opened separately for
+each of them before the processing starts. When saving to separate files with
+@ref Trade::AnySceneConverter "AnySceneConverter", the concrete converter
+plugin is picked from the output filename extension upfront and each thread
+gets its own instance of it. If the output filename contains
+`{mesh}`, each mesh is saved to a separate file, with `{mesh}` and `{level}`
+replaced with the mesh ID and level; `{level}` is required if any mesh has
+more than one level. Otherwise the output has to be a Magnum blob (`*.blob`),
+all converters in the chain have to support
+@ref Trade::SceneConverterFeature::ConvertMesh and the meshes get put into the
+blob in their original order, with each level as a separate mesh. Such blob
+can be then imported with @ref Trade::MagnumImporter "MagnumImporter".
+
+With `--profile`, wall and CPU time of each processing stage is printed for
+each mesh, followed by a total. The per-thread CPU time is measured only on
+Unix platforms.
+
 @section magnum-sceneconverter-example Example usage
 
 Printing info about all meshes in a glTF file:
@@ -156,6 +196,15 @@ the processing stats:
 magnum-sceneconverter chair.obj --converter MeshOptimizerSceneConverter -c simplify=true,simplifyTargetIndexCountThreshold=0.5 chair.ply -v
 @endcode
 
+Optimizing all meshes of a glTF file on all available cores and putting them
+into a single Magnum blob, printing time spent in each stage:
+
+@m_class{m-console-wrap}
+
+@code{.sh}
+magnum-sceneconverter scene.gltf --all-meshes --converter MeshOptimizerSceneConverter scene.blob --profile
+@endcode
+
 @see @ref magnum-imageconverter
 */
 
@@ -177,6 +226,337 @@ struct Duration {
         std::chrono::high_resolution_clock::time_point _t;
 };
 
+Float seconds(const std::chrono::nanoseconds duration) {
+    return UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count())/1.0e3f;
+}
+
+/* CPU time spent by the calling thread, zero on platforms where it can't be
+   queried */
+std::chrono::nanoseconds threadCpuTime() {
+    #ifdef CORRADE_TARGET_UNIX
+    timespec t;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+    return std::chrono::seconds{t.tv_sec} + std::chrono::nanoseconds{t.tv_nsec};
+    #else
+    return {};
+    #endif
+}
+
+/* Wall and CPU time spent in a single processing stage of a mesh */
+struct Stage {
+    std::string name;
+    std::chrono::nanoseconds wallTime, cpuTime;
+};
+
+struct StageDuration {
+    explicit StageDuration(Containers::Array<Stage>& output, std::string name): _output(output), _name{std::move(name)}, _wallTime{std::chrono::high_resolution_clock::now()}, _cpuTime{threadCpuTime()} {}
+
+    ~StageDuration() {
+        arrayAppend(_output, Stage{std::move(_name),
+            std::chrono::high_resolution_clock::now() - _wallTime,
+            threadCpuTime() - _cpuTime});
+    }
+
+    private:
+        Containers::Array<Stage>& _output;
+        std::string _name;
+        std::chrono::high_resolution_clock::time_point _wallTime;
+        std::chrono::nanoseconds _cpuTime;
+};
+
+Trade::MeshData filterAttributes(Trade::MeshData&& mesh, const std::set<UnsignedInt>& only) {
+    Containers::Array<Trade::MeshAttributeData> attributes;
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        if(only.find(i) != only.end())
+            arrayAppend(attributes, mesh.attributeData(i));
+    }
+
+    const Trade::MeshIndexData indices{mesh.indices()};
+    const UnsignedInt vertexCount = mesh.vertexCount();
+    return Trade::MeshData{mesh.primitive(),
+        mesh.releaseIndexData(), indices,
+        mesh.releaseVertexData(), std::move(attributes),
+        vertexCount};
+}
+
+std::set<UnsignedInt> parseOnlyAttributes(const std::string& value) {
+    std::set<UnsignedInt> only;
+    for(const std::string& i: Utility::String::split(value, ' '))
+        only.insert(std::stoi(i));
+    return only;
+}
+
+/* A single mesh level processed with --all-meshes */
+struct MeshJob {
+    UnsignedInt mesh, level;
+    /* Used only if everything is saved into a single blob */
+    Containers::Array<char> serialized;
+    Containers::Array<Stage> stages;
+    bool succeeded;
+};
+
+struct MeshWorker {
+    Containers::Pointer<Trade::AbstractImporter> importer;
+    Containers::Array<Containers::Pointer<Trade::AbstractSceneConverter>> converters;
+    /* Used only if each mesh is saved into a separate file */
+    Containers::Pointer<Trade::AbstractSceneConverter> fileConverter;
+};
+
+std::string meshOutputFilename(const std::string& pattern, const MeshJob& job) {
+    return Utility::String::replaceAll(
+        Utility::String::replaceAll(pattern, "{mesh}", std::to_string(job.mesh)),
+        "{level}", std::to_string(job.level));
+}
+
+bool processMesh(MeshWorker& worker, MeshJob& job, const Utility::Arguments& args, std::mutex& outputMutex) {
+    Containers::Optional<Trade::MeshData> mesh;
+    {
+        StageDuration d{job.stages, "import"};
+        if(!(mesh = worker.importer->mesh(job.mesh, job.level))) {
+            std::lock_guard<std::mutex> lock{outputMutex};
+            Error{} << "Cannot import mesh" << job.mesh << "level" << job.level;
+            return false;
+        }
+    }
+
+    if(!args.value("only-attributes").empty())
+        mesh = filterAttributes(*std::move(mesh), parseOnlyAttributes(args.value("only-attributes")));
+
+    if(args.isSet("remove-duplicates")) {
+        const UnsignedInt beforeVertexCount = mesh->vertexCount();
+        {
+            StageDuration d{job.stages, "remove-duplicates"};
+            mesh = MeshTools::removeDuplicates(*std::move(mesh));
+        }
+        if(args.isSet("verbose")) {
+            std::lock_guard<std::mutex> lock{outputMutex};
+            Debug{} << "Mesh" << job.mesh << "level" << job.level << "duplicate removal:" << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
+        }
+    }
+
+    if(!args.value("remove-duplicates-fuzzy").empty()) {
+        const UnsignedInt beforeVertexCount = mesh->vertexCount();
+        {
+            StageDuration d{job.stages, "remove-duplicates-fuzzy"};
+            mesh = MeshTools::removeDuplicatesFuzzy(*std::move(mesh), args.value<Float>("remove-duplicates-fuzzy"));
+        }
+        if(args.isSet("verbose")) {
+            std::lock_guard<std::mutex> lock{outputMutex};
+            Debug{} << "Mesh" << job.mesh << "level" << job.level << "fuzzy duplicate removal:" << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
+        }
+    }
+
+    for(Containers::Pointer<Trade::AbstractSceneConverter>& converter: worker.converters) {
+        StageDuration d{job.stages, converter->plugin()};
+        if(!(mesh = converter->convert(*mesh))) {
+            std::lock_guard<std::mutex> lock{outputMutex};
+            Error{} << converter->plugin() << "cannot convert mesh" << job.mesh << "level" << job.level;
+            return false;
+        }
+    }
+
+    if(worker.fileConverter) {
+        StageDuration d{job.stages, "save"};
+        const std::string filename = meshOutputFilename(args.value("output"), job);
+        if(!worker.fileConverter->convertToFile(filename, *mesh)) {
+            std::lock_guard<std::mutex> lock{outputMutex};
+            Error{} << "Cannot save file" << filename;
+            return false;
+        }
+    } else {
+        StageDuration d{job.stages, "serialize"};
+        job.serialized = mesh->serialize();
+    }
+
+    return true;
+}
+
+int convertAllMeshes(const Utility::Arguments& args, PluginManager::Manager<Trade::AbstractImporter>& importerManager, Containers::Pointer<Trade::AbstractImporter>&& importer) {
+    /* Without {mesh} in the filename, everything goes into a single blob */
+    const std::string& output = args.value("output");
+    const bool separateFiles = output.find("{mesh}") != std::string::npos;
+    if(!separateFiles && !Utility::String::endsWith(Utility::String::lowercase(output), ".blob")) {
+        Error{} << "Output" << output << "has to be either a *.blob file or contain {mesh} to save all meshes";
+        return 8;
+    }
+
+    /* Gather all mesh levels first so the output can be in the original order
+       independently of which thread finishes first */
+    Containers::Array<MeshJob> jobs;
+    for(UnsignedInt i = 0; i != importer->meshCount(); ++i) {
+        const UnsignedInt levelCount = importer->meshLevelCount(i);
+        if(separateFiles && levelCount > 1 && output.find("{level}") == std::string::npos) {
+            Error{} << "Mesh" << i << "has" << levelCount << "levels but output" << output << "doesn't contain {level}";
+            return 8;
+        }
+        for(UnsignedInt j = 0; j != levelCount; ++j)
+            arrayAppend(jobs, MeshJob{i, j, {}, {}, false});
+    }
+    if(jobs.empty()) {
+        Error{} << "No meshes found in" << args.value("input");
+        return 4;
+    }
+
+    /* No point in having more threads than meshes */
+    std::size_t threadCount = args.value<UnsignedInt>("threads");
+    if(!threadCount) threadCount = std::thread::hardware_concurrency();
+    threadCount = Math::max(Math::min(threadCount, jobs.size()), std::size_t{1});
+
+    /* Plugin managers aren't thread-safe, so create all instances upfront.
+       The first worker reuses the already opened importer, the others open
+       the file here as well, since importers such as AnySceneImporter load
+       and instantiate the concrete plugin in openFile(). */
+    PluginManager::Manager<Trade::AbstractSceneConverter> converterManager{
+        args.value("plugin-dir").empty() ? std::string{} :
+        Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractSceneConverter::pluginSearchPaths()[0])};
+    Containers::Array<MeshWorker> workers{threadCount};
+    for(std::size_t w = 0; w != workers.size(); ++w) {
+        MeshWorker& worker = workers[w];
+        if(w == 0) worker.importer = std::move(importer);
+        else {
+            worker.importer = importerManager.instantiate(args.value("importer"));
+            if(args.isSet("verbose")) worker.importer->setFlags(Trade::ImporterFlag::Verbose);
+            Implementation::setOptions(*worker.importer, args.value("importer-options"));
+            if(!worker.importer->openFile(args.value("input"))) {
+                Error{} << "Cannot open file" << args.value("input");
+                return 3;
+            }
+        }
+
+        /* Same chaining logic as when processing a single mesh, except that
+           without {mesh} in the output the meshes are serialized directly
+           instead of going through AnySceneConverter */
+        for(std::size_t i = 0, converterCount = args.arrayValueCount("converter"); i <= converterCount; ++i) {
+            if(i == converterCount && !separateFiles) break;
+
+            const std::string converterName = i == converterCount ?
+                "AnySceneConverter" : args.arrayValue("converter", i);
+            Containers::Pointer<Trade::AbstractSceneConverter> converter = converterManager.loadAndInstantiate(converterName);
+            if(!converter) {
+                Debug{} << "Available converter plugins:" << Utility::String::join(converterManager.aliasList(), ", ");
+                return 2;
+            }
+
+            if(args.isSet("verbose")) converter->setFlags(Trade::SceneConverterFlag::Verbose);
+            if(i < args.arrayValueCount("converter-options"))
+                Implementation::setOptions(*converter, args.arrayValue("converter-options", i));
+
+            if(separateFiles && i + 1 >= converterCount && (converter->features() & Trade::SceneConverterFeature::ConvertMeshToFile)) {
+                /* AnySceneConverter would load and instantiate the concrete
+                   plugin from the shared manager on every save, so pick it
+                   here from the output extension instead, which is the same
+                   for all meshes, and give each worker its own instance */
+                if(converter->metadata() && converter->metadata()->name() == "AnySceneConverter") {
+                    const std::string plugin = Trade::Implementation::anySceneConverterPlugin(output);
+                    if(plugin.empty()) {
+                        Error{} << "Cannot determine the format of" << output;
+                        return 8;
+                    }
+
+                    Containers::Pointer<Trade::AbstractSceneConverter> concrete = converterManager.loadAndInstantiate(plugin);
+                    if(!concrete) {
+                        Error{} << "Cannot load the" << plugin << "plugin";
+                        return 2;
+                    }
+                    if(!(concrete->features() & Trade::SceneConverterFeature::ConvertMeshToFile)) {
+                        Error{} << plugin << "doesn't support mesh conversion to a file, only" << concrete->features();
+                        return 6;
+                    }
+
+                    /* Same as AnySceneConverter, only flags are propagated */
+                    concrete->setFlags(converter->flags());
+                    converter = std::move(concrete);
+                }
+
+                worker.fileConverter = std::move(converter);
+                break;
+            }
+
+            if(!(converter->features() & Trade::SceneConverterFeature::ConvertMesh)) {
+                Error{} << converterName << "doesn't support mesh conversion, only" << converter->features();
+                return 6;
+            }
+
+            arrayAppend(worker.converters, std::move(converter));
+        }
+    }
+
+    /* Workers pick the next mesh from a shared counter, so a few large meshes
+       don't stall the others */
+    std::atomic<std::size_t> next{0};
+    std::mutex outputMutex;
+    auto work = [&](MeshWorker& worker) {
+        for(std::size_t i; (i = next++) < jobs.size(); )
+            jobs[i].succeeded = processMesh(worker, jobs[i], args, outputMutex);
+    };
+
+    std::chrono::high_resolution_clock::duration totalTime{};
+    {
+        Duration d{totalTime};
+
+        /* The first worker runs on the main thread */
+        std::vector<std::thread> threads;
+        for(std::size_t i = 1; i != workers.size(); ++i)
+            threads.emplace_back(work, std::ref(workers[i]));
+        work(workers[0]);
+        for(std::thread& thread: threads) thread.join();
+    }
+
+    std::size_t failed = 0;
+    for(const MeshJob& job: jobs) if(!job.succeeded) ++failed;
+
+    /* Concatenate the serialized meshes in the original order. Serialized
+       chunks are all padded to a multiple of 8 bytes, so this keeps all of
+       them aligned. */
+    if(!failed && !separateFiles) {
+        std::size_t size = 0;
+        for(const MeshJob& job: jobs) size += job.serialized.size();
+        Containers::Array<char> blob{Containers::NoInit, size};
+        std::size_t offset = 0;
+        for(const MeshJob& job: jobs) {
+            Utility::copy(job.serialized, blob.slice(offset, offset + job.serialized.size()));
+            offset += job.serialized.size();
+        }
+
+        if(!Utility::Directory::write(output, blob)) {
+            Error{} << "Cannot save file" << output;
+            return 5;
+        }
+    }
+
+    if(args.isSet("profile")) {
+        std::chrono::nanoseconds totalWallTime{}, totalCpuTime{};
+        for(const MeshJob& job: jobs) {
+            Debug d;
+            d << "Mesh" << job.mesh << "level" << job.level << Debug::nospace << ":";
+            for(std::size_t i = 0; i != job.stages.size(); ++i) {
+                const Stage& stage = job.stages[i];
+                if(i) d << Debug::nospace << ",";
+                d << stage.name << seconds(stage.wallTime) << "s";
+                #ifdef CORRADE_TARGET_UNIX
+                d << Debug::nospace << "/" << Debug::nospace << seconds(stage.cpuTime) << "s CPU";
+                #endif
+                totalWallTime += stage.wallTime;
+                totalCpuTime += stage.cpuTime;
+            }
+        }
+
+        Debug d;
+        d << "Processed" << jobs.size() << "meshes on" << workers.size() << "threads in" << seconds(totalTime) << "seconds, stages took" << seconds(totalWallTime) << "seconds";
+        #ifdef CORRADE_TARGET_UNIX
+        d << "and" << seconds(totalCpuTime) << "seconds of CPU time";
+        #endif
+        d << "in total";
+    }
+
+    if(failed) {
+        Error{} << "Failed to process" << failed << "out of" << jobs.size() << "meshes";
+        return 7;
+    }
+
+    return 0;
+}
+
 /** @todo const Array& doesn't work, minmax() would fail to match */
 template<class T> std::string calculateBounds(Containers::Array<T>&& attribute) {
     /** @todo clean up when Debug::toString() exists */
@@ -210,6 +590,8 @@ int main(int argc, char** argv) {
         .addArrayOption('c', "converter-options").setHelp("converter-options", "configuration options to pass to the converter(s)", "key=val,key2=val2,…")
         .addOption("mesh", "0").setHelp("mesh", "mesh to import")
         .addOption("level", "0").setHelp("level", "mesh level to import")
+        .addBooleanOption("all-meshes").setHelp("all-meshes", "process all meshes and levels in parallel instead of just --mesh and --level")
+        .addOption("threads", "0").setHelp("threads", "number of worker threads with --all-meshes, 0 means the number of hardware threads", "N")
         .addBooleanOption("info").setHelp("info", "print info about the input file and exit")
         .addBooleanOption("bounds").setHelp("bounds", "show bounds of known attributes in --info output")
         .addBooleanOption('v', "verbose").setHelp("verbose", "verbose output from importer and converter plugins")
@@ -238,7 +620,13 @@ together. All converters in the chain have to support the ConvertMesh feature,
 the last converter either ConvertMesh or ConvertMeshToFile. If the last
 converter doesn't support conversion to a file, AnySceneConverter is used to
 save its output; if no -C / --converter is specified, AnySceneConverter is
-used.)")
+used.
+
+With --all-meshes, all meshes and levels are processed in parallel on --threads
+worker threads. If the output contains {mesh}, each mesh is saved to a separate
+file, with {mesh} and {level} replaced with the mesh ID and level. Otherwise
+the output has to be a *.blob file and the meshes are put into it in their
+original order.)")
         .parse(argc, argv);
 
     PluginManager::Manager<Trade::AbstractImporter> importerManager{
@@ -255,7 +643,7 @@ used.)")
     if(args.isSet("verbose")) importer->setFlags(Trade::ImporterFlag::Verbose);
     Implementation::setOptions(*importer, args.value("importer-options"));
 
-    std::chrono::high_resolution_clock::duration importTime;
+    std::chrono::high_resolution_clock::duration importTime{};
 
     /* Open the file */
     {
@@ -683,6 +1071,13 @@ used.)")
         return error ? 1 : 0;
     }
 
+    /* Process all meshes, if requested */
+    if(args.isSet("all-meshes")) {
+        if(args.isSet("profile"))
+            Debug{} << "Opening the file took" << seconds(importTime) << "seconds";
+        return convertAllMeshes(args, importerManager, std::move(importer));
+    }
+
     Containers::Optional<Trade::MeshData> mesh;
     {
         Duration d{importTime};
@@ -692,27 +1087,11 @@ used.)")
         }
     }
 
-    std::chrono::high_resolution_clock::duration conversionTime;
+    std::chrono::high_resolution_clock::duration conversionTime{};
 
     /* Filter attributes, if requested */
-    if(!args.value("only-attributes").empty()) {
-        std::set<UnsignedInt> only;
-        for(const std::string& i: Utility::String::split(args.value("only-attributes"), ' '))
-            only.insert(std::stoi(i));
-
-        Containers::Array<Trade::MeshAttributeData> attributes;
-        for(UnsignedInt i = 0; i != mesh->attributeCount(); ++i) {
-            if(only.find(i) != only.end())
-                arrayAppend(attributes, mesh->attributeData(i));
-        }
-
-        const Trade::MeshIndexData indices{mesh->indices()};
-        const UnsignedInt vertexCount = mesh->vertexCount();
-        mesh = Trade::MeshData{mesh->primitive(),
-            mesh->releaseIndexData(), indices,
-            mesh->releaseVertexData(), std::move(attributes),
-            vertexCount};
-    }
+    if(!args.value("only-attributes").empty())
+        mesh = filterAttributes(*std::move(mesh), parseOnlyAttributes(args.value("only-attributes")));
 
     /* Remove duplicates, if requested */
     if(args.isSet("remove-duplicates")) {
@@ -0,0 +1,159 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PixelFormatConversion.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Implementation/pixelFormatConversion.hpp"
+
+namespace Magnum {
+
+Debug& operator<<(Debug& debug, const PixelFormatConversionFlag value) {
+    debug << "PixelFormatConversionFlag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case PixelFormatConversionFlag::v: return debug << "::" #v;
+        _c(SwapRedBlue)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const PixelFormatConversionFlags value) {
+    return Containers::enumSetDebugOutput(debug, value, "PixelFormatConversionFlags{}", {
+        PixelFormatConversionFlag::SwapRedBlue});
+}
+
+void convertPixelFormatInto(const ImageView2D& source, const MutableImageView2D& destination, const PixelFormatConversionFlags flags) {
+    CORRADE_ASSERT(!isPixelFormatImplementationSpecific(source.format()),
+        "convertPixelFormatInto(): can't convert from an implementation-specific format" << reinterpret_cast<void*>(pixelFormatUnwrap(source.format())), );
+    CORRADE_ASSERT(!isPixelFormatImplementationSpecific(destination.format()),
+        "convertPixelFormatInto(): can't convert to an implementation-specific format" << reinterpret_cast<void*>(pixelFormatUnwrap(destination.format())), );
+    CORRADE_ASSERT(source.size() == destination.size(),
+        "convertPixelFormatInto(): expected destination size" << source.size() << "but got" << destination.size(), );
+
+    const Implementation::PixelFormatInfo sourceInfo = Implementation::pixelFormatInfo(source.format());
+    const Implementation::PixelFormatInfo destinationInfo = Implementation::pixelFormatInfo(destination.format());
+    const bool swapRedBlue = !!(flags & PixelFormatConversionFlag::SwapRedBlue);
+    CORRADE_ASSERT(!swapRedBlue || sourceInfo.channelCount >= 3,
+        "convertPixelFormatInto(): can't swap red and blue channels of" << source.format(), );
+
+    const std::size_t width = source.size().x();
+    const std::size_t height = source.size().y();
+    if(!width || !height) return;
+
+    const Containers::StridedArrayView3D<const char> sourcePixels = source.pixels();
+    const Containers::StridedArrayView3D<char> destinationPixels = destination.pixels();
+
+    /* Same format, plain copy */
+    if(source.format() == destination.format() && !swapRedBlue) {
+        if(sourcePixels.data() != destinationPixels.data())
+            Utility::copy(sourcePixels, destinationPixels);
+        return;
+    }
+
+    Byte mapping[4];
+    Implementation::pixelChannelMapping(sourceInfo.channelCount, destinationInfo.channelCount, swapRedBlue, mapping);
+
+    /* Same component type, shuffle the bit representation */
+    if(sourceInfo.type == destinationInfo.type && sourceInfo.componentSize == destinationInfo.componentSize) {
+        const UnsignedInt one = Implementation::pixelComponentOne(destinationInfo);
+        for(std::size_t y = 0; y != height; ++y) {
+            const void* const src = sourcePixels[y].data();
+            void* const dst = destinationPixels[y].data();
+            if(sourceInfo.componentSize == 1)
+                Implementation::remapPixelRow8(static_cast<const UnsignedByte*>(src), static_cast<UnsignedByte*>(dst), width, sourceInfo.channelCount, destinationInfo.channelCount, mapping, UnsignedByte(one));
+            else if(sourceInfo.componentSize == 2)
+                Implementation::remapPixelRowScalar(static_cast<const UnsignedShort*>(src), static_cast<UnsignedShort*>(dst), width, sourceInfo.channelCount, destinationInfo.channelCount, mapping, UnsignedShort(one));
+            else
+                Implementation::remapPixelRowScalar(static_cast<const UnsignedInt*>(src), static_cast<UnsignedInt*>(dst), width, sourceInfo.channelCount, destinationInfo.channelCount, mapping, one);
+        }
+        return;
+    }
+
+    const bool remap = swapRedBlue || sourceInfo.channelCount != destinationInfo.channelCount;
+
+    /* Integer formats of different types or sizes go through 64-bit integers,
+       as floats can't represent values above 2^24 exactly */
+    if(Implementation::isIntegerPixelComponentType(sourceInfo.type) && Implementation::isIntegerPixelComponentType(destinationInfo.type)) {
+        Containers::Array<Long> decoded{Containers::NoInit, width*sourceInfo.channelCount};
+        Containers::Array<Long> remapped;
+        if(remap) remapped = Containers::Array<Long>{Containers::NoInit, width*destinationInfo.channelCount};
+        for(std::size_t y = 0; y != height; ++y) {
+            Implementation::decodeIntegerPixelRow(sourceInfo, sourcePixels[y], decoded);
+            if(remap) {
+                Implementation::remapPixelRowScalar(decoded.data(), remapped.data(), width, sourceInfo.channelCount, destinationInfo.channelCount, mapping, Long{1});
+                Implementation::encodeIntegerPixelRow(destinationInfo, remapped, destinationPixels[y]);
+            } else Implementation::encodeIntegerPixelRow(destinationInfo, decoded, destinationPixels[y]);
+        }
+        return;
+    }
+
+    /* A float destination with the same channels, decode directly into it */
+    if(destinationInfo.type == Implementation::PixelComponentType::Float && !remap) {
+        for(std::size_t y = 0; y != height; ++y)
+            Implementation::decodePixelRow(sourceInfo, sourcePixels[y], Containers::arrayCast<2, Float>(destinationPixels[y]));
+        return;
+    }
+
+    /* Everything else goes through floats, with the channels remapped there
+       if needed */
+    Containers::Array<Float> decoded{Containers::NoInit, width*sourceInfo.channelCount};
+    Containers::Array<Float> remapped;
+    if(remap) remapped = Containers::Array<Float>{Containers::NoInit, width*destinationInfo.channelCount};
+    const Containers::StridedArrayView2D<Float> decodedView{decoded, {width, sourceInfo.channelCount}};
+    for(std::size_t y = 0; y != height; ++y) {
+        Implementation::decodePixelRow(sourceInfo, sourcePixels[y], decodedView);
+        if(remap) {
+            Implementation::remapPixelRowScalar(decoded.data(), remapped.data(), width, sourceInfo.channelCount, destinationInfo.channelCount, mapping, 1.0f);
+            Implementation::encodePixelRow(destinationInfo, remapped, destinationPixels[y]);
+        } else Implementation::encodePixelRow(destinationInfo, decoded, destinationPixels[y]);
+    }
+}
+
+Image2D convertPixelFormat(const ImageView2D& source, const PixelFormat format, const PixelFormatConversionFlags flags) {
+    CORRADE_ASSERT(!isPixelFormatImplementationSpecific(format),
+        "convertPixelFormat(): can't convert to an implementation-specific format" << reinterpret_cast<void*>(pixelFormatUnwrap(format)), (Image2D{PixelFormat::R8Unorm}));
+
+    /* Default pixel storage has a four-byte row alignment */
+    const std::size_t rowSize = 4*((pixelSize(format)*source.size().x() + 3)/4);
+    Image2D out{format, source.size(), Containers::Array<char>{Containers::ValueInit, rowSize*source.size().y()}};
+    convertPixelFormatInto(source, out, flags);
+    return out;
+}
+
+}
@@ -0,0 +1,137 @@
+#ifndef Magnum_PixelFormatConversion_h
+#define Magnum_PixelFormatConversion_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Enum @ref Magnum::PixelFormatConversionFlag, enum set @ref Magnum::PixelFormatConversionFlags, function @ref Magnum::convertPixelFormatInto(), @ref Magnum::convertPixelFormat()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Pixel format conversion flag
+@m_since_latest
+
+@see @ref PixelFormatConversionFlags, @ref convertPixelFormatInto()
+*/
+enum class PixelFormatConversionFlag: UnsignedByte {
+    /**
+     * Swap the red and blue channel of the source, for converting from BGR
+     * and BGRA data. Expects that the source format has at least three
+     * channels.
+     */
+    SwapRedBlue = 1 << 0
+};
+
+/**
+@brief Pixel format conversion flags
+@m_since_latest
+
+@see @ref convertPixelFormatInto()
+*/
+typedef Containers::EnumSet<PixelFormatConversionFlag> PixelFormatConversionFlags;
+
+CORRADE_ENUMSET_OPERATORS(PixelFormatConversionFlags)
+
+/**
+@debugoperatorenum{PixelFormatConversionFlag}
+@m_since_latest
+*/
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, PixelFormatConversionFlag value);
+
+/**
+@debugoperatorenum{PixelFormatConversionFlags}
+@m_since_latest
+*/
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, PixelFormatConversionFlags value);
+
+/**
+@brief Convert pixels of an image to a different format
+@param source       Source image
+@param destination  Destination image
+@param flags        Flags
+@m_since_latest
+
+Converts every pixel of @p source to the format of @p destination. The pixel
+storage of both images is respected, so for example a tightly packed image can
+be converted to one with four-byte row alignment and vice versa. Channels are
+converted as follows:
+
+-   Channels present in both formats are converted by value, i.e. a normalized
+    value of @cpp 1.0f @ce stays @cpp 1.0f @ce and an integer
+    @cpp 5 @ce stays @cpp 5 @ce. sRGB formats are converted to and from linear
+    RGB, their alpha channel is linear.
+-   Normalized destination formats are clamped to their range, integral
+    destination formats are rounded to the nearest integer and clamped to the
+    range of the type.
+-   A single-channel source is broadcast to the red, green and blue channel of
+    the destination, for example to expand a grayscale image to RGBA.
+-   Other channels not present in the source are set to zero, except for
+    alpha, which is set to one.
+-   Channels not present in the destination are dropped.
+
+The conversion is done row by row and the implementation is picked once for
+every pair of formats. A plain copy is done for the same format; for formats
+differing only in the channel count the bit representation is shuffled
+directly, with 8-bit formats using SSE4.1 on x86 if the CPU supports it. If
+the destination is a 32-bit float format with the same channel count, the
+source is decoded directly into it. Conversions between integer formats of
+different types or sizes go through an intermediate 64-bit integer
+representation, so no precision is lost for values above @f$ 2^{24} @f$.
+Other pairs go through an intermediate 32-bit float representation. All
+conversions to and from floats use
+@ref Magnum/Math/PackingBatch.h and @ref Magnum/Math/ColorBatch.h and thus
+their SIMD implementations.
+
+Expects that @p source and @p destination have the same size and that neither
+of the formats is implementation-specific. If
+@ref PixelFormatConversionFlag::SwapRedBlue is set, expects that the source
+has at least three channels. The two views can point to the same memory only
+if the formats are the same or differ just by a swap of the red and blue
+channel.
+@see @ref isPixelFormatImplementationSpecific(), @ref pixelSize()
+*/
+MAGNUM_EXPORT void convertPixelFormatInto(const ImageView2D& source, const MutableImageView2D& destination, PixelFormatConversionFlags flags = {});
+
+/**
+@brief Convert an image to a different pixel format
+@m_since_latest
+
+Allocates an image of the same size as @p source in given @p format with
+default @ref PixelStorage and calls @ref convertPixelFormatInto() with it. See
+its documentation for more information.
+*/
+MAGNUM_EXPORT Image2D convertPixelFormat(const ImageView2D& source, PixelFormat format, PixelFormatConversionFlags flags = {});
+
+}
+
+#endif
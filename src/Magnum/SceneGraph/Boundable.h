@@ -0,0 +1,160 @@
+#ifndef Magnum_SceneGraph_Boundable_h
+#define Magnum_SceneGraph_Boundable_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BasicBoundable3D, typedef @ref Magnum::SceneGraph::Boundable3D
+ * @m_since_latest
+ */
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Boundable
+@m_since_latest
+
+Attaches an axis-aligned bounding box to an object and keeps the object
+registered in a @ref BasicSpatialIndex3D "SpatialIndex3D", which is then able
+to answer frustum, range, sphere, ray and nearest-neighbor queries without
+going through all objects in the scene.
+
+@section SceneGraph-Boundable-usage Usage
+
+The bounds are specified relative to the object, the feature then takes care
+of calculating their absolute (world-space) counterpart whenever the object
+transformation changes. Similarly to @ref Drawable, the feature can be either
+attached to an existing object or used via multiple inheritance:
+
+@snippet MagnumSceneGraph.cpp Boundable-usage
+
+The feature enables @ref CachedTransformation::Absolute, which means the index
+gets notified through @ref AbstractFeature::markDirty() every time
+@ref AbstractObject::setDirty() propagates to the object. Only objects that
+were marked as dirty are updated in @ref BasicSpatialIndex3D::update(), all
+other objects stay where they are in the index.
+
+@section SceneGraph-Boundable-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref Boundable.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref Boundable3D, @ref SpatialIndex3D
+
+@see @ref scenegraph, @ref Boundable3D, @ref BasicSpatialIndex3D
+*/
+template<class T> class BasicBoundable3D: public AbstractFeature<3, T> {
+    friend BasicSpatialIndex3D<T>;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object this boundable belongs to
+         * @param bounds    Bounds relative to the object
+         * @param index     Spatial index this boundable belongs to
+         *
+         * Adds the feature to the object and also to the index, if
+         * specified.
+         * @see @ref setBounds(), @ref BasicSpatialIndex3D::add()
+         */
+        explicit BasicBoundable3D(AbstractObject<3, T>& object, const Math::Range3D<T>& bounds, BasicSpatialIndex3D<T>* index = nullptr);
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /* This is here to avoid ambiguity with deleted copy constructor when
+           passing `*this` from class subclassing both BasicBoundable3D and
+           AbstractObject */
+        template<class U, class = typename std::enable_if<std::is_base_of<AbstractObject<3, T>, U>::value>::type> explicit BasicBoundable3D(U& object, const Math::Range3D<T>& bounds, BasicSpatialIndex3D<T>* index = nullptr): BasicBoundable3D<T>{static_cast<AbstractObject<3, T>&>(object), bounds, index} {}
+        #endif
+
+        /**
+         * @brief Destructor
+         *
+         * Removes the feature from the index, if it's a part of any.
+         */
+        ~BasicBoundable3D();
+
+        /**
+         * @brief Spatial index this boundable belongs to
+         *
+         * If the boundable doesn't belong to any index, returns
+         * @cpp nullptr @ce.
+         */
+        BasicSpatialIndex3D<T>* index() { return _index; }
+        const BasicSpatialIndex3D<T>* index() const { return _index; } /**< @overload */
+
+        /** @brief Bounds relative to the object */
+        Math::Range3D<T> bounds() const { return _bounds; }
+
+        /**
+         * @brief Set bounds relative to the object
+         * @return Reference to self (for method chaining)
+         *
+         * The absolute bounds get recalculated on next
+         * @ref BasicSpatialIndex3D::update().
+         */
+        BasicBoundable3D<T>& setBounds(const Math::Range3D<T>& bounds);
+
+        /**
+         * @brief Absolute bounds
+         *
+         * Axis-aligned box enclosing @ref bounds() transformed with the
+         * absolute object transformation. Up-to-date only after the object
+         * was cleaned or after @ref BasicSpatialIndex3D::update() was called.
+         */
+        Math::Range3D<T> absoluteBounds() const { return _absoluteBounds; }
+
+    private:
+        /* Private in order to not confuse users about which one to call */
+        void markDirty() override;
+        void clean(const Math::Matrix4<T>& absoluteTransformationMatrix) override;
+
+        BasicSpatialIndex3D<T>* _index;
+        Math::Range3D<T> _bounds, _absoluteBounds;
+        UnsignedInt _id;
+        bool _pending;
+};
+
+/**
+@brief Three-dimensional float boundable
+@m_since_latest
+
+@see @ref SpatialIndex3D
+*/
+typedef BasicBoundable3D<Float> Boundable3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !(defined(CORRADE_TARGET_MINGW) && !defined(CORRADE_TARGET_CLANG))
+extern template class MAGNUM_SCENEGRAPH_EXPORT BasicBoundable3D<Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,373 @@
+#ifndef Magnum_SceneGraph_Boundable_hpp
+#define Magnum_SceneGraph_Boundable_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Boundable.h and @ref SpatialIndex.h
+ * @m_since_latest
+ */
+
+#include <algorithm>
+#include <queue>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/Boundable.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* Axis-aligned box enclosing a transformed axis-aligned box. Arvo, Graphics
+   Gems, 1990 */
+template<class T> Math::Range3D<T> transformRange(const Math::Matrix4<T>& matrix, const Math::Range3D<T>& range) {
+    const Math::Vector3<T> center = matrix.transformPoint(range.center());
+    const Math::Vector3<T> halfSize = range.size()/T(2);
+    const Math::Vector3<T> transformedHalfSize =
+        Math::abs(matrix[0].xyz())*halfSize.x() +
+        Math::abs(matrix[1].xyz())*halfSize.y() +
+        Math::abs(matrix[2].xyz())*halfSize.z();
+    return Math::Range3D<T>::fromCenter(center, transformedHalfSize);
+}
+
+/* Squared distance of a point to a range, 0 if inside */
+template<class T> T pointRangeDistanceSquared(const Math::Vector3<T>& point, const Math::Range3D<T>& range) {
+    return (Math::max(range.min() - point, T(0)) +
+            Math::max(point - range.max(), T(0))).dot();
+}
+
+/* Slab test. Returns distance at which the ray enters the range, or a
+   negative value if it doesn't intersect it in the [0, maxDistance]
+   interval. */
+template<class T> T rayRange(const Math::Vector3<T>& origin, const Math::Vector3<T>& inverseDirection, const Math::Range3D<T>& range, const T maxDistance) {
+    const Math::Vector3<T> a = (range.min() - origin)*inverseDirection;
+    const Math::Vector3<T> b = (range.max() - origin)*inverseDirection;
+    const T entry = Math::max(Math::min(a, b).max(), T(0));
+    const T exit = Math::min(Math::max(a, b).min(), maxDistance);
+    return entry <= exit ? entry : T(-1);
+}
+
+}
+
+template<class T> BasicBoundable3D<T>::BasicBoundable3D(AbstractObject<3, T>& object, const Math::Range3D<T>& bounds, BasicSpatialIndex3D<T>* const index): AbstractFeature<3, T>{object}, _index{}, _bounds{bounds}, _id{}, _pending{} {
+    AbstractFeature<3, T>::setCachedTransformations(CachedTransformation::Absolute);
+    if(index) index->add(*this);
+}
+
+template<class T> BasicBoundable3D<T>::~BasicBoundable3D() {
+    if(_index) _index->remove(*this);
+}
+
+template<class T> BasicBoundable3D<T>& BasicBoundable3D<T>::setBounds(const Math::Range3D<T>& bounds) {
+    _bounds = bounds;
+    if(_index) _index->markPending(*this);
+    return *this;
+}
+
+template<class T> void BasicBoundable3D<T>::markDirty() {
+    if(_index) _index->markPending(*this);
+}
+
+template<class T> void BasicBoundable3D<T>::clean(const Math::Matrix4<T>& absoluteTransformationMatrix) {
+    _absoluteBounds = Implementation::transformRange(absoluteTransformationMatrix, _bounds);
+    if(_index) _index->relink(_id, _absoluteBounds);
+}
+
+template<class T> BasicSpatialIndex3D<T>::BasicSpatialIndex3D(const Math::Range3D<T>& bounds, const UnsignedInt maxDepth): _maxDepth{maxDepth} {
+    CORRADE_ASSERT((bounds.size() > Math::Vector3<T>{T(0)}).all(),
+        "SceneGraph::SpatialIndex3D: expected non-empty bounds but got" << bounds, );
+
+    _nodes.push_back(Node{bounds.center(), bounds.size().max()/T(2), 0, 0, ~UnsignedInt{}, 0});
+}
+
+template<class T> BasicSpatialIndex3D<T>::~BasicSpatialIndex3D() {
+    for(Item& item: _items) {
+        item.boundable->_index = nullptr;
+        item.boundable->_pending = false;
+    }
+}
+
+template<class T> Math::Range3D<T> BasicSpatialIndex3D<T>::bounds() const {
+    return Math::Range3D<T>::fromCenter(_nodes[0].center, Math::Vector3<T>{_nodes[0].halfSize});
+}
+
+template<class T> BasicSpatialIndex3D<T>& BasicSpatialIndex3D<T>::add(BasicBoundable3D<T>& boundable) {
+    /* Remove from previous index */
+    if(boundable._index) boundable._index->remove(boundable);
+
+    /* Crossreference the boundable and index together. The position in the
+       tree is calculated in the next update(). */
+    boundable._index = this;
+    boundable._id = _items.size();
+    _items.push_back(Item{&boundable, {}, ~UnsignedInt{}, ~UnsignedInt{}, ~UnsignedInt{}});
+    markPending(boundable);
+    return *this;
+}
+
+template<class T> BasicSpatialIndex3D<T>& BasicSpatialIndex3D<T>::remove(BasicBoundable3D<T>& boundable) {
+    CORRADE_ASSERT(boundable._index == this,
+        "SceneGraph::SpatialIndex3D::remove(): boundable is not part of this index", *this);
+
+    if(boundable._pending)
+        _pending.erase(std::find(_pending.begin(), _pending.end(), &boundable));
+
+    /* Unlink the item and move the last item in its place */
+    const UnsignedInt id = boundable._id;
+    unlink(id);
+    const UnsignedInt last = _items.size() - 1;
+    if(id != last) {
+        const bool linked = _items[last].node != ~UnsignedInt{};
+        if(linked) unlink(last);
+        _items[id] = _items[last];
+        _items[id].boundable->_id = id;
+        if(linked) link(id);
+    }
+    _items.pop_back();
+
+    boundable._index = nullptr;
+    boundable._pending = false;
+    return *this;
+}
+
+template<class T> void BasicSpatialIndex3D<T>::markPending(BasicBoundable3D<T>& boundable) {
+    if(boundable._pending) return;
+    boundable._pending = true;
+    _pending.push_back(&boundable);
+}
+
+template<class T> void BasicSpatialIndex3D<T>::update() {
+    if(_pending.empty()) return;
+
+    /* Objects that are dirty get cleaned in a single batch, which calls
+       BasicBoundable3D::clean() and thus relinks them. Objects that are
+       already clean (i.e., only their bounds changed or they were just added)
+       get updated directly. */
+    std::vector<std::reference_wrapper<AbstractObject<3, T>>> objects;
+    for(BasicBoundable3D<T>* boundable: _pending) {
+        AbstractObject<3, T>& object = boundable->object();
+        if(object.isDirty()) objects.push_back(object);
+        else boundable->clean(object.absoluteTransformationMatrix());
+    }
+    AbstractObject<3, T>::setClean(objects);
+
+    for(BasicBoundable3D<T>* boundable: _pending) boundable->_pending = false;
+    _pending.clear();
+}
+
+template<class T> void BasicSpatialIndex3D<T>::relink(const UnsignedInt id, const Math::Range3D<T>& bounds) {
+    unlink(id);
+    _items[id].bounds = bounds;
+    link(id);
+}
+
+template<class T> void BasicSpatialIndex3D<T>::link(const UnsignedInt id) {
+    Item& item = _items[id];
+    const Math::Vector3<T> center = item.bounds.center();
+    const T halfSize = (item.bounds.size()/T(2)).max();
+
+    /* Find the deepest node that's large enough for the item, if the item
+       center is outside of the root, put it there */
+    UnsignedInt node = 0;
+    if(Implementation::pointRangeDistanceSquared(center, bounds()) == T(0)) {
+        for(UnsignedInt depth = 0; depth != _maxDepth; ++depth) {
+            /* Loose bounds of a child are twice its size, so an item fits
+               there if it's not larger than the child itself */
+            if(halfSize > _nodes[node].halfSize/T(2)) break;
+
+            /* Allocate children on-demand. Careful, this invalidates node
+               references. */
+            if(!_nodes[node].firstChild) {
+                const UnsignedInt firstChild = _nodes.size();
+                const Math::Vector3<T> parentCenter = _nodes[node].center;
+                const T childHalfSize = _nodes[node].halfSize/T(2);
+                for(UnsignedInt i = 0; i != 8; ++i) _nodes.push_back(Node{
+                    parentCenter + Math::Vector3<T>{
+                        i & 1 ? childHalfSize : -childHalfSize,
+                        i & 2 ? childHalfSize : -childHalfSize,
+                        i & 4 ? childHalfSize : -childHalfSize},
+                    childHalfSize, node, 0, ~UnsignedInt{}, 0});
+                _nodes[node].firstChild = firstChild;
+            }
+
+            const Node& parent = _nodes[node];
+            node = parent.firstChild +
+                (center.x() >= parent.center.x() ? 1 : 0) +
+                (center.y() >= parent.center.y() ? 2 : 0) +
+                (center.z() >= parent.center.z() ? 4 : 0);
+        }
+    }
+
+    /* Prepend the item to the node list */
+    item.node = node;
+    item.previous = ~UnsignedInt{};
+    item.next = _nodes[node].firstItem;
+    if(item.next != ~UnsignedInt{}) _items[item.next].previous = id;
+    _nodes[node].firstItem = id;
+
+    /* Update subtree counts up to the root */
+    for(;;) {
+        ++_nodes[node].count;
+        if(!node) break;
+        node = _nodes[node].parent;
+    }
+}
+
+template<class T> void BasicSpatialIndex3D<T>::unlink(const UnsignedInt id) {
+    Item& item = _items[id];
+    UnsignedInt node = item.node;
+    if(node == ~UnsignedInt{}) return;
+
+    if(item.previous != ~UnsignedInt{}) _items[item.previous].next = item.next;
+    else _nodes[node].firstItem = item.next;
+    if(item.next != ~UnsignedInt{}) _items[item.next].previous = item.previous;
+    item.node = ~UnsignedInt{};
+
+    for(;;) {
+        --_nodes[node].count;
+        if(!node) break;
+        node = _nodes[node].parent;
+    }
+}
+
+template<class T> Math::Range3D<T> BasicSpatialIndex3D<T>::looseBounds(const UnsignedInt node) const {
+    return Math::Range3D<T>::fromCenter(_nodes[node].center, Math::Vector3<T>{_nodes[node].halfSize*T(2)});
+}
+
+template<class T> template<class NodeTest, class ItemTest> void BasicSpatialIndex3D<T>::traverse(NodeTest nodeTest, ItemTest itemTest) {
+    update();
+
+    /* The root is always visited as it contains also items that are outside
+       of the indexed area */
+    _stack.clear();
+    _stack.push_back(0);
+    while(!_stack.empty()) {
+        const Node& node = _nodes[_stack.back()];
+        _stack.pop_back();
+
+        for(UnsignedInt i = node.firstItem; i != ~UnsignedInt{}; i = _items[i].next)
+            itemTest(_items[i]);
+
+        if(node.firstChild) for(UnsignedInt i = node.firstChild, end = node.firstChild + 8; i != end; ++i)
+            if(_nodes[i].count && nodeTest(looseBounds(i))) _stack.push_back(i);
+    }
+}
+
+template<class T> std::vector<std::reference_wrapper<BasicBoundable3D<T>>> BasicSpatialIndex3D<T>::intersectFrustum(const Math::Frustum<T>& frustum) {
+    std::vector<std::reference_wrapper<BasicBoundable3D<T>>> out;
+    traverse([&](const Math::Range3D<T>& bounds) {
+        return Math::Intersection::rangeFrustum(bounds, frustum);
+    }, [&](const Item& item) {
+        if(Math::Intersection::rangeFrustum(item.bounds, frustum))
+            out.push_back(*item.boundable);
+    });
+    return out;
+}
+
+template<class T> std::vector<std::reference_wrapper<BasicBoundable3D<T>>> BasicSpatialIndex3D<T>::intersectRange(const Math::Range3D<T>& range) {
+    const auto intersects = [&](const Math::Range3D<T>& bounds) {
+        return (bounds.max() >= range.min()).all() &&
+               (bounds.min() <= range.max()).all();
+    };
+
+    std::vector<std::reference_wrapper<BasicBoundable3D<T>>> out;
+    traverse(intersects, [&](const Item& item) {
+        if(intersects(item.bounds)) out.push_back(*item.boundable);
+    });
+    return out;
+}
+
+template<class T> std::vector<std::reference_wrapper<BasicBoundable3D<T>>> BasicSpatialIndex3D<T>::intersectSphere(const Math::Vector3<T>& center, const T radius) {
+    const T radiusSquared = radius*radius;
+    const auto intersects = [&](const Math::Range3D<T>& bounds) {
+        return Implementation::pointRangeDistanceSquared(center, bounds) <= radiusSquared;
+    };
+
+    std::vector<std::reference_wrapper<BasicBoundable3D<T>>> out;
+    traverse(intersects, [&](const Item& item) {
+        if(intersects(item.bounds)) out.push_back(*item.boundable);
+    });
+    return out;
+}
+
+template<class T> std::vector<std::pair<std::reference_wrapper<BasicBoundable3D<T>>, T>> BasicSpatialIndex3D<T>::intersectRay(const Math::Vector3<T>& origin, const Math::Vector3<T>& direction, const T maxDistance) {
+    const Math::Vector3<T> inverseDirection = T(1)/direction;
+
+    std::vector<std::pair<std::reference_wrapper<BasicBoundable3D<T>>, T>> out;
+    traverse([&](const Math::Range3D<T>& bounds) {
+        return Implementation::rayRange(origin, inverseDirection, bounds, maxDistance) >= T(0);
+    }, [&](const Item& item) {
+        const T distance = Implementation::rayRange(origin, inverseDirection, item.bounds, maxDistance);
+        if(distance >= T(0)) out.emplace_back(*item.boundable, distance);
+    });
+
+    std::sort(out.begin(), out.end(), [](const std::pair<std::reference_wrapper<BasicBoundable3D<T>>, T>& a, const std::pair<std::reference_wrapper<BasicBoundable3D<T>>, T>& b) {
+        return a.second < b.second;
+    });
+    return out;
+}
+
+template<class T> std::vector<std::pair<std::reference_wrapper<BasicBoundable3D<T>>, T>> BasicSpatialIndex3D<T>::nearest(const Math::Vector3<T>& point, const std::size_t count) {
+    update();
+
+    std::vector<std::pair<std::reference_wrapper<BasicBoundable3D<T>>, T>> out;
+    if(!count) return out;
+    out.reserve(count);
+
+    /* Best-first search. Distance to loose node bounds is never larger than
+       distance to any item inside, so once an item gets to the top of the
+       queue, there's nothing closer left. The second value is a node index,
+       or an item index with the highest bit set. */
+    typedef std::pair<T, UnsignedInt> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    constexpr UnsignedInt ItemBit = 1u << 31;
+    queue.emplace(T(0), 0);
+    while(!queue.empty()) {
+        const Entry top = queue.top();
+        queue.pop();
+
+        if(top.second & ItemBit) {
+            out.emplace_back(*_items[top.second & ~ItemBit].boundable, Math::sqrt(top.first));
+            if(out.size() == count) break;
+            continue;
+        }
+
+        const Node& node = _nodes[top.second];
+        for(UnsignedInt i = node.firstItem; i != ~UnsignedInt{}; i = _items[i].next)
+            queue.emplace(Implementation::pointRangeDistanceSquared(point, _items[i].bounds), i|ItemBit);
+
+        if(node.firstChild) for(UnsignedInt i = node.firstChild, end = node.firstChild + 8; i != end; ++i)
+            if(_nodes[i].count) queue.emplace(Implementation::pointRangeDistanceSquared(point, looseBounds(i)), i);
+    }
+
+    return out;
+}
+
+}}
+
+#endif
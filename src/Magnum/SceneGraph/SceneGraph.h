@@ -94,6 +94,9 @@ template<class T> using BasicAnimableGroup3D = AnimableGroup<3, T>;
 typedef BasicAnimableGroup2D<Float> AnimableGroup2D;
 typedef BasicAnimableGroup3D<Float> AnimableGroup3D;
 
+template<class> class BasicBoundable3D;
+typedef BasicBoundable3D<Float> Boundable3D;
+
 template<UnsignedInt, class> class Camera;
 template<class T> using BasicCamera2D = Camera<2, T>;
 template<class T> using BasicCamera3D = Camera<3, T>;
@@ -137,6 +140,9 @@ typedef BasicRigidMatrixTransformation3D<Float> RigidMatrixTransformation3D;
 
 template<class Transformation> class Scene;
 
+template<class> class BasicSpatialIndex3D;
+typedef BasicSpatialIndex3D<Float> SpatialIndex3D;
+
 template<UnsignedInt, class T, class = T> class TranslationTransformation;
 template<class T, class TranslationType = T> using BasicTranslationTransformation2D = TranslationTransformation<2, T, TranslationType>;
 template<class T, class TranslationType = T> using BasicTranslationTransformation3D = TranslationTransformation<3, T, TranslationType>;
@@ -0,0 +1,297 @@
+#ifndef Magnum_SceneGraph_SpatialIndex_h
+#define Magnum_SceneGraph_SpatialIndex_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BasicSpatialIndex3D, typedef @ref Magnum::SceneGraph::SpatialIndex3D
+ * @m_since_latest
+ */
+
+#include <vector>
+#include <functional>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Spatial index
+@m_since_latest
+
+Dynamic loose octree containing absolute bounds of all
+@ref BasicBoundable3D "Boundable3D" features added to it. See the
+@ref BasicBoundable3D class documentation for an introduction.
+
+@section SceneGraph-SpatialIndex-structure Index structure
+
+The index covers a cubic area given in the constructor, which is recursively
+subdivided into octants up to @ref maxDepth() levels. Each octant has its
+bounds enlarged to twice the size (hence a *loose* octree), which means an
+object is stored in the deepest octant that's at least as large as the object
+and contains its center, and doesn't need to be split across multiple octants.
+Objects that are outside of the indexed area are kept in the root octant, so
+they're still returned by the queries, only without any acceleration.
+
+Updates are incremental --- when an object transformation changes, the
+object gets only relinked to a different octant, which is a constant-time
+operation with no allocations. Octants are never deallocated, empty octants
+are skipped during queries.
+
+@section SceneGraph-SpatialIndex-queries Queries
+
+Frustum culling of a drawable group, with the drawables being both a
+@ref Drawable and a @ref BasicBoundable3D "Boundable3D", can then look like
+this:
+
+@snippet MagnumSceneGraph.cpp SpatialIndex-culling
+
+All query functions implicitly call @ref update() first. Boundables in the
+index have to be attached to objects of the same type that are a part of the
+same scene, as @ref update() cleans them all in a single batch using
+@ref AbstractObject::setClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>&).
+
+@section SceneGraph-SpatialIndex-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref Boundable.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref SpatialIndex3D
+
+@see @ref scenegraph, @ref SpatialIndex3D
+*/
+template<class T> class BasicSpatialIndex3D {
+    friend BasicBoundable3D<T>;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param bounds    Indexed area. Expected to be non-empty.
+         * @param maxDepth  Max octree depth
+         *
+         * If the @p bounds are not a cube, the indexed area is enlarged
+         * to a cube around its center.
+         */
+        explicit BasicSpatialIndex3D(const Math::Range3D<T>& bounds, UnsignedInt maxDepth = 8);
+
+        /** @brief Copying is not allowed */
+        BasicSpatialIndex3D(const BasicSpatialIndex3D<T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        BasicSpatialIndex3D(BasicSpatialIndex3D<T>&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Removes all boundables belonging to this index, but not deletes
+         * them.
+         */
+        ~BasicSpatialIndex3D();
+
+        /** @brief Copying is not allowed */
+        BasicSpatialIndex3D<T>& operator=(const BasicSpatialIndex3D<T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        BasicSpatialIndex3D<T>& operator=(BasicSpatialIndex3D<T>&&) = delete;
+
+        /** @brief Indexed area */
+        Math::Range3D<T> bounds() const;
+
+        /** @brief Max octree depth */
+        UnsignedInt maxDepth() const { return _maxDepth; }
+
+        /** @brief Whether the index is empty */
+        bool isEmpty() const { return _items.empty(); }
+
+        /** @brief Count of boundables in the index */
+        std::size_t size() const { return _items.size(); }
+
+        /**
+         * @brief Boundable at given index
+         *
+         * Note that the order changes when boundables are removed from the
+         * index.
+         */
+        BasicBoundable3D<T>& operator[](std::size_t id) {
+            return *_items[id].boundable;
+        }
+
+        /** @overload */
+        const BasicBoundable3D<T>& operator[](std::size_t id) const {
+            return *_items[id].boundable;
+        }
+
+        /**
+         * @brief Count of allocated octants
+         *
+         * Useful mainly for diagnostic purposes. The count only grows.
+         */
+        std::size_t nodeCount() const { return _nodes.size(); }
+
+        /**
+         * @brief Count of boundables waiting for an update
+         *
+         * @see @ref update()
+         */
+        std::size_t pendingCount() const { return _pending.size(); }
+
+        /**
+         * @brief Add a boundable to the index
+         * @return Reference to self (for method chaining)
+         *
+         * If the boundable is part of another index, it is removed from it.
+         * Its position in the octree is calculated on next @ref update().
+         * @see @ref remove(), @ref BasicBoundable3D::BasicBoundable3D()
+         */
+        BasicSpatialIndex3D<T>& add(BasicBoundable3D<T>& boundable);
+
+        /**
+         * @brief Remove a boundable from the index
+         * @return Reference to self (for method chaining)
+         *
+         * The boundable must be part of the index.
+         * @see @ref add()
+         */
+        BasicSpatialIndex3D<T>& remove(BasicBoundable3D<T>& boundable);
+
+        /**
+         * @brief Update the index
+         *
+         * Cleans all objects that were marked as dirty since the last update
+         * and relinks their boundables to a new octant. If nothing changed,
+         * the function does nothing. Called implicitly from all query
+         * functions.
+         * @see @ref pendingCount()
+         */
+        void update();
+
+        /**
+         * @brief Boundables intersecting a frustum
+         *
+         * Returns boundables for which
+         * @ref Math::Intersection::rangeFrustum() is @cpp true @ce. The
+         * order is unspecified.
+         */
+        std::vector<std::reference_wrapper<BasicBoundable3D<T>>> intersectFrustum(const Math::Frustum<T>& frustum);
+
+        /**
+         * @brief Boundables intersecting a range
+         *
+         * The order is unspecified.
+         */
+        std::vector<std::reference_wrapper<BasicBoundable3D<T>>> intersectRange(const Math::Range3D<T>& range);
+
+        /**
+         * @brief Boundables intersecting a sphere
+         *
+         * The order is unspecified.
+         */
+        std::vector<std::reference_wrapper<BasicBoundable3D<T>>> intersectSphere(const Math::Vector3<T>& center, T radius);
+
+        /**
+         * @brief Boundables intersecting a ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction. Doesn't need to be normalized.
+         * @param maxDistance   Max distance along the ray, in multiples of
+         *      @p direction
+         *
+         * Returns boundables together with the distance along the ray at
+         * which the ray enters their absolute bounds, in multiples of
+         * @p direction, sorted front-to-back. If the origin is inside the
+         * bounds, the distance is @cpp 0 @ce.
+         */
+        std::vector<std::pair<std::reference_wrapper<BasicBoundable3D<T>>, T>> intersectRay(const Math::Vector3<T>& origin, const Math::Vector3<T>& direction, T maxDistance = Math::Constants<T>::inf());
+
+        /**
+         * @brief Boundables nearest to a point
+         * @param point         Point
+         * @param count         Max count of returned boundables
+         *
+         * Returns at most @p count boundables sorted by distance of their
+         * absolute bounds to @p point, together with the distance. If the
+         * point is inside the bounds, the distance is @cpp 0 @ce.
+         */
+        std::vector<std::pair<std::reference_wrapper<BasicBoundable3D<T>>, T>> nearest(const Math::Vector3<T>& point, std::size_t count);
+
+    private:
+        struct Node {
+            Math::Vector3<T> center;
+            T halfSize;
+            UnsignedInt parent;
+            /* 0 if there are no children, as the root can't be a child */
+            UnsignedInt firstChild;
+            /* ~UnsignedInt{} if there are no items */
+            UnsignedInt firstItem;
+            /* Count of items in the whole subtree */
+            UnsignedInt count;
+        };
+
+        struct Item {
+            BasicBoundable3D<T>* boundable;
+            /* Copy of the absolute bounds for better memory locality in the
+               queries */
+            Math::Range3D<T> bounds;
+            /* ~UnsignedInt{} if not linked to any node yet */
+            UnsignedInt node;
+            UnsignedInt previous, next;
+        };
+
+        MAGNUM_SCENEGRAPH_LOCAL void link(UnsignedInt item);
+        MAGNUM_SCENEGRAPH_LOCAL void unlink(UnsignedInt item);
+        MAGNUM_SCENEGRAPH_LOCAL void relink(UnsignedInt item, const Math::Range3D<T>& bounds);
+        MAGNUM_SCENEGRAPH_LOCAL void markPending(BasicBoundable3D<T>& boundable);
+        MAGNUM_SCENEGRAPH_LOCAL Math::Range3D<T> looseBounds(UnsignedInt node) const;
+
+        template<class NodeTest, class ItemTest> void traverse(NodeTest nodeTest, ItemTest itemTest);
+
+        UnsignedInt _maxDepth;
+        std::vector<Node> _nodes;
+        std::vector<Item> _items;
+        std::vector<BasicBoundable3D<T>*> _pending;
+        /* Reused between queries to avoid allocations */
+        std::vector<UnsignedInt> _stack;
+};
+
+/**
+@brief Three-dimensional float spatial index
+@m_since_latest
+
+@see @ref Boundable3D
+*/
+typedef BasicSpatialIndex3D<Float> SpatialIndex3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !(defined(CORRADE_TARGET_MINGW) && !defined(CORRADE_TARGET_CLANG))
+extern template class MAGNUM_SCENEGRAPH_EXPORT BasicSpatialIndex3D<Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,406 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/SceneGraph/Boundable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/SpatialIndex.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct SpatialIndexTest: TestSuite::Tester {
+    explicit SpatialIndexTest();
+
+    void construct();
+    void constructEmptyBounds();
+
+    void addRemove();
+    void addToAnotherIndex();
+    void removeNotPartOfIndex();
+    void destructIndex();
+    void destructBoundable();
+
+    void update();
+    void updateTransformedParent();
+    void updateBoundsChanged();
+
+    void intersectFrustum();
+    void intersectRange();
+    void intersectSphere();
+    void intersectRay();
+    void nearest();
+    void outsideIndexedArea();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+SpatialIndexTest::SpatialIndexTest() {
+    addTests({&SpatialIndexTest::construct,
+              &SpatialIndexTest::constructEmptyBounds,
+
+              &SpatialIndexTest::addRemove,
+              &SpatialIndexTest::addToAnotherIndex,
+              &SpatialIndexTest::removeNotPartOfIndex,
+              &SpatialIndexTest::destructIndex,
+              &SpatialIndexTest::destructBoundable,
+
+              &SpatialIndexTest::update,
+              &SpatialIndexTest::updateTransformedParent,
+              &SpatialIndexTest::updateBoundsChanged,
+
+              &SpatialIndexTest::intersectFrustum,
+              &SpatialIndexTest::intersectRange,
+              &SpatialIndexTest::intersectSphere,
+              &SpatialIndexTest::intersectRay,
+              &SpatialIndexTest::nearest,
+              &SpatialIndexTest::outsideIndexedArea});
+}
+
+const Range3D UnitCube{Vector3{-0.5f}, Vector3{0.5f}};
+
+void SpatialIndexTest::construct() {
+    /* Non-cubic bounds get enlarged to a cube */
+    SpatialIndex3D index{{{-2.0f, -1.0f, 0.0f}, {2.0f, 1.0f, 1.0f}}, 5};
+    CORRADE_COMPARE(index.bounds(), (Range3D{{-2.0f, -2.0f, -1.5f}, {2.0f, 2.0f, 2.5f}}));
+    CORRADE_COMPARE(index.maxDepth(), 5);
+    CORRADE_VERIFY(index.isEmpty());
+    CORRADE_COMPARE(index.size(), 0);
+    CORRADE_COMPARE(index.nodeCount(), 1);
+    CORRADE_COMPARE(index.pendingCount(), 0);
+}
+
+void SpatialIndexTest::constructEmptyBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SpatialIndex3D index{{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 1.0f}}};
+    CORRADE_COMPARE(out.str(), "SceneGraph::SpatialIndex3D: expected non-empty bounds but got Range({0, 0, 0}, {1, 0, 1})\n");
+}
+
+void SpatialIndexTest::addRemove() {
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene}, c{&scene};
+    SpatialIndex3D index{{Vector3{-10.0f}, Vector3{10.0f}}};
+
+    Boundable3D ba{a, UnitCube, &index};
+    Boundable3D bb{b, UnitCube};
+    Boundable3D bc{c, UnitCube, &index};
+    CORRADE_COMPARE(ba.index(), &index);
+    CORRADE_COMPARE(bb.index(), nullptr);
+    CORRADE_COMPARE(index.size(), 2);
+    CORRADE_COMPARE(index.pendingCount(), 2);
+
+    index.add(bb);
+    CORRADE_COMPARE(bb.index(), &index);
+    CORRADE_COMPARE(index.size(), 3);
+    CORRADE_COMPARE(index.pendingCount(), 3);
+    CORRADE_COMPARE(&index[0], &ba);
+    CORRADE_COMPARE(&index[1], &bc);
+    CORRADE_COMPARE(&index[2], &bb);
+
+    /* Removing moves the last item in place of the removed one */
+    index.update();
+    index.remove(ba);
+    CORRADE_COMPARE(ba.index(), nullptr);
+    CORRADE_COMPARE(index.size(), 2);
+    CORRADE_COMPARE(&index[0], &bb);
+    CORRADE_COMPARE(&index[1], &bc);
+
+    /* The remaining items are still reachable */
+    CORRADE_COMPARE(index.intersectSphere({}, 1.0f).size(), 2);
+
+    /* Removing a pending item removes it from the pending list as well */
+    a.translate(Vector3::xAxis(1.0f));
+    index.add(ba);
+    CORRADE_COMPARE(index.pendingCount(), 1);
+    index.remove(ba);
+    CORRADE_COMPARE(index.pendingCount(), 0);
+}
+
+void SpatialIndexTest::addToAnotherIndex() {
+    Scene3D scene;
+    Object3D a{&scene};
+    SpatialIndex3D index1{{Vector3{-10.0f}, Vector3{10.0f}}};
+    SpatialIndex3D index2{{Vector3{-10.0f}, Vector3{10.0f}}};
+
+    Boundable3D boundable{a, UnitCube, &index1};
+    index2.add(boundable);
+    CORRADE_COMPARE(boundable.index(), &index2);
+    CORRADE_VERIFY(index1.isEmpty());
+    CORRADE_COMPARE(index1.pendingCount(), 0);
+    CORRADE_COMPARE(index2.size(), 1);
+}
+
+void SpatialIndexTest::removeNotPartOfIndex() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Scene3D scene;
+    Object3D a{&scene};
+    SpatialIndex3D index{{Vector3{-10.0f}, Vector3{10.0f}}};
+    Boundable3D boundable{a, UnitCube};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    index.remove(boundable);
+    CORRADE_COMPARE(out.str(), "SceneGraph::SpatialIndex3D::remove(): boundable is not part of this index\n");
+}
+
+void SpatialIndexTest::destructIndex() {
+    Scene3D scene;
+    Object3D a{&scene};
+    Boundable3D boundable{a, UnitCube};
+    {
+        SpatialIndex3D index{{Vector3{-10.0f}, Vector3{10.0f}}};
+        index.add(boundable);
+        CORRADE_COMPARE(boundable.index(), &index);
+    }
+
+    CORRADE_COMPARE(boundable.index(), nullptr);
+}
+
+void SpatialIndexTest::destructBoundable() {
+    Scene3D scene;
+    Object3D a{&scene};
+    Object3D b{&scene};
+    SpatialIndex3D index{{Vector3{-10.0f}, Vector3{10.0f}}};
+    Boundable3D bb{b, UnitCube, &index};
+    {
+        Boundable3D ba{a, UnitCube, &index};
+        CORRADE_COMPARE(index.size(), 2);
+    }
+
+    CORRADE_COMPARE(index.size(), 1);
+    CORRADE_COMPARE(index.pendingCount(), 1);
+    CORRADE_COMPARE(&index[0], &bb);
+}
+
+void SpatialIndexTest::update() {
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene};
+    a.translate({2.0f, 0.0f, 0.0f});
+    SpatialIndex3D index{{Vector3{-10.0f}, Vector3{10.0f}}};
+    Boundable3D ba{a, UnitCube, &index};
+    Boundable3D bb{b, UnitCube, &index};
+    CORRADE_COMPARE(index.pendingCount(), 2);
+
+    index.update();
+    CORRADE_COMPARE(index.pendingCount(), 0);
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_COMPARE(ba.absoluteBounds(), (Range3D{{1.5f, -0.5f, -0.5f}, {2.5f, 0.5f, 0.5f}}));
+    CORRADE_COMPARE(bb.absoluteBounds(), UnitCube);
+    /* Small objects are in a deeper level, so the tree got subdivided */
+    CORRADE_COMPARE_AS(index.nodeCount(), 1, TestSuite::Compare::Greater);
+
+    /* Only the changed object is updated */
+    a.rotateZ(90.0_degf).scale(Vector3{2.0f, 1.0f, 1.0f});
+    CORRADE_COMPARE(index.pendingCount(), 1);
+    index.update();
+    CORRADE_COMPARE(index.pendingCount(), 0);
+    CORRADE_COMPARE(ba.absoluteBounds(), (Range3D{{-1.0f, 1.5f, -0.5f}, {1.0f, 2.5f, 0.5f}}));
+}
+
+void SpatialIndexTest::updateTransformedParent() {
+    Scene3D scene;
+    Object3D parent{&scene};
+    Object3D a{&parent};
+    SpatialIndex3D index{{Vector3{-10.0f}, Vector3{10.0f}}};
+    Boundable3D ba{a, UnitCube, &index};
+    index.update();
+
+    /* Dirty flag propagates to children */
+    parent.translate({0.0f, 3.0f, 0.0f});
+    CORRADE_COMPARE(index.pendingCount(), 1);
+    CORRADE_COMPARE(index.intersectSphere({0.0f, 3.0f, 0.0f}, 0.1f).size(), 1);
+    CORRADE_COMPARE(index.intersectSphere({}, 0.1f).size(), 0);
+}
+
+void SpatialIndexTest::updateBoundsChanged() {
+    Scene3D scene;
+    Object3D a{&scene};
+    SpatialIndex3D index{{Vector3{-10.0f}, Vector3{10.0f}}};
+    Boundable3D ba{a, UnitCube, &index};
+    index.update();
+    CORRADE_VERIFY(!a.isDirty());
+
+    ba.setBounds({Vector3{4.0f}, Vector3{5.0f}});
+    CORRADE_COMPARE(ba.bounds(), (Range3D{Vector3{4.0f}, Vector3{5.0f}}));
+    CORRADE_COMPARE(index.pendingCount(), 1);
+
+    /* The object isn't dirty, but the bounds get updated anyway */
+    index.update();
+    CORRADE_COMPARE(ba.absoluteBounds(), (Range3D{Vector3{4.0f}, Vector3{5.0f}}));
+}
+
+void SpatialIndexTest::intersectFrustum() {
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene}, c{&scene};
+    a.translate({0.5f, 0.0f, 0.0f});
+    b.translate({50.0f, 0.0f, 0.0f});
+    c.translate({-1.25f, 0.0f, 0.0f});
+    SpatialIndex3D index{{Vector3{-100.0f}, Vector3{100.0f}}};
+    Boundable3D ba{a, UnitCube, &index};
+    Boundable3D bb{b, UnitCube, &index};
+    Boundable3D bc{c, UnitCube, &index};
+
+    /* A [-1, 1] cube */
+    std::vector<std::reference_wrapper<Boundable3D>> out = index.intersectFrustum(Frustum::fromMatrix({}));
+    CORRADE_COMPARE(out.size(), 2);
+    CORRADE_VERIFY(&out[0].get() == &ba || &out[1].get() == &ba);
+    CORRADE_VERIFY(&out[0].get() == &bc || &out[1].get() == &bc);
+
+    /* Moving the object out of the frustum */
+    a.translate({10.0f, 0.0f, 0.0f});
+    out = index.intersectFrustum(Frustum::fromMatrix({}));
+    CORRADE_COMPARE(out.size(), 1);
+    CORRADE_COMPARE(&out[0].get(), &bc);
+}
+
+void SpatialIndexTest::intersectRange() {
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene};
+    a.translate({3.0f, 3.0f, 3.0f});
+    b.translate({-3.0f, -3.0f, -3.0f});
+    SpatialIndex3D index{{Vector3{-10.0f}, Vector3{10.0f}}};
+    Boundable3D ba{a, UnitCube, &index};
+    Boundable3D bb{b, UnitCube, &index};
+
+    std::vector<std::reference_wrapper<Boundable3D>> out = index.intersectRange({Vector3{0.0f}, Vector3{2.5f}});
+    CORRADE_COMPARE(out.size(), 1);
+    CORRADE_COMPARE(&out[0].get(), &ba);
+
+    CORRADE_COMPARE(index.intersectRange({Vector3{-4.0f}, Vector3{4.0f}}).size(), 2);
+    CORRADE_COMPARE(index.intersectRange({Vector3{-1.0f}, Vector3{1.0f}}).size(), 0);
+}
+
+void SpatialIndexTest::intersectSphere() {
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene};
+    a.translate({3.0f, 0.0f, 0.0f});
+    b.translate({0.0f, 6.0f, 0.0f});
+    SpatialIndex3D index{{Vector3{-10.0f}, Vector3{10.0f}}};
+    Boundable3D ba{a, UnitCube, &index};
+    Boundable3D bb{b, UnitCube, &index};
+
+    CORRADE_COMPARE(index.intersectSphere({}, 2.0f).size(), 0);
+
+    std::vector<std::reference_wrapper<Boundable3D>> out = index.intersectSphere({}, 2.5f);
+    CORRADE_COMPARE(out.size(), 1);
+    CORRADE_COMPARE(&out[0].get(), &ba);
+
+    CORRADE_COMPARE(index.intersectSphere({}, 5.5f).size(), 2);
+}
+
+void SpatialIndexTest::intersectRay() {
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene}, c{&scene};
+    a.translate({6.0f, 0.0f, 0.0f});
+    b.translate({2.0f, 0.0f, 0.0f});
+    c.translate({2.0f, 3.0f, 0.0f});
+    SpatialIndex3D index{{Vector3{-10.0f}, Vector3{10.0f}}};
+    Boundable3D ba{a, UnitCube, &index};
+    Boundable3D bb{b, UnitCube, &index};
+    Boundable3D bc{c, UnitCube, &index};
+
+    /* Sorted front-to-back, distance in multiples of direction */
+    std::vector<std::pair<std::reference_wrapper<Boundable3D>, Float>> out = index.intersectRay({}, {2.0f, 0.0f, 0.0f});
+    CORRADE_COMPARE(out.size(), 2);
+    CORRADE_COMPARE(&out[0].first.get(), &bb);
+    CORRADE_COMPARE(out[0].second, 0.75f);
+    CORRADE_COMPARE(&out[1].first.get(), &ba);
+    CORRADE_COMPARE(out[1].second, 2.75f);
+
+    /* Max distance */
+    out = index.intersectRay({}, {2.0f, 0.0f, 0.0f}, 2.0f);
+    CORRADE_COMPARE(out.size(), 1);
+    CORRADE_COMPARE(&out[0].first.get(), &bb);
+
+    /* Origin inside */
+    out = index.intersectRay({2.0f, 3.0f, 0.0f}, {0.0f, 1.0f, 0.0f});
+    CORRADE_COMPARE(out.size(), 1);
+    CORRADE_COMPARE(&out[0].first.get(), &bc);
+    CORRADE_COMPARE(out[0].second, 0.0f);
+}
+
+void SpatialIndexTest::nearest() {
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene}, c{&scene}, d{&scene};
+    a.translate({6.0f, 0.0f, 0.0f});
+    b.translate({0.0f, -2.0f, 0.0f});
+    c.translate({0.0f, 0.0f, 4.0f});
+    d.translate({-1.0f, 1.0f, 1.0f});
+    SpatialIndex3D index{{Vector3{-10.0f}, Vector3{10.0f}}};
+    Boundable3D ba{a, UnitCube, &index};
+    Boundable3D bb{b, UnitCube, &index};
+    Boundable3D bc{c, UnitCube, &index};
+    /* Large object covering the origin */
+    Boundable3D bd{d, Range3D{Vector3{-2.0f}, Vector3{2.0f}}, &index};
+
+    std::vector<std::pair<std::reference_wrapper<Boundable3D>, Float>> out = index.nearest({}, 3);
+    CORRADE_COMPARE(out.size(), 3);
+    CORRADE_COMPARE(&out[0].first.get(), &bd);
+    CORRADE_COMPARE(out[0].second, 0.0f);
+    CORRADE_COMPARE(&out[1].first.get(), &bb);
+    CORRADE_COMPARE(out[1].second, 1.5f);
+    CORRADE_COMPARE(&out[2].first.get(), &bc);
+    CORRADE_COMPARE(out[2].second, 3.5f);
+
+    CORRADE_COMPARE(index.nearest({}, 10).size(), 4);
+    CORRADE_COMPARE(index.nearest({}, 0).size(), 0);
+}
+
+void SpatialIndexTest::outsideIndexedArea() {
+    Scene3D scene;
+    Object3D a{&scene}, b{&scene};
+    a.translate({50.0f, 0.0f, 0.0f});
+    SpatialIndex3D index{{Vector3{-10.0f}, Vector3{10.0f}}};
+    Boundable3D ba{a, UnitCube, &index};
+    /* Larger than the whole area */
+    Boundable3D bb{b, Range3D{Vector3{-20.0f}, Vector3{20.0f}}, &index};
+
+    std::vector<std::reference_wrapper<Boundable3D>> out = index.intersectSphere({50.0f, 0.0f, 0.0f}, 1.0f);
+    CORRADE_COMPARE(out.size(), 1);
+    CORRADE_COMPARE(&out[0].get(), &ba);
+
+    CORRADE_COMPARE(index.intersectSphere({0.0f, 15.0f, 0.0f}, 1.0f).size(), 1);
+    CORRADE_COMPARE(index.nearest({45.0f, 0.0f, 0.0f}, 1).size(), 1);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SpatialIndexTest)
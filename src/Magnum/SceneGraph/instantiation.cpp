@@ -25,6 +25,7 @@
 
 #include "Magnum/SceneGraph/AbstractFeature.hpp"
 #include "Magnum/SceneGraph/Animable.hpp"
+#include "Magnum/SceneGraph/Boundable.hpp"
 #include "Magnum/SceneGraph/Camera.hpp"
 #include "Magnum/SceneGraph/Drawable.hpp"
 #include "Magnum/SceneGraph/DualComplexTransformation.h"
@@ -66,6 +67,9 @@ template class MAGNUM_SCENEGRAPH_EXPORT_HPP Animable<3, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP AnimableGroup<2, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP AnimableGroup<3, Float>;
 
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BasicBoundable3D<Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP BasicSpatialIndex3D<Float>;
+
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Camera<2, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Camera<3, Float>;
 
@@ -0,0 +1,116 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/PixelFormatConversion.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Swizzle.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct PixelFormatConversionBenchmark: TestSuite::Tester {
+    explicit PixelFormatConversionBenchmark();
+
+    void convert();
+    void swapRedBlueGather();
+};
+
+const Vector2i Size{1024, 1024};
+
+/* Covering the copy, bit shuffle, 64-bit integer, direct decode and float
+   code paths */
+const struct {
+    const char* name;
+    PixelFormat source, destination;
+    PixelFormatConversionFlags flags;
+} Data[]{
+    {"RGBA8Unorm copy", PixelFormat::RGBA8Unorm, PixelFormat::RGBA8Unorm, {}},
+    {"RGB8Unorm to RGBA8Unorm", PixelFormat::RGB8Unorm, PixelFormat::RGBA8Unorm, {}},
+    {"RGBA8Unorm to RGB8Unorm", PixelFormat::RGBA8Unorm, PixelFormat::RGB8Unorm, {}},
+    {"BGR8Unorm to RGB8Unorm", PixelFormat::RGB8Unorm, PixelFormat::RGB8Unorm, PixelFormatConversionFlag::SwapRedBlue},
+    {"BGRA8Unorm to RGBA8Unorm", PixelFormat::RGBA8Unorm, PixelFormat::RGBA8Unorm, PixelFormatConversionFlag::SwapRedBlue},
+    {"R8Unorm to RGBA8Unorm", PixelFormat::R8Unorm, PixelFormat::RGBA8Unorm, {}},
+    {"RGB16UI to RGBA16UI", PixelFormat::RGB16UI, PixelFormat::RGBA16UI, {}},
+    {"RGBA32UI to RGBA32I", PixelFormat::RGBA32UI, PixelFormat::RGBA32I, {}},
+    {"RGBA8UI to RGBA16UI", PixelFormat::RGBA8UI, PixelFormat::RGBA16UI, {}},
+    {"RGB16I to RGBA8UI", PixelFormat::RGB16I, PixelFormat::RGBA8UI, {}},
+    {"RGBA8Unorm to RGBA32F", PixelFormat::RGBA8Unorm, PixelFormat::RGBA32F, {}},
+    {"RGBA8Srgb to RGBA32F", PixelFormat::RGBA8Srgb, PixelFormat::RGBA32F, {}},
+    {"RGBA16F to RGBA32F", PixelFormat::RGBA16F, PixelFormat::RGBA32F, {}},
+    {"RGBA32F to RGBA16F", PixelFormat::RGBA32F, PixelFormat::RGBA16F, {}},
+    {"RGBA32F to RGBA8Unorm", PixelFormat::RGBA32F, PixelFormat::RGBA8Unorm, {}},
+    {"RGBA32F to RGBA8Srgb", PixelFormat::RGBA32F, PixelFormat::RGBA8Srgb, {}},
+    {"RGBA8Unorm to RGBA16Unorm", PixelFormat::RGBA8Unorm, PixelFormat::RGBA16Unorm, {}},
+    {"RGB8Unorm to RGBA32F", PixelFormat::RGB8Unorm, PixelFormat::RGBA32F, {}},
+    {"R8UI to RGBA32F", PixelFormat::R8UI, PixelFormat::RGBA32F, {}}
+};
+
+PixelFormatConversionBenchmark::PixelFormatConversionBenchmark() {
+    addInstancedBenchmarks({&PixelFormatConversionBenchmark::convert}, 10,
+        Containers::arraySize(Data));
+
+    addBenchmarks({&PixelFormatConversionBenchmark::swapRedBlueGather}, 10);
+}
+
+Image2D input(const PixelFormat format) {
+    Containers::Array<Color4ub> pixels{Containers::NoInit, std::size_t(Size.product())};
+    for(std::size_t i = 0; i != pixels.size(); ++i)
+        pixels[i] = Color4ub{UnsignedByte(i*7919 + 13), UnsignedByte(i*31), UnsignedByte(i), UnsignedByte(i*3 + 1)};
+    return convertPixelFormat(ImageView2D{PixelFormat::RGBA8Unorm, Size, pixels}, format);
+}
+
+void PixelFormatConversionBenchmark::convert() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Image2D source = input(data.source);
+    Image2D destination = convertPixelFormat(source, data.destination, data.flags);
+
+    CORRADE_BENCHMARK(1)
+        convertPixelFormatInto(source, destination, data.flags);
+
+    CORRADE_COMPARE(destination.size(), Size);
+}
+
+/* The per-pixel loop TgaImporter used to do before */
+void PixelFormatConversionBenchmark::swapRedBlueGather() {
+    Image2D image = input(PixelFormat::RGB8Unorm);
+
+    CORRADE_BENCHMARK(1)
+        for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(image.data()))
+            pixel = Math::gather<'b', 'g', 'r'>(pixel);
+
+    CORRADE_COMPARE(image.size(), Size);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::PixelFormatConversionBenchmark)
@@ -0,0 +1,416 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/PixelFormatConversion.h"
+#include "Magnum/Math/Color.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct PixelFormatConversionTest: TestSuite::Tester {
+    explicit PixelFormatConversionTest();
+
+    void debugFlag();
+    void debugFlags();
+
+    void sameFormat();
+    void remap8();
+    void remap8InPlace();
+    void remap16();
+    void halfToFloat();
+    void floatToUnorm();
+    void srgb();
+    void floatToIntegral();
+    void integralToIntegral();
+    void integralToIntegralRemap();
+    void unormToUnorm16();
+    void integralToFloatBroadcast();
+    void zeroSize();
+
+    void convertAllocate();
+
+    void invalidFormat();
+    void invalidSize();
+    void invalidSwapRedBlue();
+};
+
+/* 21 pixels is enough for the SIMD code to process a few blocks and leave a
+   few pixels for the scalar code */
+constexpr std::size_t Width = 21;
+
+const struct {
+    const char* name;
+    PixelFormat source, destination;
+    PixelFormatConversionFlags flags;
+    UnsignedInt sourceChannels, destinationChannels;
+    Int expected[4]; /* source channel or -1 for zero, -2 for 0xff */
+} Remap8Data[]{
+    {"RGB to RGBA", PixelFormat::RGB8Unorm, PixelFormat::RGBA8Unorm, {},
+        3, 4, {0, 1, 2, -2}},
+    {"BGR to RGBA", PixelFormat::RGB8Unorm, PixelFormat::RGBA8Unorm, PixelFormatConversionFlag::SwapRedBlue,
+        3, 4, {2, 1, 0, -2}},
+    {"BGRA to RGB", PixelFormat::RGBA8Unorm, PixelFormat::RGB8Unorm, PixelFormatConversionFlag::SwapRedBlue,
+        4, 3, {2, 1, 0}},
+    {"BGRA to RGBA", PixelFormat::RGBA8Srgb, PixelFormat::RGBA8Srgb, PixelFormatConversionFlag::SwapRedBlue,
+        4, 4, {2, 1, 0, 3}},
+    {"R to RGBA", PixelFormat::R8Unorm, PixelFormat::RGBA8Unorm, {},
+        1, 4, {0, 0, 0, -2}},
+    {"R to RGB", PixelFormat::R8Unorm, PixelFormat::RGB8Unorm, {},
+        1, 3, {0, 0, 0}},
+    {"RG to RGBA", PixelFormat::RG8Unorm, PixelFormat::RGBA8Unorm, {},
+        2, 4, {0, 1, -1, -2}},
+    {"RGBA to R", PixelFormat::RGBA8Unorm, PixelFormat::R8Unorm, {},
+        4, 1, {0}},
+    {"RGBA to RG", PixelFormat::RGBA8Unorm, PixelFormat::RG8Unorm, {},
+        4, 2, {0, 1}},
+};
+
+PixelFormatConversionTest::PixelFormatConversionTest() {
+    addTests({&PixelFormatConversionTest::debugFlag,
+              &PixelFormatConversionTest::debugFlags,
+
+              &PixelFormatConversionTest::sameFormat});
+
+    addInstancedTests({&PixelFormatConversionTest::remap8},
+        Containers::arraySize(Remap8Data));
+
+    addTests({&PixelFormatConversionTest::remap8InPlace,
+              &PixelFormatConversionTest::remap16,
+              &PixelFormatConversionTest::halfToFloat,
+              &PixelFormatConversionTest::floatToUnorm,
+              &PixelFormatConversionTest::srgb,
+              &PixelFormatConversionTest::floatToIntegral,
+              &PixelFormatConversionTest::integralToIntegral,
+              &PixelFormatConversionTest::integralToIntegralRemap,
+              &PixelFormatConversionTest::unormToUnorm16,
+              &PixelFormatConversionTest::integralToFloatBroadcast,
+              &PixelFormatConversionTest::zeroSize,
+
+              &PixelFormatConversionTest::convertAllocate,
+
+              &PixelFormatConversionTest::invalidFormat,
+              &PixelFormatConversionTest::invalidSize,
+              &PixelFormatConversionTest::invalidSwapRedBlue});
+}
+
+void PixelFormatConversionTest::debugFlag() {
+    std::ostringstream out;
+    Debug{&out} << PixelFormatConversionFlag::SwapRedBlue << PixelFormatConversionFlag(0xf0);
+    CORRADE_COMPARE(out.str(), "PixelFormatConversionFlag::SwapRedBlue PixelFormatConversionFlag(0xf0)\n");
+}
+
+void PixelFormatConversionTest::debugFlags() {
+    std::ostringstream out;
+    Debug{&out} << (PixelFormatConversionFlag::SwapRedBlue|PixelFormatConversionFlag(0xf0)) << PixelFormatConversionFlags{};
+    CORRADE_COMPARE(out.str(), "PixelFormatConversionFlag::SwapRedBlue|PixelFormatConversionFlag(0xf0) PixelFormatConversionFlags{}\n");
+}
+
+void PixelFormatConversionTest::sameFormat() {
+    /* Tightly packed rows, nine bytes each */
+    const UnsignedByte pixels[]{
+        0x00, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80,
+        0x90, 0xa0, 0xb0, 0xc0, 0xd0, 0xe0, 0xf0, 0xff, 0xee
+    };
+    const ImageView2D image{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {3, 2}, pixels};
+
+    /* The output has rows aligned to four bytes */
+    Image2D out = convertPixelFormat(image, PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(out.storage().alignment(), 4);
+    CORRADE_COMPARE(out.data().size(), 24);
+    CORRADE_COMPARE_AS(out.pixels<Color3ub>()[0],
+        image.pixels<Color3ub>()[0],
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.pixels<Color3ub>()[1],
+        image.pixels<Color3ub>()[1],
+        TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::remap8() {
+    auto&& data = Remap8Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Two rows, the second with a different content and the storage skipping
+       a row and a few pixels */
+    UnsignedByte pixels[3*4*(Width + 3)];
+    for(std::size_t i = 0; i != Containers::arraySize(pixels); ++i)
+        pixels[i] = UnsignedByte(i*7 + 3);
+    const ImageView2D image{PixelStorage{}
+        .setRowLength(Width + 3)
+        .setSkip({2, 1, 0}), data.source, {Width - 3, 2}, pixels};
+
+    Image2D out = convertPixelFormat(image, data.destination, data.flags);
+    CORRADE_COMPARE(out.format(), data.destination);
+    CORRADE_COMPARE(out.size(), (Vector2i{Width - 3, 2}));
+
+    const Containers::StridedArrayView3D<const UnsignedByte> src = Containers::arrayCast<3, const UnsignedByte>(image.pixels());
+    const Containers::StridedArrayView3D<const UnsignedByte> dst = Containers::arrayCast<3, const UnsignedByte>(out.pixels());
+    CORRADE_COMPARE(src.size()[2], data.sourceChannels);
+    CORRADE_COMPARE(dst.size()[2], data.destinationChannels);
+    for(std::size_t y = 0; y != 2; ++y) for(std::size_t x = 0; x != Width - 3; ++x) {
+        CORRADE_ITERATION(x << y);
+        for(std::size_t c = 0; c != data.destinationChannels; ++c) {
+            const Int expected = data.expected[c];
+            CORRADE_COMPARE(dst[y][x][c], UnsignedByte(
+                expected == -1 ? 0x00 :
+                expected == -2 ? 0xff : src[y][x][expected]));
+        }
+    }
+}
+
+void PixelFormatConversionTest::remap8InPlace() {
+    Color4ub pixels[Width];
+    for(std::size_t i = 0; i != Width; ++i)
+        pixels[i] = {UnsignedByte(i), UnsignedByte(i + 0x40), UnsignedByte(i + 0x80), UnsignedByte(i + 0xc0)};
+
+    const MutableImageView2D image{PixelFormat::RGBA8Unorm, {Width, 1}, pixels};
+    convertPixelFormatInto(image, image, PixelFormatConversionFlag::SwapRedBlue);
+    for(std::size_t i = 0; i != Width; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(pixels[i], (Color4ub{UnsignedByte(i + 0x80), UnsignedByte(i + 0x40), UnsignedByte(i), UnsignedByte(i + 0xc0)}));
+    }
+}
+
+void PixelFormatConversionTest::remap16() {
+    const Math::Vector3<UnsignedShort> pixels[]{
+        {1000, 2000, 3000},
+        {65535, 0, 12345}
+    };
+    const Math::Vector4<UnsignedShort> expected[]{
+        {3000, 2000, 1000, 1},
+        {12345, 0, 65535, 1}
+    };
+
+    /* Missing alpha is one for integer formats as well */
+    Image2D out = convertPixelFormat(ImageView2D{PixelFormat::RGB16UI, {2, 1}, pixels}, PixelFormat::RGBA16UI, PixelFormatConversionFlag::SwapRedBlue);
+    CORRADE_COMPARE_AS(out.pixels<Math::Vector4<UnsignedShort>>()[0],
+        Containers::stridedArrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::halfToFloat() {
+    /* 1.0, -2.0, 0.5, 65504.0 */
+    const UnsignedShort pixels[]{0x3c00, 0xc000, 0x3800, 0x7bff};
+    const Color4 expected[]{{1.0f, -2.0f, 0.5f, 65504.0f}};
+
+    Image2D out = convertPixelFormat(ImageView2D{PixelFormat::RGBA16F, {1, 1}, pixels}, PixelFormat::RGBA32F);
+    CORRADE_COMPARE_AS(out.pixels<Color4>()[0],
+        Containers::stridedArrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::floatToUnorm() {
+    /* Out-of-range values are clamped, alpha is added */
+    const Color3 pixels[]{
+        {-0.5f, 0.5f, 1.5f},
+        {0.0f, 1.0f, 0.25f}
+    };
+    const Color4ub expected[]{
+        {0x00, 0x80, 0xff, 0xff},
+        {0x00, 0xff, 0x40, 0xff}
+    };
+
+    Image2D out = convertPixelFormat(ImageView2D{PixelFormat::RGB32F, {2, 1}, pixels}, PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE_AS(out.pixels<Color4ub>()[0],
+        Containers::stridedArrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::srgb() {
+    const Color4ub pixels[]{
+        {0x00, 0x40, 0xbc, 0x80},
+        {0xff, 0x10, 0x20, 0x40}
+    };
+
+    /* Color channels are converted to linear, alpha stays */
+    Image2D linear = convertPixelFormat(ImageView2D{PixelFormat::RGBA8Srgb, {2, 1}, pixels}, PixelFormat::RGBA32F);
+    for(std::size_t i = 0; i != 2; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(linear.pixels<Color4>()[0][i], Color4::fromSrgbAlpha(pixels[i]));
+    }
+
+    /* And back */
+    Image2D srgb = convertPixelFormat(linear, PixelFormat::RGBA8Srgb);
+    CORRADE_COMPARE_AS(srgb.pixels<Color4ub>()[0],
+        Containers::stridedArrayView(pixels),
+        TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::floatToIntegral() {
+    /* Rounded to nearest, halfway cases away from zero, clamped */
+    const Float pixels[]{-200.0f, -1.5f, 2.5f, 300.0f};
+    const Byte expected[]{-128, -2, 3, 127};
+
+    Image2D out = convertPixelFormat(ImageView2D{PixelFormat::R32F, {4, 1}, pixels}, PixelFormat::R8I);
+    CORRADE_COMPARE_AS(out.pixels<Byte>()[0],
+        Containers::stridedArrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::integralToIntegral() {
+    /* Values above 2^24 aren't representable in a float, so this verifies
+       they don't go through one. Out-of-range values are clamped. */
+    const Math::Vector4<UnsignedInt> pixels[]{
+        {16777217u, 2147483647u, 2147483648u, 4294967295u},
+        {0u, 1u, 16777216u, 33554433u}
+    };
+    const Vector4i expected[]{
+        {16777217, 2147483647, 2147483647, 2147483647},
+        {0, 1, 16777216, 33554433}
+    };
+
+    Image2D out = convertPixelFormat(ImageView2D{PixelFormat::RGBA32UI, {2, 1}, pixels}, PixelFormat::RGBA32I);
+    CORRADE_COMPARE_AS(out.pixels<Vector4i>()[0],
+        Containers::stridedArrayView(expected),
+        TestSuite::Compare::Container);
+
+    /* And back, negative values clamped to zero */
+    const Vector4i negative[]{{-16777217, 16777217, -1, 2147483647}};
+    const Math::Vector4<UnsignedInt> expectedUnsigned[]{{0u, 16777217u, 0u, 2147483647u}};
+    Image2D outUnsigned = convertPixelFormat(ImageView2D{PixelFormat::RGBA32I, {1, 1}, negative}, PixelFormat::RGBA32UI);
+    CORRADE_COMPARE_AS(outUnsigned.pixels<Math::Vector4<UnsignedInt>>()[0],
+        Containers::stridedArrayView(expectedUnsigned),
+        TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::integralToIntegralRemap() {
+    /* Missing alpha is one, values clamped to the smaller type */
+    const Math::Vector3<UnsignedInt> pixels[]{
+        {16777217u, 70000u, 5u}
+    };
+    const Math::Vector4<UnsignedShort> expected[]{
+        {5, 65535, 65535, 1}
+    };
+
+    Image2D out = convertPixelFormat(ImageView2D{PixelFormat::RGB32UI, {1, 1}, pixels}, PixelFormat::RGBA16UI, PixelFormatConversionFlag::SwapRedBlue);
+    CORRADE_COMPARE_AS(out.pixels<Math::Vector4<UnsignedShort>>()[0],
+        Containers::stridedArrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::unormToUnorm16() {
+    const Color4ub pixels[]{{0x00, 0x80, 0xff, 0x01}};
+    const Math::Vector4<UnsignedShort> expected[]{{0x0000, 0x8080, 0xffff, 0x0101}};
+
+    Image2D out = convertPixelFormat(ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, pixels}, PixelFormat::RGBA16Unorm);
+    CORRADE_COMPARE_AS(out.pixels<Math::Vector4<UnsignedShort>>()[0],
+        Containers::stridedArrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::integralToFloatBroadcast() {
+    const UnsignedByte pixels[]{5, 200, 0, 0};
+    const Color4 expected[]{
+        {5.0f, 5.0f, 5.0f, 1.0f},
+        {200.0f, 200.0f, 200.0f, 1.0f}
+    };
+
+    Image2D out = convertPixelFormat(ImageView2D{PixelFormat::R8UI, {2, 1}, pixels}, PixelFormat::RGBA32F);
+    CORRADE_COMPARE_AS(out.pixels<Color4>()[0],
+        Containers::stridedArrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void PixelFormatConversionTest::zeroSize() {
+    const Color4ub pixels[1]{};
+
+    Image2D out = convertPixelFormat(ImageView2D{PixelFormat::RGBA8Unorm, {0, 1}, pixels}, PixelFormat::RGBA32F);
+    CORRADE_COMPARE(out.size(), (Vector2i{0, 1}));
+    CORRADE_COMPARE(out.data().size(), 0);
+}
+
+void PixelFormatConversionTest::convertAllocate() {
+    const Color3ub pixels[]{{0x10, 0x20, 0x30}, {}};
+
+    Image2D out = convertPixelFormat(ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {1, 2}, pixels}, PixelFormat::RG16F);
+    CORRADE_COMPARE(out.format(), PixelFormat::RG16F);
+    CORRADE_COMPARE(out.size(), (Vector2i{1, 2}));
+    CORRADE_COMPARE(out.storage().alignment(), 4);
+    CORRADE_COMPARE(out.data().size(), 8);
+}
+
+void PixelFormatConversionTest::invalidFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char data[4]{};
+    char mutableData[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    convertPixelFormatInto(
+        ImageView2D{PixelStorage{}, pixelFormatWrap(0xdead), 0, 4, {1, 1}, data},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, mutableData});
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data},
+        MutableImageView2D{PixelStorage{}, pixelFormatWrap(0xbeef), 0, 4, {1, 1}, mutableData});
+    convertPixelFormat(ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data}, pixelFormatWrap(0xcafe));
+    CORRADE_COMPARE(out.str(),
+        "convertPixelFormatInto(): can't convert from an implementation-specific format 0xdead\n"
+        "convertPixelFormatInto(): can't convert to an implementation-specific format 0xbeef\n"
+        "convertPixelFormat(): can't convert to an implementation-specific format 0xcafe\n");
+}
+
+void PixelFormatConversionTest::invalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char data[8]{};
+    char mutableData[8]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, data},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 2}, mutableData});
+    CORRADE_COMPARE(out.str(), "convertPixelFormatInto(): expected destination size Vector(2, 1) but got Vector(1, 2)\n");
+}
+
+void PixelFormatConversionTest::invalidSwapRedBlue() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char data[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    convertPixelFormat(ImageView2D{PixelFormat::RG16F, {1, 1}, data}, PixelFormat::RGBA8Unorm, PixelFormatConversionFlag::SwapRedBlue);
+    CORRADE_COMPARE(out.str(), "convertPixelFormatInto(): can't swap red and blue channels of PixelFormat::RG16F\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::PixelFormatConversionTest)
@@ -25,9 +25,11 @@
 
 #include "AbstractFont.h"
 
+#include <algorithm>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Unicode.h>
@@ -243,7 +245,36 @@ void AbstractFont::fillGlyphCache(AbstractGlyphCache& cache, const std::string&
     CORRADE_ASSERT(!(features() & FontFeature::PreparedGlyphCache),
         "Text::AbstractFont::fillGlyphCache(): feature not supported", );
 
-    doFillGlyphCache(cache, Utility::Unicode::utf32(characters));
+    if(!cache.isDynamic()) {
+        doFillGlyphCache(cache, Utility::Unicode::utf32(characters));
+        return;
+    }
+
+    /* In a dynamic cache, mark glyphs that are already there as used and
+       pass just the missing ones to the implementation, each only once */
+    std::vector<std::pair<UnsignedInt, char32_t>> missing;
+    for(const char32_t character: Utility::Unicode::utf32(characters)) {
+        const UnsignedInt glyph = doGlyphId(character);
+        if(!cache.markUsed(glyph)) missing.emplace_back(glyph, character);
+    }
+    std::stable_sort(missing.begin(), missing.end(),
+        [](const std::pair<UnsignedInt, char32_t>& a, const std::pair<UnsignedInt, char32_t>& b) {
+            return a.first < b.first;
+        });
+    missing.erase(std::unique(missing.begin(), missing.end(),
+        [](const std::pair<UnsignedInt, char32_t>& a, const std::pair<UnsignedInt, char32_t>& b) {
+            return a.first == b.first;
+        }), missing.end());
+
+    if(!missing.empty()) {
+        std::u32string missingCharacters;
+        missingCharacters.reserve(missing.size());
+        for(const std::pair<UnsignedInt, char32_t>& glyph: missing)
+            missingCharacters.push_back(glyph.second);
+        doFillGlyphCache(cache, missingCharacters);
+    }
+
+    cache.flushImage();
 }
 
 void AbstractFont::doFillGlyphCache(AbstractGlyphCache&, const std::u32string&) {
@@ -269,6 +300,30 @@ Containers::Pointer<AbstractLayouter> AbstractFont::layout(const AbstractGlyphCa
     return doLayout(cache, size, text);
 }
 
+UnsignedInt AbstractFont::layoutGlyphs(const Containers::ArrayView<const char> text, const Containers::StridedArrayView1D<UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<Vector2>& glyphOffsets, const Containers::StridedArrayView1D<Vector2>& glyphAdvances) {
+    CORRADE_ASSERT(isOpened(), "Text::AbstractFont::layoutGlyphs(): no font opened", {});
+    CORRADE_ASSERT(glyphOffsets.size() == glyphIds.size() && glyphAdvances.size() == glyphIds.size(),
+        "Text::AbstractFont::layoutGlyphs(): expected glyph ID, offset and advance views to have the same size but got" << glyphIds.size() << Debug::nospace << "," << glyphOffsets.size() << "and" << glyphAdvances.size(), {});
+
+    return doLayoutGlyphs(text, glyphIds, glyphOffsets, glyphAdvances);
+}
+
+UnsignedInt AbstractFont::doLayoutGlyphs(const Containers::ArrayView<const char> text, const Containers::StridedArrayView1D<UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<Vector2>& glyphOffsets, const Containers::StridedArrayView1D<Vector2>& glyphAdvances) {
+    UnsignedInt count = 0;
+    for(std::size_t i = 0; i != text.size(); ++count) {
+        char32_t codepoint;
+        std::tie(codepoint, i) = Utility::Unicode::nextChar(text, i);
+        if(count >= glyphIds.size()) continue;
+
+        const UnsignedInt glyph = doGlyphId(codepoint);
+        glyphIds[count] = glyph;
+        glyphOffsets[count] = {};
+        glyphAdvances[count] = doGlyphAdvance(glyph);
+    }
+
+    return count;
+}
+
 Debug& operator<<(Debug& debug, const FontFeature value) {
     debug << "Text::FontFeature" << Debug::nospace;
 
@@ -278,6 +333,7 @@ Debug& operator<<(Debug& debug, const FontFeature value) {
         _c(OpenData)
         _c(FileCallback)
         _c(PreparedGlyphCache)
+        _c(BatchLayout)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -289,7 +345,8 @@ Debug& operator<<(Debug& debug, const FontFeatures value) {
     return Containers::enumSetDebugOutput(debug, value, "Text::FontFeatures{}", {
         FontFeature::OpenData,
         FontFeature::FileCallback,
-        FontFeature::PreparedGlyphCache});
+        FontFeature::PreparedGlyphCache,
+        FontFeature::BatchLayout});
 }
 
 AbstractLayouter::AbstractLayouter(UnsignedInt glyphCount): _glyphCount(glyphCount) {}
@@ -78,7 +78,18 @@ enum class FontFeature: UnsignedByte {
      * @see @ref AbstractFont::fillGlyphCache(),
      *      @ref AbstractFont::createGlyphCache()
      */
-    PreparedGlyphCache = 1 << 2
+    PreparedGlyphCache = 1 << 2,
+
+    /**
+     * Laying out whole text runs into caller-provided arrays using
+     * @ref AbstractFont::layoutGlyphs() with the same result as
+     * @ref AbstractFont::layout(). If the font doesn't expose this feature,
+     * @ref AbstractFont::layoutGlyphs() falls back to a generic
+     * implementation that doesn't do any kerning or shaping and
+     * @ref Renderer uses @ref AbstractFont::layout() instead.
+     * @m_since_latest
+     */
+    BatchLayout = 1 << 3
 };
 
 /**
@@ -154,6 +165,8 @@ code reuse.
 The plugin implements @ref doFeatures(), @ref doClose(), @ref doLayout(),
 either @ref doCreateGlyphCache() or @ref doFillGlyphCache() and one or more of
 `doOpen*()` functions. See also @ref AbstractLayouter for more information.
+Fonts that can lay out a whole text run without allocating should also
+implement @ref doLayoutGlyphs() and advertise @ref FontFeature::BatchLayout.
 
 You don't need to do most of the redundant sanity checks, these things are
 checked by the implementation:
@@ -415,6 +428,12 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
          * @ref FontFeature::PreparedGlyphCache do not support partial glyph
          * cache filling, use @ref createGlyphCache() instead. Expects that a
          * font is opened.
+         *
+         * If the cache is @ref Text-AbstractGlyphCache-dynamic "dynamic",
+         * glyphs that are already in the cache are only marked as used in
+         * current frame, @ref doFillGlyphCache() gets called only with
+         * characters for glyphs that are missing, each glyph just once, and
+         * @ref AbstractGlyphCache::flushImage() is called at the end.
          */
         void fillGlyphCache(AbstractGlyphCache& cache, const std::string& characters);
 
@@ -441,6 +460,36 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
          */
         Containers::Pointer<AbstractLayouter> layout(const AbstractGlyphCache& cache, Float size, const std::string& text);
 
+        /**
+         * @brief Layout glyphs of a text run into caller-provided arrays
+         * @param text          UTF-8 text to layout
+         * @param glyphIds      Where to put glyph IDs
+         * @param glyphOffsets  Where to put glyph offsets relative to the
+         *      cursor position
+         * @param glyphAdvances Where to put cursor advance after each glyph
+         * @return Count of glyphs the text got laid out into
+         * @m_since_latest
+         *
+         * Unlike @ref layout(), doesn't allocate anything and doesn't depend
+         * on a particular glyph cache or text size --- the offsets and
+         * advances are in font units, multiply them by the desired text size
+         * divided by @ref size() to get the actual values. Use
+         * @ref renderGlyphQuadsInto() to turn the output into vertex data.
+         *
+         * The views are expected to have the same size. If the returned count
+         * is larger than their size, only the glyphs that fit were written
+         * and the call should be repeated with larger views. For fonts
+         * mapping each character to a single glyph the byte size of @p text
+         * is a safe upper bound. Similarly to @ref layout(), only single-line
+         * text is supported. Expects that a font is opened.
+         *
+         * If the font doesn't support @ref FontFeature::BatchLayout, the
+         * glyphs are queried for each character through @ref glyphId() and
+         * @ref glyphAdvance() and the offsets are set to zero.
+         * @see @ref features()
+         */
+        UnsignedInt layoutGlyphs(Containers::ArrayView<const char> text, const Containers::StridedArrayView1D<UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<Vector2>& glyphOffsets, const Containers::StridedArrayView1D<Vector2>& glyphAdvances);
+
     protected:
         /**
          * @brief Font metrics
@@ -537,7 +586,13 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
          * @brief Implementation for @ref fillGlyphCache()
          *
          * The string is converted from UTF-8 to UTF-32, unique characters are
-         * *not* removed.
+         * *not* removed, except for
+         * @ref Text-AbstractGlyphCache-dynamic "dynamic glyph caches". To
+         * support dynamic caches, the implementation should be able to work
+         * with a cache that already contains other glyphs, calling
+         * @ref AbstractGlyphCache::reserve() just once and uploading glyph
+         * images with @ref AbstractGlyphCache::setImage() either for the
+         * reserved rectangles or for the whole texture.
          */
         virtual void doFillGlyphCache(AbstractGlyphCache& cache, const std::u32string& characters);
 
@@ -547,6 +602,20 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
         /** @brief Implementation for @ref layout() */
         virtual Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache& cache, Float size, const std::string& text) = 0;
 
+        /**
+         * @brief Implementation for @ref layoutGlyphs()
+         * @m_since_latest
+         *
+         * The views are guaranteed to have the same size. Implementations
+         * are expected to write at most as many glyphs as fit into the views
+         * and return the total glyph count. Default implementation calls
+         * @ref doGlyphId() and @ref doGlyphAdvance() for each character and
+         * sets the offsets to zero. Implementations advertising
+         * @ref FontFeature::BatchLayout are expected to produce the same
+         * result as @ref doLayout().
+         */
+        virtual UnsignedInt doLayoutGlyphs(Containers::ArrayView<const char> text, const Containers::StridedArrayView1D<UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<Vector2>& glyphOffsets, const Containers::StridedArrayView1D<Vector2>& glyphAdvances);
+
         Containers::Optional<Containers::ArrayView<const char>>(*_fileCallback)(const std::string&, InputFileCallbackPolicy, void*){};
         void* _fileCallbackUserData{};
 
@@ -25,6 +25,11 @@
 
 #include "AbstractGlyphCache.h"
 
+#include <algorithm>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
@@ -32,36 +37,347 @@
 
 namespace Magnum { namespace Text {
 
+struct AbstractGlyphCache::Dynamic {
+    /* A row of glyphs of similar height. Glyphs are added at x until the row
+       is full, evicted glyphs leave free spans that get reused. */
+    struct Shelf {
+        Int y, height, x;
+        UnsignedInt glyphCount;
+        std::vector<Range1Di> free;
+    };
+
+    bool allocate(const Vector2i& textureSize, const Vector2i& size, Range2Di& rectangle, UnsignedInt& shelfId);
+    void release(UnsignedInt shelfId, const Range2Di& rectangle);
+
+    UnsignedInt frame{};
+    std::vector<Shelf> shelves;
+
+    /* Frame in which a glyph was last used and the shelf it's in, ~0 if
+       it's not occupying any space. Indexed the same as _glyphs. */
+    std::vector<UnsignedInt> lastUsed, glyphShelves;
+
+    /* Rectangles (including padding) returned from the last reserve() that
+       weren't passed to insert() yet, together with their shelf */
+    std::vector<std::pair<Range2Di, UnsignedInt>> reserved;
+
+    /* Rectangles (including padding) reserved since the last flushImage().
+       Only these are copied from images passed to setImage(). */
+    std::vector<Range2Di> updated;
+
+    Containers::Optional<Image2D> image;
+    Range2Di dirty;
+};
+
+bool AbstractGlyphCache::Dynamic::allocate(const Vector2i& textureSize, const Vector2i& size, Range2Di& rectangle, UnsignedInt& shelfId) {
+    /* Pick the lowest shelf that's high enough and has space. Shelves that
+       are much higher than the glyph are skipped to not waste space, unless
+       they're completely empty. */
+    shelfId = ~UnsignedInt{};
+    std::size_t spanId = ~std::size_t{};
+    for(std::size_t i = 0; i != shelves.size(); ++i) {
+        const Shelf& shelf = shelves[i];
+        if(shelf.height < size.y() || (shelf.glyphCount && shelf.height > 2*size.y()))
+            continue;
+        if(shelfId != ~UnsignedInt{} && shelves[shelfId].height <= shelf.height)
+            continue;
+
+        /* First fit among free spans, then at the end of the shelf */
+        std::size_t span = ~std::size_t{};
+        for(std::size_t j = 0; j != shelf.free.size(); ++j) if(shelf.free[j].size() >= size.x()) {
+            span = j;
+            break;
+        }
+        if(span == ~std::size_t{} && shelf.x + size.x() > textureSize.x())
+            continue;
+
+        shelfId = i;
+        spanId = span;
+    }
+
+    Int x;
+
+    /* Found an existing shelf, take either from a free span or from the
+       end */
+    if(shelfId != ~UnsignedInt{}) {
+        Shelf& shelf = shelves[shelfId];
+        if(spanId != ~std::size_t{}) {
+            Range1Di& span = shelf.free[spanId];
+            x = span.min();
+            if(span.size() == size.x())
+                shelf.free.erase(shelf.free.begin() + spanId);
+            else span = {x + size.x(), span.max()};
+        } else {
+            x = shelf.x;
+            shelf.x += size.x();
+        }
+
+    /* Otherwise open a new shelf on top, if there's space */
+    } else {
+        const Int y = shelves.empty() ? 0 : shelves.back().y + shelves.back().height;
+        if(y + size.y() > textureSize.y() || size.x() > textureSize.x())
+            return false;
+
+        shelfId = shelves.size();
+        shelves.push_back(Shelf{y, size.y(), size.x(), 0, {}});
+        x = 0;
+    }
+
+    ++shelves[shelfId].glyphCount;
+    rectangle = Range2Di::fromSize({x, shelves[shelfId].y}, size);
+    return true;
+}
+
+void AbstractGlyphCache::Dynamic::release(const UnsignedInt shelfId, const Range2Di& rectangle) {
+    Shelf& shelf = shelves[shelfId];
+    CORRADE_INTERNAL_ASSERT(shelf.glyphCount);
+
+    /* Last glyph in the shelf, make it completely free again. Empty shelves
+       on the top are removed so their space can be used by higher glyphs. */
+    if(!--shelf.glyphCount) {
+        shelf.x = 0;
+        shelf.free.clear();
+        while(!shelves.empty() && !shelves.back().glyphCount)
+            shelves.pop_back();
+        return;
+    }
+
+    /* Add a free span, merge it with neighbors and if it's at the end of the
+       shelf, give the space back */
+    shelf.free.push_back({rectangle.left(), rectangle.right()});
+    std::sort(shelf.free.begin(), shelf.free.end(), [](const Range1Di& a, const Range1Di& b) {
+        return a.min() < b.min();
+    });
+    std::size_t out = 0;
+    for(std::size_t i = 1; i != shelf.free.size(); ++i) {
+        if(shelf.free[out].max() == shelf.free[i].min())
+            shelf.free[out] = {shelf.free[out].min(), shelf.free[i].max()};
+        else shelf.free[++out] = shelf.free[i];
+    }
+    shelf.free.resize(out + 1);
+    if(shelf.free.back().max() == shelf.x) {
+        shelf.x = shelf.free.back().min();
+        shelf.free.pop_back();
+    }
+}
+
 AbstractGlyphCache::AbstractGlyphCache(const Vector2i& size, const Vector2i& padding): _size{size}, _padding{padding} {
-    /* Default "Not Found" glyph. Can't do just `.insert({0, {}})` because
-       that's ambiguous in C++17, due to a new insert(node_type&&) overload. */
-    glyphs.insert({0, std::pair<Vector2i, Range2Di>{}});
+    /* Default "Not Found" glyph, always at index 0 */
+    _glyphs.emplace_back(0, std::pair<Vector2i, Range2Di>{});
+    _glyphIndices.push_back(0);
 }
 
 AbstractGlyphCache::~AbstractGlyphCache() = default;
 
+void AbstractGlyphCache::setDynamic(const bool dynamic) {
+    CORRADE_ASSERT(_glyphs.size() == 1,
+        "Text::AbstractGlyphCache::setDynamic(): the cache is not empty", );
+
+    if(!dynamic) {
+        _dynamic = nullptr;
+        return;
+    }
+
+    _dynamic.emplace();
+    _dynamic->lastUsed.push_back(0);
+    _dynamic->glyphShelves.push_back(~UnsignedInt{});
+}
+
+UnsignedInt AbstractGlyphCache::frame() const {
+    CORRADE_ASSERT(_dynamic,
+        "Text::AbstractGlyphCache::frame(): the cache is not dynamic", {});
+    return _dynamic->frame;
+}
+
+void AbstractGlyphCache::nextFrame() {
+    CORRADE_ASSERT(_dynamic,
+        "Text::AbstractGlyphCache::nextFrame(): the cache is not dynamic", );
+    ++_dynamic->frame;
+}
+
+bool AbstractGlyphCache::markUsed(const UnsignedInt glyph) {
+    CORRADE_ASSERT(_dynamic,
+        "Text::AbstractGlyphCache::markUsed(): the cache is not dynamic", {});
+
+    /* Zero index means the glyph isn't there, except for glyph 0 itself */
+    if(glyph >= _glyphIndices.size()) return false;
+    const UnsignedInt index = _glyphIndices[glyph];
+    if(!index && glyph) return false;
+
+    _dynamic->lastUsed[index] = _dynamic->frame;
+    return true;
+}
+
+void AbstractGlyphCache::evict(const UnsignedInt glyph) {
+    const UnsignedInt index = _glyphIndices[glyph];
+    CORRADE_INTERNAL_ASSERT(index);
+
+    if(_dynamic->glyphShelves[index] != ~UnsignedInt{})
+        _dynamic->release(_dynamic->glyphShelves[index], _glyphs[index].second.second);
+
+    /* Move the last glyph in place of the evicted one */
+    const std::size_t last = _glyphs.size() - 1;
+    if(index != last) {
+        _glyphs[index] = _glyphs[last];
+        _dynamic->lastUsed[index] = _dynamic->lastUsed[last];
+        _dynamic->glyphShelves[index] = _dynamic->glyphShelves[last];
+        _glyphIndices[_glyphs[index].first] = index;
+    }
+    _glyphs.pop_back();
+    _dynamic->lastUsed.pop_back();
+    _dynamic->glyphShelves.pop_back();
+    _glyphIndices[glyph] = 0;
+}
+
 std::vector<Range2Di> AbstractGlyphCache::reserve(const std::vector<Vector2i>& sizes) {
-    CORRADE_ASSERT((glyphs.size() == 1 && glyphs.at(0) == std::pair<Vector2i, Range2Di>()),
+    if(_dynamic) {
+        /* Space reserved in the previous call but not used is given back */
+        for(const std::pair<Range2Di, UnsignedInt>& reserved: _dynamic->reserved)
+            _dynamic->release(reserved.second, reserved.first);
+        _dynamic->reserved.clear();
+
+        /* Glyphs that can be evicted, least recently used first. Gathered
+           only once the texture gets full. Storing glyph IDs and not indices
+           as those change during eviction. */
+        std::vector<UnsignedInt> evictable;
+        bool evictableGathered = false;
+        std::size_t nextEvictable = 0;
+
+        std::vector<Range2Di> out;
+        out.reserve(sizes.size());
+        for(const Vector2i& size: sizes) {
+            Range2Di rectangle;
+            UnsignedInt shelf;
+            bool allocated;
+            while(!(allocated = _dynamic->allocate(_size, size + 2*_padding, rectangle, shelf))) {
+                if(!evictableGathered) {
+                    for(std::size_t i = 1; i != _glyphs.size(); ++i)
+                        if(_dynamic->lastUsed[i] != _dynamic->frame)
+                            evictable.push_back(_glyphs[i].first);
+                    std::stable_sort(evictable.begin(), evictable.end(), [this](UnsignedInt a, UnsignedInt b) {
+                        return _dynamic->lastUsed[_glyphIndices[a]] < _dynamic->lastUsed[_glyphIndices[b]];
+                    });
+                    evictableGathered = true;
+                }
+
+                if(nextEvictable == evictable.size()) break;
+                evict(evictable[nextEvictable++]);
+            }
+
+            if(!allocated) {
+                out.emplace_back();
+                continue;
+            }
+
+            _dynamic->reserved.emplace_back(rectangle, shelf);
+            _dynamic->updated.push_back(rectangle);
+            out.push_back(rectangle.padded(-_padding));
+        }
+
+        return out;
+    }
+
+    CORRADE_ASSERT((_glyphs.size() == 1 && _glyphs[0].second == std::pair<Vector2i, Range2Di>()),
         "Text::AbstractGlyphCache::reserve(): reserving space in non-empty cache is not yet implemented", {});
-    glyphs.reserve(glyphs.size() + sizes.size());
+    _glyphs.reserve(_glyphs.size() + sizes.size());
     return TextureTools::atlas(_size, sizes, _padding);
 }
 
 void AbstractGlyphCache::insert(const UnsignedInt glyph, const Vector2i& position, const Range2Di& rectangle) {
     const std::pair<Vector2i, Range2Di> glyphData = {position-_padding, rectangle.padded(_padding)};
 
+    /* In a dynamic cache, find the shelf the rectangle was reserved in */
+    UnsignedInt shelf = ~UnsignedInt{};
+    if(_dynamic) {
+        auto found = std::find_if(_dynamic->reserved.begin(), _dynamic->reserved.end(), [&glyphData](const std::pair<Range2Di, UnsignedInt>& reserved) {
+            return reserved.first == glyphData.second;
+        });
+        if(found != _dynamic->reserved.end()) {
+            shelf = found->second;
+            _dynamic->reserved.erase(found);
+        } else CORRADE_ASSERT(rectangle.size().isZero(),
+            "Text::AbstractGlyphCache::insert(): rectangle" << rectangle << "wasn't reserved in a dynamic cache", );
+    }
+
     /* Overwriting "Not Found" glyph */
-    if(glyph == 0) glyphs[0] = glyphData;
+    if(glyph == 0) {
+        _glyphs[0].second = glyphData;
+        if(_dynamic) _dynamic->glyphShelves[0] = shelf;
+        return;
+    }
 
-    /* Inserting new glyph */
-    else CORRADE_INTERNAL_ASSERT_OUTPUT(glyphs.insert({glyph, glyphData}).second);
+    /* Inserting new glyph. Grow the index table to include the new ID, the
+       new entries pointing to the "Not Found" glyph. */
+    if(glyph >= _glyphIndices.size()) _glyphIndices.resize(glyph + 1, 0);
+    CORRADE_INTERNAL_ASSERT(!_glyphIndices[glyph]);
+    _glyphIndices[glyph] = _glyphs.size();
+    _glyphs.emplace_back(glyph, glyphData);
+    if(_dynamic) {
+        _dynamic->lastUsed.push_back(_dynamic->frame);
+        _dynamic->glyphShelves.push_back(shelf);
+    }
 }
 
 void AbstractGlyphCache::setImage(const Vector2i& offset, const ImageView2D& image) {
     CORRADE_ASSERT((offset >= Vector2i{} && offset + image.size() <= _size).all(),
         "Text::AbstractGlyphCache::setImage():" << Range2Di::fromSize(offset, image.size()) << "out of bounds for texture size" << _size, );
 
-    doSetImage(offset, image);
+    if(!_dynamic) {
+        doSetImage(offset, image);
+        return;
+    }
+
+    /* Make a CPU-side copy of the whole texture on first use. Tightly packed
+       to make the copying easier. */
+    if(!_dynamic->image) {
+        _dynamic->image.emplace(PixelStorage{}.setAlignment(1), image.format(), image.formatExtra(), image.pixelSize(), _size, Containers::Array<char>{Containers::ValueInit, std::size_t(_size.product()*image.pixelSize())});
+    } else CORRADE_ASSERT(image.format() == _dynamic->image->format() && image.formatExtra() == _dynamic->image->formatExtra() && image.pixelSize() == _dynamic->image->pixelSize(),
+        "Text::AbstractGlyphCache::setImage(): expected" << _dynamic->image->format() << "but got" << image.format() << "in a dynamic cache", );
+
+    /* Copy just the parts that were reserved since the last upload, so the
+       font can pass an image of the whole texture without overwriting
+       glyphs that are already there */
+    const Range2Di imageRectangle = Range2Di::fromSize(offset, image.size());
+    const Containers::StridedArrayView3D<const char> src = image.pixels();
+    const Containers::StridedArrayView3D<char> dst = _dynamic->image->pixels();
+    const std::size_t pixelSize = image.pixelSize();
+    for(const Range2Di& updated: _dynamic->updated) {
+        const Range2Di rectangle = Math::intersect(imageRectangle, updated);
+        if(rectangle.size().isZero()) continue;
+
+        const Range2Di srcRectangle = rectangle.translated(-offset);
+        Utility::copy(
+            src.slice({std::size_t(srcRectangle.bottom()), std::size_t(srcRectangle.left()), 0},
+                      {std::size_t(srcRectangle.top()), std::size_t(srcRectangle.right()), pixelSize}),
+            dst.slice({std::size_t(rectangle.bottom()), std::size_t(rectangle.left()), 0},
+                      {std::size_t(rectangle.top()), std::size_t(rectangle.right()), pixelSize}));
+        _dynamic->dirty = Math::join(_dynamic->dirty, rectangle);
+    }
+}
+
+Range2Di AbstractGlyphCache::dirtyRectangle() const {
+    CORRADE_ASSERT(_dynamic,
+        "Text::AbstractGlyphCache::dirtyRectangle(): the cache is not dynamic", {});
+    return _dynamic->dirty;
+}
+
+void AbstractGlyphCache::flushImage() {
+    CORRADE_ASSERT(_dynamic,
+        "Text::AbstractGlyphCache::flushImage(): the cache is not dynamic", );
+
+    _dynamic->updated.clear();
+    if(_dynamic->dirty.size().isZero()) return;
+
+    /* Upload just the modified rectangle */
+    const Range2Di& dirty = _dynamic->dirty;
+    const Image2D& image = *_dynamic->image;
+    const std::size_t pixelSize = image.pixelSize();
+    Image2D upload{PixelStorage{}.setAlignment(1), image.format(), image.formatExtra(), image.pixelSize(), dirty.size(), Containers::Array<char>{Containers::NoInit, std::size_t(dirty.size().product()*pixelSize)}};
+    Utility::copy(
+        image.pixels().slice({std::size_t(dirty.bottom()), std::size_t(dirty.left()), 0},
+                             {std::size_t(dirty.top()), std::size_t(dirty.right()), pixelSize}),
+        upload.pixels());
+    doSetImage(dirty.min(), upload);
+    _dynamic->dirty = {};
 }
 
 Image2D AbstractGlyphCache::image() {
@@ -31,12 +31,18 @@
  */
 
 #include <vector>
-#include <unordered_map>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/Text/visibility.h"
 
+#ifdef MAGNUM_BUILD_DEPRECATED
+/* The iterator used to be a std::unordered_map one, keep the include for
+   code that relied on it transitively */
+#include <unordered_map>
+#endif
+
 namespace Magnum { namespace Text {
 
 /**
@@ -72,6 +78,35 @@ CORRADE_ENUMSET_OPERATORS(GlyphCacheFeatures)
 An API-agnostic base for glyph caches. See @ref GlyphCache and
 @ref DistanceFieldGlyphCache for concrete implementations.
 
+@section Text-AbstractGlyphCache-dynamic Dynamic glyph cache
+
+By default, space for all glyphs has to be reserved upfront with a single
+@ref reserve() call, which means the set of glyphs needs to be known in
+advance. That's not feasible for example for CJK text, where there's tens of
+thousands of possible glyphs. Calling @ref setDynamic() on an empty cache
+switches it to a mode where glyphs are added on demand:
+
+-   @ref AbstractFont::fillGlyphCache() marks glyphs that are already in the
+    cache as used in current frame and asks the font to render only the
+    missing ones
+-   @ref reserve() can be called repeatedly. When the texture gets full,
+    least recently used glyphs that weren't used in current frame are
+    evicted to make space for the new ones.
+-   @ref setImage() copies only the newly reserved areas into a CPU-side copy
+    of the texture, which is then uploaded with a single sub-rectangle update
+    in @ref flushImage(). This is done automatically at the end of
+    @ref AbstractFont::fillGlyphCache().
+
+The application then calls @ref nextFrame() each frame and fills the cache
+with text that's about to be rendered:
+
+@snippet MagnumText.cpp AbstractGlyphCache-dynamic
+
+The memory use is bounded by the texture size and a table indexed by glyph
+ID. Note that glyphs rendered in previous frames can get evicted, so any
+text rendered earlier has to be filled again before being drawn in a later
+frame.
+
 @section Text-AbstractGlyphCache-subclassing Subclassing
 
 The subclass needs to implement the @ref doSetImage() function and manage the
@@ -100,7 +135,7 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
         Vector2i padding() const { return _padding; }
 
         /** @brief Count of glyphs in the cache */
-        std::size_t glyphCount() const { return glyphs.size(); }
+        std::size_t glyphCount() const { return _glyphs.size(); }
 
         /**
          * @brief Parameters of given glyph
@@ -114,23 +149,91 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
          * If no glyph is found, glyph @cpp 0 @ce is returned, which is by
          * default on zero position and has zero region in texture atlas. You
          * can reset it to some meaningful value in @ref insert().
+         *
+         * The lookup is done through a dense table indexed by glyph ID, so
+         * it's just two array accesses without any hashing.
          * @see @ref padding()
          */
         std::pair<Vector2i, Range2Di> operator[](UnsignedInt glyph) const {
-            auto it = glyphs.find(glyph);
-            return it == glyphs.end() ? glyphs.at(0) : it->second;
+            return _glyphs[glyph < _glyphIndices.size() ? _glyphIndices[glyph] : 0].second;
         }
 
-        /** @brief Iterator access to cache data */
-        std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>>::const_iterator begin() const {
-            return glyphs.begin();
+        /**
+         * @brief Iterator access to cache data
+         *
+         * Iterates over glyph ID and glyph parameter pairs in order in which
+         * they were inserted, with glyph @cpp 0 @ce always being the first.
+         * In a @ref Text-AbstractGlyphCache-dynamic "dynamic cache" the order
+         * changes as glyphs get evicted.
+         *
+         * @m_class{m-note m-warning}
+         *
+         * @par
+         *      Before @ref changelog-latest "the latest version" this returned
+         *      a @ref std::unordered_map iterator with an unspecified
+         *      iteration order. The iterator is now a @ref std::vector one,
+         *      code that names the iterator type explicitly instead of using
+         *      @cpp auto @ce or a range-for loop needs to be updated.
+         */
+        std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>>::const_iterator begin() const {
+            return _glyphs.begin();
         }
 
         /** @brief Iterator access to cache data */
-        std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>>::const_iterator end() const {
-            return glyphs.end();
+        std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>>::const_iterator end() const {
+            return _glyphs.end();
         }
 
+        /**
+         * @brief Whether the cache is dynamic
+         * @m_since_latest
+         *
+         * @see @ref setDynamic()
+         */
+        bool isDynamic() const { return !!_dynamic; }
+
+        /**
+         * @brief Enable or disable dynamic mode
+         * @m_since_latest
+         *
+         * See @ref Text-AbstractGlyphCache-dynamic for more information.
+         * Expects that the cache doesn't contain any glyphs except for glyph
+         * @cpp 0 @ce.
+         */
+        void setDynamic(bool dynamic);
+
+        /**
+         * @brief Current frame
+         * @m_since_latest
+         *
+         * Used for tracking glyph usage in a dynamic cache. Initially
+         * @cpp 0 @ce. Expects that the cache is dynamic.
+         * @see @ref isDynamic(), @ref nextFrame()
+         */
+        UnsignedInt frame() const;
+
+        /**
+         * @brief Advance to next frame
+         * @m_since_latest
+         *
+         * Glyphs that were not used in the new frame yet can be evicted
+         * to make space for new glyphs. Expects that the cache is dynamic.
+         * @see @ref isDynamic(), @ref markUsed()
+         */
+        void nextFrame();
+
+        /**
+         * @brief Mark a glyph as used in current frame
+         * @m_since_latest
+         *
+         * Returns @cpp true @ce if the glyph is in the cache,
+         * @cpp false @ce otherwise. Glyphs used in current frame are never
+         * evicted. Glyph @cpp 0 @ce is always present. Expects that the
+         * cache is dynamic. Called from @ref AbstractFont::fillGlyphCache().
+         * @see @ref isDynamic(), @ref frame()
+         */
+        bool markUsed(UnsignedInt glyph);
+
         /**
          * @brief Layout glyphs with given sizes to the cache
          *
@@ -141,6 +244,12 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
          *
          * Glyph @p sizes are expected to be without padding.
          *
+         * If the cache is @ref Text-AbstractGlyphCache-dynamic "dynamic",
+         * glyphs are packed into rows of similar height and this function can
+         * be called repeatedly. If there's not enough space, least recently
+         * used glyphs not used in current frame are evicted. If a glyph
+         * doesn't fit even after that, an empty rectangle is returned for it.
+         *
          * @attention Cache size must be large enough to contain all rendered
          *      glyphs.
          * @see @ref padding()
@@ -159,6 +268,11 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
          *
          * Glyph parameters are expected to be without padding.
          *
+         * In a @ref Text-AbstractGlyphCache-dynamic "dynamic cache" the
+         * @p rectangle is expected to be one of the rectangles returned from
+         * the last @ref reserve() call, or an empty rectangle. The glyph is
+         * then marked as used in current frame.
+         *
          * See also @ref setImage() to upload glyph image.
          * @see @ref padding()
          */
@@ -171,9 +285,37 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
          * texture. Calls @ref doSetImage(). The @p offset and
          * @ref ImageView::size() are expected tro be in bounds for
          * @ref textureSize().
+         *
+         * In a @ref Text-AbstractGlyphCache-dynamic "dynamic cache", only
+         * parts of @p image that overlap rectangles returned from
+         * @ref reserve() since the last @ref flushImage() are copied to a
+         * CPU-side copy of the texture and @ref doSetImage() is not called
+         * until @ref flushImage(). The image is expected to have the same
+         * format in all calls.
          */
         void setImage(const Vector2i& offset, const ImageView2D& image);
 
+        /**
+         * @brief Rectangle modified since the last image upload
+         * @m_since_latest
+         *
+         * Expects that the cache is dynamic.
+         * @see @ref isDynamic(), @ref flushImage()
+         */
+        Range2Di dirtyRectangle() const;
+
+        /**
+         * @brief Upload the modified part of the image
+         * @m_since_latest
+         *
+         * If @ref dirtyRectangle() is non-empty, calls @ref doSetImage() with
+         * just the modified rectangle. Called from
+         * @ref AbstractFont::fillGlyphCache(). Expects that the cache is
+         * dynamic.
+         * @see @ref isDynamic()
+         */
+        void flushImage();
+
         /**
          * @brief Download cache image
          *
@@ -198,8 +340,19 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
         /** @brief Implementation for @ref image() */
         virtual Image2D doImage();
 
+        void MAGNUM_TEXT_LOCAL evict(UnsignedInt glyph);
+
         Vector2i _size, _padding;
-        std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>> glyphs;
+        /* Glyph data in insertion order, the "Not Found" glyph 0 always being
+           the first. Indexed through _glyphIndices, which has an entry for
+           every glyph ID up to the largest inserted one, with the value being
+           0 for IDs that aren't in the cache. As glyph 0 is always at index 0,
+           a zero index for any other glyph ID means it's not present. */
+        std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>> _glyphs;
+        std::vector<UnsignedInt> _glyphIndices;
+
+        struct Dynamic;
+        Containers::Pointer<Dynamic> _dynamic;
 };
 
 }}
@@ -25,22 +25,87 @@
 
 #include "Renderer.h"
 
-#include <Corrade/Containers/Array.h>
+#include <algorithm>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
+
+#ifdef MAGNUM_TARGET_GL
 #include <Corrade/Containers/ArrayViewStl.h>
 
 #include "Magnum/Mesh.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Mesh.h"
-#include "Magnum/Math/Functions.h"
 #include "Magnum/Shaders/AbstractVector.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/GlyphCache.h"
+#endif
 
 namespace Magnum { namespace Text {
 
 namespace {
 
+/* Quad of given glyph relative to its origin and its texture coordinates */
+inline std::pair<Range2D, Range2D> glyphQuad(const AbstractGlyphCache& cache, const Float scale, const UnsignedInt glyph) {
+    Vector2i position;
+    Range2Di rectangle;
+    std::tie(position, rectangle) = cache[glyph];
+    return {Range2D(Range2Di::fromSize(position, rectangle.size())).scaled(Vector2{scale}),
+            Range2D(rectangle).scaled(1.0f/Vector2(cache.textureSize()))};
+}
+
+/* Extend rectangle with current quad bounds. If zero size, replace it. Same
+   as in AbstractLayouter::renderGlyph(). */
+inline void extendRectangle(Range2D& rectangle, const Range2D& quad) {
+    if(!rectangle.size().isZero()) {
+        rectangle.bottomLeft() = Math::min(rectangle.bottomLeft(), quad.bottomLeft());
+        rectangle.topRight() = Math::max(rectangle.topRight(), quad.topRight());
+    } else rectangle = quad;
+}
+
+inline void writeQuad(const Containers::StridedArrayView1D<Vector2>& vertexPositions, const Containers::StridedArrayView1D<Vector2>& vertexTextureCoordinates, const std::size_t i, const Range2D& quad, const Range2D& textureCoordinates) {
+    /* 0---2
+       |   |
+       |   |
+       |   |
+       1---3 */
+    vertexPositions[i*4 + 0] = quad.topLeft();
+    vertexPositions[i*4 + 1] = quad.bottomLeft();
+    vertexPositions[i*4 + 2] = quad.topRight();
+    vertexPositions[i*4 + 3] = quad.bottomRight();
+    vertexTextureCoordinates[i*4 + 0] = textureCoordinates.topLeft();
+    vertexTextureCoordinates[i*4 + 1] = textureCoordinates.bottomLeft();
+    vertexTextureCoordinates[i*4 + 2] = textureCoordinates.topRight();
+    vertexTextureCoordinates[i*4 + 3] = textureCoordinates.bottomRight();
+}
+
+}
+
+Range2D renderGlyphQuadsInto(const AbstractGlyphCache& cache, const Float scale, Vector2& cursor, const Containers::StridedArrayView1D<const UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<const Vector2>& glyphOffsets, const Containers::StridedArrayView1D<const Vector2>& glyphAdvances, const Containers::StridedArrayView1D<Vector2>& vertexPositions, const Containers::StridedArrayView1D<Vector2>& vertexTextureCoordinates) {
+    CORRADE_ASSERT(glyphOffsets.size() == glyphIds.size() && glyphAdvances.size() == glyphIds.size(),
+        "Text::renderGlyphQuadsInto(): expected glyph ID, offset and advance views to have the same size but got" << glyphIds.size() << Debug::nospace << "," << glyphOffsets.size() << "and" << glyphAdvances.size(), {});
+    CORRADE_ASSERT(vertexPositions.size() == glyphIds.size()*4 && vertexTextureCoordinates.size() == glyphIds.size()*4,
+        "Text::renderGlyphQuadsInto(): expected vertex position and texture coordinate views to have" << glyphIds.size()*4 << "elements but got" << vertexPositions.size() << "and" << vertexTextureCoordinates.size(), {});
+
+    Range2D rectangle;
+    for(std::size_t i = 0; i != glyphIds.size(); ++i) {
+        Range2D quad, textureCoordinates;
+        std::tie(quad, textureCoordinates) = glyphQuad(cache, scale, glyphIds[i]);
+        quad = quad.translated(cursor + glyphOffsets[i]*scale);
+
+        extendRectangle(rectangle, quad);
+        writeQuad(vertexPositions, vertexTextureCoordinates, i, quad, textureCoordinates);
+        cursor += glyphAdvances[i]*scale;
+    }
+
+    return rectangle;
+}
+
+#ifdef MAGNUM_TARGET_GL
+namespace {
+
 template<class T> void createIndices(void* output, const UnsignedInt glyphCount) {
     T* const out = reinterpret_cast<T*>(output);
     for(UnsignedInt i = 0; i != glyphCount; ++i) {
@@ -65,7 +130,147 @@ struct Vertex {
     Vector2 position, textureCoordinates;
 };
 
+Float horizontalAlignmentOffset(const Range2D& lineRectangle, const Alignment alignment) {
+    Float offset = 0.0f;
+    if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentCenter)
+        offset = -lineRectangle.centerX();
+    else if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentRight)
+        offset = -lineRectangle.right();
+
+    /* Integer alignment */
+    if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
+        offset = Math::round(offset);
+
+    return offset;
+}
+
+Float verticalAlignmentOffset(const Range2D& rectangle, const Alignment alignment) {
+    Float offset = 0.0f;
+    if((UnsignedByte(alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentMiddle)
+        offset = -rectangle.centerY();
+    else if((UnsignedByte(alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentTop)
+        offset = -rectangle.top();
+
+    /* Integer alignment */
+    if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
+        offset = Math::round(offset);
+
+    return offset;
+}
+
+/* Lays out a single line using AbstractFont::layoutGlyphs() and converts
+   the glyph offsets in glyphPositions to horizontally aligned glyph positions
+   relative to the line origin. Returns the glyph count and rectangle spanning
+   the line. If the count is larger than size of the views, only the count is
+   calculated and nothing else. */
+std::pair<UnsignedInt, Range2D> layoutLineInternal(AbstractFont& font, const AbstractGlyphCache& cache, const Float scale, const Containers::ArrayView<const char> line, const Alignment alignment, const Containers::StridedArrayView1D<UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<Vector2>& glyphPositions, const Containers::StridedArrayView1D<Vector2>& glyphAdvances) {
+    /* Empty line, nothing to do */
+    if(line.empty()) return {};
+
+    const UnsignedInt glyphCount = font.layoutGlyphs(line, glyphIds, glyphPositions, glyphAdvances);
+    if(glyphCount > glyphIds.size()) return {glyphCount, {}};
+
+    /* Calculate glyph positions and bounds of the line */
+    Range2D lineRectangle;
+    Vector2 cursorPosition;
+    for(std::size_t i = 0; i != glyphCount; ++i) {
+        glyphPositions[i] = cursorPosition + glyphPositions[i]*scale;
+        extendRectangle(lineRectangle, glyphQuad(cache, scale, glyphIds[i]).first.translated(glyphPositions[i]));
+        cursorPosition += glyphAdvances[i]*scale;
+    }
+
+    /* Horizontally align the line */
+    const Float alignmentOffsetX = horizontalAlignmentOffset(lineRectangle, alignment);
+    for(std::size_t i = 0; i != glyphCount; ++i)
+        glyphPositions[i].x() += alignmentOffsetX;
+
+    return {glyphCount, lineRectangle.translated(Vector2::xAxis(alignmentOffsetX))};
+}
+
+/* Lays out all lines of the text using layoutLineInternal() and converts the
+   glyph offsets in glyphPositions to final aligned glyph positions. Returns
+   the total glyph count and rectangle spanning the text. If the count is
+   larger than size of the views, only the count is calculated and nothing
+   else. */
+std::pair<UnsignedInt, Range2D> layoutGlyphsInternal(AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Containers::ArrayView<const char> text, const Alignment alignment, const Containers::StridedArrayView1D<UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<Vector2>& glyphPositions, const Containers::StridedArrayView1D<Vector2>& glyphAdvances) {
+    const Float scale = size/font.size();
+    const Vector2 lineAdvance = Vector2::yAxis(font.lineHeight()*scale);
+    const std::size_t capacity = glyphIds.size();
+
+    Range2D rectangle;
+    Vector2 linePosition;
+    std::size_t glyphCount = 0;
+    for(std::size_t prevPos = 0, pos; ; prevPos = pos + 1, linePosition -= lineAdvance) {
+        for(pos = prevPos; pos != text.size() && text[pos] != '\n'; ++pos);
+
+        /* Layout the line after glyphs of previous lines. If they don't fit
+           anymore, only count the glyphs. */
+        const std::size_t lineBegin = Math::min(glyphCount, capacity);
+        const std::pair<UnsignedInt, Range2D> line = layoutLineInternal(font, cache, scale, text.slice(prevPos, pos), alignment,
+            glyphIds.suffix(lineBegin),
+            glyphPositions.suffix(lineBegin),
+            glyphAdvances.suffix(lineBegin));
+        glyphCount += line.first;
+
+        /* Move the line to its vertical position */
+        if(pos != prevPos && glyphCount <= capacity) {
+            for(std::size_t i = lineBegin; i != glyphCount; ++i)
+                glyphPositions[i] += linePosition;
+            extendRectangle(rectangle, line.second.translated(linePosition));
+        }
+
+        if(pos == text.size()) break;
+    }
+
+    if(glyphCount > capacity) return {UnsignedInt(glyphCount), {}};
+
+    /* Vertically align the rendered text */
+    const Float alignmentOffsetY = verticalAlignmentOffset(rectangle, alignment);
+    for(std::size_t i = 0; i != glyphCount; ++i)
+        glyphPositions[i].y() += alignmentOffsetY;
+
+    return {UnsignedInt(glyphCount), rectangle.translated(Vector2::yAxis(alignmentOffsetY))};
+}
+
+/* Creates quads from output of layoutGlyphsInternal() or
+   layoutLineInternal(), translated by given offset. Only writes to the
+   output, so it can be a mapped buffer. */
+void renderGlyphQuadsInternal(const AbstractGlyphCache& cache, const Float scale, const Vector2& offset, const Containers::StridedArrayView1D<const UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<const Vector2>& glyphPositions, const Containers::StridedArrayView1D<Vector2>& vertexPositions, const Containers::StridedArrayView1D<Vector2>& vertexTextureCoordinates) {
+    for(std::size_t i = 0; i != glyphIds.size(); ++i) {
+        Range2D quad, textureCoordinates;
+        std::tie(quad, textureCoordinates) = glyphQuad(cache, scale, glyphIds[i]);
+        writeQuad(vertexPositions, vertexTextureCoordinates, i, quad.translated(glyphPositions[i] + offset), textureCoordinates);
+    }
+}
+
+std::tuple<std::vector<Vertex>, Range2D> renderVerticesBatchInternal(AbstractFont& font, const GlyphCache& cache, const Float size, const std::string& text, const Alignment alignment) {
+    /* Assume one glyph per byte, if the font produces more, repeat with the
+       actual count */
+    Containers::Array<UnsignedInt> glyphIds;
+    Containers::Array<Vector2> glyphPositions, glyphAdvances;
+    std::pair<UnsignedInt, Range2D> glyphCountRectangle{UnsignedInt(text.size()), {}};
+    do {
+        glyphIds = Containers::Array<UnsignedInt>{Containers::NoInit, glyphCountRectangle.first};
+        glyphPositions = Containers::Array<Vector2>{Containers::NoInit, glyphCountRectangle.first};
+        glyphAdvances = Containers::Array<Vector2>{Containers::NoInit, glyphCountRectangle.first};
+        glyphCountRectangle = layoutGlyphsInternal(font, cache, size, {text.data(), text.size()}, alignment, Containers::arrayView(glyphIds), Containers::arrayView(glyphPositions), Containers::arrayView(glyphAdvances));
+    } while(glyphCountRectangle.first > glyphIds.size());
+
+    const UnsignedInt glyphCount = glyphCountRectangle.first;
+    std::vector<Vertex> vertices(glyphCount*4);
+    const Containers::ArrayView<Vertex> vertexView = Containers::arrayView(vertices);
+    renderGlyphQuadsInternal(cache, size/font.size(), {},
+        glyphIds.prefix(glyphCount), glyphPositions.prefix(glyphCount),
+        Containers::StridedArrayView1D<Vector2>{vertexView, vertexView ? &vertexView[0].position : nullptr, vertexView.size(), sizeof(Vertex)},
+        Containers::StridedArrayView1D<Vector2>{vertexView, vertexView ? &vertexView[0].textureCoordinates : nullptr, vertexView.size(), sizeof(Vertex)});
+
+    return std::make_tuple(std::move(vertices), glyphCountRectangle.second);
+}
+
 std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& font, const GlyphCache& cache, const Float size, const std::string& text, const Alignment alignment) {
+    if(font.features() & FontFeature::BatchLayout)
+        return renderVerticesBatchInternal(font, cache, size, text, alignment);
+
     /* Output data, reserve memory as when the text would be ASCII-only. In
        reality the actual vertex count will be smaller, but allocating more at
        once is better than reallocating many times later. */
@@ -131,26 +336,15 @@ std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& fo
         /** @todo What about top-down text? */
 
         /* Horizontally align the rendered line */
-        Float alignmentOffsetX = 0.0f;
-        if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentCenter)
-            alignmentOffsetX = -lineRectangle.centerX();
-        else if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentRight)
-            alignmentOffsetX = -lineRectangle.right();
-
-        /* Integer alignment */
-        if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
-            alignmentOffsetX = Math::round(alignmentOffsetX);
+        const Float alignmentOffsetX = horizontalAlignmentOffset(lineRectangle, alignment);
 
         /* Align positions and bounds on current line */
         lineRectangle = lineRectangle.translated(Vector2::xAxis(alignmentOffsetX));
         for(auto it = vertices.begin()+lastLineLastVertex; it != vertices.end(); ++it)
             it->position.x() += alignmentOffsetX;
 
-        /* Add final line bounds to total bounds, similarly to AbstractFont::renderGlyph() */
-        if(!rectangle.size().isZero()) {
-            rectangle.bottomLeft() = Math::min(rectangle.bottomLeft(), lineRectangle.bottomLeft());
-            rectangle.topRight() = Math::max(rectangle.topRight(), lineRectangle.topRight());
-        } else rectangle = lineRectangle;
+        /* Add final line bounds to total bounds */
+        extendRectangle(rectangle, lineRectangle);
 
     /* Move to next line */
     } while(prevPos = pos+1,
@@ -159,15 +353,7 @@ std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& fo
             pos != std::string::npos);
 
     /* Vertically align the rendered text */
-    Float alignmentOffsetY = 0.0f;
-    if((UnsignedByte(alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentMiddle)
-        alignmentOffsetY = -rectangle.centerY();
-    else if((UnsignedByte(alignment) & Implementation::AlignmentVertical) == Implementation::AlignmentTop)
-        alignmentOffsetY = -rectangle.top();
-
-    /* Integer alignment */
-    if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
-        alignmentOffsetY = Math::round(alignmentOffsetY);
+    const Float alignmentOffsetY = verticalAlignmentOffset(rectangle, alignment);
 
     /* Align positions and bounds */
     rectangle = rectangle.translated(Vector2::yAxis(alignmentOffsetY));
@@ -261,43 +447,59 @@ template<UnsignedInt dimensions> std::tuple<GL::Mesh, Range2D> Renderer<dimensio
     return r;
 }
 
+MeshIndexType AbstractRenderer::fillIndexBuffer(GL::Buffer& indexBuffer, const UnsignedInt glyphCount, const GL::BufferUsage usage) {
+    Containers::Array<char> indexData;
+    MeshIndexType indexType;
+    std::tie(indexData, indexType) = renderIndicesInternal(glyphCount);
+    indexBuffer.setData(indexData, usage);
+    return indexType;
+}
+
 #if defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
 AbstractRenderer::BufferMapImplementation AbstractRenderer::bufferMapImplementation = &AbstractRenderer::bufferMapImplementationFull;
 AbstractRenderer::BufferUnmapImplementation AbstractRenderer::bufferUnmapImplementation = &AbstractRenderer::bufferUnmapImplementationDefault;
 
-void* AbstractRenderer::bufferMapImplementationFull(GL::Buffer& buffer, GLsizeiptr) {
-    return buffer.map(GL::Buffer::MapAccess::WriteOnly);
+void* AbstractRenderer::bufferMapImplementationFull(GL::Buffer& buffer, GLintptr offset, GLsizeiptr, GLsizeiptr) {
+    /* The whole buffer gets mapped, without invalidation, so the contents
+       outside of the updated range stay intact */
+    return static_cast<char*>(buffer.map(GL::Buffer::MapAccess::WriteOnly)) + offset;
 }
 #endif
 
 #if !defined(MAGNUM_TARGET_GLES2) || defined(CORRADE_TARGET_EMSCRIPTEN)
-inline void* AbstractRenderer::bufferMapImplementation(GL::Buffer& buffer, GLsizeiptr length)
+inline void* AbstractRenderer::bufferMapImplementation(GL::Buffer& buffer, GLintptr offset, GLsizeiptr length, GLsizeiptr usedLength)
 #else
-void* AbstractRenderer::bufferMapImplementationRange(GL::Buffer& buffer, GLsizeiptr length)
+void* AbstractRenderer::bufferMapImplementationRange(GL::Buffer& buffer, GLintptr offset, GLsizeiptr length, GLsizeiptr usedLength)
 #endif
 {
     #ifndef CORRADE_TARGET_EMSCRIPTEN
-    return buffer.map(0, length, GL::Buffer::MapFlag::InvalidateBuffer|GL::Buffer::MapFlag::Write);
+    /* If the updated range covers everything that's used, whatever is after
+       isn't needed anymore and the whole buffer can be invalidated. Otherwise
+       only the updated range can be, as the rest is still used. */
+    return buffer.map(offset, length, (offset == 0 && length >= usedLength ? GL::Buffer::MapFlag::InvalidateBuffer : GL::Buffer::MapFlag::InvalidateRange)|GL::Buffer::MapFlag::Write);
     #else
     static_cast<void>(length);
-    return &buffer == &_indexBuffer ? _indexBufferData : _vertexBufferData;
+    static_cast<void>(usedLength);
+    return (&buffer == &_indexBuffer ? _indexBufferData : _vertexBufferData) + offset;
     #endif
 }
 
 #if !defined(MAGNUM_TARGET_GLES2) || defined(CORRADE_TARGET_EMSCRIPTEN)
-inline void AbstractRenderer::bufferUnmapImplementation(GL::Buffer& buffer)
+inline void AbstractRenderer::bufferUnmapImplementation(GL::Buffer& buffer, GLintptr offset, GLsizeiptr length)
 #else
-void AbstractRenderer::bufferUnmapImplementationDefault(GL::Buffer& buffer)
+void AbstractRenderer::bufferUnmapImplementationDefault(GL::Buffer& buffer, GLintptr, GLsizeiptr)
 #endif
 {
     #ifndef CORRADE_TARGET_EMSCRIPTEN
+    static_cast<void>(offset);
+    static_cast<void>(length);
     buffer.unmap();
     #else
-    buffer.setSubData(0, &buffer == &_indexBuffer ? _indexBufferData : _vertexBufferData);
+    buffer.setSubData(offset, (&buffer == &_indexBuffer ? _indexBufferData : _vertexBufferData).slice(offset, offset + length));
     #endif
 }
 
-AbstractRenderer::AbstractRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _vertexBuffer{GL::Buffer::TargetHint::Array}, _indexBuffer{GL::Buffer::TargetHint::ElementArray}, font(font), cache(cache), size(size), _alignment(alignment), _capacity(0) {
+AbstractRenderer::AbstractRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _vertexBuffer{GL::Buffer::TargetHint::Array}, _indexBuffer{GL::Buffer::TargetHint::ElementArray}, font(font), cache(cache), size(size), _alignment(alignment), _capacity(0), _glyphCount(0), _verticalOffset(0.0f), _lines(1) {
     #ifndef MAGNUM_TARGET_GLES
     MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::map_buffer_range);
     #elif defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
@@ -324,9 +526,31 @@ template<UnsignedInt dimensions> Renderer<dimensions>::Renderer(AbstractFont& fo
             typename Shaders::AbstractVector<dimensions>::TextureCoordinates());
 }
 
-void AbstractRenderer::reserve(const uint32_t glyphCount, const GL::BufferUsage vertexBufferUsage, const GL::BufferUsage indexBufferUsage) {
+void AbstractRenderer::reserveInternal(const UnsignedInt glyphCount, const GL::BufferUsage vertexBufferUsage) {
     _capacity = glyphCount;
 
+    /* Persistent layout and scratch memory for the batch layout, so edits
+       don't need to allocate. The text and line storage is sized for one
+       byte and at most one line per glyph, beyond that it grows. */
+    if(font.features() & FontFeature::BatchLayout) {
+        _glyphIds = Containers::Array<UnsignedInt>{Containers::NoInit, glyphCount};
+        _glyphPositions = Containers::Array<Vector2>{Containers::NoInit, glyphCount};
+        _scratchGlyphIds = Containers::Array<UnsignedInt>{Containers::NoInit, glyphCount};
+        _scratchGlyphPositions = Containers::Array<Vector2>{Containers::NoInit, glyphCount};
+        _glyphAdvances = Containers::Array<Vector2>{Containers::NoInit, glyphCount};
+        _scratchText.reserve(glyphCount);
+        _lines.reserve(glyphCount + 1);
+        _scratchLines.reserve(glyphCount + 1);
+    }
+
+    /* Previous buffer contents are gone, so reset the text as well */
+    _text.clear();
+    _text.reserve(glyphCount);
+    _lines.assign(1, Line{});
+    _glyphCount = 0;
+    _verticalOffset = 0.0f;
+    _rectangle = {};
+
     const UnsignedInt vertexCount = glyphCount*4;
 
     /* Allocate vertex buffer, reset vertex count */
@@ -335,6 +559,12 @@ void AbstractRenderer::reserve(const uint32_t glyphCount, const GL::BufferUsage
     _vertexBufferData = Containers::Array<UnsignedByte>(vertexCount*sizeof(Vertex));
     #endif
     _mesh.setCount(0);
+}
+
+void AbstractRenderer::reserve(const uint32_t glyphCount, const GL::BufferUsage vertexBufferUsage, const GL::BufferUsage indexBufferUsage) {
+    reserveInternal(glyphCount, vertexBufferUsage);
+
+    const UnsignedInt vertexCount = glyphCount*4;
 
     /* Render indices */
     Containers::Array<char> indexData;
@@ -350,32 +580,210 @@ void AbstractRenderer::reserve(const uint32_t glyphCount, const GL::BufferUsage
         .setIndexBuffer(_indexBuffer, 0, indexType, 0, vertexCount);
 
     /* Prefill index buffer */
-    char* const indices = static_cast<char*>(bufferMapImplementation(_indexBuffer, indexData.size()));
+    char* const indices = static_cast<char*>(bufferMapImplementation(_indexBuffer, 0, indexData.size(), indexData.size()));
     CORRADE_INTERNAL_ASSERT(indices);
     /** @todo Emscripten: it can be done without this copying altogether */
     std::copy(indexData.begin(), indexData.end(), indices);
-    bufferUnmapImplementation(_indexBuffer);
+    bufferUnmapImplementation(_indexBuffer, 0, indexData.size());
+}
+
+void AbstractRenderer::reserve(const UnsignedInt glyphCount, const GL::BufferUsage vertexBufferUsage, GL::Buffer& indexBuffer, const MeshIndexType indexType) {
+    reserveInternal(glyphCount, vertexBufferUsage);
+
+    /* Reference the shared index buffer, the own one stays empty */
+    _mesh.setCount(0)
+        .setIndexBuffer(indexBuffer, 0, indexType, 0, glyphCount*4);
 }
 
 void AbstractRenderer::render(const std::string& text) {
+    updateInternal("render", 0, _text.size(), text);
+}
+
+void AbstractRenderer::insert(const std::size_t position, const std::string& text) {
+    CORRADE_ASSERT(position <= _text.size(),
+        "Text::Renderer::insert(): position" << position << "out of range for" << _text.size() << "bytes", );
+    updateInternal("insert", position, 0, text);
+}
+
+void AbstractRenderer::erase(const std::size_t position, const std::size_t size) {
+    CORRADE_ASSERT(position <= _text.size() && size <= _text.size() - position,
+        "Text::Renderer::erase(): range [" << Debug::nospace << position << Debug::nospace << "," << position + size << Debug::nospace << ") out of range for" << _text.size() << "bytes", );
+    updateInternal("erase", position, size, {});
+}
+
+void AbstractRenderer::replace(const std::size_t position, const std::size_t size, const std::string& text) {
+    CORRADE_ASSERT(position <= _text.size() && size <= _text.size() - position,
+        "Text::Renderer::replace(): range [" << Debug::nospace << position << Debug::nospace << "," << position + size << Debug::nospace << ") out of range for" << _text.size() << "bytes", );
+    updateInternal("replace", position, size, text);
+}
+
+void AbstractRenderer::updateInternal(const char* const function, const std::size_t position, const std::size_t size, const std::string& text) {
+    #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(function);
+    #endif
+
+    if(font.features() & FontFeature::BatchLayout) {
+        const Float scale = this->size/font.size();
+        const Float lineAdvance = font.lineHeight()*scale;
+
+        /* Find lines affected by the edit and the glyphs belonging to them.
+           The lines are sorted by their text offset, so it's a binary search
+           instead of counting newlines in the whole text. */
+        const auto lineAt = [this](const std::size_t textPosition) {
+            return std::size_t(std::upper_bound(_lines.begin(), _lines.end(), textPosition, [](const std::size_t offset, const Line& line) {
+                return offset < line.textBegin;
+            }) - _lines.begin() - 1);
+        };
+        const std::size_t firstLine = lineAt(position);
+        const std::size_t lastLine = lineAt(position + size);
+        const UnsignedInt glyphBegin = _lines[firstLine].glyphBegin;
+        const UnsignedInt oldGlyphEnd = _lines[lastLine].glyphBegin + _lines[lastLine].glyphCount;
+        const UnsignedInt trailingGlyphCount = _glyphCount - oldGlyphEnd;
+
+        /* Text of the affected lines after the edit, assembled in scratch
+           memory that keeps its capacity between calls */
+        const std::size_t textBegin = _lines[firstLine].textBegin;
+        const std::size_t textEnd = lastLine + 1 != _lines.size() ?
+            _lines[lastLine + 1].textBegin - 1 : _text.size();
+        _scratchText.assign(_text, textBegin, position - textBegin)
+            .append(text)
+            .append(_text, position + size, textEnd - position - size);
+
+        /* Lay out the affected lines into scratch memory so the renderer
+           state stays intact if they don't fit. If they don't, the remaining
+           lines only count the glyphs. */
+        const UnsignedInt available = _capacity - glyphBegin - trailingGlyphCount;
+        UnsignedInt lineGlyphCount = 0;
+        _scratchLines.clear();
+        for(std::size_t prevPos = 0, pos; ; prevPos = pos + 1) {
+            for(pos = prevPos; pos != _scratchText.size() && _scratchText[pos] != '\n'; ++pos);
+
+            const UnsignedInt lineGlyphBegin = Math::min(lineGlyphCount, available);
+            Line line;
+            line.textBegin = textBegin + prevPos;
+            line.glyphBegin = glyphBegin + lineGlyphCount;
+            line.hasText = pos != prevPos;
+            std::tie(line.glyphCount, line.rectangle) = layoutLineInternal(font, cache, scale, {_scratchText.data() + prevPos, pos - prevPos}, _alignment,
+                _scratchGlyphIds.slice(lineGlyphBegin, available),
+                _scratchGlyphPositions.slice(lineGlyphBegin, available),
+                _glyphAdvances.slice(lineGlyphBegin, available));
+            lineGlyphCount += line.glyphCount;
+            _scratchLines.push_back(line);
+
+            if(pos == _scratchText.size()) break;
+        }
+
+        CORRADE_ASSERT(glyphBegin + lineGlyphCount + trailingGlyphCount <= _capacity,
+            "Text::Renderer::" << Debug::nospace << function << Debug::nospace << "(): capacity" << _capacity << "too small to render" << glyphBegin + lineGlyphCount + trailingGlyphCount << "glyphs", );
+
+        /* Apply the edit in place, the storage is reserved upfront. The text
+           can be a reference to text(), so remember its size before. */
+        const std::size_t textSize = text.size();
+        _text.replace(position, size, text);
+
+        /* Replace the line info of the affected lines, shifting the line info
+           of all following lines if the line count changed */
+        const std::size_t oldLineCount = lastLine - firstLine + 1;
+        const std::size_t lineCount = _scratchLines.size();
+        if(lineCount > oldLineCount)
+            _lines.insert(_lines.begin() + lastLine + 1, lineCount - oldLineCount, Line{});
+        else if(lineCount < oldLineCount)
+            _lines.erase(_lines.begin() + firstLine + lineCount, _lines.begin() + lastLine + 1);
+        std::copy(_scratchLines.begin(), _scratchLines.end(), _lines.begin() + firstLine);
+
+        /* Move glyphs of the following lines right after the affected lines,
+           if their count changed, and put the new glyphs in between */
+        const UnsignedInt glyphEnd = glyphBegin + lineGlyphCount;
+        if(glyphEnd > oldGlyphEnd) {
+            std::copy_backward(_glyphIds.data() + oldGlyphEnd, _glyphIds.data() + _glyphCount, _glyphIds.data() + glyphEnd + trailingGlyphCount);
+            std::copy_backward(_glyphPositions.data() + oldGlyphEnd, _glyphPositions.data() + _glyphCount, _glyphPositions.data() + glyphEnd + trailingGlyphCount);
+        } else if(glyphEnd < oldGlyphEnd) {
+            std::copy(_glyphIds.data() + oldGlyphEnd, _glyphIds.data() + _glyphCount, _glyphIds.data() + glyphEnd);
+            std::copy(_glyphPositions.data() + oldGlyphEnd, _glyphPositions.data() + _glyphCount, _glyphPositions.data() + glyphEnd);
+        }
+        std::copy(_scratchGlyphIds.data(), _scratchGlyphIds.data() + lineGlyphCount, _glyphIds.data() + glyphBegin);
+        std::copy(_scratchGlyphPositions.data(), _scratchGlyphPositions.data() + lineGlyphCount, _glyphPositions.data() + glyphBegin);
+
+        /* Update glyph and text offsets of the following lines, if they
+           moved. Relies on unsigned wraparound for negative differences. */
+        if(glyphEnd != oldGlyphEnd || textSize != size) {
+            for(std::size_t i = firstLine + lineCount; i != _lines.size(); ++i) {
+                _lines[i].glyphBegin = _lines[i].glyphBegin + glyphEnd - oldGlyphEnd;
+                _lines[i].textBegin = _lines[i].textBegin + textSize - size;
+            }
+        }
+        _glyphCount = glyphEnd + trailingGlyphCount;
+
+        /* Calculate bounds of the whole text and vertically align it */
+        Range2D rectangle;
+        for(std::size_t i = 0; i != _lines.size(); ++i)
+            if(_lines[i].hasText)
+                extendRectangle(rectangle, _lines[i].rectangle.translated(Vector2::yAxis(-Float(i)*lineAdvance)));
+        const Float verticalOffset = verticalAlignmentOffset(rectangle, _alignment);
+        _rectangle = rectangle.translated(Vector2::yAxis(verticalOffset));
+
+        /* If the vertical alignment changed, everything has to be updated. If
+           the glyph and line count stayed the same, only the affected lines
+           have to be updated, otherwise all following glyphs moved as well. */
+        std::size_t updateLine = firstLine;
+        UnsignedInt updateBegin = glyphBegin, updateEnd = _glyphCount;
+        if(verticalOffset != _verticalOffset) {
+            updateLine = 0;
+            updateBegin = 0;
+        } else if(glyphEnd == oldGlyphEnd && lineCount == oldLineCount)
+            updateEnd = glyphEnd;
+        _verticalOffset = verticalOffset;
+
+        /* Generate the quads directly into the mapped range of the buffer */
+        if(const UnsignedInt vertexCount = (updateEnd - updateBegin)*4) {
+            const GLintptr offset = updateBegin*4*sizeof(Vertex);
+            const GLsizeiptr length = vertexCount*sizeof(Vertex);
+            Containers::ArrayView<Vertex> vertices(static_cast<Vertex*>(bufferMapImplementation(_vertexBuffer, offset, length, _glyphCount*4*sizeof(Vertex))), vertexCount);
+            CORRADE_INTERNAL_ASSERT_OUTPUT(vertices);
+            const Containers::StridedArrayView1D<Vector2> positions{vertices, &vertices[0].position, vertexCount, sizeof(Vertex)};
+            const Containers::StridedArrayView1D<Vector2> textureCoordinates{vertices, &vertices[0].textureCoordinates, vertexCount, sizeof(Vertex)};
+            for(std::size_t i = updateLine; i != _lines.size() && _lines[i].glyphBegin < updateEnd; ++i) {
+                const Line& line = _lines[i];
+                const std::size_t lineVertexBegin = (line.glyphBegin - updateBegin)*4;
+                renderGlyphQuadsInternal(cache, scale, Vector2::yAxis(verticalOffset - Float(i)*lineAdvance),
+                    _glyphIds.slice(line.glyphBegin, line.glyphBegin + line.glyphCount),
+                    _glyphPositions.slice(line.glyphBegin, line.glyphBegin + line.glyphCount),
+                    positions.slice(lineVertexBegin, lineVertexBegin + line.glyphCount*4),
+                    textureCoordinates.slice(lineVertexBegin, lineVertexBegin + line.glyphCount*4));
+            }
+            bufferUnmapImplementation(_vertexBuffer, offset, length);
+        }
+
+        /* Update index count */
+        _mesh.setCount(_glyphCount*6);
+        return;
+    }
+
+    /* Render the whole edited text again */
+    std::string editedText = _text;
+    editedText.replace(position, size, text);
+
     /* Render vertex data */
     std::vector<Vertex> vertexData;
-    _rectangle = {};
-    std::tie(vertexData, _rectangle) = renderVerticesInternal(font, cache, size, text, _alignment);
+    Range2D rectangle;
+    std::tie(vertexData, rectangle) = renderVerticesInternal(font, cache, this->size, editedText, _alignment);
 
     const UnsignedInt glyphCount = vertexData.size()/4;
     const UnsignedInt vertexCount = glyphCount*4;
     const UnsignedInt indexCount = glyphCount*6;
 
     CORRADE_ASSERT(glyphCount <= _capacity,
-        "Text::Renderer::render(): capacity" << _capacity << "too small to render" << glyphCount << "glyphs", );
+        "Text::Renderer::" << Debug::nospace << function << Debug::nospace << "(): capacity" << _capacity << "too small to render" << glyphCount << "glyphs", );
+
+    _text = std::move(editedText);
+    _rectangle = rectangle;
 
     /* Interleave the data into mapped buffer*/
     Containers::ArrayView<Vertex> vertices(static_cast<Vertex*>(bufferMapImplementation(_vertexBuffer,
-        vertexCount*sizeof(Vertex))), vertexCount);
+        0, vertexCount*sizeof(Vertex), vertexCount*sizeof(Vertex))), vertexCount);
     CORRADE_INTERNAL_ASSERT_OUTPUT(vertices);
     std::copy(vertexData.begin(), vertexData.end(), vertices.begin());
-    bufferUnmapImplementation(_vertexBuffer);
+    bufferUnmapImplementation(_vertexBuffer, 0, vertexCount*sizeof(Vertex));
 
     /* Update index count */
     _mesh.setCount(indexCount);
@@ -385,5 +793,6 @@ void AbstractRenderer::render(const std::string& text) {
 template class MAGNUM_TEXT_EXPORT Renderer<2>;
 template class MAGNUM_TEXT_EXPORT Renderer<3>;
 #endif
+#endif
 
 }}
@@ -26,30 +26,65 @@
 */
 
 /** @file Text/Renderer.h
- * @brief Class @ref Magnum::Text::AbstractRenderer, @ref Magnum::Text::Renderer, typedef @ref Magnum::Text::Renderer2D, @ref Magnum::Text::Renderer3D
+ * @brief Class @ref Magnum::Text::AbstractRenderer, @ref Magnum::Text::Renderer, typedef @ref Magnum::Text::Renderer2D, @ref Magnum::Text::Renderer3D, function @ref Magnum::Text::renderGlyphQuadsInto()
  */
 
-#include "Magnum/configure.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/Text.h"
+#include "Magnum/Text/visibility.h"
 
 #ifdef MAGNUM_TARGET_GL
 #include <string>
 #include <tuple>
 #include <vector>
+#include <Corrade/Containers/Array.h>
 
 #include "Magnum/DimensionTraits.h"
-#include "Magnum/Math/Range.h"
 #include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Mesh.h"
-#include "Magnum/Text/Text.h"
 #include "Magnum/Text/Alignment.h"
-#include "Magnum/Text/visibility.h"
-
-#ifdef CORRADE_TARGET_EMSCRIPTEN
-#include <Corrade/Containers/Array.h>
 #endif
 
 namespace Magnum { namespace Text {
 
+/**
+@brief Render quads for a laid out text run
+@param[in] cache            Glyph cache
+@param[in] scale            Scale to apply to glyph cache and font units,
+    usually the desired text size divided by @ref AbstractFont::size()
+@param[in,out] cursor       Cursor position, advanced past the last glyph
+@param[in] glyphIds         Glyph IDs
+@param[in] glyphOffsets     Glyph offsets relative to the cursor
+@param[in] glyphAdvances    Cursor advance after each glyph
+@param[out] vertexPositions Where to put vertex positions
+@param[out] vertexTextureCoordinates Where to put vertex texture
+    coordinates
+@return Rectangle spanning the rendered quads
+@m_since_latest
+
+Takes output of @ref AbstractFont::layoutGlyphs() and writes four vertices
+for each glyph, in the same order as @ref Renderer does, so the output can be
+drawn with the same index buffer:
+
+@code{.unparsed}
+0---2
+|   |
+|   |
+|   |
+1---3
+@endcode
+
+The glyph ID, offset and advance views are expected to have the same size, the
+vertex views four times that size. The vertex views are only written to, so
+they can point directly to a mapped GPU buffer. No allocation is done.
+
+@snippet MagnumText.cpp renderGlyphQuadsInto
+*/
+MAGNUM_TEXT_EXPORT Range2D renderGlyphQuadsInto(const AbstractGlyphCache& cache, Float scale, Vector2& cursor, const Containers::StridedArrayView1D<const UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<const Vector2>& glyphOffsets, const Containers::StridedArrayView1D<const Vector2>& glyphAdvances, const Containers::StridedArrayView1D<Vector2>& vertexPositions, const Containers::StridedArrayView1D<Vector2>& vertexTextureCoordinates);
+
+#ifdef MAGNUM_TARGET_GL
+
 /**
 @brief Base for text renderers
 
@@ -71,6 +106,22 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
          */
         static std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>, Range2D> render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment = Alignment::LineLeft);
 
+        /**
+         * @brief Fill an index buffer for given glyph count
+         * @param indexBuffer   Buffer where to store indices
+         * @param glyphCount    Glyph count
+         * @param usage         Index buffer usage
+         * @return Index type to use with the buffer
+         * @m_since_latest
+         *
+         * Fills @p indexBuffer with indices for @p glyphCount quads, in the
+         * same layout as @ref reserve(UnsignedInt, GL::BufferUsage, GL::BufferUsage)
+         * does. Since the indices depend only on the glyph count, a single
+         * buffer can be shared among any number of renderers using
+         * @ref reserve(UnsignedInt, GL::BufferUsage, GL::Buffer&, MeshIndexType).
+         */
+        static MeshIndexType fillIndexBuffer(GL::Buffer& indexBuffer, UnsignedInt glyphCount, GL::BufferUsage usage);
+
         /**
          * @brief Capacity for rendered glyphs
          *
@@ -84,9 +135,24 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         /** @brief Vertex buffer */
         GL::Buffer& vertexBuffer() { return _vertexBuffer; }
 
-        /** @brief Index buffer */
+        /**
+         * @brief Index buffer
+         *
+         * Empty if a shared index buffer is used, see
+         * @ref reserve(UnsignedInt, GL::BufferUsage, GL::Buffer&, MeshIndexType).
+         */
         GL::Buffer& indexBuffer() { return _indexBuffer; }
 
+        /**
+         * @brief Currently rendered text
+         * @m_since_latest
+         *
+         * Text passed to the last @ref render() call with all subsequent
+         * @ref insert(), @ref erase() and @ref replace() edits applied.
+         * Empty after @ref reserve().
+         */
+        const std::string& text() const { return _text; }
+
         /** @brief Mesh */
         GL::Mesh& mesh() { return _mesh; }
 
@@ -99,11 +165,27 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
          * only by calling this function, thus @p indexBufferUsage generally
          * doesn't need to be so dynamic if the capacity won't be changed much.
          *
-         * Initially zero capacity is reserved.
+         * Initially zero capacity is reserved. The currently rendered text
+         * is discarded.
          * @see @ref capacity()
          */
         void reserve(UnsignedInt glyphCount, GL::BufferUsage vertexBufferUsage, GL::BufferUsage indexBufferUsage);
 
+        /**
+         * @brief Reserve capacity for rendered glyphs with a shared index buffer
+         * @m_since_latest
+         *
+         * Like @ref reserve(UnsignedInt, GL::BufferUsage, GL::BufferUsage),
+         * but instead of allocating and filling an index buffer owned by this
+         * renderer, the mesh references @p indexBuffer. The buffer is
+         * expected to be filled with @ref fillIndexBuffer() for at least
+         * @p glyphCount glyphs, with @p indexType being the value it
+         * returned, and to be kept in scope for the whole renderer lifetime.
+         *
+         * @snippet MagnumText.cpp Renderer-shared-indices
+         */
+        void reserve(UnsignedInt glyphCount, GL::BufferUsage vertexBufferUsage, GL::Buffer& indexBuffer, MeshIndexType indexType);
+
         /**
          * @brief Render text
          *
@@ -111,12 +193,73 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
          * filled with @ref reserve(). Rectangle spanning the rendered text is
          * available through @ref rectangle().
          *
-         * Initially no text is rendered.
+         * If the font supports @ref FontFeature::BatchLayout, the text is
+         * laid out using @ref AbstractFont::layoutGlyphs() into scratch
+         * memory allocated in @ref reserve() and the vertices are generated
+         * directly into the mapped vertex buffer. Storage for the text and
+         * its lines is reserved there as well, so the renderer itself doesn't
+         * allocate as long as the text has at most as many bytes and lines
+         * as the reserved glyph count. Otherwise the whole text is rendered
+         * into temporary memory first.
+         *
+         * Initially no text is rendered. Equivalent to calling
+         * @ref replace() on the whole @ref text().
          * @attention The capacity must be large enough to contain all glyphs,
          *      see @ref reserve() for more information.
          */
         void render(const std::string& text);
 
+        /**
+         * @brief Insert text
+         * @param position      Byte position in @ref text() to insert at
+         * @param text          Text to insert
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref replace() with zero size.
+         */
+        void insert(std::size_t position, const std::string& text);
+
+        /**
+         * @brief Erase text
+         * @param position      Byte position in @ref text() to erase from
+         * @param size          Count of bytes to erase
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref replace() with empty text.
+         */
+        void erase(std::size_t position, std::size_t size);
+
+        /**
+         * @brief Replace text
+         * @param position      Byte position in @ref text() to replace from
+         * @param size          Count of bytes to replace
+         * @param text          Text to replace with
+         * @m_since_latest
+         *
+         * Expects that @p position and @p size are in bounds of @ref text().
+         * The positions are in bytes of the UTF-8 encoded text, it's up to
+         * the caller to not split a multi-byte character.
+         *
+         * If the font supports @ref FontFeature::BatchLayout, the glyph
+         * layout is kept between calls and the edit is applied in place. The
+         * lines touched by the edit are found with a binary search over the
+         * line offsets and only they are laid out again, after which the
+         * glyphs of the following lines are moved if their position changed.
+         * Allocation behavior is the same as in @ref render(). Only the
+         * vertex data of the affected lines
+         * are then uploaded if the glyph and line count stays the same,
+         * otherwise the upload starts at the first affected line. If the
+         * edit changes height of a vertically centered or top-aligned text,
+         * all vertex data are uploaded. Otherwise the whole text is rendered
+         * again.
+         *
+         * @snippet MagnumText.cpp Renderer-edit
+         *
+         * @attention The capacity must be large enough to contain all glyphs,
+         *      see @ref reserve() for more information.
+         */
+        void replace(std::size_t position, std::size_t size, const std::string& text);
+
     #ifndef DOXYGEN_GENERATING_OUTPUT
     protected:
     #else
@@ -133,17 +276,40 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         #endif
 
     private:
+        /* Text offset and glyph range of a single line and its bounds
+           relative to the line origin, for fonts supporting
+           FontFeature::BatchLayout */
+        struct Line {
+            std::size_t textBegin;
+            UnsignedInt glyphBegin, glyphCount;
+            Range2D rectangle;
+            bool hasText;
+        };
+
+        MAGNUM_TEXT_LOCAL void reserveInternal(UnsignedInt glyphCount, GL::BufferUsage vertexBufferUsage);
+        MAGNUM_TEXT_LOCAL void updateInternal(const char* function, std::size_t position, std::size_t size, const std::string& text);
+
         AbstractFont& font;
         const GlyphCache& cache;
         Float size;
         Alignment _alignment;
-        UnsignedInt _capacity;
+        UnsignedInt _capacity, _glyphCount;
+        Float _verticalOffset;
         Range2D _rectangle;
+        std::string _text;
+        /* Persistent layout for fonts supporting FontFeature::BatchLayout.
+           Glyph positions are relative to the line origin. The scratch
+           memory holds the lines affected by an edit before they're put in
+           place, advances are only ever a scratch memory. */
+        std::vector<Line> _lines, _scratchLines;
+        std::string _scratchText;
+        Containers::Array<UnsignedInt> _glyphIds, _scratchGlyphIds;
+        Containers::Array<Vector2> _glyphPositions, _scratchGlyphPositions, _glyphAdvances;
 
         #if defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
-        typedef void*(*BufferMapImplementation)(GL::Buffer&, GLsizeiptr);
-        static MAGNUM_TEXT_LOCAL void* bufferMapImplementationFull(GL::Buffer& buffer, GLsizeiptr length);
-        static MAGNUM_TEXT_LOCAL void* bufferMapImplementationRange(GL::Buffer& buffer, GLsizeiptr length);
+        typedef void*(*BufferMapImplementation)(GL::Buffer&, GLintptr, GLsizeiptr, GLsizeiptr);
+        static MAGNUM_TEXT_LOCAL void* bufferMapImplementationFull(GL::Buffer& buffer, GLintptr offset, GLsizeiptr length, GLsizeiptr usedLength);
+        static MAGNUM_TEXT_LOCAL void* bufferMapImplementationRange(GL::Buffer& buffer, GLintptr offset, GLsizeiptr length, GLsizeiptr usedLength);
         static BufferMapImplementation bufferMapImplementation;
         #else
         #ifndef CORRADE_TARGET_EMSCRIPTEN
@@ -151,12 +317,12 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         #else
         MAGNUM_TEXT_LOCAL
         #endif
-        void* bufferMapImplementation(GL::Buffer& buffer, GLsizeiptr length);
+        void* bufferMapImplementation(GL::Buffer& buffer, GLintptr offset, GLsizeiptr length, GLsizeiptr usedLength);
         #endif
 
         #if defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
-        typedef void(*BufferUnmapImplementation)(GL::Buffer&);
-        static MAGNUM_TEXT_LOCAL void bufferUnmapImplementationDefault(GL::Buffer& buffer);
+        typedef void(*BufferUnmapImplementation)(GL::Buffer&, GLintptr, GLsizeiptr);
+        static MAGNUM_TEXT_LOCAL void bufferUnmapImplementationDefault(GL::Buffer& buffer, GLintptr offset, GLsizeiptr length);
         static MAGNUM_TEXT_LOCAL BufferUnmapImplementation bufferUnmapImplementation;
         #else
         #ifndef CORRADE_TARGET_EMSCRIPTEN
@@ -164,7 +330,7 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         #else
         MAGNUM_TEXT_LOCAL
         #endif
-        void bufferUnmapImplementation(GL::Buffer& buffer);
+        void bufferUnmapImplementation(GL::Buffer& buffer, GLintptr offset, GLsizeiptr length);
         #endif
 };
 
@@ -193,6 +359,14 @@ that doesn't recreate everything on each text change:
 
 @snippet MagnumText.cpp Renderer-usage2
 
+If only a part of the text changes (e.g. a text field being edited), use
+@ref insert(), @ref erase() or @ref replace() instead of rendering the whole
+text again. With fonts supporting @ref FontFeature::BatchLayout only the
+affected lines are laid out again and only the changed part of the vertex
+buffer is uploaded. Since the index buffer contents depend only on the glyph
+count, many renderers can share a single index buffer, see
+@ref reserve(UnsignedInt, GL::BufferUsage, GL::Buffer&, MeshIndexType).
+
 @section Text-Renderer-required-opengl-functionality Required OpenGL functionality
 
 Mutable text rendering requires @gl_extension{ARB,map_buffer_range} on desktop
@@ -242,10 +416,8 @@ typedef Renderer<2> Renderer2D;
 
 /** @brief Three-dimensional text renderer */
 typedef Renderer<3> Renderer3D;
+#endif
 
 }}
-#else
-#error this header is available only in the OpenGL build
-#endif
 
 #endif
@@ -26,7 +26,9 @@
 #include <sstream>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 
@@ -82,7 +84,14 @@ struct AbstractFontTest: TestSuite::Tester {
     void layout();
     void layoutNoFont();
 
+    void layoutGlyphs();
+    void layoutGlyphsNotEnoughSpace();
+    void layoutGlyphsImplementation();
+    void layoutGlyphsNoFont();
+    void layoutGlyphsInvalidViewSize();
+
     void fillGlyphCache();
+    void fillGlyphCacheDynamic();
     void fillGlyphCacheNotSupported();
     void fillGlyphCacheNotImplemented();
     void fillGlyphCacheNoFont();
@@ -137,7 +146,14 @@ AbstractFontTest::AbstractFontTest() {
               &AbstractFontTest::layout,
               &AbstractFontTest::layoutNoFont,
 
+              &AbstractFontTest::layoutGlyphs,
+              &AbstractFontTest::layoutGlyphsNotEnoughSpace,
+              &AbstractFontTest::layoutGlyphsImplementation,
+              &AbstractFontTest::layoutGlyphsNoFont,
+              &AbstractFontTest::layoutGlyphsInvalidViewSize,
+
               &AbstractFontTest::fillGlyphCache,
+              &AbstractFontTest::fillGlyphCacheDynamic,
               &AbstractFontTest::fillGlyphCacheNotSupported,
               &AbstractFontTest::fillGlyphCacheNotImplemented,
               &AbstractFontTest::fillGlyphCacheNoFont,
@@ -990,6 +1006,147 @@ void AbstractFontTest::layoutNoFont() {
     CORRADE_COMPARE(out.str(), "Text::AbstractFont::layout(): no font opened\n");
 }
 
+void AbstractFontTest::layoutGlyphs() {
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t character) override { return character - U'a'; }
+        Vector2 doGlyphAdvance(UnsignedInt glyph) override { return {glyph*1.5f, 0.5f}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override { return nullptr; }
+    } font;
+
+    UnsignedInt glyphIds[4];
+    Vector2 glyphOffsets[4]{{7.0f, 7.0f}, {7.0f, 7.0f}, {7.0f, 7.0f}, {7.0f, 7.0f}};
+    Vector2 glyphAdvances[4];
+
+    /* The default implementation should go through all UTF-8 characters */
+    CORRADE_COMPARE(font.layoutGlyphs(Containers::arrayView("ab\xc4\x8d", 4),
+        glyphIds, glyphOffsets, glyphAdvances), 3);
+    CORRADE_COMPARE_AS(Containers::arrayView(glyphIds).prefix(3),
+        Containers::arrayView<UnsignedInt>({0, 1, 0x10d - 'a'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(glyphOffsets).prefix(3),
+        Containers::arrayView<Vector2>({{}, {}, {}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(glyphAdvances).prefix(3),
+        Containers::arrayView<Vector2>({
+            {0.0f, 0.5f},
+            {1.5f, 0.5f},
+            {(0x10d - 'a')*1.5f, 0.5f}
+        }), TestSuite::Compare::Container);
+
+    /* The fourth element is untouched */
+    CORRADE_COMPARE(glyphOffsets[3], (Vector2{7.0f, 7.0f}));
+}
+
+void AbstractFontTest::layoutGlyphsNotEnoughSpace() {
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t character) override { return character; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override { return nullptr; }
+    } font;
+
+    UnsignedInt glyphIds[2];
+    Vector2 glyphOffsets[2];
+    Vector2 glyphAdvances[2];
+
+    /* The total count is returned but only the first two glyphs written */
+    CORRADE_COMPARE(font.layoutGlyphs(Containers::arrayView("hello", 5),
+        glyphIds, glyphOffsets, glyphAdvances), 5);
+    CORRADE_COMPARE_AS(Containers::arrayView(glyphIds),
+        Containers::arrayView<UnsignedInt>({'h', 'e'}),
+        TestSuite::Compare::Container);
+
+    /* Empty views should work too */
+    CORRADE_COMPARE(font.layoutGlyphs(Containers::arrayView("hello", 5),
+        nullptr, nullptr, nullptr), 5);
+}
+
+void AbstractFontTest::layoutGlyphsImplementation() {
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return FontFeature::BatchLayout; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override { return nullptr; }
+
+        UnsignedInt doLayoutGlyphs(Containers::ArrayView<const char> text, const Containers::StridedArrayView1D<UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<Vector2>& glyphOffsets, const Containers::StridedArrayView1D<Vector2>& glyphAdvances) override {
+            /* A ligature */
+            CORRADE_COMPARE(text.size(), 2);
+            glyphIds[0] = 1337;
+            glyphOffsets[0] = {0.5f, -0.5f};
+            glyphAdvances[0] = {3.0f, 0.0f};
+            return 1;
+        }
+    } font;
+
+    UnsignedInt glyphIds[1];
+    Vector2 glyphOffsets[1];
+    Vector2 glyphAdvances[1];
+    CORRADE_COMPARE(font.layoutGlyphs(Containers::arrayView("fi", 2),
+        glyphIds, glyphOffsets, glyphAdvances), 1);
+    CORRADE_COMPARE(glyphIds[0], 1337);
+    CORRADE_COMPARE(glyphOffsets[0], (Vector2{0.5f, -0.5f}));
+    CORRADE_COMPARE(glyphAdvances[0], (Vector2{3.0f, 0.0f}));
+}
+
+void AbstractFontTest::layoutGlyphsNoFont() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override { return nullptr; }
+    } font;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    font.layoutGlyphs(Containers::arrayView("hello", 5), nullptr, nullptr, nullptr);
+    CORRADE_COMPARE(out.str(), "Text::AbstractFont::layoutGlyphs(): no font opened\n");
+}
+
+void AbstractFontTest::layoutGlyphsInvalidViewSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override { return nullptr; }
+    } font;
+
+    UnsignedInt glyphIds[3];
+    Vector2 glyphOffsets[2];
+    Vector2 glyphAdvances[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    font.layoutGlyphs(Containers::arrayView("hello", 5), glyphIds, glyphOffsets, glyphAdvances);
+    font.layoutGlyphs(Containers::arrayView("hello", 5), glyphIds, glyphAdvances, glyphOffsets);
+    CORRADE_COMPARE(out.str(),
+        "Text::AbstractFont::layoutGlyphs(): expected glyph ID, offset and advance views to have the same size but got 3, 2 and 3\n"
+        "Text::AbstractFont::layoutGlyphs(): expected glyph ID, offset and advance views to have the same size but got 3, 3 and 2\n");
+}
+
 void AbstractFontTest::fillGlyphCache() {
     struct MyFont: AbstractFont {
         FontFeatures doFeatures() const override { return {}; }
@@ -1017,6 +1174,53 @@ void AbstractFontTest::fillGlyphCache() {
     CORRADE_COMPARE(cache['o'*10], (std::pair<Vector2i, Range2Di>{{55, 222}, {}}));
 }
 
+void AbstractFontTest::fillGlyphCacheDynamic() {
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        /* 'z' is not in the font */
+        UnsignedInt doGlyphId(char32_t character) override {
+            return character == 'z' ? 0 : character;
+        }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override { return nullptr; }
+
+        void doFillGlyphCache(AbstractGlyphCache& cache, const std::u32string& characters) override {
+            ++called;
+            const std::vector<Range2Di> rectangles = cache.reserve(std::vector<Vector2i>(characters.size(), Vector2i{1}));
+            for(std::size_t i = 0; i != characters.size(); ++i) {
+                filled += char(characters[i]);
+                cache.insert(characters[i], {}, rectangles[i]);
+            }
+        }
+
+        Int called = 0;
+        std::string filled;
+    } font;
+
+    DummyGlyphCache cache{{16, 16}};
+    cache.setDynamic(true);
+
+    /* Each glyph is filled just once */
+    font.fillGlyphCache(cache, "hello");
+    CORRADE_COMPARE(font.called, 1);
+    CORRADE_COMPARE(font.filled, "ehlo");
+    CORRADE_COMPARE(cache.glyphCount(), 5);
+
+    /* Glyphs already in the cache and glyphs not in the font are skipped */
+    cache.nextFrame();
+    font.fillGlyphCache(cache, "hole zz");
+    CORRADE_COMPARE(font.called, 2);
+    CORRADE_COMPARE(font.filled, "ehlo ");
+    CORRADE_COMPARE(cache.glyphCount(), 6);
+
+    /* Nothing to fill, the implementation isn't called at all */
+    font.fillGlyphCache(cache, "eh");
+    CORRADE_COMPARE(font.called, 2);
+}
+
 void AbstractFontTest::fillGlyphCacheNotSupported() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
@@ -1175,8 +1379,8 @@ void AbstractFontTest::createGlyphCacheNoFont() {
 void AbstractFontTest::debugFeature() {
     std::ostringstream out;
 
-    Debug{&out} << FontFeature::OpenData << FontFeature(0xf0);
-    CORRADE_COMPARE(out.str(), "Text::FontFeature::OpenData Text::FontFeature(0xf0)\n");
+    Debug{&out} << FontFeature::OpenData << FontFeature::BatchLayout << FontFeature(0xf0);
+    CORRADE_COMPARE(out.str(), "Text::FontFeature::OpenData Text::FontFeature::BatchLayout Text::FontFeature(0xf0)\n");
 }
 
 void AbstractFontTest::debugFeatures() {
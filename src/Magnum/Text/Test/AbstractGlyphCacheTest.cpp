@@ -25,6 +25,7 @@
 
 #include <sstream>
 #include <tuple>
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
 
@@ -42,6 +43,14 @@ struct AbstractGlyphCacheTest: TestSuite::Tester {
     void access();
     void reserve();
 
+    void dynamicReserve();
+    void dynamicEvict();
+    void dynamicSetImage();
+    void dynamicNotEmpty();
+    void dynamicInsertNotReserved();
+    void dynamicSetImageFormatMismatch();
+    void notDynamic();
+
     void setImage();
     void setImageOutOfBounds();
 
@@ -55,6 +64,14 @@ AbstractGlyphCacheTest::AbstractGlyphCacheTest() {
               &AbstractGlyphCacheTest::access,
               &AbstractGlyphCacheTest::reserve,
 
+              &AbstractGlyphCacheTest::dynamicReserve,
+              &AbstractGlyphCacheTest::dynamicEvict,
+              &AbstractGlyphCacheTest::dynamicSetImage,
+              &AbstractGlyphCacheTest::dynamicNotEmpty,
+              &AbstractGlyphCacheTest::dynamicInsertNotReserved,
+              &AbstractGlyphCacheTest::dynamicSetImageFormatMismatch,
+              &AbstractGlyphCacheTest::notDynamic,
+
               &AbstractGlyphCacheTest::setImage,
               &AbstractGlyphCacheTest::setImageOutOfBounds,
 
@@ -114,6 +131,207 @@ void AbstractGlyphCacheTest::reserve() {
     CORRADE_VERIFY(!cache.reserve({{5, 3}}).empty());
 }
 
+void AbstractGlyphCacheTest::dynamicReserve() {
+    DummyGlyphCache cache{Vector2i{64}, Vector2i{1}};
+    CORRADE_VERIFY(!cache.isDynamic());
+    cache.setDynamic(true);
+    CORRADE_VERIFY(cache.isDynamic());
+    CORRADE_COMPARE(cache.frame(), 0);
+
+    /* The first two fit into the same row, the third is too high and gets a
+       new row */
+    std::vector<Range2Di> rectangles = cache.reserve({{8, 8}, {18, 8}, {8, 18}});
+    CORRADE_COMPARE(rectangles.size(), 3);
+    CORRADE_COMPARE(rectangles[0], (Range2Di{{1, 1}, {9, 9}}));
+    CORRADE_COMPARE(rectangles[1], (Range2Di{{11, 1}, {29, 9}}));
+    CORRADE_COMPARE(rectangles[2], (Range2Di{{1, 11}, {9, 29}}));
+
+    /* Insert only the first two */
+    cache.insert(5, {1, 2}, rectangles[0]);
+    cache.insert(7, {3, 4}, rectangles[1]);
+    CORRADE_COMPARE(cache.glyphCount(), 3);
+    CORRADE_COMPARE(cache[5], (std::pair<Vector2i, Range2Di>{{0, 1}, {{0, 0}, {10, 10}}}));
+    CORRADE_COMPARE(cache[7], (std::pair<Vector2i, Range2Di>{{2, 3}, {{10, 0}, {30, 10}}}));
+
+    /* The third rectangle wasn't used, so the row is given back. The next
+       glyph is put after the first two. */
+    rectangles = cache.reserve({{8, 8}, {8, 18}});
+    CORRADE_COMPARE(rectangles.size(), 2);
+    CORRADE_COMPARE(rectangles[0], (Range2Di{{31, 1}, {39, 9}}));
+    CORRADE_COMPARE(rectangles[1], (Range2Di{{1, 11}, {9, 29}}));
+}
+
+void AbstractGlyphCacheTest::dynamicEvict() {
+    DummyGlyphCache cache{{32, 10}};
+    cache.setDynamic(true);
+
+    std::vector<Range2Di> rectangles = cache.reserve({{16, 10}, {16, 10}});
+    CORRADE_COMPARE(rectangles[0], (Range2Di{{0, 0}, {16, 10}}));
+    CORRADE_COMPARE(rectangles[1], (Range2Di{{16, 0}, {32, 10}}));
+    cache.insert(1, {}, rectangles[0]);
+    cache.insert(2, {}, rectangles[1]);
+
+    /* Use only glyph 2 in the next frame */
+    cache.nextFrame();
+    CORRADE_COMPARE(cache.frame(), 1);
+    CORRADE_VERIFY(cache.markUsed(2));
+    CORRADE_VERIFY(cache.markUsed(0));
+    CORRADE_VERIFY(!cache.markUsed(3));
+    CORRADE_VERIFY(!cache.markUsed(1000));
+
+    /* The cache is full, glyph 1 gets evicted and its space reused */
+    rectangles = cache.reserve({{16, 10}});
+    CORRADE_COMPARE(rectangles[0], (Range2Di{{0, 0}, {16, 10}}));
+    CORRADE_COMPARE(cache.glyphCount(), 2);
+    CORRADE_COMPARE(cache[1], (std::pair<Vector2i, Range2Di>{}));
+    CORRADE_COMPARE(cache[2], (std::pair<Vector2i, Range2Di>{{}, {{16, 0}, {32, 10}}}));
+    cache.insert(3, {}, rectangles[0]);
+    CORRADE_COMPARE(cache.glyphCount(), 3);
+
+    /* All glyphs were used in this frame, so nothing can be evicted and an
+       empty rectangle is returned. It can be still inserted. */
+    rectangles = cache.reserve({{16, 10}});
+    CORRADE_COMPARE(rectangles[0], Range2Di{});
+    cache.insert(4, {}, rectangles[0]);
+    CORRADE_COMPARE(cache.glyphCount(), 4);
+    CORRADE_VERIFY(cache.markUsed(4));
+
+    /* In the next frame, a glyph spanning the whole row evicts both glyphs
+       in it, but not the glyph that doesn't occupy any space */
+    cache.nextFrame();
+    rectangles = cache.reserve({{32, 10}});
+    CORRADE_COMPARE(rectangles[0], (Range2Di{{0, 0}, {32, 10}}));
+    CORRADE_COMPARE(cache.glyphCount(), 2);
+    CORRADE_VERIFY(!cache.markUsed(2));
+    CORRADE_VERIFY(!cache.markUsed(3));
+    CORRADE_VERIFY(cache.markUsed(4));
+}
+
+void AbstractGlyphCacheTest::dynamicSetImage() {
+    struct MyGlyphCache: AbstractGlyphCache {
+        using AbstractGlyphCache::AbstractGlyphCache;
+
+        GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i& offset, const ImageView2D& image) override {
+            ++called;
+            imageOffset = offset;
+            imageSize = image.size();
+            imageData = std::string{image.data(), image.data().size()};
+        }
+
+        Int called = 0;
+        Vector2i imageOffset, imageSize;
+        std::string imageData;
+    } cache{{8, 4}};
+    cache.setDynamic(true);
+
+    char data[8*4];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i] = i;
+
+    /* Only the reserved parts of the image get copied and the upload is
+       delayed until flushImage() */
+    std::vector<Range2Di> rectangles = cache.reserve({{2, 2}, {2, 2}});
+    cache.insert(1, {}, rectangles[0]);
+    cache.insert(2, {}, rectangles[1]);
+    cache.setImage({}, ImageView2D{PixelFormat::R8Unorm, {8, 4}, data});
+    CORRADE_COMPARE(cache.called, 0);
+    CORRADE_COMPARE(cache.dirtyRectangle(), (Range2Di{{0, 0}, {4, 2}}));
+
+    cache.flushImage();
+    CORRADE_COMPARE(cache.called, 1);
+    CORRADE_COMPARE(cache.imageOffset, (Vector2i{0, 0}));
+    CORRADE_COMPARE(cache.imageSize, (Vector2i{4, 2}));
+    CORRADE_COMPARE(cache.imageData, (std::string{"\x00\x01\x02\x03\x08\x09\x0a\x0b", 8}));
+    CORRADE_COMPARE(cache.dirtyRectangle(), Range2Di{});
+
+    /* Nothing to upload */
+    cache.flushImage();
+    CORRADE_COMPARE(cache.called, 1);
+
+    /* The image overlaps also glyph 2, but that part isn't copied */
+    rectangles = cache.reserve({{2, 2}});
+    CORRADE_COMPARE(rectangles[0], (Range2Di{{4, 0}, {6, 2}}));
+    cache.insert(3, {}, rectangles[0]);
+    const char data2[]{'a', 'e', 'f', 'g',
+                       'h', 'i', 'j', 'k'};
+    cache.setImage({3, 0}, ImageView2D{PixelFormat::R8Unorm, {4, 2}, data2});
+    CORRADE_COMPARE(cache.dirtyRectangle(), (Range2Di{{4, 0}, {6, 2}}));
+
+    cache.flushImage();
+    CORRADE_COMPARE(cache.called, 2);
+    CORRADE_COMPARE(cache.imageOffset, (Vector2i{4, 0}));
+    CORRADE_COMPARE(cache.imageSize, (Vector2i{2, 2}));
+    CORRADE_COMPARE(cache.imageData, "efij");
+}
+
+void AbstractGlyphCacheTest::dynamicNotEmpty() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DummyGlyphCache cache{Vector2i{16}};
+    cache.insert(1, {}, {});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.setDynamic(true);
+    CORRADE_COMPARE(out.str(), "Text::AbstractGlyphCache::setDynamic(): the cache is not empty\n");
+}
+
+void AbstractGlyphCacheTest::dynamicInsertNotReserved() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DummyGlyphCache cache{Vector2i{16}};
+    cache.setDynamic(true);
+    cache.reserve({{4, 4}});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.insert(1, {}, {{4, 0}, {8, 4}});
+    CORRADE_COMPARE(out.str(), "Text::AbstractGlyphCache::insert(): rectangle Range({4, 0}, {8, 4}) wasn't reserved in a dynamic cache\n");
+}
+
+void AbstractGlyphCacheTest::dynamicSetImageFormatMismatch() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DummyGlyphCache cache{Vector2i{16}};
+    cache.setDynamic(true);
+    char data[4*4*2]{};
+    cache.setImage({}, ImageView2D{PixelFormat::R8Unorm, {4, 4}, data});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.setImage({}, ImageView2D{PixelFormat::RG8Unorm, {4, 4}, data});
+    CORRADE_COMPARE(out.str(), "Text::AbstractGlyphCache::setImage(): expected PixelFormat::R8Unorm but got PixelFormat::RG8Unorm in a dynamic cache\n");
+}
+
+void AbstractGlyphCacheTest::notDynamic() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DummyGlyphCache cache{Vector2i{16}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.frame();
+    cache.nextFrame();
+    cache.markUsed(0);
+    cache.dirtyRectangle();
+    cache.flushImage();
+    CORRADE_COMPARE(out.str(),
+        "Text::AbstractGlyphCache::frame(): the cache is not dynamic\n"
+        "Text::AbstractGlyphCache::nextFrame(): the cache is not dynamic\n"
+        "Text::AbstractGlyphCache::markUsed(): the cache is not dynamic\n"
+        "Text::AbstractGlyphCache::dirtyRectangle(): the cache is not dynamic\n"
+        "Text::AbstractGlyphCache::flushImage(): the cache is not dynamic\n");
+}
+
 void AbstractGlyphCacheTest::setImage() {
     struct MyGlyphCache: AbstractGlyphCache {
         using AbstractGlyphCache::AbstractGlyphCache;
@@ -24,12 +24,16 @@
 */
 
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 
+#include "Magnum/Mesh.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/OpenGLTester.h"
 #include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/GlyphCache.h"
 #include "Magnum/Text/Renderer.h"
 
 namespace Magnum { namespace Text { namespace Test { namespace {
@@ -43,6 +47,48 @@ struct RendererGLTest: GL::OpenGLTester {
     void mutableText();
 
     void multiline();
+    void multilineBatchLayout();
+    void multilineBatchLayoutMutable();
+
+    void edit();
+    void editPartialUpdate();
+    void editNoBatchLayout();
+    void sharedIndexBuffer();
+};
+
+const struct {
+    const char* name;
+    Alignment alignment;
+    const char* text;
+    std::size_t position, size;
+    const char* replacement;
+    const char* expected;
+} EditData[]{
+    {"same glyph count", Alignment::MiddleCenter,
+        "abcd\nef\n\nghi", 5, 2, "xy", "abcd\nxy\n\nghi"},
+    /* Updates a range at the start of the buffer, the rest has to stay */
+    {"same glyph count on the first line", Alignment::LineLeft,
+        "abcd\nef\n\nghi", 1, 2, "xy", "axyd\nef\n\nghi"},
+    {"more glyphs on a line", Alignment::MiddleCenter,
+        "abcd\nef\n\nghi", 7, 0, "z", "abcd\nefz\n\nghi"},
+    {"less glyphs on a line", Alignment::MiddleCenter,
+        "abcd\nef\n\nghi", 0, 2, "", "cd\nef\n\nghi"},
+    {"removing a line", Alignment::MiddleCenter,
+        "abcd\nef\n\nghi", 8, 1, "", "abcd\nef\nghi"},
+    {"removing a line, line alignment", Alignment::LineRight,
+        "abcd\nef\n\nghi", 8, 1, "", "abcd\nef\nghi"},
+    {"adding lines", Alignment::TopLeft,
+        "abcd\nef\n\nghi", 0, 0, "jk\n\nl", "jk\n\nlabcd\nef\n\nghi"},
+    {"joining lines", Alignment::MiddleCenter,
+        "abcd\nef\n\nghi", 4, 1, "", "abcdef\n\nghi"},
+    {"replacing across lines", Alignment::MiddleCenter,
+        "abcd\nef\n\nghi", 2, 5, "x\ny\nz", "abx\ny\nz\n\nghi"},
+    {"appending a line", Alignment::LineLeft,
+        "abcd\nef\n\nghi", 12, 0, "\njk", "abcd\nef\n\nghi\njk"},
+    {"replacing everything", Alignment::MiddleCenter,
+        "abcd\nef\n\nghi", 0, 12, "m", "m"},
+    {"into empty text", Alignment::MiddleCenter,
+        "", 0, 0, "ab\nc", "ab\nc"}
 };
 
 RendererGLTest::RendererGLTest() {
@@ -51,7 +97,16 @@ RendererGLTest::RendererGLTest() {
               &RendererGLTest::renderMeshIndexType,
               &RendererGLTest::mutableText,
 
-              &RendererGLTest::multiline});
+              &RendererGLTest::multiline,
+              &RendererGLTest::multilineBatchLayout,
+              &RendererGLTest::multilineBatchLayoutMutable});
+
+    addInstancedTests({&RendererGLTest::edit},
+        Containers::arraySize(EditData));
+
+    addTests({&RendererGLTest::editPartialUpdate,
+              &RendererGLTest::editNoBatchLayout,
+              &RendererGLTest::sharedIndexBuffer});
 }
 
 class TestLayouter: public Text::AbstractLayouter {
@@ -431,6 +486,333 @@ void RendererGLTest::multiline() {
     }), TestSuite::Compare::Container);
 }
 
+/* Equivalent to the font in multiline(), but going through the batch layout
+   and glyph cache. Scale is 1, so the glyph cache contents are used as-is. */
+class BatchLayoutFont: public Text::AbstractFont {
+    public:
+        explicit BatchLayoutFont(): _opened(false) {}
+
+    private:
+        FontFeatures doFeatures() const override { return FontFeature::BatchLayout; }
+
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        Metrics doOpenFile(const std::string&, Float) override {
+            _opened = true;
+            return {2.0f, 1.8f, -1.0f, 3.0f};
+        }
+
+        UnsignedInt doGlyphId(char32_t) override { return 0; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return Vector2::xAxis(2.0f); }
+
+        /* The batch layout should be used instead */
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override { return nullptr; }
+
+        bool _opened;
+};
+
+constexpr Vector2 MultilinePositions[]{
+    {-3.5f,  5.0f}, {-3.5f,  4.0f}, {-2.5f,  5.0f}, {-2.5f,  4.0f}, /* a */
+    {-1.5f,  5.0f}, {-1.5f,  4.0f}, {-0.5f,  5.0f}, {-0.5f,  4.0f}, /* b */
+    { 0.5f,  5.0f}, { 0.5f,  4.0f}, { 1.5f,  5.0f}, { 1.5f,  4.0f}, /* c */
+    { 2.5f,  5.0f}, { 2.5f,  4.0f}, { 3.5f,  5.0f}, { 3.5f,  4.0f}, /* d */
+    {-1.5f,  2.0f}, {-1.5f,  1.0f}, {-0.5f,  2.0f}, {-0.5f,  1.0f}, /* e */
+    { 0.5f,  2.0f}, { 0.5f,  1.0f}, { 1.5f,  2.0f}, { 1.5f,  1.0f}, /* f */
+    {-2.5f, -4.0f}, {-2.5f, -5.0f}, {-1.5f, -4.0f}, {-1.5f, -5.0f}, /* g */
+    {-0.5f, -4.0f}, {-0.5f, -5.0f}, { 0.5f, -4.0f}, { 0.5f, -5.0f}, /* h */
+    { 1.5f, -4.0f}, { 1.5f, -5.0f}, { 2.5f, -4.0f}, { 2.5f, -5.0f}  /* i */
+};
+
+void RendererGLTest::multilineBatchLayout() {
+    BatchLayoutFont font;
+    font.openFile({}, 0.0f);
+
+    GlyphCache cache{{2, 2}};
+    cache.insert(0, {}, {{}, {1, 1}});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Range2D rectangle;
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector2> positions, textureCoordinates;
+    std::tie(positions, textureCoordinates, indices, rectangle) = Text::Renderer2D::render(font,
+        cache, 2.0f, "abcd\nef\n\nghi", Alignment::MiddleCenter);
+
+    /* Same as in multiline() */
+    CORRADE_COMPARE(rectangle, Range2D({-3.5f, -5.0f}, {3.5f, 5.0f}));
+    CORRADE_COMPARE_AS(Containers::arrayView(positions),
+        Containers::arrayView(MultilinePositions),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(textureCoordinates.size(), 36);
+    CORRADE_COMPARE(textureCoordinates[0], (Vector2{0.0f, 0.5f}));
+    CORRADE_COMPARE(textureCoordinates[3], (Vector2{0.5f, 0.0f}));
+    CORRADE_COMPARE(indices.size(), 9*6);
+}
+
+void RendererGLTest::multilineBatchLayoutMutable() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::map_buffer_range>())
+        CORRADE_SKIP(GL::Extensions::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::map_buffer_range>() &&
+       !GL::Context::current().isExtensionSupported<GL::Extensions::OES::mapbuffer>())
+        CORRADE_SKIP("No required extension is supported");
+    #endif
+
+    BatchLayoutFont font;
+    font.openFile({}, 0.0f);
+
+    GlyphCache cache{{2, 2}};
+    cache.insert(0, {}, {{}, {1, 1}});
+
+    Text::Renderer2D renderer(font, cache, 2.0f, Alignment::MiddleCenter);
+    renderer.reserve(9, GL::BufferUsage::DynamicDraw, GL::BufferUsage::DynamicDraw);
+    renderer.render("abcd\nef\n\nghi");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({-3.5f, -5.0f}, {3.5f, 5.0f}));
+    CORRADE_COMPARE(renderer.mesh().count(), 9*6);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<char> vertices = renderer.vertexBuffer().data();
+    CORRADE_COMPARE_AS(Containers::stridedArrayView(Containers::arrayCast<const Vector2>(vertices)).every(2),
+        Containers::stridedArrayView(MultilinePositions),
+        TestSuite::Compare::Container);
+    #endif
+
+    /* Rendering a shorter text afterwards updates just the count */
+    renderer.render("ab");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({-1.5f, -0.5f}, {1.5f, 0.5f}));
+    CORRADE_COMPARE(renderer.mesh().count(), 2*6);
+}
+
+void RendererGLTest::edit() {
+    auto&& data = EditData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::map_buffer_range>())
+        CORRADE_SKIP(GL::Extensions::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::map_buffer_range>() &&
+       !GL::Context::current().isExtensionSupported<GL::Extensions::OES::mapbuffer>())
+        CORRADE_SKIP("No required extension is supported");
+    #endif
+
+    BatchLayoutFont font;
+    font.openFile({}, 0.0f);
+
+    GlyphCache cache{{2, 2}};
+    cache.insert(0, {}, {{}, {1, 1}});
+
+    Text::Renderer2D renderer(font, cache, 2.0f, data.alignment);
+    renderer.reserve(16, GL::BufferUsage::DynamicDraw, GL::BufferUsage::DynamicDraw);
+    renderer.render(data.text);
+    renderer.replace(data.position, data.size, data.replacement);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.text(), data.expected);
+
+    /* The result should be the same as when rendering the whole text from
+       scratch */
+    Text::Renderer2D expected(font, cache, 2.0f, data.alignment);
+    expected.reserve(16, GL::BufferUsage::DynamicDraw, GL::BufferUsage::DynamicDraw);
+    expected.render(data.expected);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(renderer.rectangle(), expected.rectangle());
+    CORRADE_COMPARE(renderer.mesh().count(), expected.mesh().count());
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    const std::size_t vertexCount = expected.mesh().count()/6*4;
+    Containers::Array<char> vertices = renderer.vertexBuffer().data();
+    Containers::Array<char> expectedVertices = expected.vertexBuffer().data();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Vector2>(vertices).prefix(vertexCount*2),
+        Containers::arrayCast<const Vector2>(expectedVertices).prefix(vertexCount*2),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void RendererGLTest::editPartialUpdate() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::map_buffer_range>())
+        CORRADE_SKIP(GL::Extensions::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::map_buffer_range>() &&
+       !GL::Context::current().isExtensionSupported<GL::Extensions::OES::mapbuffer>())
+        CORRADE_SKIP("No required extension is supported");
+    #endif
+
+    BatchLayoutFont font;
+    font.openFile({}, 0.0f);
+
+    GlyphCache cache{{2, 2}};
+    cache.insert(0, {}, {{}, {1, 1}});
+
+    Text::Renderer2D renderer(font, cache, 2.0f, Alignment::LineLeft);
+    renderer.reserve(16, GL::BufferUsage::DynamicDraw, GL::BufferUsage::DynamicDraw);
+    renderer.render("abcd\nef");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Overwrite the vertices of the first line with garbage to detect whether
+       they get uploaded again */
+    Vector2 garbage[4*4*2];
+    for(Vector2& i: garbage) i = Vector2{-100.0f};
+    renderer.vertexBuffer().setSubData(0, Containers::arrayView(garbage));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Editing the second line doesn't touch the first one */
+    renderer.insert(7, "gh");
+    renderer.erase(5, 1);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.text(), "abcd\nfgh");
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, -3.0f}, {7.0f, 1.0f}));
+    CORRADE_COMPARE(renderer.mesh().count(), 7*6);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    {
+        Containers::Array<char> vertices = renderer.vertexBuffer().data();
+        Containers::StridedArrayView1D<const Vector2> positions = Containers::stridedArrayView(Containers::arrayCast<const Vector2>(vertices)).every(2);
+        CORRADE_COMPARE_AS(Containers::arrayCast<const Vector2>(vertices).prefix(4*4*2),
+            Containers::arrayView(garbage),
+            TestSuite::Compare::Container);
+        const Vector2 expected[]{
+            {0.0f, -2.0f}, {0.0f, -3.0f}, {1.0f, -2.0f}, {1.0f, -3.0f}, /* f */
+            {2.0f, -2.0f}, {2.0f, -3.0f}, {3.0f, -2.0f}, {3.0f, -3.0f}, /* g */
+            {4.0f, -2.0f}, {4.0f, -3.0f}, {5.0f, -2.0f}, {5.0f, -3.0f}  /* h */
+        };
+        CORRADE_COMPARE_AS(positions.slice(4*4, 7*4),
+            Containers::stridedArrayView(expected),
+            TestSuite::Compare::Container);
+    }
+    #endif
+
+    /* Inserting a line before moves everything, so all gets uploaded again */
+    renderer.insert(0, "\n");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.text(), "\nabcd\nfgh");
+    CORRADE_COMPARE(renderer.mesh().count(), 7*6);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    {
+        Containers::Array<char> vertices = renderer.vertexBuffer().data();
+        Containers::StridedArrayView1D<const Vector2> positions = Containers::stridedArrayView(Containers::arrayCast<const Vector2>(vertices)).every(2);
+        CORRADE_COMPARE(positions[0], (Vector2{0.0f, -2.0f}));
+        CORRADE_COMPARE(positions[1], (Vector2{0.0f, -3.0f}));
+        CORRADE_COMPARE(positions[4*4], (Vector2{0.0f, -5.0f}));
+        CORRADE_COMPARE(positions[4*4 + 1], (Vector2{0.0f, -6.0f}));
+    }
+    #endif
+
+    /* Editing the last line after the lines moved finds it at its new
+       offset. The result should be the same as when rendering the whole text
+       from scratch. */
+    renderer.replace(7, 2, "xyz");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.text(), "\nabcd\nfxyz");
+
+    Text::Renderer2D expected(font, cache, 2.0f, Alignment::LineLeft);
+    expected.reserve(16, GL::BufferUsage::DynamicDraw, GL::BufferUsage::DynamicDraw);
+    expected.render("\nabcd\nfxyz");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.rectangle(), expected.rectangle());
+    CORRADE_COMPARE(renderer.mesh().count(), expected.mesh().count());
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    {
+        const std::size_t vertexCount = expected.mesh().count()/6*4;
+        Containers::Array<char> vertices = renderer.vertexBuffer().data();
+        Containers::Array<char> expectedVertices = expected.vertexBuffer().data();
+        CORRADE_COMPARE_AS(Containers::arrayCast<const Vector2>(vertices).prefix(vertexCount*2),
+            Containers::arrayCast<const Vector2>(expectedVertices).prefix(vertexCount*2),
+            TestSuite::Compare::Container);
+    }
+    #endif
+}
+
+void RendererGLTest::editNoBatchLayout() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::map_buffer_range>())
+        CORRADE_SKIP(GL::Extensions::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::map_buffer_range>() &&
+       !GL::Context::current().isExtensionSupported<GL::Extensions::OES::mapbuffer>())
+        CORRADE_SKIP("No required extension is supported");
+    #endif
+
+    TestFont font;
+    Text::Renderer2D renderer(font, nullGlyphCache, 0.25f);
+    renderer.reserve(4, GL::BufferUsage::DynamicDraw, GL::BufferUsage::DynamicDraw);
+    renderer.render("ac");
+    renderer.insert(1, "b");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Same as in mutableText() */
+    CORRADE_COMPARE(renderer.text(), "abc");
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, -0.5f}, {5.0f, 1.0f}));
+    CORRADE_COMPARE(renderer.mesh().count(), 3*6);
+
+    renderer.replace(0, 3, "a");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.text(), "a");
+    CORRADE_COMPARE(renderer.mesh().count(), 1*6);
+}
+
+void RendererGLTest::sharedIndexBuffer() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::map_buffer_range>())
+        CORRADE_SKIP(GL::Extensions::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::map_buffer_range>() &&
+       !GL::Context::current().isExtensionSupported<GL::Extensions::OES::mapbuffer>())
+        CORRADE_SKIP("No required extension is supported");
+    #endif
+
+    BatchLayoutFont font;
+    font.openFile({}, 0.0f);
+
+    GlyphCache cache{{2, 2}};
+    cache.insert(0, {}, {{}, {1, 1}});
+
+    /* More than 256 vertices, so a 16-bit type is needed */
+    GL::Buffer indices;
+    MeshIndexType indexType = Text::Renderer2D::fillIndexBuffer(indices, 70, GL::BufferUsage::StaticDraw);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(indexType, MeshIndexType::UnsignedShort);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<char> indexData = indices.data();
+    CORRADE_COMPARE(indexData.size(), 70*6*2);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedShort>(indexData).prefix(12),
+        (Containers::Array<UnsignedShort>{Containers::InPlaceInit, {
+            0, 1, 2, 1, 3, 2,
+            4, 5, 6, 5, 7, 6
+        }}), TestSuite::Compare::Container);
+    #endif
+
+    Text::Renderer2D a(font, cache, 2.0f);
+    Text::Renderer2D b(font, cache, 2.0f, Alignment::MiddleCenter);
+    a.reserve(4, GL::BufferUsage::DynamicDraw, indices, indexType);
+    b.reserve(9, GL::BufferUsage::DynamicDraw, indices, indexType);
+    a.render("ab");
+    b.render("abcd\nef\n\nghi");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(a.mesh().isIndexed());
+    CORRADE_VERIFY(b.mesh().isIndexed());
+    CORRADE_COMPARE(a.mesh().indexType(), GL::MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(b.mesh().indexType(), GL::MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(a.mesh().count(), 2*6);
+    CORRADE_COMPARE(b.mesh().count(), 9*6);
+    CORRADE_COMPARE(b.rectangle(), Range2D({-3.5f, -5.0f}, {3.5f, 5.0f}));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::RendererGLTest)
@@ -0,0 +1,139 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
+#include "Magnum/Text/Renderer.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct RendererTest: TestSuite::Tester {
+    explicit RendererTest();
+
+    void renderGlyphQuadsInto();
+    void renderGlyphQuadsIntoEmpty();
+    void renderGlyphQuadsIntoInvalidViewSize();
+};
+
+RendererTest::RendererTest() {
+    addTests({&RendererTest::renderGlyphQuadsInto,
+              &RendererTest::renderGlyphQuadsIntoEmpty,
+              &RendererTest::renderGlyphQuadsIntoInvalidViewSize});
+}
+
+struct DummyGlyphCache: AbstractGlyphCache {
+    using AbstractGlyphCache::AbstractGlyphCache;
+
+    GlyphCacheFeatures doFeatures() const override { return {}; }
+    void doSetImage(const Vector2i&, const ImageView2D&) override {}
+};
+
+void RendererTest::renderGlyphQuadsInto() {
+    DummyGlyphCache cache{{20, 20}};
+    cache.insert(3, {1, -2}, {{}, {4, 6}});
+    cache.insert(7, {}, {{10, 10}, {12, 20}});
+
+    const UnsignedInt glyphIds[]{3, 7, 3};
+    const Vector2 glyphOffsets[]{{}, {2.0f, 4.0f}, {}};
+    const Vector2 glyphAdvances[]{{10.0f, 0.0f}, {6.0f, 0.0f}, {10.0f, 0.0f}};
+
+    /* Interleaved output, the way Renderer has it in the vertex buffer */
+    struct Vertex {
+        Vector2 position, textureCoordinates;
+    } vertices[12];
+
+    Vector2 cursor{10.0f, 5.0f};
+    const Range2D rectangle = Text::renderGlyphQuadsInto(cache, 0.5f, cursor,
+        glyphIds, glyphOffsets, glyphAdvances,
+        Containers::StridedArrayView1D<Vector2>{vertices, &vertices[0].position, 12, sizeof(Vertex)},
+        Containers::StridedArrayView1D<Vector2>{vertices, &vertices[0].textureCoordinates, 12, sizeof(Vertex)});
+    CORRADE_COMPARE(cursor, (Vector2{23.0f, 5.0f}));
+    CORRADE_COMPARE(rectangle, (Range2D{{10.5f, 4.0f}, {20.5f, 12.0f}}));
+
+    /* 0---2
+       |   |
+       |   |
+       |   |
+       1---3 */
+    const Vector2 expectedPositions[]{
+        {10.5f, 7.0f}, {10.5f, 4.0f}, {12.5f, 7.0f}, {12.5f, 4.0f},
+        {16.0f, 12.0f}, {16.0f, 7.0f}, {17.0f, 12.0f}, {17.0f, 7.0f},
+        {18.5f, 7.0f}, {18.5f, 4.0f}, {20.5f, 7.0f}, {20.5f, 4.0f}
+    };
+    const Vector2 expectedTextureCoordinates[]{
+        {0.0f, 0.3f}, {0.0f, 0.0f}, {0.2f, 0.3f}, {0.2f, 0.0f},
+        {0.5f, 1.0f}, {0.5f, 0.5f}, {0.6f, 1.0f}, {0.6f, 0.5f},
+        {0.0f, 0.3f}, {0.0f, 0.0f}, {0.2f, 0.3f}, {0.2f, 0.0f}
+    };
+    CORRADE_COMPARE_AS((Containers::StridedArrayView1D<const Vector2>{vertices, &vertices[0].position, 12, sizeof(Vertex)}),
+        Containers::stridedArrayView(expectedPositions),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS((Containers::StridedArrayView1D<const Vector2>{vertices, &vertices[0].textureCoordinates, 12, sizeof(Vertex)}),
+        Containers::stridedArrayView(expectedTextureCoordinates),
+        TestSuite::Compare::Container);
+}
+
+void RendererTest::renderGlyphQuadsIntoEmpty() {
+    DummyGlyphCache cache{{20, 20}};
+
+    Vector2 cursor{10.0f, 5.0f};
+    const Range2D rectangle = Text::renderGlyphQuadsInto(cache, 0.5f, cursor,
+        nullptr, nullptr, nullptr, nullptr, nullptr);
+    CORRADE_COMPARE(cursor, (Vector2{10.0f, 5.0f}));
+    CORRADE_COMPARE(rectangle, Range2D{});
+}
+
+void RendererTest::renderGlyphQuadsIntoInvalidViewSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DummyGlyphCache cache{{20, 20}};
+
+    const UnsignedInt glyphIds[3]{};
+    const Vector2 glyphOffsets[3]{};
+    const Vector2 glyphAdvances[2]{};
+    Vector2 vertexPositions[12];
+    Vector2 vertexTextureCoordinates[11];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Vector2 cursor;
+    Text::renderGlyphQuadsInto(cache, 1.0f, cursor, glyphIds, glyphOffsets, glyphAdvances, vertexPositions, vertexPositions);
+    Text::renderGlyphQuadsInto(cache, 1.0f, cursor, glyphIds, glyphOffsets, glyphOffsets, vertexPositions, vertexTextureCoordinates);
+    CORRADE_COMPARE(out.str(),
+        "Text::renderGlyphQuadsInto(): expected glyph ID, offset and advance views to have the same size but got 3, 3 and 2\n"
+        "Text::renderGlyphQuadsInto(): expected vertex position and texture coordinate views to have 12 elements but got 12 and 11\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::RendererTest)
@@ -0,0 +1,146 @@
+#ifndef Magnum_TextureTools_Implementation_resampleKernels_hpp
+#define Magnum_TextureTools_Implementation_resampleKernels_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Types.h"
+#include "Magnum/Math/Implementation/cpuFeatures.hpp"
+
+namespace Magnum { namespace TextureTools { namespace Implementation {
+
+/* Kernels used by resampleInto(). The filter kernel calculates count
+   destination pixels, each being a weighted sum of taps consecutive source
+   pixels starting at given first index. The accumulate kernel adds a
+   weighted source row to a destination row of count floats and is used for
+   the vertical pass. The SIMD variants do the operations in the same order
+   as the scalar ones, so the results are the same on all platforms that
+   don't contract the multiplication and addition to a FMA. */
+typedef void(*ResampleFilterKernel)(const Float*, const Int*, const Float*, std::size_t, Float*, std::size_t);
+typedef void(*ResampleAccumulateKernel)(const Float*, Float, Float*, std::size_t);
+
+template<std::size_t channels> void resampleFilterScalar(const Float* src, const Int* first, const Float* weights, const std::size_t taps, Float* dst, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, weights += taps, dst += channels) {
+        const Float* s = src + first[i]*channels;
+        Float sum[channels]{};
+        for(std::size_t k = 0; k != taps; ++k, s += channels)
+            for(std::size_t c = 0; c != channels; ++c)
+                sum[c] += weights[k]*s[c];
+        for(std::size_t c = 0; c != channels; ++c)
+            dst[c] = sum[c];
+    }
+}
+
+inline void resampleAccumulateScalar(const Float* src, const Float weight, Float* dst, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i)
+        dst[i] += weight*src[i];
+}
+
+#ifdef CORRADE_TARGET_SSE2
+/* Four-channel pixels fit exactly into a SSE register. The other channel
+   counts would need shuffling and are left to the compiler. */
+inline void resampleFilter4Sse2(const Float* src, const Int* first, const Float* weights, const std::size_t taps, Float* dst, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, weights += taps, dst += 4) {
+        const Float* s = src + first[i]*4;
+        __m128 sum = _mm_setzero_ps();
+        for(std::size_t k = 0; k != taps; ++k, s += 4)
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(s)));
+        _mm_storeu_ps(dst, sum);
+    }
+}
+
+inline void resampleAccumulateSse2(const Float* src, const Float weight, Float* dst, const std::size_t count) {
+    const __m128 w = _mm_set1_ps(weight);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(w, _mm_loadu_ps(src + i))));
+    resampleAccumulateScalar(src + i, weight, dst + i, count - i);
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline void resampleAccumulateAvx2(const Float* src, const Float weight, Float* dst, const std::size_t count) {
+    const __m256 w = _mm256_set1_ps(weight);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(w, _mm256_loadu_ps(src + i))));
+    for(; i != count; ++i)
+        dst[i] += weight*src[i];
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+inline void resampleFilter4Neon(const Float* src, const Int* first, const Float* weights, const std::size_t taps, Float* dst, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, weights += taps, dst += 4) {
+        const Float* s = src + first[i]*4;
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        for(std::size_t k = 0; k != taps; ++k, s += 4)
+            sum = vaddq_f32(sum, vmulq_f32(vdupq_n_f32(weights[k]), vld1q_f32(s)));
+        vst1q_f32(dst, sum);
+    }
+}
+
+inline void resampleAccumulateNeon(const Float* src, const Float weight, Float* dst, const std::size_t count) {
+    const float32x4_t w = vdupq_n_f32(weight);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vmulq_f32(w, vld1q_f32(src + i))));
+    resampleAccumulateScalar(src + i, weight, dst + i, count - i);
+}
+#endif
+
+inline ResampleFilterKernel resampleFilterKernel(const std::size_t channels) {
+    switch(channels) {
+        case 1: return resampleFilterScalar<1>;
+        case 2: return resampleFilterScalar<2>;
+        case 3: return resampleFilterScalar<3>;
+        case 4:
+            #ifdef CORRADE_TARGET_SSE2
+            return resampleFilter4Sse2;
+            #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+            return resampleFilter4Neon;
+            #else
+            return resampleFilterScalar<4>;
+            #endif
+    }
+
+    return nullptr; /* LCOV_EXCL_LINE */
+}
+
+inline ResampleAccumulateKernel resampleAccumulateKernel() {
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_CPU_DISPATCH
+    if(Math::Implementation::cpuFeatures().avx2) return resampleAccumulateAvx2;
+    #endif
+    #ifdef CORRADE_TARGET_SSE2
+    return resampleAccumulateSse2;
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    return resampleAccumulateNeon;
+    #else
+    return resampleAccumulateScalar;
+    #endif
+}
+
+}}}
+
+#endif
@@ -0,0 +1,272 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Resample.h"
+
+#include <cmath>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Implementation/pixelFormatConversion.hpp"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/TextureTools/Implementation/resampleKernels.hpp"
+
+namespace Magnum { namespace TextureTools {
+
+Debug& operator<<(Debug& debug, const ResampleFilter value) {
+    debug << "TextureTools::ResampleFilter" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case ResampleFilter::value: return debug << "::" #value;
+        _c(Box)
+        _c(Triangle)
+        _c(Lanczos)
+        _c(Kaiser)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+namespace {
+
+/* Filter functions, evaluated in destination pixel units scaled to the source
+   when downsampling */
+Float filterRadius(const ResampleFilter filter) {
+    switch(filter) {
+        case ResampleFilter::Box: return 0.5f;
+        case ResampleFilter::Triangle: return 1.0f;
+        case ResampleFilter::Lanczos:
+        case ResampleFilter::Kaiser: return 3.0f;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+Float sinc(const Float x) {
+    if(x == 0.0f) return 1.0f;
+    const Float xpi = x*Constants::pi();
+    return std::sin(xpi)/xpi;
+}
+
+/* Zeroth-order modified Bessel function of the first kind, needed by the
+   Kaiser window. The series converges fast for the small arguments used
+   here. */
+Double besselI0(const Double x) {
+    const Double y = x*x/4.0;
+    Double sum = 1.0, term = 1.0;
+    for(Int k = 1; term > sum*1.0e-12; ++k) {
+        term *= y/(k*k);
+        sum += term;
+    }
+    return sum;
+}
+
+Float filterWeight(const ResampleFilter filter, const Float x) {
+    constexpr Double KaiserAlpha = 4.0;
+
+    switch(filter) {
+        case ResampleFilter::Box:
+            return x >= -0.5f && x < 0.5f ? 1.0f : 0.0f;
+        case ResampleFilter::Triangle:
+            return Math::max(1.0f - std::abs(x), 0.0f);
+        case ResampleFilter::Lanczos:
+            return std::abs(x) < 3.0f ? sinc(x)*sinc(x/3.0f) : 0.0f;
+        case ResampleFilter::Kaiser: {
+            if(std::abs(x) >= 3.0f) return 0.0f;
+            const Double t = x/3.0;
+            return sinc(x)*Float(besselI0(KaiserAlpha*std::sqrt(1.0 - t*t))/besselI0(KaiserAlpha));
+        }
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* For each destination pixel the index of the first source pixel and taps
+   normalized weights of it and the following pixels. Weights of pixels
+   outside of the source are added to the edge pixels. */
+struct Contributions {
+    Containers::Array<Int> first;
+    Containers::Array<Float> weights;
+    std::size_t taps;
+};
+
+Contributions contributions(const ResampleFilter filter, const Int sourceSize, const Int destinationSize) {
+    const Float scale = Float(sourceSize)/destinationSize;
+    const Float filterScale = Math::max(scale, 1.0f);
+    const Float support = filterRadius(filter)*filterScale;
+
+    Contributions out;
+    out.taps = Math::min(std::size_t(std::ceil(2.0f*support)) + 2, std::size_t(sourceSize));
+    out.first = Containers::Array<Int>{Containers::NoInit, std::size_t(destinationSize)};
+    out.weights = Containers::Array<Float>{Containers::ValueInit, destinationSize*out.taps};
+
+    for(Int i = 0; i != destinationSize; ++i) {
+        const Float center = (i + 0.5f)*scale;
+        const Int begin = Int(std::floor(center - support - 0.5f));
+        const Int end = Int(std::ceil(center + support - 0.5f));
+        const Int first = Math::min(Math::max(begin, 0), sourceSize - Int(out.taps));
+        out.first[i] = first;
+
+        Float* const weights = out.weights.data() + i*out.taps;
+        Float sum = 0.0f;
+        for(Int j = begin; j <= end; ++j) {
+            const Float weight = filterWeight(filter, (j + 0.5f - center)/filterScale);
+            if(weight == 0.0f) continue;
+            weights[Math::clamp(j, 0, sourceSize - 1) - first] += weight;
+            sum += weight;
+        }
+
+        /* Shouldn't happen with any of the filters, but be sure to not
+           divide by zero */
+        if(sum == 0.0f) {
+            weights[Math::clamp(Int(center), 0, sourceSize - 1) - first] = 1.0f;
+            continue;
+        }
+
+        for(std::size_t k = 0; k != out.taps; ++k)
+            weights[k] /= sum;
+    }
+
+    return out;
+}
+
+/* Splits count items into threadCount ranges, the first of them processed
+   on the calling thread */
+template<class F> void parallelFor(const std::size_t count, const UnsignedInt threadCount, const F& f) {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    const std::size_t chunkCount = Math::min(std::size_t(threadCount ? threadCount : Math::max(std::thread::hardware_concurrency(), 1u)), count);
+    if(chunkCount > 1) {
+        Containers::Array<std::thread> threads{chunkCount - 1};
+        for(std::size_t i = 1; i != chunkCount; ++i)
+            threads[i - 1] = std::thread{f, count*i/chunkCount, count*(i + 1)/chunkCount};
+        f(0, count/chunkCount);
+        for(std::thread& thread: threads) thread.join();
+        return;
+    }
+    #else
+    static_cast<void>(threadCount);
+    #endif
+
+    f(0, count);
+}
+
+}
+
+void resampleInto(const ImageView2D& source, const MutableImageView2D& destination, const ResampleFilter filter, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(!isPixelFormatImplementationSpecific(source.format()),
+        "TextureTools::resampleInto(): can't resample an implementation-specific format" << reinterpret_cast<void*>(pixelFormatUnwrap(source.format())), );
+    CORRADE_ASSERT(source.format() == destination.format(),
+        "TextureTools::resampleInto(): expected the destination format to be" << source.format() << "but got" << destination.format(), );
+
+    if(!source.size().product() || !destination.size().product()) return;
+
+    const Magnum::Implementation::PixelFormatInfo info = Magnum::Implementation::pixelFormatInfo(source.format());
+    const Vector2i sourceSize = source.size();
+    const Vector2i destinationSize = destination.size();
+    const std::size_t rowSize = destinationSize.x()*info.channelCount;
+
+    /* Horizontal pass, each source row decoded and filtered into a float
+       row of destination width. Done for all source rows first so the
+       vertical pass can then work on contiguous rows. */
+    const Contributions horizontal = contributions(filter, sourceSize.x(), destinationSize.x());
+    const Implementation::ResampleFilterKernel filterKernel = Implementation::resampleFilterKernel(info.channelCount);
+    Containers::Array<Float> intermediate{Containers::NoInit, sourceSize.y()*rowSize};
+    const Containers::StridedArrayView3D<const char> sourcePixels = source.pixels();
+    parallelFor(sourceSize.y(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        Containers::Array<Float> row{Containers::NoInit, std::size_t(sourceSize.x()*info.channelCount)};
+        const Containers::StridedArrayView2D<Float> rowView{row, {std::size_t(sourceSize.x()), info.channelCount}};
+        for(std::size_t y = begin; y != end; ++y) {
+            Magnum::Implementation::decodePixelRow(info, sourcePixels[y], rowView);
+            filterKernel(row.data(), horizontal.first.data(), horizontal.weights.data(), horizontal.taps, intermediate.data() + y*rowSize, destinationSize.x());
+        }
+    });
+
+    /* Vertical pass, accumulating weighted intermediate rows and encoding the
+       result */
+    const Contributions vertical = contributions(filter, sourceSize.y(), destinationSize.y());
+    const Implementation::ResampleAccumulateKernel accumulateKernel = Implementation::resampleAccumulateKernel();
+    const Containers::StridedArrayView3D<char> destinationPixels = destination.pixels();
+    parallelFor(destinationSize.y(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        Containers::Array<Float> row{Containers::NoInit, rowSize};
+        for(std::size_t y = begin; y != end; ++y) {
+            for(Float& value: row) value = 0.0f;
+            const Float* const weights = vertical.weights.data() + y*vertical.taps;
+            for(std::size_t k = 0; k != vertical.taps; ++k) {
+                if(weights[k] == 0.0f) continue;
+                accumulateKernel(intermediate.data() + (vertical.first[y] + k)*rowSize, weights[k], row.data(), rowSize);
+            }
+            Magnum::Implementation::encodePixelRow(info, row, destinationPixels[y]);
+        }
+    });
+}
+
+Image2D resample(const ImageView2D& source, const Vector2i& size, const ResampleFilter filter, const UnsignedInt threadCount) {
+    /* Default pixel storage has a four-byte row alignment */
+    const std::size_t rowSize = 4*((source.pixelSize()*size.x() + 3)/4);
+    Image2D out{PixelStorage{}, source.format(), source.formatExtra(), source.pixelSize(), size, Containers::Array<char>{Containers::ValueInit, rowSize*size.y()}};
+    resampleInto(source, out, filter, threadCount);
+    return out;
+}
+
+Containers::Array<Image2D> mipmaps(const ImageView2D& image, const ResampleFilter filter, const UnsignedInt threadCount) {
+    if(!image.size().product()) return {};
+
+    std::size_t levelCount = 1;
+    for(Vector2i size = image.size(); size != Vector2i{1}; size = Math::max(size/2, Vector2i{1}))
+        ++levelCount;
+
+    Containers::Array<Image2D> levels;
+    arrayReserve(levels, levelCount);
+
+    /* The base level is a plain copy, the others are filtered from the
+       previous level */
+    {
+        const std::size_t rowSize = 4*((image.pixelSize()*image.size().x() + 3)/4);
+        Image2D base{PixelStorage{}, image.format(), image.formatExtra(), image.pixelSize(), image.size(), Containers::Array<char>{Containers::ValueInit, rowSize*image.size().y()}};
+        Utility::copy(image.pixels(), base.pixels());
+        arrayAppend(levels, Containers::InPlaceInit, std::move(base));
+    }
+    for(std::size_t i = 1; i != levelCount; ++i) {
+        const Vector2i size = Math::max(levels[i - 1].size()/2, Vector2i{1});
+        arrayAppend(levels, Containers::InPlaceInit, resample(levels[i - 1], size, filter, threadCount));
+    }
+
+    return levels;
+}
+
+}}
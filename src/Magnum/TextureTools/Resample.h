@@ -0,0 +1,152 @@
+#ifndef Magnum_TextureTools_Resample_h
+#define Magnum_TextureTools_Resample_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Enum @ref Magnum::TextureTools::ResampleFilter, function @ref Magnum::TextureTools::resampleInto(), @ref Magnum::TextureTools::resample(), @ref Magnum::TextureTools::mipmaps()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Resampling filter
+@m_since_latest
+
+@see @ref resampleInto(), @ref resample(), @ref mipmaps()
+*/
+enum class ResampleFilter: UnsignedByte {
+    /**
+     * Box filter. Averages all source pixels covered by the destination
+     * pixel when downsampling, equivalent to nearest-neighbor filtering when
+     * upsampling. The fastest option, but prone to aliasing.
+     */
+    Box,
+
+    /**
+     * Triangle (tent) filter, equivalent to bilinear filtering when
+     * upsampling.
+     */
+    Triangle,
+
+    /**
+     * Three-lobed Lanczos filter. Keeps the result sharp, but may produce
+     * ringing around hard edges.
+     */
+    Lanczos,
+
+    /**
+     * Kaiser-windowed sinc filter with a radius of three pixels and
+     * @f$ \alpha = 4 @f$. Has less ringing than @ref ResampleFilter::Lanczos
+     * with a similar sharpness and is a good default for mip generation.
+     */
+    Kaiser
+};
+
+/** @debugoperatorenum{ResampleFilter} */
+MAGNUM_TEXTURETOOLS_EXPORT Debug& operator<<(Debug& debug, ResampleFilter value);
+
+/**
+@brief Resample an image into another
+@param source       Source image
+@param destination  Destination image
+@param filter       Filter to use
+@param threadCount  Thread count. If @cpp 0 @ce, uses
+    @ref std::thread::hardware_concurrency().
+@m_since_latest
+
+Resamples @p source to the size of @p destination using a separable filter,
+first horizontally and then vertically, with edge pixels extended past the
+image boundaries. The filter is widened accordingly when downsampling in
+order to not skip any source pixels.
+
+Pixels are converted to 32-bit floats for the filtering. Normalized and
+floating-point formats are filtered as-is, integral formats are rounded to the
+nearest integer and clamped to the range of the type on output. For
+@ref PixelFormat::R8Srgb, @ref PixelFormat::RG8Srgb, @ref PixelFormat::RGB8Srgb
+and @ref PixelFormat::RGBA8Srgb the color channels are converted to linear RGB
+before filtering and back after, the alpha channel is kept linear. Normalized
+formats are clamped to their range on output, so overshoots of the
+@ref ResampleFilter::Lanczos and @ref ResampleFilter::Kaiser filters don't
+cause wraparounds. The conversions use the batch APIs from
+@ref Magnum/Math/PackingBatch.h and @ref Magnum/Math/ColorBatch.h, the
+filtering itself is done with SSE2, AVX2 or NEON where available.
+
+With @p threadCount larger than @cpp 1 @ce the rows are split among a
+corresponding number of threads, with the calling thread being one of them.
+The result doesn't depend on the thread count. On
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" the operation is always done on
+the calling thread.
+
+Expects that @p source and @p destination have the same format, which is not
+implementation-specific. The pixel storage of both images is respected. If
+either of the images has a zero size, the function does nothing.
+@see @ref isPixelFormatImplementationSpecific()
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void resampleInto(const ImageView2D& source, const MutableImageView2D& destination, ResampleFilter filter = ResampleFilter::Triangle, UnsignedInt threadCount = 1);
+
+/**
+@brief Resample an image
+@m_since_latest
+
+Allocates an image of given @p size with the same format as @p source and
+default @ref PixelStorage and calls @ref resampleInto() with it. See its
+documentation for more information.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Image2D resample(const ImageView2D& source, const Vector2i& size, ResampleFilter filter = ResampleFilter::Triangle, UnsignedInt threadCount = 1);
+
+/**
+@brief Generate a mip chain
+@param image        Base level
+@param filter       Filter to use
+@param threadCount  Thread count. If @cpp 0 @ce, uses
+    @ref std::thread::hardware_concurrency().
+@m_since_latest
+
+Returns a full mip chain, with the first item being a copy of @p image and
+each next level half the size of the previous, rounded down, until a
+@cpp {1, 1} @ce level is reached. Each level is resampled from the previous
+one with @ref resampleInto(), see its documentation for details about
+supported formats and threading. All levels have a default @ref PixelStorage.
+If @p image has a zero size, returns an empty array.
+
+The levels can be passed directly to image converters. Since the
+@ref TextureTools library doesn't depend on @ref Trade, a
+@ref Trade::ImageData2D can be made out of each level by passing its
+@ref Image::storage() "storage()", @ref Image::format() "format()",
+@ref Image::size() "size()" and @ref Image::release() "release()"d data to
+the @ref Trade::ImageData constructor.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Containers::Array<Image2D> mipmaps(const ImageView2D& image, ResampleFilter filter = ResampleFilter::Triangle, UnsignedInt threadCount = 1);
+
+}}
+
+#endif
@@ -0,0 +1,272 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/TextureTools/Resample.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct ResampleTest: TestSuite::Tester {
+    explicit ResampleTest();
+
+    void debugFilter();
+
+    void sameSize();
+    void downsampleBox();
+    void downsampleTriangle();
+    void upsampleTriangle();
+    void srgb();
+    void integral();
+    void half();
+    void clampOvershoot();
+    void threads();
+    void zeroSize();
+
+    void mipmaps();
+    void mipmapsEmpty();
+};
+
+const struct {
+    const char* name;
+    ResampleFilter filter;
+} FilterData[]{
+    {"box", ResampleFilter::Box},
+    {"triangle", ResampleFilter::Triangle},
+    {"Lanczos", ResampleFilter::Lanczos},
+    {"Kaiser", ResampleFilter::Kaiser}
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadsData[]{
+    {"two threads", 2},
+    {"seven threads", 7},
+    {"hardware concurrency", 0}
+};
+
+ResampleTest::ResampleTest() {
+    addTests({&ResampleTest::debugFilter});
+
+    addInstancedTests({&ResampleTest::sameSize},
+        Containers::arraySize(FilterData));
+
+    addTests({&ResampleTest::downsampleBox,
+              &ResampleTest::downsampleTriangle,
+              &ResampleTest::upsampleTriangle,
+              &ResampleTest::srgb,
+              &ResampleTest::integral,
+              &ResampleTest::half,
+              &ResampleTest::clampOvershoot});
+
+    addInstancedTests({&ResampleTest::threads},
+        Containers::arraySize(ThreadsData));
+
+    addTests({&ResampleTest::zeroSize,
+
+              &ResampleTest::mipmaps,
+              &ResampleTest::mipmapsEmpty});
+}
+
+void ResampleTest::debugFilter() {
+    std::ostringstream out;
+    Debug{&out} << ResampleFilter::Lanczos << ResampleFilter(0xde);
+    CORRADE_COMPARE(out.str(), "TextureTools::ResampleFilter::Lanczos TextureTools::ResampleFilter(0xde)\n");
+}
+
+void ResampleTest::sameSize() {
+    auto&& data = FilterData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Rows are nine bytes, padded to twelve by the default alignment */
+    const UnsignedByte pixels[]{
+        0x00, 0x10, 0x20, 0x30, 0x40, 0x50, 0xff, 0xee, 0xdd, 0, 0, 0,
+        0x11, 0x33, 0x55, 0xaa, 0xcc, 0xee, 0x01, 0x02, 0x03, 0, 0, 0
+    };
+    const ImageView2D image{PixelFormat::RGB8Unorm, {3, 2}, pixels};
+
+    Image2D out = resample(image, {3, 2}, data.filter);
+    CORRADE_COMPARE(out.format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(out.size(), (Vector2i{3, 2}));
+    CORRADE_COMPARE_AS(out.pixels<Color3ub>()[0],
+        image.pixels<Color3ub>()[0],
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.pixels<Color3ub>()[1],
+        image.pixels<Color3ub>()[1],
+        TestSuite::Compare::Container);
+}
+
+void ResampleTest::downsampleBox() {
+    const Float pixels[]{
+        1.0f, 2.0f, 3.0f, 4.0f,
+        5.0f, 6.0f, 7.0f, 8.0f
+    };
+    const Float expected[]{3.5f, 5.5f};
+
+    Image2D out = resample(ImageView2D{PixelFormat::R32F, {4, 2}, pixels}, {2, 1}, ResampleFilter::Box);
+    CORRADE_COMPARE(out.size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE_AS(out.pixels<Float>()[0],
+        Containers::stridedArrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void ResampleTest::downsampleTriangle() {
+    /* The filter is twice as wide when downsampling by a factor of two,
+       weights of pixels outside of the image are added to the edge pixels */
+    const Float pixels[]{0.0f, 8.0f, 16.0f, 24.0f};
+    const Float expected[]{5.0f, 19.0f};
+
+    Image2D out = resample(ImageView2D{PixelFormat::R32F, {4, 1}, pixels}, {2, 1}, ResampleFilter::Triangle);
+    CORRADE_COMPARE_AS(out.pixels<Float>()[0],
+        Containers::stridedArrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void ResampleTest::upsampleTriangle() {
+    /* Equivalent to bilinear filtering with clamp-to-edge */
+    const Float pixels[]{0.0f, 4.0f};
+    const Float expected[]{0.0f, 1.0f, 3.0f, 4.0f};
+
+    Image2D out = resample(ImageView2D{PixelFormat::R32F, {2, 1}, pixels}, {4, 1}, ResampleFilter::Triangle);
+    CORRADE_COMPARE_AS(out.pixels<Float>()[0],
+        Containers::stridedArrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void ResampleTest::srgb() {
+    const Color4ub pixels[]{
+        {0x00, 0x00, 0x00, 0x00},
+        {0xff, 0xff, 0xff, 0xff}
+    };
+
+    /* Color channels are averaged in linear space, 0.5 being 0xbc in sRGB,
+       alpha is linear */
+    Image2D srgb = resample(ImageView2D{PixelFormat::RGBA8Srgb, {2, 1}, pixels}, {1, 1}, ResampleFilter::Box);
+    CORRADE_COMPARE(srgb.pixels<Color4ub>()[0][0], (Color4ub{0xbc, 0xbc, 0xbc, 0x80}));
+
+    /* Compared to a plain average for a linear format */
+    Image2D linear = resample(ImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, pixels}, {1, 1}, ResampleFilter::Box);
+    CORRADE_COMPARE(linear.pixels<Color4ub>()[0][0], (Color4ub{0x80, 0x80, 0x80, 0x80}));
+}
+
+void ResampleTest::integral() {
+    /* Rounded to nearest, halfway cases away from zero */
+    const UnsignedByte unsignedPixels[]{1, 2, 3, 4};
+    const UnsignedByte unsignedExpected[]{2, 4};
+    Image2D unsignedOut = resample(ImageView2D{PixelFormat::R8UI, {4, 1}, unsignedPixels}, {2, 1}, ResampleFilter::Box);
+    CORRADE_COMPARE_AS(unsignedOut.pixels<UnsignedByte>()[0],
+        Containers::stridedArrayView(unsignedExpected),
+        TestSuite::Compare::Container);
+
+    const Int signedPixels[]{-3, -4, 100000, 100001};
+    const Int signedExpected[]{-4, 100001};
+    Image2D signedOut = resample(ImageView2D{PixelFormat::R32I, {4, 1}, signedPixels}, {2, 1}, ResampleFilter::Box);
+    CORRADE_COMPARE_AS(signedOut.pixels<Int>()[0],
+        Containers::stridedArrayView(signedExpected),
+        TestSuite::Compare::Container);
+}
+
+void ResampleTest::half() {
+    /* 1.0, 2.0 and 3.0, 4.0 */
+    const UnsignedShort pixels[]{0x3c00, 0x4000, 0x4200, 0x4400};
+
+    Image2D out = resample(ImageView2D{PixelFormat::RG16F, {2, 1}, pixels}, {1, 1}, ResampleFilter::Box);
+    /* 2.0 and 3.0 */
+    CORRADE_COMPARE(out.pixels<Vector2us>()[0][0], (Vector2us{0x4000, 0x4200}));
+}
+
+void ResampleTest::clampOvershoot() {
+    /* The negative lobe of the Lanczos filter makes the result go below zero
+       and above one next to the edge, which would wrap around if not
+       clamped */
+    const UnsignedByte pixels[]{0x00, 0xff, 0, 0};
+
+    Image2D out = resample(ImageView2D{PixelFormat::R8Unorm, {2, 1}, pixels}, {8, 1}, ResampleFilter::Lanczos);
+    CORRADE_COMPARE(out.pixels<UnsignedByte>()[0][0], 0x00);
+    CORRADE_COMPARE(out.pixels<UnsignedByte>()[0][7], 0xff);
+}
+
+void ResampleTest::threads() {
+    auto&& data = ThreadsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<Color4ub> pixels{Containers::NoInit, 67*45};
+    for(std::size_t i = 0; i != pixels.size(); ++i)
+        pixels[i] = Color4ub(UnsignedByte(i*37), UnsignedByte(i*11), UnsignedByte(i*3), UnsignedByte(i));
+    const ImageView2D image{PixelFormat::RGBA8Unorm, {67, 45}, pixels};
+
+    /* The result doesn't depend on how the rows are split among threads */
+    Image2D expected = resample(image, {31, 17}, ResampleFilter::Kaiser, 1);
+    Image2D out = resample(image, {31, 17}, ResampleFilter::Kaiser, data.threadCount);
+    CORRADE_COMPARE_AS(out.data(), expected.data(),
+        TestSuite::Compare::Container);
+}
+
+void ResampleTest::zeroSize() {
+    const Color4ub pixels[1]{};
+
+    Image2D out = resample(ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, pixels}, {0, 3});
+    CORRADE_COMPARE(out.size(), (Vector2i{0, 3}));
+    CORRADE_COMPARE(out.data().size(), 0);
+}
+
+void ResampleTest::mipmaps() {
+    Color4ub pixels[5*3];
+    for(Color4ub& i: pixels) i = {0x10, 0x20, 0x30, 0x40};
+
+    Containers::Array<Image2D> levels = TextureTools::mipmaps(ImageView2D{PixelFormat::RGBA8Unorm, {5, 3}, pixels}, ResampleFilter::Kaiser);
+    CORRADE_COMPARE(levels.size(), 3);
+    CORRADE_COMPARE(levels[0].size(), (Vector2i{5, 3}));
+    CORRADE_COMPARE(levels[1].size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(levels[2].size(), (Vector2i{1, 1}));
+
+    /* A constant image stays constant */
+    for(const Image2D& level: levels) {
+        CORRADE_ITERATION(level.size());
+        CORRADE_COMPARE(level.format(), PixelFormat::RGBA8Unorm);
+        for(const Containers::StridedArrayView1D<const Color4ub> row: level.pixels<Color4ub>())
+            for(const Color4ub& pixel: row)
+                CORRADE_COMPARE(pixel, (Color4ub{0x10, 0x20, 0x30, 0x40}));
+    }
+}
+
+void ResampleTest::mipmapsEmpty() {
+    const Color4ub pixels[1]{};
+    CORRADE_COMPARE(TextureTools::mipmaps(ImageView2D{PixelFormat::RGBA8Unorm, {0, 1}, pixels}).size(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::ResampleTest)
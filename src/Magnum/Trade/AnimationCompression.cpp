@@ -0,0 +1,417 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AnimationCompression.h"
+
+#include <cmath>
+#include <cstring>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Animation/Quantization.h"
+#include "Magnum/Math/Complex.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/CubicHermite.h"
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Trade/AnimationData.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+enum class Operation: UnsignedByte {
+    Resample,
+    Simplify,
+    Quantize
+};
+
+struct Parameters {
+    const char* name;
+    Float rate;
+    Float tolerance;
+    Float rotationTolerance;
+};
+
+struct OutputTrack {
+    AnimationTrackTargetType targetType;
+    UnsignedInt target;
+    Animation::Interpolation interpolation;
+    Animation::Extrapolation before, after;
+    void(*interpolator)();
+    Containers::Array<Float> keys;
+    Containers::Array<char> values;
+    /* Creates the final track, with type information baked in */
+    AnimationTrackData(*finalize)(const OutputTrack&, const Containers::StridedArrayView1D<const Float>&, const char*);
+};
+
+template<class V, class R> AnimationTrackData finalizeTrack(const OutputTrack& track, const Containers::StridedArrayView1D<const Float>& keys, const char* const values) {
+    return AnimationTrackData{track.targetType, track.target,
+        Animation::TrackView<const Float, const V, R>{keys,
+            Containers::arrayView(reinterpret_cast<const V*>(values), keys.size()),
+            track.interpolation,
+            reinterpret_cast<R(*)(const V&, const V&, Float)>(track.interpolator),
+            track.before, track.after}};
+}
+
+/* Packed and spline value types with a different result type that are copied
+   verbatim. The type-erased AnimationTrackData constructor allows any other
+   combination as well, but without knowing the value type it's not possible
+   to copy those. */
+constexpr struct {
+    AnimationTrackType type, resultType;
+} CopiedTrackTypes[]{
+    {AnimationTrackType::CubicHermite1D, AnimationTrackType::Float},
+    {AnimationTrackType::CubicHermite2D, AnimationTrackType::Vector2},
+    {AnimationTrackType::CubicHermite3D, AnimationTrackType::Vector3},
+    {AnimationTrackType::CubicHermiteComplex, AnimationTrackType::Complex},
+    {AnimationTrackType::CubicHermiteQuaternion, AnimationTrackType::Quaternion},
+    {AnimationTrackType::Vector3s, AnimationTrackType::Vector3},
+    {AnimationTrackType::Vector3us, AnimationTrackType::Quaternion}
+};
+
+/* Distance metrics for keyframe removal. Rotations are compared by angle,
+   other floating-point types by Euclidean distance and everything else has
+   to match exactly. */
+Float distance(const Float a, const Float b) {
+    return Math::abs(a - b);
+}
+
+Float distance(const Vector2& a, const Vector2& b) {
+    return (a - b).length();
+}
+
+Float distance(const Vector3& a, const Vector3& b) {
+    return (a - b).length();
+}
+
+Float distance(const Vector4& a, const Vector4& b) {
+    return (a - b).length();
+}
+
+Float distance(const Complex& a, const Complex& b) {
+    return std::acos(Math::clamp(Math::dot(a.normalized(), b.normalized()), -1.0f, 1.0f));
+}
+
+Float distance(const Quaternion& a, const Quaternion& b) {
+    /* q and -q is the same rotation */
+    return 2.0f*std::acos(Math::min(Math::abs(Math::dot(a.normalized(), b.normalized())), 1.0f));
+}
+
+Float distance(const DualQuaternion& a, const DualQuaternion& b) {
+    /* Treated as a 8-component vector */
+    return std::sqrt((a.real() - b.real()).dot() + (a.dual() - b.dual()).dot());
+}
+
+template<class T> Float distance(const T& a, const T& b) {
+    return a == b ? 0.0f : Constants::inf();
+}
+
+template<class V> Containers::Array<char> copyValues(const Containers::StridedArrayView1D<const V>& values) {
+    Containers::Array<char> out{Containers::NoInit, values.size()*sizeof(V)};
+    V* const data = reinterpret_cast<V*>(out.data());
+    for(std::size_t i = 0; i != values.size(); ++i) data[i] = values[i];
+    return out;
+}
+
+template<class V, class R> void copyTrack(const AnimationData& animation, const UnsignedInt id, OutputTrack& out) {
+    const Animation::TrackView<const Float, const V, R>& track = animation.track<V, R>(id);
+    out.interpolator = reinterpret_cast<void(*)()>(track.interpolator());
+    out.keys = Containers::Array<Float>{Containers::NoInit, track.size()};
+    for(std::size_t i = 0; i != track.size(); ++i) out.keys[i] = track.keys()[i];
+    out.values = copyValues(track.values());
+    out.finalize = finalizeTrack<V, R>;
+}
+
+template<class V> void resampleTrack(const AnimationData& animation, const UnsignedInt id, const Float rate, OutputTrack& out) {
+    const Animation::TrackView<const Float, const V, V>& track = animation.track<V, V>(id);
+    if(track.size() < 2) return copyTrack<V, V>(animation, id, out);
+
+    /* The last key is put exactly at the end to preserve the duration */
+    const Range1D duration = track.duration();
+    const std::size_t count = std::size_t(Math::ceil(duration.size()*rate)) + 1;
+    out.keys = Containers::Array<Float>{Containers::NoInit, count};
+    for(std::size_t i = 0; i != count - 1; ++i)
+        out.keys[i] = duration.min() + Float(i)/rate;
+    out.keys[count - 1] = duration.max();
+
+    out.values = Containers::Array<char>{Containers::NoInit, count*sizeof(V)};
+    V* const values = reinterpret_cast<V*>(out.values.data());
+    std::size_t hint{};
+    for(std::size_t i = 0; i != count; ++i)
+        values[i] = track.at(out.keys[i], hint);
+
+    out.interpolator = reinterpret_cast<void(*)()>(track.interpolator());
+    out.finalize = finalizeTrack<V, V>;
+}
+
+template<class V> void simplifyTrack(const AnimationData& animation, const UnsignedInt id, const Float tolerance, OutputTrack& out) {
+    const Animation::TrackView<const Float, const V, V>& track = animation.track<V, V>(id);
+    if(track.size() < 3) return copyTrack<V, V>(animation, id, out);
+
+    const Containers::StridedArrayView1D<const Float> keys = track.keys();
+    const Containers::StridedArrayView1D<const V> values = track.values();
+    V(*const interpolator)(const V&, const V&, Float) = track.interpolator();
+
+    /* Greedily extend the current segment for as long as all keys inside
+       can be predicted from its endpoints */
+    Containers::Array<std::size_t> kept;
+    arrayAppend(kept, std::size_t{});
+    std::size_t start = 0;
+    for(std::size_t end = 2; end < track.size(); ++end) {
+        for(std::size_t i = start + 1; i != end; ++i) {
+            const V predicted = interpolator(values[start], values[end], Math::lerpInverted(keys[start], keys[end], keys[i]));
+            if(!(distance(predicted, values[i]) <= tolerance)) {
+                start = end - 1;
+                arrayAppend(kept, start);
+                break;
+            }
+        }
+    }
+    arrayAppend(kept, track.size() - 1);
+
+    out.keys = Containers::Array<Float>{Containers::NoInit, kept.size()};
+    out.values = Containers::Array<char>{Containers::NoInit, kept.size()*sizeof(V)};
+    V* const outValues = reinterpret_cast<V*>(out.values.data());
+    for(std::size_t i = 0; i != kept.size(); ++i) {
+        out.keys[i] = keys[kept[i]];
+        outValues[i] = values[kept[i]];
+    }
+
+    out.interpolator = reinterpret_cast<void(*)()>(interpolator);
+    out.finalize = finalizeTrack<V, V>;
+}
+
+template<class V> void processTrack(const AnimationData& animation, const UnsignedInt id, const Operation operation, const Parameters& parameters, const Float tolerance, OutputTrack& out) {
+    switch(operation) {
+        case Operation::Resample:
+            return resampleTrack<V>(animation, id, parameters.rate, out);
+        case Operation::Simplify:
+            return simplifyTrack<V>(animation, id, tolerance, out);
+        case Operation::Quantize:
+            return copyTrack<V, V>(animation, id, out);
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+void quantizeRotationTrack(const AnimationData& animation, const UnsignedInt id, OutputTrack& out) {
+    const Animation::TrackView<const Float, const Quaternion>& track = animation.track<Quaternion>(id);
+    if(track.interpolation() != Animation::Interpolation::Linear)
+        return copyTrack<Quaternion, Quaternion>(animation, id, out);
+
+    out.keys = Containers::Array<Float>{Containers::NoInit, track.size()};
+    out.values = Containers::Array<char>{Containers::NoInit, track.size()*sizeof(Vector3us)};
+    Vector3us* const values = reinterpret_cast<Vector3us*>(out.values.data());
+    for(std::size_t i = 0; i != track.size(); ++i) {
+        out.keys[i] = track.keys()[i];
+        values[i] = Animation::packQuaternionSmallestThree(track.values()[i].normalized());
+    }
+
+    out.interpolator = reinterpret_cast<void(*)()>(Animation::slerpSmallestThree);
+    out.finalize = finalizeTrack<Vector3us, Quaternion>;
+}
+
+void quantizeTranslationTrack(const AnimationData& animation, const UnsignedInt id, OutputTrack& out) {
+    const Animation::TrackView<const Float, const Vector3>& track = animation.track<Vector3>(id);
+    if(track.interpolation() != Animation::Interpolation::Linear)
+        return copyTrack<Vector3, Vector3>(animation, id, out);
+
+    Float max{};
+    for(const Vector3& value: track.values())
+        max = Math::max(max, Math::abs(value).max());
+    const Int exponent = Animation::quantizedTranslationExponent(max);
+
+    out.keys = Containers::Array<Float>{Containers::NoInit, track.size()};
+    out.values = Containers::Array<char>{Containers::NoInit, track.size()*sizeof(Vector3s)};
+    Vector3s* const values = reinterpret_cast<Vector3s*>(out.values.data());
+    for(std::size_t i = 0; i != track.size(); ++i) {
+        out.keys[i] = track.keys()[i];
+        values[i] = Animation::packTranslation(track.values()[i], exponent);
+    }
+
+    out.interpolator = reinterpret_cast<void(*)()>(Animation::quantizedTranslationInterpolator(exponent));
+    out.finalize = finalizeTrack<Vector3s, Vector3>;
+}
+
+AnimationData process(const AnimationData& animation, const Operation operation, const Parameters& parameters) {
+    /* Check all tracks upfront so there's no half-done work on failure */
+    #ifndef CORRADE_NO_ASSERT
+    for(UnsignedInt i = 0; i != animation.trackCount(); ++i) {
+        const AnimationTrackType type = animation.trackType(i);
+        const AnimationTrackType resultType = animation.trackResultType(i);
+        if(type == resultType) continue;
+
+        bool found = false;
+        for(const auto& pair: CopiedTrackTypes) if(pair.type == type && pair.resultType == resultType) {
+            found = true;
+            break;
+        }
+        CORRADE_ASSERT(found,
+            parameters.name << "unsupported track type" << type << "with result type" << resultType << "in track" << i,
+            (AnimationData{nullptr, nullptr}));
+    }
+    #endif
+
+    Containers::Array<OutputTrack> tracks{animation.trackCount()};
+    for(UnsignedInt i = 0; i != animation.trackCount(); ++i) {
+        const Animation::TrackViewStorage<const Float>& track = animation.track(i);
+        OutputTrack& out = tracks[i];
+        out.targetType = animation.trackTargetType(i);
+        out.target = animation.trackTarget(i);
+        out.interpolation = track.interpolation();
+        out.before = track.before();
+        out.after = track.after();
+
+        const AnimationTrackType type = animation.trackType(i);
+        const AnimationTrackType resultType = animation.trackResultType(i);
+
+        /* Tracks with a different result type are copied verbatim */
+        if(type != resultType) {
+            #define _c(value, result) if(type == AnimationTrackType::value && resultType == AnimationTrackType::result) \
+                copyTrack<Magnum::value, Magnum::result>(animation, i, out);
+            _c(CubicHermite1D, Float)
+            else _c(CubicHermite2D, Vector2)
+            else _c(CubicHermite3D, Vector3)
+            else _c(CubicHermiteComplex, Complex)
+            else _c(CubicHermiteQuaternion, Quaternion)
+            else _c(Vector3s, Vector3)
+            else _c(Vector3us, Quaternion)
+            #undef _c
+            else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+            continue;
+        }
+
+        /* Quantization is done only for linearly interpolated rotations and
+           translations */
+        if(operation == Operation::Quantize && type == AnimationTrackType::Quaternion) {
+            quantizeRotationTrack(animation, i, out);
+            continue;
+        }
+        if(operation == Operation::Quantize && type == AnimationTrackType::Vector3 && out.targetType == AnimationTrackTargetType::Translation3D) {
+            quantizeTranslationTrack(animation, i, out);
+            continue;
+        }
+
+        switch(type) {
+            #define _c(value, valueType, tolerance) case AnimationTrackType::value: \
+                processTrack<valueType>(animation, i, operation, parameters, parameters.tolerance, out); \
+                break;
+            _c(Bool, bool, tolerance)
+            _c(Float, Float, tolerance)
+            _c(UnsignedInt, UnsignedInt, tolerance)
+            _c(Int, Int, tolerance)
+            _c(BoolVector2, Math::BoolVector<2>, tolerance)
+            _c(BoolVector3, Math::BoolVector<3>, tolerance)
+            _c(BoolVector4, Math::BoolVector<4>, tolerance)
+            _c(Vector2, Vector2, tolerance)
+            _c(Vector2ui, Vector2ui, tolerance)
+            _c(Vector2i, Vector2i, tolerance)
+            _c(Vector3, Vector3, tolerance)
+            _c(Vector3ui, Vector3ui, tolerance)
+            _c(Vector3i, Vector3i, tolerance)
+            _c(Vector4, Vector4, tolerance)
+            _c(Vector4ui, Vector4ui, tolerance)
+            _c(Vector4i, Vector4i, tolerance)
+            _c(Complex, Complex, rotationTolerance)
+            _c(Quaternion, Quaternion, rotationTolerance)
+            _c(DualQuaternion, DualQuaternion, tolerance)
+            /* Spline and packed types interpolated to themselves are possible
+               with a custom interpolator. As their distance is calculated by
+               comparing for equality, simplification keeps everything except
+               exactly repeated values. */
+            _c(CubicHermite1D, CubicHermite1D, tolerance)
+            _c(CubicHermite2D, CubicHermite2D, tolerance)
+            _c(CubicHermite3D, CubicHermite3D, tolerance)
+            _c(CubicHermiteComplex, CubicHermiteComplex, tolerance)
+            _c(CubicHermiteQuaternion, CubicHermiteQuaternion, tolerance)
+            _c(Vector3s, Vector3s, tolerance)
+            _c(Vector3us, Vector3us, tolerance)
+            #undef _c
+        }
+    }
+
+    /* Tracks with exactly the same keys (such as after resampling) share the
+       key array */
+    Containers::Array<std::size_t> keySource{Containers::NoInit, tracks.size()};
+    for(std::size_t i = 0; i != tracks.size(); ++i) {
+        keySource[i] = i;
+        for(std::size_t j = 0; j != i; ++j) {
+            if(keySource[j] != j || tracks[j].keys.size() != tracks[i].keys.size() || std::memcmp(tracks[j].keys.data(), tracks[i].keys.data(), tracks[i].keys.size()*sizeof(Float)) != 0)
+                continue;
+            keySource[i] = j;
+            break;
+        }
+    }
+
+    /* Calculate the layout, with each array aligned to four bytes */
+    Containers::Array<std::size_t> keyOffsets{Containers::NoInit, tracks.size()};
+    Containers::Array<std::size_t> valueOffsets{Containers::NoInit, tracks.size()};
+    std::size_t size = 0;
+    for(std::size_t i = 0; i != tracks.size(); ++i) {
+        if(keySource[i] == i) {
+            keyOffsets[i] = size;
+            size += tracks[i].keys.size()*sizeof(Float);
+        } else keyOffsets[i] = keyOffsets[keySource[i]];
+
+        valueOffsets[i] = size;
+        size = (size + tracks[i].values.size() + 3) & ~std::size_t{3};
+    }
+
+    /* Copy the data over and create the tracks */
+    Containers::Array<char> data{Containers::ValueInit, size};
+    Containers::Array<AnimationTrackData> outTracks{tracks.size()};
+    for(std::size_t i = 0; i != tracks.size(); ++i) {
+        if(keySource[i] == i)
+            std::memcpy(data.data() + keyOffsets[i], tracks[i].keys.data(), tracks[i].keys.size()*sizeof(Float));
+        std::memcpy(data.data() + valueOffsets[i], tracks[i].values.data(), tracks[i].values.size());
+
+        outTracks[i] = tracks[i].finalize(tracks[i],
+            Containers::arrayView(reinterpret_cast<const Float*>(data.data() + keyOffsets[i]), tracks[i].keys.size()),
+            data.data() + valueOffsets[i]);
+    }
+
+    return AnimationData{std::move(data), std::move(outTracks), animation.duration()};
+}
+
+}
+
+AnimationData resampleAnimation(const AnimationData& animation, const Float rate) {
+    CORRADE_ASSERT(rate > 0.0f,
+        "Trade::resampleAnimation(): expected a positive rate but got" << rate,
+        (AnimationData{nullptr, nullptr}));
+    return process(animation, Operation::Resample, {"Trade::resampleAnimation():", rate, 0.0f, 0.0f});
+}
+
+AnimationData simplifyAnimation(const AnimationData& animation, const Float tolerance, const Rad rotationTolerance) {
+    return process(animation, Operation::Simplify, {"Trade::simplifyAnimation():", 0.0f, tolerance, Float(rotationTolerance)});
+}
+
+AnimationData quantizeAnimation(const AnimationData& animation) {
+    return process(animation, Operation::Quantize, {"Trade::quantizeAnimation():", 0.0f, 0.0f, 0.0f});
+}
+
+}}
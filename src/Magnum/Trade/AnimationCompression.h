@@ -0,0 +1,137 @@
+#ifndef Magnum_Trade_AnimationCompression_h
+#define Magnum_Trade_AnimationCompression_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Trade::resampleAnimation(), @ref Magnum::Trade::simplifyAnimation(), @ref Magnum::Trade::quantizeAnimation()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Angle.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Resample an animation to a fixed rate
+@param animation    Animation to resample
+@param rate         Count of keyframes per unit of key time
+@m_since_latest
+
+For each track with at least two keyframes and the same value and result type
+creates @f$ \lceil d r \rceil + 1 @f$ keyframes, where @f$ d @f$ is duration
+of the track and @f$ r @f$ is @p rate, evenly distributed over the track
+duration with the last keyframe at the track end. Values are evaluated using
+@ref Animation::TrackView::at() with the original interpolator. Tracks that
+have the same duration after resampling share the same key array, which makes
+it possible for @ref Animation::TrackBatch to do a single keyframe search for
+all of them.
+
+Tracks with value and result type being different (spline-interpolated
+tracks, packed tracks) and tracks with less than two keyframes are copied
+verbatim. Interpolation, extrapolation, target and @ref AnimationData::duration()
+is preserved. Expects that @p rate is positive and that tracks with value and
+result type being different are one of the combinations produced by
+@ref animationInterpolatorFor() or @ref quantizeAnimation() --- i.e.,
+@ref AnimationTrackType::CubicHermite1D, @relativeref{AnimationTrackType,CubicHermite2D},
+@relativeref{AnimationTrackType,CubicHermite3D},
+@relativeref{AnimationTrackType,CubicHermiteComplex},
+@relativeref{AnimationTrackType,CubicHermiteQuaternion},
+@relativeref{AnimationTrackType,Vector3s} or
+@relativeref{AnimationTrackType,Vector3us} with their corresponding result
+type.
+@see @ref simplifyAnimation(), @ref quantizeAnimation()
+*/
+MAGNUM_TRADE_EXPORT AnimationData resampleAnimation(const AnimationData& animation, Float rate);
+
+/**
+@brief Remove redundant keyframes from an animation
+@param animation            Animation to simplify
+@param tolerance            Maximal allowed distance of a removed keyframe
+    value from the value interpolated from the remaining keyframes
+@param rotationTolerance    Maximal allowed angle between a removed rotation
+    keyframe and the rotation interpolated from the remaining keyframes
+@m_since_latest
+
+For each track with the same value and result type greedily removes keyframes
+that can be predicted from their neighbors using the track interpolator
+within given tolerance. The first and last keyframe of each track are always
+kept. For @ref AnimationTrackType::Complex and
+@ref AnimationTrackType::Quaternion tracks the @p rotationTolerance is used,
+for other floating-point types including @ref AnimationTrackType::DualQuaternion
+@p tolerance is compared against a Euclidean distance of the values. For
+integer, boolean, spline and packed types only keyframes that exactly match
+the interpolated value are removed.
+
+Tracks with value and result type being different are copied verbatim, with
+the same expectations on their types as in @ref resampleAnimation().
+Interpolation, extrapolation, target and @ref AnimationData::duration() is
+preserved. As the error of each removed keyframe is bounded independently,
+the output is suitable for further processing with @ref quantizeAnimation(),
+however note that the errors of both operations can add up.
+
+The operation is quadratic in the length of the longest run of removed
+keyframes in the worst case. Running @ref resampleAnimation() first is
+recommended for clips with irregular keyframe distribution.
+*/
+MAGNUM_TRADE_EXPORT AnimationData simplifyAnimation(const AnimationData& animation, Float tolerance, Rad rotationTolerance);
+
+/**
+@brief Quantize rotation and translation tracks of an animation
+@param animation    Animation to quantize
+@m_since_latest
+
+-   Linearly interpolated @ref AnimationTrackType::Quaternion tracks are
+    converted to @ref AnimationTrackType::Vector3us using
+    @ref Animation::packQuaternionSmallestThree(), with
+    @ref Animation::slerpSmallestThree() as the interpolator and
+    @ref AnimationTrackType::Quaternion as the result type, taking six
+    bytes per keyframe instead of sixteen.
+-   Linearly interpolated @ref AnimationTrackType::Vector3 tracks targeting
+    @ref AnimationTrackTargetType::Translation3D are converted to
+    @ref AnimationTrackType::Vector3s using @ref Animation::packTranslation()
+    with an exponent calculated from the largest absolute value in the track
+    using @ref Animation::quantizedTranslationExponent(), with an
+    interpolator returned by
+    @ref Animation::quantizedTranslationInterpolator() and
+    @ref AnimationTrackType::Vector3 as the result type, taking six bytes per
+    keyframe instead of twelve.
+
+All other tracks are copied verbatim, with the same expectations on their
+types as in @ref resampleAnimation(). Keyframe keys, extrapolation, target and
+@ref AnimationData::duration() is preserved. The quantized tracks can be
+accessed using @ref AnimationData::track() with the packed type as the value
+type and the original type as the result type:
+
+@snippet MagnumTrade.cpp quantizeAnimation
+*/
+MAGNUM_TRADE_EXPORT AnimationData quantizeAnimation(const AnimationData& animation);
+
+}}
+
+#endif
@@ -174,6 +174,8 @@ Debug& operator<<(Debug& debug, const AnimationTrackType value) {
         _c(CubicHermite3D)
         _c(CubicHermiteComplex)
         _c(CubicHermiteQuaternion)
+        _c(Vector3s)
+        _c(Vector3us)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
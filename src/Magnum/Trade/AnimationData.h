@@ -115,7 +115,26 @@ enum class AnimationTrackType: UnsignedByte {
      * @ref Magnum::CubicHermiteQuaternion "CubicHermiteQuaternion". Usually
      * used for spline-interpolated @ref AnimationTrackTargetType::Rotation3D.
      */
-    CubicHermiteQuaternion
+    CubicHermiteQuaternion,
+
+    /**
+     * @ref Magnum::Vector3s "Vector3s". Usually used for quantized
+     * @ref AnimationTrackTargetType::Translation3D with a
+     * @ref AnimationTrackType::Vector3 result, see
+     * @ref Animation::packTranslation() and @ref quantizeAnimation().
+     * @m_since_latest
+     */
+    Vector3s,
+
+    /**
+     * @ref Magnum::Vector3us "Vector3us". Usually used for quantized
+     * @ref AnimationTrackTargetType::Rotation3D with a
+     * @ref AnimationTrackType::Quaternion result, see
+     * @ref Animation::packQuaternionSmallestThree() and
+     * @ref quantizeAnimation().
+     * @m_since_latest
+     */
+    Vector3us
 };
 
 /** @debugoperatorenum{AnimationTrackType} */
@@ -646,6 +665,11 @@ namespace Implementation {
     template<> constexpr AnimationTrackType animationTypeFor<CubicHermite3D>() { return AnimationTrackType::CubicHermite3D; }
     template<> constexpr AnimationTrackType animationTypeFor<CubicHermiteComplex>() { return AnimationTrackType::CubicHermiteComplex; }
     template<> constexpr AnimationTrackType animationTypeFor<CubicHermiteQuaternion>() { return AnimationTrackType::CubicHermiteQuaternion; }
+
+    template<> constexpr AnimationTrackType animationTypeFor<Vector3s>() { return AnimationTrackType::Vector3s; }
+    template<> constexpr AnimationTrackType animationTypeFor<Math::Vector<3, Short>>() { return AnimationTrackType::Vector3s; }
+    template<> constexpr AnimationTrackType animationTypeFor<Vector3us>() { return AnimationTrackType::Vector3us; }
+    template<> constexpr AnimationTrackType animationTypeFor<Math::Vector<3, UnsignedShort>>() { return AnimationTrackType::Vector3us; }
     /* LCOV_EXCL_STOP */
 }
 
@@ -0,0 +1,466 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AsyncImporter.h"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/TextureData.h"
+
+namespace Magnum { namespace Trade {
+
+struct AsyncImporter::Task {
+    virtual ~Task() = default;
+
+    /* Called on a worker thread with its own already opened importer */
+    virtual void run(AbstractImporter& importer) = 0;
+
+    /* Called with the queue lock held, so shouldn't call any user code */
+    virtual void cancel() = 0;
+
+    UnsignedLong request;
+    Int priority;
+};
+
+template<class T> struct AsyncImporter::CallbackTask: Task {
+    explicit CallbackTask(Containers::Optional<T>(*load)(AbstractImporter&, UnsignedInt, UnsignedInt), UnsignedInt id, UnsignedInt level, Callback<T> callback, void* userData): load{load}, id{id}, level{level}, callback{callback}, userData{userData} {}
+
+    void run(AbstractImporter& importer) override {
+        callback(request, load(importer, id, level), userData);
+    }
+
+    void cancel() override {}
+
+    Containers::Optional<T>(*load)(AbstractImporter&, UnsignedInt, UnsignedInt);
+    UnsignedInt id, level;
+    Callback<T> callback;
+    void* userData;
+};
+
+template<class T> struct AsyncImporter::PromiseTask: Task {
+    explicit PromiseTask(Containers::Optional<T>(*load)(AbstractImporter&, UnsignedInt, UnsignedInt), UnsignedInt id, UnsignedInt level): load{load}, id{id}, level{level} {}
+
+    void run(AbstractImporter& importer) override {
+        promise.set_value(load(importer, id, level));
+    }
+
+    void cancel() override {
+        promise.set_value(Containers::Optional<T>{});
+    }
+
+    Containers::Optional<T>(*load)(AbstractImporter&, UnsignedInt, UnsignedInt);
+    UnsignedInt id, level;
+    std::promise<Containers::Optional<T>> promise;
+};
+
+struct AsyncImporter::State {
+    struct Worker {
+        Containers::Pointer<AbstractImporter> importer;
+    };
+
+    explicit State(Instancer instancer, void* instancerData, UnsignedInt threadCount): instancer{instancer}, instancerData{instancerData}, workers{threadCount}, threads{threadCount} {}
+
+    Containers::Pointer<AbstractImporter> instantiate();
+    bool open(Containers::Pointer<AbstractImporter>&& importer, bool fromData);
+    void cancelQueued();
+    void work(Worker& worker);
+
+    Instancer instancer;
+    void* instancerData;
+    /* Used only by the plugin manager constructor */
+    PluginManager::Manager<AbstractImporter>* manager{};
+    std::string plugin;
+
+    ImporterFlags flags;
+    Containers::Optional<Containers::ArrayView<const char>>(*fileCallback)(const std::string&, InputFileCallbackPolicy, void*){};
+    void* fileCallbackUserData{};
+
+    /* Importer used on the calling thread, and what the workers have
+       opened */
+    Containers::Pointer<AbstractImporter> importer;
+    std::string filename;
+    Containers::Array<char> data;
+
+    Containers::Array<Worker> workers;
+    Containers::Array<std::thread> threads;
+
+    /* Everything below is guarded by the mutex. The worker importers as
+       well, but those are touched only by the calling thread when the queue
+       is empty and no worker is busy. */
+    mutable std::mutex mutex;
+    std::condition_variable workAvailable, idle;
+    /* In submission order, so a linear search for the highest priority picks
+       the oldest request of given priority */
+    std::vector<Containers::Pointer<Task>> queue;
+    UnsignedLong nextRequest{1};
+    std::size_t busy{};
+    bool quit{};
+};
+
+Containers::Pointer<AbstractImporter> AsyncImporter::State::instantiate() {
+    Containers::Pointer<AbstractImporter> importer = instancer(instancerData);
+    if(!importer) return nullptr;
+
+    importer->setFlags(flags);
+    if(fileCallback) importer->setFileCallback(fileCallback, fileCallbackUserData);
+    return importer;
+}
+
+bool AsyncImporter::State::open(Containers::Pointer<AbstractImporter>&& opened, const bool fromData) {
+    /* Create and open all worker importers upfront on the calling thread.
+       The plugin manager isn't thread-safe and plugins such as
+       AnySceneImporter load and instantiate other plugins when opening a
+       file, so this can't be done on the workers. */
+    Containers::Array<Containers::Pointer<AbstractImporter>> workerImporters{workers.size()};
+    for(Containers::Pointer<AbstractImporter>& workerImporter: workerImporters) {
+        if(!(workerImporter = instantiate())) return false;
+        if(!(fromData ? workerImporter->openData(data) : workerImporter->openFile(filename)))
+            return false;
+    }
+
+    std::lock_guard<std::mutex> lock{mutex};
+    for(std::size_t i = 0; i != workers.size(); ++i)
+        workers[i].importer = std::move(workerImporters[i]);
+    importer = std::move(opened);
+    return true;
+}
+
+void AsyncImporter::State::cancelQueued() {
+    for(Containers::Pointer<Task>& task: queue) task->cancel();
+    queue.clear();
+}
+
+void AsyncImporter::State::work(Worker& worker) {
+    std::unique_lock<std::mutex> lock{mutex};
+    for(;;) {
+        workAvailable.wait(lock, [&]{ return quit || !queue.empty(); });
+        if(quit) return;
+
+        auto found = queue.begin();
+        for(auto it = found + 1; it != queue.end(); ++it)
+            if((*it)->priority > (*found)->priority) found = it;
+        Containers::Pointer<Task> task = std::move(*found);
+        queue.erase(found);
+        ++busy;
+        lock.unlock();
+
+        task->run(*worker.importer);
+        task = nullptr;
+
+        lock.lock();
+        --busy;
+        if(queue.empty() && !busy) idle.notify_all();
+    }
+}
+
+namespace {
+
+Containers::Optional<MeshData> loadMesh(AbstractImporter& importer, const UnsignedInt id, const UnsignedInt level) {
+    return importer.mesh(id, level);
+}
+
+Containers::Optional<MaterialData> loadMaterial(AbstractImporter& importer, const UnsignedInt id, UnsignedInt) {
+    return importer.material(id);
+}
+
+Containers::Optional<TextureData> loadTexture(AbstractImporter& importer, const UnsignedInt id, UnsignedInt) {
+    return importer.texture(id);
+}
+
+Containers::Optional<ImageData1D> loadImage1D(AbstractImporter& importer, const UnsignedInt id, const UnsignedInt level) {
+    return importer.image1D(id, level);
+}
+
+Containers::Optional<ImageData2D> loadImage2D(AbstractImporter& importer, const UnsignedInt id, const UnsignedInt level) {
+    return importer.image2D(id, level);
+}
+
+Containers::Optional<ImageData3D> loadImage3D(AbstractImporter& importer, const UnsignedInt id, const UnsignedInt level) {
+    return importer.image3D(id, level);
+}
+
+UnsignedInt defaultThreadCount(const UnsignedInt threadCount) {
+    return threadCount ? threadCount : Math::max(std::thread::hardware_concurrency(), 1u);
+}
+
+}
+
+AsyncImporter::AsyncImporter(PluginManager::Manager<AbstractImporter>& manager, const std::string& plugin, const UnsignedInt threadCount): AsyncImporter{nullptr, nullptr, threadCount} {
+    _state->manager = &manager;
+    _state->plugin = plugin;
+    _state->instancer = [](void* userData) {
+        auto& state = *static_cast<State*>(userData);
+        return state.manager->loadAndInstantiate(state.plugin);
+    };
+    _state->instancerData = _state.get();
+}
+
+AsyncImporter::AsyncImporter(const Instancer instancer, void* const instancerData, const UnsignedInt threadCount): _state{Containers::InPlaceInit, instancer, instancerData, defaultThreadCount(threadCount)} {
+    for(std::size_t i = 0; i != _state->threads.size(); ++i)
+        _state->threads[i] = std::thread{&State::work, _state.get(), std::ref(_state->workers[i])};
+}
+
+AsyncImporter::~AsyncImporter() {
+    close();
+
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->quit = true;
+    }
+    _state->workAvailable.notify_all();
+    for(std::thread& thread: _state->threads) thread.join();
+}
+
+UnsignedInt AsyncImporter::threadCount() const { return _state->threads.size(); }
+
+ImporterFlags AsyncImporter::flags() const { return _state->flags; }
+
+void AsyncImporter::setFlags(const ImporterFlags flags) {
+    CORRADE_ASSERT(!_state->importer,
+        "Trade::AsyncImporter::setFlags(): can't be set while a file is opened", );
+    _state->flags = flags;
+}
+
+void AsyncImporter::setFileCallback(Containers::Optional<Containers::ArrayView<const char>>(*const callback)(const std::string&, InputFileCallbackPolicy, void*), void* const userData) {
+    CORRADE_ASSERT(!_state->importer, "Trade::AsyncImporter::setFileCallback(): can't be set while a file is opened", );
+    _state->fileCallback = callback;
+    _state->fileCallbackUserData = userData;
+}
+
+bool AsyncImporter::openData(const Containers::ArrayView<const char> data) {
+    close();
+
+    Containers::Pointer<AbstractImporter> importer = _state->instantiate();
+    if(!importer) return false;
+
+    /* The importers may reference the data for as long as they're opened,
+       so make a copy */
+    _state->data = Containers::Array<char>{Containers::NoInit, data.size()};
+    Utility::copy(data, _state->data);
+    if(!importer->openData(_state->data) || !_state->open(std::move(importer), true)) {
+        _state->data = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+bool AsyncImporter::openFile(const std::string& filename) {
+    close();
+
+    Containers::Pointer<AbstractImporter> importer = _state->instantiate();
+    if(!importer || !importer->openFile(filename)) return false;
+
+    _state->filename = filename;
+    if(!_state->open(std::move(importer), false)) {
+        _state->filename = {};
+        return false;
+    }
+
+    return true;
+}
+
+void AsyncImporter::close() {
+    {
+        std::unique_lock<std::mutex> lock{_state->mutex};
+        _state->cancelQueued();
+        _state->idle.wait(lock, [&]{ return !_state->busy; });
+
+        for(State::Worker& worker: _state->workers)
+            worker.importer = nullptr;
+    }
+
+    _state->importer = nullptr;
+    _state->data = nullptr;
+    _state->filename = {};
+}
+
+bool AsyncImporter::isOpened() const { return !!_state->importer; }
+
+AbstractImporter& AsyncImporter::importer() {
+    CORRADE_ASSERT(_state->importer, "Trade::AsyncImporter::importer(): no file opened", *_state->importer);
+    return *_state->importer;
+}
+
+UnsignedLong AsyncImporter::submit(Containers::Pointer<Task>&& task, const Int priority) {
+    UnsignedLong request;
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        request = task->request = _state->nextRequest++;
+        task->priority = priority;
+        _state->queue.push_back(std::move(task));
+    }
+    _state->workAvailable.notify_one();
+    return request;
+}
+
+template<class T> std::future<Containers::Optional<T>> AsyncImporter::submitPromise(Containers::Optional<T>(*const load)(AbstractImporter&, UnsignedInt, UnsignedInt), const UnsignedInt id, const UnsignedInt level, const Int priority, UnsignedLong* const request) {
+    Containers::Pointer<PromiseTask<T>> task{Containers::InPlaceInit, load, id, level};
+    std::future<Containers::Optional<T>> future = task->promise.get_future();
+    const UnsignedLong submitted = submit(std::move(task), priority);
+    if(request) *request = submitted;
+    return future;
+}
+
+template<class T> UnsignedLong AsyncImporter::submitCallback(Containers::Optional<T>(*const load)(AbstractImporter&, UnsignedInt, UnsignedInt), const UnsignedInt id, const UnsignedInt level, const Int priority, const Callback<T> callback, void* const userData) {
+    return submit(Containers::Pointer<Task>{new CallbackTask<T>{load, id, level, callback, userData}}, priority);
+}
+
+#ifndef CORRADE_NO_ASSERT
+/* Done on the calling thread in order to not blow up on a worker thread. Check
+   for the level only if nonzero, same as AbstractImporter does. */
+#define ASYNCIMPORTER_CHECK(name, function, ...)                            \
+    CORRADE_ASSERT(_state->importer,                                        \
+        "Trade::AsyncImporter::" name "(): no file opened", __VA_ARGS__);   \
+    CORRADE_ASSERT(id < _state->importer->function ## Count(),              \
+        "Trade::AsyncImporter::" name "(): index" << id << "out of range for" << _state->importer->function ## Count() << "entries", __VA_ARGS__);
+#define ASYNCIMPORTER_CHECK_LEVEL(name, function, ...)                      \
+    ASYNCIMPORTER_CHECK(name, function, __VA_ARGS__)                        \
+    CORRADE_ASSERT(!level || level < _state->importer->function ## LevelCount(id), \
+        "Trade::AsyncImporter::" name "(): level" << level << "out of range for" << _state->importer->function ## LevelCount(id) << "entries", __VA_ARGS__);
+#else
+#define ASYNCIMPORTER_CHECK(name, function, ...)
+#define ASYNCIMPORTER_CHECK_LEVEL(name, function, ...)
+#endif
+
+std::future<Containers::Optional<MeshData>> AsyncImporter::mesh(const UnsignedInt id, const UnsignedInt level, const Int priority, UnsignedLong* const request) {
+    ASYNCIMPORTER_CHECK_LEVEL("mesh", mesh, {})
+    return submitPromise(loadMesh, id, level, priority, request);
+}
+
+UnsignedLong AsyncImporter::mesh(const UnsignedInt id, const UnsignedInt level, const Int priority, const Callback<MeshData> callback, void* const userData) {
+    ASYNCIMPORTER_CHECK_LEVEL("mesh", mesh, {})
+    return submitCallback(loadMesh, id, level, priority, callback, userData);
+}
+
+std::future<Containers::Optional<MaterialData>> AsyncImporter::material(const UnsignedInt id, const Int priority, UnsignedLong* const request) {
+    ASYNCIMPORTER_CHECK("material", material, {})
+    return submitPromise(loadMaterial, id, 0, priority, request);
+}
+
+UnsignedLong AsyncImporter::material(const UnsignedInt id, const Int priority, const Callback<MaterialData> callback, void* const userData) {
+    ASYNCIMPORTER_CHECK("material", material, {})
+    return submitCallback(loadMaterial, id, 0, priority, callback, userData);
+}
+
+std::future<Containers::Optional<TextureData>> AsyncImporter::texture(const UnsignedInt id, const Int priority, UnsignedLong* const request) {
+    ASYNCIMPORTER_CHECK("texture", texture, {})
+    return submitPromise(loadTexture, id, 0, priority, request);
+}
+
+UnsignedLong AsyncImporter::texture(const UnsignedInt id, const Int priority, const Callback<TextureData> callback, void* const userData) {
+    ASYNCIMPORTER_CHECK("texture", texture, {})
+    return submitCallback(loadTexture, id, 0, priority, callback, userData);
+}
+
+std::future<Containers::Optional<ImageData1D>> AsyncImporter::image1D(const UnsignedInt id, const UnsignedInt level, const Int priority, UnsignedLong* const request) {
+    ASYNCIMPORTER_CHECK_LEVEL("image1D", image1D, {})
+    return submitPromise(loadImage1D, id, level, priority, request);
+}
+
+UnsignedLong AsyncImporter::image1D(const UnsignedInt id, const UnsignedInt level, const Int priority, const Callback<ImageData1D> callback, void* const userData) {
+    ASYNCIMPORTER_CHECK_LEVEL("image1D", image1D, {})
+    return submitCallback(loadImage1D, id, level, priority, callback, userData);
+}
+
+std::future<Containers::Optional<ImageData2D>> AsyncImporter::image2D(const UnsignedInt id, const UnsignedInt level, const Int priority, UnsignedLong* const request) {
+    ASYNCIMPORTER_CHECK_LEVEL("image2D", image2D, {})
+    return submitPromise(loadImage2D, id, level, priority, request);
+}
+
+UnsignedLong AsyncImporter::image2D(const UnsignedInt id, const UnsignedInt level, const Int priority, const Callback<ImageData2D> callback, void* const userData) {
+    ASYNCIMPORTER_CHECK_LEVEL("image2D", image2D, {})
+    return submitCallback(loadImage2D, id, level, priority, callback, userData);
+}
+
+std::future<Containers::Optional<ImageData3D>> AsyncImporter::image3D(const UnsignedInt id, const UnsignedInt level, const Int priority, UnsignedLong* const request) {
+    ASYNCIMPORTER_CHECK_LEVEL("image3D", image3D, {})
+    return submitPromise(loadImage3D, id, level, priority, request);
+}
+
+UnsignedLong AsyncImporter::image3D(const UnsignedInt id, const UnsignedInt level, const Int priority, const Callback<ImageData3D> callback, void* const userData) {
+    ASYNCIMPORTER_CHECK_LEVEL("image3D", image3D, {})
+    return submitCallback(loadImage3D, id, level, priority, callback, userData);
+}
+
+#undef ASYNCIMPORTER_CHECK
+#undef ASYNCIMPORTER_CHECK_LEVEL
+
+std::size_t AsyncImporter::pendingRequestCount() const {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    return _state->queue.size();
+}
+
+bool AsyncImporter::setPriority(const UnsignedLong request, const Int priority) {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    for(Containers::Pointer<Task>& task: _state->queue) {
+        if(task->request != request) continue;
+        task->priority = priority;
+        return true;
+    }
+
+    return false;
+}
+
+bool AsyncImporter::cancel(const UnsignedLong request) {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    for(auto it = _state->queue.begin(); it != _state->queue.end(); ++it) {
+        if((*it)->request != request) continue;
+        (*it)->cancel();
+        _state->queue.erase(it);
+        if(_state->queue.empty() && !_state->busy) _state->idle.notify_all();
+        return true;
+    }
+
+    return false;
+}
+
+std::size_t AsyncImporter::cancelAll() {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    const std::size_t count = _state->queue.size();
+    _state->cancelQueued();
+    if(!_state->busy) _state->idle.notify_all();
+    return count;
+}
+
+void AsyncImporter::wait() {
+    std::unique_lock<std::mutex> lock{_state->mutex};
+    _state->idle.wait(lock, [&]{ return _state->queue.empty() && !_state->busy; });
+}
+
+}}
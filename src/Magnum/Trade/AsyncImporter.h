@@ -0,0 +1,402 @@
+#ifndef Magnum_Trade_AsyncImporter_h
+#define Magnum_Trade_AsyncImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::AsyncImporter
+ * @m_since_latest
+ */
+
+#include <future>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/PluginManager/PluginManager.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Asynchronous importer
+@m_since_latest
+
+Loads data from an @ref AbstractImporter plugin on a pool of worker threads.
+As importers aren't thread-safe, every worker has its own importer instance,
+all of them opening the same file.
+
+@section Trade-AsyncImporter-usage Usage
+
+The pool is created together with the instance and persists across files.
+Once a file is opened with @ref openFile() or @ref openData(), resources are
+requested using @ref mesh(), @ref image2D(), @ref material() and similar
+functions. Each request is put into a queue and the function returns
+immediately with a @ref std::future, which gets fulfilled once a worker
+processes the request. Requests with a higher priority are processed first,
+requests with the same priority in the order they were submitted:
+
+@snippet MagnumTrade.cpp AsyncImporter-usage
+
+Queries such as mesh or image count, names or level counts are done through
+@ref importer(), which is opened on the calling thread. Only the calling
+thread is allowed to use it.
+
+Every request function also has an overload taking a completion callback
+instead of returning a future, which is called from a worker thread with the
+request ID, the imported data (or @ref Corrade::Containers::NullOpt on
+failure) and a user data pointer. Both variants can be mixed.
+
+Imported data that reference memory owned by the importer, such as
+@ref MeshData returned by the @ref MagnumImporter "MagnumImporter" plugin,
+stay valid until @ref close() is called or the instance is destroyed.
+
+@section Trade-AsyncImporter-cancelling Priorities and cancelling
+
+Every request gets a unique non-zero ID, which is returned by the callback variants
+and written to the optional @p request output parameter in the future
+variants. Requests that didn't start processing yet can be reprioritized
+with @ref setPriority() and removed from the queue with @ref cancel(), for
+example when the user leaves a level before it finished loading. A cancelled
+request doesn't call its callback; a cancelled future is fulfilled with
+@ref Corrade::Containers::NullOpt. @ref cancelAll() cancels all requests
+that didn't start yet, @ref wait() blocks until all requests are processed.
+
+@section Trade-AsyncImporter-callbacks File callbacks and threading
+
+The file callback set with @ref setFileCallback() is shared by all worker
+importers together with its user data pointer, so the data loaded by it get
+reused. Importers may call it also when importing data, such as when loading
+external buffers, which means the callback can be called from multiple
+threads at the same time and thus has to be thread-safe.
+
+As @ref Corrade::PluginManager::Manager isn't thread-safe, all importer
+instances are created and open the file on the calling thread in
+@ref openFile() and @ref openData(), since plugins such as
+@ref AnySceneImporter load and instantiate other plugins when opening. For
+the same reason, importers that load or instantiate other plugins while
+importing data, such as scene importers delegating external images to
+@ref AnyImageImporter in @ref AbstractImporter::image2D(), can't be used with
+this class.
+
+The instance itself is expected to be used only from the thread that created
+it, in particular the completion callbacks are not allowed to submit new
+requests. Error messages
+printed by the worker importers go to the default output unless
+Corrade is built with @ref CORRADE_BUILD_MULTITHREADED and redirected on
+given thread. The class isn't available on
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", which doesn't support threads
+without extra setup.
+@experimental
+*/
+class MAGNUM_TRADE_EXPORT AsyncImporter {
+    public:
+        /**
+         * @brief Completion callback
+         *
+         * Gets the request ID, imported data or
+         * @ref Corrade::Containers::NullOpt on failure and the user data
+         * pointer. Called from a worker thread.
+         */
+        template<class T> using Callback = void(*)(UnsignedLong, Containers::Optional<T>&&, void*);
+
+        /**
+         * @brief Importer instancer
+         *
+         * Gets an user data pointer, returns a new importer instance or
+         * @cpp nullptr @ce on failure. Called only on the thread that calls
+         * @ref openFile() or @ref openData().
+         */
+        typedef Containers::Pointer<AbstractImporter>(*Instancer)(void*);
+
+        /**
+         * @brief Construct with a plugin manager
+         * @param manager       Plugin manager
+         * @param plugin        Importer plugin name
+         * @param threadCount   Worker thread count. If @cpp 0 @ce, uses
+         *      @ref std::thread::hardware_concurrency().
+         *
+         * The @p manager is expected to stay in scope for the whole instance
+         * lifetime.
+         */
+        explicit AsyncImporter(PluginManager::Manager<AbstractImporter>& manager, const std::string& plugin, UnsignedInt threadCount = 0);
+
+        /**
+         * @brief Construct with a custom instancer
+         * @param instancer     Importer instancer
+         * @param instancerData User data pointer passed to @p instancer
+         * @param threadCount   Worker thread count. If @cpp 0 @ce, uses
+         *      @ref std::thread::hardware_concurrency().
+         *
+         * Useful for importers that aren't loaded through a plugin manager.
+         */
+        explicit AsyncImporter(Instancer instancer, void* instancerData, UnsignedInt threadCount = 0);
+
+        /** @brief Copying is not allowed */
+        AsyncImporter(const AsyncImporter&) = delete;
+
+        /** @brief Moving is not allowed */
+        AsyncImporter(AsyncImporter&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Cancels all requests that didn't start yet, waits for the running
+         * ones and then stops the worker threads.
+         */
+        ~AsyncImporter();
+
+        /** @brief Copying is not allowed */
+        AsyncImporter& operator=(const AsyncImporter&) = delete;
+
+        /** @brief Moving is not allowed */
+        AsyncImporter& operator=(AsyncImporter&&) = delete;
+
+        /** @brief Worker thread count */
+        UnsignedInt threadCount() const;
+
+        /** @brief Importer flags */
+        ImporterFlags flags() const;
+
+        /**
+         * @brief Set importer flags
+         *
+         * Applied to all importer instances. Expects that no file is opened.
+         * @see @ref AbstractImporter::setFlags()
+         */
+        void setFlags(ImporterFlags flags);
+
+        /**
+         * @brief Set file opening callback
+         *
+         * Applied to all importer instances, see
+         * @ref Trade-AsyncImporter-callbacks for details. Expects that no
+         * file is opened.
+         * @see @ref AbstractImporter::setFileCallback()
+         */
+        void setFileCallback(Containers::Optional<Containers::ArrayView<const char>>(*callback)(const std::string&, InputFileCallbackPolicy, void*), void* userData = nullptr);
+
+        /**
+         * @brief Open raw data
+         *
+         * Closes the previous file, if any, copies @p data and opens them
+         * with @ref importer() and all worker importers on the calling
+         * thread. Returns @cpp false @ce if the data can't be opened.
+         */
+        bool openData(Containers::ArrayView<const char> data);
+
+        /**
+         * @brief Open a file
+         *
+         * Closes the previous file, if any, and opens @p filename with
+         * @ref importer() and all worker importers on the calling thread.
+         * Returns @cpp false @ce if the file can't be opened.
+         */
+        bool openFile(const std::string& filename);
+
+        /**
+         * @brief Close currently opened file
+         *
+         * Cancels all requests that didn't start yet, waits for the running
+         * ones and closes all importer instances.
+         */
+        void close();
+
+        /** @brief Whether any file is opened */
+        bool isOpened() const;
+
+        /**
+         * @brief Importer used for queries
+         *
+         * Expects that a file is opened. The instance is not used by any
+         * worker thread and can be used for querying counts, names and other
+         * metadata on the calling thread. It can be used for importing
+         * data as well, but doing so will block the calling thread.
+         */
+        AbstractImporter& importer();
+
+        /**
+         * @brief Request a mesh
+         * @param id        Mesh ID, from range [0, @ref AbstractImporter::meshCount())
+         * @param level     Mesh level
+         * @param priority  Request priority. Higher priority requests are
+         *      processed first.
+         * @param request   If not @cpp nullptr @ce, request ID is written
+         *      there
+         *
+         * Expects that a file is opened. See @ref Trade-AsyncImporter-usage
+         * for details.
+         * @see @ref AbstractImporter::mesh()
+         */
+        std::future<Containers::Optional<MeshData>> mesh(UnsignedInt id, UnsignedInt level = 0, Int priority = 0, UnsignedLong* request = nullptr);
+
+        /**
+         * @brief Request a mesh with a completion callback
+         *
+         * Returns request ID. See @ref Trade-AsyncImporter-usage for details.
+         */
+        UnsignedLong mesh(UnsignedInt id, UnsignedInt level, Int priority, Callback<MeshData> callback, void* userData = nullptr);
+
+        /**
+         * @brief Request a material
+         *
+         * Like @ref mesh(UnsignedInt, UnsignedInt, Int, UnsignedLong*), but
+         * for a material.
+         * @see @ref AbstractImporter::material()
+         */
+        std::future<Containers::Optional<MaterialData>> material(UnsignedInt id, Int priority = 0, UnsignedLong* request = nullptr);
+
+        /**
+         * @brief Request a material with a completion callback
+         *
+         * Like @ref mesh(UnsignedInt, UnsignedInt, Int, Callback<MeshData>, void*),
+         * but for a material.
+         */
+        UnsignedLong material(UnsignedInt id, Int priority, Callback<MaterialData> callback, void* userData = nullptr);
+
+        /**
+         * @brief Request a texture
+         *
+         * Like @ref mesh(UnsignedInt, UnsignedInt, Int, UnsignedLong*), but
+         * for a texture.
+         * @see @ref AbstractImporter::texture()
+         */
+        std::future<Containers::Optional<TextureData>> texture(UnsignedInt id, Int priority = 0, UnsignedLong* request = nullptr);
+
+        /**
+         * @brief Request a texture with a completion callback
+         *
+         * Like @ref mesh(UnsignedInt, UnsignedInt, Int, Callback<MeshData>, void*),
+         * but for a texture.
+         */
+        UnsignedLong texture(UnsignedInt id, Int priority, Callback<TextureData> callback, void* userData = nullptr);
+
+        /**
+         * @brief Request a 1D image
+         *
+         * Like @ref mesh(UnsignedInt, UnsignedInt, Int, UnsignedLong*), but
+         * for a 1D image.
+         * @see @ref AbstractImporter::image1D()
+         */
+        std::future<Containers::Optional<ImageData1D>> image1D(UnsignedInt id, UnsignedInt level = 0, Int priority = 0, UnsignedLong* request = nullptr);
+
+        /**
+         * @brief Request a 1D image with a completion callback
+         *
+         * Like @ref mesh(UnsignedInt, UnsignedInt, Int, Callback<MeshData>, void*),
+         * but for a 1D image.
+         */
+        UnsignedLong image1D(UnsignedInt id, UnsignedInt level, Int priority, Callback<ImageData1D> callback, void* userData = nullptr);
+
+        /**
+         * @brief Request a 2D image
+         *
+         * Like @ref mesh(UnsignedInt, UnsignedInt, Int, UnsignedLong*), but
+         * for a 2D image.
+         * @see @ref AbstractImporter::image2D()
+         */
+        std::future<Containers::Optional<ImageData2D>> image2D(UnsignedInt id, UnsignedInt level = 0, Int priority = 0, UnsignedLong* request = nullptr);
+
+        /**
+         * @brief Request a 2D image with a completion callback
+         *
+         * Like @ref mesh(UnsignedInt, UnsignedInt, Int, Callback<MeshData>, void*),
+         * but for a 2D image.
+         */
+        UnsignedLong image2D(UnsignedInt id, UnsignedInt level, Int priority, Callback<ImageData2D> callback, void* userData = nullptr);
+
+        /**
+         * @brief Request a 3D image
+         *
+         * Like @ref mesh(UnsignedInt, UnsignedInt, Int, UnsignedLong*), but
+         * for a 3D image.
+         * @see @ref AbstractImporter::image3D()
+         */
+        std::future<Containers::Optional<ImageData3D>> image3D(UnsignedInt id, UnsignedInt level = 0, Int priority = 0, UnsignedLong* request = nullptr);
+
+        /**
+         * @brief Request a 3D image with a completion callback
+         *
+         * Like @ref mesh(UnsignedInt, UnsignedInt, Int, Callback<MeshData>, void*),
+         * but for a 3D image.
+         */
+        UnsignedLong image3D(UnsignedInt id, UnsignedInt level, Int priority, Callback<ImageData3D> callback, void* userData = nullptr);
+
+        /**
+         * @brief Count of requests waiting in the queue
+         *
+         * Doesn't include requests that are being processed.
+         */
+        std::size_t pendingRequestCount() const;
+
+        /**
+         * @brief Change priority of a request
+         *
+         * Returns @cpp true @ce if the request is still in the queue,
+         * @cpp false @ce if it's already being processed, finished or was
+         * cancelled.
+         */
+        bool setPriority(UnsignedLong request, Int priority);
+
+        /**
+         * @brief Cancel a request
+         *
+         * Removes the request from the queue. If the request was submitted
+         * with a callback, the callback isn't called; if with a future, the
+         * future is fulfilled with @ref Corrade::Containers::NullOpt. Returns
+         * @cpp true @ce if the request was still in the queue, @cpp false @ce
+         * if it's already being processed, finished or was cancelled before.
+         */
+        bool cancel(UnsignedLong request);
+
+        /**
+         * @brief Cancel all requests
+         *
+         * Cancels all requests that didn't start yet, same as calling
+         * @ref cancel() on each of them. Returns count of cancelled requests.
+         */
+        std::size_t cancelAll();
+
+        /**
+         * @brief Wait for all requests to finish
+         *
+         * Blocks until the queue is empty and no request is being processed.
+         */
+        void wait();
+
+    private:
+        struct Task;
+        template<class T> struct CallbackTask;
+        template<class T> struct PromiseTask;
+        struct State;
+
+        MAGNUM_TRADE_LOCAL UnsignedLong submit(Containers::Pointer<Task>&& task, Int priority);
+        template<class T> MAGNUM_TRADE_LOCAL std::future<Containers::Optional<T>> submitPromise(Containers::Optional<T>(*load)(AbstractImporter&, UnsignedInt, UnsignedInt), UnsignedInt id, UnsignedInt level, Int priority, UnsignedLong* request);
+        template<class T> MAGNUM_TRADE_LOCAL UnsignedLong submitCallback(Containers::Optional<T>(*load)(AbstractImporter&, UnsignedInt, UnsignedInt), UnsignedInt id, UnsignedInt level, Int priority, Callback<T> callback, void* userData);
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -27,6 +27,8 @@
 
 #include <Corrade/Containers/EnumSet.hpp>
 
+#include "Magnum/Trade/Implementation/serialization.h"
+
 namespace Magnum { namespace Trade {
 
 Debug& operator<<(Debug& debug, const DataFlag value) {
@@ -50,6 +52,27 @@ Debug& operator<<(Debug& debug, const DataFlags value) {
         DataFlag::Mutable});
 }
 
+Debug& operator<<(Debug& debug, const DataChunkType value) {
+    debug << "Trade::DataChunkType" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case DataChunkType::v: return debug << "::" #v;
+        _c(Mesh)
+        _c(Image1D)
+        _c(Image2D)
+        _c(Image3D)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedInt(value)) << Debug::nospace << ")";
+}
+
+const DataChunkHeader* dataChunkHeaderDeserialize(const Containers::ArrayView<const void> data) {
+    return Implementation::checkDataChunkHeader("Trade::dataChunkHeaderDeserialize():", data);
+}
+
 namespace Implementation {
     void nonOwnedArrayDeleter(char*, std::size_t) { /* does nothing */ }
 }
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Enum @ref Magnum::Trade::DataFlag, enum set @ref Magnum::Trade::DataFlags
+ * @brief Enum @ref Magnum::Trade::DataFlag, @ref Magnum::Trade::DataChunkType, enum set @ref Magnum::Trade::DataFlags, struct @ref Magnum::Trade::DataChunkHeader, function @ref Magnum::Trade::dataChunkHeaderDeserialize()
  * @m_since{2020,06}
  */
 
@@ -85,6 +85,89 @@ CORRADE_ENUMSET_OPERATORS(DataFlags)
 */
 MAGNUM_TRADE_EXPORT Debug& operator<<(Debug& debug, DataFlags value);
 
+namespace Implementation {
+    /* Four-character code, laid out in memory as the characters would be in
+       a little-endian file */
+    constexpr UnsignedInt dataChunkTypeFourCC(char a, char b, char c, char d) {
+        return UnsignedInt(UnsignedByte(a)) << 0 |
+               UnsignedInt(UnsignedByte(b)) << 8 |
+               UnsignedInt(UnsignedByte(c)) << 16 |
+               UnsignedInt(UnsignedByte(d)) << 24;
+    }
+}
+
+/**
+@brief Serialized data chunk type
+@m_since_latest
+
+Values are four-character codes that appear verbatim in the serialized data
+on little-endian machines.
+@see @ref DataChunkHeader, @ref dataChunkHeaderDeserialize()
+*/
+enum class DataChunkType: UnsignedInt {
+    /** Mesh, serialized with @ref MeshData::serialize() */
+    Mesh = Implementation::dataChunkTypeFourCC('M', 'e', 's', 'h'),
+
+    /** One-dimensional image, serialized with @ref ImageData::serialize() */
+    Image1D = Implementation::dataChunkTypeFourCC('I', 'm', 'g', '1'),
+
+    /** Two-dimensional image, serialized with @ref ImageData::serialize() */
+    Image2D = Implementation::dataChunkTypeFourCC('I', 'm', 'g', '2'),
+
+    /** Three-dimensional image, serialized with @ref ImageData::serialize() */
+    Image3D = Implementation::dataChunkTypeFourCC('I', 'm', 'g', '3')
+};
+
+/**
+@debugoperatorenum{DataChunkType}
+@m_since_latest
+*/
+MAGNUM_TRADE_EXPORT Debug& operator<<(Debug& debug, DataChunkType value);
+
+/**
+@brief Serialized data chunk header
+@m_since_latest
+
+Every blob produced by @ref MeshData::serialize() or @ref ImageData::serialize()
+starts with this header. The @ref size includes the header itself and is
+always a multiple of 8, so chunks can be concatenated into a single file
+without breaking alignment of their contents. Use
+@ref dataChunkHeaderDeserialize() to validate the header and iterate over
+chunks in such a file.
+*/
+struct DataChunkHeader {
+    /** @brief Signature, always `BLOB` */
+    char magic[4];
+
+    /** @brief Format version */
+    UnsignedShort version;
+
+    /** @brief Byte order marker */
+    UnsignedShort endianness;
+
+    /** @brief Chunk type */
+    DataChunkType type;
+
+    /** @brief Reserved, always zero */
+    UnsignedInt reserved;
+
+    /** @brief Chunk size including the header */
+    UnsignedLong size;
+};
+
+/**
+@brief Validate a serialized data chunk header
+@m_since_latest
+
+Expects that @p data is aligned to 8 bytes and starts with a header of a
+chunk with the same version and byte order as the host that fits into
+@p data. Returns a pointer to the header on success, otherwise prints a
+message to @ref Error and returns @cpp nullptr @ce. The chunk contents are
+not validated, that's done by the deserialization function corresponding
+to @ref DataChunkHeader::type.
+*/
+MAGNUM_TRADE_EXPORT const DataChunkHeader* dataChunkHeaderDeserialize(Containers::ArrayView<const void> data);
+
 namespace Implementation {
     /* Used internally by MeshData */
     MAGNUM_TRADE_EXPORT void nonOwnedArrayDeleter(char*, std::size_t);
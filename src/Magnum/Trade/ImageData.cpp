@@ -25,11 +25,15 @@
 
 #include "ImageData.h"
 
+#include <cstring>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
 
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Implementation/ImageProperties.h"
+#include "Magnum/Trade/Implementation/serialization.h"
 
 namespace Magnum { namespace Trade {
 
@@ -214,6 +218,232 @@ template<UnsignedInt dimensions> Containers::Array<char> ImageData<dimensions>::
     return data;
 }
 
+namespace {
+
+/* Data of the first level start right after the level list. The header and
+   each level entry are a multiple of 8 bytes, so there's no padding needed. */
+std::size_t serializedLevelDataOffset(const std::size_t levelCount) {
+    return sizeof(Implementation::ImageDataChunk) + levelCount*sizeof(Implementation::ImageDataChunkLevel);
+}
+
+constexpr DataChunkType ImageDataChunkTypes[]{
+    DataChunkType::Image1D,
+    DataChunkType::Image2D,
+    DataChunkType::Image3D
+};
+
+/* Used to validate deserialized formats, as pixelSize() asserts on unknown
+   values */
+constexpr UnsignedInt PixelFormatCount = 0
+    #define _c(format) + 1
+    #include "Magnum/Implementation/pixelFormatMapping.hpp"
+    #undef _c
+    ;
+constexpr UnsignedInt CompressedPixelFormatCount = 0
+    #define _c(format, width, height, depth, size) + 1
+    #include "Magnum/Implementation/compressedPixelFormatMapping.hpp"
+    #undef _c
+    ;
+
+/* Validates the header, the level list and layout of all levels. Done
+   fully in both deserialize() and deserializeLevelCount() so an invalid
+   level is never returned, it's just a few comparisons per level. */
+template<UnsignedInt dimensions> const Implementation::ImageDataChunk* checkImageDataChunk(const char* const prefix, const Containers::ArrayView<const void> data) {
+    const DataChunkHeader* const header = Implementation::checkDataChunkHeader(prefix, data, ImageDataChunkTypes[dimensions - 1], sizeof(Implementation::ImageDataChunk));
+    if(!header) return nullptr;
+
+    /* All sizes and offsets are 64-bit, so do the checks in a way that can't
+       overflow on 32-bit platforms either */
+    const auto& chunk = *reinterpret_cast<const Implementation::ImageDataChunk*>(header);
+    const UnsignedLong size = chunk.header.size;
+    const UnsignedLong levelDataOffset = sizeof(Implementation::ImageDataChunk) + UnsignedLong(chunk.levelCount)*sizeof(Implementation::ImageDataChunkLevel);
+    if(!chunk.levelCount || levelDataOffset > size) {
+        Error{} << prefix << "level count" << chunk.levelCount << "out of range for a chunk of" << size << "bytes";
+        return nullptr;
+    }
+
+    const auto* const levels = reinterpret_cast<const Implementation::ImageDataChunkLevel*>(&chunk + 1);
+    for(std::size_t i = 0; i != chunk.levelCount; ++i) {
+        const Implementation::ImageDataChunkLevel& level = levels[i];
+        if(level.dataOffset < levelDataOffset || level.dataOffset % Implementation::DataChunkAlignment || level.dataOffset > size || level.dataSize > size - level.dataOffset) {
+            Error{} << prefix << "data of level" << i << "out of range for a chunk of" << size << "bytes";
+            return nullptr;
+        }
+
+        const auto imageSize = Math::Vector<dimensions, Int>::pad(Vector3i::from(level.size));
+        if((imageSize < Math::Vector<dimensions, Int>{0}).any() || level.rowLength < 0 || level.imageHeight < 0 || (Vector3i::from(level.skip) < Vector3i{0}).any()) {
+            Error{} << prefix << "invalid size or storage of level" << i;
+            return nullptr;
+        }
+
+        if(level.compressed) {
+            if(!isCompressedPixelFormatImplementationSpecific(CompressedPixelFormat(level.format)) && (level.format == 0 || level.format > CompressedPixelFormatCount)) {
+                Error{} << prefix << "invalid format" << reinterpret_cast<void*>(level.format) << "of level" << i;
+                return nullptr;
+            }
+            if((Vector3i::from(level.compressedBlockSize) < Vector3i{0}).any() || level.compressedBlockDataSize < 0) {
+                Error{} << prefix << "invalid size or storage of level" << i;
+                return nullptr;
+            }
+
+        } else {
+            const bool implementationSpecific = isPixelFormatImplementationSpecific(PixelFormat(level.format));
+            if(!implementationSpecific && (level.format == 0 || level.format > PixelFormatCount)) {
+                Error{} << prefix << "invalid format" << reinterpret_cast<void*>(level.format) << "of level" << i;
+                return nullptr;
+            }
+            if(!level.pixelSize || level.pixelSize > 256 || (!implementationSpecific && level.pixelSize != pixelSize(PixelFormat(level.format)))) {
+                Error{} << prefix << "invalid pixel size" << level.pixelSize << "of level" << i;
+                return nullptr;
+            }
+            if(level.alignment != 1 && level.alignment != 2 && level.alignment != 4 && level.alignment != 8) {
+                Error{} << prefix << "invalid size or storage of level" << i;
+                return nullptr;
+            }
+
+            /* Same check as done in the ImageData constructor, which would
+               otherwise assert */
+            const std::size_t expectedDataSize = Magnum::Implementation::imageDataSize(BasicImageView<dimensions>{
+                PixelStorage{}
+                    .setAlignment(level.alignment)
+                    .setRowLength(level.rowLength)
+                    .setImageHeight(level.imageHeight)
+                    .setSkip(Vector3i::from(level.skip)),
+                PixelFormat(level.format), level.formatExtra, level.pixelSize,
+                imageSize});
+            if(expectedDataSize > level.dataSize) {
+                Error{} << prefix << "expected at least" << expectedDataSize << "bytes of data for level" << i << "but got" << level.dataSize;
+                return nullptr;
+            }
+        }
+    }
+
+    return &chunk;
+}
+
+}
+
+template<UnsignedInt dimensions> std::size_t ImageData<dimensions>::serializedSize() const {
+    return serializedSize(Containers::arrayView(this, 1));
+}
+
+template<UnsignedInt dimensions> void ImageData<dimensions>::serializeInto(const Containers::ArrayView<char> destination) const {
+    serializeInto(Containers::arrayView(this, 1), destination);
+}
+
+template<UnsignedInt dimensions> Containers::Array<char> ImageData<dimensions>::serialize() const {
+    return serialize(Containers::arrayView(this, 1));
+}
+
+template<UnsignedInt dimensions> std::size_t ImageData<dimensions>::serializedSize(const Containers::ArrayView<const ImageData<dimensions>> levels) {
+    std::size_t size = serializedLevelDataOffset(levels.size());
+    for(const ImageData<dimensions>& level: levels)
+        size = Implementation::alignDataChunkOffset(size + level._data.size());
+    return size;
+}
+
+template<UnsignedInt dimensions> void ImageData<dimensions>::serializeInto(const Containers::ArrayView<const ImageData<dimensions>> levels, const Containers::ArrayView<char> destination) {
+    CORRADE_ASSERT(!levels.empty(),
+        "Trade::ImageData::serializeInto(): expected at least one level", );
+    const std::size_t size = serializedSize(levels);
+    CORRADE_ASSERT(destination.size() == size,
+        "Trade::ImageData::serializeInto(): expected a view of" << size << "bytes but got" << destination.size(), );
+    CORRADE_ASSERT(reinterpret_cast<std::uintptr_t>(destination.data()) % Implementation::DataChunkAlignment == 0,
+        "Trade::ImageData::serializeInto(): expected the view to be aligned to" << Implementation::DataChunkAlignment << "bytes", );
+
+    /* Zero-fill the header and the level list so the output is deterministic,
+       padding after each level data is cleared below */
+    const std::size_t levelDataOffset = serializedLevelDataOffset(levels.size());
+    std::memset(destination.data(), 0, levelDataOffset);
+
+    auto& chunk = *reinterpret_cast<Implementation::ImageDataChunk*>(destination.data());
+    Implementation::initializeDataChunkHeader(chunk.header, ImageDataChunkTypes[dimensions - 1], size);
+    chunk.levelCount = levels.size();
+
+    const auto serializedLevels = Containers::arrayCast<Implementation::ImageDataChunkLevel>(destination.slice(sizeof(Implementation::ImageDataChunk), levelDataOffset));
+    std::size_t offset = levelDataOffset;
+    for(std::size_t i = 0; i != levels.size(); ++i) {
+        const ImageData<dimensions>& image = levels[i];
+        Implementation::ImageDataChunkLevel& level = serializedLevels[i];
+
+        const Vector3i imageSize = Vector3i::pad(image._size);
+        const PixelStorage& storage = image._compressed ?
+            static_cast<const PixelStorage&>(image._compressedStorage) : image._storage;
+        for(std::size_t j = 0; j != 3; ++j) {
+            level.size[j] = imageSize[j];
+            level.skip[j] = storage.skip()[j];
+        }
+        level.rowLength = storage.rowLength();
+        level.imageHeight = storage.imageHeight();
+        if(image._compressed) {
+            level.format = UnsignedInt(image._compressedFormat);
+            level.compressed = 1;
+            for(std::size_t j = 0; j != 3; ++j)
+                level.compressedBlockSize[j] = image._compressedStorage.compressedBlockSize()[j];
+            level.compressedBlockDataSize = image._compressedStorage.compressedBlockDataSize();
+        } else {
+            level.format = UnsignedInt(image._format);
+            level.formatExtra = image._formatExtra;
+            level.pixelSize = image._pixelSize;
+            level.alignment = image._storage.alignment();
+        }
+
+        /* The data are copied including any padding or skip described by the
+           storage, so the storage parameters stay valid */
+        level.dataOffset = offset;
+        level.dataSize = image._data.size();
+        Utility::copy(image._data, destination.slice(offset, offset + image._data.size()));
+        const std::size_t nextOffset = Implementation::alignDataChunkOffset(offset + image._data.size());
+        std::memset(destination.data() + offset + image._data.size(), 0, nextOffset - offset - image._data.size());
+        offset = nextOffset;
+    }
+}
+
+template<UnsignedInt dimensions> Containers::Array<char> ImageData<dimensions>::serialize(const Containers::ArrayView<const ImageData<dimensions>> levels) {
+    CORRADE_ASSERT(!levels.empty(),
+        "Trade::ImageData::serialize(): expected at least one level", {});
+    Containers::Array<char> out{Containers::NoInit, serializedSize(levels)};
+    serializeInto(levels, out);
+    return out;
+}
+
+template<UnsignedInt dimensions> UnsignedInt ImageData<dimensions>::deserializeLevelCount(const Containers::ArrayView<const void> data) {
+    const Implementation::ImageDataChunk* const chunk = checkImageDataChunk<dimensions>("Trade::ImageData::deserializeLevelCount():", data);
+    return chunk ? chunk->levelCount : 0;
+}
+
+template<UnsignedInt dimensions> Containers::Optional<ImageData<dimensions>> ImageData<dimensions>::deserialize(const Containers::ArrayView<const void> data, const UnsignedInt level) {
+    const Implementation::ImageDataChunk* const chunk = checkImageDataChunk<dimensions>("Trade::ImageData::deserialize():", data);
+    if(!chunk) return {};
+
+    if(level >= chunk->levelCount) {
+        Error{} << "Trade::ImageData::deserialize(): level" << level << "out of range for" << chunk->levelCount << "levels";
+        return {};
+    }
+
+    const Implementation::ImageDataChunkLevel& serialized = reinterpret_cast<const Implementation::ImageDataChunkLevel*>(chunk + 1)[level];
+    const auto imageSize = Math::Vector<dimensions, Int>::pad(Vector3i::from(serialized.size));
+    const Containers::ArrayView<const void> levelData{static_cast<const char*>(data.data()) + serialized.dataOffset, std::size_t(serialized.dataSize)};
+    if(serialized.compressed) return ImageData<dimensions>{
+        CompressedPixelStorage{}
+            .setRowLength(serialized.rowLength)
+            .setImageHeight(serialized.imageHeight)
+            .setSkip(Vector3i::from(serialized.skip))
+            .setCompressedBlockSize(Vector3i::from(serialized.compressedBlockSize))
+            .setCompressedBlockDataSize(serialized.compressedBlockDataSize),
+        CompressedPixelFormat(serialized.format), imageSize,
+        DataFlags{}, levelData};
+
+    return ImageData<dimensions>{
+        PixelStorage{}
+            .setAlignment(serialized.alignment)
+            .setRowLength(serialized.rowLength)
+            .setImageHeight(serialized.imageHeight)
+            .setSkip(Vector3i::from(serialized.skip)),
+        PixelFormat(serialized.format), serialized.formatExtra,
+        serialized.pixelSize, imageSize, DataFlags{}, levelData};
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_TRADE_EXPORT ImageData<1>;
 template class MAGNUM_TRADE_EXPORT ImageData<2>;
@@ -100,6 +100,29 @@ first. The following snippet flips the R and B channels of the imported image:
 
 @snippet MagnumTrade.cpp ImageData-usage-mutable
 
+@section Trade-ImageData-serialization Binary serialization
+
+Similarly to @ref Trade-MeshData-serialization "MeshData", an image can be
+written out as a binary blob using @ref serialize() const and turned back into
+an @ref ImageData using @ref deserialize() without copying or decoding any
+data --- the returned instance references the data passed to it, which makes
+it suitable as a cache format that's memory-mapped and uploaded directly to
+the GPU. Both compressed and uncompressed images are supported, including
+implementation-specific formats and all @ref PixelStorage /
+@ref CompressedPixelStorage parameters. A whole mip chain can be put into a
+single blob using @ref serialize(Containers::ArrayView<const ImageData<dimensions>>);
+array textures are represented as images with one dimension more, same as
+elsewhere in Magnum:
+
+@snippet MagnumTrade.cpp ImageData-serialization
+
+Data of each level are aligned to 8 bytes inside the blob, the blob is
+versioned and @ref deserialize() rejects blobs with a different version or
+byte order. The @ref importerState() is not serialized. The
+@ref MagnumImporter "MagnumImporter" and
+@ref MagnumImageConverter "MagnumImageConverter" plugins expose this format
+through the @ref AbstractImporter and @ref AbstractImageConverter interfaces.
+
 @see @ref ImageData1D, @ref ImageData2D, @ref ImageData3D,
     @ref Image-pixel-views
 */
@@ -670,6 +693,98 @@ template<UnsignedInt dimensions> class ImageData {
          */
         const void* importerState() const { return _importerState; }
 
+        /**
+         * @brief Size of the serialized representation
+         * @m_since_latest
+         *
+         * Size of the blob produced by @ref serialize() const, always a
+         * multiple of 8 bytes. See @ref Trade-ImageData-serialization for more
+         * information.
+         */
+        std::size_t serializedSize() const;
+
+        /**
+         * @brief Serialize into a pre-allocated view
+         * @m_since_latest
+         *
+         * Like @ref serialize() const, but puts the result into
+         * @p destination instead of allocating a new array. Expects that
+         * @p destination is aligned to 8 bytes and exactly
+         * @ref serializedSize() const bytes large.
+         */
+        void serializeInto(Containers::ArrayView<char> destination) const;
+
+        /**
+         * @brief Serialize to a binary blob
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref serialize(Containers::ArrayView<const ImageData<dimensions>>)
+         * with just this image. See @ref Trade-ImageData-serialization for
+         * more information.
+         */
+        Containers::Array<char> serialize() const;
+
+        /**
+         * @brief Size of a serialized multi-level image
+         * @m_since_latest
+         *
+         * Size of the blob produced by @ref serialize(Containers::ArrayView<const ImageData<dimensions>>),
+         * always a multiple of 8 bytes.
+         */
+        static std::size_t serializedSize(Containers::ArrayView<const ImageData<dimensions>> levels);
+
+        /**
+         * @brief Serialize a multi-level image into a pre-allocated view
+         * @m_since_latest
+         *
+         * Like @ref serialize(Containers::ArrayView<const ImageData<dimensions>>),
+         * but puts the result into @p destination instead of allocating a
+         * new array. Expects that @p destination is aligned to 8 bytes and
+         * exactly @ref serializedSize(Containers::ArrayView<const ImageData<dimensions>>)
+         * bytes large.
+         */
+        static void serializeInto(Containers::ArrayView<const ImageData<dimensions>> levels, Containers::ArrayView<char> destination);
+
+        /**
+         * @brief Serialize a multi-level image to a binary blob
+         * @m_since_latest
+         *
+         * Writes out format, storage parameters and data of all @p levels
+         * into a single blob that can be turned back into @ref ImageData
+         * instances using @ref deserialize(). The levels don't need to have
+         * the same format or be all compressed or all uncompressed, expects
+         * that there's at least one level. See
+         * @ref Trade-ImageData-serialization for more information.
+         */
+        static Containers::Array<char> serialize(Containers::ArrayView<const ImageData<dimensions>> levels);
+
+        /**
+         * @brief Level count of a serialized image
+         * @m_since_latest
+         *
+         * Validates the same way as @ref deserialize() and returns count of
+         * levels in the blob. If the blob is invalid, prints a message to
+         * error output and returns @cpp 0 @ce.
+         */
+        static UnsignedInt deserializeLevelCount(Containers::ArrayView<const void> data);
+
+        /**
+         * @brief Deserialize from a binary blob
+         * @m_since_latest
+         *
+         * Expects that @p data is aligned to 8 bytes and contains a blob
+         * produced by @ref serialize() of an image with the same dimension
+         * count, possibly followed by other data. The returned instance
+         * doesn't own the data and references @p data directly, so it has to
+         * stay in scope for as long as the instance is used; @ref dataFlags()
+         * are empty. If the blob is invalid, truncated, was produced on a
+         * machine with a different endianness or @p level is out of range,
+         * prints a message to error output and returns
+         * @ref Corrade::Containers::NullOpt. See
+         * @ref Trade-ImageData-serialization for more information.
+         */
+        static Containers::Optional<ImageData<dimensions>> deserialize(Containers::ArrayView<const void> data, UnsignedInt level = 0);
+
     private:
         /* For custom deleter checks. Not done in the constructors here because
            the restriction is pointless when used outside of plugin
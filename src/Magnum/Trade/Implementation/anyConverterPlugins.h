@@ -0,0 +1,90 @@
+#ifndef Magnum_Trade_Implementation_anyConverterPlugins_h
+#define Magnum_Trade_Implementation_anyConverterPlugins_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <Corrade/Utility/String.h>
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/* Plugin detection shared by AnyImageConverter, AnySceneConverter and the
+   command-line tools.
+   The Any* plugins load and instantiate the concrete plugin from the plugin
+   manager on every conversion, which isn't thread-safe, so the tools use
+   these to resolve the concrete plugin upfront when converting on multiple
+   threads. An empty string is returned if the format can't be determined. */
+
+inline std::string anyImageConverterPlugin(const std::string& filename) {
+    /** @todo lowercase only the extension, once Directory::split() is done */
+    const std::string normalized = Utility::String::lowercase(filename);
+
+    if(Utility::String::endsWith(normalized, ".bmp"))
+        return "BmpImageConverter";
+    if(Utility::String::endsWith(normalized, ".basis"))
+        return "BasisImageConverter";
+    if(Utility::String::endsWith(normalized, ".blob"))
+        return "MagnumImageConverter";
+    if(Utility::String::endsWith(normalized, ".exr"))
+        return "OpenExrImageConverter";
+    if(Utility::String::endsWith(normalized, ".hdr"))
+        return "HdrImageConverter";
+    if(Utility::String::endsWith(normalized, ".jpg") ||
+       Utility::String::endsWith(normalized, ".jpeg") ||
+       Utility::String::endsWith(normalized, ".jpe"))
+        return "JpegImageConverter";
+    if(Utility::String::endsWith(normalized, ".png"))
+        return "PngImageConverter";
+    if(Utility::String::endsWith(normalized, ".tga") ||
+       Utility::String::endsWith(normalized, ".vda") ||
+       Utility::String::endsWith(normalized, ".icb") ||
+       Utility::String::endsWith(normalized, ".vst"))
+        return "TgaImageConverter";
+    return {};
+}
+
+inline std::string anyCompressedImageConverterPlugin(const std::string& filename) {
+    /** @todo lowercase only the extension, once Directory::split() is done */
+    const std::string normalized = Utility::String::lowercase(filename);
+
+    if(Utility::String::endsWith(normalized, ".blob"))
+        return "MagnumImageConverter";
+    return {};
+}
+
+inline std::string anySceneConverterPlugin(const std::string& filename) {
+    /** @todo lowercase only the extension, once Directory::split() is done */
+    const std::string normalized = Utility::String::lowercase(filename);
+
+    if(Utility::String::endsWith(normalized, ".blob"))
+        return "MagnumSceneConverter";
+    if(Utility::String::endsWith(normalized, ".ply"))
+        return "StanfordSceneConverter";
+    return {};
+}
+
+}}}
+
+#endif
@@ -0,0 +1,293 @@
+#ifndef Magnum_Trade_Implementation_importCache_h
+#define Magnum_Trade_Implementation_importCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <vector>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Configuration.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Sha1.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/Data.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/* Import cache shared by the AnyImageImporter and AnySceneImporter plugins.
+   Each cache entry is a file named after a SHA-1 of the input data, the
+   concrete plugin name and a user-provided key, containing serialized meshes
+   and images as a sequence of data chunks. Entries are tracked in an index
+   file with a use counter, which is used to remove least recently used
+   entries once the cache grows over its size limit. Used only in plugins
+   where we don't want it to be exported. */
+namespace {
+
+struct ImportCache {
+    /* Only one of these is populated at a time, view points to it */
+    Containers::Array<char> data;
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Array<const char, Utility::Directory::MapDeleter> mapped;
+    #endif
+    Containers::ArrayView<const char> view;
+
+    /* Views on chunks of particular types, all validated on open */
+    Containers::Array<Containers::ArrayView<const char>> meshes;
+    Containers::Array<Containers::ArrayView<const char>> images1D;
+    Containers::Array<Containers::ArrayView<const char>> images2D;
+    Containers::Array<Containers::ArrayView<const char>> images3D;
+};
+
+/* What to put into the cache */
+enum: UnsignedInt {
+    ImportCacheMeshes = 1 << 0,
+    ImportCacheImages1D = 1 << 1,
+    ImportCacheImages2D = 1 << 2,
+    ImportCacheImages3D = 1 << 3
+};
+
+std::string importCacheKey(const Containers::ArrayView<const char> data, const std::string& plugin, const std::string& key) {
+    Utility::Sha1 sha1;
+    /* The separators are there so "ab" + "c" doesn't hash the same as
+       "a" + "bc" */
+    sha1 << data << std::string{'\0'} << plugin << std::string{'\0'} << key;
+    return sha1.digest().hexString();
+}
+
+/* Sorts chunks in cache->view into particular arrays. Returns false if the
+   data are invalid, which can happen for example if the entry was written by
+   a different Magnum version. Doesn't print anything in that case, as it's
+   not an error for the caller. */
+bool importCacheParse(ImportCache& cache) {
+    Error silenceError{nullptr};
+    for(std::size_t offset = 0; offset != cache.view.size(); ) {
+        const DataChunkHeader* const header = dataChunkHeaderDeserialize(cache.view.suffix(offset));
+        if(!header) return false;
+
+        const Containers::ArrayView<const char> chunk = cache.view.slice(offset, offset + header->size);
+        switch(header->type) {
+            case DataChunkType::Mesh:
+                if(!MeshData::deserialize(chunk)) return false;
+                arrayAppend(cache.meshes, chunk);
+                break;
+            case DataChunkType::Image1D:
+                if(!ImageData1D::deserializeLevelCount(chunk)) return false;
+                arrayAppend(cache.images1D, chunk);
+                break;
+            case DataChunkType::Image2D:
+                if(!ImageData2D::deserializeLevelCount(chunk)) return false;
+                arrayAppend(cache.images2D, chunk);
+                break;
+            case DataChunkType::Image3D:
+                if(!ImageData3D::deserializeLevelCount(chunk)) return false;
+                arrayAppend(cache.images3D, chunk);
+                break;
+            default: return false;
+        }
+
+        offset += header->size;
+    }
+
+    return true;
+}
+
+/* Deserializes a cached mesh and copies its data into owned arrays. The
+   deserialized instance would reference the cache, which goes away on
+   close(), and couldn't be modified in place, unlike a mesh returned by the
+   concrete plugin. The attributes are offset-only, so they can be reused
+   as-is. */
+Containers::Optional<MeshData> importCacheMesh(const Containers::ArrayView<const char> chunk) {
+    Containers::Optional<MeshData> mesh = MeshData::deserialize(chunk);
+    /* The chunk was validated on open */
+    CORRADE_INTERNAL_ASSERT(mesh);
+
+    Containers::Array<char> indexData{Containers::NoInit, mesh->indexData().size()};
+    Utility::copy(mesh->indexData(), indexData);
+    MeshIndexData indices;
+    if(mesh->isIndexed()) {
+        const std::size_t indexOffset = mesh->indexOffset();
+        indices = MeshIndexData{mesh->indexType(), indexData.slice(indexOffset, indexOffset + mesh->indexCount()*meshIndexTypeSize(mesh->indexType()))};
+    }
+
+    Containers::Array<char> vertexData{Containers::NoInit, mesh->vertexData().size()};
+    Utility::copy(mesh->vertexData(), vertexData);
+
+    const UnsignedInt vertexCount = mesh->vertexCount();
+    return MeshData{mesh->primitive(),
+        std::move(indexData), indices,
+        std::move(vertexData), mesh->releaseAttributeData(), vertexCount};
+}
+
+/* Deserializes a cached image level and copies its data into an owned
+   array, for the same reasons as importCacheMesh() */
+template<UnsignedInt dimensions> Containers::Optional<ImageData<dimensions>> importCacheImage(const Containers::ArrayView<const char> chunk, const UnsignedInt level) {
+    Containers::Optional<ImageData<dimensions>> image = ImageData<dimensions>::deserialize(chunk, level);
+    if(!image) return {};
+
+    Containers::Array<char> data{Containers::NoInit, image->data().size()};
+    Utility::copy(image->data(), data);
+    if(image->isCompressed())
+        return ImageData<dimensions>{image->compressedStorage(), image->compressedFormat(), image->size(), std::move(data)};
+    return ImageData<dimensions>{image->storage(), image->format(), image->formatExtra(), image->pixelSize(), image->size(), std::move(data)};
+}
+
+/* Marks given entry as used, inserts it into the index if it's not there
+   yet and removes least recently used entries until the total size fits into
+   the limit. The entry itself is never removed. */
+void importCacheUse(const std::string& directory, const std::string& key, const UnsignedLong size, const UnsignedLong maxSize) {
+    Utility::Configuration index{Utility::Directory::join(directory, "index.conf")};
+    const UnsignedLong counter = index.value<UnsignedLong>("counter") + 1;
+    index.setValue("counter", counter);
+
+    std::vector<Utility::ConfigurationGroup*> entries = index.groups("entry");
+    auto found = std::find_if(entries.begin(), entries.end(), [&](Utility::ConfigurationGroup* entry) {
+        return entry->value("key") == key;
+    });
+    Utility::ConfigurationGroup* entry;
+    if(found == entries.end()) {
+        entry = index.addGroup("entry");
+        entry->setValue("key", key);
+        entries.push_back(entry);
+    } else entry = *found;
+    entry->setValue("size", size);
+    entry->setValue("used", counter);
+
+    /* Remove least recently used entries until the rest fits */
+    UnsignedLong totalSize = 0;
+    for(Utility::ConfigurationGroup* e: entries)
+        totalSize += e->value<UnsignedLong>("size");
+    std::sort(entries.begin(), entries.end(), [](Utility::ConfigurationGroup* a, Utility::ConfigurationGroup* b) {
+        return a->value<UnsignedLong>("used") < b->value<UnsignedLong>("used");
+    });
+    for(Utility::ConfigurationGroup* e: entries) {
+        if(totalSize <= maxSize) break;
+        if(e == entry) continue;
+
+        totalSize -= e->value<UnsignedLong>("size");
+        Utility::Directory::rm(Utility::Directory::join(directory, e->value("key") + ".blob"));
+        index.removeGroup(e);
+    }
+
+    index.save();
+}
+
+/* Opens a cache entry. Returns false if it doesn't exist or is invalid. */
+bool importCacheOpen(ImportCache& cache, const std::string& directory, const std::string& key, const UnsignedLong maxSize) {
+    const std::string filename = Utility::Directory::join(directory, key + ".blob");
+    if(!Utility::Directory::exists(filename)) return false;
+
+    {
+        Error silenceError{nullptr};
+        #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+        cache.mapped = Utility::Directory::mapRead(filename);
+        cache.view = cache.mapped;
+        #else
+        cache.data = Utility::Directory::read(filename);
+        cache.view = cache.data;
+        #endif
+    }
+
+    if(!importCacheParse(cache)) return false;
+
+    importCacheUse(directory, key, cache.view.size(), maxSize);
+    return true;
+}
+
+/* Imports all meshes and images (or a subset of them, based on contents)
+   from the importer, serializes them and writes them to a cache entry.
+   Returns false and doesn't write anything if any import fails or a mesh has
+   multiple levels, which the cache can't represent. On success the cache
+   contents are populated from the serialized data. */
+bool importCacheStore(ImportCache& cache, AbstractImporter& importer, const UnsignedInt contents, const std::string& directory, const std::string& key, const UnsignedLong maxSize) {
+    Containers::Array<Containers::Array<char>> chunks;
+
+    if(contents & ImportCacheMeshes) for(UnsignedInt i = 0; i != importer.meshCount(); ++i) {
+        if(importer.meshLevelCount(i) != 1) return false;
+        Containers::Optional<MeshData> mesh = importer.mesh(i);
+        if(!mesh) return false;
+        arrayAppend(chunks, Containers::InPlaceInit, mesh->serialize());
+    }
+
+    if(contents & ImportCacheImages1D) for(UnsignedInt i = 0; i != importer.image1DCount(); ++i) {
+        Containers::Array<ImageData1D> levels;
+        for(UnsignedInt j = 0, levelCount = importer.image1DLevelCount(i); j != levelCount; ++j) {
+            Containers::Optional<ImageData1D> image = importer.image1D(i, j);
+            if(!image) return false;
+            arrayAppend(levels, Containers::InPlaceInit, std::move(*image));
+        }
+        arrayAppend(chunks, Containers::InPlaceInit, ImageData1D::serialize(levels));
+    }
+
+    if(contents & ImportCacheImages2D) for(UnsignedInt i = 0; i != importer.image2DCount(); ++i) {
+        Containers::Array<ImageData2D> levels;
+        for(UnsignedInt j = 0, levelCount = importer.image2DLevelCount(i); j != levelCount; ++j) {
+            Containers::Optional<ImageData2D> image = importer.image2D(i, j);
+            if(!image) return false;
+            arrayAppend(levels, Containers::InPlaceInit, std::move(*image));
+        }
+        arrayAppend(chunks, Containers::InPlaceInit, ImageData2D::serialize(levels));
+    }
+
+    if(contents & ImportCacheImages3D) for(UnsignedInt i = 0; i != importer.image3DCount(); ++i) {
+        Containers::Array<ImageData3D> levels;
+        for(UnsignedInt j = 0, levelCount = importer.image3DLevelCount(i); j != levelCount; ++j) {
+            Containers::Optional<ImageData3D> image = importer.image3D(i, j);
+            if(!image) return false;
+            arrayAppend(levels, Containers::InPlaceInit, std::move(*image));
+        }
+        arrayAppend(chunks, Containers::InPlaceInit, ImageData3D::serialize(levels));
+    }
+
+    /* All chunks have a size that's a multiple of 8, so concatenating them
+       keeps all of them aligned */
+    std::size_t size = 0;
+    for(const Containers::Array<char>& chunk: chunks) size += chunk.size();
+    cache.data = Containers::Array<char>{Containers::NoInit, size};
+    for(std::size_t i = 0, offset = 0; i != chunks.size(); ++i) {
+        Utility::copy(chunks[i], cache.data.slice(offset, offset + chunks[i].size()));
+        offset += chunks[i].size();
+    }
+    cache.view = cache.data;
+    CORRADE_INTERNAL_ASSERT_OUTPUT(importCacheParse(cache));
+
+    /* Failing to write the cache is not fatal, the data are served from
+       memory in that case */
+    if(Utility::Directory::mkpath(directory) && Utility::Directory::write(Utility::Directory::join(directory, key + ".blob"), cache.view))
+        importCacheUse(directory, key, cache.view.size(), maxSize);
+
+    return true;
+}
+
+}
+
+}}}
+
+#endif
@@ -0,0 +1,182 @@
+#ifndef Magnum_Trade_Implementation_serialization_h
+#define Magnum_Trade_Implementation_serialization_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <string>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Data.h"
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+static_assert(sizeof(DataChunkHeader) == 24, "improper size of DataChunkHeader");
+
+constexpr char DataChunkMagic[]{'B', 'L', 'O', 'B'};
+constexpr UnsignedShort DataChunkVersion = 0;
+constexpr UnsignedShort DataChunkEndianness = 0x1234;
+/* Alignment of the chunk start and of all data sections inside it, enough for
+   any vertex / pixel format including doubles */
+constexpr std::size_t DataChunkAlignment = 8;
+
+inline std::size_t alignDataChunkOffset(const std::size_t offset) {
+    return (offset + DataChunkAlignment - 1)/DataChunkAlignment*DataChunkAlignment;
+}
+
+inline void initializeDataChunkHeader(DataChunkHeader& header, const DataChunkType type, const std::size_t size) {
+    std::memcpy(header.magic, DataChunkMagic, 4);
+    header.version = DataChunkVersion;
+    header.endianness = DataChunkEndianness;
+    header.type = type;
+    header.reserved = 0;
+    header.size = size;
+}
+
+/* Checks that the data start with a valid chunk header that fits into the
+   data and returns a pointer to it, printing a message prefixed with `prefix`
+   and returning nullptr otherwise. The data are expected to be aligned so the
+   contents can be referenced without copying. The header is stored in the
+   native byte order, so the endianness marker is always read correctly if it
+   matches. */
+inline const DataChunkHeader* checkDataChunkHeader(const char* const prefix, const Containers::ArrayView<const void> data) {
+    if(reinterpret_cast<std::uintptr_t>(data.data()) % DataChunkAlignment) {
+        Error{} << prefix << "data not aligned to" << DataChunkAlignment << "bytes";
+        return nullptr;
+    }
+    if(data.size() < sizeof(DataChunkHeader)) {
+        Error{} << prefix << "expected at least" << sizeof(DataChunkHeader) << "bytes for a header but got" << data.size();
+        return nullptr;
+    }
+
+    const auto& header = *static_cast<const DataChunkHeader*>(data.data());
+    if(std::memcmp(header.magic, DataChunkMagic, 4) != 0) {
+        Error{} << prefix << "invalid signature" << std::string{header.magic, 4};
+        return nullptr;
+    }
+    if(header.endianness != DataChunkEndianness) {
+        Error{} << prefix << "data have a different endianness than the host";
+        return nullptr;
+    }
+    if(header.version != DataChunkVersion) {
+        Error{} << prefix << "unsupported version" << header.version << Debug::nospace << ", expected" << DataChunkVersion;
+        return nullptr;
+    }
+    if(header.size < sizeof(DataChunkHeader) || header.size > data.size()) {
+        Error{} << prefix << "chunk size" << header.size << "out of range for" << data.size() << "bytes of data";
+        return nullptr;
+    }
+
+    return &header;
+}
+
+/* Like above, but additionally checks the chunk type */
+inline const DataChunkHeader* checkDataChunkHeader(const char* const prefix, const Containers::ArrayView<const void> data, const DataChunkType type, const std::size_t minSize) {
+    const DataChunkHeader* const header = checkDataChunkHeader(prefix, data);
+    if(!header) return nullptr;
+
+    if(header->type != type) {
+        Error{} << prefix << "expected a chunk of type" << type << "but got" << header->type;
+        return nullptr;
+    }
+    if(header->size < minSize) {
+        Error{} << prefix << "chunk size" << header->size << "out of range for" << data.size() << "bytes of data";
+        return nullptr;
+    }
+
+    return header;
+}
+
+/* Serialized MeshData. Enums are stored as their underlying types to keep
+   this header independent of the data classes. Followed by attributeCount
+   MeshDataChunkAttribute entries, then by index data and vertex data, both
+   aligned to DataChunkAlignment. */
+struct MeshDataChunk {
+    DataChunkHeader header;
+    UnsignedInt indexCount;
+    UnsignedInt vertexCount;
+    UnsignedInt primitive;
+    UnsignedInt attributeCount;
+    UnsignedByte indexType;
+    UnsignedByte padding[7];
+    UnsignedLong indexOffset;
+    UnsignedLong indexDataSize;
+    UnsignedLong vertexDataSize;
+};
+
+static_assert(sizeof(MeshDataChunk) == 72, "improper size of MeshDataChunk");
+
+struct MeshDataChunkAttribute {
+    UnsignedLong offset;
+    UnsignedInt format;
+    UnsignedShort name;
+    Short stride;
+    UnsignedShort arraySize;
+    UnsignedShort padding[3];
+};
+
+static_assert(sizeof(MeshDataChunkAttribute) == 24, "improper size of MeshDataChunkAttribute");
+
+/* Serialized ImageData, chunk type is DataChunkType::Image1D, Image2D or
+   Image3D based on dimension count. Followed by levelCount ImageDataChunkLevel
+   entries, then by data of all levels, each aligned to DataChunkAlignment. */
+struct ImageDataChunk {
+    DataChunkHeader header;
+    UnsignedInt levelCount;
+    UnsignedInt padding;
+};
+
+static_assert(sizeof(ImageDataChunk) == 32, "improper size of ImageDataChunk");
+
+/* Format is either a PixelFormat or a CompressedPixelFormat based on the
+   compressed field, formatExtra and pixelSize are used only by uncompressed
+   images and the compressed block properties only by compressed images.
+   Sizes and skip are always three-component, with the unused ones zero.
+   Data offset is relative to the chunk start. */
+struct ImageDataChunkLevel {
+    UnsignedInt format;
+    UnsignedInt formatExtra;
+    UnsignedInt pixelSize;
+    UnsignedByte compressed;
+    UnsignedByte padding[3];
+    Int size[3];
+    Int alignment;
+    Int rowLength;
+    Int imageHeight;
+    Int skip[3];
+    Int compressedBlockSize[3];
+    Int compressedBlockDataSize;
+    UnsignedInt padding2;
+    UnsignedLong dataOffset;
+    UnsignedLong dataSize;
+};
+
+static_assert(sizeof(ImageDataChunkLevel) == 88, "improper size of ImageDataChunkLevel");
+
+}}}
+
+#endif
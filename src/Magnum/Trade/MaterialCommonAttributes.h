@@ -0,0 +1,189 @@
+#ifndef Magnum_Trade_MaterialCommonAttributes_h
+#define Magnum_Trade_MaterialCommonAttributes_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::Trade::MaterialCommonAttributes
+ * @m_since_latest
+ */
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Trade/MaterialData.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Commonly used material attributes
+@m_since_latest
+
+Values of the most commonly used @ref PbrMetallicRoughnessMaterialData and
+@ref PhongMaterialData attributes of a single material layer, extracted at once
+with @ref MaterialData::bakeCommonAttributes(). Meant to be used by renderers
+that fill uniform buffers from many materials every frame, where querying each
+attribute separately would be unnecessarily slow.
+
+Attributes that aren't present are set to the same defaults as the
+corresponding accessors in @ref MaterialData, @ref PbrMetallicRoughnessMaterialData
+and @ref PhongMaterialData use. Textures that aren't present are set to
+@cpp 0xffffffffu @ce. Per-texture coordinate transformations, coordinate sets
+and swizzles other than for metalness and roughness are not included, query
+them from the material directly if needed.
+*/
+struct MaterialCommonAttributes {
+    /** @brief Base color, @ref MaterialAttribute::BaseColor */
+    Color4 baseColor{1.0f};
+
+    /**
+     * @brief Ambient color, @ref MaterialAttribute::AmbientColor
+     *
+     * If not present, the default is @cpp 0xffffffff_rgbaf @ce if the
+     * material has @ref MaterialAttribute::AmbientTexture and
+     * @cpp 0x000000ff_rgbaf @ce otherwise, same as
+     * @ref PhongMaterialData::ambientColor().
+     */
+    Color4 ambientColor{0.0f};
+
+    /** @brief Diffuse color, @ref MaterialAttribute::DiffuseColor */
+    Color4 diffuseColor{1.0f};
+
+    /** @brief Specular color, @ref MaterialAttribute::SpecularColor */
+    Color4 specularColor{1.0f, 0.0f};
+
+    /** @brief Emissive color, @ref MaterialAttribute::EmissiveColor */
+    Color3 emissiveColor{0.0f};
+
+    /**
+     * @brief Common texture coordinate transformation matrix
+     *
+     * @ref MaterialAttribute::TextureMatrix.
+     */
+    Matrix3 textureMatrix;
+
+    /** @brief Metalness factor, @ref MaterialAttribute::Metalness */
+    Float metalness{1.0f};
+
+    /** @brief Roughness factor, @ref MaterialAttribute::Roughness */
+    Float roughness{1.0f};
+
+    /** @brief Shininess, @ref MaterialAttribute::Shininess */
+    Float shininess{80.0f};
+
+    /** @brief Alpha mask, @ref MaterialAttribute::AlphaMask */
+    Float alphaMask{0.5f};
+
+    /**
+     * @brief Normal texture scale
+     *
+     * @ref MaterialAttribute::NormalTextureScale.
+     */
+    Float normalTextureScale{1.0f};
+
+    /**
+     * @brief Occlusion texture strength
+     *
+     * @ref MaterialAttribute::OcclusionTextureStrength.
+     */
+    Float occlusionTextureStrength{1.0f};
+
+    /** @brief Base color texture, @ref MaterialAttribute::BaseColorTexture */
+    UnsignedInt baseColorTexture{~UnsignedInt{}};
+
+    /**
+     * @brief Metalness texture
+     *
+     * @ref MaterialAttribute::NoneRoughnessMetallicTexture if present,
+     * @ref MaterialAttribute::MetalnessTexture otherwise.
+     */
+    UnsignedInt metalnessTexture{~UnsignedInt{}};
+
+    /**
+     * @brief Roughness texture
+     *
+     * @ref MaterialAttribute::NoneRoughnessMetallicTexture if present,
+     * @ref MaterialAttribute::RoughnessTexture otherwise.
+     */
+    UnsignedInt roughnessTexture{~UnsignedInt{}};
+
+    /** @brief Normal texture, @ref MaterialAttribute::NormalTexture */
+    UnsignedInt normalTexture{~UnsignedInt{}};
+
+    /** @brief Occlusion texture, @ref MaterialAttribute::OcclusionTexture */
+    UnsignedInt occlusionTexture{~UnsignedInt{}};
+
+    /** @brief Emissive texture, @ref MaterialAttribute::EmissiveTexture */
+    UnsignedInt emissiveTexture{~UnsignedInt{}};
+
+    /** @brief Ambient texture, @ref MaterialAttribute::AmbientTexture */
+    UnsignedInt ambientTexture{~UnsignedInt{}};
+
+    /** @brief Diffuse texture, @ref MaterialAttribute::DiffuseTexture */
+    UnsignedInt diffuseTexture{~UnsignedInt{}};
+
+    /** @brief Specular texture, @ref MaterialAttribute::SpecularTexture */
+    UnsignedInt specularTexture{~UnsignedInt{}};
+
+    /**
+     * @brief Common texture coordinate set
+     *
+     * @ref MaterialAttribute::TextureCoordinates.
+     */
+    UnsignedInt textureCoordinates{};
+
+    /**
+     * @brief Metalness texture swizzle
+     *
+     * @ref MaterialTextureSwizzle::B if
+     * @ref MaterialAttribute::NoneRoughnessMetallicTexture is present,
+     * @ref MaterialAttribute::MetalnessTextureSwizzle otherwise.
+     */
+    MaterialTextureSwizzle metalnessTextureSwizzle{MaterialTextureSwizzle::R};
+
+    /**
+     * @brief Roughness texture swizzle
+     *
+     * @ref MaterialTextureSwizzle::G if
+     * @ref MaterialAttribute::NoneRoughnessMetallicTexture is present,
+     * @ref MaterialAttribute::RoughnessTextureSwizzle otherwise.
+     */
+    MaterialTextureSwizzle roughnessTextureSwizzle{MaterialTextureSwizzle::R};
+
+    /**
+     * @brief Alpha mode
+     *
+     * Derived from @ref MaterialAttribute::AlphaBlend and
+     * @ref MaterialAttribute::AlphaMask the same way as
+     * @ref MaterialData::alphaMode().
+     */
+    MaterialAlphaMode alphaMode{MaterialAlphaMode::Opaque};
+
+    /** @brief Whether the material is double-sided */
+    bool doubleSided{};
+};
+
+}}
+
+#endif
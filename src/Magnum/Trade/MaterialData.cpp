@@ -30,9 +30,10 @@
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/GrowableArray.h>
 
-#include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Trade/Data.h"
+#include "Magnum/Trade/MaterialCommonAttributes.h"
 #include "Magnum/Trade/Implementation/arrayUtilities.h"
 
 namespace Magnum { namespace Trade {
@@ -61,6 +62,25 @@ constexpr struct {
     #undef _ct
     #undef _cnt
 };
+
+/* Indices into AttributeMap sorted by name, so a sorted layer can be matched
+   against all known attribute names in a single linear pass */
+struct SortedAttributeMap {
+    SortedAttributeMap() {
+        for(UnsignedByte i = 0; i != Containers::arraySize(AttributeMap); ++i)
+            ids[i] = i;
+        std::sort(ids, ids + Containers::arraySize(AttributeMap), [](UnsignedByte a, UnsignedByte b) {
+            return AttributeMap[a].name < AttributeMap[b].name;
+        });
+    }
+
+    UnsignedByte ids[Containers::arraySize(AttributeMap)];
+};
+
+const SortedAttributeMap& sortedAttributeMap() {
+    static const SortedAttributeMap map;
+    return map;
+}
 #endif
 
 }
@@ -243,6 +263,8 @@ MaterialData::MaterialData(const MaterialTypes types, Containers::Array<Material
 
         begin = end;
     }
+
+    buildAttributeLookup();
 }
 
 MaterialData::MaterialData(const MaterialTypes types, const std::initializer_list<MaterialAttributeData> attributeData, const std::initializer_list<UnsignedInt> layerData, const void* const importerState): MaterialData{types, Implementation::initializerListToArrayWithDefaultDeleter(attributeData), Implementation::initializerListToArrayWithDefaultDeleter(layerData), importerState} {}
@@ -274,6 +296,36 @@ MaterialData::MaterialData(const MaterialTypes types, DataFlags, const Container
         begin = end;
     }
     #endif
+
+    buildAttributeLookup();
+}
+
+void MaterialData::buildAttributeLookup() {
+    /* The IDs are stored in bytes, offset by one to have zero for attributes
+       that aren't present. If any layer is too large for that, the lookup
+       falls back to a binary search over the names. */
+    const UnsignedInt count = layerCount();
+    for(UnsignedInt layer = 0; layer != count; ++layer)
+        if(attributeCount(layer) >= 255) return;
+
+    constexpr UnsignedInt knownCount = Containers::arraySize(AttributeMap);
+    const UnsignedByte* const sorted = sortedAttributeMap().ids;
+    _attributeLookup = Containers::Array<UnsignedByte>{Containers::ValueInit, count*knownCount};
+    for(UnsignedInt layer = 0; layer != count; ++layer) {
+        const MaterialAttributeData* const attributes = _data.data() + layerOffset(layer);
+        const UnsignedInt size = attributeCount(layer);
+        UnsignedByte* const lookup = _attributeLookup.data() + layer*knownCount;
+
+        /* Both the layer and the known names are sorted, walk them together.
+           Names of custom attributes are skipped. */
+        for(UnsignedInt i = 0, j = 0; i != size && j != knownCount; ) {
+            const Containers::StringView name = attributes[i].name();
+            const Containers::StringView known = AttributeMap[sorted[j]].name;
+            if(name < known) ++i;
+            else if(known < name) ++j;
+            else lookup[sorted[j++]] = UnsignedByte(++i);
+        }
+    }
 }
 
 MaterialData::MaterialData(MaterialData&&) noexcept = default;
@@ -504,6 +556,14 @@ UnsignedInt MaterialData::attributeFor(const UnsignedInt layer, const Containers
     return found - begin;
 }
 
+UnsignedInt MaterialData::attributeFor(const UnsignedInt layer, const MaterialAttribute name) const {
+    /* Fallback for layers with too many attributes */
+    if(!_attributeLookup) return attributeFor(layer, attributeString(name));
+
+    const UnsignedByte id = _attributeLookup[layer*Containers::arraySize(AttributeMap) + UnsignedInt(name) - 1];
+    return id ? id - 1 : ~UnsignedInt{};
+}
+
 bool MaterialData::hasAttribute(const UnsignedInt layer, const Containers::StringView name) const {
     CORRADE_ASSERT(layer < layerCount(),
         "Trade::MaterialData::hasAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
@@ -511,9 +571,11 @@ bool MaterialData::hasAttribute(const UnsignedInt layer, const Containers::Strin
 }
 
 bool MaterialData::hasAttribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::hasAttribute(): invalid name" << name, {});
-    return hasAttribute(layer, string);
+    CORRADE_ASSERT(attributeString(name).data(),
+        "Trade::MaterialData::hasAttribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::hasAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    return attributeFor(layer, name) != ~UnsignedInt{};
 }
 
 bool MaterialData::hasAttribute(const Containers::StringView layer, const Containers::StringView name) const {
@@ -551,9 +613,14 @@ UnsignedInt MaterialData::attributeId(const UnsignedInt layer, const Containers:
 }
 
 UnsignedInt MaterialData::attributeId(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::attributeId(): invalid name" << name, {});
-    return attributeId(layer, string);
+    CORRADE_ASSERT(attributeString(name).data(),
+        "Trade::MaterialData::attributeId(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attributeId(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attributeId(): attribute" << attributeString(name) << "not found in layer" << layer, {});
+    return id;
 }
 
 UnsignedInt MaterialData::attributeId(const Containers::StringView layer, const Containers::StringView name) const {
@@ -625,9 +692,14 @@ MaterialAttributeType MaterialData::attributeType(const UnsignedInt layer, const
 }
 
 MaterialAttributeType MaterialData::attributeType(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::attributeType(): invalid name" << name, {});
-    return attributeType(layer, string);
+    CORRADE_ASSERT(attributeString(name).data(),
+        "Trade::MaterialData::attributeType(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attributeType(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attributeType(): attribute" << attributeString(name) << "not found in layer" << layer, {});
+    return _data[layerOffset(layer) + id]._data.type;
 }
 
 MaterialAttributeType MaterialData::attributeType(const Containers::StringView layer, const UnsignedInt id) const {
@@ -691,9 +763,14 @@ const void* MaterialData::attribute(const UnsignedInt layer, const Containers::S
 }
 
 const void* MaterialData::attribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::attribute(): invalid name" << name, {});
-    return attribute(layer, string);
+    CORRADE_ASSERT(attributeString(name).data(),
+        "Trade::MaterialData::attribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attribute(): attribute" << attributeString(name) << "not found in layer" << layer, {});
+    return _data[layerOffset(layer) + id].value();
 }
 
 const void* MaterialData::attribute(const Containers::StringView layer, const UnsignedInt id) const {
@@ -764,9 +841,13 @@ const void* MaterialData::tryAttribute(const UnsignedInt layer, const Containers
 }
 
 const void* MaterialData::tryAttribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::tryAttribute(): invalid name" << name, {});
-    return tryAttribute(layer, string);
+    CORRADE_ASSERT(attributeString(name).data(),
+        "Trade::MaterialData::tryAttribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::tryAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    if(id == ~UnsignedInt{}) return nullptr;
+    return _data[layerOffset(layer) + id].value();
 }
 #endif
 
@@ -824,11 +905,84 @@ Float MaterialData::alphaMask() const {
     return attributeOr(MaterialAttribute::AlphaMask, 0.5f);
 }
 
+MaterialCommonAttributes MaterialData::bakeCommonAttributes(const UnsignedInt layer) const {
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::bakeCommonAttributes(): index" << layer << "out of range for" << layerCount() << "layers", {});
+
+    const MaterialAttributeData* const attributes = _data.data() + layerOffset(layer);
+    const auto find = [&](const MaterialAttribute name) -> const MaterialAttributeData* {
+        const UnsignedInt id = attributeFor(layer, name);
+        return id == ~UnsignedInt{} ? nullptr : attributes + id;
+    };
+
+    MaterialCommonAttributes out;
+    #define _c(name, field)                                                 \
+        if(const MaterialAttributeData* const a = find(MaterialAttribute::name)) \
+            out.field = a->value<decltype(out.field)>();
+    _c(BaseColor, baseColor)
+    _c(AmbientColor, ambientColor)
+    _c(DiffuseColor, diffuseColor)
+    _c(SpecularColor, specularColor)
+    _c(EmissiveColor, emissiveColor)
+    _c(TextureMatrix, textureMatrix)
+    _c(Metalness, metalness)
+    _c(Roughness, roughness)
+    _c(Shininess, shininess)
+    _c(AlphaMask, alphaMask)
+    _c(NormalTextureScale, normalTextureScale)
+    _c(OcclusionTextureStrength, occlusionTextureStrength)
+    _c(BaseColorTexture, baseColorTexture)
+    _c(NormalTexture, normalTexture)
+    _c(OcclusionTexture, occlusionTexture)
+    _c(EmissiveTexture, emissiveTexture)
+    _c(AmbientTexture, ambientTexture)
+    _c(DiffuseTexture, diffuseTexture)
+    _c(SpecularTexture, specularTexture)
+    _c(TextureCoordinates, textureCoordinates)
+    _c(DoubleSided, doubleSided)
+    #undef _c
+
+    /* Packed metallic/roughness texture has a precedence over separate ones,
+       same as in PbrMetallicRoughnessMaterialData */
+    if(const MaterialAttributeData* const a = find(MaterialAttribute::NoneRoughnessMetallicTexture)) {
+        out.metalnessTexture = out.roughnessTexture = a->value<UnsignedInt>();
+        out.metalnessTextureSwizzle = MaterialTextureSwizzle::B;
+        out.roughnessTextureSwizzle = MaterialTextureSwizzle::G;
+    } else {
+        if(const MaterialAttributeData* const a = find(MaterialAttribute::MetalnessTexture)) {
+            out.metalnessTexture = a->value<UnsignedInt>();
+            if(const MaterialAttributeData* const swizzle = find(MaterialAttribute::MetalnessTextureSwizzle))
+                out.metalnessTextureSwizzle = swizzle->value<MaterialTextureSwizzle>();
+        }
+        if(const MaterialAttributeData* const a = find(MaterialAttribute::RoughnessTexture)) {
+            out.roughnessTexture = a->value<UnsignedInt>();
+            if(const MaterialAttributeData* const swizzle = find(MaterialAttribute::RoughnessTextureSwizzle))
+                out.roughnessTextureSwizzle = swizzle->value<MaterialTextureSwizzle>();
+        }
+    }
+
+    /* Same defaults as in PhongMaterialData::ambientColor() */
+    if(out.ambientTexture != ~UnsignedInt{} && !find(MaterialAttribute::AmbientColor))
+        out.ambientColor = Color4{1.0f};
+
+    /* Same logic as in alphaMode() */
+    const MaterialAttributeData* const alphaBlend = find(MaterialAttribute::AlphaBlend);
+    if(alphaBlend && alphaBlend->value<bool>())
+        out.alphaMode = MaterialAlphaMode::Blend;
+    else if(find(MaterialAttribute::AlphaMask))
+        out.alphaMode = MaterialAlphaMode::Mask;
+
+    return out;
+}
+
 Containers::Array<UnsignedInt> MaterialData::releaseLayerData() {
+    /* The lookup table is per-layer, so it's invalid after this */
+    _attributeLookup = nullptr;
     return std::move(_layerOffsets);
 }
 
 Containers::Array<MaterialAttributeData> MaterialData::releaseAttributeData() {
+    _attributeLookup = nullptr;
     return std::move(_data);
 }
 
@@ -1617,6 +1617,15 @@ half-float types. Conversely, @ref Magnum::Double "Double" types are currently
 not supported either as there isn't currently seen any need for extended
 precision.
 
+Lookup by a string name is a binary search over the sorted attributes of given
+layer. For lookup by a @ref MaterialAttribute, the constructor additionally
+builds a table mapping each known attribute to its ID in each layer, which
+makes all overloads taking a layer index and a @ref MaterialAttribute a
+constant-time operation. The table takes one byte per known attribute and
+layer; if a layer has more than 254 attributes, it's not built and the lookup
+falls back to the binary search. For extracting all commonly used
+attributes at once, see @ref bakeCommonAttributes().
+
 @m_class{m-block m-warning}
 
 @par Max representable data size
@@ -2527,6 +2536,22 @@ class MAGNUM_TRADE_EXPORT MaterialData {
          */
         Float alphaMask() const;
 
+        /**
+         * @brief Bake commonly used attributes
+         * @m_since_latest
+         *
+         * Extracts values of common @ref PbrMetallicRoughnessMaterialData and
+         * @ref PhongMaterialData attributes in given @p layer into a single
+         * structure, with defaults filled in for attributes that aren't
+         * present. Each attribute is looked up in constant time, so this is
+         * considerably faster than querying the attributes one by one by
+         * their string names. The @p layer is expected to be smaller than
+         * @ref layerCount() const. Include
+         * @ref Magnum/Trade/MaterialCommonAttributes.h to use the returned
+         * type.
+         */
+        MaterialCommonAttributes bakeCommonAttributes(UnsignedInt layer = 0) const;
+
         /**
          * @brief Release layer data storage
          *
@@ -2582,9 +2607,16 @@ class MAGNUM_TRADE_EXPORT MaterialData {
             return layer && _layerOffsets ? _layerOffsets[layer - 1] : 0;
         }
         UnsignedInt attributeFor(UnsignedInt layer, Containers::StringView name) const;
+        /* Expects the name to be valid */
+        UnsignedInt attributeFor(UnsignedInt layer, MaterialAttribute name) const;
+        void buildAttributeLookup();
 
         Containers::Array<MaterialAttributeData> _data;
         Containers::Array<UnsignedInt> _layerOffsets;
+        /* For each layer and each MaterialAttribute a layer-local attribute
+           ID plus one, zero if not present. Empty if a layer has too many
+           attributes to fit. */
+        Containers::Array<UnsignedByte> _attributeLookup;
         MaterialTypes _types;
         const void* _importerState;
 };
@@ -2737,9 +2769,14 @@ template<class T> T MaterialData::attribute(const UnsignedInt layer, const Conta
 }
 
 template<class T> T MaterialData::attribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::attribute(): invalid name" << name, {});
-    return attribute<T>(layer, string);
+    CORRADE_ASSERT(attributeString(name).data(),
+        "Trade::MaterialData::attribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attribute(): attribute" << attributeString(name) << "not found in layer" << layer, {});
+    return attribute<T>(layer, id);
 }
 
 template<class T> T MaterialData::attribute(const Containers::StringView layer, const UnsignedInt id) const {
@@ -2794,9 +2831,13 @@ template<class T> Containers::Optional<T> MaterialData::tryAttribute(const Unsig
 }
 
 template<class T> Containers::Optional<T> MaterialData::tryAttribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::tryAttribute(): invalid name" << name, {});
-    return tryAttribute<T>(layer, string);
+    CORRADE_ASSERT(attributeString(name).data(),
+        "Trade::MaterialData::tryAttribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::tryAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    if(id == ~UnsignedInt{}) return {};
+    return attribute<T>(layer, id);
 }
 
 template<class T> Containers::Optional<T> MaterialData::tryAttribute(const Containers::StringView layer, const Containers::StringView name) const {
@@ -2833,9 +2874,13 @@ template<class T> T MaterialData::attributeOr(const UnsignedInt layer, const Con
 }
 
 template<class T> T MaterialData::attributeOr(const UnsignedInt layer, const MaterialAttribute name, const T& defaultValue) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::attributeOr(): invalid name" << name, {});
-    return attributeOr<T>(layer, string, defaultValue);
+    CORRADE_ASSERT(attributeString(name).data(),
+        "Trade::MaterialData::attributeOr(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attributeOr(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    if(id == ~UnsignedInt{}) return defaultValue;
+    return attribute<T>(layer, id);
 }
 
 template<class T> T MaterialData::attributeOr(const Containers::StringView layer, const Containers::StringView name, const T& defaultValue) const {
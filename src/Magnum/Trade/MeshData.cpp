@@ -25,6 +25,8 @@
 
 #include "MeshData.h"
 
+#include <cstring>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Algorithms.h>
 #ifndef CORRADE_NO_ASSERT
 #include <Corrade/Utility/Format.h>
@@ -33,6 +35,7 @@
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/PackingBatch.h"
 #include "Magnum/Trade/Implementation/arrayUtilities.h"
+#include "Magnum/Trade/Implementation/serialization.h"
 
 namespace Magnum { namespace Trade {
 
@@ -788,6 +791,159 @@ Containers::Array<UnsignedInt> MeshData::objectIdsAsArray(const UnsignedInt id)
     return out;
 }
 
+namespace {
+
+/* Index and vertex data offsets inside a serialized chunk. The header and
+   attribute list together are always a multiple of 8 bytes, so the index data
+   don't need any extra padding. */
+std::size_t serializedIndexDataOffset(const std::size_t attributeCount) {
+    return sizeof(Implementation::MeshDataChunk) + attributeCount*sizeof(Implementation::MeshDataChunkAttribute);
+}
+
+/* Used to validate deserialized vertex formats, as vertexFormatSize() asserts
+   on unknown values */
+constexpr UnsignedInt VertexFormatCount = 0
+    #define _c(format) + 1
+    #include "Magnum/Implementation/vertexFormatMapping.hpp"
+    #undef _c
+    ;
+
+}
+
+std::size_t MeshData::serializedSize() const {
+    const std::size_t vertexDataOffset = Implementation::alignDataChunkOffset(serializedIndexDataOffset(_attributes.size()) + _indexData.size());
+    return Implementation::alignDataChunkOffset(vertexDataOffset + _vertexData.size());
+}
+
+void MeshData::serializeInto(const Containers::ArrayView<char> destination) const {
+    const std::size_t indexDataOffset = serializedIndexDataOffset(_attributes.size());
+    const std::size_t vertexDataOffset = Implementation::alignDataChunkOffset(indexDataOffset + _indexData.size());
+    const std::size_t size = Implementation::alignDataChunkOffset(vertexDataOffset + _vertexData.size());
+    CORRADE_ASSERT(destination.size() == size,
+        "Trade::MeshData::serializeInto(): expected a view of" << size << "bytes but got" << destination.size(), );
+    CORRADE_ASSERT(reinterpret_cast<std::uintptr_t>(destination.data()) % Implementation::DataChunkAlignment == 0,
+        "Trade::MeshData::serializeInto(): expected the view to be aligned to" << Implementation::DataChunkAlignment << "bytes", );
+
+    /* Zero-fill the header, attribute list and padding so the output is
+       deterministic. The data themselves get overwritten right after, so
+       there's no need to clear them. */
+    std::memset(destination.data(), 0, indexDataOffset);
+    std::memset(destination.data() + indexDataOffset + _indexData.size(), 0, vertexDataOffset - indexDataOffset - _indexData.size());
+    std::memset(destination.data() + vertexDataOffset + _vertexData.size(), 0, size - vertexDataOffset - _vertexData.size());
+
+    auto& chunk = *reinterpret_cast<Implementation::MeshDataChunk*>(destination.data());
+    Implementation::initializeDataChunkHeader(chunk.header, DataChunkType::Mesh, size);
+    chunk.indexCount = _indexCount;
+    chunk.vertexCount = _vertexCount;
+    chunk.primitive = UnsignedInt(_primitive);
+    chunk.attributeCount = _attributes.size();
+    chunk.indexType = UnsignedByte(_indexType);
+    chunk.indexOffset = isIndexed() ? _indices - _indexData.data() : 0;
+    chunk.indexDataSize = _indexData.size();
+    chunk.vertexDataSize = _vertexData.size();
+
+    const auto attributes = Containers::arrayCast<Implementation::MeshDataChunkAttribute>(destination.slice(sizeof(Implementation::MeshDataChunk), indexDataOffset));
+    for(std::size_t i = 0; i != _attributes.size(); ++i) {
+        const MeshAttributeData& attribute = _attributes[i];
+        /* The MeshAttributeData constructors reject negative strides, so the
+           offset is always the lowest address of the attribute, which is what
+           deserialize() expects */
+        CORRADE_INTERNAL_ASSERT(attribute._stride >= 0);
+        /* With no vertices the attribute pointer doesn't need to point into
+           the vertex data, so don't calculate the offset from it */
+        attributes[i].offset =
+            attribute._isOffsetOnly ? attribute._data.offset :
+            _vertexCount ? static_cast<const char*>(attribute._data.pointer) - _vertexData.data() : 0;
+        attributes[i].format = UnsignedInt(attribute._format);
+        attributes[i].name = UnsignedShort(attribute._name);
+        attributes[i].stride = attribute._stride;
+        attributes[i].arraySize = attribute._arraySize;
+    }
+
+    Utility::copy(_indexData, destination.slice(indexDataOffset, indexDataOffset + _indexData.size()));
+    Utility::copy(_vertexData, destination.slice(vertexDataOffset, vertexDataOffset + _vertexData.size()));
+}
+
+Containers::Array<char> MeshData::serialize() const {
+    Containers::Array<char> out{Containers::NoInit, serializedSize()};
+    serializeInto(out);
+    return out;
+}
+
+Containers::Optional<MeshData> MeshData::deserialize(const Containers::ArrayView<const void> data) {
+    const DataChunkHeader* const header = Implementation::checkDataChunkHeader("Trade::MeshData::deserialize():", data, DataChunkType::Mesh, sizeof(Implementation::MeshDataChunk));
+    if(!header) return {};
+
+    /* All sizes and offsets are 64-bit, so do the checks in a way that can't
+       overflow on 32-bit platforms either */
+    const auto& chunk = *reinterpret_cast<const Implementation::MeshDataChunk*>(header);
+    const char* const begin = static_cast<const char*>(data.data());
+    const UnsignedLong size = chunk.header.size;
+    const UnsignedLong indexDataOffset = sizeof(Implementation::MeshDataChunk) + UnsignedLong(chunk.attributeCount)*sizeof(Implementation::MeshDataChunkAttribute);
+    if(indexDataOffset > size || chunk.indexDataSize > size - indexDataOffset) {
+        Error{} << "Trade::MeshData::deserialize(): index data out of range for a chunk of" << size << "bytes";
+        return {};
+    }
+    const UnsignedLong vertexDataOffset = Implementation::alignDataChunkOffset(indexDataOffset + chunk.indexDataSize);
+    if(vertexDataOffset > size || chunk.vertexDataSize > size - vertexDataOffset) {
+        Error{} << "Trade::MeshData::deserialize(): vertex data out of range for a chunk of" << size << "bytes";
+        return {};
+    }
+
+    /* Index data */
+    const auto indexType = MeshIndexType(chunk.indexType);
+    MeshIndexData indices;
+    if(indexType != MeshIndexType{}) {
+        if(UnsignedByte(indexType) > UnsignedByte(MeshIndexType::UnsignedInt)) {
+            Error{} << "Trade::MeshData::deserialize(): invalid index type" << reinterpret_cast<void*>(UnsignedByte(indexType));
+            return {};
+        }
+        const UnsignedLong indexSize = UnsignedLong(chunk.indexCount)*meshIndexTypeSize(indexType);
+        if(chunk.indexOffset > chunk.indexDataSize || indexSize > chunk.indexDataSize - chunk.indexOffset || (!chunk.indexCount && chunk.indexDataSize)) {
+            Error{} << "Trade::MeshData::deserialize(): indices out of range for" << chunk.indexDataSize << "bytes of index data";
+            return {};
+        }
+        indices = MeshIndexData{indexType, {begin + indexDataOffset + chunk.indexOffset, std::size_t(indexSize)}};
+    } else if(chunk.indexCount || chunk.indexDataSize) {
+        Error{} << "Trade::MeshData::deserialize(): index data specified for a non-indexed mesh";
+        return {};
+    }
+
+    /* Attributes. The MeshAttributeData layout depends on pointer size so
+       these have to be converted, the actual data are referenced directly. */
+    const auto serializedAttributes = Containers::arrayCast<const Implementation::MeshDataChunkAttribute>(Containers::arrayView(begin + sizeof(Implementation::MeshDataChunk), std::size_t(indexDataOffset - sizeof(Implementation::MeshDataChunk))));
+    Containers::Array<MeshAttributeData> attributes{serializedAttributes.size()};
+    for(std::size_t i = 0; i != serializedAttributes.size(); ++i) {
+        const Implementation::MeshDataChunkAttribute& attribute = serializedAttributes[i];
+        const auto name = MeshAttribute(attribute.name);
+        const auto format = VertexFormat(attribute.format);
+        const bool implementationSpecific = isVertexFormatImplementationSpecific(format);
+        if(!implementationSpecific && (attribute.format == 0 || attribute.format > VertexFormatCount)) {
+            Error{} << "Trade::MeshData::deserialize(): invalid format" << reinterpret_cast<void*>(attribute.format) << "for attribute" << i;
+            return {};
+        }
+        if(!Implementation::isVertexFormatCompatibleWithAttribute(name, format) || (attribute.arraySize && (implementationSpecific || !Implementation::isAttributeArrayAllowed(name))) || attribute.stride < 0) {
+            Error{} << "Trade::MeshData::deserialize(): invalid layout of attribute" << i;
+            return {};
+        }
+
+        /* For implementation-specific formats we don't know the size so check
+           at least partially, same as in the constructor */
+        const UnsignedLong typeSize = implementationSpecific ? 0 :
+            vertexFormatSize(format)*(attribute.arraySize ? attribute.arraySize : 1);
+        if(chunk.vertexCount && (attribute.offset > chunk.vertexDataSize || UnsignedLong(chunk.vertexCount - 1)*attribute.stride + typeSize > chunk.vertexDataSize - attribute.offset)) {
+            Error{} << "Trade::MeshData::deserialize(): attribute" << i << "out of range for" << chunk.vertexDataSize << "bytes of vertex data";
+            return {};
+        }
+
+        attributes[i] = MeshAttributeData{name, format, std::size_t(attribute.offset), chunk.vertexCount, attribute.stride, attribute.arraySize};
+    }
+
+    return MeshData{MeshPrimitive(chunk.primitive),
+        DataFlags{}, Containers::arrayView(begin + indexDataOffset, std::size_t(chunk.indexDataSize)), indices,
+        DataFlags{}, Containers::arrayView(begin + vertexDataOffset, std::size_t(chunk.vertexDataSize)), std::move(attributes), chunk.vertexCount};
+}
+
 Containers::Array<char> MeshData::releaseIndexData() {
     _indexCount = 0;
     Containers::Array<char> out = std::move(_indexData);
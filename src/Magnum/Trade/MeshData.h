@@ -693,6 +693,28 @@ you can also supply implementation-specific values that are not available in
 the generic @ref MeshPrimitive enum, similarly see also
 @ref Trade-MeshAttributeData-custom-vertex-format for details on
 implementation-specific @ref VertexFormat values.
+
+@section Trade-MeshData-serialization Binary serialization
+
+As the index and vertex data are already flat buffers and the attributes are
+just offsets into them, the whole instance can be written out as a single
+binary blob using @ref serialize() or @ref serializeInto() and turned back
+into a @ref MeshData using @ref deserialize() without copying or parsing any
+data --- the returned instance references the data passed to it. Combined with
+@ref Corrade::Utility::Directory::mapRead() this means a mesh can be loaded by
+just memory-mapping a file and validating its header:
+
+@snippet MagnumTrade.cpp MeshData-serialization
+
+The blob is versioned and stores the data in the native byte order of the
+machine that produced it, @ref deserialize() rejects blobs with a different
+version or a different endianness. Index and vertex data are aligned to 8
+bytes inside the blob, so if the blob itself is suitably aligned (which is
+always the case with memory-mapped files and allocated arrays), the data can
+be accessed directly. The @ref importerState() is not serialized. The
+@ref MagnumImporter "MagnumImporter" and
+@ref MagnumSceneConverter "MagnumSceneConverter" plugins expose this format
+through the @ref AbstractImporter and @ref AbstractSceneConverter interfaces.
 @see @ref AbstractImporter::mesh()
 */
 class MAGNUM_TRADE_EXPORT MeshData {
@@ -1706,6 +1728,55 @@ class MAGNUM_TRADE_EXPORT MeshData {
          */
         void objectIdsInto(Containers::StridedArrayView1D<UnsignedInt> destination, UnsignedInt id = 0) const;
 
+        /**
+         * @brief Size of the serialized representation
+         * @m_since_latest
+         *
+         * Size of the blob produced by @ref serialize(), always a multiple of
+         * 8 bytes. See @ref Trade-MeshData-serialization for more
+         * information.
+         */
+        std::size_t serializedSize() const;
+
+        /**
+         * @brief Serialize into a pre-allocated view
+         * @m_since_latest
+         *
+         * Like @ref serialize(), but puts the result into @p destination
+         * instead of allocating a new array. Expects that @p destination is
+         * exactly @ref serializedSize() bytes large.
+         */
+        void serializeInto(Containers::ArrayView<char> destination) const;
+
+        /**
+         * @brief Serialize to a binary blob
+         * @m_since_latest
+         *
+         * Writes out the attribute layout, index data and vertex data in a
+         * form that can be turned back into a @ref MeshData instance using
+         * @ref deserialize(). Implementation-specific and custom attributes,
+         * primitives and formats are preserved. See
+         * @ref Trade-MeshData-serialization for more information.
+         * @see @ref serializedSize(), @ref serializeInto()
+         */
+        Containers::Array<char> serialize() const;
+
+        /**
+         * @brief Deserialize from a binary blob
+         * @m_since_latest
+         *
+         * Expects that @p data is aligned to 8 bytes and contains a blob
+         * produced by @ref serialize(), possibly followed by other data. The
+         * returned instance doesn't own the data and references @p data
+         * directly, so it has to stay in scope for as long as the instance is
+         * used; both @ref indexDataFlags() and @ref vertexDataFlags() are
+         * empty. If the blob is invalid, truncated or was produced on a
+         * machine with a different endianness, prints a message to error
+         * output and returns @ref Corrade::Containers::NullOpt. See
+         * @ref Trade-MeshData-serialization for more information.
+         */
+        static Containers::Optional<MeshData> deserialize(Containers::ArrayView<const void> data);
+
         /**
          * @brief Release index data storage
          *
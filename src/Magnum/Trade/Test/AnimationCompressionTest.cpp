@@ -0,0 +1,471 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Animation/Quantization.h"
+#include "Magnum/Math/CubicHermite.h"
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Trade/AnimationCompression.h"
+#include "Magnum/Trade/AnimationData.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct AnimationCompressionTest: TestSuite::Tester {
+    explicit AnimationCompressionTest();
+
+    void resample();
+    void resampleInvalidRate();
+
+    void simplify();
+    void simplifyRotation();
+    void simplifyInteger();
+    void simplifyDualQuaternion();
+    void simplifySplineToItself();
+
+    void unsupportedTrackType();
+
+    void quantize();
+    void quantizeSimplified();
+};
+
+using namespace Math::Literals;
+
+AnimationCompressionTest::AnimationCompressionTest() {
+    addTests({&AnimationCompressionTest::resample,
+              &AnimationCompressionTest::resampleInvalidRate,
+
+              &AnimationCompressionTest::simplify,
+              &AnimationCompressionTest::simplifyRotation,
+              &AnimationCompressionTest::simplifyInteger,
+              &AnimationCompressionTest::simplifyDualQuaternion,
+              &AnimationCompressionTest::simplifySplineToItself,
+
+              &AnimationCompressionTest::unsupportedTrackType,
+
+              &AnimationCompressionTest::quantize,
+              &AnimationCompressionTest::quantizeSimplified});
+}
+
+const Float TranslationKeys[]{0.0f, 1.0f, 3.0f};
+const Vector3 Translations[]{
+    {0.0f, 1.0f, 2.0f},
+    {1.0f, 3.0f, -2.0f},
+    {-0.5f, 0.0f, 4.0f}
+};
+
+const Float RotationKeys[]{0.0f, 3.0f};
+const Quaternion Rotations[]{
+    Quaternion::rotation(0.0_degf, Vector3::yAxis()),
+    Quaternion::rotation(90.0_degf, Vector3::yAxis())
+};
+
+const Float SplineKeys[]{0.5f, 2.0f};
+const CubicHermite3D Splines[]{
+    {{0.0f, 1.0f, 0.0f}, {1.0f, 2.0f, 3.0f}, {0.0f, 1.0f, 0.0f}},
+    {{1.0f, 0.0f, 1.0f}, {3.0f, 2.0f, 1.0f}, {1.0f, 0.0f, 1.0f}}
+};
+
+void AnimationCompressionTest::resample() {
+    const AnimationData animation{{}, {}, {
+        AnimationTrackData{AnimationTrackTargetType::Translation3D, 3,
+            Animation::TrackView<const Float, const Vector3>{
+                TranslationKeys, Translations,
+                Animation::Interpolation::Linear,
+                animationInterpolatorFor<Vector3>(Animation::Interpolation::Linear),
+                Animation::Extrapolation::Constant,
+                Animation::Extrapolation::DefaultConstructed}},
+        AnimationTrackData{AnimationTrackTargetType::Rotation3D, 5,
+            Animation::TrackView<const Float, const Quaternion>{
+                RotationKeys, Rotations,
+                Animation::Interpolation::Linear,
+                animationInterpolatorFor<Quaternion>(Animation::Interpolation::Linear)}},
+        AnimationTrackData{AnimationTrackTargetType::Scaling3D, 7,
+            Animation::TrackView<const Float, const CubicHermite3D>{
+                SplineKeys, Splines,
+                Animation::Interpolation::Spline,
+                animationInterpolatorFor<CubicHermite3D>(Animation::Interpolation::Spline)}}
+    }, {-1.0f, 4.0f}};
+
+    const AnimationData resampled = resampleAnimation(animation, 2.0f);
+    CORRADE_COMPARE(resampled.duration(), (Range1D{-1.0f, 4.0f}));
+    CORRADE_COMPARE(resampled.trackCount(), 3);
+
+    {
+        CORRADE_COMPARE(resampled.trackType(0), AnimationTrackType::Vector3);
+        CORRADE_COMPARE(resampled.trackTargetType(0), AnimationTrackTargetType::Translation3D);
+        CORRADE_COMPARE(resampled.trackTarget(0), 3);
+        const auto& track = resampled.track<Vector3>(0);
+        CORRADE_COMPARE(track.interpolation(), Animation::Interpolation::Linear);
+        CORRADE_COMPARE(track.before(), Animation::Extrapolation::Constant);
+        CORRADE_COMPARE(track.after(), Animation::Extrapolation::DefaultConstructed);
+        CORRADE_COMPARE_AS(track.keys(), Containers::arrayView<Float>({
+            0.0f, 0.5f, 1.0f, 1.5f, 2.0f, 2.5f, 3.0f
+        }), TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(track.values(), Containers::arrayView<Vector3>({
+            {0.0f, 1.0f, 2.0f},
+            {0.5f, 2.0f, 0.0f},
+            {1.0f, 3.0f, -2.0f},
+            {0.625f, 2.25f, -0.5f},
+            {0.25f, 1.5f, 1.0f},
+            {-0.125f, 0.75f, 2.5f},
+            {-0.5f, 0.0f, 4.0f}
+        }), TestSuite::Compare::Container);
+    } {
+        CORRADE_COMPARE(resampled.trackType(1), AnimationTrackType::Quaternion);
+        const auto& track = resampled.track<Quaternion>(1);
+        CORRADE_COMPARE(track.size(), 7);
+        CORRADE_COMPARE(track.values()[2], Quaternion::rotation(30.0_degf, Vector3::yAxis()));
+
+        /* Both tracks have the same duration, so they share the keys */
+        CORRADE_COMPARE(track.keys().data(), resampled.track(0).keys().data());
+    } {
+        /* Spline track is copied verbatim */
+        CORRADE_COMPARE(resampled.trackType(2), AnimationTrackType::CubicHermite3D);
+        CORRADE_COMPARE(resampled.trackResultType(2), AnimationTrackType::Vector3);
+        const auto& track = resampled.track<CubicHermite3D>(2);
+        CORRADE_COMPARE(track.interpolation(), Animation::Interpolation::Spline);
+        CORRADE_COMPARE_AS(track.keys(), Containers::arrayView(SplineKeys),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(track.values(), Containers::arrayView(Splines),
+            TestSuite::Compare::Container);
+    }
+}
+
+void AnimationCompressionTest::resampleInvalidRate() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const AnimationData animation{nullptr, nullptr};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    resampleAnimation(animation, 0.0f);
+    CORRADE_COMPARE(out.str(), "Trade::resampleAnimation(): expected a positive rate but got 0\n");
+}
+
+void AnimationCompressionTest::simplify() {
+    const Float keys[]{0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    const Vector2 values[]{
+        {0.0f, 0.0f},
+        {1.0f, 0.5f},
+        {2.0f, 1.0f},
+        {3.0f, 1.5f},
+        {3.0f, 1.5f},
+        {3.0f, 1.5001f}
+    };
+
+    const AnimationData animation{{}, {}, {
+        AnimationTrackData{AnimationTrackTargetType::Translation2D, 0,
+            Animation::TrackView<const Float, const Vector2>{keys, values,
+                Animation::Interpolation::Linear,
+                animationInterpolatorFor<Vector2>(Animation::Interpolation::Linear)}}
+    }};
+
+    const AnimationData simplified = simplifyAnimation(animation, 0.001f, 0.0_degf);
+    CORRADE_COMPARE(simplified.trackCount(), 1);
+    CORRADE_COMPARE(simplified.duration(), (Range1D{0.0f, 5.0f}));
+
+    const auto& track = simplified.track<Vector2>(0);
+    CORRADE_COMPARE_AS(track.keys(), Containers::arrayView<Float>({
+        0.0f, 3.0f, 5.0f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(track.values(), Containers::arrayView<Vector2>({
+        {0.0f, 0.0f},
+        {3.0f, 1.5f},
+        {3.0f, 1.5001f}
+    }), TestSuite::Compare::Container);
+}
+
+void AnimationCompressionTest::simplifyRotation() {
+    const Float keys[]{0.0f, 1.0f, 2.0f, 3.0f};
+    const Quaternion values[]{
+        Quaternion::rotation(0.0_degf, Vector3::xAxis()),
+        Quaternion::rotation(10.0_degf, Vector3::xAxis()),
+        Quaternion::rotation(20.5_degf, Vector3::xAxis()),
+        Quaternion::rotation(30.0_degf, Vector3::xAxis())
+    };
+
+    const AnimationData animation{{}, {}, {
+        AnimationTrackData{AnimationTrackTargetType::Rotation3D, 0,
+            Animation::TrackView<const Float, const Quaternion>{keys, values,
+                Animation::Interpolation::Linear,
+                animationInterpolatorFor<Quaternion>(Animation::Interpolation::Linear)}}
+    }};
+
+    /* The third key is half a degree off, so with a larger tolerance it gets
+       removed and with a smaller not */
+    CORRADE_COMPARE(simplifyAnimation(animation, 0.0f, 1.0_degf).track(0).size(), 2);
+    CORRADE_COMPARE_AS(simplifyAnimation(animation, 0.0f, 0.1_degf).track(0).keys(), Containers::arrayView<Float>({
+        0.0f, 1.0f, 2.0f, 3.0f
+    }), TestSuite::Compare::Container);
+}
+
+void AnimationCompressionTest::simplifyInteger() {
+    const Float keys[]{0.0f, 1.0f, 2.0f, 3.0f, 4.0f};
+    const Int values[]{1, 1, 1, 2, 2};
+
+    const AnimationData animation{{}, {}, {
+        AnimationTrackData{AnimationTrackTargetType(129), 0,
+            Animation::TrackView<const Float, const Int>{keys, values,
+                Animation::Interpolation::Constant,
+                animationInterpolatorFor<Int>(Animation::Interpolation::Constant)}}
+    }};
+
+    /* The tolerance doesn't matter for integers */
+    const AnimationData simplified = simplifyAnimation(animation, 100.0f, 0.0_degf);
+    const auto& track = simplified.track<Int>(0);
+    CORRADE_COMPARE_AS(track.keys(), Containers::arrayView<Float>({
+        0.0f, 3.0f, 4.0f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(track.values(), Containers::arrayView<Int>({
+        1, 2, 2
+    }), TestSuite::Compare::Container);
+
+    /* The values are the same as in the original */
+    for(Float time: {-1.0f, 0.5f, 2.5f, 2.99f, 3.0f, 3.5f, 10.0f}) {
+        CORRADE_ITERATION(time);
+        CORRADE_COMPARE(track.at(time), animation.track<Int>(0).at(time));
+    }
+}
+
+void AnimationCompressionTest::simplifyDualQuaternion() {
+    const Float keys[]{0.0f, 1.0f, 2.0f};
+    const DualQuaternion values[]{
+        DualQuaternion::translation({0.0f, 0.0f, 0.0f}),
+        /* Off by 0.05 from the interpolated value */
+        DualQuaternion::translation({1.0f, 0.1f, 0.0f}),
+        DualQuaternion::translation({2.0f, 0.0f, 0.0f})
+    };
+
+    const AnimationData animation{{}, {}, {
+        AnimationTrackData{AnimationTrackTargetType(129), 0,
+            Animation::TrackView<const Float, const DualQuaternion>{keys, values,
+                Animation::Interpolation::Linear,
+                animationInterpolatorFor<DualQuaternion>(Animation::Interpolation::Linear)}}
+    }};
+
+    /* Within the tolerance, the middle keyframe is removed */
+    {
+        const AnimationData simplified = simplifyAnimation(animation, 0.1f, 0.0_degf);
+        CORRADE_COMPARE_AS(simplified.track<DualQuaternion>(0).keys(), Containers::arrayView<Float>({
+            0.0f, 2.0f
+        }), TestSuite::Compare::Container);
+
+    /* Outside, it's kept. With exact comparison it'd be kept in both cases. */
+    } {
+        const AnimationData simplified = simplifyAnimation(animation, 0.01f, 0.0_degf);
+        CORRADE_COMPARE_AS(simplified.track<DualQuaternion>(0).keys(), Containers::arrayView<Float>({
+            0.0f, 1.0f, 2.0f
+        }), TestSuite::Compare::Container);
+    }
+}
+
+CubicHermite3D splineToItself(const CubicHermite3D& a, const CubicHermite3D& b, Float t) {
+    return t < 1.0f ? a : b;
+}
+
+void AnimationCompressionTest::simplifySplineToItself() {
+    const Float keys[]{0.0f, 1.0f, 2.0f, 3.0f};
+    const CubicHermite3D values[]{Splines[0], Splines[0], Splines[0], Splines[1]};
+
+    const AnimationData animation{{}, {}, {
+        AnimationTrackData{AnimationTrackTargetType(129), 0,
+            Animation::TrackView<const Float, const CubicHermite3D, CubicHermite3D>{keys, values,
+                Animation::Interpolation::Constant,
+                splineToItself}}
+    }};
+    CORRADE_COMPARE(animation.trackResultType(0), AnimationTrackType::CubicHermite3D);
+
+    /* The tolerance doesn't matter, only keyframes that the interpolator
+       reproduces exactly are removed */
+    const AnimationData simplified = simplifyAnimation(animation, 100.0f, 0.0_degf);
+    const auto& track = simplified.track<CubicHermite3D, CubicHermite3D>(0);
+    CORRADE_COMPARE_AS(track.keys(), Containers::arrayView<Float>({
+        0.0f, 3.0f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(track.values()[0], Splines[0]);
+    CORRADE_COMPARE(track.values()[1], Splines[1]);
+}
+
+Vector2 floatToVector2(const Float& a, const Float& b, Float t) {
+    return {Math::lerp(a, b, t), 0.0f};
+}
+
+void AnimationCompressionTest::unsupportedTrackType() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Float keys[]{0.0f, 1.0f};
+    const Float values[]{0.0f, 1.0f};
+
+    const AnimationData animation{{}, {}, {
+        AnimationTrackData{AnimationTrackTargetType::Translation3D, 0,
+            Animation::TrackView<const Float, const Vector3>{
+                TranslationKeys, Translations,
+                Animation::Interpolation::Linear,
+                animationInterpolatorFor<Vector3>(Animation::Interpolation::Linear)}},
+        AnimationTrackData{AnimationTrackTargetType::Translation2D, 1,
+            Animation::TrackView<const Float, const Float, Vector2>{keys, values,
+                Animation::Interpolation::Linear,
+                floatToVector2}}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    resampleAnimation(animation, 1.0f);
+    simplifyAnimation(animation, 1.0f, 1.0_degf);
+    quantizeAnimation(animation);
+    CORRADE_COMPARE(out.str(),
+        "Trade::resampleAnimation(): unsupported track type Trade::AnimationTrackType::Float with result type Trade::AnimationTrackType::Vector2 in track 1\n"
+        "Trade::simplifyAnimation(): unsupported track type Trade::AnimationTrackType::Float with result type Trade::AnimationTrackType::Vector2 in track 1\n"
+        "Trade::quantizeAnimation(): unsupported track type Trade::AnimationTrackType::Float with result type Trade::AnimationTrackType::Vector2 in track 1\n");
+}
+
+void AnimationCompressionTest::quantize() {
+    const Quaternion constantRotations[]{
+        Quaternion::rotation(15.0_degf, Vector3::zAxis()),
+        Quaternion::rotation(65.0_degf, Vector3::zAxis())
+    };
+    const Vector3 scalings[]{
+        {1.0f, 2.0f, 3.0f},
+        {3.0f, 2.0f, 1.0f}
+    };
+
+    const AnimationData animation{{}, {}, {
+        AnimationTrackData{AnimationTrackTargetType::Translation3D, 3,
+            Animation::TrackView<const Float, const Vector3>{
+                TranslationKeys, Translations,
+                Animation::Interpolation::Linear,
+                animationInterpolatorFor<Vector3>(Animation::Interpolation::Linear)}},
+        AnimationTrackData{AnimationTrackTargetType::Rotation3D, 5,
+            Animation::TrackView<const Float, const Quaternion>{
+                RotationKeys, Rotations,
+                Animation::Interpolation::Linear,
+                animationInterpolatorFor<Quaternion>(Animation::Interpolation::Linear)}},
+        AnimationTrackData{AnimationTrackTargetType::Rotation3D, 6,
+            Animation::TrackView<const Float, const Quaternion>{
+                RotationKeys, constantRotations,
+                Animation::Interpolation::Constant,
+                animationInterpolatorFor<Quaternion>(Animation::Interpolation::Constant)}},
+        AnimationTrackData{AnimationTrackTargetType::Scaling3D, 7,
+            Animation::TrackView<const Float, const Vector3>{
+                RotationKeys, scalings,
+                Animation::Interpolation::Linear,
+                animationInterpolatorFor<Vector3>(Animation::Interpolation::Linear)}}
+    }};
+
+    const AnimationData quantized = quantizeAnimation(animation);
+    CORRADE_COMPARE(quantized.trackCount(), 4);
+    CORRADE_COMPARE(quantized.duration(), (Range1D{0.0f, 3.0f}));
+
+    {
+        /* Maximal absolute value is 4, so the exponent is 2 */
+        CORRADE_COMPARE(quantized.trackType(0), AnimationTrackType::Vector3s);
+        CORRADE_COMPARE(quantized.trackResultType(0), AnimationTrackType::Vector3);
+        CORRADE_COMPARE(quantized.trackTargetType(0), AnimationTrackTargetType::Translation3D);
+        CORRADE_COMPARE(quantized.trackTarget(0), 3);
+        const auto& track = quantized.track<Vector3s, Vector3>(0);
+        CORRADE_COMPARE(track.interpolation(), Animation::Interpolation::Linear);
+        CORRADE_COMPARE(track.interpolator(), Animation::quantizedTranslationInterpolator(2));
+        CORRADE_COMPARE_AS(track.keys(), Containers::arrayView(TranslationKeys),
+            TestSuite::Compare::Container);
+        for(Float time: {0.0f, 0.5f, 1.0f, 2.25f, 3.0f}) {
+            CORRADE_ITERATION(time);
+            const Vector3 expected = animation.track<Vector3>(0).at(time);
+            const Vector3 actual = track.at(time);
+            for(std::size_t i = 0; i != 3; ++i) {
+                CORRADE_ITERATION(i);
+                CORRADE_COMPARE_WITH(actual[i], expected[i],
+                    TestSuite::Compare::around(4.0f/32767.0f));
+            }
+        }
+    } {
+        CORRADE_COMPARE(quantized.trackType(1), AnimationTrackType::Vector3us);
+        CORRADE_COMPARE(quantized.trackResultType(1), AnimationTrackType::Quaternion);
+        CORRADE_COMPARE(quantized.trackTarget(1), 5);
+        const auto& track = quantized.track<Vector3us, Quaternion>(1);
+        CORRADE_COMPARE(track.interpolator(), Animation::slerpSmallestThree);
+        for(Float time: {0.0f, 0.5f, 1.0f, 2.25f, 3.0f}) {
+            CORRADE_ITERATION(time);
+            const Quaternion expected = animation.track<Quaternion>(1).at(time);
+            CORRADE_COMPARE_WITH(Math::abs(Math::dot(track.at(time), expected)), 1.0f,
+                TestSuite::Compare::around(0.00001f));
+        }
+    } {
+        /* Non-linear rotations and scaling are copied verbatim */
+        CORRADE_COMPARE(quantized.trackType(2), AnimationTrackType::Quaternion);
+        CORRADE_COMPARE_AS(quantized.track<Quaternion>(2).values(),
+            Containers::arrayView(constantRotations),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE(quantized.trackType(3), AnimationTrackType::Vector3);
+        CORRADE_COMPARE_AS(quantized.track<Vector3>(3).values(),
+            Containers::arrayView(scalings),
+            TestSuite::Compare::Container);
+    }
+
+    /* Rotation and scaling tracks share the keys, the translation values are
+       padded to four bytes */
+    CORRADE_COMPARE(quantized.data().size(),
+        3*(4 + 6) + 2 + /* padding */
+        2*4 + 2*6 + 2*16 + 2*12);
+}
+
+void AnimationCompressionTest::quantizeSimplified() {
+    /* Quantizing the output of other operations should work as well */
+    const AnimationData animation{{}, {}, {
+        AnimationTrackData{AnimationTrackTargetType::Translation3D, 3,
+            Animation::TrackView<const Float, const Vector3>{
+                TranslationKeys, Translations,
+                Animation::Interpolation::Linear,
+                animationInterpolatorFor<Vector3>(Animation::Interpolation::Linear)}},
+        AnimationTrackData{AnimationTrackTargetType::Rotation3D, 5,
+            Animation::TrackView<const Float, const Quaternion>{
+                RotationKeys, Rotations,
+                Animation::Interpolation::Linear,
+                animationInterpolatorFor<Quaternion>(Animation::Interpolation::Linear)}}
+    }};
+
+    const AnimationData compressed = quantizeAnimation(
+        simplifyAnimation(resampleAnimation(animation, 10.0f), 0.0001f, 0.1_degf));
+    CORRADE_COMPARE(compressed.trackType(0), AnimationTrackType::Vector3s);
+    CORRADE_COMPARE(compressed.trackType(1), AnimationTrackType::Vector3us);
+
+    /* Resampled linear segments got simplified back to the original keys */
+    CORRADE_COMPARE_AS(compressed.track(0).keys(), Containers::arrayView(TranslationKeys),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(compressed.track(1).size(), 2);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::AnimationCompressionTest)
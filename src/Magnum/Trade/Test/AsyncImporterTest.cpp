@@ -0,0 +1,580 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Trade/AsyncImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct AsyncImporterTest: TestSuite::Tester {
+    explicit AsyncImporterTest();
+
+    void construct();
+    void constructDefaultThreadCount();
+
+    void openData();
+    void openDataFailed();
+    void instantiateFailed();
+    void flagsFileCallback();
+
+    void future();
+    void futureFailed();
+    void callback();
+    void reopen();
+
+    void priority();
+    void setPriority();
+    void cancel();
+    void cancelAll();
+    void closeCancels();
+
+    void setFlagsFileOpened();
+    void setFileCallbackFileOpened();
+    void noFileOpened();
+    void indexOutOfRange();
+    void levelOutOfRange();
+};
+
+AsyncImporterTest::AsyncImporterTest() {
+    addTests({&AsyncImporterTest::construct,
+              &AsyncImporterTest::constructDefaultThreadCount,
+
+              &AsyncImporterTest::openData,
+              &AsyncImporterTest::openDataFailed,
+              &AsyncImporterTest::instantiateFailed,
+              &AsyncImporterTest::flagsFileCallback,
+
+              &AsyncImporterTest::future,
+              &AsyncImporterTest::futureFailed,
+              &AsyncImporterTest::callback,
+              &AsyncImporterTest::reopen,
+
+              &AsyncImporterTest::priority,
+              &AsyncImporterTest::setPriority,
+              &AsyncImporterTest::cancel,
+              &AsyncImporterTest::cancelAll,
+              &AsyncImporterTest::closeCancels,
+
+              &AsyncImporterTest::setFlagsFileOpened,
+              &AsyncImporterTest::setFileCallbackFileOpened,
+              &AsyncImporterTest::noFileOpened,
+              &AsyncImporterTest::indexOutOfRange,
+              &AsyncImporterTest::levelOutOfRange});
+}
+
+/* Blocks a worker inside an import until released, so the tests can fill the
+   queue in a deterministic way */
+struct Gate {
+    void enter() {
+        std::unique_lock<std::mutex> lock{mutex};
+        entered = true;
+        condition.notify_all();
+        condition.wait(lock, [&]{ return released; });
+    }
+
+    void waitForEnter() {
+        std::unique_lock<std::mutex> lock{mutex};
+        condition.wait(lock, [&]{ return entered; });
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> lock{mutex};
+        released = true;
+        condition.notify_all();
+    }
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool entered{}, released{};
+};
+
+struct Importer: AbstractImporter {
+    explicit Importer(Gate* gate): gate{gate} {}
+
+    ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+    bool doIsOpened() const override { return opened; }
+    void doClose() override { opened = false; }
+    void doOpenData(Containers::ArrayView<const char> data) override {
+        if(!data.empty() && data[0] == 'X') {
+            Error{} << "Importer::openData(): invalid data";
+            return;
+        }
+        opened = true;
+    }
+
+    UnsignedInt doMeshCount() const override { return 5; }
+    UnsignedInt doMeshLevelCount(UnsignedInt) override { return 2; }
+    Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt level) override {
+        /* Block only on mesh 0 so the test can be sure which request is
+           the running one */
+        if(gate && id == 0) gate->enter();
+        if(id == 4) return {};
+        return MeshData{MeshPrimitive::Points, id*10 + level};
+    }
+
+    UnsignedInt doImage2DCount() const override { return 3; }
+    Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt) override {
+        return ImageData2D{PixelFormat::R8Unorm, {4, Int(id) + 1}, Containers::Array<char>{Containers::ValueInit, 4*(id + 1)}};
+    }
+
+    Gate* gate;
+    bool opened = false;
+};
+
+struct InstancerData {
+    Gate* gate;
+    std::size_t instanceCount;
+    bool fail;
+};
+
+Containers::Pointer<AbstractImporter> instancer(void* userData) {
+    auto& data = *static_cast<InstancerData*>(userData);
+    if(data.fail) {
+        Error{} << "instancer(): failed";
+        return nullptr;
+    }
+
+    ++data.instanceCount;
+    return Containers::Pointer<AbstractImporter>{new Importer{data.gate}};
+}
+
+/* Callback results. The callbacks are called from worker threads, so a lock
+   is needed. */
+struct Results {
+    void add(UnsignedLong request, UnsignedInt value) {
+        std::lock_guard<std::mutex> lock{mutex};
+        requests.push_back(request);
+        values.push_back(value);
+    }
+
+    std::mutex mutex;
+    std::vector<UnsignedLong> requests;
+    std::vector<UnsignedInt> values;
+};
+
+void meshCallback(UnsignedLong request, Containers::Optional<MeshData>&& mesh, void* userData) {
+    static_cast<Results*>(userData)->add(request, mesh ? mesh->vertexCount() : ~UnsignedInt{});
+}
+
+constexpr const char Data[]{'h', 'e', 'l', 'l', 'o'};
+
+void AsyncImporterTest::construct() {
+    InstancerData data{};
+    AsyncImporter importer{instancer, &data, 3};
+    CORRADE_COMPARE(importer.threadCount(), 3);
+    CORRADE_VERIFY(!importer.isOpened());
+    CORRADE_COMPARE(importer.flags(), ImporterFlags{});
+    CORRADE_COMPARE(importer.pendingRequestCount(), 0);
+
+    /* Nothing is instantiated until a file is opened */
+    CORRADE_COMPARE(data.instanceCount, 0);
+}
+
+void AsyncImporterTest::constructDefaultThreadCount() {
+    InstancerData data{};
+    AsyncImporter importer{instancer, &data};
+    CORRADE_COMPARE_AS(importer.threadCount(), 1,
+        TestSuite::Compare::GreaterOrEqual);
+}
+
+void AsyncImporterTest::openData() {
+    InstancerData data{};
+    AsyncImporter importer{instancer, &data, 3};
+    CORRADE_VERIFY(importer.openData(Data));
+    CORRADE_VERIFY(importer.isOpened());
+
+    /* One importer for the calling thread and one for each worker */
+    CORRADE_COMPARE(data.instanceCount, 4);
+    CORRADE_VERIFY(importer.importer().isOpened());
+    CORRADE_COMPARE(importer.importer().meshCount(), 5);
+
+    importer.close();
+    CORRADE_VERIFY(!importer.isOpened());
+}
+
+void AsyncImporterTest::openDataFailed() {
+    InstancerData data{};
+    AsyncImporter importer{instancer, &data, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.openData(Containers::arrayView({'X'})));
+    CORRADE_VERIFY(!importer.isOpened());
+    CORRADE_COMPARE(out.str(), "Importer::openData(): invalid data\n");
+}
+
+void AsyncImporterTest::instantiateFailed() {
+    InstancerData data{};
+    data.fail = true;
+    AsyncImporter importer{instancer, &data, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.openData(Data));
+    CORRADE_VERIFY(!importer.isOpened());
+    CORRADE_COMPARE(out.str(), "instancer(): failed\n");
+}
+
+Containers::Optional<Containers::ArrayView<const char>> fileCallback(const std::string&, InputFileCallbackPolicy, void*) {
+    return {};
+}
+
+void AsyncImporterTest::flagsFileCallback() {
+    InstancerData data{};
+    AsyncImporter importer{instancer, &data, 2};
+    int userData;
+    importer.setFlags(ImporterFlag::Verbose);
+    importer.setFileCallback(fileCallback, &userData);
+    CORRADE_COMPARE(importer.flags(), ImporterFlag::Verbose);
+
+    /* Propagated to the importer instances */
+    CORRADE_VERIFY(importer.openData(Data));
+    CORRADE_COMPARE(importer.importer().flags(), ImporterFlag::Verbose);
+    CORRADE_VERIFY(importer.importer().fileCallback() == fileCallback);
+    CORRADE_COMPARE(importer.importer().fileCallbackUserData(), &userData);
+}
+
+void AsyncImporterTest::future() {
+    InstancerData data{};
+    AsyncImporter importer{instancer, &data, 3};
+    CORRADE_VERIFY(importer.openData(Data));
+
+    UnsignedLong request{};
+    std::future<Containers::Optional<MeshData>> mesh0 = importer.mesh(0);
+    std::future<Containers::Optional<MeshData>> mesh1 = importer.mesh(1, 1, 0, &request);
+    std::future<Containers::Optional<MeshData>> mesh3 = importer.mesh(3, 0, 5);
+    std::future<Containers::Optional<ImageData2D>> image = importer.image2D(2);
+    CORRADE_COMPARE(request, 2);
+
+    Containers::Optional<MeshData> result0 = mesh0.get();
+    Containers::Optional<MeshData> result1 = mesh1.get();
+    Containers::Optional<MeshData> result3 = mesh3.get();
+    Containers::Optional<ImageData2D> resultImage = image.get();
+    CORRADE_VERIFY(result0);
+    CORRADE_VERIFY(result1);
+    CORRADE_VERIFY(result3);
+    CORRADE_VERIFY(resultImage);
+    CORRADE_COMPARE(result0->vertexCount(), 0);
+    CORRADE_COMPARE(result1->vertexCount(), 11);
+    CORRADE_COMPARE(result3->vertexCount(), 30);
+    CORRADE_COMPARE(resultImage->size(), (Vector2i{4, 3}));
+}
+
+void AsyncImporterTest::futureFailed() {
+    InstancerData data{};
+    AsyncImporter importer{instancer, &data, 2};
+    CORRADE_VERIFY(importer.openData(Data));
+
+    CORRADE_VERIFY(!importer.mesh(4).get());
+}
+
+void AsyncImporterTest::callback() {
+    InstancerData data{};
+    AsyncImporter importer{instancer, &data, 4};
+    CORRADE_VERIFY(importer.openData(Data));
+
+    Results results;
+    UnsignedLong requests[]{
+        importer.mesh(2, 1, 0, meshCallback, &results),
+        importer.mesh(4, 0, 0, meshCallback, &results),
+        importer.mesh(1, 0, 0, meshCallback, &results)
+    };
+    CORRADE_COMPARE(requests[0], 1);
+    CORRADE_COMPARE(requests[1], 2);
+    CORRADE_COMPARE(requests[2], 3);
+
+    importer.wait();
+    CORRADE_COMPARE(importer.pendingRequestCount(), 0);
+
+    /* With more than one worker the order is not deterministic, so compare
+       the request -> value mapping instead */
+    CORRADE_COMPARE(results.requests.size(), 3);
+    UnsignedInt values[3];
+    for(std::size_t i = 0; i != 3; ++i)
+        values[results.requests[i] - 1] = results.values[i];
+    CORRADE_COMPARE_AS(Containers::arrayView(values), Containers::arrayView<UnsignedInt>({
+        21, ~UnsignedInt{}, 10
+    }), TestSuite::Compare::Container);
+}
+
+void AsyncImporterTest::reopen() {
+    InstancerData data{};
+    AsyncImporter importer{instancer, &data, 2};
+    CORRADE_VERIFY(importer.openData(Data));
+    CORRADE_COMPARE(importer.mesh(3).get()->vertexCount(), 30);
+
+    /* Opening again closes the previous file and creates new instances */
+    CORRADE_VERIFY(importer.openData(Data));
+    CORRADE_COMPARE(data.instanceCount, 6);
+    CORRADE_COMPARE(importer.mesh(2, 1).get()->vertexCount(), 21);
+}
+
+void AsyncImporterTest::priority() {
+    Gate gate;
+    InstancerData data{&gate, 0, false};
+    AsyncImporter importer{instancer, &data, 1};
+    CORRADE_VERIFY(importer.openData(Data));
+
+    /* Block the only worker on the first request, then fill the queue */
+    Results results;
+    importer.mesh(0, 0, 0, meshCallback, &results);
+    gate.waitForEnter();
+    importer.mesh(1, 0, 0, meshCallback, &results);
+    importer.mesh(2, 0, 10, meshCallback, &results);
+    importer.mesh(3, 0, -5, meshCallback, &results);
+    importer.mesh(1, 1, 10, meshCallback, &results);
+    importer.mesh(2, 1, 0, meshCallback, &results);
+    CORRADE_COMPARE(importer.pendingRequestCount(), 5);
+
+    gate.release();
+    importer.wait();
+
+    /* Higher priority first, same priority in submission order */
+    CORRADE_COMPARE_AS(results.values, (std::vector<UnsignedInt>{
+        0, 20, 11, 10, 21, 30
+    }), TestSuite::Compare::Container);
+}
+
+void AsyncImporterTest::setPriority() {
+    Gate gate;
+    InstancerData data{&gate, 0, false};
+    AsyncImporter importer{instancer, &data, 1};
+    CORRADE_VERIFY(importer.openData(Data));
+
+    Results results;
+    UnsignedLong running = importer.mesh(0, 0, 0, meshCallback, &results);
+    gate.waitForEnter();
+    importer.mesh(1, 0, 0, meshCallback, &results);
+    UnsignedLong request = importer.mesh(2, 0, 0, meshCallback, &results);
+    CORRADE_VERIFY(importer.setPriority(request, 1));
+
+    /* The running request can't be changed anymore, unknown neither */
+    CORRADE_VERIFY(!importer.setPriority(running, 1));
+    CORRADE_VERIFY(!importer.setPriority(1000, 1));
+
+    gate.release();
+    importer.wait();
+    CORRADE_COMPARE_AS(results.values, (std::vector<UnsignedInt>{
+        0, 20, 10
+    }), TestSuite::Compare::Container);
+}
+
+void AsyncImporterTest::cancel() {
+    Gate gate;
+    InstancerData data{&gate, 0, false};
+    AsyncImporter importer{instancer, &data, 1};
+    CORRADE_VERIFY(importer.openData(Data));
+
+    Results results;
+    UnsignedLong running = importer.mesh(0, 0, 0, meshCallback, &results);
+    gate.waitForEnter();
+    UnsignedLong cancelled = importer.mesh(1, 0, 0, meshCallback, &results);
+    importer.mesh(2, 0, 0, meshCallback, &results);
+    UnsignedLong cancelledFuture;
+    std::future<Containers::Optional<MeshData>> future = importer.mesh(3, 0, 0, &cancelledFuture);
+
+    CORRADE_VERIFY(importer.cancel(cancelled));
+    CORRADE_VERIFY(importer.cancel(cancelledFuture));
+    CORRADE_COMPARE(importer.pendingRequestCount(), 1);
+
+    /* Running, already cancelled and unknown requests can't be cancelled */
+    CORRADE_VERIFY(!importer.cancel(running));
+    CORRADE_VERIFY(!importer.cancel(cancelled));
+    CORRADE_VERIFY(!importer.cancel(1000));
+
+    /* Cancelled future is fulfilled with NullOpt */
+    CORRADE_VERIFY(!future.get());
+
+    /* Cancelled callback isn't called at all */
+    gate.release();
+    importer.wait();
+    CORRADE_COMPARE_AS(results.values, (std::vector<UnsignedInt>{
+        0, 20
+    }), TestSuite::Compare::Container);
+}
+
+void AsyncImporterTest::cancelAll() {
+    Gate gate;
+    InstancerData data{&gate, 0, false};
+    AsyncImporter importer{instancer, &data, 1};
+    CORRADE_VERIFY(importer.openData(Data));
+
+    Results results;
+    importer.mesh(0, 0, 0, meshCallback, &results);
+    gate.waitForEnter();
+    importer.mesh(1, 0, 0, meshCallback, &results);
+    std::future<Containers::Optional<MeshData>> future = importer.mesh(2);
+    CORRADE_COMPARE(importer.cancelAll(), 2);
+    CORRADE_COMPARE(importer.pendingRequestCount(), 0);
+    CORRADE_VERIFY(!future.get());
+
+    gate.release();
+    importer.wait();
+    CORRADE_COMPARE_AS(results.values, (std::vector<UnsignedInt>{
+        0
+    }), TestSuite::Compare::Container);
+}
+
+void AsyncImporterTest::closeCancels() {
+    Gate gate;
+    InstancerData data{&gate, 0, false};
+    AsyncImporter importer{instancer, &data, 1};
+    CORRADE_VERIFY(importer.openData(Data));
+
+    std::future<Containers::Optional<MeshData>> running = importer.mesh(0);
+    gate.waitForEnter();
+    std::future<Containers::Optional<MeshData>> queued = importer.mesh(1);
+
+    /* Release the gate only after close() had a chance to cancel the queue.
+       It then waits for the running request to finish. */
+    std::thread release{[&]{
+        while(importer.pendingRequestCount()) std::this_thread::yield();
+        gate.release();
+    }};
+    importer.close();
+    release.join();
+
+    CORRADE_VERIFY(!importer.isOpened());
+    CORRADE_VERIFY(!queued.get());
+    Containers::Optional<MeshData> result = running.get();
+    CORRADE_VERIFY(result);
+    CORRADE_COMPARE(result->vertexCount(), 0);
+}
+
+void AsyncImporterTest::setFlagsFileOpened() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    InstancerData data{};
+    AsyncImporter importer{instancer, &data, 1};
+    CORRADE_VERIFY(importer.openData(Data));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    importer.setFlags(ImporterFlag::Verbose);
+    CORRADE_COMPARE(out.str(), "Trade::AsyncImporter::setFlags(): can't be set while a file is opened\n");
+}
+
+void AsyncImporterTest::setFileCallbackFileOpened() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    InstancerData data{};
+    AsyncImporter importer{instancer, &data, 1};
+    CORRADE_VERIFY(importer.openData(Data));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    importer.setFileCallback(fileCallback);
+    CORRADE_COMPARE(out.str(), "Trade::AsyncImporter::setFileCallback(): can't be set while a file is opened\n");
+}
+
+void AsyncImporterTest::noFileOpened() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    InstancerData data{};
+    AsyncImporter importer{instancer, &data, 1};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    importer.mesh(0);
+    importer.mesh(0, 0, 0, meshCallback);
+    importer.material(0);
+    importer.texture(0);
+    importer.image1D(0);
+    importer.image2D(0);
+    importer.image3D(0);
+    CORRADE_COMPARE(out.str(),
+        "Trade::AsyncImporter::mesh(): no file opened\n"
+        "Trade::AsyncImporter::mesh(): no file opened\n"
+        "Trade::AsyncImporter::material(): no file opened\n"
+        "Trade::AsyncImporter::texture(): no file opened\n"
+        "Trade::AsyncImporter::image1D(): no file opened\n"
+        "Trade::AsyncImporter::image2D(): no file opened\n"
+        "Trade::AsyncImporter::image3D(): no file opened\n");
+    CORRADE_COMPARE(importer.pendingRequestCount(), 0);
+}
+
+void AsyncImporterTest::indexOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    InstancerData data{};
+    AsyncImporter importer{instancer, &data, 1};
+    CORRADE_VERIFY(importer.openData(Data));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    importer.mesh(5);
+    importer.material(0);
+    importer.image2D(3);
+    CORRADE_COMPARE(out.str(),
+        "Trade::AsyncImporter::mesh(): index 5 out of range for 5 entries\n"
+        "Trade::AsyncImporter::material(): index 0 out of range for 0 entries\n"
+        "Trade::AsyncImporter::image2D(): index 3 out of range for 3 entries\n");
+    CORRADE_COMPARE(importer.pendingRequestCount(), 0);
+}
+
+void AsyncImporterTest::levelOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    InstancerData data{};
+    AsyncImporter importer{instancer, &data, 1};
+    CORRADE_VERIFY(importer.openData(Data));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    importer.mesh(3, 2);
+    importer.image2D(1, 1);
+    CORRADE_COMPARE(out.str(),
+        "Trade::AsyncImporter::mesh(): level 2 out of range for 2 entries\n"
+        "Trade::AsyncImporter::image2D(): level 1 out of range for 1 entries\n");
+    CORRADE_COMPARE(importer.pendingRequestCount(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::AsyncImporterTest)
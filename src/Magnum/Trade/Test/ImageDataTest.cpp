@@ -29,13 +29,17 @@
 #include "Magnum/Trade/ImageData.h"
 
 #include <sstream>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/FormatStl.h>
 
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Trade/Implementation/serialization.h"
 
 namespace Magnum { namespace Trade { namespace Test { namespace {
 
@@ -87,6 +91,15 @@ struct ImageDataTest: TestSuite::Tester {
     void pixels2D();
     void pixels3D();
     void pixelsCompressed();
+
+    void serialize();
+    void serializeLevels();
+    void serializeInto();
+    void serializeIntoInvalidSize();
+    void serializeNoLevels();
+    void deserializeInvalid();
+    void deserializeLevelOutOfRange();
+    void deserializeWrongDimensions();
 };
 
 template<class> struct MutabilityTraits;
@@ -109,6 +122,56 @@ struct {
     {"mutable", DataFlag::Mutable},
 };
 
+constexpr struct {
+    const char* name;
+    void(*corrupt)(Implementation::ImageDataChunk&);
+    const char* message;
+} DeserializeInvalidData[] {
+    {"invalid signature", [](Implementation::ImageDataChunk& chunk) {
+            chunk.header.magic[0] = 'P';
+        }, "invalid signature PLOB"},
+    {"wrong chunk type", [](Implementation::ImageDataChunk& chunk) {
+            chunk.header.type = DataChunkType::Mesh;
+        }, "expected a chunk of type Trade::DataChunkType::Image2D but got Trade::DataChunkType::Mesh"},
+    {"chunk smaller than header", [](Implementation::ImageDataChunk& chunk) {
+            chunk.header.size = 24;
+        }, "chunk size 24 out of range for 144 bytes of data"},
+    {"no levels", [](Implementation::ImageDataChunk& chunk) {
+            chunk.levelCount = 0;
+        }, "level count 0 out of range for a chunk of 144 bytes"},
+    {"level count out of range", [](Implementation::ImageDataChunk& chunk) {
+            chunk.levelCount = 2;
+        }, "level count 2 out of range for a chunk of 144 bytes"},
+    {"level data out of range", [](Implementation::ImageDataChunk& chunk) {
+            reinterpret_cast<Implementation::ImageDataChunkLevel*>(&chunk + 1)[0].dataSize = 25;
+        }, "data of level 0 out of range for a chunk of 144 bytes"},
+    {"level data misaligned", [](Implementation::ImageDataChunk& chunk) {
+            reinterpret_cast<Implementation::ImageDataChunkLevel*>(&chunk + 1)[0].dataOffset = 124;
+        }, "data of level 0 out of range for a chunk of 144 bytes"},
+    {"level data overlapping the level list", [](Implementation::ImageDataChunk& chunk) {
+            reinterpret_cast<Implementation::ImageDataChunkLevel*>(&chunk + 1)[0].dataOffset = 112;
+        }, "data of level 0 out of range for a chunk of 144 bytes"},
+    {"negative size", [](Implementation::ImageDataChunk& chunk) {
+            reinterpret_cast<Implementation::ImageDataChunkLevel*>(&chunk + 1)[0].size[1] = -1;
+        }, "invalid size or storage of level 0"},
+    {"invalid format", [](Implementation::ImageDataChunk& chunk) {
+            reinterpret_cast<Implementation::ImageDataChunkLevel*>(&chunk + 1)[0].format = 0;
+        }, "invalid format 0x0 of level 0"},
+    {"invalid compressed format", [](Implementation::ImageDataChunk& chunk) {
+            reinterpret_cast<Implementation::ImageDataChunkLevel*>(&chunk + 1)[0].compressed = 1;
+            reinterpret_cast<Implementation::ImageDataChunkLevel*>(&chunk + 1)[0].format = 0xffff;
+        }, "invalid format 0xffff of level 0"},
+    {"pixel size not matching format", [](Implementation::ImageDataChunk& chunk) {
+            reinterpret_cast<Implementation::ImageDataChunkLevel*>(&chunk + 1)[0].pixelSize = 4;
+        }, "invalid pixel size 4 of level 0"},
+    {"invalid alignment", [](Implementation::ImageDataChunk& chunk) {
+            reinterpret_cast<Implementation::ImageDataChunkLevel*>(&chunk + 1)[0].alignment = 3;
+        }, "invalid size or storage of level 0"},
+    {"data too small for the storage", [](Implementation::ImageDataChunk& chunk) {
+            reinterpret_cast<Implementation::ImageDataChunkLevel*>(&chunk + 1)[0].rowLength = 4;
+        }, "expected at least 36 bytes of data for level 0 but got 24"}
+};
+
 ImageDataTest::ImageDataTest() {
     addTests({&ImageDataTest::constructGeneric,
               &ImageDataTest::constructImplementationSpecific,
@@ -160,7 +223,19 @@ ImageDataTest::ImageDataTest() {
               &ImageDataTest::pixels1D,
               &ImageDataTest::pixels2D,
               &ImageDataTest::pixels3D,
-              &ImageDataTest::pixelsCompressed});
+              &ImageDataTest::pixelsCompressed,
+
+              &ImageDataTest::serialize,
+              &ImageDataTest::serializeLevels,
+              &ImageDataTest::serializeInto,
+              &ImageDataTest::serializeIntoInvalidSize,
+              &ImageDataTest::serializeNoLevels});
+
+    addInstancedTests({&ImageDataTest::deserializeInvalid},
+        Containers::arraySize(DeserializeInvalidData));
+
+    addTests({&ImageDataTest::deserializeLevelOutOfRange,
+              &ImageDataTest::deserializeWrongDimensions});
 }
 
 namespace GL {
@@ -1105,6 +1180,177 @@ void ImageDataTest::pixelsCompressed() {
     CORRADE_COMPARE(out.str(), "Trade::ImageData::pixels(): the image is compressed\n");
 }
 
+/* 2x3 RGB image with rows padded to four bytes, 24 bytes of data, 144 bytes
+   serialized */
+ImageData2D serializationTestImage() {
+    Containers::Array<char> data{Containers::InPlaceInit, {
+        'a', 'b', 'c', 'd', 'e', 'f', 0, 0,
+        'g', 'h', 'i', 'j', 'k', 'l', 0, 0,
+        'm', 'n', 'o', 'p', 'q', 'r', 0, 0}};
+    return ImageData2D{PixelStorage{}.setAlignment(4),
+        PixelFormat::RGB8Unorm, {2, 3}, std::move(data)};
+}
+
+void ImageDataTest::serialize() {
+    const ImageData2D image = serializationTestImage();
+    CORRADE_COMPARE(image.serializedSize(), 144);
+
+    Containers::Array<char> blob = image.serialize();
+    CORRADE_COMPARE(blob.size(), 144);
+    CORRADE_COMPARE(ImageData2D::deserializeLevelCount(blob), 1);
+
+    Containers::Optional<ImageData2D> out = ImageData2D::deserialize(blob);
+    CORRADE_VERIFY(out);
+
+    /* The data should be referenced directly, with nothing copied */
+    CORRADE_COMPARE(out->dataFlags(), DataFlags{});
+    CORRADE_COMPARE(static_cast<const void*>(out->data().data()), blob.data() + 120);
+    CORRADE_COMPARE(out->data().size(), 24);
+
+    CORRADE_VERIFY(!out->isCompressed());
+    CORRADE_COMPARE(out->storage().alignment(), 4);
+    CORRADE_COMPARE(out->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(out->formatExtra(), 0);
+    CORRADE_COMPARE(out->pixelSize(), 3);
+    CORRADE_COMPARE(out->size(), (Vector2i{2, 3}));
+    CORRADE_COMPARE(out->pixels<Color3ub>()[1][1], (Color3ub{'j', 'k', 'l'}));
+
+    /* Serializing the deserialized instance should give back the same
+       blob */
+    CORRADE_COMPARE_AS(out->serialize(), blob,
+        TestSuite::Compare::Container);
+}
+
+void ImageDataTest::serializeLevels() {
+    ImageData2D levels[]{
+        ImageData2D{PixelStorage{}.setRowLength(5),
+            PixelFormat::RGBA8Unorm, {4, 2}, Containers::Array<char>{Containers::ValueInit, 40}},
+        ImageData2D{PixelStorage{}.setAlignment(1),
+            GL::PixelFormat::RGB, GL::PixelType::UnsignedShort, {2, 1}, Containers::Array<char>{Containers::ValueInit, 12}},
+        ImageData2D{CompressedPixelStorage{}
+                .setCompressedBlockSize(Vector3i{4})
+                .setCompressedBlockDataSize(8),
+            CompressedPixelFormat::Bc1RGBAUnorm, {1, 1}, Containers::Array<char>{Containers::ValueInit, 8}}
+    };
+    levels[0].mutableData()[39] = 'x';
+    levels[1].mutableData()[11] = 'y';
+    levels[2].mutableData()[7] = 'z';
+
+    /* 32 bytes for the header, 3*88 for the level list, then 40, 12 + 4
+       bytes padding and 8 bytes of data */
+    CORRADE_COMPARE(ImageData2D::serializedSize(levels), 360);
+    Containers::Array<char> blob = ImageData2D::serialize(levels);
+    CORRADE_COMPARE(blob.size(), 360);
+    CORRADE_COMPARE(ImageData2D::deserializeLevelCount(blob), 3);
+
+    Containers::Optional<ImageData2D> level0 = ImageData2D::deserialize(blob, 0);
+    CORRADE_VERIFY(level0);
+    CORRADE_VERIFY(!level0->isCompressed());
+    CORRADE_COMPARE(level0->storage().rowLength(), 5);
+    CORRADE_COMPARE(level0->format(), PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE(level0->size(), (Vector2i{4, 2}));
+    CORRADE_COMPARE(static_cast<const void*>(level0->data().data()), blob.data() + 296);
+    CORRADE_COMPARE(level0->data().size(), 40);
+    CORRADE_COMPARE(level0->data()[39], 'x');
+
+    Containers::Optional<ImageData2D> level1 = ImageData2D::deserialize(blob, 1);
+    CORRADE_VERIFY(level1);
+    CORRADE_VERIFY(!level1->isCompressed());
+    CORRADE_COMPARE(level1->storage().alignment(), 1);
+    CORRADE_COMPARE(level1->format(), pixelFormatWrap(GL::PixelFormat::RGB));
+    CORRADE_COMPARE(level1->formatExtra(), UnsignedInt(GL::PixelType::UnsignedShort));
+    CORRADE_COMPARE(level1->pixelSize(), 6);
+    CORRADE_COMPARE(level1->size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(static_cast<const void*>(level1->data().data()), blob.data() + 336);
+    CORRADE_COMPARE(level1->data().size(), 12);
+    CORRADE_COMPARE(level1->data()[11], 'y');
+
+    Containers::Optional<ImageData2D> level2 = ImageData2D::deserialize(blob, 2);
+    CORRADE_VERIFY(level2);
+    CORRADE_VERIFY(level2->isCompressed());
+    CORRADE_COMPARE(level2->compressedStorage().compressedBlockSize(), Vector3i{4});
+    CORRADE_COMPARE(level2->compressedStorage().compressedBlockDataSize(), 8);
+    CORRADE_COMPARE(level2->compressedFormat(), CompressedPixelFormat::Bc1RGBAUnorm);
+    CORRADE_COMPARE(level2->size(), (Vector2i{1, 1}));
+    CORRADE_COMPARE(static_cast<const void*>(level2->data().data()), blob.data() + 352);
+    CORRADE_COMPARE(level2->data().size(), 8);
+    CORRADE_COMPARE(level2->data()[7], 'z');
+
+    /* The padding should be zero-filled */
+    CORRADE_COMPARE_AS(blob.slice(348, 352),
+        Containers::arrayView<char>({0, 0, 0, 0}),
+        TestSuite::Compare::Container);
+}
+
+void ImageDataTest::serializeInto() {
+    const ImageData2D image = serializationTestImage();
+
+    Containers::Array<char> blob{Containers::ValueInit, 144};
+    image.serializeInto(blob);
+    CORRADE_COMPARE_AS(blob, image.serialize(),
+        TestSuite::Compare::Container);
+}
+
+void ImageDataTest::serializeIntoInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const ImageData2D image = serializationTestImage();
+
+    Containers::Array<char> blob{Containers::ValueInit, 152};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    image.serializeInto(blob);
+    CORRADE_COMPARE(out.str(), "Trade::ImageData::serializeInto(): expected a view of 144 bytes but got 152\n");
+}
+
+void ImageDataTest::serializeNoLevels() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ImageData2D::serialize(nullptr);
+    CORRADE_COMPARE(out.str(), "Trade::ImageData::serialize(): expected at least one level\n");
+}
+
+void ImageDataTest::deserializeInvalid() {
+    auto&& data = DeserializeInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<char> blob = serializationTestImage().serialize();
+    data.corrupt(*reinterpret_cast<Implementation::ImageDataChunk*>(blob.data()));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_COMPARE(ImageData2D::deserializeLevelCount(blob), 0);
+    CORRADE_VERIFY(!ImageData2D::deserialize(blob));
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Trade::ImageData::deserializeLevelCount(): {0}\n"
+        "Trade::ImageData::deserialize(): {0}\n", data.message));
+}
+
+void ImageDataTest::deserializeLevelOutOfRange() {
+    Containers::Array<char> blob = serializationTestImage().serialize();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!ImageData2D::deserialize(blob, 1));
+    CORRADE_COMPARE(out.str(), "Trade::ImageData::deserialize(): level 1 out of range for 1 levels\n");
+}
+
+void ImageDataTest::deserializeWrongDimensions() {
+    Containers::Array<char> blob = serializationTestImage().serialize();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!ImageData3D::deserialize(blob));
+    CORRADE_COMPARE(out.str(), "Trade::ImageData::deserialize(): expected a chunk of type Trade::DataChunkType::Image3D but got Trade::DataChunkType::Image2D\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::ImageDataTest)
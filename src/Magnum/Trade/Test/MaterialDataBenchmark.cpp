@@ -0,0 +1,163 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Trade/MaterialCommonAttributes.h"
+#include "Magnum/Trade/MaterialData.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MaterialDataBenchmark: TestSuite::Tester {
+    explicit MaterialDataBenchmark();
+
+    void construct();
+
+    void lookupString();
+    void lookupName();
+    void bakeCommonAttributes();
+};
+
+using namespace Math::Literals;
+
+enum: std::size_t { MaterialCount = 100 };
+
+MaterialDataBenchmark::MaterialDataBenchmark() {
+    addBenchmarks({&MaterialDataBenchmark::construct,
+
+                   &MaterialDataBenchmark::lookupString,
+                   &MaterialDataBenchmark::lookupName,
+                   &MaterialDataBenchmark::bakeCommonAttributes}, 10);
+}
+
+/* A typical glTF material with a few extra attributes, queried as a renderer
+   would when filling a uniform buffer */
+MaterialData material(const UnsignedInt i) {
+    return MaterialData{MaterialType::PbrMetallicRoughness, {
+        {MaterialAttribute::BaseColor, 0x335566ff_rgbaf},
+        {MaterialAttribute::BaseColorTexture, i},
+        {MaterialAttribute::Metalness, 0.25f},
+        {MaterialAttribute::Roughness, 0.75f},
+        {MaterialAttribute::NoneRoughnessMetallicTexture, i + 1},
+        {MaterialAttribute::NormalTexture, i + 2},
+        {MaterialAttribute::NormalTextureScale, 0.5f},
+        {MaterialAttribute::OcclusionTexture, i + 3},
+        {MaterialAttribute::EmissiveColor, 0x111111_rgbf},
+        {MaterialAttribute::AlphaMask, 0.3f},
+        {MaterialAttribute::DoubleSided, true},
+        {"importerSpecificId", i},
+        {"extrasCustomFlag", true}
+    }};
+}
+
+Containers::Array<MaterialData> materials() {
+    Containers::Array<MaterialData> out;
+    arrayReserve(out, MaterialCount);
+    for(UnsignedInt i = 0; i != MaterialCount; ++i)
+        arrayAppend(out, Containers::InPlaceInit, material(i));
+    return out;
+}
+
+void MaterialDataBenchmark::construct() {
+    UnsignedInt count = 0;
+    CORRADE_BENCHMARK(1) {
+        for(UnsignedInt i = 0; i != MaterialCount; ++i)
+            count += material(i).attributeCount();
+    }
+
+    CORRADE_COMPARE(count, UnsignedInt(MaterialCount*13));
+}
+
+void MaterialDataBenchmark::lookupString() {
+    Containers::Array<MaterialData> data = materials();
+
+    MaterialCommonAttributes out;
+    CORRADE_BENCHMARK(1) {
+        for(const MaterialData& material: data) {
+            out.baseColor = material.attributeOr("BaseColor", 0xffffffff_rgbaf);
+            out.emissiveColor = material.attributeOr("EmissiveColor", 0x000000_rgbf);
+            out.metalness = material.attributeOr("Metalness", 1.0f);
+            out.roughness = material.attributeOr("Roughness", 1.0f);
+            out.alphaMask = material.attributeOr("AlphaMask", 0.5f);
+            out.normalTextureScale = material.attributeOr("NormalTextureScale", 1.0f);
+            out.occlusionTextureStrength = material.attributeOr("OcclusionTextureStrength", 1.0f);
+            out.baseColorTexture = material.attributeOr("BaseColorTexture", ~UnsignedInt{});
+            out.metalnessTexture = out.roughnessTexture = material.attributeOr("NoneRoughnessMetallicTexture", ~UnsignedInt{});
+            out.normalTexture = material.attributeOr("NormalTexture", ~UnsignedInt{});
+            out.occlusionTexture = material.attributeOr("OcclusionTexture", ~UnsignedInt{});
+            out.emissiveTexture = material.attributeOr("EmissiveTexture", ~UnsignedInt{});
+            out.doubleSided = material.attributeOr("DoubleSided", false);
+        }
+    }
+
+    CORRADE_COMPARE(out.baseColorTexture, UnsignedInt(MaterialCount - 1));
+    CORRADE_COMPARE(out.roughness, 0.75f);
+}
+
+void MaterialDataBenchmark::lookupName() {
+    Containers::Array<MaterialData> data = materials();
+
+    MaterialCommonAttributes out;
+    CORRADE_BENCHMARK(1) {
+        for(const MaterialData& material: data) {
+            out.baseColor = material.attributeOr(MaterialAttribute::BaseColor, 0xffffffff_rgbaf);
+            out.emissiveColor = material.attributeOr(MaterialAttribute::EmissiveColor, 0x000000_rgbf);
+            out.metalness = material.attributeOr(MaterialAttribute::Metalness, 1.0f);
+            out.roughness = material.attributeOr(MaterialAttribute::Roughness, 1.0f);
+            out.alphaMask = material.attributeOr(MaterialAttribute::AlphaMask, 0.5f);
+            out.normalTextureScale = material.attributeOr(MaterialAttribute::NormalTextureScale, 1.0f);
+            out.occlusionTextureStrength = material.attributeOr(MaterialAttribute::OcclusionTextureStrength, 1.0f);
+            out.baseColorTexture = material.attributeOr(MaterialAttribute::BaseColorTexture, ~UnsignedInt{});
+            out.metalnessTexture = out.roughnessTexture = material.attributeOr(MaterialAttribute::NoneRoughnessMetallicTexture, ~UnsignedInt{});
+            out.normalTexture = material.attributeOr(MaterialAttribute::NormalTexture, ~UnsignedInt{});
+            out.occlusionTexture = material.attributeOr(MaterialAttribute::OcclusionTexture, ~UnsignedInt{});
+            out.emissiveTexture = material.attributeOr(MaterialAttribute::EmissiveTexture, ~UnsignedInt{});
+            out.doubleSided = material.attributeOr(MaterialAttribute::DoubleSided, false);
+        }
+    }
+
+    CORRADE_COMPARE(out.baseColorTexture, UnsignedInt(MaterialCount - 1));
+    CORRADE_COMPARE(out.roughness, 0.75f);
+}
+
+void MaterialDataBenchmark::bakeCommonAttributes() {
+    Containers::Array<MaterialData> data = materials();
+
+    MaterialCommonAttributes out;
+    CORRADE_BENCHMARK(1) {
+        for(const MaterialData& material: data)
+            out = material.bakeCommonAttributes();
+    }
+
+    CORRADE_COMPARE(out.baseColorTexture, UnsignedInt(MaterialCount - 1));
+    CORRADE_COMPARE(out.roughness, 0.75f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MaterialDataBenchmark)
@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/StaticArray.h>
 #include <Corrade/Containers/StringStl.h>
 #include <Corrade/TestSuite/Tester.h>
@@ -35,6 +36,7 @@
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Trade/FlatMaterialData.h"
+#include "Magnum/Trade/MaterialCommonAttributes.h"
 #include "Magnum/Trade/MaterialData.h"
 #include "Magnum/Trade/PbrClearCoatMaterialData.h"
 #include "Magnum/Trade/PbrMetallicRoughnessMaterialData.h"
@@ -139,6 +141,16 @@ class MaterialDataTest: public TestSuite::Tester {
         void releaseAttributes();
         void releaseLayers();
 
+        void lookup();
+        void lookupTooManyAttributes();
+        void lookupReleasedLayers();
+
+        void bakeCommonAttributes();
+        void bakeCommonAttributesDefaults();
+        void bakeCommonAttributesPackedMetallicRoughness();
+        void bakeCommonAttributesLayer();
+        void bakeCommonAttributesLayerOutOfBounds();
+
         #ifdef MAGNUM_BUILD_DEPRECATED
         void constructPhongDeprecated();
         void constructPhongDeprecatedTextured();
@@ -386,6 +398,16 @@ MaterialDataTest::MaterialDataTest() {
               &MaterialDataTest::releaseAttributes,
               &MaterialDataTest::releaseLayers,
 
+              &MaterialDataTest::lookup,
+              &MaterialDataTest::lookupTooManyAttributes,
+              &MaterialDataTest::lookupReleasedLayers,
+
+              &MaterialDataTest::bakeCommonAttributes,
+              &MaterialDataTest::bakeCommonAttributesDefaults,
+              &MaterialDataTest::bakeCommonAttributesPackedMetallicRoughness,
+              &MaterialDataTest::bakeCommonAttributesLayer,
+              &MaterialDataTest::bakeCommonAttributesLayerOutOfBounds,
+
               #ifdef MAGNUM_BUILD_DEPRECATED
               &MaterialDataTest::constructPhongDeprecated,
               &MaterialDataTest::constructPhongDeprecatedTextured,
@@ -2585,6 +2607,251 @@ void MaterialDataTest::releaseLayers() {
     CORRADE_COMPARE(data.attributeCount(), 2);
 }
 
+void MaterialDataTest::lookup() {
+    /* Custom attributes interleaved with the builtin ones, which the lookup
+       table construction has to skip */
+    MaterialData data{{}, {
+        {"aCustom", 5u},
+        {MaterialAttribute::DiffuseColor, 0xff3366aa_rgbaf},
+        {"DiffuseColorCustom", 7u},
+        {MaterialAttribute::AlphaMask, 0.25f},
+        {"zzz", 3.0f},
+
+        {MaterialLayer::ClearCoat},
+        {MaterialAttribute::LayerFactor, 0.5f},
+        {MaterialAttribute::Roughness, 0.75f},
+        {"customLayerAttribute", 1u},
+
+        /* Empty layer */
+    }, {5, 9, 9}};
+
+    CORRADE_VERIFY(data.hasAttribute(MaterialAttribute::DiffuseColor));
+    CORRADE_VERIFY(data.hasAttribute(MaterialAttribute::AlphaMask));
+    CORRADE_VERIFY(!data.hasAttribute(MaterialAttribute::Roughness));
+    CORRADE_VERIFY(!data.hasAttribute(MaterialAttribute::LayerName));
+    CORRADE_COMPARE(data.attributeId(MaterialAttribute::AlphaMask), 0);
+    CORRADE_COMPARE(data.attributeId(MaterialAttribute::DiffuseColor), 1);
+    CORRADE_COMPARE(data.attributeType(MaterialAttribute::AlphaMask), MaterialAttributeType::Float);
+    CORRADE_COMPARE(data.attribute<Color4>(MaterialAttribute::DiffuseColor), 0xff3366aa_rgbaf);
+    CORRADE_COMPARE(*static_cast<const Float*>(data.attribute(MaterialAttribute::AlphaMask)), 0.25f);
+    CORRADE_COMPARE(*data.tryAttribute<Float>(MaterialAttribute::AlphaMask), 0.25f);
+    CORRADE_VERIFY(!data.tryAttribute(MaterialAttribute::Roughness));
+    CORRADE_COMPARE(data.attributeOr(MaterialAttribute::Roughness, 1.5f), 1.5f);
+
+    CORRADE_VERIFY(data.hasAttribute(1, MaterialAttribute::LayerName));
+    CORRADE_VERIFY(data.hasAttribute(1, MaterialAttribute::Roughness));
+    CORRADE_VERIFY(!data.hasAttribute(1, MaterialAttribute::DiffuseColor));
+    CORRADE_COMPARE(data.attributeId(1, MaterialAttribute::LayerName), 0);
+    CORRADE_COMPARE(data.attributeId(1, MaterialAttribute::LayerFactor), 1);
+    CORRADE_COMPARE(data.attributeId(1, MaterialAttribute::Roughness), 2);
+    CORRADE_COMPARE(data.attribute<Float>(1, MaterialAttribute::Roughness), 0.75f);
+    CORRADE_COMPARE(data.attributeOr(1, MaterialAttribute::Metalness, 0.125f), 0.125f);
+
+    CORRADE_VERIFY(!data.hasAttribute(2, MaterialAttribute::LayerName));
+    CORRADE_VERIFY(!data.tryAttribute(2, MaterialAttribute::Roughness));
+}
+
+void MaterialDataTest::lookupTooManyAttributes() {
+    /* With more than 254 attributes in a layer the lookup table isn't built
+       and it should fall back to a binary search */
+    Containers::Array<MaterialAttributeData> attributes;
+    for(UnsignedInt i = 0; i != 300; ++i)
+        arrayAppend(attributes, Containers::InPlaceInit, "custom" + std::to_string(i), i);
+    arrayAppend(attributes, Containers::InPlaceInit, MaterialAttribute::Shininess, 96.0f);
+    arrayAppend(attributes, Containers::InPlaceInit, MaterialAttribute::BaseColor, 0x336699ff_rgbaf);
+
+    MaterialData data{{}, std::move(attributes)};
+    CORRADE_COMPARE(data.attributeCount(), 302);
+    CORRADE_VERIFY(!data.hasAttribute(MaterialAttribute::DiffuseColor));
+    CORRADE_COMPARE(data.attributeId(MaterialAttribute::BaseColor), 0);
+    CORRADE_COMPARE(data.attributeId(MaterialAttribute::Shininess), 1);
+    CORRADE_COMPARE(data.attribute<Float>(MaterialAttribute::Shininess), 96.0f);
+    CORRADE_COMPARE(data.attribute<UnsignedInt>("custom123"), 123);
+
+    MaterialCommonAttributes baked = data.bakeCommonAttributes();
+    CORRADE_COMPARE(baked.baseColor, 0x336699ff_rgbaf);
+    CORRADE_COMPARE(baked.shininess, 96.0f);
+}
+
+void MaterialDataTest::lookupReleasedLayers() {
+    MaterialData data{{}, {
+        {MaterialAttribute::DiffuseColor, 0xff3366aa_rgbaf},
+        {MaterialAttribute::NormalTexture, 0u}
+    }, {1, 2}};
+
+    CORRADE_VERIFY(!data.hasAttribute(MaterialAttribute::NormalTexture));
+
+    /* After releasing the layer data the base material contains all
+       attributes, the lookup table shouldn't be used anymore */
+    data.releaseLayerData();
+    CORRADE_VERIFY(data.hasAttribute(MaterialAttribute::NormalTexture));
+    CORRADE_COMPARE(data.attributeId(MaterialAttribute::NormalTexture), 1);
+
+    data.releaseAttributeData();
+    CORRADE_VERIFY(!data.hasAttribute(MaterialAttribute::DiffuseColor));
+}
+
+void MaterialDataTest::bakeCommonAttributes() {
+    MaterialData data{MaterialType::PbrMetallicRoughness|MaterialType::Phong, {
+        {MaterialAttribute::BaseColor, 0x335566ff_rgbaf},
+        {MaterialAttribute::AmbientColor, 0x111111ff_rgbaf},
+        {MaterialAttribute::AmbientTexture, 1u},
+        {MaterialAttribute::DiffuseColor, 0x222222ff_rgbaf},
+        {MaterialAttribute::DiffuseTexture, 2u},
+        {MaterialAttribute::SpecularColor, 0x33333333_rgbaf},
+        {MaterialAttribute::SpecularTexture, 3u},
+        {MaterialAttribute::EmissiveColor, 0x444444_rgbf},
+        {MaterialAttribute::EmissiveTexture, 4u},
+        {MaterialAttribute::TextureMatrix, Matrix3::scaling({0.5f, 1.0f})},
+        {MaterialAttribute::TextureCoordinates, 2u},
+        {MaterialAttribute::Metalness, 0.25f},
+        {MaterialAttribute::MetalnessTexture, 5u},
+        {MaterialAttribute::MetalnessTextureSwizzle, MaterialTextureSwizzle::A},
+        {MaterialAttribute::Roughness, 0.75f},
+        {MaterialAttribute::RoughnessTexture, 6u},
+        {MaterialAttribute::Shininess, 96.0f},
+        {MaterialAttribute::AlphaBlend, true},
+        {MaterialAttribute::AlphaMask, 0.3f},
+        {MaterialAttribute::DoubleSided, true},
+        {MaterialAttribute::BaseColorTexture, 7u},
+        {MaterialAttribute::NormalTexture, 8u},
+        {MaterialAttribute::NormalTextureScale, 0.5f},
+        {MaterialAttribute::OcclusionTexture, 9u},
+        {MaterialAttribute::OcclusionTextureStrength, 0.125f},
+        {"customAttribute", 10u}
+    }};
+
+    MaterialCommonAttributes baked = data.bakeCommonAttributes();
+    CORRADE_COMPARE(baked.baseColor, 0x335566ff_rgbaf);
+    CORRADE_COMPARE(baked.ambientColor, 0x111111ff_rgbaf);
+    CORRADE_COMPARE(baked.diffuseColor, 0x222222ff_rgbaf);
+    CORRADE_COMPARE(baked.specularColor, 0x33333333_rgbaf);
+    CORRADE_COMPARE(baked.emissiveColor, 0x444444_rgbf);
+    CORRADE_COMPARE(baked.textureMatrix, Matrix3::scaling({0.5f, 1.0f}));
+    CORRADE_COMPARE(baked.metalness, 0.25f);
+    CORRADE_COMPARE(baked.roughness, 0.75f);
+    CORRADE_COMPARE(baked.shininess, 96.0f);
+    CORRADE_COMPARE(baked.alphaMask, 0.3f);
+    CORRADE_COMPARE(baked.normalTextureScale, 0.5f);
+    CORRADE_COMPARE(baked.occlusionTextureStrength, 0.125f);
+    CORRADE_COMPARE(baked.baseColorTexture, 7);
+    CORRADE_COMPARE(baked.metalnessTexture, 5);
+    CORRADE_COMPARE(baked.roughnessTexture, 6);
+    CORRADE_COMPARE(baked.normalTexture, 8);
+    CORRADE_COMPARE(baked.occlusionTexture, 9);
+    CORRADE_COMPARE(baked.emissiveTexture, 4);
+    CORRADE_COMPARE(baked.ambientTexture, 1);
+    CORRADE_COMPARE(baked.diffuseTexture, 2);
+    CORRADE_COMPARE(baked.specularTexture, 3);
+    CORRADE_COMPARE(baked.textureCoordinates, 2);
+    CORRADE_COMPARE(baked.metalnessTextureSwizzle, MaterialTextureSwizzle::A);
+    CORRADE_COMPARE(baked.roughnessTextureSwizzle, MaterialTextureSwizzle::R);
+    CORRADE_COMPARE(baked.alphaMode, MaterialAlphaMode::Blend);
+    CORRADE_VERIFY(baked.doubleSided);
+}
+
+void MaterialDataTest::bakeCommonAttributesDefaults() {
+    MaterialData data{{}, {
+        {"customAttribute", 10u}
+    }};
+
+    const PbrMetallicRoughnessMaterialData& pbr = data.as<PbrMetallicRoughnessMaterialData>();
+    const PhongMaterialData& phong = data.as<PhongMaterialData>();
+
+    MaterialCommonAttributes baked = data.bakeCommonAttributes();
+    CORRADE_COMPARE(baked.baseColor, pbr.baseColor());
+    CORRADE_COMPARE(baked.ambientColor, phong.ambientColor());
+    CORRADE_COMPARE(baked.diffuseColor, phong.diffuseColor());
+    CORRADE_COMPARE(baked.specularColor, phong.specularColor());
+    CORRADE_COMPARE(baked.emissiveColor, pbr.emissiveColor());
+    CORRADE_COMPARE(baked.textureMatrix, Matrix3{});
+    CORRADE_COMPARE(baked.metalness, pbr.metalness());
+    CORRADE_COMPARE(baked.roughness, pbr.roughness());
+    CORRADE_COMPARE(baked.shininess, phong.shininess());
+    CORRADE_COMPARE(baked.alphaMask, data.alphaMask());
+    CORRADE_COMPARE(baked.normalTextureScale, 1.0f);
+    CORRADE_COMPARE(baked.occlusionTextureStrength, 1.0f);
+    CORRADE_COMPARE(baked.baseColorTexture, ~UnsignedInt{});
+    CORRADE_COMPARE(baked.metalnessTexture, ~UnsignedInt{});
+    CORRADE_COMPARE(baked.roughnessTexture, ~UnsignedInt{});
+    CORRADE_COMPARE(baked.normalTexture, ~UnsignedInt{});
+    CORRADE_COMPARE(baked.occlusionTexture, ~UnsignedInt{});
+    CORRADE_COMPARE(baked.emissiveTexture, ~UnsignedInt{});
+    CORRADE_COMPARE(baked.ambientTexture, ~UnsignedInt{});
+    CORRADE_COMPARE(baked.diffuseTexture, ~UnsignedInt{});
+    CORRADE_COMPARE(baked.specularTexture, ~UnsignedInt{});
+    CORRADE_COMPARE(baked.textureCoordinates, 0);
+    CORRADE_COMPARE(baked.metalnessTextureSwizzle, MaterialTextureSwizzle::R);
+    CORRADE_COMPARE(baked.roughnessTextureSwizzle, MaterialTextureSwizzle::R);
+    CORRADE_COMPARE(baked.alphaMode, data.alphaMode());
+    CORRADE_COMPARE(baked.doubleSided, data.isDoubleSided());
+
+    /* Ambient color defaults to white if there's an ambient texture */
+    MaterialData textured{{}, {
+        {MaterialAttribute::AmbientTexture, 3u},
+        {MaterialAttribute::AlphaMask, 0.25f}
+    }};
+    MaterialCommonAttributes bakedTextured = textured.bakeCommonAttributes();
+    CORRADE_COMPARE(bakedTextured.ambientTexture, 3);
+    CORRADE_COMPARE(bakedTextured.ambientColor, textured.as<PhongMaterialData>().ambientColor());
+    CORRADE_COMPARE(bakedTextured.alphaMode, MaterialAlphaMode::Mask);
+}
+
+void MaterialDataTest::bakeCommonAttributesPackedMetallicRoughness() {
+    MaterialData data{{}, {
+        {MaterialAttribute::NoneRoughnessMetallicTexture, 2u},
+        /* These are ignored in favor of the packed texture */
+        {MaterialAttribute::MetalnessTexture, 3u},
+        {MaterialAttribute::MetalnessTextureSwizzle, MaterialTextureSwizzle::A}
+    }};
+
+    const PbrMetallicRoughnessMaterialData& pbr = data.as<PbrMetallicRoughnessMaterialData>();
+
+    MaterialCommonAttributes baked = data.bakeCommonAttributes();
+    CORRADE_COMPARE(baked.metalnessTexture, pbr.metalnessTexture());
+    CORRADE_COMPARE(baked.metalnessTextureSwizzle, pbr.metalnessTextureSwizzle());
+    CORRADE_COMPARE(baked.roughnessTexture, pbr.roughnessTexture());
+    CORRADE_COMPARE(baked.roughnessTextureSwizzle, pbr.roughnessTextureSwizzle());
+    CORRADE_COMPARE(baked.metalnessTexture, 2);
+    CORRADE_COMPARE(baked.metalnessTextureSwizzle, MaterialTextureSwizzle::B);
+    CORRADE_COMPARE(baked.roughnessTextureSwizzle, MaterialTextureSwizzle::G);
+}
+
+void MaterialDataTest::bakeCommonAttributesLayer() {
+    MaterialData data{{}, {
+        {MaterialAttribute::Roughness, 0.5f},
+        {MaterialAttribute::NormalTexture, 2u},
+
+        {MaterialLayer::ClearCoat},
+        {MaterialAttribute::Roughness, 0.25f},
+        {MaterialAttribute::NormalTexture, 5u},
+    }, {2, 5}};
+
+    MaterialCommonAttributes base = data.bakeCommonAttributes();
+    CORRADE_COMPARE(base.roughness, 0.5f);
+    CORRADE_COMPARE(base.normalTexture, 2);
+
+    MaterialCommonAttributes layer = data.bakeCommonAttributes(1);
+    CORRADE_COMPARE(layer.roughness, 0.25f);
+    CORRADE_COMPARE(layer.normalTexture, 5);
+}
+
+void MaterialDataTest::bakeCommonAttributesLayerOutOfBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    MaterialData data{{}, {
+        {MaterialAttribute::AlphaMask, 0.5f}
+    }, {0, 1}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    data.bakeCommonAttributes(2);
+    CORRADE_COMPARE(out.str(),
+        "Trade::MaterialData::bakeCommonAttributes(): index 2 out of range for 2 layers\n");
+}
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 void MaterialDataTest::constructPhongDeprecated() {
     const int a{};
@@ -24,13 +24,17 @@
 */
 
 #include <sstream>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/FormatStl.h>
 
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Half.h"
 #include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/Implementation/serialization.h"
 
 namespace Magnum { namespace Trade { namespace Test { namespace {
 
@@ -167,6 +171,15 @@ struct MeshDataTest: TestSuite::Tester {
     void releaseIndexData();
     void releaseAttributeData();
     void releaseVertexData();
+
+    void serialize();
+    void serializeNotIndexedNoAttributes();
+    void serializeNoVertices();
+    void serializeInto();
+    void serializeIntoInvalidSize();
+    void serializeIntoMisaligned();
+    void deserializeInvalid();
+    void deserializeMisaligned();
 };
 
 const struct {
@@ -197,6 +210,67 @@ const struct {
     {"mutable", DataFlag::Mutable}
 };
 
+/* The offsets and sizes assume the mesh from serializationTestMesh(), which
+   serializes into 224 bytes --- 72 bytes of a header, 3*24 bytes of
+   attributes, 14 bytes of index data padded to 16 and 60 bytes of vertex data
+   padded to 64 */
+const struct {
+    const char* name;
+    void(*corrupt)(Implementation::MeshDataChunk&);
+    std::size_t size;
+    const char* message;
+} DeserializeInvalidData[] {
+    {"short header", nullptr, 23,
+        "expected at least 24 bytes for a header but got 23"},
+    {"invalid signature", [](Implementation::MeshDataChunk& chunk) {
+            chunk.header.magic[3] = 'H';
+        }, 0, "invalid signature BLOH"},
+    {"different endianness", [](Implementation::MeshDataChunk& chunk) {
+            chunk.header.endianness = 0x3412;
+        }, 0, "data have a different endianness than the host"},
+    {"unsupported version", [](Implementation::MeshDataChunk& chunk) {
+            chunk.header.version = 1;
+        }, 0, "unsupported version 1, expected 0"},
+    {"wrong chunk type", [](Implementation::MeshDataChunk& chunk) {
+            chunk.header.type = DataChunkType::Image2D;
+        }, 0, "expected a chunk of type Trade::DataChunkType::Mesh but got Trade::DataChunkType::Image2D"},
+    {"chunk larger than data", nullptr, 216,
+        "chunk size 224 out of range for 216 bytes of data"},
+    {"chunk smaller than header", [](Implementation::MeshDataChunk& chunk) {
+            chunk.header.size = 64;
+        }, 0, "chunk size 64 out of range for 224 bytes of data"},
+    {"attribute count out of range", [](Implementation::MeshDataChunk& chunk) {
+            chunk.attributeCount = 100;
+        }, 0, "index data out of range for a chunk of 224 bytes"},
+    {"index data out of range", [](Implementation::MeshDataChunk& chunk) {
+            chunk.indexDataSize = 100;
+        }, 0, "index data out of range for a chunk of 224 bytes"},
+    {"vertex data out of range", [](Implementation::MeshDataChunk& chunk) {
+            chunk.vertexDataSize = 65;
+        }, 0, "vertex data out of range for a chunk of 224 bytes"},
+    {"invalid index type", [](Implementation::MeshDataChunk& chunk) {
+            chunk.indexType = 4;
+        }, 0, "invalid index type 0x4"},
+    {"indices out of range", [](Implementation::MeshDataChunk& chunk) {
+            chunk.indexCount = 7;
+        }, 0, "indices out of range for 14 bytes of index data"},
+    {"index data for a non-indexed mesh", [](Implementation::MeshDataChunk& chunk) {
+            chunk.indexType = 0;
+        }, 0, "index data specified for a non-indexed mesh"},
+    {"invalid vertex format", [](Implementation::MeshDataChunk& chunk) {
+            reinterpret_cast<Implementation::MeshDataChunkAttribute*>(&chunk + 1)[1].format = 0;
+        }, 0, "invalid format 0x0 for attribute 1"},
+    {"format not compatible with attribute", [](Implementation::MeshDataChunk& chunk) {
+            reinterpret_cast<Implementation::MeshDataChunkAttribute*>(&chunk + 1)[0].format = UnsignedInt(VertexFormat::Float);
+        }, 0, "invalid layout of attribute 0"},
+    {"array of a builtin attribute", [](Implementation::MeshDataChunk& chunk) {
+            reinterpret_cast<Implementation::MeshDataChunkAttribute*>(&chunk + 1)[0].arraySize = 2;
+        }, 0, "invalid layout of attribute 0"},
+    {"attribute out of range", [](Implementation::MeshDataChunk& chunk) {
+            reinterpret_cast<Implementation::MeshDataChunkAttribute*>(&chunk + 1)[1].offset = 48;
+        }, 0, "attribute 1 out of range for 60 bytes of vertex data"}
+};
+
 MeshDataTest::MeshDataTest() {
     addTests({&MeshDataTest::customAttributeName,
               &MeshDataTest::customAttributeNameTooLarge,
@@ -387,7 +461,19 @@ MeshDataTest::MeshDataTest() {
 
               &MeshDataTest::releaseIndexData,
               &MeshDataTest::releaseAttributeData,
-              &MeshDataTest::releaseVertexData});
+              &MeshDataTest::releaseVertexData,
+
+              &MeshDataTest::serialize,
+              &MeshDataTest::serializeNotIndexedNoAttributes,
+              &MeshDataTest::serializeNoVertices,
+              &MeshDataTest::serializeInto,
+              &MeshDataTest::serializeIntoInvalidSize,
+              &MeshDataTest::serializeIntoMisaligned});
+
+    addInstancedTests({&MeshDataTest::deserializeInvalid},
+        Containers::arraySize(DeserializeInvalidData));
+
+    addTests({&MeshDataTest::deserializeMisaligned});
 }
 
 void MeshDataTest::customAttributeName() {
@@ -3006,6 +3092,215 @@ void MeshDataTest::releaseVertexData() {
     CORRADE_COMPARE(data.attributeOffset(0), 48);
 }
 
+MeshData serializationTestMesh() {
+    struct Vertex {
+        UnsignedShort ids[2];
+        Vector3 position;
+        UnsignedInt implementationSpecific;
+    };
+
+    /* Indices not at the start of the index data to verify the offset is
+       preserved */
+    Containers::Array<char> indexData{Containers::ValueInit, 2 + 6*sizeof(UnsignedShort)};
+    auto indices = Containers::arrayCast<UnsignedShort>(indexData.suffix(2));
+    Utility::copy(Containers::arrayView<UnsignedShort>({0, 1, 2, 2, 1, 0}), indices);
+
+    Containers::Array<char> vertexData{Containers::ValueInit, 3*sizeof(Vertex)};
+    auto vertices = Containers::arrayCast<Vertex>(vertexData);
+    vertices[0] = {{1, 2}, {1.0f, 2.0f, 3.0f}, 0xaa};
+    vertices[1] = {{3, 4}, {4.0f, 5.0f, 6.0f}, 0xbb};
+    vertices[2] = {{5, 6}, {7.0f, 8.0f, 9.0f}, 0xcc};
+
+    return MeshData{MeshPrimitive::Triangles,
+        std::move(indexData), MeshIndexData{indices},
+        std::move(vertexData), {
+            MeshAttributeData{MeshAttribute::Position,
+                Containers::StridedArrayView1D<const Vector3>{vertices, &vertices[0].position, vertices.size(), sizeof(Vertex)}},
+            /* Offset-only and an array */
+            MeshAttributeData{meshAttributeCustom(13), VertexFormat::UnsignedShort, offsetof(Vertex, ids), 3, sizeof(Vertex), 2},
+            MeshAttributeData{MeshAttribute::ObjectId, vertexFormatWrap(0xcaca),
+                Containers::StridedArrayView1D<const void>{Containers::StridedArrayView1D<const UnsignedInt>{vertices, &vertices[0].implementationSpecific, vertices.size(), sizeof(Vertex)}}}
+        }};
+}
+
+void MeshDataTest::serialize() {
+    const MeshData data = serializationTestMesh();
+    CORRADE_COMPARE(data.serializedSize(), 224);
+
+    Containers::Array<char> blob = data.serialize();
+    CORRADE_COMPARE(blob.size(), 224);
+
+    Containers::Optional<MeshData> out = MeshData::deserialize(blob);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(out->primitive(), MeshPrimitive::Triangles);
+
+    /* The data should be referenced directly, with nothing copied */
+    CORRADE_COMPARE(out->indexDataFlags(), DataFlags{});
+    CORRADE_COMPARE(out->vertexDataFlags(), DataFlags{});
+    CORRADE_COMPARE(static_cast<const void*>(out->indexData().data()), blob.data() + 144);
+    CORRADE_COMPARE(out->indexData().size(), 14);
+    CORRADE_COMPARE(static_cast<const void*>(out->vertexData().data()), blob.data() + 160);
+    CORRADE_COMPARE(out->vertexData().size(), 60);
+
+    CORRADE_VERIFY(out->isIndexed());
+    CORRADE_COMPARE(out->indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(out->indexOffset(), 2);
+    CORRADE_COMPARE_AS(out->indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({0, 1, 2, 2, 1, 0}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(out->vertexCount(), 3);
+    CORRADE_COMPARE(out->attributeCount(), 3);
+    CORRADE_COMPARE(out->attributeName(0), MeshAttribute::Position);
+    CORRADE_COMPARE(out->attributeFormat(0), VertexFormat::Vector3);
+    CORRADE_COMPARE(out->attributeOffset(0), 4);
+    CORRADE_COMPARE(out->attributeStride(0), 20);
+    CORRADE_COMPARE(out->attributeArraySize(0), 0);
+    CORRADE_COMPARE_AS(out->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}, {7.0f, 8.0f, 9.0f}
+        }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(out->attributeName(1), meshAttributeCustom(13));
+    CORRADE_COMPARE(out->attributeFormat(1), VertexFormat::UnsignedShort);
+    CORRADE_COMPARE(out->attributeOffset(1), 0);
+    CORRADE_COMPARE(out->attributeStride(1), 20);
+    CORRADE_COMPARE(out->attributeArraySize(1), 2);
+    Containers::StridedArrayView2D<const UnsignedShort> ids = out->attribute<UnsignedShort[]>(1);
+    CORRADE_COMPARE(ids[0][1], 2);
+    CORRADE_COMPARE(ids[2][0], 5);
+
+    CORRADE_COMPARE(out->attributeName(2), MeshAttribute::ObjectId);
+    CORRADE_COMPARE(out->attributeFormat(2), vertexFormatWrap(0xcaca));
+    CORRADE_COMPARE(out->attributeOffset(2), 16);
+    CORRADE_COMPARE(out->attributeStride(2), 20);
+    CORRADE_COMPARE_AS((Containers::arrayCast<1, const UnsignedInt>(out->attribute(2).prefix({3, 4}))),
+        Containers::arrayView<UnsignedInt>({0xaa, 0xbb, 0xcc}),
+        TestSuite::Compare::Container);
+
+    /* Serializing the deserialized instance should give back the same
+       blob */
+    CORRADE_COMPARE_AS(out->serialize(), blob,
+        TestSuite::Compare::Container);
+}
+
+void MeshDataTest::serializeNotIndexedNoAttributes() {
+    const MeshData data{meshPrimitiveWrap(0xfeed), 15};
+    CORRADE_COMPARE(data.serializedSize(), 72);
+
+    Containers::Array<char> blob = data.serialize();
+    Containers::Optional<MeshData> out = MeshData::deserialize(blob);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(out->primitive(), meshPrimitiveWrap(0xfeed));
+    CORRADE_VERIFY(!out->isIndexed());
+    CORRADE_COMPARE(out->indexData().size(), 0);
+    CORRADE_COMPARE(out->vertexCount(), 15);
+    CORRADE_COMPARE(out->attributeCount(), 0);
+    CORRADE_COMPARE(out->vertexData().size(), 0);
+}
+
+void MeshDataTest::serializeNoVertices() {
+    /* The attribute view doesn't point into the (empty) vertex data, which
+       is allowed for zero vertices */
+    const Vector3 position;
+    const MeshData data{MeshPrimitive::Triangles, nullptr, {
+        MeshAttributeData{MeshAttribute::Position,
+            Containers::StridedArrayView1D<const Vector3>{{&position, 0}, 0, 12}},
+        MeshAttributeData{MeshAttribute::Normal, VertexFormat::Vector3, 0, 0, 12}
+    }};
+    CORRADE_COMPARE(data.serializedSize(), 120);
+
+    Containers::Array<char> blob = data.serialize();
+    Containers::Optional<MeshData> out = MeshData::deserialize(blob);
+    CORRADE_VERIFY(out);
+    CORRADE_COMPARE(out->vertexCount(), 0);
+    CORRADE_COMPARE(out->vertexData().size(), 0);
+    CORRADE_COMPARE(out->attributeCount(), 2);
+    CORRADE_COMPARE(out->attributeName(0), MeshAttribute::Position);
+    CORRADE_COMPARE(out->attributeFormat(0), VertexFormat::Vector3);
+    CORRADE_COMPARE(out->attributeOffset(0), 0);
+    CORRADE_COMPARE(out->attributeStride(0), 12);
+    CORRADE_COMPARE(out->attributeName(1), MeshAttribute::Normal);
+    CORRADE_COMPARE(out->attributeOffset(1), 0);
+    CORRADE_COMPARE(out->attributeStride(1), 12);
+
+    /* Serializing the deserialized instance should give back the same
+       blob */
+    CORRADE_COMPARE_AS(out->serialize(), blob,
+        TestSuite::Compare::Container);
+}
+
+void MeshDataTest::serializeInto() {
+    const MeshData data = serializationTestMesh();
+
+    /* The padding should be cleared, so the output is the same regardless of
+       what was in the destination before */
+    Containers::Array<char> out{Containers::DirectInit, data.serializedSize(), '\xff'};
+    data.serializeInto(out);
+    CORRADE_COMPARE_AS(out, data.serialize(),
+        TestSuite::Compare::Container);
+}
+
+void MeshDataTest::serializeIntoInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const MeshData data = serializationTestMesh();
+    Containers::Array<char> out{232};
+
+    std::ostringstream outError;
+    Error redirectError{&outError};
+    data.serializeInto(out.prefix(216));
+    data.serializeInto(out);
+    CORRADE_COMPARE(outError.str(),
+        "Trade::MeshData::serializeInto(): expected a view of 224 bytes but got 216\n"
+        "Trade::MeshData::serializeInto(): expected a view of 224 bytes but got 232\n");
+}
+
+void MeshDataTest::serializeIntoMisaligned() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const MeshData data{MeshPrimitive::Points, 15};
+    Containers::Array<char> out{80};
+
+    std::ostringstream outError;
+    Error redirectError{&outError};
+    data.serializeInto(out.slice(4, 76));
+    CORRADE_COMPARE(outError.str(),
+        "Trade::MeshData::serializeInto(): expected the view to be aligned to 8 bytes\n");
+}
+
+void MeshDataTest::deserializeInvalid() {
+    auto&& data = DeserializeInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<char> blob = serializationTestMesh().serialize();
+    CORRADE_COMPARE(blob.size(), 224);
+    if(data.corrupt)
+        data.corrupt(*reinterpret_cast<Implementation::MeshDataChunk*>(blob.data()));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!MeshData::deserialize(blob.prefix(data.size ? data.size : blob.size())));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MeshData::deserialize(): {}\n", data.message));
+}
+
+void MeshDataTest::deserializeMisaligned() {
+    Containers::Array<char> blob{Containers::ValueInit, 80};
+    MeshData{MeshPrimitive::Points, 15}.serializeInto(blob.prefix(72));
+
+    /* Move the blob by 4 bytes, making it misaligned */
+    Utility::copy(blob.prefix(72), blob.slice(4, 76));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!MeshData::deserialize(blob.slice(4, 76)));
+    CORRADE_COMPARE(out.str(), "Trade::MeshData::deserialize(): data not aligned to 8 bytes\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::MeshDataTest)
@@ -55,6 +55,7 @@ enum class MaterialLayer: UnsignedInt;
 enum class MaterialType: UnsignedInt;
 enum class MaterialAlphaMode: UnsignedByte;
 class MaterialAttributeData;
+struct MaterialCommonAttributes;
 class MaterialData;
 #ifdef MAGNUM_BUILD_DEPRECATED
 typedef CORRADE_DEPRECATED("use MaterialData instead") MaterialData AbstractMaterialData;
@@ -23,6 +23,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/StaticArray.h>
@@ -35,9 +42,11 @@
 
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Implementation/converterUtilities.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/Implementation/anyConverterPlugins.h"
 #include "Magnum/Trade/Implementation/converterUtilities.h"
 
 namespace Magnum {
@@ -69,7 +78,8 @@ magnum-imageconverter [-h|--help] [-I|--importer IMPORTER]
     [-C|--converter CONVERTER] [--plugin-dir DIR]
     [-i|--importer-options key=val,key2=val2,…]
     [-c|--converter-options key=val,key2=val2,…] [--image IMAGE]
-    [--level LEVEL] [--in-place] [--info] [-v|--verbose] [--] input output
+    [--level LEVEL] [--in-place] [--info] [-v|--verbose] [--profile]
+    [--batch] [--threads N] [--] input output
 @endcode
 
 Arguments:
@@ -91,6 +101,11 @@ Arguments:
 -   `--in-place` --- overwrite the input image with the output
 -   `--info` --- print info about the input file and exit
 -   `-v`, `--verbose` --- verbose output from importer and converter plugins
+-   `--profile` --- measure import and conversion time
+-   `--batch` --- convert multiple images, treating `input` as a list file or
+    a wildcard pattern and `output` as an output filename pattern
+-   `--threads N` --- number of worker threads in `--batch` mode (default:
+    `0`, which means the number of hardware threads)
 
 Specifying `--importer raw:&lt;format&gt;` will treat the input as a raw
 tightly-packed square of pixels in given @ref PixelFormat. Specifying `-C` /
@@ -107,6 +122,31 @@ converter plugin configuration. If the `=` character is omitted, it's
 equivalent to saying `key=true`; configuration subgroups are delimited with
 `/`.
 
+@subsection magnum-imageconverter-usage-batch Batch conversion
+
+With `--batch`, the `input` is either a wildcard pattern, if it contains `*`
+or `?` in the filename part, or a file containing a list of input filenames,
+one per line. Empty lines and lines starting with `#` are ignored in the list
+file. The `output` is a filename pattern, in which `{}` gets replaced with the
+input filename without the extension and `{name}` with the input filename
+without the path and extension. With `--in-place`, each image is converted
+over its input file.
+
+The importer and converter plugins are loaded only once and the conversion is
+then done on `--threads` worker threads, each with its own importer and
+converter instance. Opening and closing the files is serialized, as importers
+such as @ref Trade::AnyImageImporter "AnyImageImporter" load the concrete
+plugin for each file from a shared plugin manager. The import and conversion
+itself runs in parallel. With the default
+@ref Trade::AnyImageConverter "AnyImageConverter", the concrete converter
+plugin is picked from each output filename extension upfront and each worker
+gets its own instance of it, the same as with an explicitly specified
+converter. The `--image`, `--level` and option arguments apply
+to all files. Importing raw data using `--importer raw:&lt;format&gt;` and
+`--info` isn't supported in batch mode. If `--profile` is specified, import
+and conversion time is printed for each file, followed by the total time and
+throughput.
+
 @section magnum-imageconverter-example Example usage
 
 Converting a JPEG file to a PNG:
@@ -135,6 +175,13 @@ inspection:
 magnum-imageconverter image.dds --converter raw data.dat
 @endcode
 
+Converting all PNG files in a directory to Basis Universal, putting them into
+a different directory and printing timing information:
+
+@code{.sh}
+magnum-imageconverter --batch "textures/*.png" "compressed/{name}.basis" --profile
+@endcode
+
 @see @ref magnum-sceneconverter
 */
 
@@ -142,6 +189,323 @@ magnum-imageconverter image.dds --converter raw data.dat
 
 using namespace Magnum;
 
+namespace {
+
+struct Duration {
+    explicit Duration(std::chrono::high_resolution_clock::duration& output): _output(output), _t{std::chrono::high_resolution_clock::now()} {}
+
+    ~Duration() {
+        _output += std::chrono::high_resolution_clock::now() - _t;
+    }
+
+    private:
+        std::chrono::high_resolution_clock::duration& _output;
+        std::chrono::high_resolution_clock::time_point _t;
+};
+
+Float seconds(const std::chrono::high_resolution_clock::duration duration) {
+    return UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count())/1.0e3f;
+}
+
+/* Matches a filename against a pattern with * and ? wildcards, backtracking
+   to the last * on a mismatch */
+bool matchesWildcard(const std::string& pattern, const std::string& string) {
+    std::size_t p = 0, s = 0, star = std::string::npos, mark = 0;
+    while(s != string.size()) {
+        if(p != pattern.size() && (pattern[p] == '?' || pattern[p] == string[s])) {
+            ++p;
+            ++s;
+        } else if(p != pattern.size() && pattern[p] == '*') {
+            star = p++;
+            mark = s;
+        } else if(star != std::string::npos) {
+            p = star + 1;
+            s = ++mark;
+        } else return false;
+    }
+
+    while(p != pattern.size() && pattern[p] == '*') ++p;
+    return p == pattern.size();
+}
+
+/* Expands --batch input to a list of files. Wildcards are supported only in
+   the filename part. */
+bool batchInputs(const std::string& input, std::vector<std::string>& out) {
+    const std::string filename = Utility::Directory::filename(input);
+    if(filename.find_first_of("*?") != std::string::npos) {
+        const std::string path = Utility::Directory::path(input);
+        const std::string directory = path.empty() ? "." : path;
+        if(!Utility::Directory::isDirectory(directory)) {
+            Error{} << "Cannot list directory" << directory;
+            return false;
+        }
+
+        for(const std::string& file: Utility::Directory::list(directory, Utility::Directory::Flag::SkipDirectories|Utility::Directory::Flag::SkipSpecial|Utility::Directory::Flag::SortAscending))
+            if(matchesWildcard(filename, file))
+                out.push_back(Utility::Directory::join(path, file));
+        return true;
+    }
+
+    if(!Utility::Directory::exists(input)) {
+        Error{} << "Cannot open file" << input;
+        return false;
+    }
+
+    for(std::string& line: Utility::String::splitWithoutEmptyParts(Utility::Directory::readString(input), '\n')) {
+        Utility::String::trimInPlace(line);
+        if(line.empty() || line[0] == '#') continue;
+        out.push_back(std::move(line));
+    }
+    return true;
+}
+
+/* A single file processed with --batch. If the converter is
+   AnyImageConverter, the concrete plugins are resolved upfront, for both
+   uncompressed and compressed images, as the image type is known only after
+   import. Empty if the format can't be determined. */
+struct BatchJob {
+    std::string input, output;
+    std::string plugin, compressedPlugin;
+};
+
+struct BatchWorker {
+    Containers::Pointer<Trade::AbstractImporter> importer;
+    /* Used if the converter is a concrete plugin */
+    Containers::Pointer<Trade::AbstractImageConverter> converter;
+    /* Used instead of the above if the converter is AnyImageConverter,
+       containing an instance of each concrete plugin the jobs need */
+    std::map<std::string, Containers::Pointer<Trade::AbstractImageConverter>> converters;
+    std::chrono::high_resolution_clock::duration importTime{}, conversionTime{};
+    std::size_t failed{};
+};
+
+/* Importers such as AnyImageImporter load and instantiate the concrete
+   plugin from the shared plugin manager in openFile() and destroy it in
+   close(). The manager isn't thread-safe, so both are serialized. */
+bool batchOpen(BatchWorker& worker, const std::string& input, std::mutex& managerMutex) {
+    std::lock_guard<std::mutex> lock{managerMutex};
+    return worker.importer->openFile(input);
+}
+
+void batchClose(BatchWorker& worker, std::mutex& managerMutex) {
+    std::lock_guard<std::mutex> lock{managerMutex};
+    worker.importer->close();
+}
+
+/* Picks the converter instance for given job and image. Returns nullptr if
+   the format can't be determined. */
+Trade::AbstractImageConverter* batchConverter(BatchWorker& worker, const BatchJob& job, const Trade::ImageData2D& image) {
+    if(worker.converter) return worker.converter.get();
+
+    const std::string& plugin = image.isCompressed() ? job.compressedPlugin : job.plugin;
+    if(plugin.empty()) return nullptr;
+
+    const auto found = worker.converters.find(plugin);
+    CORRADE_INTERNAL_ASSERT(found != worker.converters.end());
+    return found->second.get();
+}
+
+bool batchConvert(BatchWorker& worker, const Utility::Arguments& args, const BatchJob& job, std::mutex& managerMutex, std::mutex& outputMutex) {
+    std::chrono::high_resolution_clock::duration importTime{}, conversionTime{};
+
+    Containers::Optional<Trade::ImageData2D> image;
+    {
+        Duration d{importTime};
+        if(!batchOpen(worker, job.input, managerMutex)) {
+            std::lock_guard<std::mutex> lock{outputMutex};
+            Error{} << "Cannot open file" << job.input;
+            return false;
+        }
+
+        if(!(image = worker.importer->image2D(args.value<UnsignedInt>("image"), args.value<UnsignedInt>("level")))) {
+            batchClose(worker, managerMutex);
+            std::lock_guard<std::mutex> lock{outputMutex};
+            Error{} << "Cannot import the image from" << job.input;
+            return false;
+        }
+    }
+
+    bool success = true;
+
+    {
+        Duration d{conversionTime};
+
+        /* Saving raw data doesn't need any converter */
+        const bool raw = args.value("converter") == "raw";
+        Trade::AbstractImageConverter* const converter = raw ? nullptr :
+            batchConverter(worker, job, *image);
+
+        /* Create the output directory, if the pattern puts the output
+           elsewhere */
+        const std::string path = Utility::Directory::path(job.output);
+        if(!raw && !converter) {
+            std::lock_guard<std::mutex> lock{outputMutex};
+            Error e;
+            e << "Cannot determine the format of" << job.output;
+            if(image->isCompressed()) e << "for a compressed image";
+            success = false;
+        } else if(!path.empty() && !Utility::Directory::mkpath(path)) {
+            std::lock_guard<std::mutex> lock{outputMutex};
+            Error{} << "Cannot create directory" << path;
+            success = false;
+        } else if(converter ? !converter->exportToFile(*image, job.output) :
+           !Utility::Directory::write(job.output, image->data()))
+        {
+            std::lock_guard<std::mutex> lock{outputMutex};
+            Error{} << "Cannot save file" << job.output;
+            success = false;
+        }
+    }
+
+    /* The image may reference data owned by the importer, so it's closed only
+       after the conversion is done */
+    image = Containers::NullOpt;
+    batchClose(worker, managerMutex);
+    if(!success) return false;
+
+    worker.importTime += importTime;
+    worker.conversionTime += conversionTime;
+
+    std::lock_guard<std::mutex> lock{outputMutex};
+    Debug d;
+    d << "Converted" << job.input << "to" << job.output;
+    if(args.isSet("profile"))
+        d << Debug::nospace << ", import took" << seconds(importTime) << "seconds, conversion" << seconds(conversionTime) << "seconds";
+    return true;
+}
+
+int batch(const Utility::Arguments& args, PluginManager::Manager<Trade::AbstractImporter>& importerManager) {
+    if(Utility::String::beginsWith(args.value("importer"), "raw:") || args.isSet("info")) {
+        Error{} << "Raw import and --info are not supported in --batch mode";
+        return 6;
+    }
+
+    /* Unless converting in place, the outputs would all overwrite each other
+       if the pattern doesn't reference the input */
+    const std::string& pattern = args.value("output");
+    if(!args.isSet("in-place") && pattern.find("{}") == std::string::npos && pattern.find("{name}") == std::string::npos) {
+        Error{} << "Output pattern" << pattern << "contains neither {} nor {name}";
+        return 6;
+    }
+
+    std::vector<std::string> inputs;
+    if(!batchInputs(args.value("input"), inputs)) return 3;
+
+    Containers::Array<BatchJob> jobs{inputs.size()};
+    for(std::size_t i = 0; i != inputs.size(); ++i) {
+        BatchJob& job = jobs[i];
+        job.input = std::move(inputs[i]);
+        job.output = job.input;
+        if(!args.isSet("in-place")) {
+            job.output = Utility::String::replaceAll(pattern, "{name}",
+                Utility::Directory::splitExtension(Utility::Directory::filename(job.input)).first);
+            job.output = Utility::String::replaceAll(job.output, "{}",
+                Utility::Directory::splitExtension(job.input).first);
+        }
+    }
+
+    /* No point in having more threads than files */
+    std::size_t threadCount = args.value<UnsignedInt>("threads");
+    if(!threadCount) threadCount = std::thread::hardware_concurrency();
+    threadCount = Math::max(Math::min(threadCount, jobs.size()), std::size_t{1});
+
+    /* Plugin managers aren't thread-safe, so load the plugins and create all
+       converter instances upfront. Each worker then uses only its own
+       instances. AnyImageConverter would load and instantiate the concrete
+       plugin from the shared manager for every file, so the concrete plugins
+       are resolved from the output filenames here instead. */
+    PluginManager::Manager<Trade::AbstractImageConverter> converterManager{
+        args.value("plugin-dir").empty() ? std::string{} :
+        Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractImageConverter::pluginSearchPaths()[0])};
+    const std::string& converterName = args.value("converter");
+    std::vector<std::string> converterPlugins;
+    if(converterName != "raw") {
+        if(!(converterManager.load(converterName) & PluginManager::LoadState::Loaded)) {
+            Debug{} << "Available converter plugins:" << Utility::String::join(converterManager.aliasList(), ", ");
+            return 2;
+        }
+
+        if(converterManager.metadata(converterName)->name() == "AnyImageConverter") {
+            for(BatchJob& job: jobs) {
+                job.plugin = Trade::Implementation::anyImageConverterPlugin(job.output);
+                job.compressedPlugin = Trade::Implementation::anyCompressedImageConverterPlugin(job.output);
+                for(const std::string* plugin: {&job.plugin, &job.compressedPlugin})
+                    if(!plugin->empty() && std::find(converterPlugins.begin(), converterPlugins.end(), *plugin) == converterPlugins.end())
+                        converterPlugins.push_back(*plugin);
+            }
+
+            for(const std::string& plugin: converterPlugins) {
+                if(!(converterManager.load(plugin) & PluginManager::LoadState::Loaded)) {
+                    Error{} << "Cannot load the" << plugin << "plugin";
+                    return 2;
+                }
+            }
+        } else converterPlugins.push_back(converterName);
+    }
+
+    Containers::Array<BatchWorker> workers{threadCount};
+    for(BatchWorker& worker: workers) {
+        if(!(worker.importer = importerManager.loadAndInstantiate(args.value("importer")))) {
+            Debug{} << "Available importer plugins:" << Utility::String::join(importerManager.aliasList(), ", ");
+            return 1;
+        }
+        if(args.isSet("verbose")) worker.importer->setFlags(Trade::ImporterFlag::Verbose);
+        Implementation::setOptions(*worker.importer, args.value("importer-options"));
+
+        for(const std::string& plugin: converterPlugins) {
+            Containers::Pointer<Trade::AbstractImageConverter> converter = converterManager.instantiate(plugin);
+            if(args.isSet("verbose")) converter->setFlags(Trade::ImageConverterFlag::Verbose);
+            Implementation::setOptions(*converter, args.value("converter-options"));
+            if(plugin == converterName) worker.converter = std::move(converter);
+            else worker.converters.emplace(plugin, std::move(converter));
+        }
+    }
+
+    /* Workers pick the next file from a shared counter, so a few slow files
+       don't stall the others */
+    std::atomic<std::size_t> next{0};
+    std::mutex managerMutex, outputMutex;
+    auto work = [&](BatchWorker& worker) {
+        for(std::size_t i; (i = next++) < jobs.size(); )
+            if(!batchConvert(worker, args, jobs[i], managerMutex, outputMutex))
+                ++worker.failed;
+    };
+
+    std::chrono::high_resolution_clock::duration totalTime{};
+    {
+        Duration d{totalTime};
+
+        /* The first worker runs on the main thread */
+        std::vector<std::thread> threads;
+        for(std::size_t i = 1; i != workers.size(); ++i)
+            threads.emplace_back(work, std::ref(workers[i]));
+        work(workers[0]);
+        for(std::thread& thread: threads) thread.join();
+    }
+
+    std::size_t failed = 0;
+    std::chrono::high_resolution_clock::duration importTime{}, conversionTime{};
+    for(const BatchWorker& worker: workers) {
+        failed += worker.failed;
+        importTime += worker.importTime;
+        conversionTime += worker.conversionTime;
+    }
+
+    if(args.isSet("profile")) {
+        Debug{} << "Converted" << jobs.size() - failed << "out of" << jobs.size() << "images on" << workers.size() << "threads in" << seconds(totalTime) << "seconds," << (jobs.size() - failed)/Math::max(seconds(totalTime), 0.001f) << "images per second";
+        Debug{} << "Import took" << seconds(importTime) << "seconds, conversion" << seconds(conversionTime) << "seconds in total";
+    }
+
+    if(failed) {
+        Error{} << "Failed to convert" << failed << "out of" << jobs.size() << "images";
+        return 7;
+    }
+
+    return 0;
+}
+
+}
+
 int main(int argc, char** argv) {
     Utility::Arguments args;
     args.addArgument("input").setHelp("input", "input image")
@@ -156,6 +520,9 @@ int main(int argc, char** argv) {
         .addBooleanOption("in-place").setHelp("in-place", "overwrite the input image with the output")
         .addBooleanOption("info").setHelp("info", "print info about the input file and exit")
         .addBooleanOption('v', "verbose").setHelp("verbose", "verbose output from importer and converter plugins")
+        .addBooleanOption("profile").setHelp("profile", "measure import and conversion time")
+        .addBooleanOption("batch").setHelp("batch", "convert multiple images, input is a list file or a wildcard pattern and output an output filename pattern")
+        .addOption("threads", "0").setHelp("threads", "number of worker threads in --batch mode, 0 means the number of hardware threads", "N")
         .setParseErrorCallback([](const Utility::Arguments& args, Utility::Arguments::ParseError error, const std::string& key) {
             /* If --in-place or --info is passed, we don't need the output
                argument */
@@ -179,13 +546,25 @@ be specified.
 The -i / --importer-options and -c / --converter-options arguments accept a
 comma-separated list of key/value pairs to set in the importer / converter
 plugin configuration. If the = character is omitted, it's equivalent to saying
-key=true; configuration subgroups are delimited with /.)")
+key=true; configuration subgroups are delimited with /.
+
+With --batch, the input is either a wildcard pattern, if it contains * or ? in
+the filename part, or a file with a list of input filenames, one per line. In
+the output pattern, {} gets replaced with the input filename without the
+extension and {name} with the input filename without the path and extension.
+Plugins are loaded just once and the conversion runs on --threads worker
+threads.)")
         .parse(argc, argv);
 
     PluginManager::Manager<Trade::AbstractImporter> importerManager{
         args.value("plugin-dir").empty() ? std::string{} :
         Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractImporter::pluginSearchPaths()[0])};
 
+    /* Convert multiple files, if requested */
+    if(args.isSet("batch")) return batch(args, importerManager);
+
+    std::chrono::high_resolution_clock::duration importTime{}, conversionTime{};
+
     /* Load raw data, if requested; assume it's a tightly-packed square of
        given format */
     /** @todo implement image slicing and then use `--slice "0 0 w h"` to
@@ -271,6 +650,7 @@ key=true; configuration subgroups are delimited with /.)")
         }
 
         /* Open input file and the desired image */
+        Duration d{importTime};
         if(!importer->openFile(args.value("input"))) {
             Error() << "Cannot open file" << args.value("input");
             return 3;
@@ -317,8 +697,16 @@ key=true; configuration subgroups are delimited with /.)")
     Implementation::setOptions(*converter, args.value("converter-options"));
 
     /* Save output file */
-    if(!converter->exportToFile(*image, output)) {
-        Error() << "Cannot save file" << output;
-        return 5;
+    {
+        Duration d{conversionTime};
+        if(!converter->exportToFile(*image, output)) {
+            Error() << "Cannot save file" << output;
+            return 5;
+        }
+    }
+
+    if(args.isSet("profile")) {
+        Debug{} << "Import took" << seconds(importTime) << "seconds, conversion"
+            << seconds(conversionTime) << "seconds";
     }
 }
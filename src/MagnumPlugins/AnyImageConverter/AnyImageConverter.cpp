@@ -29,9 +29,9 @@
 #include <Corrade/PluginManager/PluginMetadata.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/DebugStl.h>
-#include <Corrade/Utility/String.h>
 
 #include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/Implementation/anyConverterPlugins.h"
 
 namespace Magnum { namespace Trade {
 
@@ -48,31 +48,9 @@ ImageConverterFeatures AnyImageConverter::doFeatures() const {
 bool AnyImageConverter::doExportToFile(const ImageView2D& image, const std::string& filename) {
     CORRADE_INTERNAL_ASSERT(manager());
 
-    /** @todo lowercase only the extension, once Directory::split() is done */
-    const std::string normalized = Utility::String::lowercase(filename);
-
     /* Detect the plugin from extension */
-    std::string plugin;
-    if(Utility::String::endsWith(normalized, ".bmp"))
-        plugin = "BmpImageConverter";
-    else if(Utility::String::endsWith(normalized, ".basis"))
-        plugin = "BasisImageConverter";
-    else if(Utility::String::endsWith(normalized, ".exr"))
-        plugin = "OpenExrImageConverter";
-    else if(Utility::String::endsWith(normalized, ".hdr"))
-        plugin = "HdrImageConverter";
-    else if(Utility::String::endsWith(normalized, ".jpg") ||
-            Utility::String::endsWith(normalized, ".jpeg") ||
-            Utility::String::endsWith(normalized, ".jpe"))
-        plugin = "JpegImageConverter";
-    else if(Utility::String::endsWith(normalized, ".png"))
-        plugin = "PngImageConverter";
-    else if(Utility::String::endsWith(normalized, ".tga") ||
-            Utility::String::endsWith(normalized, ".vda") ||
-            Utility::String::endsWith(normalized, ".icb") ||
-            Utility::String::endsWith(normalized, ".vst"))
-        plugin = "TgaImageConverter";
-    else {
+    const std::string plugin = Implementation::anyImageConverterPlugin(filename);
+    if(plugin.empty()) {
         Error{} << "Trade::AnyImageConverter::exportToFile(): cannot determine the format of" << filename;
         return false;
     }
@@ -100,13 +78,37 @@ bool AnyImageConverter::doExportToFile(const ImageView2D& image, const std::stri
     return converter->exportToFile(image, filename);
 }
 
-bool AnyImageConverter::doExportToFile(const CompressedImageView2D&, const std::string& filename) {
+bool AnyImageConverter::doExportToFile(const CompressedImageView2D& image, const std::string& filename) {
     CORRADE_INTERNAL_ASSERT(manager());
 
-    /* No file formats to store compressed data yet */
+    /* Detect the plugin from extension */
+    const std::string plugin = Implementation::anyCompressedImageConverterPlugin(filename);
+    if(plugin.empty()) {
+        Error{} << "Trade::AnyImageConverter::exportToFile(): cannot determine the format of" << filename << "to store compressed data";
+        return false;
+    }
 
-    Error{} << "Trade::AnyImageConverter::exportToFile(): cannot determine the format of" << filename << "to store compressed data";
-    return false;
+    /* Try to load the plugin */
+    if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
+        Error{} << "Trade::AnyImageConverter::exportToFile(): cannot load the" << plugin << "plugin";
+        return false;
+    }
+    if(flags() & ImageConverterFlag::Verbose) {
+        Debug d;
+        d << "Trade::AnyImageConverter::exportToFile(): using" << plugin;
+        PluginManager::PluginMetadata* metadata = manager()->metadata(plugin);
+        CORRADE_INTERNAL_ASSERT(metadata);
+        if(plugin != metadata->name())
+            d << "(provided by" << metadata->name() << Debug::nospace << ")";
+    }
+
+    /* Instantiate the plugin, propagate flags */
+    Containers::Pointer<AbstractImageConverter> converter = static_cast<PluginManager::Manager<AbstractImageConverter>*>(manager())->instantiate(plugin);
+    converter->setFlags(flags());
+
+    /* Try to convert the file (error output should be printed by the plugin
+       itself) */
+    return converter->exportToFile(image, filename);
 }
 
 }}
@@ -58,6 +58,8 @@ tries to convert the file with it. Supported formats for uncompressed data:
 
 -   Basis Universal (`*.basis`), converted with @ref BasisImageConverter or any
     other plugin that provides it
+-   Magnum blob (`*.blob`), converted with @ref MagnumImageConverter or any
+    other plugin that provides it
 -   Windows Bitmap (`*.bmp`), converted with any plugin that provides
     `BmpImageConverter`
 -   OpenEXR (`*.exr`), converted with any plugin that provides
@@ -71,8 +73,12 @@ tries to convert the file with it. Supported formats for uncompressed data:
 -   Truevision TGA (`*.tga`, `*.vda`, `*.icb`, `*.vst`), converted with
     @ref TgaImageConverter or any other plugin that provides it
 
-No supported formats for compressed data yet. Only exporting to files is
-supported.
+Supported formats for compressed data:
+
+-   Magnum blob (`*.blob`), converted with @ref MagnumImageConverter or any
+    other plugin that provides it
+
+Only exporting to files is supported.
 
 @section Trade-AnyImageConverter-usage Usage
 
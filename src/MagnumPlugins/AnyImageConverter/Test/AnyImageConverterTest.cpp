@@ -44,8 +44,10 @@ struct AnyImageConverterTest: TestSuite::Tester {
 
     void convert();
     void detect();
+    void detectCompressed();
 
     void unknown();
+    void unknownCompressed();
 
     void verbose();
 
@@ -66,6 +68,7 @@ constexpr struct {
     const char* plugin;
 } DetectData[]{
     {"BMP", "file.bmp", "BmpImageConverter"},
+    {"Magnum blob", "file.blob", "MagnumImageConverter"},
     {"EXR", "file.exr", "OpenExrImageConverter"},
     {"HDR", "file.hdr", "HdrImageConverter"},
     {"JPEG", "file.jpg", "JpegImageConverter"},
@@ -81,7 +84,10 @@ AnyImageConverterTest::AnyImageConverterTest() {
     addInstancedTests({&AnyImageConverterTest::detect},
         Containers::arraySize(DetectData));
 
-    addTests({&AnyImageConverterTest::unknown,
+    addTests({&AnyImageConverterTest::detectCompressed,
+
+              &AnyImageConverterTest::unknown,
+              &AnyImageConverterTest::unknownCompressed,
 
               &AnyImageConverterTest::verbose});
 
@@ -107,6 +113,10 @@ constexpr const char Data[] = {
 
 const ImageView2D Image{PixelFormat::RGB8Unorm, {2, 3}, Data};
 
+constexpr const char CompressedData[16]{};
+
+const CompressedImageView2D CompressedImage{CompressedPixelFormat::Bc1RGBUnorm, {4, 4}, CompressedData};
+
 void AnyImageConverterTest::convert() {
     auto&& data = ConvertData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -144,6 +154,22 @@ void AnyImageConverterTest::detect() {
     #endif
 }
 
+void AnyImageConverterTest::detectCompressed() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("AnyImageConverter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->exportToFile(CompressedImage, "file.blob"));
+    /* Can't use raw string literals in macros on GCC 4.8 */
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    CORRADE_COMPARE(out.str(),
+"PluginManager::Manager::load(): plugin MagnumImageConverter is not static and was not found in nonexistent\nTrade::AnyImageConverter::exportToFile(): cannot load the MagnumImageConverter plugin\n");
+    #else
+    CORRADE_COMPARE(out.str(),
+"PluginManager::Manager::load(): plugin MagnumImageConverter was not found\nTrade::AnyImageConverter::exportToFile(): cannot load the MagnumImageConverter plugin\n");
+    #endif
+}
+
 void AnyImageConverterTest::unknown() {
     std::ostringstream output;
     Error redirectError{&output};
@@ -154,6 +180,16 @@ void AnyImageConverterTest::unknown() {
     CORRADE_COMPARE(output.str(), "Trade::AnyImageConverter::exportToFile(): cannot determine the format of image.xcf\n");
 }
 
+void AnyImageConverterTest::unknownCompressed() {
+    std::ostringstream output;
+    Error redirectError{&output};
+
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("AnyImageConverter");
+    CORRADE_VERIFY(!converter->exportToFile(CompressedImage, "image.dds"));
+
+    CORRADE_COMPARE(output.str(), "Trade::AnyImageConverter::exportToFile(): cannot determine the format of image.dds to store compressed data\n");
+}
+
 void AnyImageConverterTest::verbose() {
     if(!(_manager.loadState("TgaImageConverter") & PluginManager::LoadState::Loaded))
         CORRADE_SKIP("TgaImageConverter plugin not enabled, cannot test");
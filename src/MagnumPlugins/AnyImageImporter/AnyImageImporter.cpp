@@ -30,14 +30,19 @@
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/PluginManager/PluginMetadata.h>
 #include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/String.h>
 
 #include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/Implementation/importCache.h"
 
 namespace Magnum { namespace Trade {
 
+struct AnyImageImporter::Cache: Implementation::ImportCache {};
+
 AnyImageImporter::AnyImageImporter(PluginManager::Manager<AbstractImporter>& manager): AbstractImporter{manager} {}
 
 AnyImageImporter::AnyImageImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
@@ -48,10 +53,45 @@ AnyImageImporter::~AnyImageImporter() = default;
 
 ImporterFeatures AnyImageImporter::doFeatures() const { return ImporterFeature::OpenData; }
 
-bool AnyImageImporter::doIsOpened() const { return !!_in; }
+bool AnyImageImporter::doIsOpened() const { return _in || _cache; }
 
 void AnyImageImporter::doClose() {
     _in = nullptr;
+    _cache = nullptr;
+}
+
+bool AnyImageImporter::openCached(const char* const messagePrefix, const Containers::ArrayView<const char> data, const std::string& plugin, std::string& key) {
+    const std::string directory = configuration().value("cacheDirectory");
+    if(directory.empty()) return false;
+
+    key = Implementation::importCacheKey(data, plugin, configuration().value("cacheKey"));
+    Containers::Pointer<Cache> cache{new Cache};
+    if(!Implementation::importCacheOpen(*cache, directory, key, configuration().value<UnsignedLong>("cacheSize")*1024*1024))
+        return false;
+
+    if(flags() & ImporterFlag::Verbose)
+        Debug{} << messagePrefix << "using a cached" << plugin << "import" << key;
+
+    _cache = std::move(cache);
+    return true;
+}
+
+void AnyImageImporter::openInternal(const char* const messagePrefix, Containers::Pointer<AbstractImporter>&& importer, const std::string& key) {
+    /* If caching is enabled, import everything and serve it from the
+       serialized data, so the first run behaves the same as the following
+       ones. If that fails, use the importer directly. */
+    if(!key.empty()) {
+        Containers::Pointer<Cache> cache{new Cache};
+        if(Implementation::importCacheStore(*cache, *importer, Implementation::ImportCacheImages2D, configuration().value("cacheDirectory"), key, configuration().value<UnsignedLong>("cacheSize")*1024*1024)) {
+            if(flags() & ImporterFlag::Verbose)
+                Debug{} << messagePrefix << "cached the import as" << key;
+
+            _cache = std::move(cache);
+            return;
+        }
+    }
+
+    _in = std::move(importer);
 }
 
 void AnyImageImporter::doOpenFile(const std::string& filename) {
@@ -64,6 +104,8 @@ void AnyImageImporter::doOpenFile(const std::string& filename) {
     std::string plugin;
     if(Utility::String::endsWith(normalized, ".basis"))
         plugin = "BasisImporter";
+    else if(Utility::String::endsWith(normalized, ".blob"))
+        plugin = "MagnumImporter";
     else if(Utility::String::endsWith(normalized, ".bmp"))
         plugin = "BmpImporter";
     else if(Utility::String::endsWith(normalized, ".dds"))
@@ -83,6 +125,9 @@ void AnyImageImporter::doOpenFile(const std::string& filename) {
         plugin = "JpegImporter";
     else if(Utility::String::endsWith(normalized, ".jp2"))
         plugin = "Jpeg2000Importer";
+    else if(Utility::String::endsWith(normalized, ".ktx") ||
+            Utility::String::endsWith(normalized, ".ktx2"))
+        plugin = "KtxImporter";
     else if(Utility::String::endsWith(normalized, ".mng"))
         plugin = "MngImporter";
     else if(Utility::String::endsWith(normalized, ".pbm"))
@@ -114,10 +159,22 @@ void AnyImageImporter::doOpenFile(const std::string& filename) {
             Utility::String::endsWith(normalized, ".icb") ||
             Utility::String::endsWith(normalized, ".vst"))
         plugin = "TgaImporter";
+    else if(Utility::String::endsWith(normalized, ".webp"))
+        plugin = "WebPImporter";
     else {
         Error{} << "Trade::AnyImageImporter::openFile(): cannot determine the format of" << filename;
         return;
     }
+
+    /* If caching is enabled, look into the cache first. The file is read
+       only to calculate the cache key. */
+    std::string key;
+    if(!configuration().value("cacheDirectory").empty() && Utility::Directory::exists(filename)) {
+        const Containers::Array<char> data = Utility::Directory::read(filename);
+        if(openCached("Trade::AnyImageImporter::openFile():", data, plugin, key))
+            return;
+    }
+
     if(flags() & ImporterFlag::Verbose) {
         Debug d;
         d << "Trade::AnyImageImporter::openFile(): using" << plugin;
@@ -142,7 +199,7 @@ void AnyImageImporter::doOpenFile(const std::string& filename) {
     if(!importer->openFile(filename)) return;
 
     /* Success, save the instance */
-    _in = std::move(importer);
+    openInternal("Trade::AnyImageImporter::openFile():", std::move(importer), key);
 }
 
 void AnyImageImporter::doOpenData(Containers::ArrayView<const char> data) {
@@ -177,6 +234,58 @@ void AnyImageImporter::doOpenData(Containers::ArrayView<const char> data) {
     else if(dataString.hasPrefix("II\x2a\x00"_s) ||
             dataString.hasPrefix("MM\x00\x2a"_s))
         plugin = "TiffImporter";
+    /* Trade::DataChunkHeader::magic */
+    else if(dataString.hasPrefix("BLOB"_s))
+        plugin = "MagnumImporter";
+    /* https://www.khronos.org/registry/KTX/specs/1.0/ktxspec_v1.html#2.1,
+       https://github.khronos.org/KTX-Specification/#_identifier */
+    else if(dataString.hasPrefix("\xabKTX 11\xbb\x0d\x0a\x1a\x0a"_s) ||
+            dataString.hasPrefix("\xabKTX 20\xbb\x0d\x0a\x1a\x0a"_s))
+        plugin = "KtxImporter";
+    /* https://en.wikipedia.org/wiki/GIF#File_format */
+    else if(dataString.hasPrefix("GIF87a"_s) ||
+            dataString.hasPrefix("GIF89a"_s))
+        plugin = "GifImporter";
+    /* https://www.adobe.com/devnet-apps/photoshop/fileformatashtml/#50577409_pgfId-1055726 */
+    else if(dataString.hasPrefix("8BPS"_s))
+        plugin = "PsdImporter";
+    /* https://en.wikipedia.org/wiki/JPEG_2000#File_format_and_codestream,
+       either the JP2 container or a raw codestream */
+    else if(dataString.hasPrefix("\x00\x00\x00\x0cjP  \x0d\x0a\x87\x0a"_s) ||
+            dataString.hasPrefix("\xff\x4f\xff\x51"_s))
+        plugin = "Jpeg2000Importer";
+    /* https://developers.google.com/speed/webp/docs/riff_container#webp_file_header */
+    else if(dataString.size() >= 12 && dataString.hasPrefix("RIFF"_s) &&
+            dataString.slice(8, 12) == "WEBP"_s)
+        plugin = "WebPImporter";
+    /* https://paulbourke.net/dataformats/sgirgb/sgiversion.html, magic
+       followed by storage format (0 or 1) and bytes per channel (1 or 2) */
+    else if(data.size() >= 4 && dataString.hasPrefix("\x01\xda"_s) &&
+            (data[2] == 0 || data[2] == 1) && (data[3] == 1 || data[3] == 2))
+        plugin = "SgiImporter";
+    /* https://en.wikipedia.org/wiki/Netpbm#File_formats, P and a digit
+       followed by a whitespace */
+    else if(data.size() >= 3 && data[0] == 'P' && data[1] >= '1' && data[1] <= '6' &&
+            (data[2] == ' ' || data[2] == '\t' || data[2] == '\r' || data[2] == '\n')) {
+        if(data[1] == '1' || data[1] == '4') plugin = "PbmImporter";
+        else if(data[1] == '2' || data[1] == '5') plugin = "PgmImporter";
+        else plugin = "PpmImporter";
+    }
+    /* https://en.wikipedia.org/wiki/BMP_file_format#Bitmap_file_header, the
+       two-byte magic is followed by a DIB header of one of these sizes */
+    else if(data.size() >= 18 && dataString.hasPrefix("BM"_s) &&
+            !data[15] && !data[16] && !data[17] && [data]() {
+                const UnsignedByte size = data[14];
+                return size == 12 || size == 40 || size == 52 || size == 56 ||
+                       size == 64 || size == 108 || size == 124;
+            }())
+        plugin = "BmpImporter";
+    /* https://en.wikipedia.org/wiki/ICO_(file_format)#Header, reserved zero,
+       type 1 for icons and 2 for cursors and a non-zero image count. Has to
+       be before TGA, as cursors pass its check as well. */
+    else if(data.size() >= 6 && (dataString.hasPrefix("\x00\x00\x01\x00"_s) ||
+            dataString.hasPrefix("\x00\x00\x02\x00"_s)) && (data[4] || data[5]))
+        plugin = "IcoImporter";
     /* https://github.com/file/file/blob/d04de269e0b06ccd0a7d1bf4974fed1d75be7d9e/magic/Magdir/images#L18-L22
        TGAs are a complete guesswork, so try after everything else fails. */
     else if([data]() {
@@ -214,6 +323,11 @@ void AnyImageImporter::doOpenData(Containers::ArrayView<const char> data) {
         return;
     }
 
+    /* If caching is enabled, look into the cache first */
+    std::string key;
+    if(openCached("Trade::AnyImageImporter::openData():", data, plugin, key))
+        return;
+
     /* Try to load the plugin */
     if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
         Error{} << "Trade::AnyImageImporter::openData(): cannot load the" << plugin << "plugin";
@@ -237,14 +351,20 @@ void AnyImageImporter::doOpenData(Containers::ArrayView<const char> data) {
     if(!importer->openData(data)) return;
 
     /* Success, save the instance */
-    _in = std::move(importer);
+    openInternal("Trade::AnyImageImporter::openData():", std::move(importer), key);
 }
 
-UnsignedInt AnyImageImporter::doImage2DCount() const { return _in->image2DCount(); }
+UnsignedInt AnyImageImporter::doImage2DCount() const {
+    return _cache ? _cache->images2D.size() : _in->image2DCount();
+}
 
-UnsignedInt AnyImageImporter::doImage2DLevelCount(UnsignedInt id) { return _in->image2DLevelCount(id); }
+UnsignedInt AnyImageImporter::doImage2DLevelCount(UnsignedInt id) {
+    return _cache ? ImageData2D::deserializeLevelCount(_cache->images2D[id]) : _in->image2DLevelCount(id);
+}
 
-Containers::Optional<ImageData2D> AnyImageImporter::doImage2D(const UnsignedInt id, const UnsignedInt level) { return _in->image2D(id, level); }
+Containers::Optional<ImageData2D> AnyImageImporter::doImage2D(const UnsignedInt id, const UnsignedInt level) {
+    return _cache ? Implementation::importCacheImage<2>(_cache->images2D[id], level) : _in->image2D(id, level);
+}
 
 }}
 
@@ -56,46 +56,60 @@ namespace Magnum { namespace Trade {
 Detects file type based on file extension, loads corresponding plugin and then
 tries to open the file with it. Supported formats:
 
--   Basis Universal (`*.basis`), loaded @ref BasisImporter or any other plugin
-    that provides it
--   Windows Bitmap (`*.bmp`), loaded with any plugin that provides `BmpImporter`
+-   Basis Universal (`*.basis` or data with corresponding signature), loaded
+    @ref BasisImporter or any other plugin that provides it
+-   Magnum blob (`*.blob` or data with corresponding signature), loaded with
+    @ref MagnumImporter or any other plugin that provides it
+-   Windows Bitmap (`*.bmp` or data with corresponding signature), loaded with
+    any plugin that provides `BmpImporter`
 -   DirectDraw Surface (`*.dds` or data with corresponding signature), loaded
     with @ref DdsImporter or any other plugin that provides it
--   Graphics Interchange Format (`*.gif`), loaded with any plugin that provides
-    `GifImporter`
+-   Graphics Interchange Format (`*.gif` or data with corresponding
+    signature), loaded with any plugin that provides `GifImporter`
 -   OpenEXR (`*.exr` or data with corresponding signature), loaded with any
     plugin that provides `OpenExrImporter`
 -   Radiance HDR (`*.hdr` or data with corresponding signature), loaded with
     any plugin that provides `HdrImporter`
--   Windows icon/cursor (`*.ico`, `*.cur`), loaded with @ref IcoImporter or any
-    other plugin that provides it
+-   Windows icon/cursor (`*.ico`, `*.cur` or data with corresponding
+    signature), loaded with @ref IcoImporter or any other plugin that provides
+    it
 -   JPEG (`*.jpg`, `*.jpe`, `*.jpeg` or data with corresponding signature),
     loaded with @ref JpegImporter or any other plugin that provides it
--   JPEG 2000 (`*.jp2`), loaded with any plugin that provides
-    `Jpeg2000Importer`
+-   JPEG 2000 (`*.jp2` or data with corresponding signature), loaded with any
+    plugin that provides `Jpeg2000Importer`
+-   Khronos Texture (`*.ktx`, `*.ktx2` or data with corresponding signature),
+    loaded with any plugin that provides `KtxImporter`
 -   Multiple-image Network Graphics (`*.mng`), loaded with any plugin that
     provides `MngImporter`
--   Portable Bitmap (`*.pbm`), loaded with any plugin that provides `PbmImporter`
+-   Portable Bitmap (`*.pbm` or data with corresponding signature), loaded
+    with any plugin that provides `PbmImporter`
 -   ZSoft PCX (`*.pcx`), loaded with any plugin that provides `PcxImporter`
--   Portable Graymap (`*.pgm`), loaded with any plugin that provides
-    `PgmImporter`
+-   Portable Graymap (`*.pgm` or data with corresponding signature), loaded
+    with any plugin that provides `PgmImporter`
 -   Softimage PIC (`*.pic`), loaded with any plugin that provides `PicImporter`
 -   Portable Anymap (`*.pnm`), loaded with any plugin that provides
     `PnmImporter`
 -   Portable Network Graphics (`*.png` or data with corresponding signature),
     loaded with @ref PngImporter or any other plugin that provides it
--   Portable Pixmap (`*.ppm`), loaded with any plugin that provides `PpmImporter`
--   Adobe Photoshop (`*.psd`), loaded with any plugin that provides `PsdImporter`
--   Silicon Graphics (`*.sgi`, `*.bw`, `*.rgb`, `*.rgba`), loaded with any
-    plugin that provides `SgiImporter`
+-   Portable Pixmap (`*.ppm` or data with corresponding signature), loaded
+    with any plugin that provides `PpmImporter`
+-   Adobe Photoshop (`*.psd` or data with corresponding signature), loaded with
+    any plugin that provides `PsdImporter`
+-   Silicon Graphics (`*.sgi`, `*.bw`, `*.rgb`, `*.rgba` or data with
+    corresponding signature), loaded with any plugin that provides
+    `SgiImporter`
 -   Tagged Image File Format (`*.tif`, `*.tiff` or data with corresponding
     signature), loaded with any plugin that provides `TiffImporter`
 -   Truevision TGA (`*.tga`, `*.vda`, `*.icb`, `*.vst` or data with
     corresponding signature), loaded with @ref TgaImporter or any other plugin
     that provides it
+-   WebP (`*.webp` or data with corresponding signature), loaded with any
+    plugin that provides `WebPImporter`
 
 Detecting file type through @ref openData() is supported only for a subset of
-formats that are marked as such in the list above.
+formats that are marked as such in the list above. The data are passed to the
+concrete plugin directly, without any copy. As TGA files don't have any
+signature, they're detected only if no other signature matches.
 
 @section Trade-AnyImageImporter-usage Usage
 
@@ -127,6 +141,32 @@ target_link_libraries(your-app PRIVATE Magnum::AnyImageImporter)
 
 See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
 information.
+
+@section Trade-AnyImageImporter-cache Import cache
+
+If the @cb{.ini} cacheDirectory @ce @ref Trade-AnyImageImporter-configuration "configuration option"
+is set, the imported data are serialized into a
+@ref Trade-MeshData-serialization "Magnum blob" in given directory on the
+first import and subsequent imports of the same file then only memory-map the
+blob instead of loading and running the concrete plugin. The cache key is a
+SHA-1 hash of the file contents, the concrete plugin name and the
+@cb{.ini} cacheKey @ce option. Once the cache grows over
+@cb{.ini} cacheSize @ce megabytes, least recently used entries get removed.
+Only images are cached, which is all this plugin exposes. The cache key is
+calculated from the file contents, so it's also used for data opened through
+@ref openData(). Images returned from the cache are copied out of the blob,
+so they're owned and mutable and stay valid after the file is closed, same as
+when they come from the concrete plugin.
+
+@section Trade-AnyImageImporter-configuration Plugin-specific configuration
+
+It's possible to tune various options mainly for the import cache through
+@ref configuration(). See below for all options and their default values:
+
+@snippet MagnumPlugins/AnyImageImporter/AnyImageImporter.conf config
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_ANYIMAGEIMPORTER_EXPORT AnyImageImporter: public AbstractImporter {
     public:
@@ -166,7 +206,13 @@ class MAGNUM_ANYIMAGEIMPORTER_EXPORT AnyImageImporter: public AbstractImporter {
         MAGNUM_ANYIMAGEIMPORTER_LOCAL UnsignedInt doImage2DLevelCount(UnsignedInt id) override;
         MAGNUM_ANYIMAGEIMPORTER_LOCAL Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt level) override;
 
+        struct Cache;
+
+        MAGNUM_ANYIMAGEIMPORTER_LOCAL bool openCached(const char* messagePrefix, Containers::ArrayView<const char> data, const std::string& plugin, std::string& key);
+        MAGNUM_ANYIMAGEIMPORTER_LOCAL void openInternal(const char* messagePrefix, Containers::Pointer<AbstractImporter>&& importer, const std::string& key);
+
         Containers::Pointer<AbstractImporter> _in;
+        Containers::Pointer<Cache> _cache;
 };
 
 }}
@@ -28,12 +28,16 @@
 #include <Corrade/Containers/StringView.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/FormatStl.h>
 
+#include "Magnum/PixelFormat.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/Implementation/importCache.h"
 
 #include "configure.h"
 
@@ -44,6 +48,7 @@ struct AnyImageImporterTest: TestSuite::Tester {
 
     void load();
     void detect();
+    void detectSignature();
 
     void unknownExtension();
     void unknownSignature();
@@ -51,6 +56,10 @@ struct AnyImageImporterTest: TestSuite::Tester {
 
     void verbose();
 
+    void cacheHit();
+    void cacheMiss();
+    void cacheEviction();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
@@ -82,6 +91,7 @@ constexpr struct {
     {"JPEG data", "gray.jpg", fileCallback, "JpegImporter"},
     {"JPEG uppercase", "uppercase.JPG", nullptr, "JpegImporter"},
     {"JPEG2000", "image.jp2", nullptr, "Jpeg2000Importer"},
+    {"Magnum blob", "image.blob", nullptr, "MagnumImporter"},
     {"EXR", "image.exr", nullptr, "OpenExrImporter"},
     {"EXR data", "image.exr", fileCallback, "OpenExrImporter"},
     {"HDR", "rgb.hdr", nullptr, "HdrImporter"},
@@ -100,6 +110,28 @@ constexpr struct {
 
 using namespace Containers::Literals;
 
+const struct {
+    const char* name;
+    Containers::StringView data;
+    const char* plugin;
+} DetectSignatureData[]{
+    {"Magnum blob", "BLOB\x80\x00\x34\x12"_s, "MagnumImporter"},
+    {"KTX", "\xabKTX 11\xbb\x0d\x0a\x1a\x0a"_s, "KtxImporter"},
+    {"KTX2", "\xabKTX 20\xbb\x0d\x0a\x1a\x0a"_s, "KtxImporter"},
+    {"GIF", "GIF89a\x01\x00\x01\x00"_s, "GifImporter"},
+    {"PSD", "8BPS\x00\x01"_s, "PsdImporter"},
+    {"JPEG2000", "\x00\x00\x00\x0cjP  \x0d\x0a\x87\x0a"_s, "Jpeg2000Importer"},
+    {"JPEG2000 codestream", "\xff\x4f\xff\x51\x00\x2f"_s, "Jpeg2000Importer"},
+    {"WebP", "RIFF\x24\x00\x00\x00WEBPVP8 "_s, "WebPImporter"},
+    {"SGI", "\x01\xda\x01\x01\x00\x03"_s, "SgiImporter"},
+    {"PBM", "P4\n3 2\n"_s, "PbmImporter"},
+    {"PGM", "P2 3 2 255\n"_s, "PgmImporter"},
+    {"PPM", "P6\n3 2\n255\n"_s, "PpmImporter"},
+    {"BMP", "BM\x46\x00\x00\x00\x00\x00\x00\x00\x36\x00\x00\x00\x28\x00\x00\x00"_s, "BmpImporter"},
+    {"ICO", "\x00\x00\x01\x00\x01\x00"_s, "IcoImporter"},
+    {"CUR", "\x00\x00\x02\x00\x01\x00"_s, "IcoImporter"}
+};
+
 const struct {
     const char* name;
     Containers::StringView data;
@@ -123,6 +155,9 @@ AnyImageImporterTest::AnyImageImporterTest() {
     addInstancedTests({&AnyImageImporterTest::detect},
         Containers::arraySize(DetectData));
 
+    addInstancedTests({&AnyImageImporterTest::detectSignature},
+        Containers::arraySize(DetectSignatureData));
+
     addTests({&AnyImageImporterTest::unknownExtension});
 
     addInstancedTests({&AnyImageImporterTest::unknownSignature},
@@ -133,6 +168,10 @@ AnyImageImporterTest::AnyImageImporterTest() {
     addInstancedTests({&AnyImageImporterTest::verbose},
         Containers::arraySize(LoadData));
 
+    addTests({&AnyImageImporterTest::cacheHit,
+              &AnyImageImporterTest::cacheMiss,
+              &AnyImageImporterTest::cacheEviction});
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef ANYIMAGEIMPORTER_PLUGIN_FILENAME
@@ -189,6 +228,25 @@ void AnyImageImporterTest::detect() {
     #endif
 }
 
+void AnyImageImporterTest::detectSignature() {
+    auto&& data = DetectSignatureData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnyImageImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data.data));
+    /* Can't use raw string literals in macros on GCC 4.8 */
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+"PluginManager::Manager::load(): plugin {0} is not static and was not found in nonexistent\nTrade::AnyImageImporter::openData(): cannot load the {0} plugin\n", data.plugin));
+    #else
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+"PluginManager::Manager::load(): plugin {0} was not found\nTrade::AnyImageImporter::openData(): cannot load the {0} plugin\n", data.plugin));
+    #endif
+}
+
 void AnyImageImporterTest::unknownExtension() {
     std::ostringstream output;
     Error redirectError{&output};
@@ -247,6 +305,143 @@ void AnyImageImporterTest::verbose() {
         data.verboseFunctionName));
 }
 
+/* Creates an empty cache directory and returns its path */
+std::string emptyCacheDirectory(const std::string& name) {
+    const std::string directory = Utility::Directory::join(ANYIMAGEIMPORTER_TEST_OUTPUT_DIR, name);
+    if(Utility::Directory::exists(directory))
+        for(const std::string& file: Utility::Directory::list(directory, Utility::Directory::Flag::SkipDirectories))
+            CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::rm(Utility::Directory::join(directory, file)));
+    else CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::mkpath(directory));
+    return directory;
+}
+
+constexpr char CachedPixels[]{'\xca', '\xfe', '\xba', '\xbe'};
+
+void AnyImageImporterTest::cacheHit() {
+    const std::string directory = emptyCacheDirectory("cache-hit");
+
+    /* Put a 1x1 image into the cache under a key calculated from the TGA
+       file, the importer should then return it instead of the 3x2 image in
+       the file. TgaImporter doesn't even need to be present. */
+    const Containers::Array<char> tga = Utility::Directory::read(TGA_FILE);
+    const std::string key = Implementation::importCacheKey(tga, "TgaImporter", "");
+    CORRADE_VERIFY(Utility::Directory::write(Utility::Directory::join(directory, key + ".blob"), ImageData2D{PixelFormat::RGBA8Unorm, {1, 1}, DataFlags{}, CachedPixels}.serialize()));
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnyImageImporter");
+    importer->configuration().setValue("cacheDirectory", directory);
+    importer->setFlags(ImporterFlag::Verbose);
+
+    std::ostringstream out;
+    {
+        Debug redirectOutput{&out};
+        CORRADE_VERIFY(importer->openFile(TGA_FILE));
+    }
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Trade::AnyImageImporter::openFile(): using a cached TgaImporter import {}\n", key));
+
+    CORRADE_COMPARE(importer->image2DCount(), 1);
+    CORRADE_COMPARE(importer->image2DLevelCount(0), 1);
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE(image->size(), Vector2i{1});
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(CachedPixels),
+        TestSuite::Compare::Container);
+
+    /* The data are a copy, not a view into the cache */
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+
+    /* The entry got recorded in the index */
+    Utility::Configuration index{Utility::Directory::join(directory, "index.conf")};
+    CORRADE_COMPARE(index.groupCount("entry"), 1);
+    CORRADE_COMPARE(index.group("entry")->value("key"), key);
+
+    importer->close();
+    CORRADE_VERIFY(!importer->isOpened());
+
+    /* So they stay valid after the importer is closed */
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(CachedPixels),
+        TestSuite::Compare::Container);
+}
+
+void AnyImageImporterTest::cacheMiss() {
+    if(!(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not enabled, cannot test");
+
+    const std::string directory = emptyCacheDirectory("cache-miss");
+    const Containers::Array<char> tga = Utility::Directory::read(TGA_FILE);
+    const std::string key = Implementation::importCacheKey(tga, "TgaImporter", "");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnyImageImporter");
+    importer->configuration().setValue("cacheDirectory", directory);
+    importer->setFlags(ImporterFlag::Verbose);
+
+    /* First time the file gets imported and stored into the cache. Messages
+       from TgaImporter are printed during the import already. */
+    std::ostringstream out;
+    {
+        Debug redirectOutput{&out};
+        CORRADE_VERIFY(importer->openFile(TGA_FILE));
+    }
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Trade::AnyImageImporter::openFile(): using TgaImporter\n"
+        "Trade::TgaImporter::image2D(): converting from BGR to RGB\n"
+        "Trade::AnyImageImporter::openFile(): cached the import as {}\n", key));
+    CORRADE_VERIFY(Utility::Directory::exists(Utility::Directory::join(directory, key + ".blob")));
+
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i(3, 2));
+
+    /* Second time it's taken from the cache */
+    out.str({});
+    {
+        Debug redirectOutput{&out};
+        CORRADE_VERIFY(importer->openFile(TGA_FILE));
+    }
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Trade::AnyImageImporter::openFile(): using a cached TgaImporter import {}\n", key));
+
+    Containers::Optional<ImageData2D> cached = importer->image2D(0);
+    CORRADE_VERIFY(cached);
+    CORRADE_COMPARE(cached->format(), image->format());
+    CORRADE_COMPARE(cached->size(), image->size());
+    CORRADE_COMPARE_AS(cached->data(), image->data(),
+        TestSuite::Compare::Container);
+}
+
+void AnyImageImporterTest::cacheEviction() {
+    const std::string directory = emptyCacheDirectory("cache-eviction");
+
+    /* Two entries for the same file, differing only in the user key */
+    const Containers::Array<char> tga = Utility::Directory::read(TGA_FILE);
+    const std::string a = Implementation::importCacheKey(tga, "TgaImporter", "a");
+    const std::string b = Implementation::importCacheKey(tga, "TgaImporter", "b");
+    CORRADE_VERIFY(a != b);
+    const Containers::Array<char> blob = ImageData2D{PixelFormat::RGBA8Unorm, {1, 1}, DataFlags{}, CachedPixels}.serialize();
+    CORRADE_VERIFY(Utility::Directory::write(Utility::Directory::join(directory, a + ".blob"), blob));
+    CORRADE_VERIFY(Utility::Directory::write(Utility::Directory::join(directory, b + ".blob"), blob));
+
+    /* With a zero size limit, only the most recently used entry is kept */
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnyImageImporter");
+    importer->configuration().setValue("cacheDirectory", directory);
+    importer->configuration().setValue("cacheSize", 0);
+
+    importer->configuration().setValue("cacheKey", "a");
+    CORRADE_VERIFY(importer->openFile(TGA_FILE));
+    CORRADE_VERIFY(Utility::Directory::exists(Utility::Directory::join(directory, a + ".blob")));
+    CORRADE_VERIFY(Utility::Directory::exists(Utility::Directory::join(directory, b + ".blob")));
+
+    importer->configuration().setValue("cacheKey", "b");
+    CORRADE_VERIFY(importer->openFile(TGA_FILE));
+    CORRADE_VERIFY(!Utility::Directory::exists(Utility::Directory::join(directory, a + ".blob")));
+    CORRADE_VERIFY(Utility::Directory::exists(Utility::Directory::join(directory, b + ".blob")));
+
+    Utility::Configuration index{Utility::Directory::join(directory, "index.conf")};
+    CORRADE_COMPARE(index.groupCount("entry"), 1);
+    CORRADE_COMPARE(index.group("entry")->value("key"), b);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::AnyImageImporterTest)
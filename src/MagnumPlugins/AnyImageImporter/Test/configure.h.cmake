@@ -27,3 +27,4 @@
 #cmakedefine TGAIMPORTER_PLUGIN_FILENAME "${TGAIMPORTER_PLUGIN_FILENAME}"
 #define TGA_FILE "${TGA_FILE}"
 #define TEST_FILE_DIR "${TEST_FILE_DIR}"
+#define ANYIMAGEIMPORTER_TEST_OUTPUT_DIR "${ANYIMAGEIMPORTER_TEST_OUTPUT_DIR}"
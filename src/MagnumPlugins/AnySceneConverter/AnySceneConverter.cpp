@@ -29,9 +29,9 @@
 #include <Corrade/PluginManager/PluginMetadata.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/DebugStl.h>
-#include <Corrade/Utility/String.h>
 
 #include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/Implementation/anyConverterPlugins.h"
 
 namespace Magnum { namespace Trade {
 
@@ -48,14 +48,9 @@ SceneConverterFeatures AnySceneConverter::doFeatures() const {
 bool AnySceneConverter::doConvertToFile(const std::string& filename, const MeshData& mesh) {
     CORRADE_INTERNAL_ASSERT(manager());
 
-    /** @todo lowercase only the extension, once Directory::split() is done */
-    const std::string normalized = Utility::String::lowercase(filename);
-
     /* Detect the plugin from extension */
-    std::string plugin;
-    if(Utility::String::endsWith(normalized, ".ply"))
-        plugin = "StanfordSceneConverter";
-    else {
+    const std::string plugin = Implementation::anySceneConverterPlugin(filename);
+    if(plugin.empty()) {
         Error{} << "Trade::AnySceneConverter::convertToFile(): cannot determine the format of" << filename;
         return false;
     }
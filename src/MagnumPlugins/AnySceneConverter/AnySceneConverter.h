@@ -56,6 +56,8 @@ namespace Magnum { namespace Trade {
 Detects file type based on file extension, loads corresponding plugin and then
 tries to convert the file with it. Supported formats:
 
+-   Magnum blob (`*.blob`), converted with @ref MagnumSceneConverter or any
+    other plugin that provides it
 -   Stanford (`*.ply`), converted with @ref StanfordSceneConverter or any other
     plugin that provides it
 
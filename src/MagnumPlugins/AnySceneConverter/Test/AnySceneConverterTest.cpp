@@ -56,6 +56,7 @@ constexpr struct {
     const char* filename;
     const char* plugin;
 } DetectData[]{
+    {"Magnum blob", "mesh.blob", "MagnumSceneConverter"},
     {"Stanford PLY", "bunny.ply", "StanfordSceneConverter"},
     {"Stanford PLY uppercase", "ARMADI~1.PLY", "StanfordSceneConverter"}
 };
@@ -25,13 +25,22 @@
 
 #include "AnySceneImporter.h"
 
+#include <algorithm>
+#include <cstring>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/PluginManager/PluginMetadata.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/String.h>
 
+#include "Magnum/Math/Functions.h"
+
 #include "Magnum/Trade/AnimationData.h"
 #include "Magnum/Trade/CameraData.h"
 #include "Magnum/Trade/ImageData.h"
@@ -40,6 +49,7 @@
 #include "Magnum/Trade/MeshData.h"
 #include "Magnum/Trade/ObjectData2D.h"
 #include "Magnum/Trade/ObjectData3D.h"
+#include "Magnum/Trade/Implementation/importCache.h"
 #include "Magnum/Trade/SceneData.h"
 #include "Magnum/Trade/SkinData.h"
 #include "Magnum/Trade/TextureData.h"
@@ -53,18 +63,139 @@
 
 namespace Magnum { namespace Trade {
 
+struct AnySceneImporter::Cache: Implementation::ImportCache {};
+
+namespace {
+
+/* Used in place of the plugin if it fails to load after a cache hit. Reports
+   zero of everything that's not in the cache, and counts of the cached data
+   so their (empty) names can be queried without going out of range. */
+struct EmptyImporter: AbstractImporter {
+    explicit EmptyImporter(const Implementation::ImportCache& cache): cache(cache) {}
+
+    ImporterFeatures doFeatures() const override { return {}; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    UnsignedInt doMeshCount() const override { return cache.meshes.size(); }
+    UnsignedInt doImage1DCount() const override { return cache.images1D.size(); }
+    UnsignedInt doImage2DCount() const override { return cache.images2D.size(); }
+    UnsignedInt doImage3DCount() const override { return cache.images3D.size(); }
+
+    const Implementation::ImportCache& cache;
+};
+
+}
+
 AnySceneImporter::AnySceneImporter(PluginManager::Manager<AbstractImporter>& manager): AbstractImporter{manager} {}
 
 AnySceneImporter::AnySceneImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
 AnySceneImporter::~AnySceneImporter() = default;
 
-ImporterFeatures AnySceneImporter::doFeatures() const { return {}; }
+ImporterFeatures AnySceneImporter::doFeatures() const { return ImporterFeature::OpenData; }
 
-bool AnySceneImporter::doIsOpened() const { return !!_in; }
+bool AnySceneImporter::doIsOpened() const { return _in || _cache; }
 
 void AnySceneImporter::doClose() {
     _in = nullptr;
+    _cache = nullptr;
+    _plugin = {};
+    _filename = {};
+    _data = nullptr;
+}
+
+AbstractImporter& AnySceneImporter::in() const {
+    /* After a cache hit, the plugin gets loaded only once data that aren't
+       in the cache are accessed */
+    if(!_in) {
+        CORRADE_INTERNAL_ASSERT(_cache);
+        _in = const_cast<AnySceneImporter&>(*this).openPlugin(_filename.empty() ? "Trade::AnySceneImporter::openData():" : "Trade::AnySceneImporter::openFile():", _plugin, _filename, _data);
+        if(!_in) _in.reset(new EmptyImporter{*_cache});
+    }
+
+    return *_in;
+}
+
+Containers::Pointer<AbstractImporter> AnySceneImporter::openPlugin(const char* const messagePrefix, const std::string& plugin, const std::string& filename, const Containers::ArrayView<const char> data) {
+    /* Try to load the plugin */
+    if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
+        Error{} << messagePrefix << "cannot load the" << plugin << "plugin";
+        return nullptr;
+    }
+    if(flags() & ImporterFlag::Verbose) {
+        Debug d;
+        d << messagePrefix << "using" << plugin;
+        PluginManager::PluginMetadata* metadata = manager()->metadata(plugin);
+        CORRADE_INTERNAL_ASSERT(metadata);
+        if(plugin != metadata->name())
+            d << "(provided by" << metadata->name() << Debug::nospace << ")";
+    }
+
+    /* Instantiate the plugin, propagate flags */
+    Containers::Pointer<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin);
+    importer->setFlags(flags());
+
+    /* Try to open the file or data (error output should be printed by the
+       plugin itself). When opening data, propagate file callbacks so the
+       plugin can load external files such as glTF buffers. */
+    if(filename.empty()) {
+        if(fileCallback() && (importer->features() & ImporterFeature::FileCallback))
+            importer->setFileCallback(fileCallback(), fileCallbackUserData());
+        if(!importer->openData(data)) return nullptr;
+    } else if(!importer->openFile(filename)) return nullptr;
+
+    return importer;
+}
+
+void AnySceneImporter::openInternal(const char* const messagePrefix, const std::string& plugin, const std::string& filename, const Containers::ArrayView<const char> data) {
+    /* If caching is enabled, look into the cache first. A file is read only
+       to calculate the cache key. */
+    const std::string directory = configuration().value("cacheDirectory");
+    const UnsignedLong maxSize = configuration().value<UnsignedLong>("cacheSize")*1024*1024;
+    std::string key;
+    if(!directory.empty() && (!filename.empty() ? Utility::Directory::exists(filename) : !data.empty())) {
+        const Containers::Array<char> fileData = filename.empty() ?
+            Containers::Array<char>{} : Utility::Directory::read(filename);
+        key = Implementation::importCacheKey(filename.empty() ? data : Containers::ArrayView<const char>{fileData}, plugin, configuration().value("cacheKey"));
+        Containers::Pointer<Cache> cache{new Cache};
+        if(Implementation::importCacheOpen(*cache, directory, key, maxSize)) {
+            if(flags() & ImporterFlag::Verbose)
+                Debug{} << messagePrefix << "using a cached" << plugin << "import" << key;
+
+            /* Remember the plugin and filename for opening the file lazily
+               if anything that's not in the cache is accessed. Data passed
+               to openData() aren't guaranteed to stay in scope, so they have
+               to be copied. */
+            _cache = std::move(cache);
+            _plugin = plugin;
+            _filename = filename;
+            if(filename.empty()) {
+                _data = Containers::Array<char>{Containers::NoInit, data.size()};
+                Utility::copy(data, _data);
+            }
+            return;
+        }
+    }
+
+    Containers::Pointer<AbstractImporter> importer = openPlugin(messagePrefix, plugin, filename, data);
+    if(!importer) return;
+
+    /* If caching is enabled, import all meshes and images and serve them from
+       the serialized data, so the first run behaves the same as the following
+       ones. If that fails, use the importer directly. */
+    if(!key.empty()) {
+        Containers::Pointer<Cache> cache{new Cache};
+        if(Implementation::importCacheStore(*cache, *importer, Implementation::ImportCacheMeshes|Implementation::ImportCacheImages1D|Implementation::ImportCacheImages2D|Implementation::ImportCacheImages3D, directory, key, maxSize)) {
+            if(flags() & ImporterFlag::Verbose)
+                Debug{} << messagePrefix << "cached the import as" << key;
+
+            _cache = std::move(cache);
+        }
+    }
+
+    /* Success, save the instance */
+    _in = std::move(importer);
 }
 
 void AnySceneImporter::doOpenFile(const std::string& filename) {
@@ -105,6 +236,8 @@ void AnySceneImporter::doOpenFile(const std::string& filename) {
     else if(Utility::String::endsWith(normalized, ".lwo") ||
             Utility::String::endsWith(normalized, ".lws"))
         plugin = "LightWaveImporter";
+    else if(Utility::String::endsWith(normalized, ".blob"))
+        plugin = "MagnumImporter";
     else if(Utility::String::endsWith(normalized, ".lxo"))
         plugin = "ModoImporter";
     else if(Utility::String::endsWith(normalized, ".ms3d"))
@@ -135,123 +268,273 @@ void AnySceneImporter::doOpenFile(const std::string& filename) {
         return;
     }
 
-    /* Try to load the plugin */
-    if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
-        Error{} << "Trade::AnySceneImporter::openFile(): cannot load the" << plugin << "plugin";
-        return;
-    }
-    if(flags() & ImporterFlag::Verbose) {
-        Debug d;
-        d << "Trade::AnySceneImporter::openFile(): using" << plugin;
-        PluginManager::PluginMetadata* metadata = manager()->metadata(plugin);
-        CORRADE_INTERNAL_ASSERT(metadata);
-        if(plugin != metadata->name())
-            d << "(provided by" << metadata->name() << Debug::nospace << ")";
-    }
+    openInternal("Trade::AnySceneImporter::openFile():", plugin, filename, nullptr);
+}
 
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin);
-    importer->setFlags(flags());
+namespace {
 
-    /* Try to open the file (error output should be printed by the plugin
-       itself) */
-    if(!importer->openFile(filename)) return;
+bool isWhitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
 
-    /* Success, save the instance */
-    _in = std::move(importer);
+bool contains(const Containers::ArrayView<const char> data, const Containers::StringView string) {
+    return std::search(data.begin(), data.end(), string.begin(), string.end()) != data.end();
 }
 
-UnsignedInt AnySceneImporter::doAnimationCount() const { return _in->animationCount(); }
-Int AnySceneImporter::doAnimationForName(const std::string& name) { return _in->animationForName(name); }
-std::string AnySceneImporter::doAnimationName(const UnsignedInt id) { return _in->animationName(id); }
-Containers::Optional<AnimationData> AnySceneImporter::doAnimation(const UnsignedInt id) { return _in->animation(id); }
+/* Checks that the first line that isn't empty or a comment starts with one of
+   the OBJ keywords. Comments are common at the start of OBJ files, so those
+   are skipped. */
+bool isObj(const Containers::StringView text) {
+    using namespace Containers::Literals;
+
+    for(std::size_t i = 0; i < text.size(); ) {
+        /* Skip leading whitespace and empty lines */
+        if(isWhitespace(text[i])) {
+            ++i;
+            continue;
+        }
+
+        /* Skip comments */
+        if(text[i] == '#') {
+            while(i < text.size() && text[i] != '\n') ++i;
+            continue;
+        }
+
+        /* The first word has to be one of the keywords, followed by a
+           whitespace */
+        std::size_t end = i;
+        while(end < text.size() && !isWhitespace(text[end])) ++end;
+        if(end == text.size()) return false;
+        const Containers::StringView word = text.slice(i, end);
+        for(const Containers::StringView keyword: {"v"_s, "vt"_s, "vn"_s, "vp"_s, "f"_s, "l"_s, "p"_s, "o"_s, "g"_s, "s"_s, "mtllib"_s, "usemtl"_s})
+            if(word == keyword) return true;
+        return false;
+    }
 
-Int AnySceneImporter::doDefaultScene() const { return _in->defaultScene(); }
+    return false;
+}
 
-UnsignedInt AnySceneImporter::doSceneCount() const { return _in->sceneCount(); }
-Int AnySceneImporter::doSceneForName(const std::string& name) { return _in->sceneForName(name); }
-std::string AnySceneImporter::doSceneName(const UnsignedInt id) { return _in->sceneName(id); }
-Containers::Optional<SceneData> AnySceneImporter::doScene(const UnsignedInt id) { return _in->scene(id); }
+}
 
-UnsignedInt AnySceneImporter::doLightCount() const { return _in->lightCount(); }
-Int AnySceneImporter::doLightForName(const std::string& name) { return _in->lightForName(name); }
-std::string AnySceneImporter::doLightName(const UnsignedInt id) { return _in->lightName(id); }
-Containers::Optional<LightData> AnySceneImporter::doLight(const UnsignedInt id) { return _in->light(id); }
+void AnySceneImporter::doOpenData(Containers::ArrayView<const char> data) {
+    using namespace Containers::Literals;
 
-UnsignedInt AnySceneImporter::doCameraCount() const { return _in->cameraCount(); }
-Int AnySceneImporter::doCameraForName(const std::string& name) { return _in->cameraForName(name); }
-std::string AnySceneImporter::doCameraName(const UnsignedInt id) { return _in->cameraName(id); }
-Containers::Optional<CameraData> AnySceneImporter::doCamera(const UnsignedInt id) { return _in->camera(id); }
+    CORRADE_INTERNAL_ASSERT(manager());
 
-UnsignedInt AnySceneImporter::doObject2DCount() const { return _in->object2DCount(); }
-Int AnySceneImporter::doObject2DForName(const std::string& name) { return _in->object2DForName(name); }
-std::string AnySceneImporter::doObject2DName(const UnsignedInt id) { return _in->object2DName(id); }
-Containers::Pointer<ObjectData2D> AnySceneImporter::doObject2D(const UnsignedInt id) { return _in->object2D(id); }
+    /* So we can use the convenient hasPrefix() API */
+    const Containers::StringView dataString = data;
 
-UnsignedInt AnySceneImporter::doObject3DCount() const { return _in->object3DCount(); }
-Int AnySceneImporter::doObject3DForName(const std::string& name) { return _in->object3DForName(name); }
-std::string AnySceneImporter::doObject3DName(const UnsignedInt id) { return _in->object3DName(id); }
-Containers::Pointer<ObjectData3D> AnySceneImporter::doObject3D(const UnsignedInt id) { return _in->object3D(id); }
+    /* Text formats can start with an UTF-8 BOM or whitespace, skip it. Look
+       only at the beginning of the file for text markers, a 4 kB prefix should
+       be enough for any reasonable header. */
+    Containers::StringView text = dataString;
+    if(text.hasPrefix("\xef\xbb\xbf"_s)) text = text.suffix(3);
+    while(text.size() && isWhitespace(text[0])) text = text.suffix(1);
+    const Containers::ArrayView<const char> textPrefix = Containers::ArrayView<const char>{text}.prefix(Math::min(text.size(), std::size_t{4096}));
 
-UnsignedInt AnySceneImporter::doSkin2DCount() const { return _in->skin2DCount(); }
-Int AnySceneImporter::doSkin2DForName(const std::string& name) { return _in->skin2DForName(name); }
-std::string AnySceneImporter::doSkin2DName(const UnsignedInt id) { return _in->skin2DName(id); }
-Containers::Optional<SkinData2D> AnySceneImporter::doSkin2D(const UnsignedInt id) { return _in->skin2D(id); }
+    std::string plugin;
+    /* Trade::DataChunkHeader::magic */
+    if(dataString.hasPrefix("BLOB"_s))
+        plugin = "MagnumImporter";
+    /* https://github.com/KhronosGroup/glTF/tree/master/specification/2.0#binary-header */
+    else if(dataString.hasPrefix("glTF"_s))
+        plugin = "GltfImporter";
+    /* https://code.blender.org/2013/08/fbx-binary-file-format-specification/ */
+    else if(dataString.hasPrefix("Kaydara FBX Binary  \x00"_s))
+        plugin = "FbxImporter";
+    /* http://paulbourke.net/dataformats/ply/ */
+    else if(dataString.hasPrefix("ply\n"_s) || dataString.hasPrefix("ply\r\n"_s))
+        plugin = "StanfordImporter";
+    /* https://github.com/dfelinto/blender/blob/master/doc/blender_file_format/mystery_of_the_blend.html */
+    else if(dataString.hasPrefix("BLENDER"_s))
+        plugin = "BlenderImporter";
+    /* http://paulbourke.net/dataformats/directx/#xfilefrm_Header */
+    else if(dataString.hasPrefix("xof "_s))
+        plugin = "DirectXImporter";
+    /* https://www.inivis.com/ac3d/man/ac3dfileformat.html */
+    else if(dataString.hasPrefix("AC3D"_s))
+        plugin = "Ac3dImporter";
+    /* http://paulbourke.net/dataformats/ms3d/ms3dspec.h */
+    else if(dataString.hasPrefix("MS3D000000"_s))
+        plugin = "MilkshapeImporter";
+    /* IFF containers, http://static.lightwave3d.com/sdk/2015/html/filefmts/lwo2.html */
+    else if(dataString.size() >= 12 && dataString.hasPrefix("FORM"_s) &&
+            (dataString.slice(8, 12) == "LWO2"_s ||
+             dataString.slice(8, 12) == "LWOB"_s))
+        plugin = "LightWaveImporter";
+    else if(dataString.size() >= 12 && dataString.hasPrefix("FORM"_s) &&
+            dataString.slice(8, 12) == "LXOB"_s)
+        plugin = "ModoImporter";
+    /* https://research.cs.wisc.edu/graphics/Courses/cs-838-1999/Jeff/BVH.html */
+    else if(text.hasPrefix("HIERARCHY"_s))
+        plugin = "BvhImporter";
+    /* ASCII STL. Binary STLs often start with "solid" as well, but
+       StlImporter handles both. */
+    else if(text.hasPrefix("solid"_s))
+        plugin = "StlImporter";
+    /* glTF JSON, which has to contain the asset property */
+    else if(text.hasPrefix("{"_s) && contains(textPrefix, "\"asset\""_s))
+        plugin = "GltfImporter";
+    /* COLLADA XML */
+    else if(text.hasPrefix("<"_s) && contains(textPrefix, "<COLLADA"_s))
+        plugin = "ColladaImporter";
+    /* OpenGEX, https://opengex.org/OpenGEX.3.0.pdf, usually starts with a
+       Metric or GeometryNode structure */
+    else if(text.hasPrefix("Metric"_s) || text.hasPrefix("GeometryNode"_s))
+        plugin = "OpenGexImporter";
+    /* OBJ files have no signature, so this is a guesswork based on the first
+       meaningful line */
+    else if(isObj(text))
+        plugin = "ObjImporter";
+    /* Binary STL, http://paulbourke.net/dataformats/stl/, an 80-byte header
+       followed by a triangle count and 50 bytes for each triangle. Again a
+       guesswork, so try after everything else fails. */
+    else if(data.size() >= 84 && [data]() {
+            UnsignedInt count;
+            std::memcpy(&count, data.data() + 80, 4);
+            return data.size() == 84 + std::size_t(count)*50;
+        }())
+        plugin = "StlImporter";
+    /* 3DS, http://paulbourke.net/dataformats/3ds/, the main chunk ID followed
+       by a size that's equal to the file size */
+    else if(data.size() >= 6 && dataString.hasPrefix("\x4d\x4d"_s) && [data]() {
+            UnsignedInt size;
+            std::memcpy(&size, data.data() + 2, 4);
+            return data.size() == size;
+        }())
+        plugin = "3dsImporter";
+    else if(!data.size()) {
+        Error{} << "Trade::AnySceneImporter::openData(): file is empty";
+        return;
+    } else {
+        /* FFS so much casting to avoid implicit sign extension ruining
+           everything */
+        UnsignedInt signature = UnsignedInt(UnsignedByte(data[0])) << 24;
+        if(data.size() > 1) signature |= UnsignedInt(UnsignedByte(data[1])) << 16;
+        if(data.size() > 2) signature |= UnsignedInt(UnsignedByte(data[2])) << 8;
+        if(data.size() > 3) signature |= UnsignedInt(UnsignedByte(data[3]));
+        /* If there's less than four bytes, cut the rest away */
+        Error{} << "Trade::AnySceneImporter::openData(): cannot determine the format from signature 0x" << Debug::nospace << Utility::formatString("{:.8x}", signature).substr(0, data.size() < 4 ? data.size()*2 : std::string::npos);
+        return;
+    }
 
-UnsignedInt AnySceneImporter::doSkin3DCount() const { return _in->skin3DCount(); }
-Int AnySceneImporter::doSkin3DForName(const std::string& name) { return _in->skin3DForName(name); }
-std::string AnySceneImporter::doSkin3DName(const UnsignedInt id) { return _in->skin3DName(id); }
-Containers::Optional<SkinData3D> AnySceneImporter::doSkin3D(const UnsignedInt id) { return _in->skin3D(id); }
+    openInternal("Trade::AnySceneImporter::openData():", plugin, {}, data);
+}
 
-UnsignedInt AnySceneImporter::doMeshCount() const { return _in->meshCount(); }
-Int AnySceneImporter::doMeshForName(const std::string& name) { return _in->meshForName(name); }
-std::string AnySceneImporter::doMeshName(const UnsignedInt id) { return _in->meshName(id); }
-Containers::Optional<MeshData> AnySceneImporter::doMesh(const UnsignedInt id, const UnsignedInt level) { return _in->mesh(id, level); }
+UnsignedInt AnySceneImporter::doAnimationCount() const { return in().animationCount(); }
+Int AnySceneImporter::doAnimationForName(const std::string& name) { return in().animationForName(name); }
+std::string AnySceneImporter::doAnimationName(const UnsignedInt id) { return in().animationName(id); }
+Containers::Optional<AnimationData> AnySceneImporter::doAnimation(const UnsignedInt id) { return in().animation(id); }
+
+Int AnySceneImporter::doDefaultScene() const { return in().defaultScene(); }
+
+UnsignedInt AnySceneImporter::doSceneCount() const { return in().sceneCount(); }
+Int AnySceneImporter::doSceneForName(const std::string& name) { return in().sceneForName(name); }
+std::string AnySceneImporter::doSceneName(const UnsignedInt id) { return in().sceneName(id); }
+Containers::Optional<SceneData> AnySceneImporter::doScene(const UnsignedInt id) { return in().scene(id); }
+
+UnsignedInt AnySceneImporter::doLightCount() const { return in().lightCount(); }
+Int AnySceneImporter::doLightForName(const std::string& name) { return in().lightForName(name); }
+std::string AnySceneImporter::doLightName(const UnsignedInt id) { return in().lightName(id); }
+Containers::Optional<LightData> AnySceneImporter::doLight(const UnsignedInt id) { return in().light(id); }
+
+UnsignedInt AnySceneImporter::doCameraCount() const { return in().cameraCount(); }
+Int AnySceneImporter::doCameraForName(const std::string& name) { return in().cameraForName(name); }
+std::string AnySceneImporter::doCameraName(const UnsignedInt id) { return in().cameraName(id); }
+Containers::Optional<CameraData> AnySceneImporter::doCamera(const UnsignedInt id) { return in().camera(id); }
+
+UnsignedInt AnySceneImporter::doObject2DCount() const { return in().object2DCount(); }
+Int AnySceneImporter::doObject2DForName(const std::string& name) { return in().object2DForName(name); }
+std::string AnySceneImporter::doObject2DName(const UnsignedInt id) { return in().object2DName(id); }
+Containers::Pointer<ObjectData2D> AnySceneImporter::doObject2D(const UnsignedInt id) { return in().object2D(id); }
+
+UnsignedInt AnySceneImporter::doObject3DCount() const { return in().object3DCount(); }
+Int AnySceneImporter::doObject3DForName(const std::string& name) { return in().object3DForName(name); }
+std::string AnySceneImporter::doObject3DName(const UnsignedInt id) { return in().object3DName(id); }
+Containers::Pointer<ObjectData3D> AnySceneImporter::doObject3D(const UnsignedInt id) { return in().object3D(id); }
+
+UnsignedInt AnySceneImporter::doSkin2DCount() const { return in().skin2DCount(); }
+Int AnySceneImporter::doSkin2DForName(const std::string& name) { return in().skin2DForName(name); }
+std::string AnySceneImporter::doSkin2DName(const UnsignedInt id) { return in().skin2DName(id); }
+Containers::Optional<SkinData2D> AnySceneImporter::doSkin2D(const UnsignedInt id) { return in().skin2D(id); }
+
+UnsignedInt AnySceneImporter::doSkin3DCount() const { return in().skin3DCount(); }
+Int AnySceneImporter::doSkin3DForName(const std::string& name) { return in().skin3DForName(name); }
+std::string AnySceneImporter::doSkin3DName(const UnsignedInt id) { return in().skin3DName(id); }
+Containers::Optional<SkinData3D> AnySceneImporter::doSkin3D(const UnsignedInt id) { return in().skin3D(id); }
+
+UnsignedInt AnySceneImporter::doMeshCount() const {
+    return _cache ? _cache->meshes.size() : in().meshCount();
+}
+Int AnySceneImporter::doMeshForName(const std::string& name) { return in().meshForName(name); }
+std::string AnySceneImporter::doMeshName(const UnsignedInt id) { return in().meshName(id); }
+Containers::Optional<MeshData> AnySceneImporter::doMesh(const UnsignedInt id, const UnsignedInt level) {
+    /* Only meshes with a single level get cached, so level is always 0 */
+    return _cache ? Implementation::importCacheMesh(_cache->meshes[id]) : in().mesh(id, level);
+}
 
-MeshAttribute AnySceneImporter::doMeshAttributeForName(const std::string& name) { return _in->meshAttributeForName(name); }
-std::string AnySceneImporter::doMeshAttributeName(const UnsignedShort id) { return _in->meshAttributeName(meshAttributeCustom(id)); }
+MeshAttribute AnySceneImporter::doMeshAttributeForName(const std::string& name) { return in().meshAttributeForName(name); }
+std::string AnySceneImporter::doMeshAttributeName(const UnsignedShort id) { return in().meshAttributeName(meshAttributeCustom(id)); }
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 CORRADE_IGNORE_DEPRECATED_PUSH
-UnsignedInt AnySceneImporter::doMesh2DCount() const { return _in->mesh2DCount(); }
-Int AnySceneImporter::doMesh2DForName(const std::string& name) { return _in->mesh2DForName(name); }
-std::string AnySceneImporter::doMesh2DName(const UnsignedInt id) { return _in->mesh2DName(id); }
-Containers::Optional<MeshData2D> AnySceneImporter::doMesh2D(const UnsignedInt id) { return _in->mesh2D(id); }
-
-UnsignedInt AnySceneImporter::doMesh3DCount() const { return _in->mesh3DCount(); }
-Int AnySceneImporter::doMesh3DForName(const std::string& name) { return _in->mesh3DForName(name); }
-std::string AnySceneImporter::doMesh3DName(const UnsignedInt id) { return _in->mesh3DName(id); }
-Containers::Optional<MeshData3D> AnySceneImporter::doMesh3D(const UnsignedInt id) { return _in->mesh3D(id); }
+UnsignedInt AnySceneImporter::doMesh2DCount() const { return in().mesh2DCount(); }
+Int AnySceneImporter::doMesh2DForName(const std::string& name) { return in().mesh2DForName(name); }
+std::string AnySceneImporter::doMesh2DName(const UnsignedInt id) { return in().mesh2DName(id); }
+Containers::Optional<MeshData2D> AnySceneImporter::doMesh2D(const UnsignedInt id) { return in().mesh2D(id); }
+
+UnsignedInt AnySceneImporter::doMesh3DCount() const { return in().mesh3DCount(); }
+Int AnySceneImporter::doMesh3DForName(const std::string& name) { return in().mesh3DForName(name); }
+std::string AnySceneImporter::doMesh3DName(const UnsignedInt id) { return in().mesh3DName(id); }
+Containers::Optional<MeshData3D> AnySceneImporter::doMesh3D(const UnsignedInt id) { return in().mesh3D(id); }
 CORRADE_IGNORE_DEPRECATED_POP
 #endif
 
-UnsignedInt AnySceneImporter::doMaterialCount() const { return _in->materialCount(); }
-Int AnySceneImporter::doMaterialForName(const std::string& name) { return _in->materialForName(name); }
-std::string AnySceneImporter::doMaterialName(const UnsignedInt id) { return _in->materialName(id); }
-Containers::Optional<MaterialData> AnySceneImporter::doMaterial(const UnsignedInt id) { return _in->material(id); }
-
-UnsignedInt AnySceneImporter::doTextureCount() const { return _in->textureCount(); }
-Int AnySceneImporter::doTextureForName(const std::string& name) { return _in->textureForName(name); }
-std::string AnySceneImporter::doTextureName(const UnsignedInt id) { return _in->textureName(id); }
-Containers::Optional<TextureData> AnySceneImporter::doTexture(const UnsignedInt id) { return _in->texture(id); }
-
-UnsignedInt AnySceneImporter::doImage1DCount() const { return _in->image1DCount(); }
-UnsignedInt AnySceneImporter::doImage1DLevelCount(UnsignedInt id) { return _in->image1DLevelCount(id); }
-Int AnySceneImporter::doImage1DForName(const std::string& name) { return _in->image1DForName(name); }
-std::string AnySceneImporter::doImage1DName(const UnsignedInt id) { return _in->image1DName(id); }
-Containers::Optional<ImageData1D> AnySceneImporter::doImage1D(const UnsignedInt id, const UnsignedInt level) { return _in->image1D(id, level); }
-
-UnsignedInt AnySceneImporter::doImage2DCount() const { return _in->image2DCount(); }
-UnsignedInt AnySceneImporter::doImage2DLevelCount(UnsignedInt id) { return _in->image2DLevelCount(id); }
-Int AnySceneImporter::doImage2DForName(const std::string& name) { return _in->image2DForName(name); }
-std::string AnySceneImporter::doImage2DName(const UnsignedInt id) { return _in->image2DName(id); }
-Containers::Optional<ImageData2D> AnySceneImporter::doImage2D(const UnsignedInt id, const UnsignedInt level) { return _in->image2D(id, level); }
-
-UnsignedInt AnySceneImporter::doImage3DCount() const { return _in->image3DCount(); }
-UnsignedInt AnySceneImporter::doImage3DLevelCount(UnsignedInt id) { return _in->image3DLevelCount(id); }
-Int AnySceneImporter::doImage3DForName(const std::string& name) { return _in->image3DForName(name); }
-std::string AnySceneImporter::doImage3DName(const UnsignedInt id) { return _in->image3DName(id); }
-Containers::Optional<ImageData3D> AnySceneImporter::doImage3D(const UnsignedInt id, const UnsignedInt level) { return _in->image3D(id, level); }
+UnsignedInt AnySceneImporter::doMaterialCount() const { return in().materialCount(); }
+Int AnySceneImporter::doMaterialForName(const std::string& name) { return in().materialForName(name); }
+std::string AnySceneImporter::doMaterialName(const UnsignedInt id) { return in().materialName(id); }
+Containers::Optional<MaterialData> AnySceneImporter::doMaterial(const UnsignedInt id) { return in().material(id); }
+
+UnsignedInt AnySceneImporter::doTextureCount() const { return in().textureCount(); }
+Int AnySceneImporter::doTextureForName(const std::string& name) { return in().textureForName(name); }
+std::string AnySceneImporter::doTextureName(const UnsignedInt id) { return in().textureName(id); }
+Containers::Optional<TextureData> AnySceneImporter::doTexture(const UnsignedInt id) { return in().texture(id); }
+
+UnsignedInt AnySceneImporter::doImage1DCount() const {
+    return _cache ? _cache->images1D.size() : in().image1DCount();
+}
+UnsignedInt AnySceneImporter::doImage1DLevelCount(UnsignedInt id) {
+    return _cache ? ImageData1D::deserializeLevelCount(_cache->images1D[id]) : in().image1DLevelCount(id);
+}
+Int AnySceneImporter::doImage1DForName(const std::string& name) { return in().image1DForName(name); }
+std::string AnySceneImporter::doImage1DName(const UnsignedInt id) { return in().image1DName(id); }
+Containers::Optional<ImageData1D> AnySceneImporter::doImage1D(const UnsignedInt id, const UnsignedInt level) {
+    return _cache ? Implementation::importCacheImage<1>(_cache->images1D[id], level) : in().image1D(id, level);
+}
+
+UnsignedInt AnySceneImporter::doImage2DCount() const {
+    return _cache ? _cache->images2D.size() : in().image2DCount();
+}
+UnsignedInt AnySceneImporter::doImage2DLevelCount(UnsignedInt id) {
+    return _cache ? ImageData2D::deserializeLevelCount(_cache->images2D[id]) : in().image2DLevelCount(id);
+}
+Int AnySceneImporter::doImage2DForName(const std::string& name) { return in().image2DForName(name); }
+std::string AnySceneImporter::doImage2DName(const UnsignedInt id) { return in().image2DName(id); }
+Containers::Optional<ImageData2D> AnySceneImporter::doImage2D(const UnsignedInt id, const UnsignedInt level) {
+    return _cache ? Implementation::importCacheImage<2>(_cache->images2D[id], level) : in().image2D(id, level);
+}
+
+UnsignedInt AnySceneImporter::doImage3DCount() const {
+    return _cache ? _cache->images3D.size() : in().image3DCount();
+}
+UnsignedInt AnySceneImporter::doImage3DLevelCount(UnsignedInt id) {
+    return _cache ? ImageData3D::deserializeLevelCount(_cache->images3D[id]) : in().image3DLevelCount(id);
+}
+Int AnySceneImporter::doImage3DForName(const std::string& name) { return in().image3DForName(name); }
+std::string AnySceneImporter::doImage3DName(const UnsignedInt id) { return in().image3DName(id); }
+Containers::Optional<ImageData3D> AnySceneImporter::doImage3D(const UnsignedInt id, const UnsignedInt level) {
+    return _cache ? Implementation::importCacheImage<3>(_cache->images3D[id], level) : in().image3D(id, level);
+}
 
 }}
 
@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Trade::AnySceneImporter
  */
 
+#include <Corrade/Containers/Array.h>
+
 #include "Magnum/Trade/AbstractImporter.h"
 #include "MagnumPlugins/AnySceneImporter/configure.h"
 
@@ -76,6 +78,8 @@ tries to open the file with it. Supported formats:
     provides `IrrlichtImporter`
 -   LightWave, LightWave Scene (`*.lwo`, `*.lws`), loaded with any plugin that
     provides `LightWaveImporter`
+-   Magnum blob (`*.blob`), loaded with @ref MagnumImporter or any other
+    plugin that provides it
 -   Modo (`*.lxo`), loaded with any plugin that provides `ModoImporter`
 -   Milkshape 3D (`*.ms3d`), loaded with any plugin that provides
     `MilkshapeImporter`
@@ -95,7 +99,17 @@ tries to open the file with it. Supported formats:
     `ValveImporter`
 -   XGL (`*.xgl`, `*.zgl`), loaded with any plugin that provides `XglImporter`
 
-Only loading from files is supported.
+Detects file type based on signature when opening through @ref openData().
+Binary formats with a signature are detected for Magnum blobs, binary glTF,
+binary FBX, Stanford PLY, Blender, DirectX X, AC3D, Milkshape 3D, LightWave
+and Modo files. Text formats are detected from the first few kilobytes of
+data for BVH, ASCII STL, glTF JSON, COLLADA, OpenGEX and Wavefront OBJ files,
+while binary STL and 3DS files are detected based on the size stored in their
+header. As those are a guesswork, they're checked only after all formats with
+a signature. The data are passed to the concrete plugin directly without any
+copy, and file callbacks are propagated to it if it supports
+@ref ImporterFeature::FileCallback, so external files such as glTF buffers
+can be loaded as well.
 
 @section Trade-AnySceneImporter-usage Usage
 
@@ -127,6 +141,42 @@ target_link_libraries(your-app PRIVATE Magnum::AnySceneImporter)
 
 See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
 information.
+
+@section Trade-AnySceneImporter-cache Import cache
+
+If the @cb{.ini} cacheDirectory @ce @ref Trade-AnySceneImporter-configuration "configuration option"
+is set, the imported data are serialized into a
+@ref Trade-MeshData-serialization "Magnum blob" in given directory on the
+first import and subsequent imports of the same file then only memory-map the
+blob instead of loading and running the concrete plugin. The cache key is a
+SHA-1 hash of the file contents, the concrete plugin name and the
+@cb{.ini} cacheKey @ce option. Once the cache grows over
+@cb{.ini} cacheSize @ce megabytes, least recently used entries get removed.
+Meshes and 1D, 2D and 3D images are cached. If a file contains a mesh with
+multiple levels, it's not cached at all. Other data such as scenes or
+materials are not cached --- on a cache hit the concrete plugin is loaded and
+the file opened only once such data are accessed. If the plugin fails to load
+at that point, an error is printed and everything that's not in the cache is
+reported as empty. Because the plugin manager gets accessed outside of
+@ref openFile() and @ref openData() in that case, the plugin can't be used
+with @ref AsyncImporter while the cache is enabled. Only the top-level file is
+hashed, so changes in externally referenced files such as buffers or textures
+are not detected. Use the @cb{.ini} cacheKey @ce option to invalidate the
+cache in that case.
+
+Meshes and images returned from the cache are copied out of the blob, so
+they're owned and mutable and stay valid after the file is closed, same as
+when they come from the concrete plugin.
+
+@section Trade-AnySceneImporter-configuration Plugin-specific configuration
+
+It's possible to tune various options mainly for the import cache through
+@ref configuration(). See below for all options and their default values:
+
+@snippet MagnumPlugins/AnySceneImporter/AnySceneImporter.conf config
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_ANYSCENEIMPORTER_EXPORT AnySceneImporter: public AbstractImporter {
     public:
@@ -142,6 +192,7 @@ class MAGNUM_ANYSCENEIMPORTER_EXPORT AnySceneImporter: public AbstractImporter {
         MAGNUM_ANYSCENEIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL void doClose() override;
+        MAGNUM_ANYSCENEIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
 
         MAGNUM_ANYSCENEIMPORTER_LOCAL UnsignedInt doAnimationCount() const override;
@@ -238,7 +289,16 @@ class MAGNUM_ANYSCENEIMPORTER_EXPORT AnySceneImporter: public AbstractImporter {
         MAGNUM_ANYSCENEIMPORTER_LOCAL std::string doImage3DName(UnsignedInt id) override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL Containers::Optional<ImageData3D> doImage3D(UnsignedInt id, UnsignedInt level) override;
 
-        Containers::Pointer<AbstractImporter> _in;
+        struct Cache;
+
+        MAGNUM_ANYSCENEIMPORTER_LOCAL AbstractImporter& in() const;
+        MAGNUM_ANYSCENEIMPORTER_LOCAL Containers::Pointer<AbstractImporter> openPlugin(const char* messagePrefix, const std::string& plugin, const std::string& filename, Containers::ArrayView<const char> data);
+        MAGNUM_ANYSCENEIMPORTER_LOCAL void openInternal(const char* messagePrefix, const std::string& plugin, const std::string& filename, Containers::ArrayView<const char> data);
+
+        mutable Containers::Pointer<AbstractImporter> _in;
+        Containers::Pointer<Cache> _cache;
+        std::string _plugin, _filename;
+        Containers::Array<char> _data;
 };
 
 }}
@@ -26,14 +26,21 @@
 #include <sstream>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/FormatStl.h>
 
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/Implementation/importCache.h"
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include "Magnum/Trade/AsyncImporter.h"
+#endif
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 #define _MAGNUM_NO_DEPRECATED_MESHDATA /* So it doesn't yell here */
@@ -52,12 +59,25 @@ struct AnySceneImporterTest: TestSuite::Tester {
     #ifdef MAGNUM_BUILD_DEPRECATED
     void loadDeprecatedMeshData();
     #endif
+    void loadData();
     void detect();
+    void detectSignature();
 
     void unknown();
+    void unknownSignature();
+    void emptyData();
 
     void verbose();
 
+    void cacheHit();
+    void cacheMiss();
+    void cacheLazyOpen();
+    void cacheLazyOpenPluginLoadFailed();
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void async();
+    #endif
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
@@ -78,6 +98,7 @@ constexpr struct {
     {"COLLADA", "xml.dae", "ColladaImporter"},
     {"FBX", "autodesk.fbx", "FbxImporter"},
     {"glTF", "khronos.gltf", "GltfImporter"},
+    {"Magnum blob", "mesh.blob", "MagnumImporter"},
     {"OpenGEX", "eric.ogex", "OpenGexImporter"},
     {"Stanford PLY", "bunny.ply", "StanfordImporter"},
     {"Stanford PLY uppercase", "ARMADI~1.PLY", "StanfordImporter"},
@@ -85,6 +106,48 @@ constexpr struct {
     /* Not testing everything, only the most important ones */
 };
 
+using namespace Containers::Literals;
+
+const struct {
+    const char* name;
+    Containers::StringView data;
+    const char* plugin;
+} DetectSignatureData[]{
+    {"Magnum blob", "BLOB\x80\x00\x34\x12"_s, "MagnumImporter"},
+    {"glTF binary", "glTF\x02\x00\x00\x00"_s, "GltfImporter"},
+    {"glTF JSON", "\xef\xbb\xbf  {\n  \"asset\": {\"version\": \"2.0\"}\n}"_s, "GltfImporter"},
+    {"FBX", "Kaydara FBX Binary  \x00\x1a\x00"_s, "FbxImporter"},
+    {"COLLADA", "<?xml version=\"1.0\"?>\n<COLLADA xmlns=\"http://www.collada.org/2005/11/COLLADASchema\">"_s, "ColladaImporter"},
+    {"Stanford PLY", "ply\nformat ascii 1.0\n"_s, "StanfordImporter"},
+    {"Stanford PLY CRLF", "ply\r\nformat ascii 1.0\r\n"_s, "StanfordImporter"},
+    {"STL ASCII", "solid cube\n"_s, "StlImporter"},
+    {"STL binary", Containers::StringView{"\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+                                          "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+                                          "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+                                          "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+                                          "\x00\x00\x00\x00", 84}, "StlImporter"},
+    {"OpenGEX", "Metric {float {1.0}}\n"_s, "OpenGexImporter"},
+    {"OBJ", "# Exported by hand\n\nv 1 2 3\n"_s, "ObjImporter"},
+    {"OBJ mtllib", "mtllib scene.mtl\n"_s, "ObjImporter"},
+    {"3DS", "\x4d\x4d\x06\x00\x00\x00"_s, "3dsImporter"},
+    {"Blender", "BLENDER-v279"_s, "BlenderImporter"},
+    {"LightWave", "FORM\x00\x00\x00\x04LWO2"_s, "LightWaveImporter"},
+    {"Modo", "FORM\x00\x00\x00\x04LXOB"_s, "ModoImporter"},
+    /* Not testing everything, only the most important ones */
+};
+
+const struct {
+    const char* name;
+    Containers::StringView data;
+    const char* signature;
+} DetectUnknownData[]{
+    {"something random", "\x25\x3a\x00\x56 blablabla"_s, "253a0056"},
+    {"just one byte", "\x33"_s, "33"},
+    {"JSON but not glTF", "{\"hello\": 3}"_s, "7b226865"},
+    {"text but not OBJ", "hello world\n"_s, "68656c6c"},
+    {"3DS but wrong size", "\x4d\x4d\x07\x00\x00\x00"_s, "4d4d0700"}
+};
+
 AnySceneImporterTest::AnySceneImporterTest() {
     addInstancedTests({&AnySceneImporterTest::load},
         Containers::arraySize(LoadData));
@@ -93,12 +156,31 @@ AnySceneImporterTest::AnySceneImporterTest() {
     addTests({&AnySceneImporterTest::loadDeprecatedMeshData});
     #endif
 
+    addTests({&AnySceneImporterTest::loadData});
+
     addInstancedTests({&AnySceneImporterTest::detect},
         Containers::arraySize(DetectData));
 
-    addTests({&AnySceneImporterTest::unknown,
+    addInstancedTests({&AnySceneImporterTest::detectSignature},
+        Containers::arraySize(DetectSignatureData));
+
+    addTests({&AnySceneImporterTest::unknown});
 
-              &AnySceneImporterTest::verbose});
+    addInstancedTests({&AnySceneImporterTest::unknownSignature},
+        Containers::arraySize(DetectUnknownData));
+
+    addTests({&AnySceneImporterTest::emptyData,
+
+              &AnySceneImporterTest::verbose,
+
+              &AnySceneImporterTest::cacheHit,
+              &AnySceneImporterTest::cacheMiss,
+              &AnySceneImporterTest::cacheLazyOpen,
+              &AnySceneImporterTest::cacheLazyOpenPluginLoadFailed});
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    addTests({&AnySceneImporterTest::async});
+    #endif
 
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
@@ -152,6 +234,22 @@ void AnySceneImporterTest::loadDeprecatedMeshData() {
 }
 #endif
 
+void AnySceneImporterTest::loadData() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not enabled, cannot test");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+    CORRADE_VERIFY(importer->openData(Utility::Directory::read(OBJ_FILE)));
+
+    /* Check only size, as it is good enough proof that it is working */
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+
+    importer->close();
+    CORRADE_VERIFY(!importer->isOpened());
+}
+
 void AnySceneImporterTest::detect() {
     auto&& data = DetectData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -171,6 +269,25 @@ void AnySceneImporterTest::detect() {
     #endif
 }
 
+void AnySceneImporterTest::detectSignature() {
+    auto&& data = DetectSignatureData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data.data));
+    /* Can't use raw string literals in macros on GCC 4.8 */
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+"PluginManager::Manager::load(): plugin {0} is not static and was not found in nonexistent\nTrade::AnySceneImporter::openData(): cannot load the {0} plugin\n", data.plugin));
+    #else
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+"PluginManager::Manager::load(): plugin {0} was not found\nTrade::AnySceneImporter::openData(): cannot load the {0} plugin\n", data.plugin));
+    #endif
+}
+
 void AnySceneImporterTest::unknown() {
     std::ostringstream output;
     Error redirectError{&output};
@@ -181,6 +298,29 @@ void AnySceneImporterTest::unknown() {
     CORRADE_COMPARE(output.str(), "Trade::AnySceneImporter::openFile(): cannot determine the format of mesh.wtf\n");
 }
 
+void AnySceneImporterTest::unknownSignature() {
+    auto&& data = DetectUnknownData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::ostringstream output;
+    Error redirectError{&output};
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+    CORRADE_VERIFY(!importer->openData(data.data));
+
+    CORRADE_COMPARE(output.str(), Utility::formatString("Trade::AnySceneImporter::openData(): cannot determine the format from signature 0x{}\n", data.signature));
+}
+
+void AnySceneImporterTest::emptyData() {
+    std::ostringstream output;
+    Error redirectError{&output};
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+    CORRADE_VERIFY(!importer->openData(nullptr));
+
+    CORRADE_COMPARE(output.str(), "Trade::AnySceneImporter::openData(): file is empty\n");
+}
+
 void AnySceneImporterTest::verbose() {
     if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
         CORRADE_SKIP("ObjImporter plugin not enabled, cannot test");
@@ -202,6 +342,222 @@ void AnySceneImporterTest::verbose() {
     CORRADE_SKIP("No plugin with verbose output available to test flag propagation.");
 }
 
+/* Creates an empty cache directory and returns its path */
+std::string emptyCacheDirectory(const std::string& name) {
+    const std::string directory = Utility::Directory::join(ANYSCENEIMPORTER_TEST_OUTPUT_DIR, name);
+    if(Utility::Directory::exists(directory))
+        for(const std::string& file: Utility::Directory::list(directory, Utility::Directory::Flag::SkipDirectories))
+            CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::rm(Utility::Directory::join(directory, file)));
+    else CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::mkpath(directory));
+    return directory;
+}
+
+constexpr Vector3 CachedPositions[]{
+    {1.0f, 2.0f, 3.0f},
+    {4.0f, 5.0f, 6.0f}
+};
+
+/* Puts a two-vertex mesh into the cache under a key calculated from given
+   file, the importer should then return it instead of what's in the file */
+std::string writeCachedMesh(const std::string& directory, const std::string& filename, const std::string& plugin) {
+    const std::string key = Implementation::importCacheKey(Utility::Directory::read(filename), plugin, "");
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::write(Utility::Directory::join(directory, key + ".blob"), MeshData{MeshPrimitive::Lines, DataFlags{}, CachedPositions, {
+        MeshAttributeData{MeshAttribute::Position, Containers::arrayView(CachedPositions)}
+    }}.serialize()));
+    return key;
+}
+
+void AnySceneImporterTest::cacheHit() {
+    const std::string directory = emptyCacheDirectory("cache-hit");
+
+    /* ObjImporter doesn't even need to be present */
+    const std::string key = writeCachedMesh(directory, OBJ_FILE, "ObjImporter");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+    importer->configuration().setValue("cacheDirectory", directory);
+    importer->setFlags(ImporterFlag::Verbose);
+
+    std::ostringstream out;
+    {
+        Debug redirectOutput{&out};
+        CORRADE_VERIFY(importer->openFile(OBJ_FILE));
+    }
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Trade::AnySceneImporter::openFile(): using a cached ObjImporter import {}\n", key));
+
+    CORRADE_COMPARE(importer->meshCount(), 1);
+    CORRADE_COMPARE(importer->meshLevelCount(0), 1);
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView(CachedPositions),
+        TestSuite::Compare::Container);
+
+    /* The data are a copy, not a view into the cache, so they can be
+       modified in place */
+    CORRADE_COMPARE(mesh->indexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    mesh->mutableAttribute<Vector3>(MeshAttribute::Position)[1].x() = 7.0f;
+
+    importer->close();
+    CORRADE_VERIFY(!importer->isOpened());
+
+    /* And stay valid after the importer is closed */
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({{1.0f, 2.0f, 3.0f}, {7.0f, 5.0f, 6.0f}}),
+        TestSuite::Compare::Container);
+}
+
+void AnySceneImporterTest::cacheMiss() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not enabled, cannot test");
+
+    const std::string directory = emptyCacheDirectory("cache-miss");
+    const std::string key = Implementation::importCacheKey(Utility::Directory::read(OBJ_FILE), "ObjImporter", "");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+    importer->configuration().setValue("cacheDirectory", directory);
+    importer->setFlags(ImporterFlag::Verbose);
+
+    /* First time the file gets imported and stored into the cache */
+    std::ostringstream out;
+    {
+        Debug redirectOutput{&out};
+        CORRADE_VERIFY(importer->openFile(OBJ_FILE));
+    }
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Trade::AnySceneImporter::openFile(): using ObjImporter\n"
+        "Trade::AnySceneImporter::openFile(): cached the import as {}\n", key));
+    CORRADE_VERIFY(Utility::Directory::exists(Utility::Directory::join(directory, key + ".blob")));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+
+    /* Second time it's taken from the cache */
+    out.str({});
+    {
+        Debug redirectOutput{&out};
+        CORRADE_VERIFY(importer->openFile(OBJ_FILE));
+    }
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Trade::AnySceneImporter::openFile(): using a cached ObjImporter import {}\n", key));
+
+    Containers::Optional<MeshData> cached = importer->mesh(0);
+    CORRADE_VERIFY(cached);
+    CORRADE_COMPARE(cached->primitive(), mesh->primitive());
+    CORRADE_COMPARE(cached->vertexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE_AS(cached->attribute<Vector3>(MeshAttribute::Position),
+        mesh->attribute<Vector3>(MeshAttribute::Position),
+        TestSuite::Compare::Container);
+}
+
+void AnySceneImporterTest::cacheLazyOpen() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not enabled, cannot test");
+
+    const std::string directory = emptyCacheDirectory("cache-lazy-open");
+    const std::string key = writeCachedMesh(directory, OBJ_FILE, "ObjImporter");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+    importer->configuration().setValue("cacheDirectory", directory);
+    importer->setFlags(ImporterFlag::Verbose);
+
+    std::ostringstream out;
+    Debug redirectOutput{&out};
+    CORRADE_VERIFY(importer->openFile(OBJ_FILE));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+    CORRADE_VERIFY(importer->mesh(0));
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Trade::AnySceneImporter::openFile(): using a cached ObjImporter import {}\n", key));
+
+    /* Scenes and names aren't cached, so the plugin gets loaded and the file
+       opened on first access, but only once */
+    out.str({});
+    CORRADE_COMPARE(importer->sceneCount(), 0);
+    CORRADE_COMPARE(importer->object3DCount(), 0);
+    importer->meshName(0);
+    CORRADE_COMPARE(out.str(),
+        "Trade::AnySceneImporter::openFile(): using ObjImporter\n");
+
+    /* Meshes are still taken from the cache */
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), 2);
+}
+
+void AnySceneImporterTest::cacheLazyOpenPluginLoadFailed() {
+    /* StanfordImporter isn't available, but it's not needed until anything
+       that's not cached gets accessed */
+    const std::string filename = Utility::Directory::join(ANYSCENEIMPORTER_TEST_OUTPUT_DIR, "cache-plugin-load-failed.ply");
+    constexpr const char ply[] = "ply\nformat ascii 1.0\n";
+    CORRADE_VERIFY(Utility::Directory::write(filename, Containers::arrayView(ply, sizeof(ply) - 1)));
+    const std::string directory = emptyCacheDirectory("cache-plugin-load-failed");
+    writeCachedMesh(directory, filename, "StanfordImporter");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+    importer->configuration().setValue("cacheDirectory", directory);
+    CORRADE_VERIFY(importer->openFile(filename));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+    CORRADE_VERIFY(importer->mesh(0));
+
+    /* The failure is reported only once, everything not cached is empty
+       after */
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_COMPARE(importer->sceneCount(), 0);
+        CORRADE_COMPARE(importer->materialCount(), 0);
+        CORRADE_COMPARE(importer->meshName(0), "");
+        CORRADE_COMPARE(importer->meshForName("mesh"), -1);
+    }
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    CORRADE_COMPARE(out.str(),
+        "PluginManager::Manager::load(): plugin StanfordImporter is not static and was not found in nonexistent\n"
+        "Trade::AnySceneImporter::openFile(): cannot load the StanfordImporter plugin\n");
+    #else
+    CORRADE_COMPARE(out.str(),
+        "PluginManager::Manager::load(): plugin StanfordImporter was not found\n"
+        "Trade::AnySceneImporter::openFile(): cannot load the StanfordImporter plugin\n");
+    #endif
+
+    /* Cached data are still available */
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), 2);
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void AnySceneImporterTest::async() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not enabled, cannot test");
+
+    /* The worker importers instantiate ObjImporter when opening the file,
+       which has to happen on the calling thread as the manager isn't
+       thread-safe */
+    AsyncImporter importer{_manager, "AnySceneImporter", 4};
+    CORRADE_VERIFY(importer.openFile(OBJ_FILE));
+
+    std::future<Containers::Optional<MeshData>> meshes[8];
+    for(std::future<Containers::Optional<MeshData>>& mesh: meshes)
+        mesh = importer.mesh(0);
+    for(std::future<Containers::Optional<MeshData>>& mesh: meshes) {
+        Containers::Optional<MeshData> result = mesh.get();
+        CORRADE_VERIFY(result);
+        CORRADE_COMPARE(result->vertexCount(), 3);
+    }
+
+    /* Reopening goes through the same path again */
+    CORRADE_VERIFY(importer.openData(Utility::Directory::read(OBJ_FILE)));
+    CORRADE_VERIFY(importer.mesh(0).get());
+
+    importer.close();
+    CORRADE_VERIFY(!importer.isOpened());
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::AnySceneImporterTest)
@@ -26,3 +26,4 @@
 #cmakedefine ANYSCENEIMPORTER_PLUGIN_FILENAME "${ANYSCENEIMPORTER_PLUGIN_FILENAME}"
 #cmakedefine OBJIMPORTER_PLUGIN_FILENAME "${OBJIMPORTER_PLUGIN_FILENAME}"
 #define OBJ_FILE "${OBJ_FILE}"
+#define ANYSCENEIMPORTER_TEST_OUTPUT_DIR "${ANYSCENEIMPORTER_TEST_OUTPUT_DIR}"
@@ -25,9 +25,11 @@
 
 #include "MagnumFont.h"
 
+#include <algorithm>
 #include <sstream>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Configuration.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Unicode.h>
@@ -49,10 +51,32 @@ struct MagnumFont::Data {
     Utility::Configuration conf;
     Containers::Optional<Trade::ImageData2D> image;
     Containers::Optional<std::string> filePath;
-    std::unordered_map<char32_t, UnsignedInt> glyphId;
     std::vector<Vector2> glyphAdvance;
+
+    /* Two-level character->glyph map. A BMP codepoint is looked up in
+       bmpPages by its upper byte, giving a page in bmpGlyphs that's then
+       indexed by the lower byte. Pages that have no characters all point to
+       the first page of bmpGlyphs, which contains just zeros, i.e. the "Not
+       Found" glyph. Codepoints outside of the BMP are rare enough that a
+       sorted array and a binary search is good enough. */
+    UnsignedShort bmpPages[256]{};
+    std::vector<UnsignedInt> bmpGlyphs;
+    std::vector<std::pair<char32_t, UnsignedInt>> otherGlyphs;
+
+    UnsignedInt glyphId(char32_t character) const;
 };
 
+UnsignedInt MagnumFont::Data::glyphId(const char32_t character) const {
+    if(character < 0x10000)
+        return bmpGlyphs[bmpPages[character >> 8]*256 + (character & 0xff)];
+
+    const auto found = std::lower_bound(otherGlyphs.begin(), otherGlyphs.end(), character,
+        [](const std::pair<char32_t, UnsignedInt>& a, const char32_t b) {
+            return a.first < b;
+        });
+    return found != otherGlyphs.end() && found->first == character ? found->second : 0;
+}
+
 namespace {
     class MagnumFontLayouter: public AbstractLayouter {
         public:
@@ -74,7 +98,7 @@ MagnumFont::MagnumFont(PluginManager::AbstractManager& manager, const std::strin
 
 MagnumFont::~MagnumFont() { close(); }
 
-FontFeatures MagnumFont::doFeatures() const { return FontFeature::OpenData|FontFeature::FileCallback|FontFeature::PreparedGlyphCache; }
+FontFeatures MagnumFont::doFeatures() const { return FontFeature::OpenData|FontFeature::FileCallback|FontFeature::PreparedGlyphCache|FontFeature::BatchLayout; }
 
 bool MagnumFont::doIsOpened() const { return _opened && _opened->image; }
 
@@ -121,14 +145,41 @@ auto MagnumFont::doOpenData(const Containers::ArrayView<const char> data, const
     for(const Utility::ConfigurationGroup* const g: glyphs)
         _opened->glyphAdvance.push_back(g->value<Vector2>("advance"));
 
-    /* Fill character->glyph map */
+    /* Gather characters, figure out which BMP pages are used. Page 0 of the
+       glyph table is reserved for unused pages. */
     const std::vector<Utility::ConfigurationGroup*> chars = _opened->conf.groups("char");
+    std::vector<std::pair<char32_t, UnsignedInt>> characters;
+    characters.reserve(chars.size());
+    UnsignedShort pageCount = 1;
     for(const Utility::ConfigurationGroup* const c: chars) {
+        const char32_t character = c->value<char32_t>("unicode");
         const UnsignedInt glyphId = c->value<UnsignedInt>("glyph");
         CORRADE_INTERNAL_ASSERT(glyphId < _opened->glyphAdvance.size());
-        _opened->glyphId.emplace(c->value<char32_t>("unicode"), glyphId);
+        characters.emplace_back(character, glyphId);
+
+        if(character < 0x10000) {
+            UnsignedShort& page = _opened->bmpPages[character >> 8];
+            if(!page) page = pageCount++;
+        } else _opened->otherGlyphs.emplace_back(character, glyphId);
     }
 
+    /* Fill the BMP table. Going backwards so if a character is listed more
+       than once, the first occurence wins, same as for the rest below. */
+    _opened->bmpGlyphs.assign(pageCount*256, 0);
+    for(auto it = characters.rbegin(); it != characters.rend(); ++it)
+        if(it->first < 0x10000)
+            _opened->bmpGlyphs[_opened->bmpPages[it->first >> 8]*256 + (it->first & 0xff)] = it->second;
+
+    /* Sort the rest for binary search, removing duplicates */
+    std::stable_sort(_opened->otherGlyphs.begin(), _opened->otherGlyphs.end(),
+        [](const std::pair<char32_t, UnsignedInt>& a, const std::pair<char32_t, UnsignedInt>& b) {
+            return a.first < b.first;
+        });
+    _opened->otherGlyphs.erase(std::unique(_opened->otherGlyphs.begin(), _opened->otherGlyphs.end(),
+        [](const std::pair<char32_t, UnsignedInt>& a, const std::pair<char32_t, UnsignedInt>& b) {
+            return a.first == b.first;
+        }), _opened->otherGlyphs.end());
+
     return {_opened->conf.value<Float>("fontSize"),
             _opened->conf.value<Float>("ascent"),
             _opened->conf.value<Float>("descent"),
@@ -143,8 +194,7 @@ auto MagnumFont::doOpenFile(const std::string& filename, Float size) -> Metrics
 }
 
 UnsignedInt MagnumFont::doGlyphId(const char32_t character) {
-    auto it = _opened->glyphId.find(character);
-    return it != _opened->glyphId.end() ? it->second : 0;
+    return _opened->glyphId(character);
 }
 
 Vector2 MagnumFont::doGlyphAdvance(const UnsignedInt glyph) {
@@ -174,13 +224,28 @@ Containers::Pointer<AbstractLayouter> MagnumFont::doLayout(const AbstractGlyphCa
     for(std::size_t i = 0; i != text.size(); ) {
         UnsignedInt codepoint;
         std::tie(codepoint, i) = Utility::Unicode::nextChar(text, i);
-        const auto it = _opened->glyphId.find(codepoint);
-        glyphs.push_back(it == _opened->glyphId.end() ? 0 : it->second);
+        glyphs.push_back(_opened->glyphId(codepoint));
     }
 
     return Containers::Pointer<MagnumFontLayouter>(new MagnumFontLayouter(_opened->glyphAdvance, cache, this->size(), size, std::move(glyphs)));
 }
 
+UnsignedInt MagnumFont::doLayoutGlyphs(const Containers::ArrayView<const char> text, const Containers::StridedArrayView1D<UnsignedInt>& glyphIds, const Containers::StridedArrayView1D<Vector2>& glyphOffsets, const Containers::StridedArrayView1D<Vector2>& glyphAdvances) {
+    UnsignedInt count = 0;
+    for(std::size_t i = 0; i != text.size(); ++count) {
+        UnsignedInt codepoint;
+        std::tie(codepoint, i) = Utility::Unicode::nextChar(text, i);
+        if(count >= glyphIds.size()) continue;
+
+        const UnsignedInt glyph = _opened->glyphId(codepoint);
+        glyphIds[count] = glyph;
+        glyphOffsets[count] = {};
+        glyphAdvances[count] = _opened->glyphAdvance[glyph];
+    }
+
+    return count;
+}
+
 namespace {
 
 MagnumFontLayouter::MagnumFontLayouter(const std::vector<Vector2>& glyphAdvance, const AbstractGlyphCache& cache, const Float fontSize, const Float textSize, std::vector<UnsignedInt>&& glyphs): AbstractLayouter(glyphs.size()), glyphAdvance(glyphAdvance), cache(cache), fontSize(fontSize), textSize(textSize), glyphs(std::move(glyphs)) {}
@@ -24,13 +24,19 @@
 */
 
 #include <sstream>
+#include <unordered_map>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Configuration.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Unicode.h>
 
 #include "Magnum/FileCallback.h"
+#include "Magnum/Math/ConfigurationValue.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/AbstractGlyphCache.h"
 #include "Magnum/Trade/AbstractImporter.h"
@@ -45,23 +51,69 @@ struct MagnumFontTest: TestSuite::Tester {
     void nonexistent();
     void properties();
     void layout();
+    void layoutGlyphs();
+    void glyphIdMultiplePages();
 
     void fileCallbackImage();
     void fileCallbackImageNotFound();
 
+    void benchmarkLayout();
+    void benchmarkLayoutGlyphs();
+
+    Containers::Pointer<AbstractFont> openMixedScriptFont();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<Trade::AbstractImporter> _importerManager{"nonexistent"};
     PluginManager::Manager<AbstractFont> _fontManager{"nonexistent"};
+
+    Containers::Array<char> _mixedScriptFontImage;
+};
+
+struct DummyGlyphCache: AbstractGlyphCache {
+    using AbstractGlyphCache::AbstractGlyphCache;
+
+    GlyphCacheFeatures doFeatures() const override { return {}; }
+    void doSetImage(const Vector2i&, const ImageView2D&) override {}
+};
+
+/* Character ranges, each character mapped to a glyph of its own. Spans
+   several BMP pages and goes also outside of the BMP. */
+const struct {
+    char32_t begin, end;
+} MixedScriptRanges[]{
+    {0x0020, 0x007f},   /* Basic Latin */
+    {0x0391, 0x03ca},   /* Greek */
+    {0x0410, 0x0450},   /* Cyrillic */
+    {0x05d0, 0x05eb},   /* Hebrew */
+    {0x4e00, 0x5200},   /* CJK Unified Ideographs, four pages */
+    {0x1f600, 0x1f650}  /* Emoticons */
+};
+
+/* A mix of Latin, Greek, Cyrillic, Hebrew, CJK and emoji, with an e acute
+   that's not in the font */
+const char32_t MixedScriptText[]{
+    'H', 'e', 'l', 'l', 'o', ' ',
+    0x3b1, 0x3b2, 0x3b3, ' ',
+    0x43f, 0x440, 0x438, ' ',
+    0x5e9, 0x5dc, ' ',
+    0x4e16, 0x5165, ' ',
+    0x1f600, ' ',
+    'c', 'a', 'f', 0xe9, ' '
 };
 
 MagnumFontTest::MagnumFontTest() {
     addTests({&MagnumFontTest::nonexistent,
               &MagnumFontTest::properties,
               &MagnumFontTest::layout,
+              &MagnumFontTest::layoutGlyphs,
+              &MagnumFontTest::glyphIdMultiplePages,
 
               &MagnumFontTest::fileCallbackImage,
               &MagnumFontTest::fileCallbackImageNotFound});
 
+    addBenchmarks({&MagnumFontTest::benchmarkLayout,
+                   &MagnumFontTest::benchmarkLayoutGlyphs}, 10);
+
     /* Load the plugins directly from the build tree. Otherwise they're static
        and already loaded. */
     _fontManager.registerExternalManager(_importerManager);
@@ -97,12 +149,7 @@ void MagnumFontTest::layout() {
     CORRADE_VERIFY(font->openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.conf"), 0.0f));
 
     /* Fill the cache with some fake glyphs */
-    struct DummyGlyphCache: AbstractGlyphCache {
-        using AbstractGlyphCache::AbstractGlyphCache;
-
-        GlyphCacheFeatures doFeatures() const override { return {}; }
-        void doSetImage(const Vector2i&, const ImageView2D&) override {}
-    } cache{Vector2i{256}};
+    DummyGlyphCache cache{Vector2i{256}};
     cache.insert(font->glyphId(U'W'), {25, 34}, {{0, 8}, {16, 128}});
     cache.insert(font->glyphId(U'e'), {25, 12}, {{16, 4}, {64, 32}});
 
@@ -140,6 +187,116 @@ void MagnumFontTest::layout() {
     CORRADE_COMPARE(cursorPosition, Vector2(0.375f, 0.0f));
 }
 
+void MagnumFontTest::layoutGlyphs() {
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+    CORRADE_VERIFY(font->features() & FontFeature::BatchLayout);
+
+    CORRADE_VERIFY(font->openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.conf"), 0.0f));
+
+    UnsignedInt glyphIds[4];
+    Vector2 glyphOffsets[4];
+    Vector2 glyphAdvances[4];
+    CORRADE_COMPARE(font->layoutGlyphs(Containers::arrayView("Wave", 4), glyphIds, glyphOffsets, glyphAdvances), 4);
+
+    /* 'a' and 'v' are not found */
+    CORRADE_COMPARE_AS(Containers::arrayView(glyphIds),
+        Containers::arrayView<UnsignedInt>({2, 0, 0, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(glyphOffsets),
+        Containers::arrayView<Vector2>({{}, {}, {}, {}}),
+        TestSuite::Compare::Container);
+    /* Same as in layout(), except for the 0.5/16 scale */
+    CORRADE_COMPARE_AS(Containers::arrayView(glyphAdvances),
+        Containers::arrayView<Vector2>({
+            {23.0f, 0.0f}, {8.0f, 0.0f}, {8.0f, 0.0f}, {12.0f, 0.0f}
+        }), TestSuite::Compare::Container);
+}
+
+Containers::Pointer<AbstractFont> MagnumFontTest::openMixedScriptFont() {
+    Utility::Configuration conf;
+    conf.setValue("version", 1);
+    conf.setValue("image", std::string{"font.tga"});
+    conf.setValue("originalImageSize", Vector2i{1536});
+    conf.setValue("padding", Vector2i{24});
+    conf.setValue("fontSize", 16.0f);
+    conf.setValue("ascent", 25.0f);
+    conf.setValue("descent", -10.0f);
+    conf.setValue("lineHeight", 39.7333f);
+
+    /* Glyph 0 is the "Not Found" glyph, the rest has advance depending on
+       the character to have something to verify */
+    conf.addGroup("glyph")->setValue("advance", Vector2{8.0f, 0.0f});
+    UnsignedInt glyphId = 0;
+    for(const auto& range: MixedScriptRanges) {
+        for(char32_t c = range.begin; c != range.end; ++c) {
+            Utility::ConfigurationGroup* character = conf.addGroup("char");
+            character->setValue("unicode", c);
+            character->setValue("glyph", ++glyphId);
+            conf.addGroup("glyph")->setValue("advance", Vector2{Float(c % 16 + 1), 0.0f});
+        }
+    }
+
+    std::ostringstream out;
+    conf.save(out);
+    const std::string data = out.str();
+
+    _mixedScriptFontImage = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.tga"));
+
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+    font->setFileCallback([](const std::string&, InputFileCallbackPolicy, Containers::Array<char>& image) {
+            return Containers::optional(Containers::ArrayView<const char>(image));
+        }, _mixedScriptFontImage);
+    if(!font->openData({data.data(), data.size()}, 0.0f)) return nullptr;
+    return font;
+}
+
+void MagnumFontTest::glyphIdMultiplePages() {
+    Containers::Pointer<AbstractFont> font = openMixedScriptFont();
+    CORRADE_VERIFY(font);
+
+    /* First and last character of each range, continuing glyph IDs */
+    CORRADE_COMPARE(font->glyphId(U' '), 1);
+    CORRADE_COMPARE(font->glyphId(U'~'), 95);
+    CORRADE_COMPARE(font->glyphId(0x0391), 96);
+    CORRADE_COMPARE(font->glyphId(0x03c9), 152);
+    CORRADE_COMPARE(font->glyphId(0x0410), 153);
+    CORRADE_COMPARE(font->glyphId(0x044f), 216);
+    CORRADE_COMPARE(font->glyphId(0x05d0), 217);
+    CORRADE_COMPARE(font->glyphId(0x05ea), 243);
+    CORRADE_COMPARE(font->glyphId(0x4e00), 244);
+    CORRADE_COMPARE(font->glyphId(0x51ff), 1267);
+    CORRADE_COMPARE(font->glyphId(0x1f600), 1268);
+    CORRADE_COMPARE(font->glyphId(0x1f64f), 1347);
+    CORRADE_COMPARE(font->glyphAdvance(font->glyphId(0x1f64f)), (Vector2{16.0f, 0.0f}));
+
+    /* Characters on a used page but not in the font, on an unused page,
+       outside of the BMP and outside of the Unicode range */
+    CORRADE_COMPARE(font->glyphId(0x7f), 0);
+    CORRADE_COMPARE(font->glyphId(0xe9), 0);
+    CORRADE_COMPARE(font->glyphId(0x03ca), 0);
+    CORRADE_COMPARE(font->glyphId(0x0900), 0);
+    CORRADE_COMPARE(font->glyphId(0xffff), 0);
+    CORRADE_COMPARE(font->glyphId(0x1f5ff), 0);
+    CORRADE_COMPARE(font->glyphId(0x1f650), 0);
+    CORRADE_COMPARE(font->glyphId(0x10ffff), 0);
+    CORRADE_COMPARE(font->glyphId(0xffffffff), 0);
+
+    /* Batch layout goes through the same tables. Alpha, first CJK ideograph,
+       a smiley and e acute. */
+    const char text[] = "\xce\xb1\xe4\xb8\x80\xf0\x9f\x98\x80\xc3\xa9";
+    UnsignedInt glyphIds[4];
+    Vector2 glyphOffsets[4];
+    Vector2 glyphAdvances[4];
+    CORRADE_COMPARE(font->layoutGlyphs({text, sizeof(text) - 1}, glyphIds, glyphOffsets, glyphAdvances), 4);
+    CORRADE_COMPARE_AS(Containers::arrayView(glyphIds),
+        Containers::arrayView<UnsignedInt>({128, 244, 1268, 0}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(glyphAdvances),
+        Containers::arrayView<Vector2>({
+            {2.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 0.0f}, {8.0f, 0.0f}
+        }), TestSuite::Compare::Container);
+}
+
 void MagnumFontTest::fileCallbackImage() {
     Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
     CORRADE_VERIFY(font->features() & FontFeature::FileCallback);
@@ -175,6 +332,72 @@ void MagnumFontTest::fileCallbackImageNotFound() {
     CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::openFile(): cannot open file font.tga\n");
 }
 
+std::string mixedScriptText(UnsignedInt& glyphCount) {
+    /* Repeat the text until it's 1 MB */
+    std::string text;
+    text.reserve(1024*1024 + 4*Containers::arraySize(MixedScriptText));
+    glyphCount = 0;
+    while(text.size() < 1024*1024) {
+        for(const char32_t c: MixedScriptText) {
+            char utf8[4]{};
+            text.append(utf8, Utility::Unicode::utf8(c, utf8));
+        }
+        glyphCount += Containers::arraySize(MixedScriptText);
+    }
+
+    return text;
+}
+
+void MagnumFontTest::benchmarkLayout() {
+    Containers::Pointer<AbstractFont> font = openMixedScriptFont();
+    CORRADE_VERIFY(font);
+
+    UnsignedInt glyphCount;
+    const std::string text = mixedScriptText(glyphCount);
+
+    DummyGlyphCache cache{Vector2i{256}};
+    for(UnsignedInt i = 1; i != 1348; ++i)
+        cache.insert(i, {}, {{}, Vector2i{Int(i % 16 + 1)}});
+
+    UnsignedInt count = 0;
+    Range2D rectangle;
+    CORRADE_BENCHMARK(1) {
+        Containers::Pointer<AbstractLayouter> layouter = font->layout(cache, 0.5f, text);
+        Vector2 cursorPosition;
+        for(UnsignedInt i = 0; i != layouter->glyphCount(); ++i)
+            layouter->renderGlyph(i, cursorPosition, rectangle);
+        count = layouter->glyphCount();
+    }
+
+    CORRADE_COMPARE(count, glyphCount);
+    CORRADE_VERIFY(!rectangle.size().isZero());
+}
+
+void MagnumFontTest::benchmarkLayoutGlyphs() {
+    Containers::Pointer<AbstractFont> font = openMixedScriptFont();
+    CORRADE_VERIFY(font);
+
+    UnsignedInt glyphCount;
+    const std::string text = mixedScriptText(glyphCount);
+
+    Containers::Array<UnsignedInt> glyphIds{glyphCount};
+    Containers::Array<Vector2> glyphOffsets{glyphCount};
+    Containers::Array<Vector2> glyphAdvances{glyphCount};
+    UnsignedInt count = 0;
+    CORRADE_BENCHMARK(1) {
+        count = font->layoutGlyphs({text.data(), text.size()},
+            Containers::arrayView(glyphIds),
+            Containers::arrayView(glyphOffsets),
+            Containers::arrayView(glyphAdvances));
+    }
+
+    CORRADE_COMPARE(count, glyphCount);
+    /* 'H' */
+    CORRADE_COMPARE(glyphIds[0], 41);
+    /* e acute */
+    CORRADE_COMPARE(glyphIds[25], 0);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::MagnumFontTest)
@@ -27,6 +27,7 @@
 
 #include <algorithm>
 #include <sstream>
+#include <unordered_map>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Configuration.h>
 #include <Corrade/Utility/Directory.h>
@@ -68,7 +69,7 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
 
     /* Get the glyphs and sort them for predictable output */
     std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>> sortedGlyphs;
-    for(const std::pair<const UnsignedInt, std::pair<Vector2i, Range2Di>>& glyph: cache)
+    for(const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& glyph: cache)
         sortedGlyphs.emplace_back(glyph);
     std::sort(sortedGlyphs.begin(), sortedGlyphs.end(),
         [](const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& a,
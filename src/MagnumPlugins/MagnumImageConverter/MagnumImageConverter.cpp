@@ -0,0 +1,59 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MagnumImageConverter.h"
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/Trade/ImageData.h"
+
+namespace Magnum { namespace Trade {
+
+MagnumImageConverter::MagnumImageConverter() = default;
+
+MagnumImageConverter::MagnumImageConverter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImageConverter{manager, plugin} {}
+
+MagnumImageConverter::~MagnumImageConverter() = default;
+
+ImageConverterFeatures MagnumImageConverter::doFeatures() const {
+    return ImageConverterFeature::ConvertData|ImageConverterFeature::ConvertCompressedData;
+}
+
+/* The views are wrapped in non-owning ImageData instances, which don't copy
+   anything */
+
+Containers::Array<char> MagnumImageConverter::doExportToData(const ImageView2D& image) {
+    return ImageData2D{image.storage(), image.format(), image.formatExtra(), image.pixelSize(), image.size(), DataFlags{}, image.data()}.serialize();
+}
+
+Containers::Array<char> MagnumImageConverter::doExportToData(const CompressedImageView2D& image) {
+    return ImageData2D{image.storage(), image.format(), image.size(), DataFlags{}, image.data()}.serialize();
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MagnumImageConverter, Magnum::Trade::MagnumImageConverter,
+    "cz.mosra.magnum.Trade.AbstractImageConverter/0.2.1")
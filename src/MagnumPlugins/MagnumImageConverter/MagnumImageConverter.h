@@ -0,0 +1,123 @@
+#ifndef Magnum_Trade_MagnumImageConverter_h
+#define Magnum_Trade_MagnumImageConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MagnumImageConverter
+ * @m_since_latest
+ */
+
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "MagnumPlugins/MagnumImageConverter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MAGNUMIMAGECONVERTER_BUILD_STATIC
+    #ifdef MagnumImageConverter_EXPORTS
+        #define MAGNUM_MAGNUMIMAGECONVERTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MAGNUMIMAGECONVERTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MAGNUMIMAGECONVERTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MAGNUMIMAGECONVERTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MAGNUMIMAGECONVERTER_EXPORT
+#define MAGNUM_MAGNUMIMAGECONVERTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Magnum blob image converter plugin
+@m_since_latest
+
+Writes compressed and uncompressed images into a memory-mappable binary blob
+(`*.blob`) using @ref ImageData::serialize(). The blob can be imported back
+with the @ref MagnumImporter "MagnumImporter" plugin or using
+@ref ImageData::deserialize() directly.
+
+@section Trade-MagnumImageConverter-usage Usage
+
+This plugin depends on the @ref Trade library and is built if
+`WITH_MAGNUMIMAGECONVERTER` is enabled when building Magnum. To use as a
+dynamic plugin, load @cpp "MagnumImageConverter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(WITH_MAGNUMIMAGECONVERTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::MagnumImageConverter)
+@endcode
+
+To use as a static plugin or as a dependency of another plugin with CMake, you
+need to request the `MagnumImageConverter` component of the `Magnum` package
+and link to the `Magnum::MagnumImageConverter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED MagnumImageConverter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::MagnumImageConverter)
+@endcode
+
+See @ref building, @ref cmake and @ref plugins for more information.
+
+@section Trade-MagnumImageConverter-behavior Behavior and limitations
+
+The pixel data are written verbatim, together with the format and all
+@ref PixelStorage / @ref CompressedPixelStorage parameters, so the image can
+be uploaded to the GPU directly from a memory-mapped file. The data are stored
+in the native byte order of the machine, see
+@ref Trade-ImageData-serialization for more information.
+
+The @ref AbstractImageConverter interface accepts just a single 2D image, use
+@ref ImageData::serialize(Containers::ArrayView<const ImageData<dimensions>>)
+directly to put a whole mip chain or a 1D or 3D image into a blob.
+*/
+class MAGNUM_MAGNUMIMAGECONVERTER_EXPORT MagnumImageConverter: public AbstractImageConverter {
+    public:
+        /** @brief Default constructor */
+        explicit MagnumImageConverter();
+
+        /** @brief Plugin manager constructor */
+        explicit MagnumImageConverter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        ~MagnumImageConverter();
+
+    private:
+        MAGNUM_MAGNUMIMAGECONVERTER_LOCAL ImageConverterFeatures doFeatures() const override;
+        MAGNUM_MAGNUMIMAGECONVERTER_LOCAL Containers::Array<char> doExportToData(const ImageView2D& image) override;
+        MAGNUM_MAGNUMIMAGECONVERTER_LOCAL Containers::Array<char> doExportToData(const CompressedImageView2D& image) override;
+};
+
+}}
+
+#endif
@@ -0,0 +1,124 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/ImageData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MagnumImageConverterTest: TestSuite::Tester {
+    explicit MagnumImageConverterTest();
+
+    void convert();
+    void convertCompressed();
+    void convertToFile();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImageConverter> _manager{"nonexistent"};
+};
+
+MagnumImageConverterTest::MagnumImageConverterTest() {
+    addTests({&MagnumImageConverterTest::convert,
+              &MagnumImageConverterTest::convertCompressed,
+              &MagnumImageConverterTest::convertToFile});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MAGNUMIMAGECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(MAGNUMIMAGECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* Create the output directory if it doesn't exist yet */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::mkpath(MAGNUMIMAGECONVERTER_TEST_OUTPUT_DIR));
+}
+
+constexpr char Data[]{
+    1, 2, 3, 4, 5, 6, 0, 0,
+    7, 8, 9, 10, 11, 12, 0, 0
+};
+
+const ImageView2D Image{PixelStorage{}.setAlignment(4),
+    PixelFormat::RGB8Unorm, {2, 2}, Data};
+
+void MagnumImageConverterTest::convert() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("MagnumImageConverter");
+
+    Containers::Array<char> data = converter->exportToData(Image);
+    CORRADE_VERIFY(data);
+
+    Containers::Optional<ImageData2D> image = ImageData2D::deserialize(data);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(!image->isCompressed());
+    CORRADE_COMPARE(image->storage().alignment(), 4);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image->size(), (Vector2i{2, 2}));
+    CORRADE_COMPARE_AS(image->data(),
+        Containers::arrayView(Data),
+        TestSuite::Compare::Container);
+}
+
+void MagnumImageConverterTest::convertCompressed() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("MagnumImageConverter");
+
+    Containers::Array<char> data = converter->exportToData(CompressedImageView2D{
+        CompressedPixelFormat::Bc1RGBAUnorm, {4, 4}, Containers::arrayView(Data).prefix(8)});
+    CORRADE_VERIFY(data);
+
+    Containers::Optional<ImageData2D> image = ImageData2D::deserialize(data);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(image->isCompressed());
+    CORRADE_COMPARE(image->compressedFormat(), CompressedPixelFormat::Bc1RGBAUnorm);
+    CORRADE_COMPARE(image->size(), (Vector2i{4, 4}));
+    CORRADE_COMPARE_AS(image->data(),
+        Containers::arrayView(Data).prefix(8),
+        TestSuite::Compare::Container);
+}
+
+void MagnumImageConverterTest::convertToFile() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("MagnumImageConverter");
+
+    const std::string filename = Utility::Directory::join(MAGNUMIMAGECONVERTER_TEST_OUTPUT_DIR, "image.blob");
+    if(Utility::Directory::exists(filename))
+        CORRADE_VERIFY(Utility::Directory::rm(filename));
+
+    CORRADE_VERIFY(converter->exportToFile(Image, filename));
+    CORRADE_COMPARE_AS(Utility::Directory::read(filename),
+        converter->exportToData(Image),
+        TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MagnumImageConverterTest)
@@ -0,0 +1,188 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MagnumImporter.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Trade {
+
+struct MagnumImporter::State {
+    /* Only one of these is populated at a time, view points to it */
+    Containers::Array<char> data;
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Array<const char, Utility::Directory::MapDeleter> mapped;
+    #endif
+    Containers::ArrayView<const char> view;
+
+    /* Views on chunks of particular types, all validated on open */
+    Containers::Array<Containers::ArrayView<const char>> meshes;
+    Containers::Array<Containers::ArrayView<const char>> images1D;
+    Containers::Array<Containers::ArrayView<const char>> images2D;
+    Containers::Array<Containers::ArrayView<const char>> images3D;
+};
+
+MagnumImporter::MagnumImporter() = default;
+
+MagnumImporter::MagnumImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+MagnumImporter::~MagnumImporter() = default;
+
+ImporterFeatures MagnumImporter::doFeatures() const { return ImporterFeature::OpenData; }
+
+bool MagnumImporter::doIsOpened() const { return !!_state; }
+
+void MagnumImporter::doClose() { _state.reset(); }
+
+void MagnumImporter::openInternal(const char* const messagePrefix, Containers::Pointer<State>&& state) {
+    /* Go through all chunks and validate them right away so it doesn't need
+       to be done in mesh() / image*(). Deserialization prints a message on
+       its own. Chunks of unknown types are skipped to allow newer files to be
+       at least partially imported. */
+    for(std::size_t offset = 0; offset != state->view.size(); ) {
+        const DataChunkHeader* const header = dataChunkHeaderDeserialize(state->view.suffix(offset));
+        if(!header) return;
+
+        const Containers::ArrayView<const char> chunk = state->view.slice(offset, offset + header->size);
+        switch(header->type) {
+            case DataChunkType::Mesh:
+                if(!MeshData::deserialize(chunk)) return;
+                arrayAppend(state->meshes, chunk);
+                break;
+            case DataChunkType::Image1D:
+                if(!ImageData1D::deserializeLevelCount(chunk)) return;
+                arrayAppend(state->images1D, chunk);
+                break;
+            case DataChunkType::Image2D:
+                if(!ImageData2D::deserializeLevelCount(chunk)) return;
+                arrayAppend(state->images2D, chunk);
+                break;
+            case DataChunkType::Image3D:
+                if(!ImageData3D::deserializeLevelCount(chunk)) return;
+                arrayAppend(state->images3D, chunk);
+                break;
+            default:
+                Warning{} << messagePrefix << "skipping unknown chunk" << header->type;
+        }
+
+        offset += header->size;
+    }
+
+    _state = std::move(state);
+}
+
+void MagnumImporter::doOpenData(const Containers::ArrayView<const char> data) {
+    /* The data are not guaranteed to stay in scope after this function exits
+       and neither are guaranteed to be suitably aligned, so make a copy.
+       Allocated memory is always aligned enough. */
+    Containers::Pointer<State> state{new State};
+    state->data = Containers::Array<char>{Containers::NoInit, data.size()};
+    Utility::copy(data, state->data);
+    state->view = state->data;
+
+    openInternal("Trade::MagnumImporter::openData():", std::move(state));
+}
+
+void MagnumImporter::doOpenFile(const std::string& filename) {
+    if(!Utility::Directory::exists(filename)) {
+        Error{} << "Trade::MagnumImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+
+    /* Memory-map the file if possible, otherwise read it. Not delegating to
+       the default implementation so messages printed while opening have the
+       correct prefix. */
+    Containers::Pointer<State> state{new State};
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    state->mapped = Utility::Directory::mapRead(filename);
+    if(!state->mapped) {
+        Error{} << "Trade::MagnumImporter::openFile(): cannot map file" << filename;
+        return;
+    }
+    state->view = state->mapped;
+    #else
+    state->data = Utility::Directory::read(filename);
+    state->view = state->data;
+    #endif
+
+    openInternal("Trade::MagnumImporter::openFile():", std::move(state));
+}
+
+UnsignedInt MagnumImporter::doMeshCount() const { return _state->meshes.size(); }
+
+Containers::Optional<MeshData> MagnumImporter::doMesh(const UnsignedInt id, UnsignedInt) {
+    /* Already validated when opening, so this can't fail */
+    Containers::Optional<MeshData> mesh = MeshData::deserialize(_state->meshes[id]);
+    CORRADE_INTERNAL_ASSERT(mesh);
+    return mesh;
+}
+
+UnsignedInt MagnumImporter::doImage1DCount() const { return _state->images1D.size(); }
+
+UnsignedInt MagnumImporter::doImage1DLevelCount(const UnsignedInt id) {
+    return ImageData1D::deserializeLevelCount(_state->images1D[id]);
+}
+
+Containers::Optional<ImageData1D> MagnumImporter::doImage1D(const UnsignedInt id, const UnsignedInt level) {
+    Containers::Optional<ImageData1D> image = ImageData1D::deserialize(_state->images1D[id], level);
+    CORRADE_INTERNAL_ASSERT(image);
+    return image;
+}
+
+UnsignedInt MagnumImporter::doImage2DCount() const { return _state->images2D.size(); }
+
+UnsignedInt MagnumImporter::doImage2DLevelCount(const UnsignedInt id) {
+    return ImageData2D::deserializeLevelCount(_state->images2D[id]);
+}
+
+Containers::Optional<ImageData2D> MagnumImporter::doImage2D(const UnsignedInt id, const UnsignedInt level) {
+    Containers::Optional<ImageData2D> image = ImageData2D::deserialize(_state->images2D[id], level);
+    CORRADE_INTERNAL_ASSERT(image);
+    return image;
+}
+
+UnsignedInt MagnumImporter::doImage3DCount() const { return _state->images3D.size(); }
+
+UnsignedInt MagnumImporter::doImage3DLevelCount(const UnsignedInt id) {
+    return ImageData3D::deserializeLevelCount(_state->images3D[id]);
+}
+
+Containers::Optional<ImageData3D> MagnumImporter::doImage3D(const UnsignedInt id, const UnsignedInt level) {
+    Containers::Optional<ImageData3D> image = ImageData3D::deserialize(_state->images3D[id], level);
+    CORRADE_INTERNAL_ASSERT(image);
+    return image;
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MagnumImporter, Magnum::Trade::MagnumImporter,
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.3")
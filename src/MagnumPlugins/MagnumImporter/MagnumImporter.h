@@ -0,0 +1,159 @@
+#ifndef Magnum_Trade_MagnumImporter_h
+#define Magnum_Trade_MagnumImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MagnumImporter
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Utility/VisibilityMacros.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "MagnumPlugins/MagnumImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MAGNUMIMPORTER_BUILD_STATIC
+    #ifdef MagnumImporter_EXPORTS
+        #define MAGNUM_MAGNUMIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MAGNUMIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MAGNUMIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MAGNUMIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MAGNUMIMPORTER_EXPORT
+#define MAGNUM_MAGNUMIMPORTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Magnum blob importer plugin
+@m_since_latest
+
+Imports meshes and images serialized with @ref MeshData::serialize(),
+@ref ImageData::serialize() or the
+@ref MagnumSceneConverter "MagnumSceneConverter" and
+@ref MagnumImageConverter "MagnumImageConverter" plugins (`*.blob`).
+
+@section Trade-MagnumImporter-usage Usage
+
+This plugin depends on the @ref Trade library and is built if
+`WITH_MAGNUMIMPORTER` is enabled when building Magnum. To use as a dynamic
+plugin, load @cpp "MagnumImporter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(WITH_MAGNUMIMPORTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::MagnumImporter)
+@endcode
+
+To use as a static plugin or use this as a dependency of another plugin with
+CMake, you need to request the `MagnumImporter` component of the `Magnum`
+package and link to the `Magnum::MagnumImporter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED MagnumImporter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::MagnumImporter)
+@endcode
+
+See @ref building, @ref cmake and @ref plugins for more information.
+
+@section Trade-MagnumImporter-behavior Behavior and limitations
+
+The file is a sequence of serialized chunks, each containing either a mesh
+or a 1D, 2D or 3D image with all its levels, see
+@ref Trade-MeshData-serialization and @ref Trade-ImageData-serialization for
+details about the format. Files produced by the converter plugins contain just
+one chunk, but any number of them can be concatenated together. Chunks of
+unknown types are skipped with a warning. All chunks are validated when
+opening, after that @ref mesh() and @ref image2D() and related functions
+return instances that reference the opened data directly, without any parsing
+or copying. The returned instances are valid only until the importer is closed
+or another file is opened and their data flags are empty, as they're neither
+owned nor mutable. Use @ref MeshTools::owned() or copy the image data to make
+a self-contained instance.
+
+When opening a file using @ref openFile() and no file callbacks are set, the
+file is memory-mapped instead of being read into memory, which means the
+import cost is independent of the mesh or image size. On platforms without
+memory mapping support, and with @ref openData(), the data are copied into an
+internal buffer. In both cases, the image data are aligned to 8 bytes, so they
+can be uploaded to the GPU directly.
+*/
+class MAGNUM_MAGNUMIMPORTER_EXPORT MagnumImporter: public AbstractImporter {
+    public:
+        /** @brief Default constructor */
+        explicit MagnumImporter();
+
+        /** @brief Plugin manager constructor */
+        explicit MagnumImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        ~MagnumImporter();
+
+    private:
+        MAGNUM_MAGNUMIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL bool doIsOpened() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL void doClose() override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doMeshCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt level) override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doImage1DCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doImage1DLevelCount(UnsignedInt id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<ImageData1D> doImage1D(UnsignedInt id, UnsignedInt level) override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doImage2DCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doImage2DLevelCount(UnsignedInt id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt level) override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doImage3DCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doImage3DLevelCount(UnsignedInt id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<ImageData3D> doImage3D(UnsignedInt id, UnsignedInt level) override;
+
+        struct State;
+        MAGNUM_MAGNUMIMPORTER_LOCAL void openInternal(const char* messagePrefix, Containers::Pointer<State>&& state);
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -0,0 +1,280 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MagnumImporterTest: TestSuite::Tester {
+    explicit MagnumImporterTest();
+
+    void openData();
+    void openFile();
+    void openFileNotFound();
+    void openInvalid();
+    void openInvalidChunk();
+    void openMultipleChunks();
+    void openUnknownChunk();
+
+    void openTwice();
+    void importTwice();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+MagnumImporterTest::MagnumImporterTest() {
+    addTests({&MagnumImporterTest::openData,
+              &MagnumImporterTest::openFile,
+              &MagnumImporterTest::openFileNotFound,
+              &MagnumImporterTest::openInvalid,
+              &MagnumImporterTest::openInvalidChunk,
+              &MagnumImporterTest::openMultipleChunks,
+              &MagnumImporterTest::openUnknownChunk,
+
+              &MagnumImporterTest::openTwice,
+              &MagnumImporterTest::importTwice});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MAGNUMIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(MAGNUMIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* Create the output directory if it doesn't exist yet */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::mkpath(MAGNUMIMPORTER_TEST_OUTPUT_DIR));
+}
+
+constexpr UnsignedShort Indices[]{0, 1, 2, 2, 1, 0};
+constexpr Vector3 Positions[]{
+    {1.0f, 2.0f, 3.0f},
+    {4.0f, 5.0f, 6.0f},
+    {7.0f, 8.0f, 9.0f}
+};
+
+Containers::Array<char> serializedMesh() {
+    return MeshData{MeshPrimitive::Triangles,
+        DataFlags{}, Indices, MeshIndexData{Indices},
+        DataFlags{}, Positions, {
+            MeshAttributeData{MeshAttribute::Position, Containers::arrayView(Positions)}
+        }}.serialize();
+}
+
+void MagnumImporterTest::openData() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(serializedMesh()));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh->indexDataFlags(), DataFlags{});
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlags{});
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(),
+        Containers::arrayView(Indices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView(Positions),
+        TestSuite::Compare::Container);
+}
+
+void MagnumImporterTest::openFile() {
+    const std::string filename = Utility::Directory::join(MAGNUMIMPORTER_TEST_OUTPUT_DIR, "mesh.blob");
+    CORRADE_VERIFY(Utility::Directory::write(filename, serializedMesh()));
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openFile(filename));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indexDataFlags(), DataFlags{});
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlags{});
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(),
+        Containers::arrayView(Indices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView(Positions),
+        TestSuite::Compare::Container);
+}
+
+void MagnumImporterTest::openFileNotFound() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openFile("nonexistent.blob"));
+    CORRADE_VERIFY(!importer->isOpened());
+    CORRADE_COMPARE(out.str(), "Trade::MagnumImporter::openFile(): cannot open file nonexistent.blob\n");
+}
+
+void MagnumImporterTest::openInvalid() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Containers::Array<char> data = serializedMesh();
+    data[0] = 'P';
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data));
+    CORRADE_VERIFY(!importer->isOpened());
+    CORRADE_COMPARE(out.str(), "Trade::dataChunkHeaderDeserialize(): invalid signature PLOB\n");
+}
+
+void MagnumImporterTest::openInvalidChunk() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* Make the header valid but the chunk too small to contain the mesh
+       header */
+    Containers::Array<char> data = serializedMesh();
+    reinterpret_cast<DataChunkHeader*>(data.data())->size = 32;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data));
+    CORRADE_VERIFY(!importer->isOpened());
+    CORRADE_COMPARE(out.str(), "Trade::MeshData::deserialize(): chunk size 32 out of range for 32 bytes of data\n");
+}
+
+void MagnumImporterTest::openMultipleChunks() {
+    constexpr char Pixels[]{
+        1, 2, 3, 4, 5, 6, 7, 8,
+        9, 10, 11, 12, 13, 14, 15, 16
+    };
+    const ImageData2D levels[]{
+        ImageData2D{PixelFormat::RGBA8Unorm, {2, 2}, DataFlags{}, Pixels},
+        ImageData2D{PixelFormat::RGBA8Unorm, {1, 1}, DataFlags{}, Containers::arrayView(Pixels).suffix(12)}
+    };
+    const Containers::Array<char> chunks[]{
+        serializedMesh(),
+        ImageData2D::serialize(levels),
+        ImageData3D{CompressedPixelFormat::Bc1RGBAUnorm, {4, 4, 1}, DataFlags{}, Containers::arrayView(Pixels).prefix(8)}.serialize(),
+        serializedMesh()
+    };
+    Containers::Array<char> data{Containers::NoInit, chunks[0].size() + chunks[1].size() + chunks[2].size() + chunks[3].size()};
+    std::size_t offset = 0;
+    for(const Containers::Array<char>& chunk: chunks) {
+        Utility::copy(chunk, data.slice(offset, offset + chunk.size()));
+        offset += chunk.size();
+    }
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(data));
+    CORRADE_COMPARE(importer->meshCount(), 2);
+    CORRADE_COMPARE(importer->image1DCount(), 0);
+    CORRADE_COMPARE(importer->image2DCount(), 1);
+    CORRADE_COMPARE(importer->image2DLevelCount(0), 2);
+    CORRADE_COMPARE(importer->image3DCount(), 1);
+    CORRADE_COMPARE(importer->image3DLevelCount(0), 1);
+
+    Containers::Optional<MeshData> mesh = importer->mesh(1);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView(Positions),
+        TestSuite::Compare::Container);
+
+    Containers::Optional<ImageData2D> image2D = importer->image2D(0, 1);
+    CORRADE_VERIFY(image2D);
+    CORRADE_COMPARE(image2D->dataFlags(), DataFlags{});
+    CORRADE_COMPARE(image2D->format(), PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE(image2D->size(), Vector2i{1});
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(image2D->data().data()) % 8, 0);
+    CORRADE_COMPARE_AS(image2D->data(),
+        Containers::arrayView(Pixels).suffix(12),
+        TestSuite::Compare::Container);
+
+    Containers::Optional<ImageData3D> image3D = importer->image3D(0);
+    CORRADE_VERIFY(image3D);
+    CORRADE_VERIFY(image3D->isCompressed());
+    CORRADE_COMPARE(image3D->compressedFormat(), CompressedPixelFormat::Bc1RGBAUnorm);
+    CORRADE_COMPARE(image3D->size(), (Vector3i{4, 4, 1}));
+    CORRADE_COMPARE_AS(image3D->data(),
+        Containers::arrayView(Pixels).prefix(8),
+        TestSuite::Compare::Container);
+}
+
+void MagnumImporterTest::openUnknownChunk() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Containers::Array<char> data = serializedMesh();
+    reinterpret_cast<DataChunkHeader*>(data.data())->type = DataChunkType(0xdeadbeef);
+
+    std::ostringstream out;
+    Warning redirectWarning{&out};
+    CORRADE_VERIFY(importer->openData(data));
+    CORRADE_COMPARE(importer->meshCount(), 0);
+    CORRADE_COMPARE(out.str(), "Trade::MagnumImporter::openData(): skipping unknown chunk Trade::DataChunkType(0xdeadbeef)\n");
+
+    /* The message has the correct prefix when opening a file as well */
+    const std::string filename = Utility::Directory::join(MAGNUMIMPORTER_TEST_OUTPUT_DIR, "unknown-chunk.blob");
+    CORRADE_VERIFY(Utility::Directory::write(filename, data));
+    out.str({});
+    CORRADE_VERIFY(importer->openFile(filename));
+    CORRADE_COMPARE(importer->meshCount(), 0);
+    CORRADE_COMPARE(out.str(), "Trade::MagnumImporter::openFile(): skipping unknown chunk Trade::DataChunkType(0xdeadbeef)\n");
+}
+
+void MagnumImporterTest::openTwice() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    CORRADE_VERIFY(importer->openData(serializedMesh()));
+    CORRADE_VERIFY(importer->openData(serializedMesh()));
+
+    /* Shouldn't crash, leak or anything */
+}
+
+void MagnumImporterTest::importTwice() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(serializedMesh()));
+
+    /* Verify that everything is working the same way on second use */
+    {
+        Containers::Optional<MeshData> mesh = importer->mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), 3);
+    } {
+        Containers::Optional<MeshData> mesh = importer->mesh(0);
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), 3);
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MagnumImporterTest)
@@ -32,9 +32,9 @@
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Endianness.h>
 
+#include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
-#include "Magnum/Math/Swizzle.h"
-#include "Magnum/Math/Vector4.h"
+#include "Magnum/PixelFormatConversion.h"
 #include "Magnum/Trade/ImageData.h"
 #include "MagnumPlugins/TgaImporter/TgaHeader.h"
 
@@ -188,16 +188,13 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
     if((size.x()*header.bpp/8)%4 != 0)
         storage.setAlignment(1);
 
-    if(format == PixelFormat::RGB8Unorm) {
+    if(format == PixelFormat::RGB8Unorm || format == PixelFormat::RGBA8Unorm) {
         if(flags() & ImporterFlag::Verbose)
-            Debug{} << "Trade::TgaImporter::image2D(): converting from BGR to RGB";
-        for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(data))
-            pixel = Math::gather<'b', 'g', 'r'>(pixel);
-    } else if(format == PixelFormat::RGBA8Unorm) {
-        if(flags() & ImporterFlag::Verbose)
-            Debug{} << "Trade::TgaImporter::image2D(): converting from BGRA to RGBA";
-        for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(data))
-            pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+            Debug{} << "Trade::TgaImporter::image2D(): converting from" << (format == PixelFormat::RGB8Unorm ? "BGR to RGB" : "BGRA to RGBA");
+        /* In-place, the red and blue channels get swapped for whole rows at
+           once */
+        const ImageView2D source{storage, format, size, data};
+        convertPixelFormatInto(source, MutableImageView2D{storage, format, size, data}, PixelFormatConversionFlag::SwapRedBlue);
     }
 
     return ImageData2D{storage, format, size, std::move(data)};